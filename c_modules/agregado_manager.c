@@ -0,0 +1,659 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "agregado_manager.h"
+#include "aluno_manager.h"
+#include "turma_manager.h"
+#include "aula_manager.h"
+#include "atividade_manager.h"
+#include "tabela_manager.h"
+
+// Tabelas de endereçamento aberto (potências de 2). Entradas zeradas não são
+// apagadas na hora; ao passar de 3/4 de ocupação a tabela é reorganizada só
+// com as que ainda contam.
+#define ENTRADAS_TURMA 16384           // Ids de turma citados por qualquer tabela
+#define ENTRADAS_ALUNO 8192            // RAs de alunos e de matrículas
+#define ENTRADAS_FILTRO 8192           // Até 8 chaves por turma
+#define NOS_MATRICULA MAX_MATRICULAS
+
+// ========== ESTRUTURAS INTERNAS ==========
+
+typedef struct {
+    int id_turma;
+    int usada;
+    AgregadoTurma valores;
+} EntradaTurma;
+
+// Estado do RA e início da sua lista de matrículas
+typedef struct {
+    int ra;
+    int usada;
+    int cadastrado;            // 1 se existe na tabela de alunos
+    int ativo;
+    int primeira;              // Nó da primeira matrícula (-1 = nenhuma)
+} EntradaAluno;
+
+typedef struct {
+    int id_turma;
+    int proximo;               // Próximo nó do mesmo RA (-1 = fim)
+} NoMatricula;
+
+// Turmas por (professor, ano, semestre) com curingas
+typedef struct {
+    uint64_t chave;            // 0 = livre
+    int turmas;
+} EntradaFiltro;
+
+typedef struct {
+    int iniciado;
+    EntradaTurma turmas[ENTRADAS_TURMA];
+    int usadas_turmas;
+    EntradaAluno alunos[ENTRADAS_ALUNO];
+    int usadas_alunos;
+    EntradaFiltro filtros[ENTRADAS_FILTRO];
+    int usadas_filtros;
+    NoMatricula nos[NOS_MATRICULA];
+    int livre;                 // Lista de nós devolvidos (-1 = vazia)
+    int nunca_usado;           // Primeiro nó ainda não usado
+    TotaisAgregados totais;
+} EstadoAgregados;
+
+static EstadoAgregados vivo;
+static pthread_mutex_t trava_agregados = PTHREAD_MUTEX_INITIALIZER;
+
+// Cópia alterada pela transação em andamento: só a thread dela a vê, e os
+// módulos reconstroem o estado vivo depois da confirmação
+static EstadoAgregados da_transacao;
+static unsigned long transacao_da_copia = 0;
+
+// ========== FUNÇÕES AUXILIARES PRIVADAS ==========
+
+static uint32_t espalhar(uint32_t x) {
+    x *= 0x9E3779B1u;
+    return x ^ (x >> 15);
+}
+
+static void limparEstado(EstadoAgregados *e) {
+    memset(e, 0, sizeof(*e));
+    e->iniciado = 1;
+    e->livre = -1;
+}
+
+static void garantirIniciado(void) {
+    if (!vivo.iniciado) {
+        limparEstado(&vivo);
+    }
+}
+
+// Estado que a thread atual lê ou altera (exige trava_agregados)
+static EstadoAgregados* estadoDaThread(int alterar) {
+    unsigned long transacao = numeroTransacaoTabelas();
+
+    garantirIniciado();
+    if (transacao == 0) {
+        return &vivo;
+    }
+    if (transacao_da_copia != transacao) {
+        if (!alterar) {
+            return &vivo;
+        }
+        // Primeira alteração da transação: parte do estado confirmado
+        memcpy(&da_transacao, &vivo, sizeof(EstadoAgregados));
+        transacao_da_copia = transacao;
+    }
+    return &da_transacao;
+}
+
+static int turmaZerada(const AgregadoTurma *v) {
+    return v->aulas == 0 && v->atividades == 0 && v->alunos == 0 && v->alunos_ativos == 0;
+}
+
+static void reorganizarTurmas(EstadoAgregados *e);
+static void reorganizarAlunos(EstadoAgregados *e);
+static void reorganizarFiltros(EstadoAgregados *e);
+
+static EntradaTurma* entradaTurma(EstadoAgregados *e, int id_turma, int criar) {
+    if (criar && e->usadas_turmas >= ENTRADAS_TURMA / 4 * 3) {
+        reorganizarTurmas(e);
+    }
+    uint32_t i = espalhar((uint32_t)id_turma) & (ENTRADAS_TURMA - 1);
+    for (int sondas = 0; sondas < ENTRADAS_TURMA; sondas++, i = (i + 1) & (ENTRADAS_TURMA - 1)) {
+        EntradaTurma *t = &e->turmas[i];
+        if (t->usada && t->id_turma == id_turma) {
+            return t;
+        }
+        if (!t->usada) {
+            if (!criar) {
+                return NULL;
+            }
+            memset(t, 0, sizeof(*t));
+            t->usada = 1;
+            t->id_turma = id_turma;
+            e->usadas_turmas++;
+            return t;
+        }
+    }
+    return NULL;
+}
+
+static EntradaAluno* entradaAluno(EstadoAgregados *e, int ra, int criar) {
+    if (criar && e->usadas_alunos >= ENTRADAS_ALUNO / 4 * 3) {
+        reorganizarAlunos(e);
+    }
+    uint32_t i = espalhar((uint32_t)ra) & (ENTRADAS_ALUNO - 1);
+    for (int sondas = 0; sondas < ENTRADAS_ALUNO; sondas++, i = (i + 1) & (ENTRADAS_ALUNO - 1)) {
+        EntradaAluno *a = &e->alunos[i];
+        if (a->usada && a->ra == ra) {
+            return a;
+        }
+        if (!a->usada) {
+            if (!criar) {
+                return NULL;
+            }
+            memset(a, 0, sizeof(*a));
+            a->usada = 1;
+            a->ra = ra;
+            a->primeira = -1;
+            e->usadas_alunos++;
+            return a;
+        }
+    }
+    return NULL;
+}
+
+static EntradaFiltro* entradaFiltro(EstadoAgregados *e, uint64_t chave, int criar) {
+    if (criar && e->usadas_filtros >= ENTRADAS_FILTRO / 4 * 3) {
+        reorganizarFiltros(e);
+    }
+    uint32_t i = (uint32_t)chave & (ENTRADAS_FILTRO - 1);
+    for (int sondas = 0; sondas < ENTRADAS_FILTRO; sondas++, i = (i + 1) & (ENTRADAS_FILTRO - 1)) {
+        EntradaFiltro *f = &e->filtros[i];
+        if (f->chave == chave) {
+            return f;
+        }
+        if (f->chave == 0) {
+            if (!criar) {
+                return NULL;
+            }
+            f->chave = chave;
+            f->turmas = 0;
+            e->usadas_filtros++;
+            return f;
+        }
+    }
+    return NULL;
+}
+
+// Reinsere só as entradas que ainda contam
+static void reorganizarTurmas(EstadoAgregados *e) {
+    EntradaTurma *copia = malloc(sizeof(e->turmas));
+    if (copia == NULL) {
+        return;
+    }
+    memcpy(copia, e->turmas, sizeof(e->turmas));
+    memset(e->turmas, 0, sizeof(e->turmas));
+    e->usadas_turmas = 0;
+    for (int i = 0; i < ENTRADAS_TURMA; i++) {
+        if (copia[i].usada && !turmaZerada(&copia[i].valores)) {
+            entradaTurma(e, copia[i].id_turma, 1)->valores = copia[i].valores;
+        }
+    }
+    free(copia);
+}
+
+static void reorganizarAlunos(EstadoAgregados *e) {
+    EntradaAluno *copia = malloc(sizeof(e->alunos));
+    if (copia == NULL) {
+        return;
+    }
+    memcpy(copia, e->alunos, sizeof(e->alunos));
+    memset(e->alunos, 0, sizeof(e->alunos));
+    e->usadas_alunos = 0;
+    for (int i = 0; i < ENTRADAS_ALUNO; i++) {
+        if (copia[i].usada && (copia[i].cadastrado || copia[i].primeira >= 0)) {
+            *entradaAluno(e, copia[i].ra, 1) = copia[i];
+        }
+    }
+    free(copia);
+}
+
+static void reorganizarFiltros(EstadoAgregados *e) {
+    EntradaFiltro *copia = malloc(sizeof(e->filtros));
+    if (copia == NULL) {
+        return;
+    }
+    memcpy(copia, e->filtros, sizeof(e->filtros));
+    memset(e->filtros, 0, sizeof(e->filtros));
+    e->usadas_filtros = 0;
+    for (int i = 0; i < ENTRADAS_FILTRO; i++) {
+        if (copia[i].chave != 0 && copia[i].turmas != 0) {
+            entradaFiltro(e, copia[i].chave, 1)->turmas = copia[i].turmas;
+        }
+    }
+    free(copia);
+}
+
+static void somarTurma(EstadoAgregados *e, int id_turma, int aulas, int atividades, int alunos, int ativos) {
+    EntradaTurma *t = entradaTurma(e, id_turma, 1);
+    if (t != NULL) {
+        t->valores.aulas += aulas;
+        t->valores.atividades += atividades;
+        t->valores.alunos += alunos;
+        t->valores.alunos_ativos += ativos;
+    }
+}
+
+// FNV-1a de 64 bits; professor NULL (curinga) difere de professor ""
+static uint64_t chaveFiltro(const char *professor, int ano, int semestre) {
+    uint64_t h = 1469598103934665603ULL;
+
+    if (professor != NULL) {
+        h = (h ^ 1u) * 1099511628211ULL;
+        for (const unsigned char *p = (const unsigned char *)professor; *p; p++) {
+            h = (h ^ *p) * 1099511628211ULL;
+        }
+    }
+    h = (h ^ 0xffu) * 1099511628211ULL;
+    h = (h ^ (uint32_t)ano) * 1099511628211ULL;
+    h = (h ^ (uint32_t)semestre) * 1099511628211ULL;
+    return h ? h : 1;
+}
+
+// A turma entra nas chaves com e sem cada campo (ano/semestre 0 já são o curinga)
+static void somarFiltros(EstadoAgregados *e, const Turma *turma, int delta) {
+    for (int mascara = 0; mascara < 8; mascara++) {
+        if (((mascara & 2) && turma->ano == 0) || ((mascara & 4) && turma->semestre == 0)) {
+            continue;
+        }
+        uint64_t chave = chaveFiltro((mascara & 1) ? turma->professor : NULL,
+                                     (mascara & 2) ? turma->ano : 0,
+                                     (mascara & 4) ? turma->semestre : 0);
+        EntradaFiltro *f = entradaFiltro(e, chave, 1);
+        if (f != NULL) {
+            f->turmas += delta;
+        }
+    }
+}
+
+// Atualiza o estado do RA e as turmas em que ele está matriculado
+static void ajustarAluno(EstadoAgregados *e, EntradaAluno *a, int cadastrado, int ativo) {
+    int contava = a->cadastrado && a->ativo;
+    int conta = cadastrado && ativo;
+
+    a->cadastrado = cadastrado;
+    a->ativo = ativo;
+    if (conta != contava) {
+        for (int no = a->primeira; no >= 0; no = e->nos[no].proximo) {
+            somarTurma(e, e->nos[no].id_turma, 0, 0, 0, conta - contava);
+        }
+    }
+}
+
+static void definirAluno(EstadoAgregados *e, int ra, int cadastrado, int ativo) {
+    EntradaAluno *a = entradaAluno(e, ra, 1);
+    if (a != NULL) {
+        ajustarAluno(e, a, cadastrado, ativo);
+    }
+}
+
+static void incluirMatricula(EstadoAgregados *e, int ra, int id_turma) {
+    EntradaAluno *a = entradaAluno(e, ra, 1);
+    if (a == NULL) {
+        return;
+    }
+
+    int no = e->livre;
+    if (no >= 0) {
+        e->livre = e->nos[no].proximo;
+    } else if (e->nunca_usado < NOS_MATRICULA) {
+        no = e->nunca_usado++;
+    }
+    // Sem nó (mais matrículas que a tabela comporta) a turma ainda conta o aluno
+    if (no >= 0) {
+        e->nos[no].id_turma = id_turma;
+        e->nos[no].proximo = a->primeira;
+        a->primeira = no;
+    }
+
+    somarTurma(e, id_turma, 0, 0, 1, (a->cadastrado && a->ativo) ? 1 : 0);
+    e->totais.matriculas++;
+}
+
+static void removerMatricula(EstadoAgregados *e, int ra, int id_turma) {
+    EntradaAluno *a = entradaAluno(e, ra, 0);
+    if (a == NULL) {
+        return;
+    }
+
+    for (int *elo = &a->primeira; *elo >= 0; elo = &e->nos[*elo].proximo) {
+        if (e->nos[*elo].id_turma == id_turma) {
+            int no = *elo;
+            *elo = e->nos[no].proximo;
+            e->nos[no].proximo = e->livre;
+            e->livre = no;
+
+            somarTurma(e, id_turma, 0, 0, -1, (a->cadastrado && a->ativo) ? -1 : 0);
+            e->totais.matriculas--;
+            return;
+        }
+    }
+}
+
+// ---------- Reconstrução de cada tabela (trava dos agregados obtida) ----------
+
+static void reconstruirAlunos(EstadoAgregados *e, const Aluno *alunos, int total) {
+    // Todos deixam de contar como ativos; cada aluno volta com o estado da tabela
+    for (int i = 0; i < ENTRADAS_ALUNO; i++) {
+        if (e->alunos[i].usada) {
+            ajustarAluno(e, &e->alunos[i], 0, 0);
+        }
+    }
+    e->totais.alunos = total;
+    e->totais.alunos_ativos = 0;
+    for (int i = 0; i < total; i++) {
+        definirAluno(e, alunos[i].ra, 1, alunos[i].ativo != 0);
+        e->totais.alunos_ativos += (alunos[i].ativo != 0);
+    }
+}
+
+static void reconstruirTurmas(EstadoAgregados *e, const Turma *turmas, int total) {
+    memset(e->filtros, 0, sizeof(e->filtros));
+    e->usadas_filtros = 0;
+    e->totais.turmas = total;
+    for (int i = 0; i < total; i++) {
+        somarFiltros(e, &turmas[i], 1);
+    }
+}
+
+static void reconstruirAulas(EstadoAgregados *e, const Aula *aulas, int total) {
+    for (int i = 0; i < ENTRADAS_TURMA; i++) {
+        e->turmas[i].valores.aulas = 0;
+    }
+    e->totais.aulas = total;
+    for (int i = 0; i < total; i++) {
+        somarTurma(e, aulas[i].id_turma, 1, 0, 0, 0);
+    }
+}
+
+static void reconstruirAtividades(EstadoAgregados *e, const Atividade *atividades, int total) {
+    for (int i = 0; i < ENTRADAS_TURMA; i++) {
+        e->turmas[i].valores.atividades = 0;
+    }
+    e->totais.atividades = total;
+    for (int i = 0; i < total; i++) {
+        somarTurma(e, atividades[i].id_turma, 0, 1, 0, 0);
+    }
+}
+
+static void reconstruirMatriculas(EstadoAgregados *e, const AlunoTurma *matriculas, int total) {
+    for (int i = 0; i < ENTRADAS_TURMA; i++) {
+        e->turmas[i].valores.alunos = 0;
+        e->turmas[i].valores.alunos_ativos = 0;
+    }
+    for (int i = 0; i < ENTRADAS_ALUNO; i++) {
+        e->alunos[i].primeira = -1;
+    }
+    e->livre = -1;
+    e->nunca_usado = 0;
+    e->totais.matriculas = 0;
+    for (int i = 0; i < total; i++) {
+        incluirMatricula(e, matriculas[i].ra, matriculas[i].id_turma);
+    }
+}
+
+// Conta as turmas e chaves de filtro com valores diferentes
+static int compararEstados(EstadoAgregados *a, EstadoAgregados *b) {
+    const AgregadoTurma zerado = {0, 0, 0, 0};
+    int divergencias = 0;
+
+    divergencias += (a->totais.alunos != b->totais.alunos);
+    divergencias += (a->totais.alunos_ativos != b->totais.alunos_ativos);
+    divergencias += (a->totais.turmas != b->totais.turmas);
+    divergencias += (a->totais.aulas != b->totais.aulas);
+    divergencias += (a->totais.atividades != b->totais.atividades);
+    divergencias += (a->totais.matriculas != b->totais.matriculas);
+
+    for (int lado = 0; lado < 2; lado++) {
+        EstadoAgregados *um = lado ? b : a;
+        EstadoAgregados *outro = lado ? a : b;
+
+        for (int i = 0; i < ENTRADAS_TURMA; i++) {
+            if (!um->turmas[i].usada) {
+                continue;
+            }
+            const EntradaTurma *par = entradaTurma(outro, um->turmas[i].id_turma, 0);
+            const AgregadoTurma *v = par ? &par->valores : &zerado;
+            // Entradas presentes dos dois lados são contadas uma vez (lado 0)
+            if ((lado == 0 || par == NULL) && memcmp(v, &um->turmas[i].valores, sizeof(*v)) != 0) {
+                divergencias++;
+            }
+        }
+        for (int i = 0; i < ENTRADAS_FILTRO; i++) {
+            if (um->filtros[i].chave == 0) {
+                continue;
+            }
+            const EntradaFiltro *par = entradaFiltro(outro, um->filtros[i].chave, 0);
+            if ((lado == 0 || par == NULL) && (par ? par->turmas : 0) != um->filtros[i].turmas) {
+                divergencias++;
+            }
+        }
+    }
+    return divergencias;
+}
+
+// ========== MANUTENÇÃO ==========
+
+void agregarAluno(const Aluno *antes, const Aluno *depois) {
+    pthread_mutex_lock(&trava_agregados);
+    EstadoAgregados *e = estadoDaThread(1);
+
+    if (antes != NULL) {
+        e->totais.alunos--;
+        e->totais.alunos_ativos -= (antes->ativo != 0);
+        if (depois == NULL || depois->ra != antes->ra) {
+            definirAluno(e, antes->ra, 0, 0);
+        }
+    }
+    if (depois != NULL) {
+        e->totais.alunos++;
+        e->totais.alunos_ativos += (depois->ativo != 0);
+        definirAluno(e, depois->ra, 1, depois->ativo != 0);
+    }
+
+    pthread_mutex_unlock(&trava_agregados);
+}
+
+void agregarTurma(const Turma *antes, const Turma *depois) {
+    pthread_mutex_lock(&trava_agregados);
+    EstadoAgregados *e = estadoDaThread(1);
+
+    if (antes != NULL) {
+        e->totais.turmas--;
+        somarFiltros(e, antes, -1);
+    }
+    if (depois != NULL) {
+        e->totais.turmas++;
+        somarFiltros(e, depois, 1);
+    }
+
+    pthread_mutex_unlock(&trava_agregados);
+}
+
+void agregarAula(const Aula *antes, const Aula *depois) {
+    pthread_mutex_lock(&trava_agregados);
+    EstadoAgregados *e = estadoDaThread(1);
+
+    if (antes != NULL) {
+        e->totais.aulas--;
+        somarTurma(e, antes->id_turma, -1, 0, 0, 0);
+    }
+    if (depois != NULL) {
+        e->totais.aulas++;
+        somarTurma(e, depois->id_turma, 1, 0, 0, 0);
+    }
+
+    pthread_mutex_unlock(&trava_agregados);
+}
+
+void agregarAtividade(const Atividade *antes, const Atividade *depois) {
+    pthread_mutex_lock(&trava_agregados);
+    EstadoAgregados *e = estadoDaThread(1);
+
+    if (antes != NULL) {
+        e->totais.atividades--;
+        somarTurma(e, antes->id_turma, 0, -1, 0, 0);
+    }
+    if (depois != NULL) {
+        e->totais.atividades++;
+        somarTurma(e, depois->id_turma, 0, 1, 0, 0);
+    }
+
+    pthread_mutex_unlock(&trava_agregados);
+}
+
+void agregarMatricula(const AlunoTurma *antes, const AlunoTurma *depois) {
+    pthread_mutex_lock(&trava_agregados);
+    EstadoAgregados *e = estadoDaThread(1);
+
+    if (antes != NULL) {
+        removerMatricula(e, antes->ra, antes->id_turma);
+    }
+    if (depois != NULL) {
+        incluirMatricula(e, depois->ra, depois->id_turma);
+    }
+
+    pthread_mutex_unlock(&trava_agregados);
+}
+
+void reconstruirAgregadosAlunos(const Aluno *alunos, int total) {
+    pthread_mutex_lock(&trava_agregados);
+    garantirIniciado();
+    reconstruirAlunos(&vivo, alunos, total);
+    if (estadoDaThread(0) != &vivo) {
+        reconstruirAlunos(&da_transacao, alunos, total);
+    }
+    pthread_mutex_unlock(&trava_agregados);
+}
+
+void reconstruirAgregadosTurmas(const Turma *turmas, int total) {
+    pthread_mutex_lock(&trava_agregados);
+    garantirIniciado();
+    reconstruirTurmas(&vivo, turmas, total);
+    if (estadoDaThread(0) != &vivo) {
+        reconstruirTurmas(&da_transacao, turmas, total);
+    }
+    pthread_mutex_unlock(&trava_agregados);
+}
+
+void reconstruirAgregadosAulas(const Aula *aulas, int total) {
+    pthread_mutex_lock(&trava_agregados);
+    garantirIniciado();
+    reconstruirAulas(&vivo, aulas, total);
+    if (estadoDaThread(0) != &vivo) {
+        reconstruirAulas(&da_transacao, aulas, total);
+    }
+    pthread_mutex_unlock(&trava_agregados);
+}
+
+void reconstruirAgregadosAtividades(const Atividade *atividades, int total) {
+    pthread_mutex_lock(&trava_agregados);
+    garantirIniciado();
+    reconstruirAtividades(&vivo, atividades, total);
+    if (estadoDaThread(0) != &vivo) {
+        reconstruirAtividades(&da_transacao, atividades, total);
+    }
+    pthread_mutex_unlock(&trava_agregados);
+}
+
+void reconstruirAgregadosMatriculas(const AlunoTurma *matriculas, int total) {
+    pthread_mutex_lock(&trava_agregados);
+    garantirIniciado();
+    reconstruirMatriculas(&vivo, matriculas, total);
+    if (estadoDaThread(0) != &vivo) {
+        reconstruirMatriculas(&da_transacao, matriculas, total);
+    }
+    pthread_mutex_unlock(&trava_agregados);
+}
+
+// ========== LEITURA ==========
+
+void lerAgregadoTurma(int id_turma, AgregadoTurma *destino) {
+    pthread_mutex_lock(&trava_agregados);
+    EstadoAgregados *e = estadoDaThread(0);
+
+    const EntradaTurma *t = entradaTurma(e, id_turma, 0);
+    if (t != NULL) {
+        *destino = t->valores;
+    } else {
+        memset(destino, 0, sizeof(*destino));
+    }
+
+    pthread_mutex_unlock(&trava_agregados);
+}
+
+int lerTurmasAgregadas(const char *professor, int ano, int semestre) {
+    uint64_t chave = chaveFiltro(professor, ano, semestre);
+
+    pthread_mutex_lock(&trava_agregados);
+    EstadoAgregados *e = estadoDaThread(0);
+    const EntradaFiltro *f = entradaFiltro(e, chave, 0);
+    int total = f ? f->turmas : 0;
+    pthread_mutex_unlock(&trava_agregados);
+
+    return total;
+}
+
+void lerTotaisAgregados(TotaisAgregados *destino) {
+    pthread_mutex_lock(&trava_agregados);
+    EstadoAgregados *e = estadoDaThread(0);
+    *destino = e->totais;
+    pthread_mutex_unlock(&trava_agregados);
+}
+
+// ========== VERIFICAÇÃO ==========
+
+int verificarAgregados(int reconstruir) {
+    EstadoAgregados *novo = malloc(sizeof(EstadoAgregados));
+    Aluno *alunos = malloc(sizeof(Aluno) * MAX_ALUNOS);
+    Turma *turmas = malloc(sizeof(Turma) * MAX_TURMAS);
+    Aula *aulas = malloc(sizeof(Aula) * MAX_AULAS);
+    Atividade *atividades = malloc(sizeof(Atividade) * MAX_ATIVIDADES);
+    AlunoTurma *matriculas = malloc(sizeof(AlunoTurma) * MAX_MATRICULAS);
+    int divergencias = -1;
+
+    if (novo != NULL && alunos != NULL && turmas != NULL && aulas != NULL && atividades != NULL &&
+        matriculas != NULL) {
+        // As listagens podem recarregar CSVs (e reconstruir partes do estado
+        // vivo): nada aqui pode estar com a trava dos agregados
+        int total_alunos = listarAlunos(alunos, MAX_ALUNOS);
+        int total_turmas = listarTurmas(turmas, MAX_TURMAS);
+        int total_aulas = listarTodasAulas(aulas, MAX_AULAS);
+        int total_atividades = listarAtividades(atividades, MAX_ATIVIDADES);
+        int total_matriculas = listarMatriculas(matriculas, MAX_MATRICULAS);
+
+        limparEstado(novo);
+        reconstruirAlunos(novo, alunos, total_alunos);
+        reconstruirTurmas(novo, turmas, total_turmas);
+        reconstruirAulas(novo, aulas, total_aulas);
+        reconstruirAtividades(novo, atividades, total_atividades);
+        reconstruirMatriculas(novo, matriculas, total_matriculas);
+
+        pthread_mutex_lock(&trava_agregados);
+        garantirIniciado();
+        divergencias = compararEstados(&vivo, novo);
+        if (reconstruir && divergencias > 0) {
+            memcpy(&vivo, novo, sizeof(EstadoAgregados));
+        }
+        pthread_mutex_unlock(&trava_agregados);
+    }
+
+    free(novo);
+    free(alunos);
+    free(turmas);
+    free(aulas);
+    free(atividades);
+    free(matriculas);
+    return divergencias;
+}
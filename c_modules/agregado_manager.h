@@ -0,0 +1,83 @@
+#ifndef AGREGADO_MANAGER_H
+#define AGREGADO_MANAGER_H
+
+#include "structs.h"
+
+// ========== VISÕES AGREGADAS ==========
+//
+// Contadores materializados das tabelas em memória, lidos em O(1):
+// - por turma: aulas, atividades, alunos matriculados e matriculados ativos;
+// - turmas por professor, ano e semestre, em qualquer combinação (cada turma
+//   soma nas 8 chaves com e sem cada campo);
+// - total de registros de cada tabela.
+//
+// Os módulos de cadastro chamam agregarX(antes, depois) com a trava de
+// escrita da própria tabela em toda inclusão (antes = NULL), alteração ou
+// exclusão (depois = NULL), e reconstruirAgregadosX() sempre que o CSV é
+// (re)carregado, inclusive quando outro processo o alterou. Dentro de uma
+// transação (tabela_manager.h), agregarX() altera uma cópia que só a thread
+// dela lê; os demais veem o estado confirmado até o módulo reconstruir a
+// tabela depois da confirmação.
+//
+// "Ativo" cruza duas tabelas: o módulo guarda, por RA, o estado do aluno e a
+// lista das turmas em que está matriculado, de modo que desativar um aluno
+// ajusta só as turmas dele e matricular consulta o estado sem abrir alunos.
+//
+// As consultas públicas ficam nos módulos (contarAulasDaTurma(),
+// contarTurmasPor(), ...), que conferem o CSV antes de ler o contador.
+
+// Contadores de uma turma
+typedef struct {
+    int aulas;
+    int atividades;
+    int alunos;                // Matrículas na turma
+    int alunos_ativos;         // Matrículas de alunos com ativo = 1
+} AgregadoTurma;
+
+// Total de registros de cada tabela
+typedef struct {
+    int alunos;
+    int alunos_ativos;
+    int turmas;
+    int aulas;
+    int atividades;
+    int matriculas;
+} TotaisAgregados;
+
+// ========== MANUTENÇÃO (CHAMADA PELOS MÓDULOS) ==========
+
+// Funções para aplicar uma alteração (antes = NULL inclui, depois = NULL exclui)
+void agregarAluno(const Aluno *antes, const Aluno *depois);
+void agregarTurma(const Turma *antes, const Turma *depois);
+void agregarAula(const Aula *antes, const Aula *depois);
+void agregarAtividade(const Atividade *antes, const Atividade *depois);
+void agregarMatricula(const AlunoTurma *antes, const AlunoTurma *depois);
+
+// Funções para recalcular a parte de uma tabela depois de recarregá-la
+void reconstruirAgregadosAlunos(const Aluno *alunos, int total);
+void reconstruirAgregadosTurmas(const Turma *turmas, int total);
+void reconstruirAgregadosAulas(const Aula *aulas, int total);
+void reconstruirAgregadosAtividades(const Atividade *atividades, int total);
+void reconstruirAgregadosMatriculas(const AlunoTurma *matriculas, int total);
+
+// ========== LEITURA ==========
+
+// Função para ler os contadores de uma turma (zeros se não houver registros)
+void lerAgregadoTurma(int id_turma, AgregadoTurma *destino);
+
+// Função para ler o total de turmas com o professor/ano/semestre
+// professor NULL, ano 0 ou semestre 0 não filtram aquele campo
+int lerTurmasAgregadas(const char *professor, int ano, int semestre);
+
+// Função para ler o total de registros das tabelas
+void lerTotaisAgregados(TotaisAgregados *destino);
+
+// ========== VERIFICAÇÃO ==========
+
+// Função para recalcular tudo do zero a partir das listagens dos módulos e
+// comparar com os contadores mantidos; com "reconstruir", os recalculados
+// passam a valer. Supõe que não há escritas durante a chamada.
+// Retorna: número de contadores divergentes (-1 se faltou memória)
+int verificarAgregados(int reconstruir);
+
+#endif
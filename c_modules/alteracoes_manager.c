@@ -0,0 +1,1153 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include "alteracoes_manager.h"
+#include "tabela_manager.h"
+#include "journal_manager.h"
+#include "structs.h"
+
+#ifdef _WIN32
+#include <io.h>
+#include <process.h>
+#define close _close
+#define open _open
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+// Tabelas registradas e quantos campos formam a chave de cada uma
+static const struct {
+    const char *nome;
+    int campos;
+} tabelas_registradas[] = {
+    {"alunos.csv", 1}, {"turmas.csv", 1}, {"aulas.csv", 1}, {"aluno_turma.csv", 2},
+    {"atividades.csv", 1}, {"notas.csv", 2}, {"usuarios.csv", 1}
+};
+
+#define TOTAL_TABELAS_REGISTRADAS ((int)(sizeof(tabelas_registradas) / sizeof(tabelas_registradas[0])))
+
+// Texto que cresce conforme as operações são acrescentadas
+typedef struct {
+    char *dados;
+    size_t tamanho;
+    size_t capacidade;
+    int erro;
+} Texto;
+
+// Operações preparadas de um CSV, à espera de marcarTabelaSalva()
+typedef struct {
+    char arquivo[MAX_PATH];
+    Texto operacoes;               // "op;anterior;linha\n" (sem sequência, tabela e geração)
+    long total;
+    int ocupada;
+} AlteracoesPendentes;
+
+// Uma por CSV: só o dono da trava exclusiva do arquivo mexe no conteúdo
+static AlteracoesPendentes pendentes[MAX_TABELAS_TRANSACAO];
+static pthread_mutex_t trava_pendentes = PTHREAD_MUTEX_INITIALIZER;
+
+// Índice chave -> linha por endereçamento aberto; a chave é o começo da linha
+typedef struct {
+    int32_t *posicoes;             // -1 vazia, -2 removida, senão índice da linha
+    size_t capacidade;             // Potência de 2
+    size_t ocupadas;               // Inclui as removidas
+} IndiceChaves;
+
+#define POSICAO_VAZIA (-1)
+#define POSICAO_REMOVIDA (-2)
+
+struct ConteudoTabela {
+    int campos;
+    int tem_cabecalho;
+    const char *cabecalho;
+    size_t tamanho_cabecalho;
+    const char **linhas;           // Nós (inclusive os já removidos da lista)
+    uint32_t *tamanhos;
+    uint32_t *chaves;              // Tamanho da chave; 0 = linha fora do índice
+    int32_t *anteriores;
+    int32_t *proximos;
+    size_t total;
+    size_t capacidade;
+    long long ativas;
+    int32_t primeira;
+    int32_t ultima;
+    IndiceChaves indice;
+};
+
+// ========== FUNÇÕES AUXILIARES PRIVADAS ==========
+
+static const char *nomeDoArquivo(const char *arquivo) {
+    const char *barra = strrchr(arquivo, '/');
+    const char *invertida = strrchr(arquivo, '\\');
+    if (invertida != NULL && (barra == NULL || invertida > barra)) {
+        barra = invertida;
+    }
+    return (barra != NULL) ? barra + 1 : arquivo;
+}
+
+// "<diretório do arquivo>/alteracoes.log"
+static void caminhoDoLog(char *destino, size_t tamanho, const char *arquivo) {
+    const char *nome = nomeDoArquivo(arquivo);
+    snprintf(destino, tamanho, "%.*s%s", (int)(nome - arquivo), arquivo, ARQUIVO_ALTERACOES);
+}
+
+static void acrescentarTexto(Texto *texto, const char *dados, size_t tamanho) {
+    if (texto->erro) {
+        return;
+    }
+    if (texto->tamanho + tamanho + 1 > texto->capacidade) {
+        size_t capacidade = (texto->capacidade > 0) ? texto->capacidade : 4096;
+        while (texto->tamanho + tamanho + 1 > capacidade) {
+            capacidade *= 2;
+        }
+        char *maior = realloc(texto->dados, capacidade);
+        if (maior == NULL) {
+            texto->erro = 1;
+            return;
+        }
+        texto->dados = maior;
+        texto->capacidade = capacidade;
+    }
+    memcpy(texto->dados + texto->tamanho, dados, tamanho);
+    texto->tamanho += tamanho;
+    texto->dados[texto->tamanho] = '\0';
+}
+
+static void liberarTexto(Texto *texto) {
+    free(texto->dados);
+    memset(texto, 0, sizeof(*texto));
+}
+
+// "op;anterior;linha\n"
+static void acrescentarOperacao(Texto *texto, char operacao, const char *anterior, size_t tamanho_anterior,
+                                const char *linha, size_t tamanho_linha) {
+    char prefixo[2] = {operacao, ';'};
+    acrescentarTexto(texto, prefixo, sizeof(prefixo));
+    acrescentarTexto(texto, anterior, tamanho_anterior);
+    acrescentarTexto(texto, ";", 1);
+    acrescentarTexto(texto, linha, tamanho_linha);
+    acrescentarTexto(texto, "\n", 1);
+}
+
+// Lê o arquivo inteiro (terminado em '\0')
+// Retorna: buffer (malloc) ou NULL se não existe ou não pôde ser lido
+static char *lerArquivoInteiro(const char *caminho, size_t *tamanho) {
+    FILE *arquivo = fopen(caminho, "rb");
+    char *dados = NULL;
+    long fim;
+
+    if (arquivo == NULL) {
+        return NULL;
+    }
+    if (fseek(arquivo, 0, SEEK_END) == 0 && (fim = ftell(arquivo)) >= 0 && fseek(arquivo, 0, SEEK_SET) == 0) {
+        dados = malloc((size_t)fim + 1);
+        if (dados != NULL && fread(dados, 1, (size_t)fim, arquivo) != (size_t)fim) {
+            free(dados);
+            dados = NULL;
+        }
+        if (dados != NULL) {
+            dados[fim] = '\0';
+            *tamanho = (size_t)fim;
+        }
+    }
+    fclose(arquivo);
+    return dados;
+}
+
+// Tamanho do prefixo com os "campos" primeiros campos (sem a vírgula final)
+// Retorna: tamanho da chave, 0 se a linha tem campos de menos
+static uint32_t tamanhoChave(const char *linha, size_t tamanho, int campos) {
+    int virgulas = 0;
+
+    for (size_t i = 0; i < tamanho; i++) {
+        if (linha[i] == ',' && ++virgulas == campos) {
+            return (uint32_t)i;
+        }
+    }
+    // Linha só com a chave (ex.: aluno_turma "RA,ID_Turma")
+    return (tamanho > 0 && virgulas == campos - 1) ? (uint32_t)tamanho : 0;
+}
+
+// Quebra "dados" em linhas (sem o '\n'); a primeira é o cabeçalho
+// Retorna: linhas encontradas, -1 se faltou memória
+static long dividirLinhas(const char *dados, size_t tamanho, const char ***linhas, uint32_t **tamanhos) {
+    long total = 0;
+    long capacidade = 1024;
+    size_t inicio = 0;
+
+    *linhas = malloc(sizeof(const char *) * (size_t)capacidade);
+    *tamanhos = malloc(sizeof(uint32_t) * (size_t)capacidade);
+    if (*linhas == NULL || *tamanhos == NULL) {
+        return -1;
+    }
+
+    while (inicio < tamanho) {
+        const char *quebra = memchr(dados + inicio, '\n', tamanho - inicio);
+        size_t fim = (quebra != NULL) ? (size_t)(quebra - dados) : tamanho;
+
+        if (total == capacidade) {
+            capacidade *= 2;
+            const char **mais_linhas = realloc(*linhas, sizeof(const char *) * (size_t)capacidade);
+            if (mais_linhas != NULL) {
+                *linhas = mais_linhas;
+            }
+            uint32_t *mais_tamanhos = realloc(*tamanhos, sizeof(uint32_t) * (size_t)capacidade);
+            if (mais_tamanhos != NULL) {
+                *tamanhos = mais_tamanhos;
+            }
+            if (mais_linhas == NULL || mais_tamanhos == NULL) {
+                return -1;
+            }
+        }
+        (*linhas)[total] = dados + inicio;
+        (*tamanhos)[total] = (uint32_t)(fim - inicio);
+        total++;
+        inicio = fim + 1;
+    }
+    return total;
+}
+
+// ========== ÍNDICE DE CHAVES ==========
+
+// FNV-1a
+static uint32_t hashChave(const char *chave, size_t tamanho) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < tamanho; i++) {
+        hash = (hash ^ (unsigned char)chave[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static int criarIndice(IndiceChaves *indice, size_t esperadas) {
+    size_t capacidade = 64;
+    while (capacidade < esperadas * 2) {
+        capacidade *= 2;
+    }
+    indice->posicoes = malloc(sizeof(int32_t) * capacidade);
+    if (indice->posicoes == NULL) {
+        return 0;
+    }
+    memset(indice->posicoes, 0xFF, sizeof(int32_t) * capacidade);  // POSICAO_VAZIA
+    indice->capacidade = capacidade;
+    indice->ocupadas = 0;
+    return 1;
+}
+
+// Retorna: posição no índice da chave, ou -1 se ausente
+static long long procurarChave(const IndiceChaves *indice, const char *const *linhas, const uint32_t *chaves,
+                               const char *chave, size_t tamanho) {
+    size_t mascara = indice->capacidade - 1;
+    size_t i = hashChave(chave, tamanho) & mascara;
+
+    for (;;) {
+        int32_t posicao = indice->posicoes[i];
+        if (posicao == POSICAO_VAZIA) {
+            return -1;
+        }
+        if (posicao >= 0 && chaves[posicao] == tamanho && memcmp(linhas[posicao], chave, tamanho) == 0) {
+            return (long long)i;
+        }
+        i = (i + 1) & mascara;
+    }
+}
+
+// Coloca "valor" no índice (a chave não pode estar nele)
+static void colocarChave(IndiceChaves *indice, const char *chave, size_t tamanho, int32_t valor) {
+    size_t mascara = indice->capacidade - 1;
+    size_t i = hashChave(chave, tamanho) & mascara;
+
+    while (indice->posicoes[i] >= 0) {
+        i = (i + 1) & mascara;
+    }
+    if (indice->posicoes[i] == POSICAO_VAZIA) {
+        indice->ocupadas++;
+    }
+    indice->posicoes[i] = valor;
+}
+
+// Dobra (ou limpa as removidas) quando metade das posições está ocupada
+static int garantirEspacoIndice(IndiceChaves *indice, const char *const *linhas, const uint32_t *chaves) {
+    IndiceChaves novo;
+
+    size_t vivas = 0;
+
+    if ((indice->ocupadas + 1) * 2 <= indice->capacidade) {
+        return 1;
+    }
+    for (size_t i = 0; i < indice->capacidade; i++) {
+        vivas += (indice->posicoes[i] >= 0);
+    }
+    if (!criarIndice(&novo, vivas * 2 + 16)) {
+        return 0;
+    }
+    for (size_t i = 0; i < indice->capacidade; i++) {
+        int32_t posicao = indice->posicoes[i];
+        if (posicao >= 0) {
+            colocarChave(&novo, linhas[posicao], chaves[posicao], posicao);
+        }
+    }
+    free(indice->posicoes);
+    *indice = novo;
+    return 1;
+}
+
+// ========== COMPARAÇÃO DO CSV ANTIGO COM O TEMPORÁRIO ==========
+
+// Tabela recriada: cabeçalho + todas as linhas na ordem
+static void compararRecriando(Texto *saida, long *total, const char **linhas, const uint32_t *tamanhos,
+                              long quantidade) {
+    acrescentarOperacao(saida, ALTERACAO_RECRIAR, "", 0, linhas[0], tamanhos[0]);
+    for (long j = 1; j < quantidade; j++) {
+        acrescentarOperacao(saida, ALTERACAO_ACRESCENTAR, "", 0, linhas[j], tamanhos[j]);
+    }
+    *total = quantidade;
+}
+
+// Classifica cada linha nova pela antiga de mesma chave
+// Retorna: 1 se classificou, 0 se a tabela precisa ser recriada
+static int associarChaves(const char **linhas, const uint32_t *tamanhos, uint32_t *chaves, int32_t *origens,
+                          unsigned char *marcas, IndiceChaves *indice, long antigas, long quantidade,
+                          int campos) {
+    int32_t ultima_mantida = -1;
+
+    // Chave vazia, com ';' (não cabe no campo "anterior") ou repetida: recria
+    chaves[0] = 0;
+    chaves[antigas] = 0;
+    for (long i = 1; i < quantidade; i++) {
+        if (i == antigas) {
+            continue;
+        }
+        chaves[i] = tamanhoChave(linhas[i], tamanhos[i], campos);
+        if (chaves[i] == 0 || memchr(linhas[i], ';', chaves[i]) != NULL) {
+            return 0;
+        }
+    }
+    for (long o = 1; o < antigas; o++) {
+        if (procurarChave(indice, linhas, chaves, linhas[o], chaves[o]) >= 0) {
+            return 0;
+        }
+        colocarChave(indice, linhas[o], chaves[o], (int32_t)o);
+    }
+
+    for (long j = antigas + 1; j < quantidade; j++) {
+        long long posicao = procurarChave(indice, linhas, chaves, linhas[j], chaves[j]);
+        int32_t valor = (posicao >= 0) ? indice->posicoes[posicao] : -1;
+
+        origens[j] = -1;
+        if (valor >= antigas || (valor >= 0 && marcas[valor])) {
+            return 0;
+        }
+        if (valor < 0) {
+            colocarChave(indice, linhas[j], chaves[j], (int32_t)j);
+            continue;
+        }
+        origens[j] = valor;
+        // Fora da ordem das que ficaram: sai de onde estava e entra no lugar novo
+        if (valor > ultima_mantida) {
+            ultima_mantida = valor;
+            marcas[valor] = 1;
+        } else {
+            marcas[valor] = 2;
+        }
+    }
+    return 1;
+}
+
+// Compara por chave; as linhas antigas vêm antes das novas em "linhas"
+// (marcas da antiga: 0 apagada, 1 mantida no lugar, 2 mudou de lugar)
+// Retorna: 1 se comparou, 0 se a tabela precisa ser recriada, -1 se faltou memória
+static int compararPorChave(Texto *saida, long *total, const char **linhas, const uint32_t *tamanhos,
+                            long antigas, long novas, int campos) {
+    long quantidade = antigas + novas;
+    uint32_t *chaves = malloc(sizeof(uint32_t) * (size_t)quantidade);
+    int32_t *origens = malloc(sizeof(int32_t) * (size_t)quantidade);   // Nova -> antiga (-1 = inserida)
+    unsigned char *marcas = calloc((size_t)quantidade, 1);
+    IndiceChaves indice = {NULL, 0, 0};
+    int resultado = -1;
+
+    if (chaves != NULL && origens != NULL && marcas != NULL && criarIndice(&indice, (size_t)quantidade)) {
+        resultado = associarChaves(linhas, tamanhos, chaves, origens, marcas, &indice, antigas, quantidade,
+                                   campos);
+    }
+
+    if (resultado == 1) {
+        long operacoes = 0;
+        for (long o = 1; o < antigas; o++) {
+            if (marcas[o] != 1) {
+                acrescentarOperacao(saida, ALTERACAO_EXCLUIR, "", 0, linhas[o], tamanhos[o]);
+                operacoes++;
+            }
+        }
+        for (long j = antigas + 1; j < quantidade; j++) {
+            int32_t origem = origens[j];
+            if (origem < 0 || marcas[origem] == 2) {
+                const char *anterior = (j > antigas + 1) ? linhas[j - 1] : "";
+                uint32_t tamanho_anterior = (j > antigas + 1) ? chaves[j - 1] : 0;
+                acrescentarOperacao(saida, ALTERACAO_INSERIR, anterior, tamanho_anterior, linhas[j], tamanhos[j]);
+                operacoes++;
+            } else if (tamanhos[origem] != tamanhos[j] || memcmp(linhas[origem], linhas[j], tamanhos[j]) != 0) {
+                acrescentarOperacao(saida, ALTERACAO_ATUALIZAR, "", 0, linhas[j], tamanhos[j]);
+                operacoes++;
+            }
+        }
+        *total = operacoes;
+    }
+
+    free(chaves);
+    free(origens);
+    free(marcas);
+    free(indice.posicoes);
+    return resultado;
+}
+
+// Retorna: slot das operações de "arquivo" (reservado se preciso), NULL se não há slot
+static AlteracoesPendentes *pendentesDoArquivo(const char *arquivo, int reservar) {
+    AlteracoesPendentes *livre = NULL;
+    AlteracoesPendentes *encontrado = NULL;
+
+    pthread_mutex_lock(&trava_pendentes);
+    for (int i = 0; i < MAX_TABELAS_TRANSACAO && encontrado == NULL; i++) {
+        if (pendentes[i].ocupada && strcmp(pendentes[i].arquivo, arquivo) == 0) {
+            encontrado = &pendentes[i];
+        } else if (!pendentes[i].ocupada && livre == NULL) {
+            livre = &pendentes[i];
+        }
+    }
+    if (encontrado == NULL && reservar && livre != NULL) {
+        snprintf(livre->arquivo, sizeof(livre->arquivo), "%s", arquivo);
+        livre->ocupada = 1;
+        encontrado = livre;
+    }
+    pthread_mutex_unlock(&trava_pendentes);
+    return encontrado;
+}
+
+static void liberarPendentes(AlteracoesPendentes *slot) {
+    liberarTexto(&slot->operacoes);
+    slot->total = 0;
+    pthread_mutex_lock(&trava_pendentes);
+    slot->ocupada = 0;
+    pthread_mutex_unlock(&trava_pendentes);
+}
+
+// ========== IMPLEMENTAÇÃO DAS FUNÇÕES PÚBLICAS ==========
+
+int camposChaveAlteracoes(const char *tabela) {
+    for (int i = 0; i < TOTAL_TABELAS_REGISTRADAS; i++) {
+        if (strcmp(tabelas_registradas[i].nome, tabela) == 0) {
+            return tabelas_registradas[i].campos;
+        }
+    }
+    return 0;
+}
+
+void prepararAlteracoesTabela(const char *arquivo) {
+    char temporario[MAX_PATH + 8];
+    char *novo;
+    size_t tamanho_novo = 0;
+
+    if (camposChaveAlteracoes(nomeDoArquivo(arquivo)) == 0) {
+        return;
+    }
+    snprintf(temporario, sizeof(temporario), "%s.tmp", arquivo);
+    novo = lerArquivoInteiro(temporario, &tamanho_novo);
+    prepararAlteracoesConteudo(arquivo, novo, tamanho_novo);
+    free(novo);
+}
+
+void prepararAlteracoesConteudo(const char *arquivo, const char *novo, size_t tamanho_novo) {
+    const char **linhas = NULL;
+    uint32_t *tamanhos = NULL;
+    char *antigo = NULL;
+    size_t tamanho_antigo = 0;
+    int campos = camposChaveAlteracoes(nomeDoArquivo(arquivo));
+
+    if (campos == 0) {
+        return;
+    }
+    descartarAlteracoesTabela(arquivo);
+
+    // Sem '\n' no fim, o CSV não seria reproduzido byte a byte: fica sem registro
+    if (novo == NULL || tamanho_novo == 0 || novo[tamanho_novo - 1] != '\n') {
+        return;
+    }
+    antigo = lerArquivoInteiro(arquivo, &tamanho_antigo);
+    if (antigo != NULL && (tamanho_antigo == 0 || antigo[tamanho_antigo - 1] != '\n')) {
+        tamanho_antigo = 0;        // Antigo irreconhecível: recria
+    }
+
+    // Antigas e novas no mesmo vetor: dividir um buffer só com as duas partes
+    size_t tamanho_junto = tamanho_antigo + tamanho_novo;
+    char *junto = malloc(tamanho_junto + 1);
+    long antigas = 0;
+    long quantidade = -1;
+    if (junto != NULL) {
+        if (tamanho_antigo > 0) {
+            memcpy(junto, antigo, tamanho_antigo);
+            antigas = dividirLinhas(junto, tamanho_antigo, &linhas, &tamanhos);
+            free(linhas);
+            free(tamanhos);
+        }
+        memcpy(junto + tamanho_antigo, novo, tamanho_novo);
+        quantidade = (antigas >= 0) ? dividirLinhas(junto, tamanho_junto, &linhas, &tamanhos) : -1;
+    }
+    free(antigo);
+
+    AlteracoesPendentes *slot = (quantidade > antigas) ? pendentesDoArquivo(arquivo, 1) : NULL;
+    if (slot != NULL) {
+        int comparado = 0;
+        if (antigas > 0 && tamanhos[0] == tamanhos[antigas] &&
+            memcmp(linhas[0], linhas[antigas], tamanhos[0]) == 0) {
+            comparado = compararPorChave(&slot->operacoes, &slot->total, linhas, tamanhos,
+                                         antigas, quantidade - antigas, campos);
+        }
+        if (comparado == 0) {
+            liberarTexto(&slot->operacoes);
+            compararRecriando(&slot->operacoes, &slot->total, linhas + antigas, tamanhos + antigas,
+                              quantidade - antigas);
+        }
+        if (comparado < 0 || slot->operacoes.erro) {
+            liberarPendentes(slot);
+        }
+    }
+
+    free(linhas);
+    free(tamanhos);
+    free(junto);
+}
+
+// Acrescenta "texto" ao log (exige a trava exclusiva dele)
+// Retorna: 1 se gravado, 0 se erro
+static int acrescentarAoLog(const char *caminho, const char *texto, size_t tamanho) {
+    FILE *log = fopen(caminho, "a+b");
+    int ok = (log != NULL);
+    if (ok) {
+        // Última gravação cortada no meio: a próxima começa numa linha nova
+        if (fseek(log, 0, SEEK_END) == 0 && ftell(log) > 0 && fseek(log, -1, SEEK_END) == 0 &&
+            fgetc(log) != '\n') {
+            fseek(log, 0, SEEK_END);
+            fputc('\n', log);
+        }
+        fseek(log, 0, SEEK_END);
+        ok = tamanho == 0 || fwrite(texto, 1, tamanho, log) == tamanho;
+    }
+    if (log != NULL) {
+        ok = (fclose(log) == 0) && ok;
+    }
+    return ok;
+}
+
+void registrarAlteracoesTabela(const char *arquivo, long long geracao) {
+    AlteracoesPendentes *slot = pendentesDoArquivo(arquivo, 0);
+    TravaArquivo trava = TRAVA_ARQUIVO_INIT;
+    char caminho[MAX_PATH + 32];
+    char prefixo[96];
+    Texto texto = {NULL, 0, 0, 0};
+    const char *tabela = nomeDoArquivo(arquivo);
+
+    if (slot == NULL) {
+        return;
+    }
+
+    caminhoDoLog(caminho, sizeof(caminho), arquivo);
+    if (!travarArquivo(&trava, caminho, TRAVA_EXCLUSIVA)) {
+        printf("Aviso: alterações de %s sem registro (trava do log).\n", arquivo);
+        liberarPendentes(slot);
+        return;
+    }
+
+    // Reserva as sequências antes de gravar: uma queda deixa só um buraco
+    long long sequencia = lerGeracaoArquivo(&trava);
+    avancarGeracaoArquivo(&trava, slot->total + 1);
+
+    const char *operacao = slot->operacoes.dados;
+    const char *fim = operacao + slot->operacoes.tamanho;
+    while (operacao != NULL && operacao < fim) {
+        const char *quebra = memchr(operacao, '\n', (size_t)(fim - operacao));
+        int tamanho = snprintf(prefixo, sizeof(prefixo), "%lld;%s;%lld;", ++sequencia, tabela, geracao);
+        acrescentarTexto(&texto, prefixo, (size_t)tamanho);
+        acrescentarTexto(&texto, operacao, (size_t)(quebra - operacao) + 1);
+        operacao = quebra + 1;
+    }
+    int tamanho = snprintf(prefixo, sizeof(prefixo), "%lld;%s;%lld;%c;;%ld\n", ++sequencia, tabela, geracao,
+                           ALTERACAO_CONFIRMAR, slot->total);
+    acrescentarTexto(&texto, prefixo, (size_t)tamanho);
+
+    if (texto.erro || !acrescentarAoLog(caminho, texto.dados, texto.tamanho)) {
+        printf("Aviso: alterações de %s sem registro.\n", arquivo);
+    }
+
+    destravarArquivo(&trava);
+    close(trava.descritor);
+    liberarTexto(&texto);
+    liberarPendentes(slot);
+}
+
+int acrescentarPublicacoesAlteracoes(const char *diretorio, const char *texto, size_t tamanho,
+                                     long long ultima_sequencia) {
+    TravaArquivo trava = TRAVA_ARQUIVO_INIT;
+    char caminho[MAX_PATH + 32];
+    int ok;
+
+    snprintf(caminho, sizeof(caminho), "%s/%s", diretorio, ARQUIVO_ALTERACOES);
+    if (!travarArquivo(&trava, caminho, TRAVA_EXCLUSIVA)) {
+        return 0;
+    }
+    ok = acrescentarAoLog(caminho, texto, tamanho);
+    long long atual = lerGeracaoArquivo(&trava);
+    if (ok && ultima_sequencia > atual) {
+        avancarGeracaoArquivo(&trava, ultima_sequencia - atual);
+    }
+    destravarArquivo(&trava);
+    close(trava.descritor);
+    return ok;
+}
+
+void descartarAlteracoesTabela(const char *arquivo) {
+    AlteracoesPendentes *slot = pendentesDoArquivo(arquivo, 0);
+    if (slot != NULL) {
+        liberarPendentes(slot);
+    }
+}
+
+long long ultimaSequenciaAlteracoes(const char *diretorio) {
+    char caminho[MAX_PATH + 32];
+    long long sequencia;
+
+    // Sem criar "alteracoes.log.lock" num diretório que nunca teve log
+    snprintf(caminho, sizeof(caminho), "%s/%s.lock", diretorio, ARQUIVO_ALTERACOES);
+    TravaArquivo trava = {open(caminho, O_RDWR), 0};
+    if (trava.descritor < 0) {
+        return 0;
+    }
+    trava.pid = (long)getpid();
+
+    snprintf(caminho, sizeof(caminho), "%s/%s", diretorio, ARQUIVO_ALTERACOES);
+    travarArquivo(&trava, caminho, TRAVA_COMPARTILHADA);
+    sequencia = lerGeracaoArquivo(&trava);
+    destravarArquivo(&trava);
+    close(trava.descritor);
+    return sequencia;
+}
+
+int interpretarAlteracao(const char *linha, size_t tamanho, Alteracao *destino) {
+    const char *campos[5];
+    const char *p = linha;
+    const char *fim = linha + tamanho;
+    char numero[24];
+
+    // Cinco ';' separam sequência, tabela, geração, operação, anterior e linha
+    for (int i = 0; i < 5; i++) {
+        const char *separador = memchr(p, ';', (size_t)(fim - p));
+        if (separador == NULL) {
+            return 0;
+        }
+        campos[i] = separador;
+        p = separador + 1;
+    }
+
+    size_t tamanho_sequencia = (size_t)(campos[0] - linha);
+    size_t tamanho_tabela = (size_t)(campos[1] - campos[0] - 1);
+    size_t tamanho_geracao = (size_t)(campos[2] - campos[1] - 1);
+    if (tamanho_sequencia == 0 || tamanho_sequencia >= sizeof(numero) || tamanho_tabela == 0 ||
+        tamanho_tabela >= MAX_NOME_TABELA_ALTERACAO || tamanho_geracao == 0 || tamanho_geracao >= sizeof(numero) ||
+        campos[3] - campos[2] != 2) {
+        return 0;
+    }
+
+    memcpy(numero, linha, tamanho_sequencia);
+    numero[tamanho_sequencia] = '\0';
+    destino->sequencia = atoll(numero);
+    memcpy(destino->tabela, campos[0] + 1, tamanho_tabela);
+    destino->tabela[tamanho_tabela] = '\0';
+    memcpy(numero, campos[1] + 1, tamanho_geracao);
+    numero[tamanho_geracao] = '\0';
+    destino->geracao = atoll(numero);
+    destino->operacao = campos[2][1];
+    destino->anterior = campos[3] + 1;
+    destino->tamanho_anterior = (size_t)(campos[4] - campos[3] - 1);
+    destino->linha = campos[4] + 1;
+    destino->tamanho_linha = (size_t)(fim - destino->linha);
+
+    return destino->sequencia > 0 && strchr("IUDRAC", destino->operacao) != NULL;
+}
+
+int abrirLeitorAlteracoes(LeitorAlteracoes *leitor, const char *diretorio, long long apos_sequencia) {
+    char caminho[MAX_PATH + 32];
+
+    memset(leitor, 0, sizeof(*leitor));
+    snprintf(caminho, sizeof(caminho), "%s/%s", diretorio, ARQUIVO_ALTERACOES);
+    leitor->arquivo = fopen(caminho, "rb");
+    leitor->apos_sequencia = apos_sequencia;
+    return leitor->arquivo != NULL;
+}
+
+// Lê uma linha inteira do log (sem o '\n')
+// Retorna: 1 se leu, 0 no fim do arquivo ou numa linha ainda sem '\n', -1 se faltou memória
+static int lerLinhaLog(LeitorAlteracoes *leitor, size_t *tamanho) {
+    size_t usado = 0;
+
+    for (;;) {
+        if (leitor->capacidade_linha - usado < 2) {
+            size_t capacidade = (leitor->capacidade_linha > 0) ? leitor->capacidade_linha * 2 : 4096;
+            char *maior = realloc(leitor->linha, capacidade);
+            if (maior == NULL) {
+                return -1;
+            }
+            leitor->linha = maior;
+            leitor->capacidade_linha = capacidade;
+        }
+        if (fgets(leitor->linha + usado, (int)(leitor->capacidade_linha - usado), leitor->arquivo) == NULL) {
+            clearerr(leitor->arquivo);
+            return 0;
+        }
+        usado += strlen(leitor->linha + usado);
+        if (usado > 0 && leitor->linha[usado - 1] == '\n') {
+            leitor->linha[--usado] = '\0';
+            *tamanho = usado;
+            return 1;
+        }
+    }
+}
+
+// Quebra o texto da publicação em operações (sem a linha C)
+// Retorna: operações, -1 se faltou memória
+static long montarOperacoes(LeitorAlteracoes *leitor, long total) {
+    const char *p = leitor->texto;
+    const char *fim = leitor->texto + leitor->tamanho_texto;
+    long lidas = 0;
+
+    if (total > leitor->capacidade_operacoes) {
+        Alteracao *maiores = realloc(leitor->operacoes, sizeof(Alteracao) * (size_t)total);
+        if (maiores == NULL) {
+            return -1;
+        }
+        leitor->operacoes = maiores;
+        leitor->capacidade_operacoes = total;
+    }
+    while (p < fim && lidas < total) {
+        const char *quebra = memchr(p, '\n', (size_t)(fim - p));
+        interpretarAlteracao(p, (size_t)(quebra - p), &leitor->operacoes[lidas++]);
+        p = quebra + 1;
+    }
+    return lidas;
+}
+
+int lerPublicacaoAlteracoes(LeitorAlteracoes *leitor, PublicacaoAlteracoes *destino) {
+    Alteracao alteracao;
+    Alteracao primeira;
+    long linhas = 0;
+    size_t tamanho;
+    int lida;
+
+    if (leitor->arquivo == NULL || fseek(leitor->arquivo, leitor->posicao, SEEK_SET) != 0) {
+        return 0;
+    }
+    leitor->tamanho_texto = 0;
+
+    while ((lida = lerLinhaLog(leitor, &tamanho)) > 0) {
+        // Linha cortada ou já lida: a próxima publicação começa depois dela
+        if (!interpretarAlteracao(leitor->linha, tamanho, &alteracao) ||
+            alteracao.sequencia <= leitor->apos_sequencia) {
+            leitor->posicao = ftell(leitor->arquivo);
+            leitor->tamanho_texto = 0;
+            linhas = 0;
+            continue;
+        }
+
+        // Publicação sem a linha C (queda): a sequência reservada não continua
+        if (linhas > 0 && (alteracao.sequencia != destino->ultima_sequencia + 1 ||
+                           strcmp(alteracao.tabela, primeira.tabela) != 0 ||
+                           alteracao.geracao != primeira.geracao)) {
+            leitor->tamanho_texto = 0;
+            linhas = 0;
+        }
+        if (linhas == 0) {
+            primeira = alteracao;
+            destino->primeira_sequencia = alteracao.sequencia;
+        }
+        destino->ultima_sequencia = alteracao.sequencia;
+        linhas++;
+
+        if (leitor->tamanho_texto + tamanho + 2 > leitor->capacidade_texto) {
+            size_t capacidade = (leitor->capacidade_texto > 0) ? leitor->capacidade_texto : 4096;
+            while (leitor->tamanho_texto + tamanho + 2 > capacidade) {
+                capacidade *= 2;
+            }
+            char *maior = realloc(leitor->texto, capacidade);
+            if (maior == NULL) {
+                return -1;
+            }
+            leitor->texto = maior;
+            leitor->capacidade_texto = capacidade;
+        }
+        memcpy(leitor->texto + leitor->tamanho_texto, leitor->linha, tamanho);
+        leitor->tamanho_texto += tamanho;
+        leitor->texto[leitor->tamanho_texto++] = '\n';
+
+        if (alteracao.operacao != ALTERACAO_CONFIRMAR) {
+            continue;
+        }
+        if (atol(alteracao.linha) != linhas - 1) {
+            leitor->tamanho_texto = 0;
+            linhas = 0;
+            continue;
+        }
+
+        long total = montarOperacoes(leitor, linhas - 1);
+        if (total < 0) {
+            return -1;
+        }
+        snprintf(destino->tabela, sizeof(destino->tabela), "%s", primeira.tabela);
+        destino->geracao = primeira.geracao;
+        destino->operacoes = leitor->operacoes;
+        destino->total = total;
+        destino->texto = leitor->texto;
+        destino->tamanho_texto = leitor->tamanho_texto;
+        leitor->posicao = ftell(leitor->arquivo);
+        leitor->apos_sequencia = destino->ultima_sequencia;
+        return 1;
+    }
+    return (lida < 0) ? -1 : 0;
+}
+
+void fecharLeitorAlteracoes(LeitorAlteracoes *leitor) {
+    if (leitor->arquivo != NULL) {
+        fclose(leitor->arquivo);
+    }
+    free(leitor->linha);
+    free(leitor->texto);
+    free(leitor->operacoes);
+    memset(leitor, 0, sizeof(*leitor));
+}
+
+long podarAlteracoes(const char *diretorio, long long ate_sequencia) {
+    TravaArquivo trava = TRAVA_ARQUIVO_INIT;
+    char caminho[MAX_PATH + 32];
+    size_t tamanho = 0;
+    long mantidas = 0;
+    int ok = 1;
+
+    snprintf(caminho, sizeof(caminho), "%s/%s", diretorio, ARQUIVO_ALTERACOES);
+    if (!travarArquivo(&trava, caminho, TRAVA_EXCLUSIVA)) {
+        printf("Erro: não foi possível travar '%s'.\n", caminho);
+        return -1;
+    }
+
+    char *dados = lerArquivoInteiro(caminho, &tamanho);
+    if (dados == NULL) {
+        destravarArquivo(&trava);
+        close(trava.descritor);
+        return 0;                  // Nada registrado ainda
+    }
+    FILE *saida = abrirEscritaAtomica(caminho);
+    ok = saida != NULL;
+
+    // Linhas cortadas no meio (sem sequência válida) também saem
+    for (size_t inicio = 0; ok && inicio < tamanho;) {
+        const char *quebra = memchr(dados + inicio, '\n', tamanho - inicio);
+        size_t fim = (quebra != NULL) ? (size_t)(quebra - dados) : tamanho;
+        Alteracao alteracao;
+
+        if (quebra != NULL && interpretarAlteracao(dados + inicio, fim - inicio, &alteracao) &&
+            alteracao.sequencia > ate_sequencia) {
+            ok = fwrite(dados + inicio, 1, fim - inicio + 1, saida) == fim - inicio + 1;
+            mantidas++;
+        }
+        inicio = fim + 1;
+    }
+    if (saida != NULL) {
+        if (ok) {
+            ok = concluirEscritaAtomica(saida, caminho);
+        } else {
+            const char *temporarios[1] = {caminho};
+            fclose(saida);
+            descartarTemporarios(temporarios, 1);
+        }
+    }
+
+    free(dados);
+    destravarArquivo(&trava);
+    close(trava.descritor);
+    if (!ok) {
+        printf("Erro ao podar '%s'.\n", caminho);
+        return -1;
+    }
+    return mantidas;
+}
+
+// ========== CONTEÚDO EM MEMÓRIA ==========
+
+// Retorna: índice do novo nó (fora da lista), -1 se faltou memória
+static int32_t novoNo(ConteudoTabela *conteudo, const char *linha, size_t tamanho) {
+    if (conteudo->total == conteudo->capacidade) {
+        size_t capacidade = (conteudo->capacidade > 0) ? conteudo->capacidade * 2 : 1024;
+        const char **linhas = realloc(conteudo->linhas, sizeof(const char *) * capacidade);
+        if (linhas != NULL) {
+            conteudo->linhas = linhas;
+        }
+        uint32_t *tamanhos = realloc(conteudo->tamanhos, sizeof(uint32_t) * capacidade);
+        if (tamanhos != NULL) {
+            conteudo->tamanhos = tamanhos;
+        }
+        uint32_t *chaves = realloc(conteudo->chaves, sizeof(uint32_t) * capacidade);
+        if (chaves != NULL) {
+            conteudo->chaves = chaves;
+        }
+        int32_t *anteriores = realloc(conteudo->anteriores, sizeof(int32_t) * capacidade);
+        if (anteriores != NULL) {
+            conteudo->anteriores = anteriores;
+        }
+        int32_t *proximos = realloc(conteudo->proximos, sizeof(int32_t) * capacidade);
+        if (proximos != NULL) {
+            conteudo->proximos = proximos;
+        }
+        if (linhas == NULL || tamanhos == NULL || chaves == NULL || anteriores == NULL || proximos == NULL) {
+            return -1;
+        }
+        conteudo->capacidade = capacidade;
+    }
+
+    int32_t no = (int32_t)conteudo->total++;
+    conteudo->linhas[no] = linha;
+    conteudo->tamanhos[no] = (uint32_t)tamanho;
+    conteudo->chaves[no] = tamanhoChave(linha, tamanho, conteudo->campos);
+    conteudo->anteriores[no] = -1;
+    conteudo->proximos[no] = -1;
+    return no;
+}
+
+// Liga "no" depois de "anterior" (-1 = no início)
+static void ligarNo(ConteudoTabela *conteudo, int32_t no, int32_t anterior) {
+    int32_t proximo = (anterior >= 0) ? conteudo->proximos[anterior] : conteudo->primeira;
+
+    conteudo->anteriores[no] = anterior;
+    conteudo->proximos[no] = proximo;
+    if (anterior >= 0) {
+        conteudo->proximos[anterior] = no;
+    } else {
+        conteudo->primeira = no;
+    }
+    if (proximo >= 0) {
+        conteudo->anteriores[proximo] = no;
+    } else {
+        conteudo->ultima = no;
+    }
+    conteudo->ativas++;
+}
+
+static void desligarNo(ConteudoTabela *conteudo, int32_t no) {
+    int32_t anterior = conteudo->anteriores[no];
+    int32_t proximo = conteudo->proximos[no];
+
+    if (anterior >= 0) {
+        conteudo->proximos[anterior] = proximo;
+    } else {
+        conteudo->primeira = proximo;
+    }
+    if (proximo >= 0) {
+        conteudo->anteriores[proximo] = anterior;
+    } else {
+        conteudo->ultima = anterior;
+    }
+    conteudo->ativas--;
+}
+
+// Indexa o nó se a chave for válida e ainda livre (linhas repetidas ficam fora)
+// Retorna: 1 se indexou, 0 se não, -1 se faltou memória
+static int indexarNo(ConteudoTabela *conteudo, int32_t no) {
+    uint32_t chave = conteudo->chaves[no];
+
+    if (chave == 0) {
+        return 0;
+    }
+    if (!garantirEspacoIndice(&conteudo->indice, conteudo->linhas, conteudo->chaves)) {
+        return -1;
+    }
+    if (procurarChave(&conteudo->indice, conteudo->linhas, conteudo->chaves, conteudo->linhas[no], chave) >= 0) {
+        conteudo->chaves[no] = 0;
+        return 0;
+    }
+    colocarChave(&conteudo->indice, conteudo->linhas[no], chave, no);
+    return 1;
+}
+
+// Retorna: posição no índice da chave da linha, -1 se ausente
+static long long procurarLinha(const ConteudoTabela *conteudo, const char *linha, size_t tamanho) {
+    uint32_t chave = tamanhoChave(linha, tamanho, conteudo->campos);
+    if (chave == 0) {
+        return -1;
+    }
+    return procurarChave(&conteudo->indice, conteudo->linhas, conteudo->chaves, linha, chave);
+}
+
+static void esvaziarConteudo(ConteudoTabela *conteudo) {
+    conteudo->total = 0;
+    conteudo->ativas = 0;
+    conteudo->primeira = -1;
+    conteudo->ultima = -1;
+    memset(conteudo->indice.posicoes, 0xFF, sizeof(int32_t) * conteudo->indice.capacidade);
+    conteudo->indice.ocupadas = 0;
+}
+
+ConteudoTabela* criarConteudoTabela(const char *tabela, const char *dados, size_t tamanho) {
+    ConteudoTabela *conteudo = calloc(1, sizeof(ConteudoTabela));
+    size_t inicio = 0;
+    size_t estimadas = 0;
+
+    if (conteudo == NULL) {
+        return NULL;
+    }
+    conteudo->campos = camposChaveAlteracoes(tabela);
+    conteudo->primeira = -1;
+    conteudo->ultima = -1;
+
+    // Linhas estimadas pelo tamanho médio das primeiras, para não refazer o índice
+    for (size_t i = 0; i < tamanho && i < 65536; i++) {
+        estimadas += (dados[i] == '\n');
+    }
+    if (tamanho > 65536 && estimadas > 0) {
+        estimadas = (size_t)((double)estimadas * ((double)tamanho / 65536.0));
+    }
+    if (conteudo->campos == 0 || !criarIndice(&conteudo->indice, estimadas + 16)) {
+        free(conteudo);
+        return NULL;
+    }
+
+    while (inicio < tamanho) {
+        const char *quebra = memchr(dados + inicio, '\n', tamanho - inicio);
+        size_t fim = (quebra != NULL) ? (size_t)(quebra - dados) : tamanho;
+
+        if (!conteudo->tem_cabecalho) {
+            conteudo->tem_cabecalho = 1;
+            conteudo->cabecalho = dados + inicio;
+            conteudo->tamanho_cabecalho = fim - inicio;
+        } else {
+            int32_t no = novoNo(conteudo, dados + inicio, fim - inicio);
+            if (no < 0 || indexarNo(conteudo, no) < 0) {
+                liberarConteudoTabela(conteudo);
+                return NULL;
+            }
+            ligarNo(conteudo, no, conteudo->ultima);
+        }
+        inicio = fim + 1;
+    }
+    return conteudo;
+}
+
+int aplicarAlteracao(ConteudoTabela *conteudo, const Alteracao *alteracao) {
+    long long posicao;
+    int32_t no;
+    int32_t anterior = -1;
+
+    switch (alteracao->operacao) {
+        case ALTERACAO_RECRIAR:
+            esvaziarConteudo(conteudo);
+            conteudo->tem_cabecalho = 1;
+            conteudo->cabecalho = alteracao->linha;
+            conteudo->tamanho_cabecalho = alteracao->tamanho_linha;
+            return 1;
+
+        case ALTERACAO_ACRESCENTAR:
+            no = novoNo(conteudo, alteracao->linha, alteracao->tamanho_linha);
+            if (no < 0 || indexarNo(conteudo, no) < 0) {
+                return 0;
+            }
+            ligarNo(conteudo, no, conteudo->ultima);
+            return 1;
+
+        case ALTERACAO_INSERIR:
+            if (alteracao->tamanho_anterior > 0) {
+                posicao = procurarChave(&conteudo->indice, conteudo->linhas, conteudo->chaves,
+                                        alteracao->anterior, alteracao->tamanho_anterior);
+                if (posicao < 0) {
+                    return 0;
+                }
+                anterior = conteudo->indice.posicoes[posicao];
+            }
+            no = novoNo(conteudo, alteracao->linha, alteracao->tamanho_linha);
+            if (no < 0 || indexarNo(conteudo, no) <= 0) {
+                return 0;          // Chave inválida ou já existente
+            }
+            ligarNo(conteudo, no, anterior);
+            return 1;
+
+        case ALTERACAO_ATUALIZAR:
+            posicao = procurarLinha(conteudo, alteracao->linha, alteracao->tamanho_linha);
+            if (posicao < 0) {
+                return 0;
+            }
+            no = conteudo->indice.posicoes[posicao];
+            conteudo->linhas[no] = alteracao->linha;
+            conteudo->tamanhos[no] = (uint32_t)alteracao->tamanho_linha;
+            return 1;
+
+        case ALTERACAO_EXCLUIR:
+            posicao = procurarLinha(conteudo, alteracao->linha, alteracao->tamanho_linha);
+            if (posicao < 0) {
+                return 0;
+            }
+            no = conteudo->indice.posicoes[posicao];
+            conteudo->indice.posicoes[posicao] = POSICAO_REMOVIDA;
+            desligarNo(conteudo, no);
+            return 1;
+
+        case ALTERACAO_CONFIRMAR:
+            return 1;
+
+        default:
+            return 0;
+    }
+}
+
+char* serializarConteudoTabela(const ConteudoTabela *conteudo, size_t *tamanho) {
+    size_t total = conteudo->tem_cabecalho ? conteudo->tamanho_cabecalho + 1 : 0;
+    char *saida;
+    char *p;
+
+    for (int32_t no = conteudo->primeira; no >= 0; no = conteudo->proximos[no]) {
+        total += conteudo->tamanhos[no] + 1;
+    }
+    saida = malloc(total + 1);
+    if (saida == NULL) {
+        return NULL;
+    }
+
+    p = saida;
+    if (conteudo->tem_cabecalho) {
+        memcpy(p, conteudo->cabecalho, conteudo->tamanho_cabecalho);
+        p += conteudo->tamanho_cabecalho;
+        *p++ = '\n';
+    }
+    for (int32_t no = conteudo->primeira; no >= 0; no = conteudo->proximos[no]) {
+        memcpy(p, conteudo->linhas[no], conteudo->tamanhos[no]);
+        p += conteudo->tamanhos[no];
+        *p++ = '\n';
+    }
+    *p = '\0';
+    *tamanho = total;
+    return saida;
+}
+
+long long linhasConteudoTabela(const ConteudoTabela *conteudo) {
+    return conteudo->ativas;
+}
+
+void liberarConteudoTabela(ConteudoTabela *conteudo) {
+    if (conteudo == NULL) {
+        return;
+    }
+    free(conteudo->linhas);
+    free(conteudo->tamanhos);
+    free(conteudo->chaves);
+    free(conteudo->anteriores);
+    free(conteudo->proximos);
+    free(conteudo->indice.posicoes);
+    free(conteudo);
+}
@@ -0,0 +1,169 @@
+#ifndef ALTERACOES_MANAGER_H
+#define ALTERACOES_MANAGER_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+// ========== REGISTRO DE ALTERAÇÕES (CHANGE LOG) ==========
+//
+// Cada publicação de um CSV conhecido (alunos, turmas, aulas, aluno_turma,
+// atividades, notas, usuarios) acrescenta em "<dir>/alteracoes.log" as linhas
+// que mudaram, por chave (os primeiros campos da linha: RA, ID, ou RA +
+// ID_Turma em aluno_turma e RA + ID_Atividade em notas):
+// 1. antes do rename (concluirEscritaAtomica(), ou a confirmação de uma
+//    transação), o CSV antigo é comparado com "x.csv.tmp" e as operações
+//    ficam pendentes;
+// 2. marcarTabelaSalva(), depois de incrementar a geração do CSV, grava as
+//    operações com a geração nova e números de sequência, ainda sob a trava
+//    exclusiva do CSV.
+// A sequência é global (todas as tabelas) e só cresce: é o contador de
+// geração de "alteracoes.log.lock", avançado sob a trava exclusiva dele.
+//
+// Uma publicação termina na linha "C"; operações sem ela (queda no meio da
+// gravação) não valem. Se o processo morrer entre o rename e o registro, ou
+// se outro programa gravar o CSV (front end Python, recuperação do journal),
+// aquela geração fica sem registro: quem usa o log (backups incrementais)
+// detecta o buraco pela geração e copia a tabela inteira.
+//
+// Formato (texto, uma operação por linha; o CSV vai até o fim da linha):
+//   sequencia;tabela;geracao;operacao;anterior;linha
+//   I  insere "linha" logo depois da chave "anterior" (vazia = no início)
+//   U  substitui a linha de mesma chave
+//   D  remove a linha de mesma chave ("linha" é a versão apagada)
+//   R  a tabela é recriada: "linha" é o cabeçalho; seguem-se operações A
+//   A  acrescenta "linha" no fim (só depois de R)
+//   C  fim da publicação; "linha" é o número de operações
+// A publicação usa R quando a comparação por chave não se aplica (cabeçalho
+// mudou, chave repetida, CSV que não existia). Uma linha que mudou de lugar
+// vira D + I. Aplicar as operações na ordem reproduz o CSV byte a byte.
+
+#define ARQUIVO_ALTERACOES "alteracoes.log"
+
+#define ALTERACAO_INSERIR 'I'
+#define ALTERACAO_ATUALIZAR 'U'
+#define ALTERACAO_EXCLUIR 'D'
+#define ALTERACAO_RECRIAR 'R'
+#define ALTERACAO_ACRESCENTAR 'A'
+#define ALTERACAO_CONFIRMAR 'C'
+
+#define MAX_NOME_TABELA_ALTERACAO 32
+
+// Uma linha do log, interpretada sem cópia (os ponteiros apontam para ela)
+typedef struct {
+    long long sequencia;
+    char tabela[MAX_NOME_TABELA_ALTERACAO]; // Nome do CSV ("aulas.csv")
+    long long geracao;             // Geração do CSV depois da publicação
+    char operacao;
+    const char *anterior;          // Chave anterior (operação I)
+    size_t tamanho_anterior;
+    const char *linha;
+    size_t tamanho_linha;
+} Alteracao;
+
+// Uma publicação confirmada (as operações de um CSV numa geração)
+typedef struct {
+    char tabela[MAX_NOME_TABELA_ALTERACAO];
+    long long geracao;
+    long long primeira_sequencia;
+    long long ultima_sequencia;    // A da linha C
+    const Alteracao *operacoes;    // Sem a linha C
+    long total;
+    const char *texto;             // Linhas como estão no log, com a C
+    size_t tamanho_texto;
+} PublicacaoAlteracoes;
+
+// Leitura sequencial do log (válida até a próxima leitura)
+typedef struct {
+    FILE *arquivo;
+    long long apos_sequencia;      // Publicações até esta sequência são puladas
+    long posicao;                  // Início da próxima publicação a ler
+    char *linha;
+    size_t capacidade_linha;
+    char *texto;
+    size_t tamanho_texto;
+    size_t capacidade_texto;
+    Alteracao *operacoes;
+    long capacidade_operacoes;
+} LeitorAlteracoes;
+
+// Conteúdo de um CSV em memória, com índice por chave (aplicação das operações)
+typedef struct ConteudoTabela ConteudoTabela;
+
+// ========== GRAVAÇÃO (CHAMADA PELAS TABELAS RESIDENTES) ==========
+
+// Função para comparar "arquivo" com "<arquivo>.tmp" e guardar as operações
+// Sem efeito para arquivos que não são tabelas conhecidas
+void prepararAlteracoesTabela(const char *arquivo);
+
+// Função igual à anterior, com o conteúdo novo já em memória (o CSV ainda não
+// foi escrito em "<arquivo>.tmp", ex.: gravação entregue ao motor de persistência)
+void prepararAlteracoesConteudo(const char *arquivo, const char *novo, size_t tamanho_novo);
+
+// Função para gravar no log as operações preparadas de "arquivo"
+// Exige a trava exclusiva do CSV; "geracao" é a geração nova
+void registrarAlteracoesTabela(const char *arquivo, long long geracao);
+
+// Função para esquecer as operações preparadas (publicação desistida)
+void descartarAlteracoesTabela(const char *arquivo);
+
+// Função para acrescentar a "<diretorio>/alteracoes.log" publicações já
+// numeradas por outro diretório (réplica); a sequência passa a
+// "ultima_sequencia" (com "tamanho" 0, só a sequência)
+// Retorna: 1 se gravado, 0 se erro
+int acrescentarPublicacoesAlteracoes(const char *diretorio, const char *texto, size_t tamanho,
+                                     long long ultima_sequencia);
+
+// ========== LEITURA ==========
+
+// Função para obter o número de campos da chave de uma tabela ("aulas.csv")
+// Retorna: campos da chave, 0 se a tabela não é registrada
+int camposChaveAlteracoes(const char *tabela);
+
+// Função para ler a última sequência atribuída em "<diretorio>/alteracoes.log"
+// Retorna: sequência, 0 se o log nunca foi usado
+long long ultimaSequenciaAlteracoes(const char *diretorio);
+
+// Função para interpretar uma linha do log (sem o '\n')
+// Retorna: 1 se válida, 0 se malformada
+int interpretarAlteracao(const char *linha, size_t tamanho, Alteracao *destino);
+
+// Função para abrir "<diretorio>/alteracoes.log" a partir da sequência dada
+// Retorna: 1 se aberto, 0 se o log não existe
+int abrirLeitorAlteracoes(LeitorAlteracoes *leitor, const char *diretorio, long long apos_sequencia);
+
+// Função para ler a próxima publicação confirmada
+// No fim do log (ou numa publicação ainda pela metade) retorna 0 e a próxima
+// chamada tenta de novo do mesmo ponto: serve para acompanhar o log crescendo
+// Retorna: 1 se leu, 0 se não há publicação completa, -1 se faltou memória
+int lerPublicacaoAlteracoes(LeitorAlteracoes *leitor, PublicacaoAlteracoes *destino);
+
+// Função para fechar o leitor
+void fecharLeitorAlteracoes(LeitorAlteracoes *leitor);
+
+// Função para apagar do log as operações com sequência <= "ate_sequencia"
+// Retorna: operações mantidas, -1 se erro (o log fica como estava)
+long podarAlteracoes(const char *diretorio, long long ate_sequencia);
+
+// ========== APLICAÇÃO ==========
+
+// Função para montar o conteúdo de um CSV ("dados" deve viver até o fim do
+// conteúdo; as linhas apontam para ele)
+// Retorna: conteúdo ou NULL se faltou memória ou a tabela não é registrada
+ConteudoTabela* criarConteudoTabela(const char *tabela, const char *dados, size_t tamanho);
+
+// Função para aplicar uma operação ("alteracao->linha" deve viver até o fim)
+// Retorna: 1 se aplicada, 0 se ela não se encaixa no conteúdo (chave ausente,
+//          repetida ou faltou memória)
+int aplicarAlteracao(ConteudoTabela *conteudo, const Alteracao *alteracao);
+
+// Função para gerar o CSV do conteúdo
+// Retorna: buffer (malloc) com "*tamanho" bytes, NULL se faltou memória
+char* serializarConteudoTabela(const ConteudoTabela *conteudo, size_t *tamanho);
+
+// Função para contar as linhas de dados do conteúdo
+long long linhasConteudoTabela(const ConteudoTabela *conteudo);
+
+// Função para liberar o conteúdo
+void liberarConteudoTabela(ConteudoTabela *conteudo);
+
+#endif
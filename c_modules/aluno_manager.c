@@ -3,19 +3,106 @@
 #include <string.h>
 #include "aluno_manager.h"
 #include "file_manager.h"
+#include "tabela_manager.h"
+#include "exportacao_manager.h"
+#include "agregado_manager.h"
 
 // - Mantém alunos em memória enquanto o programa executa
 static Aluno alunos[MAX_ALUNOS];
 static int total_alunos = 0;
 
+// - Índice por RA: posições de "alunos" ordenadas por (RA, posição)
+//   (o RA não muda e alunos nunca saem do array, então só cresce)
+static int indice_ra[MAX_ALUNOS];
+
+static int compararPosicoesPorRA(const void *a, const void *b) {
+    const Aluno *x = &alunos[*(const int *)a];
+    const Aluno *y = &alunos[*(const int *)b];
+    if (x->ra != y->ra) {
+        return x->ra < y->ra ? -1 : 1;
+    }
+    return *(const int *)a - *(const int *)b;
+}
+
+// - Primeira entre as "entradas" iniciais do índice com RA >= ra (busca binária)
+static int limiteInferiorRA(int ra, int entradas) {
+    int inicio = 0, fim = entradas;
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        if (alunos[indice_ra[meio]].ra < ra) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return inicio;
+}
+
+// - Posição do aluno no array, ou -1 (exige trava da tabela)
+static int posicaoDoRA(int ra) {
+    int entrada = limiteInferiorRA(ra, total_alunos);
+    if (entrada < total_alunos && alunos[indice_ra[entrada]].ra == ra) {
+        return indice_ra[entrada];
+    }
+    return -1;
+}
+
+static void reconstruirIndiceRA(void) {
+    for (int i = 0; i < total_alunos; i++) {
+        indice_ra[i] = i;
+    }
+    qsort(indice_ra, (size_t)total_alunos, sizeof(int), compararPosicoesPorRA);
+}
+
+// - Acrescenta ao índice o aluno recém-colocado na última posição
+static void indexarUltimoAluno(void) {
+    int posicao = total_alunos - 1;
+    int entrada = limiteInferiorRA(alunos[posicao].ra, posicao);
+    memmove(&indice_ra[entrada + 1], &indice_ra[entrada], sizeof(int) * (size_t)(posicao - entrada));
+    indice_ra[entrada] = posicao;
+}
+
 // - Traz os dados do arquivo CSV para o array global
-static void carregarAlunosMemoria() {
+static void carregarAlunosMemoria(void) {
     total_alunos = carregarDados(ARQUIVO_ALUNOS, alunos, MAX_ALUNOS, TIPO_ALUNO);
+    reconstruirIndiceRA();
+    publicarExportacao(EXPORTACAO_ALUNOS, alunos, total_alunos);
+    reconstruirAgregadosAlunos(alunos, total_alunos);
 }
 
-// - Persiste o array global novamente no CSV
-static void salvarAlunosArquivo() {
-    salvarDados(ARQUIVO_ALUNOS, alunos, total_alunos, TIPO_ALUNO);
+static int gravarAlunosArquivo(void);
+
+// - Trava leitores/escritor e controle de recarga do CSV
+static TabelaResidente tabela_alunos = TABELA_RESIDENTE_INIT(ARQUIVO_ALUNOS, carregarAlunosMemoria,
+                                                             gravarAlunosArquivo);
+
+// - Persiste o array global novamente no CSV (exige trava de escrita)
+static int gravarAlunosArquivo(void) {
+    if (!salvarDados(ARQUIVO_ALUNOS, alunos, total_alunos, TIPO_ALUNO)) {
+        return 0;
+    }
+    marcarTabelaSalva(&tabela_alunos);
+    return 1;
+}
+
+// - Publica a versão confirmada para os demais leitores (após a transação)
+static int publicarAlunosConfirmados(int ignorado) {
+    (void)ignorado;
+    abrirLeituraTabela(&tabela_alunos);
+    publicarExportacao(EXPORTACAO_ALUNOS, alunos, total_alunos);
+    reconstruirAgregadosAlunos(alunos, total_alunos);
+    fecharTabela(&tabela_alunos);
+    return 1;
+}
+
+// - Publica a alteração e grava agora ou em segundo plano (exige trava de escrita)
+static int salvarAlunosArquivo(void) {
+    if (emTransacaoTabelas()) {
+        publicarTabelaAposConfirmar(&tabela_alunos, publicarAlunosConfirmados);
+    } else {
+        publicarExportacao(EXPORTACAO_ALUNOS, alunos, total_alunos);
+    }
+    return registrarAlteracaoTabela(&tabela_alunos);
 }
 
 // ========== CADASTRAR ALUNO ==========
@@ -24,46 +111,76 @@ int cadastrarAluno(Aluno *aluno) {
         return 0;
     }
     
-    carregarAlunosMemoria();
+    abrirEscritaTabela(&tabela_alunos);
     
     // - Garante unicidade de RA antes de inserir
-    for (int i = 0; i < total_alunos; i++) {
-        if (alunos[i].ra == aluno->ra) {
-            printf("Erro: RA %d já cadastrado.\n", aluno->ra);
-            return 0;
-        }
+    if (posicaoDoRA(aluno->ra) >= 0) {
+        fecharTabela(&tabela_alunos);
+        printf("Erro: RA %d já cadastrado.\n", aluno->ra);
+        return 0;
     }
     
     // Adicionar novo aluno
     if (total_alunos < MAX_ALUNOS) {
         alunos[total_alunos] = *aluno;
         total_alunos++;
-        salvarAlunosArquivo();
+        indexarUltimoAluno();
+        agregarAluno(NULL, aluno);
+        int salvo = salvarAlunosArquivo();
+        fecharTabela(&tabela_alunos);
+        if (!salvo) {
+            return 0;
+        }
         printf("Aluno cadastrado com sucesso!\n");
         return 1;
     }
     
+    fecharTabela(&tabela_alunos);
     printf("Erro: limite de alunos atingido.\n");
     return 0;
 }
 
 // ========== BUSCAR ALUNO POR RA ==========
+// O ponteiro retornado aponta para o array residente e só é estável até a
+// próxima escrita; em código multithread prefira obterAlunoPorRA().
 Aluno* buscarAlunoPorRA(int ra) {
-    carregarAlunosMemoria();
+    Aluno *encontrado = NULL;
+    
+    abrirLeituraTabela(&tabela_alunos);
     
     // Uso de ponteiro (requisito desejável)
-    for (int i = 0; i < total_alunos; i++) {
-        if (alunos[i].ra == ra) {
-            return &alunos[i]; // Retorna ponteiro para o aluno
-        }
+    int posicao = posicaoDoRA(ra);
+    if (posicao >= 0) {
+        encontrado = &alunos[posicao]; // Retorna ponteiro para o aluno
     }
     
-    return NULL; // Não encontrado
+    fecharTabela(&tabela_alunos);
+    return encontrado; // NULL se não encontrado
+}
+
+// ========== OBTER CÓPIA DO ALUNO POR RA ==========
+int obterAlunoPorRA(int ra, Aluno *destino) {
+    int encontrado = 0;
+    
+    if (destino == NULL) {
+        return 0;
+    }
+    
+    abrirLeituraTabela(&tabela_alunos);
+    
+    int posicao = posicaoDoRA(ra);
+    if (posicao >= 0) {
+        *destino = alunos[posicao]; // Cópia feita sob a trava de leitura
+        encontrado = 1;
+    }
+    
+    fecharTabela(&tabela_alunos);
+    return encontrado;
 }
 
 // ========== LISTAR TODOS OS ALUNOS ==========
 int listarAlunos(Aluno *destino, int max) {
-    carregarAlunosMemoria();
+    abrirLeituraTabela(&tabela_alunos);
     
     int count = (total_alunos < max) ? total_alunos : max;
     
@@ -72,39 +189,92 @@ int listarAlunos(Aluno *destino, int max) {
         destino[i] = alunos[i];
     }
     
+    fecharTabela(&tabela_alunos);
     return count;
 }
 
+// ========== JUNTAR RAS AOS CADASTROS ==========
+int juntarAlunosPorRA(const int *ras, int total, int apenas_ativos, Aluno *destino, int max) {
+    int count = 0;
+    
+    abrirLeituraTabela(&tabela_alunos); // Uma trava (e uma conferência do CSV) para a lista toda
+    
+    for (int i = 0; i < total && count < max; i++) {
+        int posicao = posicaoDoRA(ras[i]);
+        if (posicao >= 0) {
+            if (!apenas_ativos || alunos[posicao].ativo) {
+                destino[count++] = alunos[posicao];
+            }
+        } else if (!apenas_ativos) {
+            // - RA sem cadastro (matrícula órfã): linha vazia marcada com ativo = -1
+            memset(&destino[count], 0, sizeof(Aluno));
+            destino[count].ra = ras[i];
+            destino[count].ativo = -1;
+            count++;
+        }
+    }
+    
+    fecharTabela(&tabela_alunos);
+    return count;
+}
+
+// ========== CONTAR ALUNOS ==========
+int contarAlunos(int apenas_ativos) {
+    TotaisAgregados totais;
+    
+    abrirLeituraTabela(&tabela_alunos); // Recarrega (e reconstrói) se o CSV mudou
+    lerTotaisAgregados(&totais);
+    fecharTabela(&tabela_alunos);
+    
+    return apenas_ativos ? totais.alunos_ativos : totais.alunos;
+}
+
 // ========== ATUALIZAR ALUNO ==========
 int atualizarAluno(Aluno *aluno) {
-    carregarAlunosMemoria();
+    if (aluno == NULL) {
+        return 0;
+    }
     
-    for (int i = 0; i < total_alunos; i++) {
-        if (alunos[i].ra == aluno->ra) {
-            alunos[i] = *aluno;
-            salvarAlunosArquivo();
-            printf("Aluno atualizado com sucesso!\n");
-            return 1;
+    abrirEscritaTabela(&tabela_alunos);
+    
+    int i = posicaoDoRA(aluno->ra);
+    if (i >= 0) {
+        Aluno antes = alunos[i];
+        alunos[i] = *aluno;
+        agregarAluno(&antes, &alunos[i]);
+        int salvo = salvarAlunosArquivo();
+        fecharTabela(&tabela_alunos);
+        if (!salvo) {
+            return 0;
         }
+        printf("Aluno atualizado com sucesso!\n");
+        return 1;
     }
     
+    fecharTabela(&tabela_alunos);
     printf("Erro: aluno não encontrado.\n");
     return 0;
 }
 
 // ========== EXCLUIR ALUNO (soft delete) ==========
 int excluirAluno(int ra) {
-    carregarAlunosMemoria();
+    abrirEscritaTabela(&tabela_alunos);
     
-    for (int i = 0; i < total_alunos; i++) {
-        if (alunos[i].ra == ra) {
-            alunos[i].ativo = 0; // Desativa ao invés de remover
-            salvarAlunosArquivo();
-            printf("Aluno desativado com sucesso!\n");
-            return 1;
+    int i = posicaoDoRA(ra);
+    if (i >= 0) {
+        Aluno antes = alunos[i];
+        alunos[i].ativo = 0; // Desativa ao invés de remover
+        agregarAluno(&antes, &alunos[i]);
+        int salvo = salvarAlunosArquivo();
+        fecharTabela(&tabela_alunos);
+        if (!salvo) {
+            return 0;
         }
+        printf("Aluno desativado com sucesso!\n");
+        return 1;
     }
     
+    fecharTabela(&tabela_alunos);
     printf("Erro: aluno não encontrado.\n");
     return 0;
 }
@@ -12,9 +12,23 @@ int cadastrarAluno(Aluno *aluno);
 // Função para buscar aluno por RA
 Aluno* buscarAlunoPorRA(int ra);
 
+// Função para copiar o aluno de um RA para o destino (seguro entre threads)
+// Retorna: 1 se encontrado, 0 se não
+int obterAlunoPorRA(int ra, Aluno *destino);
+
+// Função para juntar uma lista de RAs aos cadastros, na ordem da lista, sob
+// uma única trava de leitura (cada RA é buscado no índice ordenado por RA)
+// RA sem cadastro vira uma linha com nome/email vazios e ativo = -1; com
+// apenas_ativos, ele e os inativos ficam de fora
+// Retorna: linhas copiadas para o destino (até max)
+int juntarAlunosPorRA(const int *ras, int total, int apenas_ativos, Aluno *destino, int max);
+
 // Função para listar todos os alunos
 int listarAlunos(Aluno *alunos, int max);
 
+// Função para contar alunos em O(1) (contador mantido por agregado_manager)
+int contarAlunos(int apenas_ativos);
+
 // Função para atualizar dados de um aluno
 int atualizarAluno(Aluno *aluno);
 
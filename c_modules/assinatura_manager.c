@@ -0,0 +1,303 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "assinatura_manager.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <time.h>
+#include <unistd.h>
+#endif
+
+static const char *tabelas_assinatura[TOTAL_TABELAS_ASSINATURA] = {
+    "alunos.csv", "turmas.csv", "aulas.csv", "aluno_turma.csv", "atividades.csv", "notas.csv", "usuarios.csv"
+};
+
+// ========== FUNÇÕES AUXILIARES PRIVADAS ==========
+
+static void esperarAssinatura(int ms) {
+#ifdef _WIN32
+    Sleep((DWORD)ms);
+#else
+    struct timespec espera = {ms / 1000, (long)(ms % 1000) * 1000000L};
+    nanosleep(&espera, NULL);
+#endif
+}
+
+static int indiceTabelaAssinatura(const char *tabela) {
+    for (int i = 0; i < TOTAL_TABELAS_ASSINATURA; i++) {
+        if (strcmp(tabelas_assinatura[i], tabela) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void caminhoAssinatura(char *destino, size_t tamanho, const AssinaturaAlteracoes *assinatura,
+                              const char *nome) {
+    snprintf(destino, tamanho, "%s/%s", assinatura->diretorio, nome);
+}
+
+// Geração atual de cada tabela assinada (-1 se a trava está ocupada: fica
+// para a próxima leitura)
+static void lerGeracoesAssinadas(AssinaturaAlteracoes *assinatura, long long *geracoes) {
+    char caminho[MAX_PATH + 32];
+
+    for (int i = 0; i < TOTAL_TABELAS_ASSINATURA; i++) {
+        geracoes[i] = -1;
+        if (!assinatura->tabelas[i]) {
+            continue;
+        }
+        caminhoAssinatura(caminho, sizeof(caminho), assinatura, tabelas_assinatura[i]);
+        if (travarArquivo(&assinatura->travas[i], caminho, TRAVA_COMPARTILHADA | TRAVA_SEM_ESPERA)) {
+            geracoes[i] = lerGeracaoArquivo(&assinatura->travas[i]);
+            destravarArquivo(&assinatura->travas[i]);
+        }
+    }
+}
+
+// O log foi trocado (podarAlteracoes() grava outro e renomeia): reabre
+static int logSubstituido(const AssinaturaAlteracoes *assinatura) {
+    char caminho[MAX_PATH + 32];
+    struct stat atual;
+    struct stat aberto;
+
+    caminhoAssinatura(caminho, sizeof(caminho), assinatura, ARQUIVO_ALTERACOES);
+    if (stat(caminho, &atual) != 0 || fstat(fileno(assinatura->leitor.arquivo), &aberto) != 0) {
+        return 0;
+    }
+#ifndef _WIN32
+    if (atual.st_ino != aberto.st_ino || atual.st_dev != aberto.st_dev) {
+        return 1;
+    }
+#endif
+    return (long)atual.st_size < assinatura->leitor.posicao;
+}
+
+// Retorna: 1 se acrescentou, 0 se faltou memória
+static int acrescentarEvento(LoteAlteracoes *lote, long long sequencia, const char *tabela, char operacao,
+                             const char *linha, size_t tamanho) {
+    if (lote->total == lote->capacidade) {
+        long capacidade = (lote->capacidade > 0) ? lote->capacidade * 2 : 64;
+        EventoAlteracao *eventos = realloc(lote->eventos, sizeof(EventoAlteracao) * (size_t)capacidade);
+        if (eventos == NULL) {
+            return 0;
+        }
+        lote->eventos = eventos;
+        size_t *deslocamentos = realloc(lote->deslocamentos, sizeof(size_t) * (size_t)capacidade);
+        if (deslocamentos == NULL) {
+            return 0;
+        }
+        lote->deslocamentos = deslocamentos;
+        lote->capacidade = capacidade;
+    }
+    if (lote->capacidade_texto - lote->tamanho_texto < tamanho + 1) {
+        size_t capacidade = (lote->capacidade_texto > 0) ? lote->capacidade_texto : 4096;
+        while (capacidade - lote->tamanho_texto < tamanho + 1) {
+            capacidade *= 2;
+        }
+        char *texto = realloc(lote->texto, capacidade);
+        if (texto == NULL) {
+            return 0;
+        }
+        lote->texto = texto;
+        lote->capacidade_texto = capacidade;
+    }
+
+    EventoAlteracao *evento = &lote->eventos[lote->total];
+    evento->sequencia = sequencia;
+    snprintf(evento->tabela, sizeof(evento->tabela), "%s", tabela);
+    evento->operacao = operacao;
+    evento->linha = NULL;
+    evento->tamanho_linha = tamanho;
+    lote->deslocamentos[lote->total] = lote->tamanho_texto;
+    if (tamanho > 0) {
+        memcpy(lote->texto + lote->tamanho_texto, linha, tamanho);
+    }
+    lote->texto[lote->tamanho_texto + tamanho] = '\0';
+    lote->tamanho_texto += tamanho + 1;
+    lote->total++;
+    return 1;
+}
+
+static int acrescentarRecarga(LoteAlteracoes *lote, long long sequencia, int indice) {
+    return acrescentarEvento(lote, sequencia, tabelas_assinatura[indice], EVENTO_RECARREGAR, NULL, 0);
+}
+
+// Converte as operações de uma publicação em eventos
+// Retorna: 1 se sucesso, 0 se faltou memória
+static int acrescentarPublicacao(AssinaturaAlteracoes *assinatura, LoteAlteracoes *lote,
+                                 const PublicacaoAlteracoes *publicacao) {
+    int indice = indiceTabelaAssinatura(publicacao->tabela);
+
+    // Sequências puladas: operações que o assinante nunca vai ver
+    if (publicacao->primeira_sequencia > assinatura->apos_sequencia + 1) {
+        for (int i = 0; i < TOTAL_TABELAS_ASSINATURA; i++) {
+            if (assinatura->tabelas[i] && !acrescentarRecarga(lote, publicacao->ultima_sequencia, i)) {
+                return 0;
+            }
+        }
+    }
+    if (indice < 0 || !assinatura->tabelas[indice]) {
+        return 1;
+    }
+
+    // Geração que não segue a última vista: a tabela relida já inclui esta
+    long long anterior = assinatura->geracoes[indice];
+    if (anterior >= 0 && publicacao->geracao <= anterior) {
+        return 1;
+    }
+    assinatura->geracoes[indice] = publicacao->geracao;
+    if (anterior >= 0 && publicacao->geracao > anterior + 1) {
+        return acrescentarRecarga(lote, publicacao->ultima_sequencia, indice);
+    }
+
+    for (long i = 0; i < publicacao->total; i++) {
+        const Alteracao *alteracao = &publicacao->operacoes[i];
+        switch (alteracao->operacao) {
+            case ALTERACAO_RECRIAR:
+                // As operações A seguintes são a tabela inteira
+                return acrescentarRecarga(lote, publicacao->ultima_sequencia, indice);
+            case ALTERACAO_INSERIR:
+            case ALTERACAO_ATUALIZAR:
+            case ALTERACAO_EXCLUIR:
+                if (!acrescentarEvento(lote, alteracao->sequencia, publicacao->tabela, alteracao->operacao,
+                                       alteracao->linha, alteracao->tamanho_linha)) {
+                    return 0;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return 1;
+}
+
+// Esvazia o log até o fim ou até "maximo" eventos
+// Retorna: 1 se chegou ao fim do log, 0 se parou em "maximo", -1 se faltou memória
+static int lerPublicacoes(AssinaturaAlteracoes *assinatura, LoteAlteracoes *lote, long maximo) {
+    PublicacaoAlteracoes publicacao;
+
+    if (assinatura->aberto && logSubstituido(assinatura)) {
+        fecharLeitorAlteracoes(&assinatura->leitor);
+        assinatura->aberto = 0;
+    }
+    if (!assinatura->aberto) {
+        assinatura->aberto = abrirLeitorAlteracoes(&assinatura->leitor, assinatura->diretorio,
+                                                   assinatura->apos_sequencia);
+        if (!assinatura->aberto) {
+            return 1;                  // Log ainda não existe
+        }
+    }
+
+    while (lote->total < maximo) {
+        int lida = lerPublicacaoAlteracoes(&assinatura->leitor, &publicacao);
+        if (lida <= 0) {
+            return (lida == 0) ? 1 : -1;
+        }
+        if (!acrescentarPublicacao(assinatura, lote, &publicacao)) {
+            return -1;
+        }
+        assinatura->apos_sequencia = publicacao.ultima_sequencia;
+    }
+    return 0;
+}
+
+// ========== IMPLEMENTAÇÃO DAS FUNÇÕES PÚBLICAS ==========
+
+int abrirAssinaturaAlteracoes(AssinaturaAlteracoes *assinatura, const char *diretorio,
+                              const char *const *tabelas, int total, long long apos_sequencia) {
+    memset(assinatura, 0, sizeof(*assinatura));
+    snprintf(assinatura->diretorio, sizeof(assinatura->diretorio), "%s", diretorio);
+    for (int i = 0; i < TOTAL_TABELAS_ASSINATURA; i++) {
+        assinatura->tabelas[i] = (tabelas == NULL || total <= 0);
+        assinatura->geracoes[i] = -1;
+        assinatura->travas[i] = (TravaArquivo)TRAVA_ARQUIVO_INIT;
+    }
+    for (int i = 0; tabelas != NULL && i < total; i++) {
+        int indice = indiceTabelaAssinatura(tabelas[i]);
+        if (indice < 0) {
+            printf("Erro: a tabela '%s' não tem registro de alterações.\n", tabelas[i]);
+            return 0;
+        }
+        assinatura->tabelas[indice] = 1;
+    }
+
+    // A partir de agora: gerações antes da sequência, para que uma gravação
+    // no meio apareça como publicação e não como recarga
+    if (apos_sequencia == ASSINATURA_DO_FIM) {
+        lerGeracoesAssinadas(assinatura, assinatura->geracoes);
+        apos_sequencia = ultimaSequenciaAlteracoes(diretorio);
+    }
+    assinatura->apos_sequencia = apos_sequencia;
+    return 1;
+}
+
+long lerLoteAlteracoes(AssinaturaAlteracoes *assinatura, LoteAlteracoes *lote, long maximo, int espera_ms) {
+    long long geracoes[TOTAL_TABELAS_ASSINATURA];
+    int esperado = 0;
+
+    lote->total = 0;
+    lote->tamanho_texto = 0;
+    if (maximo <= 0) {
+        maximo = 1;
+    }
+
+    for (;;) {
+        lerGeracoesAssinadas(assinatura, geracoes);
+        int fim = lerPublicacoes(assinatura, lote, maximo);
+        if (fim < 0) {
+            return -1;
+        }
+
+        // Log lido até o fim: geração acima da última publicada não foi registrada
+        for (int i = 0; fim && i < TOTAL_TABELAS_ASSINATURA; i++) {
+            if (geracoes[i] < 0) {
+                continue;
+            }
+            if (assinatura->geracoes[i] < 0) {
+                assinatura->geracoes[i] = geracoes[i];
+            } else if (geracoes[i] > assinatura->geracoes[i]) {
+                assinatura->geracoes[i] = geracoes[i];
+                if (!acrescentarRecarga(lote, assinatura->apos_sequencia, i)) {
+                    return -1;
+                }
+            }
+        }
+
+        if (lote->total > 0 || esperado >= espera_ms) {
+            break;
+        }
+        esperarAssinatura(INTERVALO_ASSINATURA_MS);
+        esperado += INTERVALO_ASSINATURA_MS;
+    }
+
+    for (long i = 0; i < lote->total; i++) {
+        lote->eventos[i].linha = lote->texto + lote->deslocamentos[i];
+    }
+    lote->ultima_sequencia = assinatura->apos_sequencia;
+    return lote->total;
+}
+
+void liberarLoteAlteracoes(LoteAlteracoes *lote) {
+    free(lote->eventos);
+    free(lote->deslocamentos);
+    free(lote->texto);
+    memset(lote, 0, sizeof(*lote));
+}
+
+void fecharAssinaturaAlteracoes(AssinaturaAlteracoes *assinatura) {
+    if (assinatura->aberto) {
+        fecharLeitorAlteracoes(&assinatura->leitor);
+        assinatura->aberto = 0;
+    }
+    for (int i = 0; i < TOTAL_TABELAS_ASSINATURA; i++) {
+        if (assinatura->travas[i].descritor >= 0) {
+            close(assinatura->travas[i].descritor);
+            assinatura->travas[i].descritor = -1;
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef ASSINATURA_MANAGER_H
+#define ASSINATURA_MANAGER_H
+
+#include <stddef.h>
+#include "structs.h"
+#include "tabela_manager.h"
+#include "alteracoes_manager.h"
+
+// ========== ASSINATURA DE ALTERAÇÕES (CHANGE DATA CAPTURE) ==========
+//
+// Um assinante (o front end, por exemplo) recebe em lotes as alterações das
+// tabelas que escolheu: inclusão, atualização ou exclusão de um registro,
+// com a linha do CSV e a sequência do registro de alterações
+// (alteracoes_manager.h), que só cresce. Guardando a sequência do último
+// lote aplicado, o assinante retoma dali depois de reiniciar, sem reler as
+// tabelas.
+//
+// Os eventos vêm do log, relido a cada espera; um lote termina sempre no fim
+// de uma publicação (nunca com metade das operações de uma gravação). Quando
+// o log não basta, o evento é RECARREGAR e a tabela deve ser relida inteira:
+// - a publicação recria a tabela (operação R do log);
+// - falta uma geração no log: CSV gravado pelo front end Python ou por outro
+//   programa, ou queda entre o rename e o registro. A geração de cada CSV é
+//   lida sob a trava compartilhada antes de esvaziar o log: se passou da
+//   última publicada, a gravação não foi registrada;
+// - faltam sequências (log podado por podarAlteracoes() depois da sequência
+//   pedida): RECARREGAR de todas as tabelas assinadas.
+// Inclusões e atualizações valem como "grava o registro desta chave" e
+// exclusões como "apaga esta chave": reaplicar eventos que a tabela relida
+// já reflete não muda o resultado.
+//
+// Ao retomar de uma sequência antiga, a geração de cada tabela só passa a
+// ser acompanhada a partir da primeira leitura: gravações de fora do log
+// feitas com o assinante parado não geram RECARREGAR.
+
+#define EVENTO_RECARREGAR 'L'
+
+#define TOTAL_TABELAS_ASSINATURA 7
+#define INTERVALO_ASSINATURA_MS 10     // Releitura do log durante a espera
+#define ASSINATURA_DO_FIM -1           // apos_sequencia: só alterações novas
+
+// Um evento; "linha" vale até a próxima leitura do mesmo lote
+typedef struct {
+    long long sequencia;           // Da operação no log (RECARREGAR: a do lote)
+    char tabela[MAX_NOME_TABELA_ALTERACAO]; // Nome do CSV ("aulas.csv")
+    char operacao;                 // ALTERACAO_INSERIR, _ATUALIZAR, _EXCLUIR ou EVENTO_RECARREGAR
+    const char *linha;             // Registro (EXCLUIR: a versão apagada; RECARREGAR: vazio)
+    size_t tamanho_linha;
+} EventoAlteracao;
+
+// Eventos lidos por uma chamada de lerLoteAlteracoes()
+typedef struct {
+    EventoAlteracao *eventos;
+    long total;
+    long long ultima_sequencia;    // Para retomar (apos_sequencia da próxima assinatura)
+    long capacidade;
+    size_t *deslocamentos;         // Início de cada linha em "texto" durante a montagem
+    char *texto;
+    size_t tamanho_texto;
+    size_t capacidade_texto;
+} LoteAlteracoes;
+
+typedef struct {
+    char diretorio[MAX_PATH];
+    LeitorAlteracoes leitor;
+    int aberto;
+    int tabelas[TOTAL_TABELAS_ASSINATURA];   // 1 se assinada
+    long long geracoes[TOTAL_TABELAS_ASSINATURA]; // Última vista (-1 = desconhecida)
+    TravaArquivo travas[TOTAL_TABELAS_ASSINATURA];
+    long long apos_sequencia;      // Última sequência já entregue
+} AssinaturaAlteracoes;
+
+// Função para assinar as alterações de "tabelas" ("alunos.csv", ...; NULL
+// ou "total" 0 = todas) em "diretorio", depois de "apos_sequencia"
+// (ASSINATURA_DO_FIM = a partir de agora)
+// Retorna: 1 se sucesso, 0 se alguma tabela não é registrada no log
+int abrirAssinaturaAlteracoes(AssinaturaAlteracoes *assinatura, const char *diretorio,
+                              const char *const *tabelas, int total, long long apos_sequencia);
+
+// Função para ler o próximo lote: espera até "espera_ms" pelo primeiro
+// evento (0 = não espera) e junta publicações até chegar a "maximo" eventos
+// Retorna: eventos no lote (0 se nada mudou), -1 se faltou memória
+long lerLoteAlteracoes(AssinaturaAlteracoes *assinatura, LoteAlteracoes *lote, long maximo, int espera_ms);
+
+// Função para liberar os buffers do lote
+void liberarLoteAlteracoes(LoteAlteracoes *lote);
+
+// Função para encerrar a assinatura
+void fecharAssinaturaAlteracoes(AssinaturaAlteracoes *assinatura);
+
+#endif
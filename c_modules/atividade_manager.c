@@ -3,6 +3,9 @@
 #include <string.h>
 #include "atividade_manager.h"
 #include "file_manager.h"
+#include "tabela_manager.h"
+#include "exportacao_manager.h"
+#include "agregado_manager.h"
 
 // ========== ARMAZENAMENTO EM MEMÓRIA ==========
 static Atividade atividades[MAX_ATIVIDADES];
@@ -16,14 +19,47 @@ static void carregarAtividadesMemoria(void) {
                                      atividades,
                                      MAX_ATIVIDADES,
                                      TIPO_ATIVIDADE);
+    publicarExportacao(EXPORTACAO_ATIVIDADES, atividades, total_atividades);
+    reconstruirAgregadosAtividades(atividades, total_atividades);
 }
 
-// Persiste as atividades do array em memória para o CSV
-static void salvarAtividadesArquivo(void) {
-    salvarDados(ARQUIVO_ATIVIDADES,
-                atividades,
-                total_atividades,
-                TIPO_ATIVIDADE);
+static int gravarAtividadesArquivo(void);
+
+// Trava leitores/escritor da tabela de atividades
+static TabelaResidente tabela_atividades = TABELA_RESIDENTE_INIT(ARQUIVO_ATIVIDADES,
+                                                                 carregarAtividadesMemoria,
+                                                                 gravarAtividadesArquivo);
+
+// Persiste as atividades do array em memória para o CSV (exige trava de escrita)
+static int gravarAtividadesArquivo(void) {
+    if (!salvarDados(ARQUIVO_ATIVIDADES,
+                     atividades,
+                     total_atividades,
+                     TIPO_ATIVIDADE)) {
+        return 0;
+    }
+    marcarTabelaSalva(&tabela_atividades);
+    return 1;
+}
+
+// Publica a versão confirmada para os demais leitores (após a transação)
+static int publicarAtividadesConfirmadas(int ignorado) {
+    (void)ignorado;
+    abrirLeituraTabela(&tabela_atividades);
+    publicarExportacao(EXPORTACAO_ATIVIDADES, atividades, total_atividades);
+    reconstruirAgregadosAtividades(atividades, total_atividades);
+    fecharTabela(&tabela_atividades);
+    return 1;
+}
+
+// Publica a alteração e grava agora ou em segundo plano (exige trava de escrita)
+static int salvarAtividadesArquivo(void) {
+    if (emTransacaoTabelas()) {
+        publicarTabelaAposConfirmar(&tabela_atividades, publicarAtividadesConfirmadas);
+    } else {
+        publicarExportacao(EXPORTACAO_ATIVIDADES, atividades, total_atividades);
+    }
+    return registrarAlteracaoTabela(&tabela_atividades);
 }
 
 // ========== FUNÇÕES PÚBLICAS ==========
@@ -33,43 +69,76 @@ int cadastrarAtividade(Atividade *atividade) {
         return 0;
     }
 
-    carregarAtividadesMemoria();
+    abrirEscritaTabela(&tabela_atividades);
 
     // Verifica unicidade do ID
     for (int i = 0; i < total_atividades; i++) {
         if (atividades[i].id == atividade->id) {
+            fecharTabela(&tabela_atividades);
             printf("Erro: atividade ID %d já cadastrada.\n", atividade->id);
             return 0;
         }
     }
 
     if (total_atividades >= MAX_ATIVIDADES) {
+        fecharTabela(&tabela_atividades);
         printf("Erro: limite máximo de atividades atingido.\n");
         return 0;
     }
 
     atividades[total_atividades] = *atividade;
     total_atividades++;
-    salvarAtividadesArquivo();
+    agregarAtividade(NULL, atividade);
+    int salvo = salvarAtividadesArquivo();
+    fecharTabela(&tabela_atividades);
+    if (!salvo) {
+        return 0;
+    }
 
     printf("Atividade '%s' cadastrada com sucesso!\n", atividade->titulo);
     return 1;
 }
 
+// O ponteiro só é estável até a próxima escrita; entre threads use obterAtividadePorID()
 Atividade* buscarAtividadePorID(int id) {
-    carregarAtividadesMemoria();
+    Atividade *encontrada = NULL;
+
+    abrirLeituraTabela(&tabela_atividades);
+
+    for (int i = 0; i < total_atividades; i++) {
+        if (atividades[i].id == id) {
+            encontrada = &atividades[i];
+            break;
+        }
+    }
+
+    fecharTabela(&tabela_atividades);
+    return encontrada;
+}
+
+int obterAtividadePorID(int id, Atividade *destino) {
+    int encontrada = 0;
+
+    if (destino == NULL) {
+        return 0;
+    }
+
+    abrirLeituraTabela(&tabela_atividades);
 
     for (int i = 0; i < total_atividades; i++) {
         if (atividades[i].id == id) {
-            return &atividades[i];
+            *destino = atividades[i];
+            encontrada = 1;
+            break;
         }
     }
 
-    return NULL;
+    fecharTabela(&tabela_atividades);
+    return encontrada;
 }
 
 int listarAtividades(Atividade *destino, int max) {
-    carregarAtividadesMemoria();
+    abrirLeituraTabela(&tabela_atividades);
 
     int count = (total_atividades < max) ? total_atividades : max;
 
@@ -77,11 +146,12 @@ int listarAtividades(Atividade *destino, int max) {
         destino[i] = atividades[i];
     }
 
+    fecharTabela(&tabela_atividades);
     return count;
 }
 
 int listarAtividadesDaTurma(int id_turma, Atividade *destino, int max) {
-    carregarAtividadesMemoria();
+    abrirLeituraTabela(&tabela_atividades);
 
     int count = 0;
 
@@ -92,51 +162,118 @@ int listarAtividadesDaTurma(int id_turma, Atividade *destino, int max) {
         }
     }
 
+    fecharTabela(&tabela_atividades);
     return count;
 }
 
+int contarAtividades(void) {
+    TotaisAgregados totais;
+
+    abrirLeituraTabela(&tabela_atividades); // Recarrega (e reconstrói) se o CSV mudou
+    lerTotaisAgregados(&totais);
+    fecharTabela(&tabela_atividades);
+
+    return totais.atividades;
+}
+
+int contarAtividadesDaTurma(int id_turma) {
+    AgregadoTurma agregado;
+
+    abrirLeituraTabela(&tabela_atividades);
+    lerAgregadoTurma(id_turma, &agregado);
+    fecharTabela(&tabela_atividades);
+
+    return agregado.atividades;
+}
+
 int atualizarAtividade(Atividade *atividade) {
     if (atividade == NULL) {
         return 0;
     }
 
-    carregarAtividadesMemoria();
+    abrirEscritaTabela(&tabela_atividades);
 
     for (int i = 0; i < total_atividades; i++) {
         if (atividades[i].id == atividade->id) {
+            Atividade antes = atividades[i];
             atividades[i] = *atividade;
-            salvarAtividadesArquivo();
+            agregarAtividade(&antes, &atividades[i]);
+            int salvo = salvarAtividadesArquivo();
+            fecharTabela(&tabela_atividades);
+            if (!salvo) {
+                return 0;
+            }
             printf("Atividade atualizada com sucesso!\n");
             return 1;
         }
     }
 
+    fecharTabela(&tabela_atividades);
     printf("Erro: atividade ID %d não encontrada.\n", atividade->id);
     return 0;
 }
 
 int excluirAtividade(int id) {
-    carregarAtividadesMemoria();
+    abrirEscritaTabela(&tabela_atividades);
 
     for (int i = 0; i < total_atividades; i++) {
         if (atividades[i].id == id) {
+            agregarAtividade(&atividades[i], NULL);
+
             // Desloca elementos para preencher o espaço
             for (int j = i; j < total_atividades - 1; j++) {
                 atividades[j] = atividades[j + 1];
             }
             total_atividades--;
-            salvarAtividadesArquivo();
+            int salvo = salvarAtividadesArquivo();
+            fecharTabela(&tabela_atividades);
+            if (!salvo) {
+                return 0;
+            }
             printf("Atividade ID %d removida com sucesso!\n", id);
             return 1;
         }
     }
 
+    fecharTabela(&tabela_atividades);
     printf("Erro: atividade ID %d não encontrada.\n", id);
     return 0;
 }
 
+int excluirAtividadesDaTurma(int id_turma, int *ids_destino, int max) {
+    int removidas = 0;
+    int mantidas = 0;
+
+    abrirEscritaTabela(&tabela_atividades);
+
+    // Compacta o array mantendo a ordem das demais atividades
+    for (int i = 0; i < total_atividades; i++) {
+        if (atividades[i].id_turma == id_turma) {
+            agregarAtividade(&atividades[i], NULL);
+            if (ids_destino != NULL && removidas < max) {
+                ids_destino[removidas] = atividades[i].id;
+            }
+            removidas++;
+        } else {
+            if (mantidas != i) {
+                atividades[mantidas] = atividades[i];
+            }
+            mantidas++;
+        }
+    }
+
+    if (removidas > 0) {
+        total_atividades = mantidas;
+        if (!salvarAtividadesArquivo()) {
+            removidas = -1; // Alteração desfeita: nada foi excluído
+        }
+    }
+    fecharTabela(&tabela_atividades);
+    return removidas;
+}
+
 int gerarProximoIDAtividade(void) {
-    carregarAtividadesMemoria();
+    abrirLeituraTabela(&tabela_atividades);
 
     int maior_id = 0;
 
@@ -146,6 +283,6 @@ int gerarProximoIDAtividade(void) {
         }
     }
 
+    fecharTabela(&tabela_atividades);
     return maior_id + 1;
 }
-
@@ -16,6 +16,10 @@ int cadastrarAtividade(Atividade *atividade);
 // Retorna ponteiro para a atividade ou NULL se não encontrada
 Atividade* buscarAtividadePorID(int id);
 
+// Copiar atividade por ID para o destino (seguro entre threads)
+// Retorna 1 se encontrada, 0 caso contrário
+int obterAtividadePorID(int id, Atividade *destino);
+
 // Listar todas as atividades
 // Copia até max atividades para o destino e retorna a quantidade copiada
 int listarAtividades(Atividade *destino, int max);
@@ -24,12 +28,23 @@ int listarAtividades(Atividade *destino, int max);
 // Retorna a quantidade copiada para o destino
 int listarAtividadesDaTurma(int id_turma, Atividade *destino, int max);
 
+// Contar todas as atividades (O(1), contador de agregado_manager)
+int contarAtividades(void);
+
+// Contar atividades de uma turma (O(1))
+int contarAtividadesDaTurma(int id_turma);
+
 // Atualizar uma atividade existente
 int atualizarAtividade(Atividade *atividade);
 
 // Excluir uma atividade definitivamente (remove do arquivo)
 int excluirAtividade(int id);
 
+// Excluir todas as atividades de uma turma (uma passada e uma gravação)
+// Os IDs removidos são copiados para ids_destino (até max; pode ser NULL)
+// Retorna: número de atividades excluídas, ou -1 se a gravação falhou
+int excluirAtividadesDaTurma(int id_turma, int *ids_destino, int max);
+
 // Gerar próximo ID sequencial disponível
 int gerarProximoIDAtividade(void);
 
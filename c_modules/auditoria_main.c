@@ -0,0 +1,110 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "structs.h"
+#include "auditoria_manager.h"
+#include "log_auditoria_manager.h"
+
+// Consulta e exportação do log de auditoria binário (data/auditoria)
+//
+//   sistema_auditoria --login prof1 --ultimas-horas 24
+//   sistema_auditoria --auth --falhas --contar
+//   sistema_auditoria --exportar auth_log.txt --auth
+
+static void exibirAjuda(const char *programa) {
+    printf("Uso: %s [opcoes]\n", programa);
+    printf("  --dir DIR           Diretorio do log (padrao: %s)\n", LOG_AUDITORIA_DIR);
+    printf("  --login LOGIN       Apenas eventos do login\n");
+    printf("  --acao ACAO         Apenas eventos da acao (LOGIN, LOGOUT, ...)\n");
+    printf("  --auth | --acoes    Apenas tentativas de login / apenas acoes\n");
+    printf("  --falhas | --sucessos\n");
+    printf("  --desde MS          Inicio do intervalo (ms desde 1970)\n");
+    printf("  --ate MS            Fim do intervalo (ms desde 1970)\n");
+    printf("  --ultimas-horas H   Intervalo das ultimas H horas\n");
+    printf("  --exportar ARQ      Grava as linhas em ARQ em vez da tela\n");
+    printf("  --contar            Mostra apenas a quantidade de eventos\n");
+}
+
+static int contarEvento(const EventoAuditoria *evento, void *contexto) {
+    (void)evento;
+    (void)contexto;
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    const char *diretorio = LOG_AUDITORIA_DIR;
+    const char *exportar = NULL;
+    FiltroAuditoria filtro;
+    int contar = 0;
+
+    filtroAuditoriaPadrao(&filtro);
+
+    for (int i = 1; i < argc; i++) {
+        const char *valor = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(argv[i], "--dir") == 0 && valor) {
+            diretorio = valor;
+            i++;
+        } else if (strcmp(argv[i], "--login") == 0 && valor) {
+            filtro.login = valor;
+            i++;
+        } else if (strcmp(argv[i], "--acao") == 0 && valor) {
+            filtro.acao = valor;
+            i++;
+        } else if (strcmp(argv[i], "--auth") == 0) {
+            filtro.destino = AUDITORIA_AUTH;
+        } else if (strcmp(argv[i], "--acoes") == 0) {
+            filtro.destino = AUDITORIA_ACOES;
+        } else if (strcmp(argv[i], "--falhas") == 0) {
+            filtro.sucesso = 0;
+        } else if (strcmp(argv[i], "--sucessos") == 0) {
+            filtro.sucesso = 1;
+        } else if (strcmp(argv[i], "--desde") == 0 && valor) {
+            filtro.inicio_ms = strtoll(valor, NULL, 10);
+            i++;
+        } else if (strcmp(argv[i], "--ate") == 0 && valor) {
+            filtro.fim_ms = strtoll(valor, NULL, 10);
+            i++;
+        } else if (strcmp(argv[i], "--ultimas-horas") == 0 && valor) {
+            filtro.inicio_ms = ((int64_t)time(NULL) - (int64_t)(atof(valor) * 3600)) * 1000;
+            i++;
+        } else if (strcmp(argv[i], "--exportar") == 0 && valor) {
+            exportar = valor;
+            i++;
+        } else if (strcmp(argv[i], "--contar") == 0) {
+            contar = 1;
+        } else {
+            exibirAjuda(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    if (contar) {
+        long total = consultarLogAuditoria(diretorio, &filtro, contarEvento, NULL);
+        if (total < 0) {
+            printf("Erro: diretório de auditoria '%s' não encontrado.\n", diretorio);
+            return 1;
+        }
+        printf("%ld\n", total);
+        return 0;
+    }
+
+    FILE *saida = stdout;
+    if (exportar != NULL) {
+        saida = fopen(exportar, "w");
+        if (saida == NULL) {
+            printf("Erro: não foi possível criar '%s'.\n", exportar);
+            return 1;
+        }
+    }
+
+    long linhas = exportarLogTexto(diretorio, &filtro, saida);
+
+    if (saida != stdout) {
+        fclose(saida);
+        printf("%ld linhas exportadas para %s.\n", linhas, exportar);
+    }
+    return 0;
+}
@@ -0,0 +1,354 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include "auditoria_manager.h"
+#include "structs.h"
+#include "log_auditoria_manager.h"
+
+#define MASCARA_AUDITORIA (AUDITORIA_CAPACIDADE - 1)
+#define TENTATIVAS_ESPERA 1000         // sched_yield() antes de descartar (~1 ms)
+#define ESPERA_ESCRITORA_MS 50         // Cochilo máximo da escritora sem aviso
+
+// ========== ESTRUTURAS INTERNAS ==========
+
+// Posição do anel: "sequencia" == índice global quando livre para o produtor
+// da volta atual, índice + 1 quando pronta para a escritora
+typedef struct {
+    _Atomic uint64_t sequencia;
+    EventoAuditoria evento;
+} EntradaAuditoria;
+
+static EntradaAuditoria anel[AUDITORIA_CAPACIDADE];
+static _Atomic uint64_t cauda = 0;             // Próxima posição dos produtores
+static uint64_t cabeca = 0;                    // Próxima posição da escritora
+static _Atomic unsigned long long descartadas = 0;
+static _Atomic int escritora_dormindo = 0;
+static _Atomic int ativa = 0;
+static int politica_ativa = AUDITORIA_ESPERAR;
+
+static char diretorio_auditoria[MAX_PATH] = LOG_AUDITORIA_DIR;
+
+// Controle da escritora (início, parada, barreira)
+static pthread_mutex_t trava_controle = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sinal_escritora = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t sinal_gravado = PTHREAD_COND_INITIALIZER;
+static pthread_t escritora;
+static int parar_escritora = 0;
+static int iniciada_alguma_vez = 0;
+static int saida_registrada = 0;
+static int log_direto_aberto = 0;              // Log aberto por gravarDiretamente()
+static uint64_t gravadas_ate = 0;              // Entradas [0, gravadas_ate) já gravadas
+static _Atomic unsigned long long total_gravacoes = 0;
+
+// ========== FUNÇÕES AUXILIARES PRIVADAS ==========
+
+static int64_t instanteAtualMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void preencherEvento(EventoAuditoria *evento, DestinoAuditoria destino, const char *login,
+                            const char *acao, int sucesso, const char *detalhes) {
+    evento->instante_ms = instanteAtualMs();
+    evento->destino = (int)destino;
+    evento->sucesso = sucesso ? 1 : 0;
+    snprintf(evento->login, sizeof(evento->login), "%s", login ? login : "");
+    snprintf(evento->acao, sizeof(evento->acao), "%s", acao ? acao : "");
+    snprintf(evento->detalhes, sizeof(evento->detalhes), "%s", detalhes ? detalhes : "");
+}
+
+// Retira as entradas prontas e entrega o lote ao log; retorna quantas retirou
+static int drenarAnel(void) {
+    static unsigned long long descartes_relatados = 0;
+    int retiradas = 0;
+
+    for (;;) {
+        EntradaAuditoria *entrada = &anel[cabeca & MASCARA_AUDITORIA];
+        uint64_t sequencia = atomic_load_explicit(&entrada->sequencia, memory_order_acquire);
+
+        if (sequencia != cabeca + 1) {
+            break;              // Vazia ou ainda sendo preenchida
+        }
+        anexarEventoLog(&entrada->evento);
+        atomic_store_explicit(&entrada->sequencia, cabeca + AUDITORIA_CAPACIDADE,
+                              memory_order_release);
+        cabeca++;
+        retiradas++;
+    }
+
+    // Descartes viram um evento no log de ações
+    unsigned long long perdidas = atomic_load_explicit(&descartadas, memory_order_relaxed);
+    if (perdidas != descartes_relatados) {
+        EventoAuditoria aviso;
+        char detalhes[64];
+        snprintf(detalhes, sizeof(detalhes), "%llu entradas descartadas (anel cheio)",
+                 perdidas - descartes_relatados);
+        preencherEvento(&aviso, AUDITORIA_ACOES, "", "AUDITORIA", 0, detalhes);
+        anexarEventoLog(&aviso);
+        descartes_relatados = perdidas;
+    }
+
+    if (descarregarLogAuditoria()) {
+        atomic_fetch_add_explicit(&total_gravacoes, 1, memory_order_relaxed);
+    }
+    return retiradas;
+}
+
+// Prazo absoluto "ms" a partir de agora (para pthread_cond_timedwait)
+static void prazoEmMs(struct timespec *prazo, long ms) {
+    clock_gettime(CLOCK_REALTIME, prazo);
+    prazo->tv_nsec += ms * 1000000L;
+    while (prazo->tv_nsec >= 1000000000L) {
+        prazo->tv_sec++;
+        prazo->tv_nsec -= 1000000000L;
+    }
+}
+
+static void *executarEscritora(void *arg) {
+    (void)arg;
+
+    for (;;) {
+        int retiradas = drenarAnel();
+
+        pthread_mutex_lock(&trava_controle);
+        gravadas_ate = cabeca;
+        pthread_cond_broadcast(&sinal_gravado);
+
+        if (parar_escritora && cabeca == atomic_load(&cauda)) {
+            pthread_mutex_unlock(&trava_controle);
+            break;
+        }
+
+        // Anel vazio: avisa os produtores e cochila (o aviso pode se perder
+        // entre a conferência e a espera; o prazo limita o atraso)
+        if (retiradas == 0) {
+            struct timespec prazo;
+            atomic_store(&escritora_dormindo, 1);
+            if (!parar_escritora &&
+                atomic_load_explicit(&anel[cabeca & MASCARA_AUDITORIA].sequencia,
+                                     memory_order_acquire) != cabeca + 1) {
+                prazoEmMs(&prazo, ESPERA_ESCRITORA_MS);
+                pthread_cond_timedwait(&sinal_escritora, &trava_controle, &prazo);
+            }
+            atomic_store(&escritora_dormindo, 0);
+        }
+        pthread_mutex_unlock(&trava_controle);
+    }
+
+    fecharLogAuditoria();
+    return NULL;
+}
+
+static void acordarEscritora(void) {
+    if (atomic_load_explicit(&escritora_dormindo, memory_order_relaxed)) {
+        pthread_mutex_lock(&trava_controle);
+        pthread_cond_signal(&sinal_escritora);
+        pthread_mutex_unlock(&trava_controle);
+    }
+}
+
+// Inicia a escritora (exige trava_controle)
+static int iniciarEscritora(int politica) {
+    if (atomic_load(&ativa)) {
+        return 1;
+    }
+
+    // Recomeça a partir da cauda atual (reinício após encerrarAuditoria)
+    cabeca = atomic_load(&cauda);
+    for (uint64_t posicao = cabeca; posicao < cabeca + AUDITORIA_CAPACIDADE; posicao++) {
+        atomic_store_explicit(&anel[posicao & MASCARA_AUDITORIA].sequencia, posicao,
+                              memory_order_relaxed);
+    }
+    gravadas_ate = cabeca;
+
+    if (log_direto_aberto) {
+        fecharLogAuditoria();
+        log_direto_aberto = 0;
+    }
+    if (!abrirLogAuditoria(diretorio_auditoria)) {
+        return 0;
+    }
+
+    politica_ativa = politica;
+    parar_escritora = 0;
+    iniciada_alguma_vez = 1;
+    if (pthread_create(&escritora, NULL, executarEscritora, NULL) != 0) {
+        fecharLogAuditoria();
+        printf("Erro: não foi possível iniciar a escritora de auditoria.\n");
+        return 0;
+    }
+    atomic_store(&ativa, 1);
+
+    if (!saida_registrada) {
+        atexit(encerrarAuditoria);
+        saida_registrada = 1;
+    }
+    return 1;
+}
+
+// Sem escritora (após encerrarAuditoria): grava o evento diretamente, com o
+// log aberto até o próximo início ou encerramento
+static int gravarDiretamente(const EventoAuditoria *evento) {
+    int ok = 0;
+
+    pthread_mutex_lock(&trava_controle);
+    if (!atomic_load(&ativa)) {
+        if (!log_direto_aberto) {
+            log_direto_aberto = abrirLogAuditoria(diretorio_auditoria);
+        }
+        if (log_direto_aberto && anexarEventoLog(evento)) {
+            descarregarLogAuditoria();
+            ok = 1;
+        }
+    }
+    pthread_mutex_unlock(&trava_controle);
+    return ok;
+}
+
+// ========== FUNÇÕES PÚBLICAS ==========
+
+int iniciarAuditoria(int politica) {
+    pthread_mutex_lock(&trava_controle);
+    int ok = iniciarEscritora(politica);
+    pthread_mutex_unlock(&trava_controle);
+    return ok;
+}
+
+void encerrarAuditoria(void) {
+    pthread_mutex_lock(&trava_controle);
+    if (!atomic_load(&ativa)) {
+        if (log_direto_aberto) {
+            fecharLogAuditoria();
+            log_direto_aberto = 0;
+        }
+        pthread_mutex_unlock(&trava_controle);
+        return;
+    }
+    atomic_store(&ativa, 0);
+    parar_escritora = 1;
+    pthread_cond_signal(&sinal_escritora);
+    pthread_mutex_unlock(&trava_controle);
+
+    pthread_join(escritora, NULL);
+}
+
+int redirecionarAuditoria(const char *diretorio) {
+    int ok = 0;
+
+    if (diretorio == NULL) {
+        return 0;
+    }
+    pthread_mutex_lock(&trava_controle);
+    if (!atomic_load(&ativa)) {
+        if (log_direto_aberto) {
+            fecharLogAuditoria();
+            log_direto_aberto = 0;
+        }
+        snprintf(diretorio_auditoria, sizeof(diretorio_auditoria), "%s", diretorio);
+        ok = 1;
+    }
+    pthread_mutex_unlock(&trava_controle);
+    return ok;
+}
+
+const char* diretorioAuditoria(void) {
+    return diretorio_auditoria;
+}
+
+int registrarEventoAuditoria(DestinoAuditoria destino, const char *login, const char *acao,
+                             int sucesso, const char *detalhes) {
+    int tentativas = 0;
+
+    if ((unsigned)destino >= TOTAL_DESTINOS_AUDITORIA || acao == NULL) {
+        return 0;
+    }
+
+    // Primeiro registro do processo inicia a escritora
+    if (!atomic_load_explicit(&ativa, memory_order_acquire)) {
+        pthread_mutex_lock(&trava_controle);
+        if (!iniciada_alguma_vez) {
+            iniciarEscritora(AUDITORIA_ESPERAR);
+        }
+        pthread_mutex_unlock(&trava_controle);
+
+        if (!atomic_load(&ativa)) {
+            EventoAuditoria evento;
+            preencherEvento(&evento, destino, login, acao, sucesso, detalhes);
+            return gravarDiretamente(&evento);
+        }
+    }
+
+    // Reserva uma posição (fila limitada de múltiplos produtores)
+    uint64_t posicao = atomic_load_explicit(&cauda, memory_order_relaxed);
+    EntradaAuditoria *entrada;
+    for (;;) {
+        entrada = &anel[posicao & MASCARA_AUDITORIA];
+        uint64_t sequencia = atomic_load_explicit(&entrada->sequencia, memory_order_acquire);
+        int64_t diferenca = (int64_t)(sequencia - posicao);
+
+        if (diferenca == 0) {
+            if (atomic_compare_exchange_weak_explicit(&cauda, &posicao, posicao + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diferenca < 0) {
+            // Anel cheio
+            if (politica_ativa == AUDITORIA_DESCARTAR || ++tentativas > TENTATIVAS_ESPERA) {
+                atomic_fetch_add_explicit(&descartadas, 1, memory_order_relaxed);
+                acordarEscritora();
+                return 0;
+            }
+            acordarEscritora();
+            sched_yield();
+            posicao = atomic_load_explicit(&cauda, memory_order_relaxed);
+        } else {
+            posicao = atomic_load_explicit(&cauda, memory_order_relaxed);
+        }
+    }
+
+    preencherEvento(&entrada->evento, destino, login, acao, sucesso, detalhes);
+    atomic_store_explicit(&entrada->sequencia, posicao + 1, memory_order_release);
+
+    acordarEscritora();
+    return 1;
+}
+
+int registrarAuditoria(DestinoAuditoria destino, const char *formato, ...) {
+    char detalhes[LOG_MAX_DETALHES];
+    va_list argumentos;
+
+    if (formato == NULL) {
+        return 0;
+    }
+    va_start(argumentos, formato);
+    vsnprintf(detalhes, sizeof(detalhes), formato, argumentos);
+    va_end(argumentos);
+    return registrarEventoAuditoria(destino, "", "MENSAGEM", 1, detalhes);
+}
+
+void descarregarAuditoria(void) {
+    uint64_t alvo = atomic_load(&cauda);
+
+    pthread_mutex_lock(&trava_controle);
+    while (atomic_load(&ativa) && gravadas_ate < alvo) {
+        pthread_cond_signal(&sinal_escritora);
+        pthread_cond_wait(&sinal_gravado, &trava_controle);
+    }
+    pthread_mutex_unlock(&trava_controle);
+}
+
+void estatisticasAuditoria(EstatisticasAuditoria *destino) {
+    pthread_mutex_lock(&trava_controle);
+    destino->registradas = atomic_load(&cauda);
+    destino->gravadas = gravadas_ate;
+    destino->descartadas = atomic_load(&descartadas);
+    destino->gravacoes = total_gravacoes;
+    pthread_mutex_unlock(&trava_controle);
+}
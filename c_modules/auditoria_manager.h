@@ -0,0 +1,73 @@
+#ifndef AUDITORIA_MANAGER_H
+#define AUDITORIA_MANAGER_H
+
+// ========== LOG DE AUDITORIA ASSÍNCRONO ==========
+//
+// Quem registra (login, ações) apenas copia o evento para uma posição de um
+// anel de tamanho fixo, sem trava e sem chamadas de sistema. Uma thread
+// escritora retira as entradas em ordem e as acrescenta ao log binário de
+// log_auditoria_manager.h, entregando cada lote com uma única gravação.
+//
+// O anel é uma fila limitada de múltiplos produtores: cada posição tem um
+// número de sequência que diz se ela está livre para o produtor da volta
+// atual ou pronta para a escritora. Com o anel cheio, a política escolhida
+// decide entre descartar (contando o descarte) ou esperar um tempo limitado.
+//
+// O primeiro registro inicia a escritora automaticamente e agenda
+// encerrarAuditoria() para a saída do processo.
+
+#include "log_auditoria_manager.h"
+
+#define AUDITORIA_CAPACIDADE 4096      // Entradas no anel (potência de 2)
+
+// Política com o anel cheio
+#define AUDITORIA_DESCARTAR 0          // Descarta a entrada e conta o descarte
+#define AUDITORIA_ESPERAR 1            // Espera até ~1 ms pela escritora; depois descarta
+
+// Origem do evento (antigos data/auth_log.txt e data/acoes_log.txt)
+typedef enum {
+    AUDITORIA_AUTH = 0,                // Tentativas de login
+    AUDITORIA_ACOES,                   // Ações dos usuários
+    TOTAL_DESTINOS_AUDITORIA
+} DestinoAuditoria;
+
+// Contadores desde o início do processo
+typedef struct {
+    unsigned long long registradas;    // Entradas aceitas no anel
+    unsigned long long gravadas;       // Entradas já entregues ao log
+    unsigned long long descartadas;    // Entradas perdidas com o anel cheio
+    unsigned long long gravacoes;      // Lotes entregues ao sistema
+} EstatisticasAuditoria;
+
+// Função para iniciar a escritora com a política desejada
+// Opcional: o primeiro registro inicia com AUDITORIA_ESPERAR.
+// Retorna: 1 se ativa, 0 se erro
+int iniciarAuditoria(int politica);
+
+// Função para gravar o que estiver no anel e parar a escritora
+void encerrarAuditoria(void);
+
+// Função para trocar o diretório do log (só com a escritora parada)
+// Retorna: 1 se trocou, 0 se a escritora está ativa
+int redirecionarAuditoria(const char *diretorio);
+
+// Função para obter o diretório do log em uso
+const char* diretorioAuditoria(void);
+
+// Função para registrar um evento estruturado
+// Retorna: 1 se a entrada entrou no anel, 0 se foi descartada
+int registrarEventoAuditoria(DestinoAuditoria destino, const char *login, const char *acao,
+                             int sucesso, const char *detalhes);
+
+// Função para registrar uma mensagem livre (ação "MENSAGEM", sem login)
+// Retorna: 1 se a entrada entrou no anel, 0 se foi descartada
+int registrarAuditoria(DestinoAuditoria destino, const char *formato, ...);
+
+// Função barreira: retorna quando tudo o que foi registrado antes da chamada
+// estiver entregue ao log
+void descarregarAuditoria(void);
+
+// Função para consultar os contadores
+void estatisticasAuditoria(EstatisticasAuditoria *destino);
+
+#endif
@@ -3,6 +3,13 @@
 #include <string.h>
 #include "aula_manager.h"
 #include "file_manager.h"
+#include "tabela_manager.h"
+#include "snapshot_manager.h"
+#include "exportacao_manager.h"
+#include "relatorio_manager.h"
+#include "agregado_manager.h"
+#include "turma_manager.h"
+#include "frequencia_manager.h"
 
 // ========== ARRAYS GLOBAIS (EM MEMÓRIA) ==========
 static Aula aulas[MAX_AULAS];
@@ -10,18 +17,92 @@ static int total_aulas = 0;
 
 // ========== FUNÇÕES AUXILIARES PRIVADAS ==========
 
-// Carrega aulas do arquivo para memória
+// Versões imutáveis usadas pelas listagens e relatórios
+static TabelaSnapshot snapshot_aulas = TABELA_SNAPSHOT_INIT(Aula);
+
+// Versão vista só pela thread da transação que alterou as aulas
+static TabelaSnapshot snapshot_aulas_transacao = TABELA_SNAPSHOT_INIT(Aula);
+static unsigned long transacao_das_aulas = 0;
+
+// Ordem crescente de IDs (bsearch das aulas a mover)
+static int compararIDs(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Carrega aulas do arquivo para memória e publica a nova versão
 static void carregarAulasMemoria(void) {
     total_aulas = carregarDados(ARQUIVO_AULAS, aulas, MAX_AULAS, TIPO_AULA);
+    publicarSnapshot(&snapshot_aulas, aulas, total_aulas);
+    publicarExportacao(EXPORTACAO_AULAS, aulas, total_aulas);
+    reconstruirAgregadosAulas(aulas, total_aulas);
+}
+
+static int gravarAulasArquivo(void);
+
+// Trava leitores/escritor da tabela de aulas
+static TabelaResidente tabela_aulas = TABELA_RESIDENTE_INIT(ARQUIVO_AULAS, carregarAulasMemoria,
+                                                            gravarAulasArquivo);
+
+// Grava aulas da memória para o arquivo (exige trava de escrita)
+static int gravarAulasArquivo(void) {
+    if (!salvarDados(ARQUIVO_AULAS, aulas, total_aulas, TIPO_AULA)) {
+        return 0;
+    }
+    marcarTabelaSalva(&tabela_aulas);
+    return 1;
+}
+
+// Publica a versão confirmada para os demais leitores (após a transação)
+static int publicarAulasConfirmadas(int ignorado) {
+    (void)ignorado;
+    abrirLeituraTabela(&tabela_aulas);
+    publicarSnapshot(&snapshot_aulas, aulas, total_aulas);
+    publicarExportacao(EXPORTACAO_AULAS, aulas, total_aulas);
+    reconstruirAgregadosAulas(aulas, total_aulas);
+    fecharTabela(&tabela_aulas);
+    return 1;
 }
 
-// Salva aulas da memória para o arquivo
-static void salvarAulasArquivo(void) {
-    salvarDados(ARQUIVO_AULAS, aulas, total_aulas, TIPO_AULA);
+// Publica a nova versão e grava agora ou em segundo plano (exige trava de escrita)
+// Em transação, só a própria thread vê a versão nova até a confirmação
+static int salvarAulasArquivo(void) {
+    if (emTransacaoTabelas()) {
+        publicarTabelaAposConfirmar(&tabela_aulas, publicarAulasConfirmadas);
+        publicarSnapshot(&snapshot_aulas_transacao, aulas, total_aulas);
+        transacao_das_aulas = numeroTransacaoTabelas();
+    } else {
+        publicarSnapshot(&snapshot_aulas, aulas, total_aulas);
+        publicarExportacao(EXPORTACAO_AULAS, aulas, total_aulas);
+    }
+    return registrarAlteracaoTabela(&tabela_aulas);
 }
 
 // ========== IMPLEMENTAÇÃO DAS FUNÇÕES PÚBLICAS ==========
 
+// Obter a versão publicada das aulas sem esperar por escritores
+Snapshot* adquirirSnapshotAulas(void) {
+    unsigned long transacao = numeroTransacaoTabelas();
+    
+    // A thread da transação lê as próprias alterações
+    if (transacao != 0 && transacao == transacao_das_aulas) {
+        return adquirirSnapshot(&snapshot_aulas_transacao);
+    }
+    
+    sincronizarTabelaSemBloquear(&tabela_aulas);
+    
+    Snapshot *versao = adquirirSnapshot(&snapshot_aulas);
+    if (versao == NULL) {
+        // Nenhuma versão publicada ainda: aguarda apenas a carga inicial
+        abrirLeituraTabela(&tabela_aulas);
+        fecharTabela(&tabela_aulas);
+        versao = adquirirSnapshot(&snapshot_aulas);
+    }
+    
+    return versao;
+}
+
 // Registrar uma nova aula no diário eletrônico
 int registrarAula(Aula *aula) {
     // Estrutura de decisão (requisito obrigatório)
@@ -36,11 +117,12 @@ int registrarAula(Aula *aula) {
         return 0;
     }
     
-    carregarAulasMemoria();
+    abrirEscritaTabela(&tabela_aulas);
     
     // Verificar se ID já existe
     for (int i = 0; i < total_aulas; i++) {
         if (aulas[i].id == aula->id) {
+            fecharTabela(&tabela_aulas);
             printf("Erro: ID %d já cadastrado.\n", aula->id);
             return 0;
         }
@@ -48,6 +130,7 @@ int registrarAula(Aula *aula) {
     
     // Verificar limite
     if (total_aulas >= MAX_AULAS) {
+        fecharTabela(&tabela_aulas);
         printf("Erro: limite de aulas atingido.\n");
         return 0;
     }
@@ -55,53 +138,90 @@ int registrarAula(Aula *aula) {
     // Adicionar nova aula
     aulas[total_aulas] = *aula;
     total_aulas++;
-    salvarAulasArquivo();
+    agregarAula(NULL, aula);
+    int salvo = salvarAulasArquivo();
+    fecharTabela(&tabela_aulas);
+    if (!salvo) {
+        return 0;
+    }
     
     printf("Aula registrada com sucesso no diário eletrônico!\n");
     return 1;
 }
 
 // Buscar aula por ID (uso de ponteiro - requisito desejável)
+// O ponteiro só é estável até a próxima escrita; entre threads use obterAulaPorID()
 Aula* buscarAulaPorID(int id) {
-    carregarAulasMemoria();
+    Aula *encontrada = NULL;
+    
+    abrirLeituraTabela(&tabela_aulas);
     
     // Estrutura de repetição (requisito obrigatório)
     for (int i = 0; i < total_aulas; i++) {
         if (aulas[i].id == id) {
-            return &aulas[i]; // Retorna ponteiro
+            encontrada = &aulas[i]; // Retorna ponteiro
+            break;
+        }
+    }
+    
+    fecharTabela(&tabela_aulas);
+    return encontrada; // NULL se não encontrada
+}
+
+// Copiar aula por ID para o destino
+int obterAulaPorID(int id, Aula *destino) {
+    int encontrada = 0;
+    
+    if (destino == NULL) {
+        return 0;
+    }
+    
+    Snapshot *versao = adquirirSnapshotAulas();
+    
+    for (int i = 0; i < totalRegistrosSnapshot(versao); i++) {
+        const Aula *aula = registroSnapshot(versao, i);
+        if (aula->id == id) {
+            *destino = *aula;
+            encontrada = 1;
+            break;
         }
     }
     
-    return NULL; // Não encontrada
+    liberarSnapshot(versao);
+    return encontrada;
 }
 
 // Listar todas as aulas de uma turma específica
 int listarAulasDaTurma(int id_turma, Aula *destino, int max) {
-    carregarAulasMemoria();
+    Snapshot *versao = adquirirSnapshotAulas();
     
     int count = 0;
     
     // Estrutura de repetição com decisão (requisito obrigatório)
-    for (int i = 0; i < total_aulas && count < max; i++) {
-        if (aulas[i].id_turma == id_turma) {
-            destino[count] = aulas[i];
+    for (int i = 0; i < totalRegistrosSnapshot(versao) && count < max; i++) {
+        const Aula *aula = registroSnapshot(versao, i);
+        if (aula->id_turma == id_turma) {
+            destino[count] = *aula;
             count++;
         }
     }
     
+    liberarSnapshot(versao);
     return count;
 }
 
 // Listar todas as aulas
 int listarTodasAulas(Aula *destino, int max) {
-    carregarAulasMemoria();
+    Snapshot *versao = adquirirSnapshotAulas();
     
-    int count = (total_aulas < max) ? total_aulas : max;
+    int total = totalRegistrosSnapshot(versao);
+    int count = (total < max) ? total : max;
     
     for (int i = 0; i < count; i++) {
-        destino[i] = aulas[i];
+        destino[i] = *(const Aula *)registroSnapshot(versao, i);
     }
     
+    liberarSnapshot(versao);
     return count;
 }
 
@@ -116,132 +236,256 @@ int atualizarAula(Aula *aula) {
         return 0;
     }
     
-    carregarAulasMemoria();
+    abrirEscritaTabela(&tabela_aulas);
     
     for (int i = 0; i < total_aulas; i++) {
         if (aulas[i].id == aula->id) {
+            Aula antes = aulas[i];
             aulas[i] = *aula;
-            salvarAulasArquivo();
+            agregarAula(&antes, &aulas[i]);
+            int salvo = salvarAulasArquivo();
+            fecharTabela(&tabela_aulas);
+            if (!salvo) {
+                return 0;
+            }
             printf("Aula atualizada com sucesso!\n");
             return 1;
         }
     }
     
+    fecharTabela(&tabela_aulas);
     printf("Erro: aula não encontrada.\n");
     return 0;
 }
 
 // Excluir uma aula do diário
 int excluirAula(int id) {
-    carregarAulasMemoria();
+    abrirEscritaTabela(&tabela_aulas);
     
     for (int i = 0; i < total_aulas; i++) {
         if (aulas[i].id == id) {
+            agregarAula(&aulas[i], NULL);
+            
             // Remove a aula deslocando os elementos
             for (int j = i; j < total_aulas - 1; j++) {
                 aulas[j] = aulas[j + 1];
             }
             total_aulas--;
-            salvarAulasArquivo();
+            int salvo = salvarAulasArquivo();
+            fecharTabela(&tabela_aulas);
+            if (!salvo) {
+                return 0;
+            }
             
             printf("Aula excluída com sucesso!\n");
             return 1;
         }
     }
     
+    fecharTabela(&tabela_aulas);
     printf("Erro: aula não encontrada.\n");
     return 0;
 }
 
+// Excluir todas as aulas de uma turma compactando o array
+int excluirAulasDaTurma(int id_turma, int *ids_destino, int max) {
+    int removidas = 0;
+    int mantidas = 0;
+
+    abrirEscritaTabela(&tabela_aulas);
+
+    for (int i = 0; i < total_aulas; i++) {
+        if (aulas[i].id_turma == id_turma) {
+            agregarAula(&aulas[i], NULL);
+            if (ids_destino != NULL && removidas < max) {
+                ids_destino[removidas] = aulas[i].id;
+            }
+            removidas++;
+        } else {
+            if (mantidas != i) {
+                aulas[mantidas] = aulas[i];
+            }
+            mantidas++;
+        }
+    }
+
+    if (removidas > 0) {
+        total_aulas = mantidas;
+        if (!salvarAulasArquivo()) {
+            removidas = -1; // Alteração desfeita: nada foi excluído
+        }
+    }
+    fecharTabela(&tabela_aulas);
+    return removidas;
+}
+
+// Mover aulas para outra turma numa única transação
+int moverAulasParaTurma(const int *ids_aulas, int total, int id_turma_destino) {
+    Turma destino;
+    int movidas = 0;
+    int encontradas = 0;
+    int ok;
+
+    if (ids_aulas == NULL || total <= 0) {
+        return 0;
+    }
+
+    int *ids = malloc(sizeof(int) * (size_t)total);
+    if (ids == NULL) {
+        printf("Erro: memória insuficiente.\n");
+        return -1;
+    }
+    memcpy(ids, ids_aulas, sizeof(int) * (size_t)total);
+    qsort(ids, (size_t)total, sizeof(int), compararIDs);
+
+    if (!iniciarTransacaoTabelas()) {
+        free(ids);
+        return -1;
+    }
+
+    ok = obterTurmaPorID(id_turma_destino, &destino);
+    if (!ok) {
+        printf("Erro: turma %d não encontrada.\n", id_turma_destino);
+    }
+
+    if (ok) {
+        abrirEscritaTabela(&tabela_aulas);
+        for (int i = 0; i < total_aulas; i++) {
+            if (bsearch(&aulas[i].id, ids, (size_t)total, sizeof(int), compararIDs) == NULL) {
+                continue;
+            }
+            encontradas++;
+            if (aulas[i].id_turma == id_turma_destino) {
+                continue;
+            }
+            Aula antes = aulas[i];
+            aulas[i].id_turma = id_turma_destino;
+            agregarAula(&antes, &aulas[i]);
+            // A chamada foi feita sobre os alunos da turma antiga
+            ok = ok && aposConfirmarTransacaoTabelas(excluirChamada, aulas[i].id);
+            movidas++;
+        }
+        if (movidas > 0 && !salvarAulasArquivo()) {
+            ok = 0;
+        }
+        fecharTabela(&tabela_aulas);
+
+        if (encontradas != total) {
+            printf("Erro: %d aula(s) não encontrada(s) ou repetida(s).\n", total - encontradas);
+            ok = 0;
+        }
+    }
+
+    free(ids);
+    if (!concluirTransacaoTabelas(ok)) {
+        return -1;
+    }
+    return movidas;
+}
+
 // ========== FUNÇÕES DE CONSULTA E RELATÓRIOS ==========
 
 // Buscar aulas por data específica
 int buscarAulasPorData(const char *data, Aula *destino, int max) {
-    carregarAulasMemoria();
+    Snapshot *versao = adquirirSnapshotAulas();
     
     int count = 0;
     
-    for (int i = 0; i < total_aulas && count < max; i++) {
+    for (int i = 0; i < totalRegistrosSnapshot(versao) && count < max; i++) {
+        const Aula *aula = registroSnapshot(versao, i);
         // Comparação de strings (requisito de estrutura de decisão)
-        if (strcmp(aulas[i].data, data) == 0) {
-            destino[count] = aulas[i];
+        if (strcmp(aula->data, data) == 0) {
+            destino[count] = *aula;
             count++;
         }
     }
     
+    liberarSnapshot(versao);
     return count;
 }
 
 // Buscar aulas de uma turma em um período
 int buscarAulasPorPeriodo(int id_turma, const char *data_inicio, 
                           const char *data_fim, Aula *destino, int max) {
-    carregarAulasMemoria();
+    Snapshot *versao = adquirirSnapshotAulas();
     
     int count = 0;
     
     // Estrutura de repetição com múltiplas condições
-    for (int i = 0; i < total_aulas && count < max; i++) {
-        if (aulas[i].id_turma == id_turma) {
+    for (int i = 0; i < totalRegistrosSnapshot(versao) && count < max; i++) {
+        const Aula *aula = registroSnapshot(versao, i);
+        if (aula->id_turma == id_turma) {
             // Comparação de datas (simplificada - considera formato DD/MM/AAAA)
-            if (strcmp(aulas[i].data, data_inicio) >= 0 && 
-                strcmp(aulas[i].data, data_fim) <= 0) {
-                destino[count] = aulas[i];
+            if (strcmp(aula->data, data_inicio) >= 0 && 
+                strcmp(aula->data, data_fim) <= 0) {
+                destino[count] = *aula;
                 count++;
             }
         }
     }
     
+    liberarSnapshot(versao);
     return count;
 }
 
-// Contar total de aulas de uma turma
+// Contar total de aulas de uma turma (contador mantido por agregado_manager)
 int contarAulasDaTurma(int id_turma) {
-    carregarAulasMemoria();
+    AgregadoTurma agregado;
     
-    int count = 0;
+    // Como as leituras por snapshot: confere o CSV sem esperar escritores
+    liberarSnapshot(adquirirSnapshotAulas());
+    lerAgregadoTurma(id_turma, &agregado);
     
-    for (int i = 0; i < total_aulas; i++) {
-        if (aulas[i].id_turma == id_turma) {
-            count++;
-        }
-    }
+    return agregado.aulas;
+}
+
+// Contar total de aulas
+int contarAulas(void) {
+    TotaisAgregados totais;
     
-    return count;
+    liberarSnapshot(adquirirSnapshotAulas());
+    lerTotaisAgregados(&totais);
+    
+    return totais.aulas;
 }
 
 // Gerar relatório do diário de classe (Requisito de Sustentabilidade)
 int gerarRelatorioTurma(int id_turma, const char *arquivo_destino) {
-    carregarAulasMemoria();
+    BufferRelatorio buffer = {NULL, 0, 0};
     
-    FILE *relatorio = fopen(arquivo_destino, "w");
-    if (relatorio == NULL) {
+    // O relatório inteiro sai de uma única versão, mesmo com escritas concorrentes
+    Snapshot *versao = adquirirSnapshotAulas();
+    const Aula **da_turma = malloc(sizeof(const Aula *) * (size_t)(totalRegistrosSnapshot(versao) + 1));
+    if (da_turma == NULL) {
+        liberarSnapshot(versao);
         printf("Erro ao criar arquivo de relatório.\n");
         return 0;
     }
     
-    // Cabeçalho do relatório
-    fprintf(relatorio, "========================================\n");
-    fprintf(relatorio, "  DIÁRIO DE CLASSE - TURMA ID %d\n", id_turma);
-    fprintf(relatorio, "========================================\n\n");
-    
     int aulas_encontradas = 0;
     
     // Estrutura de repetição para gerar relatório
-    for (int i = 0; i < total_aulas; i++) {
-        if (aulas[i].id_turma == id_turma) {
-            fprintf(relatorio, "Data: %s\n", aulas[i].data);
-            fprintf(relatorio, "Conteúdo: %s\n", aulas[i].conteudo);
-            fprintf(relatorio, "----------------------------------------\n\n");
-            aulas_encontradas++;
+    for (int i = 0; i < totalRegistrosSnapshot(versao); i++) {
+        const Aula *aula = registroSnapshot(versao, i);
+        if (aula->id_turma == id_turma) {
+            da_turma[aulas_encontradas++] = aula;
         }
     }
     
-    // Rodapé do relatório
-    fprintf(relatorio, "\n========================================\n");
-    fprintf(relatorio, "Total de aulas ministradas: %d\n", aulas_encontradas);
-    fprintf(relatorio, "========================================\n");
+    // Mesmo texto do lote (relatorio_manager), gravado de uma vez
+    int montado = renderizarRelatorioTurma(&buffer, id_turma, da_turma, aulas_encontradas);
+    liberarSnapshot(versao);
+    free(da_turma);
     
+    FILE *relatorio = montado ? fopen(arquivo_destino, "w") : NULL;
+    if (relatorio == NULL) {
+        liberarBufferRelatorio(&buffer);
+        printf("Erro ao criar arquivo de relatório.\n");
+        return 0;
+    }
+    fwrite(buffer.dados, 1, buffer.usados, relatorio);
     fclose(relatorio);
+    liberarBufferRelatorio(&buffer);
     
     printf("Relatório gerado com sucesso: %s\n", arquivo_destino);
     printf("Total de aulas: %d\n", aulas_encontradas);
@@ -253,17 +497,19 @@ int gerarRelatorioTurma(int id_turma, const char *arquivo_destino) {
 
 // Gerar próximo ID disponível de aula
 int gerarProximoIDAula(void) {
-    carregarAulasMemoria();
+    Snapshot *versao = adquirirSnapshotAulas();
     
     int maior_id = 0;
     
     // Encontra o maior ID existente
-    for (int i = 0; i < total_aulas; i++) {
-        if (aulas[i].id > maior_id) {
-            maior_id = aulas[i].id;
+    for (int i = 0; i < totalRegistrosSnapshot(versao); i++) {
+        const Aula *aula = registroSnapshot(versao, i);
+        if (aula->id > maior_id) {
+            maior_id = aula->id;
         }
     }
     
+    liberarSnapshot(versao);
     return maior_id + 1;
 }
 
@@ -2,6 +2,7 @@
 #define AULA_MANAGER_H
 
 #include "structs.h"
+#include "snapshot_manager.h"
 
 #define MAX_AULAS 5000
 #define ARQUIVO_AULAS "data/aulas.csv"
@@ -16,6 +17,10 @@ int registrarAula(Aula *aula);
 // Retorna: ponteiro para a aula ou NULL se não encontrada
 Aula* buscarAulaPorID(int id);
 
+// Função para copiar a aula de um ID para o destino (seguro entre threads)
+// Retorna: 1 se encontrada, 0 se não
+int obterAulaPorID(int id, Aula *destino);
+
 // Função para listar todas as aulas de uma turma
 // Retorna: número de aulas listadas
 int listarAulasDaTurma(int id_turma, Aula *destino, int max);
@@ -32,8 +37,25 @@ int atualizarAula(Aula *aula);
 // Retorna: 1 se sucesso, 0 se erro
 int excluirAula(int id);
 
+// Função para excluir todas as aulas de uma turma (uma passada e uma gravação)
+// Os IDs removidos são copiados para ids_destino (até max; pode ser NULL)
+// Retorna: número de aulas excluídas, ou -1 se a gravação falhou
+int excluirAulasDaTurma(int id_turma, int *ids_destino, int max);
+
+// Função para mover aulas para outra turma numa única transação
+// (tabela_manager.h): se a turma ou alguma aula não existir, nada muda.
+// As chamadas das aulas movidas são excluídas depois da publicação, pois
+// valiam para os alunos da turma antiga
+// Retorna: aulas movidas (as que já estavam na turma não contam), -1 se erro
+int moverAulasParaTurma(const int *ids_aulas, int total, int id_turma_destino);
+
 // ========== FUNÇÕES DE CONSULTA E RELATÓRIOS ==========
 
+// Função para obter uma versão imutável das aulas (leitura sem bloqueio)
+// Os registros são acessados com registroSnapshot(versao, i) como const Aula*
+// Retorna: snapshot que deve ser devolvido com liberarSnapshot()
+Snapshot* adquirirSnapshotAulas(void);
+
 // Função para buscar aulas por data
 // Retorna: número de aulas encontradas naquela data
 int buscarAulasPorData(const char *data, Aula *destino, int max);
@@ -47,6 +69,9 @@ int buscarAulasPorPeriodo(int id_turma, const char *data_inicio,
 // Retorna: número de aulas ministradas
 int contarAulasDaTurma(int id_turma);
 
+// Função para contar o total de aulas
+int contarAulas(void);
+
 // Função para gerar relatório do diário de classe (texto)
 // Retorna: 1 se sucesso, 0 se erro
 int gerarRelatorioTurma(int id_turma, const char *arquivo_destino);
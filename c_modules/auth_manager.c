@@ -3,32 +3,35 @@
 #include <string.h>
 #include <time.h>
 #include "auth_manager.h"
-
-#define ARQUIVO_LOG_AUTH "data/auth_log.txt"
-#define ARQUIVO_ACOES "data/acoes_log.txt"
-
-// ========== FUNÇÕES AUXILIARES PRIVADAS ==========
-
-// Obter timestamp atual
-static long getTimestamp(void) {
-    return (long)time(NULL);
-}
+#include "auditoria_manager.h"
+#include "limitador_manager.h"
 
 // ========== IMPLEMENTAÇÃO DAS FUNÇÕES DE AUTENTICAÇÃO ==========
 
 // Autenticar um usuário
 Sessao* autenticar(const char *login, const char *senha, Sessao *sessao) {
+    return autenticarCliente(login, senha, NULL, sessao);
+}
+
+// Autenticar um usuário identificando a origem da tentativa
+// O limitador vem antes de qualquer busca: a recusa não lê a tabela nem o log
+Sessao* autenticarCliente(const char *login, const char *senha, const char *cliente, Sessao *sessao) {
     if (login == NULL || senha == NULL || sessao == NULL) {
         printf("Erro: parâmetros inválidos para autenticação.\n");
         registrarTentativaLogin(login ? login : "NULL", 0);
         return NULL;
     }
     
+    if (!consultarLimitador(login, cliente)) {
+        return NULL;
+    }
+    
     // Buscar usuário por login
     Usuario *usuario = buscarUsuarioPorLogin(login);
     
     if (usuario == NULL) {
         printf("Erro: usuário '%s' não encontrado.\n", login);
+        registrarFalhaLimitador(login, cliente);
         registrarTentativaLogin(login, 0);
         return NULL;
     }
@@ -36,6 +39,7 @@ Sessao* autenticar(const char *login, const char *senha, Sessao *sessao) {
     // Verificar se está ativo
     if (!usuario->ativo) {
         printf("Erro: usuário '%s' está desativado.\n", login);
+        registrarFalhaLimitador(login, cliente);
         registrarTentativaLogin(login, 0);
         return NULL;
     }
@@ -43,16 +47,24 @@ Sessao* autenticar(const char *login, const char *senha, Sessao *sessao) {
     // Verificar senha
     if (!verificarSenha(login, senha)) {
         printf("Erro: senha incorreta para usuário '%s'.\n", login);
+        registrarFalhaLimitador(login, cliente);
         registrarTentativaLogin(login, 0);
         return NULL;
     }
     
     // Criar sessão
+    DadosSessao dados;
+    if (!criarSessaoServidor(usuario->id, usuario->login, usuario->tipo, &dados)) {
+        registrarTentativaLogin(login, 0);
+        return NULL;
+    }
     sessao->id_usuario = usuario->id;
     strcpy(sessao->login, usuario->login);
     strcpy(sessao->tipo, usuario->tipo);
+    strcpy(sessao->token, dados.token);
+    prepararPermissoesSessao(sessao);
     sessao->ativo = 1;
-    sessao->timestamp_login = getTimestamp();
+    sessao->timestamp_login = dados.criada;
     
     printf("✓ Login bem-sucedido!\n");
     printf("  Usuário: %s\n", sessao->login);
@@ -86,11 +98,15 @@ int logout(Sessao *sessao) {
     }
     
     registrarAcao(sessao, "LOGOUT", "Logout realizado");
+    encerrarSessaoToken(sessao->token);
     
     // Limpar dados da sessão
     sessao->id_usuario = 0;
     memset(sessao->login, 0, sizeof(sessao->login));
     memset(sessao->tipo, 0, sizeof(sessao->tipo));
+    memset(sessao->token, 0, sizeof(sessao->token));
+    sessao->papel = 0;
+    sessao->permissoes = 0;
     sessao->ativo = 0;
     sessao->timestamp_login = 0;
     
@@ -100,41 +116,97 @@ int logout(Sessao *sessao) {
 
 // ========== FUNÇÕES DE AUTORIZAÇÃO ==========
 
+// Máscara de cada papel (índice = TipoUsuario; 0 = papel desconhecido)
+static const MascaraPermissoes permissoes_por_papel[] = {
+    0,
+    PERMISSOES_ADMIN,
+    PERMISSOES_PROFESSOR,
+    PERMISSOES_ALUNO
+};
+
+// Hash perfeito dos nomes de ação: (nome[1] * 4 + último + tamanho) & 15
+// não colide para os dez nomes; a posição guarda o único candidato
+typedef struct {
+    const char *nome;
+    AcaoPermissao acao;
+} NomeAcao;
+
+static const NomeAcao nomes_acoes[16] = {
+    [4]  = {"CADASTRAR_TURMA", ACAO_CADASTRAR_TURMA},
+    [13] = {"EDITAR_TURMA", ACAO_EDITAR_TURMA},
+    [3]  = {"REGISTRAR_AULA", ACAO_REGISTRAR_AULA},
+    [5]  = {"UPLOAD_ATIVIDADE", ACAO_UPLOAD_ATIVIDADE},
+    [8]  = {"VISUALIZAR_ALUNOS", ACAO_VISUALIZAR_ALUNOS},
+    [2]  = {"GERAR_RELATORIO", ACAO_GERAR_RELATORIO},
+    [15] = {"CONSULTAR_TURMAS", ACAO_CONSULTAR_TURMAS},
+    [14] = {"CONSULTAR_AULAS", ACAO_CONSULTAR_AULAS},
+    [9]  = {"BAIXAR_ATIVIDADE", ACAO_BAIXAR_ATIVIDADE},
+    [7]  = {"VISUALIZAR_NOTAS", ACAO_VISUALIZAR_NOTAS}
+};
+
+AcaoPermissao acaoPorNome(const char *nome) {
+    if (nome == NULL) {
+        return ACAO_NENHUMA;
+    }
+    size_t tamanho = strlen(nome);
+    if (tamanho < 2) {
+        return ACAO_NENHUMA;
+    }
+
+    const NomeAcao *candidato = &nomes_acoes[((unsigned char)nome[1] * 4u +
+                                              (unsigned char)nome[tamanho - 1] + tamanho) & 15u];
+    if (candidato->nome == NULL || strcmp(candidato->nome, nome) != 0) {
+        return ACAO_NENHUMA;
+    }
+    return candidato->acao;
+}
+
+MascaraPermissoes permissoesDoPapel(TipoUsuario papel) {
+    if ((unsigned)papel >= sizeof(permissoes_por_papel) / sizeof(permissoes_por_papel[0])) {
+        return 0;
+    }
+    return permissoes_por_papel[papel];
+}
+
+void prepararPermissoesSessao(Sessao *sessao) {
+    if (sessao == NULL) {
+        return;
+    }
+
+    // Tipo desconhecido fica sem papel (e sem permissões)
+    if (strcmp(sessao->tipo, "ADMIN") == 0) {
+        sessao->papel = TIPO_ADMIN;
+    } else if (strcmp(sessao->tipo, "PROFESSOR") == 0) {
+        sessao->papel = TIPO_PROFESSOR;
+    } else if (strcmp(sessao->tipo, "ALUNO") == 0) {
+        sessao->papel = TIPO_ALUNO;
+    } else {
+        sessao->papel = 0;
+    }
+    sessao->permissoes = permissoesDoPapel(sessao->papel);
+}
+
+// Verificar permissão pela constante da ação
+int temPermissaoAcao(const Sessao *sessao, AcaoPermissao acao) {
+    if (sessao == NULL || !sessao->ativo) {
+        return 0;
+    }
+    return (sessao->permissoes & acao) != 0;
+}
+
 // Verificar se usuário tem permissão para uma ação
 int temPermissao(Sessao *sessao, const char *acao) {
     if (sessao == NULL || acao == NULL || !sessao->ativo) {
         return 0;
     }
-    
-    // Admin tem permissão para tudo
-    if (isAdmin(sessao)) {
-        return 1;
-    }
-    
-    // Permissões específicas por tipo de usuário
-    if (isProfessor(sessao)) {
-        // Professor pode:
-        if (strcmp(acao, "CADASTRAR_TURMA") == 0 ||
-            strcmp(acao, "EDITAR_TURMA") == 0 ||
-            strcmp(acao, "REGISTRAR_AULA") == 0 ||
-            strcmp(acao, "UPLOAD_ATIVIDADE") == 0 ||
-            strcmp(acao, "VISUALIZAR_ALUNOS") == 0 ||
-            strcmp(acao, "GERAR_RELATORIO") == 0) {
-            return 1;
-        }
-    }
-    
-    if (isAluno(sessao)) {
-        // Aluno pode:
-        if (strcmp(acao, "CONSULTAR_TURMAS") == 0 ||
-            strcmp(acao, "CONSULTAR_AULAS") == 0 ||
-            strcmp(acao, "BAIXAR_ATIVIDADE") == 0 ||
-            strcmp(acao, "VISUALIZAR_NOTAS") == 0) {
-            return 1;
-        }
+
+    AcaoPermissao codigo = acaoPorNome(acao);
+
+    // Admin tem permissão para tudo, inclusive ações sem constante
+    if (codigo == ACAO_NENHUMA) {
+        return sessao->papel == TIPO_ADMIN;
     }
-    
-    return 0;
+    return (sessao->permissoes & codigo) != 0;
 }
 
 // Verificar se é admin
@@ -143,7 +215,7 @@ int isAdmin(Sessao *sessao) {
         return 0;
     }
     
-    return (strcmp(sessao->tipo, "ADMIN") == 0);
+    return sessao->papel == TIPO_ADMIN;
 }
 
 // Verificar se é professor
@@ -152,7 +224,7 @@ int isProfessor(Sessao *sessao) {
         return 0;
     }
     
-    return (strcmp(sessao->tipo, "PROFESSOR") == 0);
+    return sessao->papel == TIPO_PROFESSOR;
 }
 
 // Verificar se é aluno
@@ -161,13 +233,17 @@ int isAluno(Sessao *sessao) {
         return 0;
     }
     
-    return (strcmp(sessao->tipo, "ALUNO") == 0);
+    return sessao->papel == TIPO_ALUNO;
 }
 
 // ========== FUNÇÕES DE GESTÃO DE SESSÃO ==========
 
 // Validar se a sessão está ativa
+// Busca O(1) na tabela de sessões: a exclusão do usuário ou o reset da senha
+// já removeram o token, e a roda de tempo cuida do limite de 8 horas
 int validarSessao(Sessao *sessao) {
+    DadosSessao dados;
+
     if (sessao == NULL) {
         return 0;
     }
@@ -177,19 +253,11 @@ int validarSessao(Sessao *sessao) {
         return 0;
     }
     
-    // Verificar se usuário ainda existe e está ativo
-    Usuario *usuario = buscarUsuarioPorID(sessao->id_usuario);
-    if (usuario == NULL || !usuario->ativo) {
-        sessao->ativo = 0;
-        return 0;
-    }
-    
-    // Timeout de sessão: 8 horas (28800 segundos)
-    long tempo_atual = getTimestamp();
-    long tempo_sessao = tempo_atual - sessao->timestamp_login;
-    
-    if (tempo_sessao > 28800) {
+    int resultado = validarTokenSessao(sessao->token, &dados);
+    if (resultado == SESSAO_EXPIRADA) {
         printf("Sessão expirada. Faça login novamente.\n");
+    }
+    if (resultado != SESSAO_VALIDA || dados.id_usuario != sessao->id_usuario) {
         sessao->ativo = 0;
         return 0;
     }
@@ -209,23 +277,10 @@ Usuario* getUsuarioSessao(Sessao *sessao) {
 // ========== FUNÇÕES DE LOG/AUDITORIA ==========
 
 // Registrar tentativa de login
+// O evento entra no anel da auditoria; a escritora grava em lote
 int registrarTentativaLogin(const char *login, int sucesso) {
-    FILE *arquivo = fopen(ARQUIVO_LOG_AUTH, "a");
-    if (arquivo == NULL) {
-        return 0;
-    }
-    
-    time_t agora = time(NULL);
-    char *timestamp = ctime(&agora);
-    timestamp[strcspn(timestamp, "\n")] = 0; // Remove \n
-    
-    fprintf(arquivo, "[%s] LOGIN %s - Usuario: %s\n",
-            timestamp,
-            sucesso ? "SUCESSO" : "FALHA",
-            login ? login : "NULL");
-    
-    fclose(arquivo);
-    return 1;
+    return registrarEventoAuditoria(AUDITORIA_AUTH, login ? login : "NULL", "LOGIN",
+                                    sucesso, NULL);
 }
 
 // Registrar ação do usuário
@@ -234,5 +289,5 @@ int registrarAcao(Sessao *sessao, const char *acao, const char *detalhes) {
         return 0;
     }
     
-    FILE *arquivo = fopen(ARQUIVO_ACOES, "a");
+    return registrarEventoAuditoria(AUDITORIA_ACOES, sessao->login, acao, 1, detalhes);
 }
@@ -3,14 +3,47 @@
 
 #include "structs.h"
 #include "usuario_manager.h"
+#include "sessao_manager.h"
+
+// ========== PERMISSÕES ==========
+//
+// Cada ação conhecida é um bit; cada papel tem uma máscara fixa. A checagem é
+// um único AND entre a máscara da sessão (calculada no login) e o bit da ação.
+// Nomes de ação em texto passam por um hash perfeito (acaoPorNome).
+
+typedef enum {
+    ACAO_NENHUMA = 0,                  // Nome desconhecido
+    ACAO_CADASTRAR_TURMA = 1u << 0,
+    ACAO_EDITAR_TURMA = 1u << 1,
+    ACAO_REGISTRAR_AULA = 1u << 2,
+    ACAO_UPLOAD_ATIVIDADE = 1u << 3,
+    ACAO_VISUALIZAR_ALUNOS = 1u << 4,
+    ACAO_GERAR_RELATORIO = 1u << 5,
+    ACAO_CONSULTAR_TURMAS = 1u << 6,
+    ACAO_CONSULTAR_AULAS = 1u << 7,
+    ACAO_BAIXAR_ATIVIDADE = 1u << 8,
+    ACAO_VISUALIZAR_NOTAS = 1u << 9
+} AcaoPermissao;
+
+typedef unsigned int MascaraPermissoes;
+
+#define PERMISSOES_ADMIN 0xFFFFFFFFu   // Inclusive ações sem nome conhecido
+#define PERMISSOES_PROFESSOR (ACAO_CADASTRAR_TURMA | ACAO_EDITAR_TURMA | ACAO_REGISTRAR_AULA | \
+                              ACAO_UPLOAD_ATIVIDADE | ACAO_VISUALIZAR_ALUNOS | ACAO_GERAR_RELATORIO)
+#define PERMISSOES_ALUNO (ACAO_CONSULTAR_TURMAS | ACAO_CONSULTAR_AULAS | ACAO_BAIXAR_ATIVIDADE | \
+                          ACAO_VISUALIZAR_NOTAS)
 
 // Estrutura para representar uma sessão de usuário
+// (cópia do lado do chamador; o estado de referência fica em sessao_manager)
 typedef struct {
     int id_usuario;
     char login[MAX_LOGIN];
     char tipo[20];
     int ativo;
     long timestamp_login;  // Timestamp do login
+    char token[SESSAO_TAM_TOKEN];  // Token da tabela de sessões
+    TipoUsuario papel;             // Calculado a partir de "tipo" no login
+    MascaraPermissoes permissoes;  // Máscara do papel
 } Sessao;
 
 // ========== FUNÇÕES DE AUTENTICAÇÃO ==========
@@ -23,6 +56,12 @@ typedef struct {
 //   - sessao: ponteiro para armazenar dados da sessão
 Sessao* autenticar(const char *login, const char *senha, Sessao *sessao);
 
+// Função para autenticar informando a origem (IP, terminal...) da tentativa
+// Tentativas acima do limite do login ou do cliente (limitador_manager.h)
+// são recusadas antes de buscar o usuário, sem mensagem nem registro em log
+// Retorna: ponteiro para sessão criada ou NULL se falhar ou for bloqueada
+Sessao* autenticarCliente(const char *login, const char *senha, const char *cliente, Sessao *sessao);
+
 // Função para verificar se a senha está correta
 // Retorna: 1 se correta, 0 se incorreta
 int verificarSenha(const char *login, const char *senha);
@@ -33,10 +72,25 @@ int logout(Sessao *sessao);
 
 // ========== FUNÇÕES DE AUTORIZAÇÃO ==========
 
-// Função para verificar se usuário tem permissão para uma ação
+// Função para verificar se usuário tem permissão para uma ação (pelo nome)
 // Retorna: 1 se tem permissão, 0 se não tem
 int temPermissao(Sessao *sessao, const char *acao);
 
+// Função para verificar a permissão pela constante da ação (um AND)
+// Retorna: 1 se tem permissão, 0 se não tem
+int temPermissaoAcao(const Sessao *sessao, AcaoPermissao acao);
+
+// Função para converter o nome de uma ação na constante
+// Retorna: a ação ou ACAO_NENHUMA se o nome é desconhecido
+AcaoPermissao acaoPorNome(const char *nome);
+
+// Função para obter a máscara de permissões de um papel
+MascaraPermissoes permissoesDoPapel(TipoUsuario papel);
+
+// Função para preencher papel e permissões a partir de sessao->tipo
+// (autenticar() já chama; útil para sessões montadas pelo chamador)
+void prepararPermissoesSessao(Sessao *sessao);
+
 // Função para verificar se é admin
 // Retorna: 1 se é admin, 0 se não é
 int isAdmin(Sessao *sessao);
@@ -51,7 +105,7 @@ int isAluno(Sessao *sessao);
 
 // ========== FUNÇÕES DE GESTÃO DE SESSÃO ==========
 
-// Função para validar se a sessão está ativa
+// Função para validar se a sessão está ativa (consulta só a tabela de sessões)
 // Retorna: 1 se válida, 0 se inválida
 int validarSessao(Sessao *sessao);
 
@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "structs.h"
+#include "backup_manager.h"
+#include "alteracoes_manager.h"
+
+// Backup consistente do diretório de dados, com o sistema em uso
+//
+//   sistema_backup --criar backups/data_2025-09-01.pimb
+//   sistema_backup --verificar backups/data_2025-09-01.pimb
+//   sistema_backup --criar backups/data_2025-09-02.pimb --base backups/data_2025-09-01.pimb
+//   sistema_backup --restaurar backups/data_2025-09-01.pimb backups/data_2025-09-02.pimb --destino data_restaurado
+//   sistema_backup --podar backups/data_2025-09-02.pimb
+//
+// Os incrementais guardam só o que mudou desde o backup dado em --base; a
+// restauração recebe a cadeia em ordem e reconstrói o instante do último.
+// --podar apaga do registro de alterações o que o backup dado já cobre.
+//
+// Código de saída: 0 sucesso, 1 backup corrompido, 2 erro
+
+#define DIRETORIO_PADRAO "data"
+
+static void exibirAjuda(const char *programa) {
+    printf("Uso: %s [opcoes]\n", programa);
+    printf("  --criar ARQ        Grava o backup de --dir em ARQ\n");
+    printf("  --verificar ARQ    Confere estrutura e CRCs de ARQ\n");
+    printf("  --base ANTERIOR    Com --criar: backup incremental sobre ANTERIOR\n");
+    printf("  --restaurar ARQ... Restaura ARQ (completo seguido dos incrementais) em --destino\n");
+    printf("  --podar ARQ        Apaga do registro de alteracoes o que ARQ ja cobre\n");
+    printf("  --dir DIR          Diretorio dos dados (padrao: %s)\n", DIRETORIO_PADRAO);
+    printf("  --destino DIR      Diretorio novo para a restauracao\n");
+}
+
+static void exibirResumo(const char *acao, const ResumoBackup *resumo) {
+    printf("%s: %d arquivo(s), %lld linha(s), %lld bytes -> %lld bytes em %.3f s",
+           acao, resumo->arquivos, resumo->linhas, resumo->bytes, resumo->bytes_gravados, resumo->segundos);
+    if (resumo->tipo == BACKUP_TIPO_INCREMENTAL) {
+        printf(" (incremental: %d inalterado(s), %lld operacao(oes))", resumo->inalterados, resumo->alteracoes);
+    }
+    if (resumo->segundos_travado > 0.0) {
+        printf(" (travas por %.0f us)", resumo->segundos_travado * 1e6);
+    }
+    printf(".\n");
+}
+
+int main(int argc, char *argv[]) {
+    const char *diretorio = DIRETORIO_PADRAO;
+    const char *destino = NULL;
+    const char *criar = NULL;
+    const char *verificar = NULL;
+    const char *base = NULL;
+    const char *podar = NULL;
+    const char *restaurar[MAX_CADEIA_BACKUP];
+    int total_restaurar = 0;
+    ResumoBackup resumo;
+
+    for (int i = 1; i < argc; i++) {
+        const char *valor = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(argv[i], "--criar") == 0 && valor) {
+            criar = valor;
+            i++;
+        } else if (strcmp(argv[i], "--verificar") == 0 && valor) {
+            verificar = valor;
+            i++;
+        } else if (strcmp(argv[i], "--base") == 0 && valor) {
+            base = valor;
+            i++;
+        } else if (strcmp(argv[i], "--podar") == 0 && valor) {
+            podar = valor;
+            i++;
+        } else if (strcmp(argv[i], "--restaurar") == 0 && valor && total_restaurar == 0) {
+            // Os elos seguintes vêm até a próxima opção
+            while (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0 && total_restaurar < MAX_CADEIA_BACKUP) {
+                restaurar[total_restaurar++] = argv[++i];
+            }
+        } else if (strcmp(argv[i], "--dir") == 0 && valor) {
+            diretorio = valor;
+            i++;
+        } else if (strcmp(argv[i], "--destino") == 0 && valor) {
+            destino = valor;
+            i++;
+        } else {
+            exibirAjuda(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 2;
+        }
+    }
+
+    if ((criar != NULL) + (verificar != NULL) + (podar != NULL) + (total_restaurar > 0) != 1 ||
+        (total_restaurar > 0 && destino == NULL) || (base != NULL && criar == NULL)) {
+        exibirAjuda(argv[0]);
+        return 2;
+    }
+
+    if (criar != NULL) {
+        int ok = (base != NULL) ? criarBackupIncremental(diretorio, base, criar, &resumo)
+                                : criarBackup(diretorio, criar, &resumo);
+        if (!ok) {
+            return 2;
+        }
+        exibirResumo("Backup", &resumo);
+    } else if (verificar != NULL) {
+        if (!verificarBackup(verificar, &resumo)) {
+            return 1;
+        }
+        exibirResumo("Backup integro", &resumo);
+    } else if (podar != NULL) {
+        if (!lerInformacoesBackup(podar, &resumo)) {
+            return 2;
+        }
+        long mantidas = podarAlteracoes(diretorio, resumo.sequencia);
+        if (mantidas < 0) {
+            return 2;
+        }
+        printf("Registro de alteracoes podado ate a sequencia %lld: %ld operacao(oes) mantida(s).\n",
+               resumo.sequencia, mantidas);
+    } else {
+        if (strcmp(destino, diretorio) == 0) {
+            printf("Erro: restaure em outro diretorio e troque com o sistema parado.\n");
+            return 2;
+        }
+        if (!restaurarCadeiaBackup(restaurar, total_restaurar, destino, &resumo)) {
+            return 2;
+        }
+        exibirResumo("Restaurado", &resumo);
+    }
+
+    return 0;
+}
@@ -0,0 +1,1263 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "backup_manager.h"
+#include "tabela_manager.h"
+#include "journal_manager.h"
+#include "alteracoes_manager.h"
+#include "structs.h"
+
+#ifdef _WIN32
+#include <direct.h>
+#include <io.h>
+#define close _close
+#define criarDiretorio(caminho) _mkdir(caminho)
+#else
+#include <unistd.h>
+#define criarDiretorio(caminho) mkdir((caminho), 0755)
+#endif
+
+// Arquivos do backup, na ordem em que são travados
+static const char *arquivos_backup[TOTAL_ARQUIVOS_BACKUP] = {
+    "alunos.csv", "turmas.csv", "aulas.csv", "aluno_turma.csv",
+    "atividades.csv", "notas.csv", "usuarios.csv", "frequencia.dat"
+};
+
+#define COMPRESSAO_NENHUMA 0
+#define COMPRESSAO_LZ 1
+
+#define BITS_HASH_LZ 16
+#define MINIMO_LZ 4
+#define JANELA_LZ 65535
+
+// Arquivo aberto no instante da captura
+typedef struct {
+    int existe;
+    long long geracao;             // Contador do arquivo de trava
+    long long tamanho;             // Bytes no instante da captura
+    FILE *arquivo;                 // POSIX: lido depois de soltar as travas
+    unsigned char *dados;          // Windows: lido sob as travas
+} ArquivoCapturado;
+
+// Gravação do backup com CRC acumulado
+typedef struct {
+    FILE *arquivo;
+    uint32_t crc;                  // Estado (sem a inversão final)
+    long long bytes;
+    int erro;
+} SaidaBackup;
+
+// Leitura do backup com CRC acumulado
+typedef struct {
+    FILE *arquivo;
+    uint32_t crc;
+    int erro;
+} EntradaBackup;
+
+// Cabeçalho de um arquivo dentro do backup
+typedef struct {
+    char nome[MAX_NOME_ARQUIVO_BACKUP];
+    uint32_t modo;
+    uint32_t compressao;
+    long long geracao;
+    long long linhas;
+    long long tamanho;
+    long long gravado;
+    uint32_t crc_conteudo;
+    long long tamanho_final;
+} EntradaArquivoBackup;
+
+// Cabeçalho do backup
+typedef struct {
+    uint32_t versao;
+    uint32_t tipo;
+    uint32_t arquivos;
+    long long identificador;
+    long long base;
+    long long sequencia;
+} CabecalhoBackup;
+
+// Operações de um CSV desde o backup anterior (criação do incremental)
+typedef struct {
+    int candidato;                 // O anterior tem o CSV e a geração avançou
+    long long proxima_geracao;     // Próxima geração esperada no log
+    long long ate_geracao;         // Geração capturada
+    long long operacoes;
+    char *texto;
+    size_t tamanho;
+    size_t capacidade;
+} AlteracoesColetadas;
+
+// Arquivo sendo reconstruído pela restauração
+typedef struct {
+    int existe;
+    unsigned char *dados;          // Conteúdo do último backup completo (ou acrescido)
+    size_t tamanho;
+    ConteudoTabela *conteudo;      // Depois das primeiras operações
+    unsigned char **guardados;     // Operações aplicadas (o conteúdo aponta para elas)
+    int total_guardados;
+    int capacidade_guardados;
+    int conferido;                 // Conteúdo é o de um completo, com CRC já conferido
+    uint32_t crc;                  // Esperados no fim (último elo)
+    long long linhas;
+    long long tamanho_final;
+} ArquivoRestaurado;
+
+// ========== CRC-32 ==========
+
+// Tabelas do "slicing-by-8": oito bytes por iteração (o incremental lê e
+// confere todas as tabelas a cada backup)
+static uint32_t tabela_crc[8][256];
+static pthread_once_t crc_iniciado = PTHREAD_ONCE_INIT;
+
+static void montarTabelaCrc(void) {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        tabela_crc[0][i] = c;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+        for (int t = 1; t < 8; t++) {
+            tabela_crc[t][i] = tabela_crc[0][tabela_crc[t - 1][i] & 0xFF] ^ (tabela_crc[t - 1][i] >> 8);
+        }
+    }
+}
+
+// Continua o CRC "estado" (comece com 0xFFFFFFFF e inverta no fim)
+static uint32_t acumularCrc(uint32_t estado, const unsigned char *dados, size_t tamanho) {
+    size_t i = 0;
+
+    pthread_once(&crc_iniciado, montarTabelaCrc);
+    for (; i + 8 <= tamanho; i += 8) {
+        const unsigned char *p = dados + i;
+        uint32_t baixo = estado ^ ((uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 |
+                                   (uint32_t)p[3] << 24);
+        estado = tabela_crc[7][baixo & 0xFF] ^ tabela_crc[6][(baixo >> 8) & 0xFF] ^
+                 tabela_crc[5][(baixo >> 16) & 0xFF] ^ tabela_crc[4][baixo >> 24] ^ tabela_crc[3][p[4]] ^
+                 tabela_crc[2][p[5]] ^ tabela_crc[1][p[6]] ^ tabela_crc[0][p[7]];
+    }
+    for (; i < tamanho; i++) {
+        estado = tabela_crc[0][(estado ^ dados[i]) & 0xFF] ^ (estado >> 8);
+    }
+    return estado;
+}
+
+static uint32_t calcularCrc(const unsigned char *dados, size_t tamanho) {
+    return acumularCrc(0xFFFFFFFFu, dados, tamanho) ^ 0xFFFFFFFFu;
+}
+
+// ========== COMPRESSÃO LZ77 ==========
+
+// Cada sequência: token (4 bits de literais, 4 bits de cópia - MINIMO_LZ),
+// extensões de 255 quando o campo vale 15, literais, deslocamento u16 e
+// extensões da cópia. A última sequência tem só literais.
+
+static uint32_t lerQuatroBytes(const unsigned char *p) {
+    uint32_t valor;
+    memcpy(&valor, p, sizeof(valor));
+    return valor;
+}
+
+static unsigned char *escreverExtensao(unsigned char *saida, size_t resto) {
+    while (resto >= 255) {
+        *saida++ = 255;
+        resto -= 255;
+    }
+    *saida++ = (unsigned char)resto;
+    return saida;
+}
+
+// comprimento = 0: sequência final, só com literais
+static unsigned char *emitirSequencia(unsigned char *saida, const unsigned char *literais, size_t total_literais,
+                                      size_t deslocamento, size_t comprimento) {
+    size_t copia = comprimento ? comprimento - MINIMO_LZ : 0;
+    unsigned char *token = saida++;
+
+    *token = (unsigned char)(((total_literais < 15 ? total_literais : 15) << 4) | (copia < 15 ? copia : 15));
+    if (total_literais >= 15) {
+        saida = escreverExtensao(saida, total_literais - 15);
+    }
+    memcpy(saida, literais, total_literais);
+    saida += total_literais;
+
+    if (comprimento) {
+        *saida++ = (unsigned char)(deslocamento & 0xFF);
+        *saida++ = (unsigned char)(deslocamento >> 8);
+        if (copia >= 15) {
+            saida = escreverExtensao(saida, copia - 15);
+        }
+    }
+    return saida;
+}
+
+// Espaço que comprimirBloco() pode precisar no pior caso
+static size_t limiteComprimido(size_t tamanho) {
+    return tamanho + tamanho / 255 + 16;
+}
+
+// Retorna: bytes comprimidos em "destino", 0 se faltou memória
+static size_t comprimirBloco(const unsigned char *origem, size_t tamanho, unsigned char *destino) {
+    uint32_t *ultimas = calloc((size_t)1 << BITS_HASH_LZ, sizeof(uint32_t));  // Posição + 1
+    unsigned char *saida = destino;
+    size_t ancora = 0;
+    size_t i = 0;
+
+    if (ultimas == NULL) {
+        return 0;
+    }
+
+    while (i + MINIMO_LZ <= tamanho) {
+        uint32_t sequencia = lerQuatroBytes(origem + i);
+        uint32_t h = (sequencia * 2654435761u) >> (32 - BITS_HASH_LZ);
+        size_t candidata = ultimas[h];
+        ultimas[h] = (uint32_t)(i + 1);
+
+        if (candidata == 0 || i - (candidata - 1) > JANELA_LZ ||
+            lerQuatroBytes(origem + candidata - 1) != sequencia) {
+            i++;
+            continue;
+        }
+
+        size_t inicio = candidata - 1;
+        size_t comprimento = MINIMO_LZ;
+        while (i + comprimento < tamanho && origem[inicio + comprimento] == origem[i + comprimento]) {
+            comprimento++;
+        }
+        saida = emitirSequencia(saida, origem + ancora, i - ancora, i - inicio, comprimento);
+        i += comprimento;
+        ancora = i;
+    }
+
+    if (ancora < tamanho) {
+        saida = emitirSequencia(saida, origem + ancora, tamanho - ancora, 0, 0);
+    }
+    free(ultimas);
+    return (size_t)(saida - destino);
+}
+
+// Lê uma extensão de comprimento; 0 se os dados acabaram
+static int lerExtensao(const unsigned char **p, const unsigned char *fim, size_t *comprimento) {
+    unsigned char byte;
+    do {
+        if (*p >= fim) {
+            return 0;
+        }
+        byte = *(*p)++;
+        *comprimento += byte;
+    } while (byte == 255);
+    return 1;
+}
+
+// Retorna: 1 se gerou exatamente "esperado" bytes, 0 se os dados estão corrompidos
+static int descomprimirBloco(const unsigned char *origem, size_t tamanho, unsigned char *destino, size_t esperado) {
+    const unsigned char *p = origem;
+    const unsigned char *fim = origem + tamanho;
+    size_t gerados = 0;
+
+    while (p < fim) {
+        unsigned char token = *p++;
+        size_t literais = token >> 4;
+        size_t comprimento = (token & 15);
+
+        if (literais == 15 && !lerExtensao(&p, fim, &literais)) {
+            return 0;
+        }
+        if (literais > (size_t)(fim - p) || literais > esperado - gerados) {
+            return 0;
+        }
+        memcpy(destino + gerados, p, literais);
+        p += literais;
+        gerados += literais;
+
+        if (p == fim) {
+            break;
+        }
+        if (fim - p < 2) {
+            return 0;
+        }
+        size_t deslocamento = (size_t)p[0] | ((size_t)p[1] << 8);
+        p += 2;
+        if (comprimento == 15 && !lerExtensao(&p, fim, &comprimento)) {
+            return 0;
+        }
+        comprimento += MINIMO_LZ;
+        if (deslocamento == 0 || deslocamento > gerados || comprimento > esperado - gerados) {
+            return 0;
+        }
+        // Byte a byte: a cópia pode sobrepor o que ela mesma gera
+        for (size_t k = 0; k < comprimento; k++) {
+            destino[gerados + k] = destino[gerados - deslocamento + k];
+        }
+        gerados += comprimento;
+    }
+    return gerados == esperado;
+}
+
+// ========== GRAVAÇÃO E LEITURA DO FORMATO ==========
+
+static void escreverBytes(SaidaBackup *saida, const void *dados, size_t tamanho) {
+    if (saida->erro || tamanho == 0) {
+        return;
+    }
+    if (fwrite(dados, 1, tamanho, saida->arquivo) != tamanho) {
+        saida->erro = 1;
+        return;
+    }
+    saida->crc = acumularCrc(saida->crc, dados, tamanho);
+    saida->bytes += (long long)tamanho;
+}
+
+static void escreverU32(SaidaBackup *saida, uint32_t valor) {
+    unsigned char bytes[4];
+    for (int i = 0; i < 4; i++) {
+        bytes[i] = (unsigned char)(valor >> (8 * i));
+    }
+    escreverBytes(saida, bytes, sizeof(bytes));
+}
+
+static void escreverU64(SaidaBackup *saida, uint64_t valor) {
+    unsigned char bytes[8];
+    for (int i = 0; i < 8; i++) {
+        bytes[i] = (unsigned char)(valor >> (8 * i));
+    }
+    escreverBytes(saida, bytes, sizeof(bytes));
+}
+
+static int lerBytes(EntradaBackup *entrada, void *destino, size_t tamanho) {
+    if (entrada->erro) {
+        return 0;
+    }
+    if (fread(destino, 1, tamanho, entrada->arquivo) != tamanho) {
+        entrada->erro = 1;
+        return 0;
+    }
+    entrada->crc = acumularCrc(entrada->crc, destino, tamanho);
+    return 1;
+}
+
+static uint32_t lerU32(EntradaBackup *entrada) {
+    unsigned char bytes[4] = {0};
+    uint32_t valor = 0;
+    lerBytes(entrada, bytes, sizeof(bytes));
+    for (int i = 0; i < 4; i++) {
+        valor |= (uint32_t)bytes[i] << (8 * i);
+    }
+    return valor;
+}
+
+static uint64_t lerU64(EntradaBackup *entrada) {
+    unsigned char bytes[8] = {0};
+    uint64_t valor = 0;
+    lerBytes(entrada, bytes, sizeof(bytes));
+    for (int i = 0; i < 8; i++) {
+        valor |= (uint64_t)bytes[i] << (8 * i);
+    }
+    return valor;
+}
+
+static void escreverEntradaArquivo(SaidaBackup *saida, const EntradaArquivoBackup *entrada) {
+    escreverBytes(saida, entrada->nome, MAX_NOME_ARQUIVO_BACKUP);
+    escreverU32(saida, entrada->modo);
+    escreverU32(saida, entrada->compressao);
+    escreverU64(saida, (uint64_t)entrada->geracao);
+    escreverU64(saida, (uint64_t)entrada->linhas);
+    escreverU64(saida, (uint64_t)entrada->tamanho);
+    escreverU64(saida, (uint64_t)entrada->gravado);
+    escreverU32(saida, entrada->crc_conteudo);
+    escreverU64(saida, (uint64_t)entrada->tamanho_final);
+}
+
+static int lerEntradaArquivo(EntradaBackup *entrada, uint32_t versao, EntradaArquivoBackup *destino) {
+    lerBytes(entrada, destino->nome, MAX_NOME_ARQUIVO_BACKUP);
+    destino->nome[MAX_NOME_ARQUIVO_BACKUP - 1] = '\0';
+    destino->modo = lerU32(entrada);
+    destino->compressao = lerU32(entrada);
+    destino->geracao = (long long)lerU64(entrada);
+    destino->linhas = (long long)lerU64(entrada);
+    destino->tamanho = (long long)lerU64(entrada);
+    destino->gravado = (long long)lerU64(entrada);
+    destino->crc_conteudo = lerU32(entrada);
+    destino->tamanho_final = (versao >= 2) ? (long long)lerU64(entrada) : destino->tamanho;
+    return !entrada->erro && destino->tamanho >= 0 && destino->gravado >= 0 && destino->tamanho_final >= 0;
+}
+
+static void escreverCabecalho(SaidaBackup *saida, const CabecalhoBackup *cabecalho) {
+    escreverBytes(saida, BACKUP_MAGICO, 4);
+    escreverU32(saida, BACKUP_VERSAO);
+    escreverU32(saida, cabecalho->tipo);
+    escreverU64(saida, (uint64_t)cabecalho->identificador);
+    escreverU64(saida, (uint64_t)cabecalho->base);
+    escreverU64(saida, (uint64_t)time(NULL));
+    escreverU64(saida, (uint64_t)cabecalho->sequencia);
+    escreverU32(saida, cabecalho->arquivos);
+}
+
+// Retorna: 1 se é um backup reconhecido
+static int lerCabecalho(EntradaBackup *entrada, CabecalhoBackup *cabecalho) {
+    char magico[4];
+
+    memset(cabecalho, 0, sizeof(*cabecalho));
+    lerBytes(entrada, magico, sizeof(magico));
+    cabecalho->versao = lerU32(entrada);
+    cabecalho->tipo = lerU32(entrada);
+    cabecalho->identificador = (long long)lerU64(entrada);
+    if (cabecalho->versao >= 2) {
+        cabecalho->base = (long long)lerU64(entrada);
+    }
+    lerU64(entrada);
+    if (cabecalho->versao >= 2) {
+        cabecalho->sequencia = (long long)lerU64(entrada);
+    }
+    cabecalho->arquivos = lerU32(entrada);
+
+    return !entrada->erro && memcmp(magico, BACKUP_MAGICO, 4) == 0 && cabecalho->versao >= 1 &&
+           cabecalho->versao <= BACKUP_VERSAO && cabecalho->arquivos <= TOTAL_ARQUIVOS_BACKUP &&
+           (cabecalho->tipo == BACKUP_TIPO_COMPLETO ||
+            (cabecalho->tipo == BACKUP_TIPO_INCREMENTAL && cabecalho->base != 0));
+}
+
+// Posição do arquivo na lista do backup, -1 se o nome não é conhecido
+static int indiceArquivoBackup(const char *nome) {
+    for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP; i++) {
+        if (strcmp(arquivos_backup[i], nome) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// ========== CAPTURA ==========
+
+static double agoraSegundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void caminhoNoDiretorio(char *destino, size_t tamanho, const char *diretorio, const char *nome) {
+    snprintf(destino, tamanho, "%s/%s", diretorio, nome);
+}
+
+static void fecharTrava(TravaArquivo *trava) {
+    destravarArquivo(trava);
+    if (trava->descritor >= 0) {
+        close(trava->descritor);
+        trava->descritor = -1;
+    }
+}
+
+// Lê "tamanho" bytes do início do arquivo capturado
+// Retorna: buffer (malloc) ou NULL se erro
+static unsigned char *lerCapturado(ArquivoCapturado *captura) {
+    unsigned char *dados = malloc((size_t)captura->tamanho + 1);
+    if (dados == NULL) {
+        return NULL;
+    }
+    if (captura->tamanho > 0 &&
+        fread(dados, 1, (size_t)captura->tamanho, captura->arquivo) != (size_t)captura->tamanho) {
+        free(dados);
+        return NULL;
+    }
+    return dados;
+}
+
+static void liberarCaptura(ArquivoCapturado *capturas) {
+    for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP; i++) {
+        if (capturas[i].arquivo != NULL) {
+            fclose(capturas[i].arquivo);
+        }
+        free(capturas[i].dados);
+        memset(&capturas[i], 0, sizeof(capturas[i]));
+    }
+}
+
+// Abre todos os arquivos num mesmo instante (ver backup_manager.h)
+// Retorna: 1 se capturou, 0 se erro
+static int capturarDiretorio(const char *diretorio, ArquivoCapturado *capturas, long long *sequencia,
+                             double *segundos_travado) {
+    TravaArquivo trava_journal = TRAVA_ARQUIVO_INIT;
+    TravaArquivo travas[TOTAL_ARQUIVOS_BACKUP];
+    char journal[MAX_PATH * 2];
+    char caminho[MAX_PATH * 2];
+    struct stat info;
+    int ok = 1;
+
+    memset(capturas, 0, sizeof(ArquivoCapturado) * TOTAL_ARQUIVOS_BACKUP);
+    caminhoNoDiretorio(journal, sizeof(journal), diretorio, "journal.log");
+
+    double inicio = agoraSegundos();
+    ok = travarArquivo(&trava_journal, journal, TRAVA_EXCLUSIVA);
+
+    // Publicação interrompida: os CSVs estão entre duas versões
+    if (ok && stat(journal, &info) == 0) {
+        fecharTrava(&trava_journal);
+        if (strcmp(journal, ARQUIVO_JOURNAL) == 0) {
+            recuperarJournal();
+        }
+        inicio = agoraSegundos();
+        ok = travarArquivo(&trava_journal, journal, TRAVA_EXCLUSIVA) && stat(journal, &info) != 0;
+    }
+    if (!ok) {
+        fecharTrava(&trava_journal);
+        printf("Erro: não foi possível travar '%s' ou há publicação pendente.\n", journal);
+        return 0;
+    }
+
+    for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP; i++) {
+        travas[i] = (TravaArquivo)TRAVA_ARQUIVO_INIT;
+        caminhoNoDiretorio(caminho, sizeof(caminho), diretorio, arquivos_backup[i]);
+        if (stat(caminho, &info) != 0) {
+            continue;              // Sem o arquivo, sem trava (nem ".lock" novo)
+        }
+        if (!travarArquivo(&travas[i], caminho, TRAVA_COMPARTILHADA)) {
+            printf("Erro: não foi possível travar '%s'.\n", caminho);
+            ok = 0;
+            break;
+        }
+        capturas[i].geracao = lerGeracaoArquivo(&travas[i]);
+        capturas[i].arquivo = fopen(caminho, "rb");
+        if (capturas[i].arquivo == NULL) {
+            continue;              // Removido entre o stat e a trava
+        }
+        capturas[i].existe = 1;
+        fseek(capturas[i].arquivo, 0, SEEK_END);
+        capturas[i].tamanho = ftell(capturas[i].arquivo);
+        fseek(capturas[i].arquivo, 0, SEEK_SET);
+#ifdef _WIN32
+        // O rename de um escritor falharia com o arquivo aberto: lê agora
+        capturas[i].dados = lerCapturado(&capturas[i]);
+        fclose(capturas[i].arquivo);
+        capturas[i].arquivo = NULL;
+        if (capturas[i].dados == NULL) {
+            ok = 0;
+            break;
+        }
+#endif
+    }
+
+    // Com todos os CSVs travados, nenhuma publicação está no meio do registro
+    *sequencia = ultimaSequenciaAlteracoes(diretorio);
+
+    for (int i = TOTAL_ARQUIVOS_BACKUP - 1; i >= 0; i--) {
+        if (travas[i].descritor >= 0) {
+            fecharTrava(&travas[i]);
+        }
+    }
+    fecharTrava(&trava_journal);
+    *segundos_travado = agoraSegundos() - inicio;
+
+    if (!ok) {
+        liberarCaptura(capturas);
+    }
+    return ok;
+}
+
+// Linhas de dados de um CSV (sem o cabeçalho)
+static long long contarLinhasCsv(const char *nome, const unsigned char *dados, long long tamanho) {
+    long long linhas = 0;
+    size_t comprimento = strlen(nome);
+
+    if (comprimento < 4 || strcmp(nome + comprimento - 4, ".csv") != 0) {
+        return 0;
+    }
+    const unsigned char *fim = dados + tamanho;
+    for (const unsigned char *p = dados; (p = memchr(p, '\n', (size_t)(fim - p))) != NULL; p++) {
+        linhas++;
+    }
+    if (tamanho > 0 && dados[tamanho - 1] != '\n') {
+        linhas++;
+    }
+    return (linhas > 0) ? linhas - 1 : 0;
+}
+
+// Comprime e grava o conteúdo guardado de um arquivo ("tamanho" bytes em "dados")
+static int gravarConteudo(SaidaBackup *saida, EntradaArquivoBackup *entrada, const unsigned char *dados) {
+    size_t tamanho = (size_t)entrada->tamanho;
+    unsigned char *comprimido = (tamanho > 0) ? malloc(limiteComprimido(tamanho)) : NULL;
+    size_t gravado = (comprimido != NULL) ? comprimirBloco(dados, tamanho, comprimido) : 0;
+
+    if (gravado > 0 && gravado < tamanho) {
+        entrada->compressao = COMPRESSAO_LZ;
+        entrada->gravado = (long long)gravado;
+        escreverEntradaArquivo(saida, entrada);
+        escreverBytes(saida, comprimido, gravado);
+    } else {
+        entrada->compressao = COMPRESSAO_NENHUMA;
+        entrada->gravado = entrada->tamanho;
+        escreverEntradaArquivo(saida, entrada);
+        escreverBytes(saida, dados, tamanho);
+    }
+    free(comprimido);
+    return !saida->erro;
+}
+
+// Lê cabeçalho e entradas de um backup pulando o conteúdo (base do incremental)
+// Retorna: 1 se leu, 0 se não é um backup reconhecido
+static int lerEntradasBackup(const char *arquivo, CabecalhoBackup *cabecalho, EntradaArquivoBackup *entradas) {
+    EntradaBackup entrada;
+    int ok;
+
+    memset(&entrada, 0, sizeof(entrada));
+    memset(entradas, 0, sizeof(EntradaArquivoBackup) * TOTAL_ARQUIVOS_BACKUP);
+    entrada.arquivo = fopen(arquivo, "rb");
+    if (entrada.arquivo == NULL) {
+        printf("Erro: não foi possível abrir '%s'.\n", arquivo);
+        return 0;
+    }
+
+    ok = lerCabecalho(&entrada, cabecalho);
+    for (uint32_t i = 0; i < cabecalho->arquivos && ok; i++) {
+        EntradaArquivoBackup lida;
+        ok = lerEntradaArquivo(&entrada, cabecalho->versao, &lida) &&
+             fseek(entrada.arquivo, (long)lida.gravado, SEEK_CUR) == 0;
+        int indice = ok ? indiceArquivoBackup(lida.nome) : -1;
+        if (indice >= 0) {
+            entradas[indice] = lida;
+        }
+    }
+    fclose(entrada.arquivo);
+
+    if (!ok) {
+        printf("Erro: '%s' não é um backup reconhecido.\n", arquivo);
+    }
+    return ok;
+}
+
+static int acrescentarColetadas(AlteracoesColetadas *coletadas, const char *texto, size_t tamanho) {
+    if (coletadas->tamanho + tamanho > coletadas->capacidade) {
+        size_t capacidade = (coletadas->capacidade > 0) ? coletadas->capacidade : 4096;
+        while (coletadas->tamanho + tamanho > capacidade) {
+            capacidade *= 2;
+        }
+        char *maior = realloc(coletadas->texto, capacidade);
+        if (maior == NULL) {
+            return 0;
+        }
+        coletadas->texto = maior;
+        coletadas->capacidade = capacidade;
+    }
+    memcpy(coletadas->texto + coletadas->tamanho, texto, tamanho);
+    coletadas->tamanho += tamanho;
+    return 1;
+}
+
+// Junta as publicações de cada CSV candidato com gerações entre a do backup
+// anterior e a capturada; uma geração faltando desqualifica o CSV
+static void coletarAlteracoes(const char *diretorio, long long apos_sequencia, AlteracoesColetadas *coletadas) {
+    LeitorAlteracoes leitor;
+    PublicacaoAlteracoes publicacao;
+    int lida;
+
+    if (!abrirLeitorAlteracoes(&leitor, diretorio, apos_sequencia)) {
+        for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP; i++) {
+            coletadas[i].candidato = 0;
+        }
+        return;
+    }
+
+    while ((lida = lerPublicacaoAlteracoes(&leitor, &publicacao)) > 0) {
+        int indice = indiceArquivoBackup(publicacao.tabela);
+        AlteracoesColetadas *tabela = (indice >= 0) ? &coletadas[indice] : NULL;
+
+        // Publicada depois da captura: fica para o próximo
+        if (tabela == NULL || !tabela->candidato || publicacao.geracao > tabela->ate_geracao) {
+            continue;
+        }
+        // Geração sem registro, ou fora de ordem (contador de geração refeito)
+        if (publicacao.geracao != tabela->proxima_geracao ||
+            !acrescentarColetadas(tabela, publicacao.texto, publicacao.tamanho_texto)) {
+            tabela->candidato = 0;
+            continue;
+        }
+        tabela->operacoes += publicacao.total;
+        tabela->proxima_geracao = publicacao.geracao + 1;
+    }
+    fecharLeitorAlteracoes(&leitor);
+
+    for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP; i++) {
+        if (lida < 0 || coletadas[i].proxima_geracao != coletadas[i].ate_geracao + 1) {
+            coletadas[i].candidato = 0;
+        }
+    }
+}
+
+// Escolhe o modo de cada arquivo do incremental e aponta o que será guardado
+static void escolherModoIncremental(EntradaArquivoBackup *entrada, const EntradaArquivoBackup *anterior,
+                                    const AlteracoesColetadas *coletadas, const unsigned char *dados,
+                                    const unsigned char **guardar, long long *operacoes) {
+    long long tamanho_anterior = anterior->tamanho_final;
+
+    if (anterior->nome[0] == '\0' || anterior->modo == BACKUP_ARQUIVO_AUSENTE) {
+        return;
+    }
+    if (entrada->crc_conteudo == anterior->crc_conteudo && entrada->tamanho_final == tamanho_anterior) {
+        entrada->modo = BACKUP_ARQUIVO_SEM_ALTERACOES;
+        entrada->tamanho = 0;
+        return;
+    }
+
+    // frequencia.dat: o começo igual ao anterior basta
+    if (camposChaveAlteracoes(entrada->nome) == 0) {
+        if (entrada->tamanho_final > tamanho_anterior &&
+            calcularCrc(dados, (size_t)tamanho_anterior) == anterior->crc_conteudo) {
+            entrada->modo = BACKUP_ARQUIVO_ACRESCIMO;
+            entrada->tamanho = entrada->tamanho_final - tamanho_anterior;
+            *guardar = dados + tamanho_anterior;
+        }
+        return;
+    }
+
+    // Operações só quando o log cobre tudo e elas são menores que a tabela
+    if (coletadas->candidato && (long long)coletadas->tamanho < entrada->tamanho_final) {
+        entrada->modo = BACKUP_ARQUIVO_ALTERACOES;
+        entrada->tamanho = (long long)coletadas->tamanho;
+        *guardar = (const unsigned char *)coletadas->texto;
+        *operacoes = coletadas->operacoes;
+    }
+}
+
+// Grava um backup completo (base == NULL) ou incremental sobre "base"
+static int gravarBackup(const char *diretorio, const char *base, const char *destino, ResumoBackup *resumo) {
+    ArquivoCapturado capturas[TOTAL_ARQUIVOS_BACKUP];
+    EntradaArquivoBackup anteriores[TOTAL_ARQUIVOS_BACKUP];
+    AlteracoesColetadas coletadas[TOTAL_ARQUIVOS_BACKUP];
+    CabecalhoBackup cabecalho_base;
+    CabecalhoBackup cabecalho;
+    ResumoBackup total;
+    SaidaBackup saida;
+    double inicio = agoraSegundos();
+    int ok = 1;
+
+    memset(&total, 0, sizeof(total));
+    memset(anteriores, 0, sizeof(anteriores));
+    memset(coletadas, 0, sizeof(coletadas));
+    if (emTransacaoTabelas()) {
+        printf("Erro: backup dentro de uma transação.\n");
+        return 0;
+    }
+    if (base != NULL && !lerEntradasBackup(base, &cabecalho_base, anteriores)) {
+        return 0;
+    }
+
+    // Alterações adiadas deste processo entram no backup
+    if (!descarregarTabelas()) {
+        printf("Aviso: alterações adiadas que não puderam ser gravadas ficam fora do backup.\n");
+    }
+
+    if (!capturarDiretorio(diretorio, capturas, &total.sequencia, &total.segundos_travado)) {
+        return 0;
+    }
+
+    // O log só é lido depois de soltar as travas: o que vier após a captura fica de fora
+    if (base != NULL) {
+        for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP; i++) {
+            coletadas[i].candidato = capturas[i].existe && anteriores[i].nome[0] != '\0' &&
+                                     anteriores[i].modo != BACKUP_ARQUIVO_AUSENTE &&
+                                     camposChaveAlteracoes(arquivos_backup[i]) > 0 &&
+                                     capturas[i].geracao > anteriores[i].geracao;
+            coletadas[i].proxima_geracao = anteriores[i].geracao + 1;
+            coletadas[i].ate_geracao = capturas[i].geracao;
+        }
+        coletarAlteracoes(diretorio, cabecalho_base.sequencia, coletadas);
+    }
+
+    memset(&saida, 0, sizeof(saida));
+    saida.crc = 0xFFFFFFFFu;
+    saida.arquivo = abrirEscritaAtomica(destino);
+    if (saida.arquivo == NULL) {
+        printf("Erro ao criar '%s'.\n", destino);
+        liberarCaptura(capturas);
+        for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP; i++) {
+            free(coletadas[i].texto);
+        }
+        return 0;
+    }
+
+    // Microssegundos do relógio: distingue backups do mesmo diretório
+    struct timespec agora;
+    clock_gettime(CLOCK_REALTIME, &agora);
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    cabecalho.tipo = (base != NULL) ? BACKUP_TIPO_INCREMENTAL : BACKUP_TIPO_COMPLETO;
+    cabecalho.identificador = (long long)agora.tv_sec * 1000000LL + agora.tv_nsec / 1000;
+    cabecalho.base = (base != NULL) ? cabecalho_base.identificador : 0;
+    cabecalho.sequencia = total.sequencia;
+    cabecalho.arquivos = TOTAL_ARQUIVOS_BACKUP;
+    escreverCabecalho(&saida, &cabecalho);
+
+    for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP && ok; i++) {
+        EntradaArquivoBackup entrada;
+        memset(&entrada, 0, sizeof(entrada));
+        snprintf(entrada.nome, sizeof(entrada.nome), "%s", arquivos_backup[i]);
+        entrada.geracao = capturas[i].geracao;
+
+        if (!capturas[i].existe) {
+            entrada.modo = BACKUP_ARQUIVO_AUSENTE;
+            escreverEntradaArquivo(&saida, &entrada);
+            continue;
+        }
+
+        unsigned char *dados = (capturas[i].dados != NULL) ? capturas[i].dados : lerCapturado(&capturas[i]);
+        if (dados == NULL) {
+            printf("Erro ao ler '%s/%s'.\n", diretorio, arquivos_backup[i]);
+            ok = 0;
+            break;
+        }
+        const unsigned char *guardar = dados;
+        entrada.modo = BACKUP_ARQUIVO_COMPLETO;
+        entrada.tamanho = capturas[i].tamanho;
+        entrada.tamanho_final = capturas[i].tamanho;
+        entrada.linhas = contarLinhasCsv(entrada.nome, dados, entrada.tamanho);
+        entrada.crc_conteudo = calcularCrc(dados, (size_t)entrada.tamanho);
+        if (base != NULL) {
+            escolherModoIncremental(&entrada, &anteriores[i], &coletadas[i], dados, &guardar, &total.alteracoes);
+        }
+
+        if (entrada.modo == BACKUP_ARQUIVO_SEM_ALTERACOES) {
+            escreverEntradaArquivo(&saida, &entrada);
+            total.inalterados++;
+        } else {
+            ok = gravarConteudo(&saida, &entrada, guardar);
+        }
+
+        total.arquivos++;
+        total.linhas += entrada.linhas;
+        total.bytes += entrada.tamanho_final;
+        if (dados != capturas[i].dados) {
+            free(dados);
+        }
+    }
+    liberarCaptura(capturas);
+    for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP; i++) {
+        free(coletadas[i].texto);
+    }
+
+    uint32_t crc = saida.crc ^ 0xFFFFFFFFu;
+    escreverBytes(&saida, BACKUP_FIM, 4);
+    escreverU32(&saida, crc);
+    total.bytes_gravados = saida.bytes;
+
+    ok = ok && !saida.erro;
+    if (!ok) {
+        fclose(saida.arquivo);
+        descartarTemporarios(&destino, 1);
+        printf("Erro ao gravar o backup '%s'.\n", destino);
+        return 0;
+    }
+    if (!concluirEscritaAtomica(saida.arquivo, destino)) {
+        printf("Erro ao publicar o backup '%s'.\n", destino);
+        return 0;
+    }
+
+    total.tipo = (int)cabecalho.tipo;
+    total.identificador = cabecalho.identificador;
+    total.base = cabecalho.base;
+    total.segundos = agoraSegundos() - inicio;
+    if (resumo != NULL) {
+        *resumo = total;
+    }
+    return 1;
+}
+
+// ========== RESTAURAÇÃO ==========
+
+static void limparRestaurado(ArquivoRestaurado *arquivo) {
+    liberarConteudoTabela(arquivo->conteudo);
+    free(arquivo->dados);
+    for (int i = 0; i < arquivo->total_guardados; i++) {
+        free(arquivo->guardados[i]);
+    }
+    free(arquivo->guardados);
+    memset(arquivo, 0, sizeof(*arquivo));
+}
+
+// Aplica as operações guardadas no conteúdo do arquivo (fica com "dados")
+static int aplicarOperacoesRestauradas(ArquivoRestaurado *arquivo, const char *nome, unsigned char *dados,
+                                       size_t tamanho) {
+    const char *p = (const char *)dados;
+    const char *fim = p + tamanho;
+
+    if (arquivo->total_guardados == arquivo->capacidade_guardados) {
+        int capacidade = (arquivo->capacidade_guardados > 0) ? arquivo->capacidade_guardados * 2 : 8;
+        unsigned char **maiores = realloc(arquivo->guardados, sizeof(unsigned char *) * (size_t)capacidade);
+        if (maiores == NULL) {
+            free(dados);
+            return 0;
+        }
+        arquivo->guardados = maiores;
+        arquivo->capacidade_guardados = capacidade;
+    }
+    arquivo->guardados[arquivo->total_guardados++] = dados;
+
+    if (arquivo->conteudo == NULL) {
+        arquivo->conteudo = criarConteudoTabela(nome, (const char *)arquivo->dados, arquivo->tamanho);
+        if (arquivo->conteudo == NULL) {
+            return 0;
+        }
+    }
+
+    while (p < fim) {
+        const char *quebra = memchr(p, '\n', (size_t)(fim - p));
+        Alteracao alteracao;
+        if (quebra == NULL || !interpretarAlteracao(p, (size_t)(quebra - p), &alteracao) ||
+            strcmp(alteracao.tabela, nome) != 0 || !aplicarAlteracao(arquivo->conteudo, &alteracao)) {
+            printf("Erro: operação de '%s' não se encaixa no backup anterior.\n", nome);
+            return 0;
+        }
+        p = quebra + 1;
+    }
+    return 1;
+}
+
+// Leva o arquivo ao estado de uma entrada do backup (fica com "dados")
+static int aplicarEntradaRestaurada(ArquivoRestaurado *arquivo, const EntradaArquivoBackup *entrada,
+                                    unsigned char *dados) {
+    int ok = 1;
+
+    switch (entrada->modo) {
+        case BACKUP_ARQUIVO_AUSENTE:
+            limparRestaurado(arquivo);
+            free(dados);
+            return 1;
+
+        case BACKUP_ARQUIVO_COMPLETO:
+            limparRestaurado(arquivo);
+            arquivo->existe = 1;
+            arquivo->dados = dados;
+            arquivo->tamanho = (size_t)entrada->tamanho;
+            arquivo->conferido = 1;
+            break;
+
+        case BACKUP_ARQUIVO_SEM_ALTERACOES:
+            free(dados);
+            ok = arquivo->existe && arquivo->crc == entrada->crc_conteudo &&
+                 arquivo->tamanho_final == entrada->tamanho_final;
+            break;
+
+        case BACKUP_ARQUIVO_ACRESCIMO: {
+            size_t tamanho = arquivo->tamanho + (size_t)entrada->tamanho;
+            unsigned char *maior = (arquivo->existe && arquivo->conteudo == NULL &&
+                                    (long long)tamanho == entrada->tamanho_final)
+                                       ? realloc(arquivo->dados, tamanho + 1) : NULL;
+            ok = maior != NULL;
+            if (ok) {
+                memcpy(maior + arquivo->tamanho, dados, (size_t)entrada->tamanho);
+                arquivo->dados = maior;
+                arquivo->tamanho = tamanho;
+                arquivo->conferido = 0;
+            }
+            free(dados);
+            break;
+        }
+
+        case BACKUP_ARQUIVO_ALTERACOES:
+            if (!arquivo->existe) {
+                free(dados);
+                ok = 0;
+            } else {
+                ok = aplicarOperacoesRestauradas(arquivo, entrada->nome, dados, (size_t)entrada->tamanho);
+                arquivo->conferido = 0;
+            }
+            break;
+
+        default:
+            free(dados);
+            ok = 0;
+    }
+
+    if (!ok) {
+        printf("Erro: '%s' não continua o backup anterior.\n", entrada->nome);
+        return 0;
+    }
+    arquivo->crc = entrada->crc_conteudo;
+    arquivo->linhas = entrada->linhas;
+    arquivo->tamanho_final = entrada->tamanho_final;
+    return 1;
+}
+
+// Grava os arquivos reconstruídos, conferindo o conteúdo final de cada um
+static int gravarRestaurados(ArquivoRestaurado *restaurados, const char *diretorio_destino, ResumoBackup *total) {
+    char caminho[MAX_PATH * 2];
+
+    for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP; i++) {
+        ArquivoRestaurado *arquivo = &restaurados[i];
+        unsigned char *serializado = NULL;
+        const unsigned char *dados = arquivo->dados;
+        size_t tamanho = arquivo->tamanho;
+
+        if (!arquivo->existe) {
+            continue;
+        }
+        if (arquivo->conteudo != NULL) {
+            serializado = (unsigned char *)serializarConteudoTabela(arquivo->conteudo, &tamanho);
+            dados = serializado;
+            if (dados == NULL) {
+                printf("Erro: memória insuficiente para restaurar '%s'.\n", arquivos_backup[i]);
+                return 0;
+            }
+        }
+        if ((long long)tamanho != arquivo->tamanho_final ||
+            (!arquivo->conferido && calcularCrc(dados != NULL ? dados : (const unsigned char *)"", tamanho) != arquivo->crc)) {
+            printf("Erro: '%s' restaurado não confere com o backup (CRC).\n", arquivos_backup[i]);
+            free(serializado);
+            return 0;
+        }
+
+        caminhoNoDiretorio(caminho, sizeof(caminho), diretorio_destino, arquivos_backup[i]);
+        FILE *saida = fopen(caminho, "wb");
+        int ok = saida != NULL && fwrite(dados, 1, tamanho, saida) == tamanho;
+        if (saida != NULL) {
+            ok = (fclose(saida) == 0) && ok;
+        }
+        free(serializado);
+        if (!ok) {
+            printf("Erro ao gravar '%s'.\n", caminho);
+            return 0;
+        }
+        total->arquivos++;
+        total->linhas += arquivo->linhas;
+        total->bytes += (long long)tamanho;
+    }
+    return 1;
+}
+
+// Lê, confere e (com "restaurados") aplica cada arquivo de um backup
+static int percorrerBackup(const char *arquivo, ArquivoRestaurado *restaurados, ResumoBackup *resumo,
+                           CabecalhoBackup *cabecalho) {
+    EntradaBackup entrada;
+    ResumoBackup total;
+    char magico[4];
+    double inicio = agoraSegundos();
+    int ok = 1;
+
+    memset(&total, 0, sizeof(total));
+    memset(&entrada, 0, sizeof(entrada));
+    entrada.crc = 0xFFFFFFFFu;
+    entrada.arquivo = fopen(arquivo, "rb");
+    if (entrada.arquivo == NULL) {
+        printf("Erro: não foi possível abrir '%s'.\n", arquivo);
+        return 0;
+    }
+
+    if (!lerCabecalho(&entrada, cabecalho)) {
+        printf("Erro: '%s' não é um backup reconhecido.\n", arquivo);
+        fclose(entrada.arquivo);
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < cabecalho->arquivos && ok; i++) {
+        EntradaArquivoBackup dados_entrada;
+        if (!lerEntradaArquivo(&entrada, cabecalho->versao, &dados_entrada) ||
+            indiceArquivoBackup(dados_entrada.nome) < 0) {
+            ok = 0;
+            break;
+        }
+        if (dados_entrada.modo == BACKUP_ARQUIVO_AUSENTE || dados_entrada.modo == BACKUP_ARQUIVO_SEM_ALTERACOES) {
+            ok = dados_entrada.gravado == 0 &&
+                 (dados_entrada.modo == BACKUP_ARQUIVO_AUSENTE || cabecalho->tipo == BACKUP_TIPO_INCREMENTAL);
+            if (ok && restaurados != NULL) {
+                ok = aplicarEntradaRestaurada(&restaurados[indiceArquivoBackup(dados_entrada.nome)],
+                                              &dados_entrada, NULL);
+            }
+            total.arquivos += ok && dados_entrada.modo == BACKUP_ARQUIVO_SEM_ALTERACOES;
+            total.inalterados += ok && dados_entrada.modo == BACKUP_ARQUIVO_SEM_ALTERACOES;
+            continue;
+        }
+
+        unsigned char *gravado = malloc((size_t)dados_entrada.gravado + 1);
+        unsigned char *dados = (dados_entrada.compressao == COMPRESSAO_LZ)
+                                   ? malloc((size_t)dados_entrada.tamanho + 1) : gravado;
+        ok = gravado != NULL && dados != NULL && dados_entrada.modo <= BACKUP_ARQUIVO_ACRESCIMO &&
+             (dados_entrada.modo == BACKUP_ARQUIVO_COMPLETO || cabecalho->tipo == BACKUP_TIPO_INCREMENTAL) &&
+             lerBytes(&entrada, gravado, (size_t)dados_entrada.gravado);
+        if (ok && dados_entrada.compressao == COMPRESSAO_LZ) {
+            ok = descomprimirBloco(gravado, (size_t)dados_entrada.gravado, dados, (size_t)dados_entrada.tamanho);
+        } else if (ok) {
+            ok = dados_entrada.compressao == COMPRESSAO_NENHUMA && dados_entrada.gravado == dados_entrada.tamanho;
+        }
+        // O conteúdo do completo tem CRC próprio; o resto é conferido na restauração
+        if (ok && dados_entrada.modo == BACKUP_ARQUIVO_COMPLETO &&
+            calcularCrc(dados, (size_t)dados_entrada.tamanho) != dados_entrada.crc_conteudo) {
+            printf("Erro: CRC de '%s' não confere.\n", dados_entrada.nome);
+            ok = 0;
+        }
+        if (dados != gravado) {
+            free(gravado);
+        }
+
+        if (ok) {
+            total.arquivos++;
+            total.linhas += dados_entrada.linhas;
+            total.bytes += dados_entrada.tamanho_final;
+            if (restaurados != NULL) {
+                ok = aplicarEntradaRestaurada(&restaurados[indiceArquivoBackup(dados_entrada.nome)],
+                                              &dados_entrada, dados);
+                dados = NULL;
+            }
+        }
+        free(dados);
+    }
+
+    // O CRC final cobre tudo o que veio antes dele
+    uint32_t calculado = entrada.crc ^ 0xFFFFFFFFu;
+    if (ok) {
+        lerBytes(&entrada, magico, sizeof(magico));
+        uint32_t crc = lerU32(&entrada);
+        ok = !entrada.erro && memcmp(magico, BACKUP_FIM, 4) == 0 && crc == calculado;
+        if (ok) {
+            total.bytes_gravados = ftell(entrada.arquivo);
+            ok = fgetc(entrada.arquivo) == EOF;
+        }
+    }
+    fclose(entrada.arquivo);
+
+    if (!ok) {
+        printf("Erro: backup '%s' corrompido ou incompleto.\n", arquivo);
+        return 0;
+    }
+    total.tipo = (int)cabecalho->tipo;
+    total.identificador = cabecalho->identificador;
+    total.base = cabecalho->base;
+    total.sequencia = cabecalho->sequencia;
+    total.segundos = agoraSegundos() - inicio;
+    if (resumo != NULL) {
+        *resumo = total;
+    }
+    return 1;
+}
+
+// ========== IMPLEMENTAÇÃO DAS FUNÇÕES PÚBLICAS ==========
+
+int criarBackup(const char *diretorio, const char *destino, ResumoBackup *resumo) {
+    return gravarBackup(diretorio, NULL, destino, resumo);
+}
+
+int criarBackupIncremental(const char *diretorio, const char *base, const char *destino, ResumoBackup *resumo) {
+    return gravarBackup(diretorio, base, destino, resumo);
+}
+
+int lerInformacoesBackup(const char *arquivo, ResumoBackup *resumo) {
+    EntradaArquivoBackup entradas[TOTAL_ARQUIVOS_BACKUP];
+    CabecalhoBackup cabecalho;
+
+    if (!lerEntradasBackup(arquivo, &cabecalho, entradas)) {
+        return 0;
+    }
+    memset(resumo, 0, sizeof(*resumo));
+    resumo->tipo = (int)cabecalho.tipo;
+    resumo->identificador = cabecalho.identificador;
+    resumo->base = cabecalho.base;
+    resumo->sequencia = cabecalho.sequencia;
+    for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP; i++) {
+        if (entradas[i].nome[0] != '\0' && entradas[i].modo != BACKUP_ARQUIVO_AUSENTE) {
+            resumo->arquivos++;
+            resumo->linhas += entradas[i].linhas;
+            resumo->bytes += entradas[i].tamanho_final;
+        }
+    }
+    return 1;
+}
+
+int listarArquivosBackup(const char *arquivo, ArquivoBackup *arquivos) {
+    EntradaArquivoBackup entradas[TOTAL_ARQUIVOS_BACKUP];
+    CabecalhoBackup cabecalho;
+    int total = 0;
+
+    if (!lerEntradasBackup(arquivo, &cabecalho, entradas)) {
+        return -1;
+    }
+    for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP; i++) {
+        if (entradas[i].nome[0] != '\0') {
+            memcpy(arquivos[total].nome, entradas[i].nome, MAX_NOME_ARQUIVO_BACKUP);
+            arquivos[total].modo = (int)entradas[i].modo;
+            arquivos[total].geracao = entradas[i].geracao;
+            arquivos[total].linhas = entradas[i].linhas;
+            arquivos[total].tamanho = entradas[i].tamanho_final;
+            total++;
+        }
+    }
+    return total;
+}
+
+int verificarBackup(const char *arquivo, ResumoBackup *resumo) {
+    CabecalhoBackup cabecalho;
+    return percorrerBackup(arquivo, NULL, resumo, &cabecalho);
+}
+
+int restaurarBackup(const char *arquivo, const char *diretorio_destino, ResumoBackup *resumo) {
+    return restaurarCadeiaBackup(&arquivo, 1, diretorio_destino, resumo);
+}
+
+int restaurarCadeiaBackup(const char *const *arquivos, int total, const char *diretorio_destino,
+                          ResumoBackup *resumo) {
+    ArquivoRestaurado restaurados[TOTAL_ARQUIVOS_BACKUP];
+    CabecalhoBackup cabecalho;
+    ResumoBackup elo;
+    ResumoBackup soma;
+    char caminho[MAX_PATH * 2];
+    struct stat info;
+    double inicio = agoraSegundos();
+    long long anterior = 0;
+    int ok = 1;
+
+    if (total <= 0 || total > MAX_CADEIA_BACKUP) {
+        printf("Erro: informe de 1 a %d backups.\n", MAX_CADEIA_BACKUP);
+        return 0;
+    }
+    if (criarDiretorio(diretorio_destino) != 0 && errno != EEXIST) {
+        printf("Erro: não foi possível criar o diretório '%s'.\n", diretorio_destino);
+        return 0;
+    }
+    for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP; i++) {
+        caminhoNoDiretorio(caminho, sizeof(caminho), diretorio_destino, arquivos_backup[i]);
+        if (stat(caminho, &info) == 0) {
+            printf("Erro: '%s' já existe; a restauração exige um diretório sem tabelas.\n", caminho);
+            return 0;
+        }
+    }
+
+    // Cada elo é conferido e aplicado em memória; só a cadeia inteira é gravada
+    memset(restaurados, 0, sizeof(restaurados));
+    memset(&soma, 0, sizeof(soma));
+    for (int i = 0; i < total && ok; i++) {
+        ok = percorrerBackup(arquivos[i], restaurados, &elo, &cabecalho);
+        if (ok && (i == 0 ? cabecalho.tipo != BACKUP_TIPO_COMPLETO
+                          : cabecalho.tipo != BACKUP_TIPO_INCREMENTAL || cabecalho.base != anterior)) {
+            printf("Erro: '%s' não é o próximo backup da cadeia.\n", arquivos[i]);
+            ok = 0;
+        }
+        anterior = cabecalho.identificador;
+        soma.bytes_gravados += elo.bytes_gravados;
+        soma.tipo = elo.tipo;
+        soma.identificador = elo.identificador;
+        soma.base = elo.base;
+        soma.sequencia = elo.sequencia;
+    }
+
+    ok = ok && gravarRestaurados(restaurados, diretorio_destino, &soma);
+    for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP; i++) {
+        limparRestaurado(&restaurados[i]);
+    }
+    if (!ok) {
+        // Nada pela metade: o que já foi gravado sai
+        for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP; i++) {
+            caminhoNoDiretorio(caminho, sizeof(caminho), diretorio_destino, arquivos_backup[i]);
+            remove(caminho);
+        }
+        return 0;
+    }
+
+    soma.segundos = agoraSegundos() - inicio;
+    if (resumo != NULL) {
+        *resumo = soma;
+    }
+    return 1;
+}
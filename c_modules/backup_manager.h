@@ -0,0 +1,124 @@
+#ifndef BACKUP_MANAGER_H
+#define BACKUP_MANAGER_H
+
+// ========== BACKUP CONSISTENTE DO DIRETÓRIO DE DADOS ==========
+//
+// Um backup é um arquivo só com todas as tabelas do diretório (os CSVs e
+// frequencia.dat) no mesmo instante, comprimidas e com CRC-32.
+//
+// Captura sem parar os escritores (cp de data/*.csv pode pegar, por exemplo,
+// a matrícula já gravada e a turma ainda não):
+// 1. trava exclusiva "<dir>/journal.log.lock": nenhuma transação entre
+//    tabelas está no meio da publicação (journal_manager.h);
+// 2. trava compartilhada de cada arquivo, sempre na mesma ordem: nenhum
+//    escritor está entre o temporário e o rename;
+// 3. cada arquivo é aberto e o tamanho anotado; as travas são soltas.
+// Os escritores esperam só pelos passos 1 a 3 (alguns microssegundos). A
+// leitura e a compressão vêm depois, pelos descritores abertos: um escritor
+// que publicar depois troca o arquivo por rename e não altera o que já foi
+// aberto, e frequencia.dat só cresce por acréscimo (lê-se até o tamanho
+// anotado). No Windows, onde o rename não substitui arquivo aberto, o
+// conteúdo é lido ainda sob as travas.
+//
+// Backup incremental: feito sobre um anterior (completo ou incremental),
+// guarda de cada arquivo só o que mudou desde ele:
+// - nada, se o conteúdo tem o mesmo CRC e tamanho;
+// - as operações do registro de alterações (alteracoes_manager.h) das
+//   gerações seguintes à do backup anterior, se o log tem todas elas;
+// - o trecho acrescentado, em frequencia.dat (só cresce até a compactação);
+// - o arquivo inteiro nos demais casos (buraco no log, CSV gravado por fora).
+// A restauração aplica a cadeia (completo + incrementais, em ordem) em
+// memória e confere o CRC do conteúdo final de cada arquivo antes de gravar.
+//
+// Formato (inteiros little-endian):
+//   "PIMB" versao(u32) tipo(u32) identificador(u64) base(u64) instante(u64)
+//          sequencia(u64) arquivos(u32)
+//   por arquivo: nome[32] modo(u32) compressao(u32) geracao(i64) linhas(u64)
+//                tamanho(u64) gravado(u64) crc_conteudo(u32) tamanho_final(u64)
+//                + "gravado" bytes
+//   "FIMB" crc(u32) de tudo o que vem antes
+// "base" é o identificador do backup anterior (0 no completo) e "sequencia"
+// a última do registro de alterações no instante da captura. "tamanho" é o
+// do conteúdo guardado; "crc_conteudo", "linhas" e "tamanho_final" são do
+// arquivo restaurado. A versão 1 (sem base, sequencia e tamanho_final, só
+// backups completos) continua legível.
+// A compressão é LZ77 por bloco (sequências literal + cópia com deslocamento
+// de até 64 KiB); um bloco que não diminui é guardado como está.
+
+#define BACKUP_MAGICO "PIMB"
+#define BACKUP_FIM "FIMB"
+#define BACKUP_VERSAO 2
+#define BACKUP_TIPO_COMPLETO 0
+#define BACKUP_TIPO_INCREMENTAL 1
+
+#define TOTAL_ARQUIVOS_BACKUP 8
+#define MAX_NOME_ARQUIVO_BACKUP 32
+
+// Modo de cada arquivo dentro do backup
+#define BACKUP_ARQUIVO_COMPLETO 0
+#define BACKUP_ARQUIVO_AUSENTE 1       // Não existia no diretório
+#define BACKUP_ARQUIVO_SEM_ALTERACOES 2 // Igual ao do backup anterior
+#define BACKUP_ARQUIVO_ALTERACOES 3    // Operações do registro de alterações
+#define BACKUP_ARQUIVO_ACRESCIMO 4     // Bytes acrescentados ao do backup anterior
+
+#define MAX_CADEIA_BACKUP 256          // Backups numa restauração
+
+typedef struct {
+    int tipo;                      // BACKUP_TIPO_*
+    int arquivos;                  // Arquivos presentes no backup
+    int inalterados;               // Incremental: arquivos iguais aos do anterior
+    long long linhas;              // Linhas de dados dos CSVs
+    long long bytes;               // Tamanho original somado
+    long long bytes_gravados;      // Tamanho do arquivo de backup
+    long long alteracoes;          // Incremental: operações guardadas
+    long long identificador;
+    long long base;                // Identificador do backup anterior (0 = completo)
+    long long sequencia;           // Registro de alterações na captura
+    double segundos_travado;       // Tempo com as travas dos arquivos (captura)
+    double segundos;
+} ResumoBackup;
+
+// Função para gravar o backup consistente de "diretorio" em "destino"
+// Exige que a thread não esteja em transação (ela seguraria as travas)
+// Retorna: 1 se sucesso, 0 se erro (o destino anterior é preservado)
+int criarBackup(const char *diretorio, const char *destino, ResumoBackup *resumo);
+
+// Função para gravar em "destino" só o que mudou desde o backup "base"
+// Retorna: 1 se sucesso, 0 se erro (o destino anterior é preservado)
+int criarBackupIncremental(const char *diretorio, const char *base, const char *destino, ResumoBackup *resumo);
+
+// Um arquivo dentro do backup
+typedef struct {
+    char nome[MAX_NOME_ARQUIVO_BACKUP];
+    int modo;                      // BACKUP_ARQUIVO_*
+    long long geracao;             // Contador do arquivo de trava na captura
+    long long linhas;
+    long long tamanho;             // Do arquivo restaurado
+} ArquivoBackup;
+
+// Função para ler o cabeçalho de um backup (tipo, identificador, base e
+// sequência), sem conferir o conteúdo
+// Retorna: 1 se é um backup reconhecido, 0 se não
+int lerInformacoesBackup(const char *arquivo, ResumoBackup *resumo);
+
+// Função para listar os arquivos de um backup (TOTAL_ARQUIVOS_BACKUP no máximo)
+// Retorna: arquivos listados, -1 se não é um backup reconhecido
+int listarArquivosBackup(const char *arquivo, ArquivoBackup *arquivos);
+
+// Função para conferir estrutura e CRCs de um backup sem gravar nada
+// Retorna: 1 se íntegro, 0 se corrompido ou ilegível
+int verificarBackup(const char *arquivo, ResumoBackup *resumo);
+
+// Função para restaurar um backup num diretório (criado se preciso)
+// Não sobrescreve arquivos existentes: restaure em outro diretório e troque
+// com a aplicação parada
+// Retorna: 1 se sucesso, 0 se erro
+int restaurarBackup(const char *arquivo, const char *diretorio_destino, ResumoBackup *resumo);
+
+// Função para restaurar uma cadeia: um completo seguido dos incrementais
+// feitos sobre ele, em ordem (o último define o instante restaurado)
+// Retorna: 1 se sucesso, 0 se erro (nada é gravado se algum elo falhar)
+int restaurarCadeiaBackup(const char *const *arquivos, int total, const char *diretorio_destino,
+                          ResumoBackup *resumo);
+
+#endif
@@ -0,0 +1,1773 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+
+#include "structs.h"
+#include "aluno_manager.h"
+#include "turma_manager.h"
+#include "aula_manager.h"
+#include "file_manager.h"
+#include "exportacao_manager.h"
+#include "persistencia_manager.h"
+#include "auditoria_manager.h"
+#include "relatorio_manager.h"
+#include "agregado_manager.h"
+#include "frequencia_manager.h"
+#include "nota_manager.h"
+#include "tabela_manager.h"
+#include "verificacao_manager.h"
+#include "backup_manager.h"
+#include "alteracoes_manager.h"
+#include "replicacao_manager.h"
+#include "assinatura_manager.h"
+
+// ========== UTILITÁRIOS DE MEDIÇÃO ==========
+
+// Tempo monotônico em segundos
+static double agoraSegundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Quantidade de núcleos disponíveis (mínimo 1)
+static int numeroDeNucleos(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n < 1) ? 1 : (int)n;
+}
+
+// Desvia stdout para /dev/null (os módulos imprimem a cada operação)
+// Retorna: descritor a passar para restaurarSaida()
+static int silenciarSaida(void) {
+    fflush(stdout);
+    int salvo = dup(fileno(stdout));
+    FILE *nulo = fopen("/dev/null", "w");
+    if (nulo != NULL) {
+        dup2(fileno(nulo), fileno(stdout));
+        fclose(nulo);
+    }
+    return salvo;
+}
+
+static void restaurarSaida(int salvo) {
+    fflush(stdout);
+    dup2(salvo, fileno(stdout));
+    close(salvo);
+}
+
+// ========== ESCALABILIDADE DE LEITURA (1..N NÚCLEOS) ==========
+
+#define DURACAO_LEITURA 0.5
+
+typedef struct {
+    const int *ras;
+    int total_ras;
+    double fim;
+    long operacoes;
+} ArgLeitura;
+
+static void *leitorBench(void *arg) {
+    ArgLeitura *dados = (ArgLeitura *)arg;
+    Aluno copia;
+    long ops = 0;
+
+    while (agoraSegundos() < dados->fim) {
+        // Lotes de 64 consultas entre leituras do relógio
+        for (int i = 0; i < 64; i++) {
+            obterAlunoPorRA(dados->ras[(ops + i) % dados->total_ras], &copia);
+        }
+        ops += 64;
+    }
+
+    dados->operacoes = ops;
+    return NULL;
+}
+
+static void benchEscalabilidadeLeitura(void) {
+    static Aluno alunos[MAX_ALUNOS];
+    static int ras[MAX_ALUNOS];
+    int total = listarAlunos(alunos, MAX_ALUNOS);
+    int nucleos = numeroDeNucleos();
+    double base = 0.0;
+
+    if (total == 0) {
+        printf("Nenhum aluno em %s; cadastre dados antes do benchmark.\n", ARQUIVO_ALUNOS);
+        return;
+    }
+
+    for (int i = 0; i < total; i++) {
+        ras[i] = alunos[i].ra;
+    }
+
+    printf("\n=== Escalabilidade de leitura (obterAlunoPorRA, %d alunos) ===\n", total);
+    printf("%-8s %-16s %-10s\n", "Threads", "Consultas/s", "Speedup");
+
+    for (int t = 1; t <= nucleos * 2; t = (t < nucleos) ? t + 1 : t * 2) {
+        pthread_t *threads = malloc(sizeof(pthread_t) * t);
+        ArgLeitura *args = malloc(sizeof(ArgLeitura) * t);
+        double inicio = agoraSegundos();
+        long total_ops = 0;
+
+        for (int i = 0; i < t; i++) {
+            args[i].ras = ras;
+            args[i].total_ras = total;
+            args[i].fim = inicio + DURACAO_LEITURA;
+            args[i].operacoes = 0;
+            pthread_create(&threads[i], NULL, leitorBench, &args[i]);
+        }
+        for (int i = 0; i < t; i++) {
+            pthread_join(threads[i], NULL);
+            total_ops += args[i].operacoes;
+        }
+
+        double vazao = (double)total_ops / (agoraSegundos() - inicio);
+        if (t == 1) {
+            base = vazao;
+        }
+        printf("%-8d %-16.0f %-10.2f\n", t, vazao, base > 0 ? vazao / base : 0.0);
+
+        free(threads);
+        free(args);
+    }
+}
+
+// ========== SNAPSHOTS: LEITURA COM ESCRITOR ATIVO ==========
+
+typedef struct {
+    int id_turma;
+    double fim;
+    long operacoes;
+} ArgSnapshot;
+
+typedef struct {
+    Aula original;
+    double fim;
+    int escritas;
+} ArgEscritorAulas;
+
+static void *leitorSnapshot(void *arg) {
+    ArgSnapshot *dados = (ArgSnapshot *)arg;
+    long ops = 0;
+
+    while (agoraSegundos() < dados->fim) {
+        for (int i = 0; i < 16; i++) {
+            contarAulasDaTurma(dados->id_turma);
+        }
+        ops += 16;
+    }
+
+    dados->operacoes = ops;
+    return NULL;
+}
+
+// Alterna o conteúdo de uma aula, forçando publicações de novas versões
+static void *escritorAulas(void *arg) {
+    ArgEscritorAulas *dados = (ArgEscritorAulas *)arg;
+    Aula alterada = dados->original;
+    size_t tam = strlen(alterada.conteudo);
+    struct timespec pausa = {0, 5 * 1000 * 1000};
+
+    while (agoraSegundos() < dados->fim) {
+        alterada.conteudo[tam] = (dados->escritas % 2 == 0) ? '.' : '\0';
+        alterada.conteudo[tam + 1] = '\0';
+        atualizarAula(&alterada);
+        dados->escritas++;
+        nanosleep(&pausa, NULL);
+    }
+
+    atualizarAula(&dados->original);
+    return NULL;
+}
+
+static void benchSnapshotAulas(void) {
+    Aula primeira;
+    int nucleos = numeroDeNucleos();
+    double base = 0.0;
+
+    if (listarTodasAulas(&primeira, 1) == 0) {
+        printf("Nenhuma aula em %s; cadastre dados antes do benchmark.\n", ARQUIVO_AULAS);
+        return;
+    }
+    if (strlen(primeira.conteudo) + 2 > sizeof(primeira.conteudo)) {
+        printf("Conteudo da primeira aula no limite; benchmark ignorado.\n");
+        return;
+    }
+
+    printf("\n=== Leitura por snapshot com escritor ativo (contarAulasDaTurma) ===\n");
+    printf("%-8s %-16s %-10s %-10s\n", "Threads", "Consultas/s", "Speedup", "Escritas");
+
+    for (int t = 1; t <= nucleos * 2; t = (t < nucleos) ? t + 1 : t * 2) {
+        pthread_t *threads = malloc(sizeof(pthread_t) * t);
+        ArgSnapshot *args = malloc(sizeof(ArgSnapshot) * t);
+        pthread_t escritor;
+        ArgEscritorAulas arg_escritor;
+        double inicio = agoraSegundos();
+        long total_ops = 0;
+
+        arg_escritor.original = primeira;
+        arg_escritor.fim = inicio + DURACAO_LEITURA;
+        arg_escritor.escritas = 0;
+        pthread_create(&escritor, NULL, escritorAulas, &arg_escritor);
+
+        for (int i = 0; i < t; i++) {
+            args[i].id_turma = primeira.id_turma;
+            args[i].fim = inicio + DURACAO_LEITURA;
+            args[i].operacoes = 0;
+            pthread_create(&threads[i], NULL, leitorSnapshot, &args[i]);
+        }
+        for (int i = 0; i < t; i++) {
+            pthread_join(threads[i], NULL);
+            total_ops += args[i].operacoes;
+        }
+        pthread_join(escritor, NULL);
+
+        double vazao = (double)total_ops / (agoraSegundos() - inicio);
+        if (t == 1) {
+            base = vazao;
+        }
+        printf("%-8d %-16.0f %-10.2f %-10d\n", t, vazao,
+               base > 0 ? vazao / base : 0.0, arg_escritor.escritas);
+
+        free(threads);
+        free(args);
+    }
+}
+
+// ========== EXPORTAÇÃO: ANEXAR SEGMENTO x RELER CSV ==========
+
+#define REPETICOES_EXPORTACAO 200
+
+static void benchExportacao(void) {
+    static Aula aulas[MAX_AULAS];
+    LeitorExportacao leitor;
+    int total_csv = 0, total_shm = 0;
+
+    if (!habilitarExportacao() || exportarTodasTabelas() == 0) {
+        printf("Exportacao em memoria compartilhada indisponivel.\n");
+        return;
+    }
+
+    double inicio = agoraSegundos();
+    for (int i = 0; i < REPETICOES_EXPORTACAO; i++) {
+        total_csv = carregarDados(ARQUIVO_AULAS, aulas, MAX_AULAS, TIPO_AULA);
+    }
+    double tempo_csv = (agoraSegundos() - inicio) / REPETICOES_EXPORTACAO;
+
+    inicio = agoraSegundos();
+    for (int i = 0; i < REPETICOES_EXPORTACAO; i++) {
+        if (anexarExportacao(&leitor, EXPORTACAO_AULAS)) {
+            total_shm = lerTabelaExportada(&leitor, aulas, MAX_AULAS, NULL);
+            desanexarExportacao(&leitor);
+        }
+    }
+    double tempo_shm = (agoraSegundos() - inicio) / REPETICOES_EXPORTACAO;
+
+    printf("\n=== Carga de aulas: CSV x memoria compartilhada ===\n");
+    printf("%-28s %-10s %-12s\n", "Origem", "Registros", "us/carga");
+    printf("%-28s %-10d %-12.1f\n", "carregarDados (CSV)", total_csv, tempo_csv * 1e6);
+    printf("%-28s %-10d %-12.1f\n", "anexar + lerTabelaExportada", total_shm, tempo_shm * 1e6);
+
+    removerExportacoes();
+}
+
+// ========== PERSISTÊNCIA: STDIO SÍNCRONO x ASSÍNCRONO ==========
+
+#define AULAS_PERSISTENCIA 500
+#define COMMITS_PERSISTENCIA 64
+#define ARQUIVOS_PERSISTENCIA 8
+
+static void caminhoBenchPersistencia(char *destino, size_t tamanho, int indice) {
+    snprintf(destino, tamanho, "data/bench_persistencia_%d.csv", indice % ARQUIVOS_PERSISTENCIA);
+}
+
+// Gravação síncrona com stdio (com ou sem fsync + rename, como um commit durável)
+static double commitsSincronos(const char *conteudo, size_t tamanho, int duravel) {
+    char arquivo[MAX_PATH], temporario[MAX_PATH + 8];
+    double inicio = agoraSegundos();
+
+    for (int i = 0; i < COMMITS_PERSISTENCIA; i++) {
+        caminhoBenchPersistencia(arquivo, sizeof(arquivo), i);
+        snprintf(temporario, sizeof(temporario), "%s.tmp", arquivo);
+
+        FILE *f = fopen(duravel ? temporario : arquivo, "w");
+        if (f == NULL) {
+            return -1.0;
+        }
+        fwrite(conteudo, 1, tamanho, f);
+        fflush(f);
+        if (duravel) {
+            fsync(fileno(f));
+        }
+        fclose(f);
+        if (duravel) {
+            rename(temporario, arquivo);
+        }
+    }
+    return agoraSegundos() - inicio;
+}
+
+// Submete todos os commits e espera; "latencia" recebe o tempo médio de submissão
+static double commitsAssincronos(const char *conteudo, size_t tamanho, double *latencia) {
+    char arquivo[MAX_PATH];
+    FilaConclusoes fila;
+    ConclusaoGravacao conclusao;
+    double submissao = 0.0;
+    int falhas = 0;
+
+    inicializarFilaConclusoes(&fila);
+    double inicio = agoraSegundos();
+    for (int i = 0; i < COMMITS_PERSISTENCIA; i++) {
+        char *copia = malloc(tamanho);
+        if (copia == NULL) {
+            break;
+        }
+        memcpy(copia, conteudo, tamanho);
+        caminhoBenchPersistencia(arquivo, sizeof(arquivo), i);
+
+        double antes = agoraSegundos();
+        if (submeterGravacao(arquivo, copia, tamanho, &fila, NULL) == 0) {
+            falhas++;
+        }
+        submissao += agoraSegundos() - antes;
+    }
+    for (int i = 0; i < COMMITS_PERSISTENCIA - falhas; i++) {
+        aguardarConclusao(&fila, &conclusao);
+        if (conclusao.resultado != 0) {
+            falhas++;
+        }
+    }
+    double total = agoraSegundos() - inicio;
+    destruirFilaConclusoes(&fila);
+
+    *latencia = submissao / COMMITS_PERSISTENCIA;
+    return falhas ? -1.0 : total;
+}
+
+static void imprimirLinhaPersistencia(const char *nome, double total, double latencia) {
+    if (total < 0) {
+        printf("%-28s %s\n", nome, "falhou");
+        return;
+    }
+    printf("%-28s %-14.1f %-14.1f %-10.0f\n", nome, latencia * 1e6,
+           total / COMMITS_PERSISTENCIA * 1e6, COMMITS_PERSISTENCIA / total);
+}
+
+static void benchPersistencia(void) {
+    static Aula aulas[AULAS_PERSISTENCIA];
+    char arquivo[MAX_PATH];
+    size_t tamanho = 0;
+    double latencia;
+
+    for (int i = 0; i < AULAS_PERSISTENCIA; i++) {
+        aulas[i].id = i + 1;
+        aulas[i].id_turma = i % 20 + 1;
+        snprintf(aulas[i].data, sizeof(aulas[i].data), "%02d/%02d/2025", i % 28 + 1, i % 12 + 1);
+        snprintf(aulas[i].conteudo, sizeof(aulas[i].conteudo), "Conteudo ministrado na aula %d", i + 1);
+    }
+    char *conteudo = serializarDados(aulas, AULAS_PERSISTENCIA, TIPO_AULA, &tamanho);
+    if (conteudo == NULL) {
+        printf("Falha ao serializar as aulas.\n");
+        return;
+    }
+
+    printf("\n=== Persistencia: %d commits de %zu bytes em %d arquivos ===\n",
+           COMMITS_PERSISTENCIA, tamanho, ARQUIVOS_PERSISTENCIA);
+    printf("%-28s %-14s %-14s %-10s\n", "Modo", "us/submissao", "us/commit", "commits/s");
+
+    double total = commitsSincronos(conteudo, tamanho, 0);
+    imprimirLinhaPersistencia("stdio (sem fsync)", total, total / COMMITS_PERSISTENCIA);
+    total = commitsSincronos(conteudo, tamanho, 1);
+    imprimirLinhaPersistencia("stdio + fsync + rename", total, total / COMMITS_PERSISTENCIA);
+
+    if (iniciarPersistencia(PERSISTENCIA_URING) == PERSISTENCIA_URING) {
+        total = commitsAssincronos(conteudo, tamanho, &latencia);
+        imprimirLinhaPersistencia("io_uring (cadeia ligada)", total, latencia);
+    } else {
+        printf("%-28s %s\n", "io_uring (cadeia ligada)", "indisponivel");
+    }
+    encerrarPersistencia();
+
+    if (iniciarPersistencia(PERSISTENCIA_THREADS) == PERSISTENCIA_THREADS) {
+        total = commitsAssincronos(conteudo, tamanho, &latencia);
+        imprimirLinhaPersistencia("pool de threads", total, latencia);
+    }
+    encerrarPersistencia();
+
+    for (int i = 0; i < ARQUIVOS_PERSISTENCIA; i++) {
+        caminhoBenchPersistencia(arquivo, sizeof(arquivo), i);
+        remove(arquivo);
+    }
+    free(conteudo);
+}
+
+// ========== AUDITORIA: fopen POR LINHA x ANEL COM ESCRITORA ==========
+
+#define LINHAS_AUDITORIA 20000
+#define ARQUIVO_BENCH_AUDITORIA "data/bench_auditoria.txt"
+#define DIRETORIO_BENCH_AUDITORIA "data/bench_auditoria"
+
+typedef struct {
+    int indice;
+    int por_linha;             // 1 = abordagem antiga (abre e fecha o arquivo)
+} ArgAuditoria;
+
+// Como registrarTentativaLogin() gravava antes do anel
+static void registrarLinhaAntiga(const char *login) {
+    FILE *arquivo = fopen(ARQUIVO_BENCH_AUDITORIA, "a");
+    if (arquivo == NULL) {
+        return;
+    }
+    time_t agora = time(NULL);
+    char *timestamp = ctime(&agora);
+    timestamp[strcspn(timestamp, "\n")] = 0;
+    fprintf(arquivo, "[%s] LOGIN %s - Usuario: %s\n", timestamp, "FALHA", login);
+    fclose(arquivo);
+}
+
+static void *produtorAuditoria(void *arg) {
+    ArgAuditoria *a = (ArgAuditoria *)arg;
+    char login[32];
+
+    snprintf(login, sizeof(login), "aluno%d", a->indice);
+    for (int i = 0; i < LINHAS_AUDITORIA; i++) {
+        if (a->por_linha) {
+            registrarLinhaAntiga(login);
+        } else {
+            registrarEventoAuditoria(AUDITORIA_AUTH, login, "LOGIN", 0, NULL);
+        }
+    }
+    return NULL;
+}
+
+static double rodarProdutoresAuditoria(int threads, int por_linha) {
+    pthread_t ids[64];
+    ArgAuditoria args[64];
+
+    double inicio = agoraSegundos();
+    for (int t = 0; t < threads; t++) {
+        args[t].indice = t;
+        args[t].por_linha = por_linha;
+        pthread_create(&ids[t], NULL, produtorAuditoria, &args[t]);
+    }
+    for (int t = 0; t < threads; t++) {
+        pthread_join(ids[t], NULL);
+    }
+    if (!por_linha) {
+        descarregarAuditoria();
+    }
+    return agoraSegundos() - inicio;
+}
+
+static void benchAuditoria(void) {
+    int maximo = numeroDeNucleos() < 4 ? 4 : numeroDeNucleos();
+    EstatisticasAuditoria antes, depois;
+
+    if (maximo > 64) {
+        maximo = 64;
+    }
+    encerrarAuditoria();
+    redirecionarAuditoria(DIRETORIO_BENCH_AUDITORIA);
+    removerSegmentosLog(DIRETORIO_BENCH_AUDITORIA);
+
+    printf("\n=== Auditoria: %d linhas por thread ===\n", LINHAS_AUDITORIA);
+    printf("%-8s %-22s %-14s %-12s %-12s\n", "Threads", "Modo", "linhas/s", "gravacoes", "descartes");
+
+    for (int threads = 1; threads <= maximo; threads *= 2) {
+        double tempo = rodarProdutoresAuditoria(threads, 1);
+        long total = (long)threads * LINHAS_AUDITORIA;
+        printf("%-8d %-22s %-14.0f %-12ld %-12d\n", threads, "fopen por linha", total / tempo, total, 0);
+
+        for (int politica = AUDITORIA_DESCARTAR; politica <= AUDITORIA_ESPERAR; politica++) {
+            iniciarAuditoria(politica);
+            estatisticasAuditoria(&antes);
+            tempo = rodarProdutoresAuditoria(threads, 0);
+            estatisticasAuditoria(&depois);
+            encerrarAuditoria();
+            printf("%-8d %-22s %-14.0f %-12llu %-12llu\n", threads,
+                   politica == AUDITORIA_DESCARTAR ? "anel (descartar)" : "anel (esperar)",
+                   total / tempo, depois.gravacoes - antes.gravacoes,
+                   depois.descartadas - antes.descartadas);
+        }
+    }
+
+    remove(ARQUIVO_BENCH_AUDITORIA);
+    removerSegmentosLog(DIRETORIO_BENCH_AUDITORIA);
+    redirecionarAuditoria(LOG_AUDITORIA_DIR);
+}
+
+// ========== CONSULTA DA AUDITORIA: VARREDURA x ÍNDICES ==========
+
+#define EVENTOS_CONSULTA 400000
+#define LOGINS_CONSULTA 200
+
+typedef struct {
+    const char *login;
+    long encontrados;
+} ContagemConsulta;
+
+// Varredura completa filtrando no visitante (o que um grep no texto fazia)
+static int contarPorLoginNaVarredura(const EventoAuditoria *evento, void *contexto) {
+    ContagemConsulta *c = (ContagemConsulta *)contexto;
+    if (strcmp(evento->login, c->login) == 0) {
+        c->encontrados++;
+    }
+    return 1;
+}
+
+static int contarEvento(const EventoAuditoria *evento, void *contexto) {
+    (void)evento;
+    (*(long *)contexto)++;
+    return 1;
+}
+
+static void benchConsultaAuditoria(void) {
+    EventoAuditoria evento;
+    FiltroAuditoria filtro;
+    ContagemConsulta contagem = {"usuario7", 0};
+    long total;
+
+    encerrarAuditoria();
+    removerSegmentosLog(DIRETORIO_BENCH_AUDITORIA);
+    configurarRotacaoLog(1024L * 1024, 0);
+    abrirLogAuditoria(DIRETORIO_BENCH_AUDITORIA);
+
+    // Um evento por milissegundo a partir de um instante fixo
+    int64_t base = 1700000000000LL;
+    memset(&evento, 0, sizeof(evento));
+    evento.destino = AUDITORIA_AUTH;
+    snprintf(evento.acao, sizeof(evento.acao), "LOGIN");
+    double inicio = agoraSegundos();
+    for (int i = 0; i < EVENTOS_CONSULTA; i++) {
+        evento.instante_ms = base + i;
+        evento.sucesso = (i % 10) != 0;
+        snprintf(evento.login, sizeof(evento.login), "usuario%d", i % LOGINS_CONSULTA);
+        anexarEventoLog(&evento);
+    }
+    fecharLogAuditoria();
+    double escrita = agoraSegundos() - inicio;
+
+    printf("\n=== Consulta da auditoria: %d eventos, %d logins ===\n", EVENTOS_CONSULTA, LOGINS_CONSULTA);
+    printf("Escrita direta no log: %.0f eventos/s\n", EVENTOS_CONSULTA / escrita);
+    printf("%-34s %-12s %-12s\n", "Consulta", "eventos", "ms");
+
+    filtroAuditoriaPadrao(&filtro);
+    inicio = agoraSegundos();
+    consultarLogAuditoria(DIRETORIO_BENCH_AUDITORIA, &filtro, contarPorLoginNaVarredura, &contagem);
+    printf("%-34s %-12ld %-12.2f\n", "login por varredura completa", contagem.encontrados,
+           (agoraSegundos() - inicio) * 1000.0);
+
+    total = 0;
+    filtro.login = "usuario7";
+    inicio = agoraSegundos();
+    consultarLogAuditoria(DIRETORIO_BENCH_AUDITORIA, &filtro, contarEvento, &total);
+    printf("%-34s %-12ld %-12.2f\n", "login pelo indice", total, (agoraSegundos() - inicio) * 1000.0);
+
+    // Janela de 1 s no meio do log
+    total = 0;
+    filtroAuditoriaPadrao(&filtro);
+    filtro.inicio_ms = base + EVENTOS_CONSULTA / 2;
+    filtro.fim_ms = filtro.inicio_ms + 999;
+    inicio = agoraSegundos();
+    consultarLogAuditoria(DIRETORIO_BENCH_AUDITORIA, &filtro, contarEvento, &total);
+    printf("%-34s %-12ld %-12.2f\n", "janela de 1 s pelo indice de tempo", total,
+           (agoraSegundos() - inicio) * 1000.0);
+
+    removerSegmentosLog(DIRETORIO_BENCH_AUDITORIA);
+    configurarRotacaoLog(0, 0);
+}
+
+// ========== RELATÓRIOS: UM POR TURMA x LOTE ==========
+
+#define DIRETORIO_BENCH_RELATORIOS "data/bench_relatorios"
+#define REPETICOES_RELATORIOS 10
+
+// Relatório a relatório: cada chamada varre todas as aulas
+static double relatoriosUmPorTurma(const Turma *turmas, int total) {
+    char caminho[256];
+    double inicio = agoraSegundos();
+
+    // gerarRelatorioTurma() imprime duas linhas por turma
+    int salvo = silenciarSaida();
+    for (int i = 0; i < total; i++) {
+        snprintf(caminho, sizeof(caminho), "%s/relatorio_turma_%d.txt", DIRETORIO_BENCH_RELATORIOS,
+                 turmas[i].id);
+        gerarRelatorioTurma(turmas[i].id, caminho);
+    }
+    restaurarSaida(salvo);
+
+    return agoraSegundos() - inicio;
+}
+
+static void benchRelatorios(void) {
+    static Turma turmas[MAX_TURMAS];
+    ResultadoLoteRelatorios resultado;
+    int nucleos = numeroDeNucleos();
+
+    int total = listarTurmas(turmas, MAX_TURMAS);
+    if (total == 0) {
+        printf("Nenhuma turma em %s; cadastre dados antes do benchmark.\n", ARQUIVO_TURMAS);
+        return;
+    }
+    if (gerarRelatoriosTodasTurmas(DIRETORIO_BENCH_RELATORIOS, 1, &resultado) < 0) {
+        printf("Nao foi possivel criar %s.\n", DIRETORIO_BENCH_RELATORIOS);
+        return;
+    }
+    int aulas = 0;
+    for (int i = 0; i < resultado.total_turmas; i++) {
+        aulas += resultado.tempos[i].aulas;
+    }
+    liberarResultadoLote(&resultado);
+
+    printf("\n=== Relatorios de %d turmas (%d aulas), melhor de %d ===\n", total, aulas,
+           REPETICOES_RELATORIOS);
+    printf("%-26s %-10s %-12s %-12s %-10s\n", "Forma", "Threads", "ms total", "ms carga", "Speedup");
+
+    // Repetições intercaladas: a gravação em disco varia muito entre rodadas
+    double base = 1e9;
+    double melhor[RELATORIO_MAX_THREADS + 1], carga[RELATORIO_MAX_THREADS + 1];
+    double mais_lenta[RELATORIO_MAX_THREADS + 1];
+    for (int t = 0; t <= RELATORIO_MAX_THREADS; t++) {
+        melhor[t] = 1e9;
+    }
+    for (int r = 0; r < REPETICOES_RELATORIOS; r++) {
+        double tempo = relatoriosUmPorTurma(turmas, total);
+        base = (tempo < base) ? tempo : base;
+
+        for (int t = 1; t <= nucleos * 2 && t <= RELATORIO_MAX_THREADS; t = (t < nucleos) ? t + 1 : t * 2) {
+            gerarRelatoriosTodasTurmas(DIRETORIO_BENCH_RELATORIOS, t, &resultado);
+            if (resultado.segundos_total < melhor[t]) {
+                melhor[t] = resultado.segundos_total;
+                carga[t] = resultado.segundos_carga;
+                mais_lenta[t] = 0.0;
+                for (int i = 0; i < resultado.total_turmas; i++) {
+                    if (resultado.tempos[i].microssegundos > mais_lenta[t]) {
+                        mais_lenta[t] = resultado.tempos[i].microssegundos;
+                    }
+                }
+            }
+            liberarResultadoLote(&resultado);
+        }
+    }
+
+    printf("%-26s %-10d %-12.2f %-12s %-10.2f\n", "um por turma (varredura)", 1, base * 1e3, "-", 1.0);
+    for (int t = 1; t <= nucleos * 2 && t <= RELATORIO_MAX_THREADS; t = (t < nucleos) ? t + 1 : t * 2) {
+        printf("%-26s %-10d %-12.2f %-12.2f %-10.2f (turma mais lenta: %.0f us)\n", "lote", t,
+               melhor[t] * 1e3, carga[t] * 1e3, base / melhor[t], mais_lenta[t]);
+    }
+
+    // Atualização incremental depois de um lote completo
+    Aula primeira;
+    double sem_alteracao = 1e9;
+    for (int r = 0; r < REPETICOES_RELATORIOS; r++) {
+        atualizarRelatoriosTurmas(DIRETORIO_BENCH_RELATORIOS, 0, &resultado);
+        sem_alteracao = (resultado.segundos_total < sem_alteracao) ? resultado.segundos_total : sem_alteracao;
+        liberarResultadoLote(&resultado);
+    }
+    printf("%-26s %-10d %-12.2f %-12s %-10.2f (0 reescritos)\n", "atualizar (nada mudou)", nucleos,
+           sem_alteracao * 1e3, "-", base / sem_alteracao);
+
+    if (listarTodasAulas(&primeira, 1) == 1 && strlen(primeira.conteudo) + 2 <= sizeof(primeira.conteudo)) {
+        Aula alterada = primeira;
+        strcat(alterada.conteudo, ".");
+        atualizarAula(&alterada);
+        atualizarRelatoriosTurmas(DIRETORIO_BENCH_RELATORIOS, 0, &resultado);
+        printf("%-26s %-10d %-12.2f %-12s %-10.2f (%d reescrito)\n", "atualizar (1 aula mudou)", nucleos,
+               resultado.segundos_total * 1e3, "-", base / resultado.segundos_total, resultado.reescritos);
+        liberarResultadoLote(&resultado);
+        atualizarAula(&primeira);
+    }
+
+    for (int i = 0; i < total; i++) {
+        char caminho[256];
+        snprintf(caminho, sizeof(caminho), "%s/relatorio_turma_%d.txt", DIRETORIO_BENCH_RELATORIOS,
+                 turmas[i].id);
+        remove(caminho);
+    }
+    char versoes[256];
+    snprintf(versoes, sizeof(versoes), "%s/%s", DIRETORIO_BENCH_RELATORIOS, ARQUIVO_VERSOES_RELATORIOS);
+    remove(versoes);
+    strcat(versoes, ".lock");
+    remove(versoes);
+    remove(DIRETORIO_BENCH_RELATORIOS);
+}
+
+// ========== VISÕES AGREGADAS ==========
+
+#define REPETICOES_AGREGADOS 20
+
+// Aulas e alunos ativos de todas as turmas contando linha a linha
+static long contagemPorVarredura(const Turma *turmas, int total) {
+    static int ras[MAX_MATRICULAS];
+    long soma = 0;
+
+    Snapshot *versao = adquirirSnapshotAulas();
+    for (int t = 0; t < total; t++) {
+        for (int i = 0; i < totalRegistrosSnapshot(versao); i++) {
+            soma += ((const Aula *)registroSnapshot(versao, i))->id_turma == turmas[t].id;
+        }
+        int matriculados = listarAlunosDaTurma(turmas[t].id, ras, MAX_MATRICULAS);
+        for (int i = 0; i < matriculados; i++) {
+            Aluno aluno;
+            soma += obterAlunoPorRA(ras[i], &aluno) && aluno.ativo;
+        }
+    }
+    liberarSnapshot(versao);
+    return soma;
+}
+
+static long contagemAgregada(const Turma *turmas, int total) {
+    long soma = 0;
+
+    for (int t = 0; t < total; t++) {
+        soma += contarAulasDaTurma(turmas[t].id);
+        soma += contarAlunosDaTurma(turmas[t].id, 1);
+    }
+    return soma;
+}
+
+static void benchAgregados(void) {
+    static Turma turmas[MAX_TURMAS];
+
+    int total = listarTurmas(turmas, MAX_TURMAS);
+    if (total == 0) {
+        printf("Nenhuma turma em %s; cadastre dados antes do benchmark.\n", ARQUIVO_TURMAS);
+        return;
+    }
+
+    double varredura = 1e9, agregada = 1e9, verificacao = 1e9;
+    long soma_varredura = 0, soma_agregada = 0;
+    for (int r = 0; r < REPETICOES_AGREGADOS; r++) {
+        double inicio = agoraSegundos();
+        soma_varredura = contagemPorVarredura(turmas, total);
+        double meio = agoraSegundos();
+        soma_agregada = contagemAgregada(turmas, total);
+        double fim = agoraSegundos();
+        int divergencias = verificarAgregados(0);
+        double depois = agoraSegundos();
+
+        varredura = (meio - inicio < varredura) ? meio - inicio : varredura;
+        agregada = (fim - meio < agregada) ? fim - meio : agregada;
+        verificacao = (depois - fim < verificacao) ? depois - fim : verificacao;
+        if (divergencias != 0) {
+            printf("Aviso: %d contador(es) divergente(s) na rodada %d\n", divergencias, r + 1);
+        }
+    }
+
+    printf("\n=== Aulas e alunos ativos de %d turmas, melhor de %d ===\n", total, REPETICOES_AGREGADOS);
+    printf("%-28s %-12s %-14s %-10s\n", "Forma", "ms total", "us por turma", "Speedup");
+    printf("%-28s %-12.3f %-14.2f %-10.2f\n", "varredura das tabelas", varredura * 1e3,
+           varredura * 1e6 / total, 1.0);
+    printf("%-28s %-12.3f %-14.2f %-10.2f\n", "contadores agregados", agregada * 1e3,
+           agregada * 1e6 / total, varredura / agregada);
+    printf("%-28s %-12.3f %-14s %-10s\n", "recalculo completo (verif.)", verificacao * 1e3, "-", "-");
+    if (soma_varredura != soma_agregada) {
+        printf("Aviso: somas diferentes (%ld na varredura, %ld nos contadores)\n", soma_varredura,
+               soma_agregada);
+    }
+}
+
+// ========== ALUNOS DA TURMA (JUNÇÃO) ==========
+
+#define REPETICOES_ROSTER 5
+
+// Forma antiga: RAs da turma e uma busca (trava + conferência do CSV) por RA
+static long rosterUmPorUm(const Turma *turmas, int total) {
+    static int ras[MAX_ALUNOS];
+    long soma = 0;
+    for (int t = 0; t < total; t++) {
+        int n = listarAlunosDaTurma(turmas[t].id, ras, MAX_ALUNOS);
+        for (int i = 0; i < n; i++) {
+            Aluno aluno;
+            if (obterAlunoPorRA(ras[i], &aluno)) {
+                soma += aluno.ra + aluno.ativo;
+            }
+        }
+    }
+    return soma;
+}
+
+static long rosterJuntado(const Turma *turmas, int total) {
+    static Aluno alunos[MAX_ALUNOS];
+    long soma = 0;
+    for (int t = 0; t < total; t++) {
+        int n = listarAlunosDaTurmaDetalhado(turmas[t].id, 0, alunos, MAX_ALUNOS);
+        for (int i = 0; i < n; i++) {
+            if (alunos[i].ativo >= 0) {
+                soma += alunos[i].ra + alunos[i].ativo;
+            }
+        }
+    }
+    return soma;
+}
+
+static void benchRoster(void) {
+    static Turma turmas[MAX_TURMAS];
+
+    int total = listarTurmas(turmas, MAX_TURMAS);
+    if (total == 0) {
+        printf("Nenhuma turma em %s; cadastre dados antes do benchmark.\n", ARQUIVO_TURMAS);
+        return;
+    }
+
+    double um_por_um = 1e9, juntado = 1e9;
+    long soma_um_por_um = 0, soma_juntado = 0;
+    for (int r = 0; r < REPETICOES_ROSTER; r++) {
+        double inicio = agoraSegundos();
+        soma_um_por_um = rosterUmPorUm(turmas, total);
+        double meio = agoraSegundos();
+        soma_juntado = rosterJuntado(turmas, total);
+        double fim = agoraSegundos();
+
+        um_por_um = (meio - inicio < um_por_um) ? meio - inicio : um_por_um;
+        juntado = (fim - meio < juntado) ? fim - meio : juntado;
+    }
+
+    printf("\n=== Alunos de %d turmas com o cadastro, melhor de %d ===\n", total, REPETICOES_ROSTER);
+    printf("%-34s %-12s %-14s %-10s\n", "Forma", "ms total", "us por turma", "Speedup");
+    printf("%-34s %-12.3f %-14.2f %-10.2f\n", "RAs + uma busca por aluno (N+1)", um_por_um * 1e3,
+           um_por_um * 1e6 / total, 1.0);
+    printf("%-34s %-12.3f %-14.2f %-10.2f\n", "juncao em lote (indice de RA)", juntado * 1e3,
+           juntado * 1e6 / total, um_por_um / juntado);
+    if (soma_um_por_um != soma_juntado) {
+        printf("Aviso: somas diferentes (%ld um a um, %ld juntado)\n", soma_um_por_um, soma_juntado);
+    }
+}
+
+// ========== FREQUÊNCIA ==========
+
+#define ARQUIVO_BENCH_FREQUENCIA "data/bench_frequencia.dat"
+#define ALUNOS_BENCH_FREQUENCIA 1000
+#define AULAS_BENCH_FREQUENCIA 2000
+#define REPETICOES_FREQUENCIA 10
+
+static void benchFrequencia(void) {
+    static Aluno alunos[MAX_ALUNOS];
+    static AlunoTurma matriculas[MAX_MATRICULAS];
+    static Aula aulas[MAX_AULAS];
+    static FrequenciaAluno frequencias[ALUNOS_BENCH_FREQUENCIA];
+    static int ids_aula[AULAS_BENCH_FREQUENCIA];
+    int ausentes[ALUNOS_BENCH_FREQUENCIA];
+
+    // Turma temporária com os alunos já cadastrados; matrículas, aulas e a
+    // turma são excluídas no fim (alunos não, pois a exclusão só desativa)
+    int total_alunos = listarAlunos(alunos, MAX_ALUNOS);
+    int livres_matriculas = MAX_MATRICULAS - listarMatriculas(matriculas, MAX_MATRICULAS);
+    int livres_aulas = MAX_AULAS - listarTodasAulas(aulas, MAX_AULAS);
+    int n_alunos = total_alunos;
+    n_alunos = (n_alunos < ALUNOS_BENCH_FREQUENCIA) ? n_alunos : ALUNOS_BENCH_FREQUENCIA;
+    n_alunos = (n_alunos < livres_matriculas) ? n_alunos : livres_matriculas;
+    int n_aulas = (livres_aulas < AULAS_BENCH_FREQUENCIA) ? livres_aulas : AULAS_BENCH_FREQUENCIA;
+    if (n_alunos <= 0 || n_aulas <= 0) {
+        printf("Sem alunos cadastrados ou sem espaco para matriculas/aulas de teste.\n");
+        return;
+    }
+
+    remove(ARQUIVO_BENCH_FREQUENCIA);
+    usarArquivoFrequencia(ARQUIVO_BENCH_FREQUENCIA);
+
+    // Cadastros em memória; o CSV é gravado uma vez no fim
+    iniciarGravacaoAdiada(60000, 1 << 30);
+    int saida = silenciarSaida();
+    Turma turma = {gerarProximoIDTurma(), "Bench Frequencia", "Professor Bench", 2025, 2};
+    cadastrarTurma(&turma);
+    for (int i = 0; i < n_alunos; i++) {
+        associarAlunoTurma(alunos[i].ra, turma.id);
+    }
+    for (int i = 0; i < n_aulas; i++) {
+        Aula aula = {gerarProximoIDAula(), turma.id, "01/09/2025", "Bench frequencia"};
+        registrarAula(&aula);
+        ids_aula[i] = aula.id;
+    }
+    restaurarSaida(saida);
+
+    long long celulas = (long long)n_alunos * n_aulas;
+    printf("\n=== Frequencia: turma com %d alunos x %d aulas (%lld celulas) ===\n", n_alunos, n_aulas, celulas);
+
+    // 1. Chamadas "todos presentes, exceto" (~10% de ausentes)
+    srand(7);
+    double inicio = agoraSegundos();
+    for (int a = 0; a < n_aulas; a++) {
+        int total_ausentes = 0;
+        for (int i = 0; i < n_alunos; i++) {
+            if (rand() % 10 == 0) {
+                ausentes[total_ausentes++] = alunos[i].ra;
+            }
+        }
+        registrarChamada(ids_aula[a], ausentes, total_ausentes);
+    }
+    double registro = agoraSegundos() - inicio;
+
+    // 2. Consultas: popcount por palavra x um aluno por vez
+    double turma_melhor = 1e9, todos_melhor = 1e9, um_a_um_melhor = 1e9;
+    FrequenciaTurma resumo;
+    long long soma_todos = 0, soma_um_a_um = 0;
+    for (int r = 0; r < REPETICOES_FREQUENCIA; r++) {
+        double t0 = agoraSegundos();
+        frequenciaDaTurma(turma.id, &resumo);
+        double t1 = agoraSegundos();
+        int listados = frequenciaAlunosDaTurma(turma.id, frequencias, ALUNOS_BENCH_FREQUENCIA);
+        double t2 = agoraSegundos();
+        soma_um_a_um = 0;
+        for (int i = 0; i < n_alunos; i++) {
+            FrequenciaAluno individual;
+            frequenciaDoAluno(turma.id, alunos[i].ra, &individual);
+            soma_um_a_um += individual.presencas;
+        }
+        double t3 = agoraSegundos();
+
+        soma_todos = 0;
+        for (int i = 0; i < listados; i++) {
+            soma_todos += frequencias[i].presencas;
+        }
+        turma_melhor = (t1 - t0 < turma_melhor) ? t1 - t0 : turma_melhor;
+        todos_melhor = (t2 - t1 < todos_melhor) ? t2 - t1 : todos_melhor;
+        um_a_um_melhor = (t3 - t2 < um_a_um_melhor) ? t3 - t2 : um_a_um_melhor;
+    }
+
+    // 3. Tamanho em disco e releitura
+    FILE *arquivo = fopen(ARQUIVO_BENCH_FREQUENCIA, "rb");
+    long tamanho = 0;
+    if (arquivo != NULL) {
+        fseek(arquivo, 0, SEEK_END);
+        tamanho = ftell(arquivo);
+        fclose(arquivo);
+    }
+    inicio = agoraSegundos();
+    usarArquivoFrequencia(ARQUIVO_BENCH_FREQUENCIA);
+    frequenciaDaTurma(turma.id, &resumo);
+    double releitura = agoraSegundos() - inicio;
+
+    printf("%-36s %-12s %-16s\n", "Operacao", "ms", "Mcelulas/s");
+    printf("%-36s %-12.2f %-16.1f (%.0f chamadas/s)\n", "registrar chamadas (com gravacao)", registro * 1e3,
+           celulas / registro / 1e6, n_aulas / registro);
+    printf("%-36s %-12.3f %-16.1f\n", "frequencia da turma (popcount)", turma_melhor * 1e3,
+           celulas / turma_melhor / 1e6);
+    printf("%-36s %-12.3f %-16.1f\n", "frequencia de todos os alunos", todos_melhor * 1e3,
+           celulas / todos_melhor / 1e6);
+    printf("%-36s %-12.3f %-16.1f\n", "um aluno por vez (teste de bit)", um_a_um_melhor * 1e3,
+           celulas / um_a_um_melhor / 1e6);
+    printf("%-36s %-12.2f %-16.1f\n", "releitura do arquivo", releitura * 1e3, celulas / releitura / 1e6);
+    printf("Presencas: %lld de %lld (%.1f%%); arquivo: %ld bytes (%.2f bits por celula)\n", resumo.presencas,
+           resumo.matriculados, resumo.matriculados ? 100.0 * resumo.presencas / resumo.matriculados : 0.0,
+           tamanho, celulas ? 8.0 * tamanho / celulas : 0.0);
+    if (soma_todos != soma_um_a_um || soma_todos != resumo.presencas) {
+        printf("Aviso: somas diferentes (%lld todos, %lld um a um, %lld turma)\n", soma_todos, soma_um_a_um,
+               resumo.presencas);
+    }
+
+    // Limpeza
+    usarArquivoFrequencia(NULL);
+    remove(ARQUIVO_BENCH_FREQUENCIA);
+    remove(ARQUIVO_BENCH_FREQUENCIA ".lock");
+    saida = silenciarSaida();
+    for (int i = 0; i < n_aulas; i++) {
+        excluirAula(ids_aula[i]);
+    }
+    for (int i = 0; i < n_alunos; i++) {
+        removerAlunoTurma(alunos[i].ra, turma.id);
+    }
+    excluirTurma(turma.id);
+    encerrarGravacaoAdiada();
+    restaurarSaida(saida);
+}
+
+// ========== NOTAS ==========
+
+#define ALUNOS_BENCH_NOTAS 100000
+#define ATIVIDADES_BENCH_NOTAS 50
+#define REPETICOES_NOTAS 5
+
+// Estatísticas por atividade lendo as notas linha a linha (vetor de Nota),
+// como ficariam sem as colunas: uma passada, acumulador por atividade
+static double estatisticasPorLinhas(const Nota *notas, int total, EstatisticasNotas *destino) {
+    static double somas[ATIVIDADES_BENCH_NOTAS + 1], quadrados[ATIVIDADES_BENCH_NOTAS + 1];
+    double soma_medias = 0.0;
+
+    memset(destino, 0, sizeof(EstatisticasNotas) * (ATIVIDADES_BENCH_NOTAS + 1));
+    memset(somas, 0, sizeof(somas));
+    memset(quadrados, 0, sizeof(quadrados));
+    for (int i = 0; i < total; i++) {
+        EstatisticasNotas *e = &destino[notas[i].id_atividade];
+        float nota = notas[i].nota;
+        if (e->quantidade == 0 || nota < e->minima) {
+            e->minima = nota;
+        }
+        if (e->quantidade == 0 || nota > e->maxima) {
+            e->maxima = nota;
+        }
+        e->quantidade++;
+        e->histograma[nota >= 9.0f ? 9 : (int)nota]++;
+        somas[notas[i].id_atividade] += nota;
+        quadrados[notas[i].id_atividade] += (double)nota * nota;
+    }
+    for (int a = 1; a <= ATIVIDADES_BENCH_NOTAS; a++) {
+        EstatisticasNotas *e = &destino[a];
+        if (e->quantidade > 0) {
+            e->media = somas[a] / e->quantidade;
+            e->desvio = sqrt(quadrados[a] / e->quantidade - e->media * e->media);
+            soma_medias += e->media;
+        }
+    }
+    return soma_medias;
+}
+
+static void benchNotas(void) {
+    static EstatisticasNotas por_linhas[ATIVIDADES_BENCH_NOTAS + 1];
+    int atividades[ATIVIDADES_BENCH_NOTAS];
+    float pesos[ATIVIDADES_BENCH_NOTAS];
+    size_t maximo = (size_t)ALUNOS_BENCH_NOTAS * ATIVIDADES_BENCH_NOTAS;
+    Nota *notas = malloc(sizeof(Nota) * maximo);
+    int *ras = malloc(sizeof(int) * ALUNOS_BENCH_NOTAS);
+    double *medias = malloc(sizeof(double) * ALUNOS_BENCH_NOTAS);
+    Boletim *boletim = criarBoletim();
+    if (notas == NULL || ras == NULL || medias == NULL || boletim == NULL) {
+        printf("Memoria insuficiente para o benchmark de notas.\n");
+        free(notas);
+        free(ras);
+        free(medias);
+        liberarBoletim(boletim);
+        return;
+    }
+
+    // Notas em ordem de aluno (como num CSV exportado), ~5% em branco
+    unsigned int semente = 42;
+    int total = 0;
+    for (int a = 0; a < ATIVIDADES_BENCH_NOTAS; a++) {
+        atividades[a] = a + 1;
+        pesos[a] = (float)(1 + a % 3);
+    }
+    for (int i = 0; i < ALUNOS_BENCH_NOTAS; i++) {
+        for (int a = 0; a < ATIVIDADES_BENCH_NOTAS; a++) {
+            semente = semente * 1103515245u + 12345u;
+            if ((semente >> 16) % 20 != 0) {
+                notas[total].ra = 100000 + i;
+                notas[total].id_atividade = atividades[a];
+                notas[total].nota = (float)((semente >> 8) % 41) / 4.0f;
+                total++;
+            }
+        }
+    }
+    double celulas = (double)ALUNOS_BENCH_NOTAS * ATIVIDADES_BENCH_NOTAS;
+    printf("\n=== Boletim de %d alunos x %d atividades (%d notas), melhor de %d ===\n", ALUNOS_BENCH_NOTAS,
+           ATIVIDADES_BENCH_NOTAS, total, REPETICOES_NOTAS);
+
+    double inicio = agoraSegundos();
+    int importadas = importarNotasBoletim(boletim, notas, total);
+    double importacao = agoraSegundos() - inicio;
+
+    double linhas = 1e9, colunas = 1e9, turma = 1e9, por_aluno = 1e9, vetorial = 1e9, ponderada = 1e9;
+    double soma_linhas = 0.0, soma_colunas = 0.0, soma_por_aluno = 0.0, soma_vetorial = 0.0;
+    EstatisticasNotas estatisticas, geral;
+    for (int r = 0; r < REPETICOES_NOTAS; r++) {
+        inicio = agoraSegundos();
+        soma_linhas = estatisticasPorLinhas(notas, total, por_linhas);
+        double t1 = agoraSegundos();
+        soma_colunas = 0.0;
+        for (int a = 0; a < ATIVIDADES_BENCH_NOTAS; a++) {
+            estatisticasAtividadesBoletim(boletim, &atividades[a], 1, &estatisticas);
+            soma_colunas += estatisticas.media;
+        }
+        double t2 = agoraSegundos();
+        estatisticasAtividadesBoletim(boletim, atividades, ATIVIDADES_BENCH_NOTAS, &geral);
+        double t3 = agoraSegundos();
+        soma_por_aluno = 0.0;
+        for (int i = 0; i < ALUNOS_BENCH_NOTAS; i++) {
+            estatisticasAlunoBoletim(boletim, 100000 + i, atividades, ATIVIDADES_BENCH_NOTAS, &estatisticas);
+            soma_por_aluno += estatisticas.media;
+        }
+        double t4 = agoraSegundos();
+        int copiados = mediasPorAlunoBoletim(boletim, atividades, ATIVIDADES_BENCH_NOTAS, ras, medias,
+                                             ALUNOS_BENCH_NOTAS);
+        soma_vetorial = 0.0;
+        for (int i = 0; i < copiados; i++) {
+            soma_vetorial += medias[i];
+        }
+        double t5 = agoraSegundos();
+        double media = 0.0;
+        for (int i = 0; i < ALUNOS_BENCH_NOTAS; i++) {
+            mediaPonderadaBoletim(boletim, 100000 + i, atividades, pesos, ATIVIDADES_BENCH_NOTAS, &media);
+        }
+        double t6 = agoraSegundos();
+
+        linhas = (t1 - inicio < linhas) ? t1 - inicio : linhas;
+        colunas = (t2 - t1 < colunas) ? t2 - t1 : colunas;
+        turma = (t3 - t2 < turma) ? t3 - t2 : turma;
+        por_aluno = (t4 - t3 < por_aluno) ? t4 - t3 : por_aluno;
+        vetorial = (t5 - t4 < vetorial) ? t5 - t4 : vetorial;
+        ponderada = (t6 - t5 < ponderada) ? t6 - t5 : ponderada;
+    }
+
+    printf("%-38s %-12s %-12s\n", "Operacao", "ms", "Mnotas/s");
+    printf("%-38s %-12.1f %-12.1f\n", "importacao em lote", importacao * 1e3, importadas / importacao / 1e6);
+    printf("%-38s %-12.2f %-12.1f\n", "50 atividades lendo linhas (Nota[])", linhas * 1e3, total / linhas / 1e6);
+    printf("%-38s %-12.2f %-12.1f (%.1fx)\n", "50 atividades, coluna a coluna", colunas * 1e3,
+           celulas / colunas / 1e6, linhas / colunas);
+    printf("%-38s %-12.2f %-12.1f\n", "turma inteira (50 colunas juntas)", turma * 1e3, celulas / turma / 1e6);
+    printf("%-38s %-12.2f %-12.1f\n", "estatisticas de cada aluno (linha)", por_aluno * 1e3,
+           celulas / por_aluno / 1e6);
+    printf("%-38s %-12.2f %-12.1f (%.1fx)\n", "media de todos os alunos (colunas)", vetorial * 1e3,
+           celulas / vetorial / 1e6, por_aluno / vetorial);
+    printf("%-38s %-12.2f %-12.1f\n", "media ponderada de cada aluno", ponderada * 1e3, celulas / ponderada / 1e6);
+    printf("Geral: media %.3f, desvio %.3f, min %.2f, max %.2f\n", geral.media, geral.desvio,
+           (double)geral.minima, (double)geral.maxima);
+    if (fabs(soma_linhas - soma_colunas) > 1e-6 * ATIVIDADES_BENCH_NOTAS ||
+        fabs(soma_por_aluno - soma_vetorial) > 1e-6 * ALUNOS_BENCH_NOTAS) {
+        printf("Aviso: resultados diferentes (%.6f x %.6f nas atividades, %.6f x %.6f nos alunos)\n", soma_linhas,
+               soma_colunas, soma_por_aluno, soma_vetorial);
+    }
+
+    liberarBoletim(boletim);
+    free(notas);
+    free(ras);
+    free(medias);
+}
+
+// ========== VERIFICAÇÃO DE INTEGRIDADE ==========
+
+#define DIRETORIO_BENCH_VERIFICACAO "data/bench_verificacao"
+#define ALUNOS_BENCH_VERIFICACAO 200000
+#define TURMAS_BENCH_VERIFICACAO 2000
+#define AULAS_POR_TURMA_VERIFICACAO 100
+#define MATRICULAS_POR_ALUNO_VERIFICACAO 2
+#define ATIVIDADES_POR_TURMA_VERIFICACAO 10
+#define REPETICOES_VERIFICACAO 3
+
+static const char *csvs_bench_verificacao[] = {
+    "alunos.csv", "turmas.csv", "aulas.csv", "aluno_turma.csv", "atividades.csv", "usuarios.csv", "notas.csv"
+};
+
+static FILE *abrirCsvBenchVerificacao(const char *arquivo, const char *cabecalho) {
+    char caminho[256];
+    snprintf(caminho, sizeof(caminho), "%s/%s", DIRETORIO_BENCH_VERIFICACAO, arquivo);
+    FILE *csv = fopen(caminho, "w");
+    if (csv != NULL) {
+        fprintf(csv, "%s\n", cabecalho);
+    }
+    return csv;
+}
+
+static void removerBenchVerificacao(void) {
+    char caminho[256];
+    for (int i = 0; i < 7; i++) {
+        snprintf(caminho, sizeof(caminho), "%s/%s", DIRETORIO_BENCH_VERIFICACAO, csvs_bench_verificacao[i]);
+        remove(caminho);
+        strncat(caminho, ".lock", sizeof(caminho) - strlen(caminho) - 1);
+        remove(caminho);
+    }
+    rmdir(DIRETORIO_BENCH_VERIFICACAO);
+}
+
+// Diretório sintético consistente, com alguns problemas de cada tipo
+// Retorna: linhas de dados gravadas, 0 se erro
+static long gerarBenchVerificacao(void) {
+    FILE *csv[7];
+    long linhas = 0;
+
+    mkdir(DIRETORIO_BENCH_VERIFICACAO, 0755);
+    csv[0] = abrirCsvBenchVerificacao("alunos.csv", "RA,Nome,Email,Ativo");
+    csv[1] = abrirCsvBenchVerificacao("turmas.csv", "ID,Nome,Professor,Ano,Semestre");
+    csv[2] = abrirCsvBenchVerificacao("aulas.csv", "ID,ID_Turma,Data,Conteudo");
+    csv[3] = abrirCsvBenchVerificacao("aluno_turma.csv", "RA,ID_Turma");
+    csv[4] = abrirCsvBenchVerificacao("atividades.csv", "ID,ID_Turma,Titulo,Descricao,Arquivo");
+    csv[5] = abrirCsvBenchVerificacao("usuarios.csv", "ID,Login,Senha,Tipo,Ativo");
+    csv[6] = abrirCsvBenchVerificacao("notas.csv", "RA,ID_Atividade,Nota");
+    for (int i = 0; i < 7; i++) {
+        if (csv[i] == NULL) {
+            for (int j = 0; j < 7; j++) {
+                if (csv[j] != NULL) {
+                    fclose(csv[j]);
+                }
+            }
+            return 0;
+        }
+    }
+
+    for (int i = 0; i < ALUNOS_BENCH_VERIFICACAO; i++) {
+        fprintf(csv[0], "%d,Aluno %d,aluno%d@escola.br,%d\n", 100000 + i, i, i, (i % 50000 == 7) ? 2 : 1);
+        fprintf(csv[5], "%d,aluno%d,%08x,ALUNO,1\n", i + 1, i, (unsigned int)i * 2654435761u);
+        linhas += 2;
+    }
+    for (int t = 1; t <= TURMAS_BENCH_VERIFICACAO; t++) {
+        fprintf(csv[1], "%d,Turma %d,Professor %d,2025,%d\n", t, t, t % 97, 1 + t % 2);
+        linhas++;
+        for (int a = 0; a < AULAS_POR_TURMA_VERIFICACAO; a++) {
+            int id = (t - 1) * AULAS_POR_TURMA_VERIFICACAO + a + 1;
+            fprintf(csv[2], "%d,%d,%02d/%02d/2025,Conteudo da aula %d, parte %d\n", id,
+                    (id % 40000 == 3) ? TURMAS_BENCH_VERIFICACAO + 1 : t, 1 + a % 28, 1 + a % 12, a, a % 3);
+            linhas++;
+        }
+        for (int a = 0; a < ATIVIDADES_POR_TURMA_VERIFICACAO; a++) {
+            fprintf(csv[4], "%d,%d,Atividade %d,Descricao da atividade,\n",
+                    (t - 1) * ATIVIDADES_POR_TURMA_VERIFICACAO + a + 1, t, a);
+            linhas++;
+        }
+    }
+    // Cada aluno em MATRICULAS_POR_ALUNO_VERIFICACAO turmas, com nota em todas as atividades delas
+    for (int i = 0; i < ALUNOS_BENCH_VERIFICACAO; i++) {
+        for (int m = 0; m < MATRICULAS_POR_ALUNO_VERIFICACAO; m++) {
+            int turma = 1 + (i * MATRICULAS_POR_ALUNO_VERIFICACAO + m * 7) % TURMAS_BENCH_VERIFICACAO;
+            fprintf(csv[3], "%d,%d\n", 100000 + i, turma);
+            linhas++;
+            for (int a = 0; a < ATIVIDADES_POR_TURMA_VERIFICACAO; a += 4) {
+                fprintf(csv[6], "%d,%d,%.2f\n", 100000 + i, (turma - 1) * ATIVIDADES_POR_TURMA_VERIFICACAO + a + 1,
+                        (double)((i + a) % 41) / 4.0);
+                linhas++;
+            }
+        }
+    }
+
+    for (int i = 0; i < 7; i++) {
+        fclose(csv[i]);
+    }
+    return linhas;
+}
+
+static void benchVerificacao(void) {
+    removerBenchVerificacao();
+    double inicio = agoraSegundos();
+    long linhas = gerarBenchVerificacao();
+    if (linhas == 0) {
+        printf("Nao foi possivel gerar %s.\n", DIRETORIO_BENCH_VERIFICACAO);
+        removerBenchVerificacao();
+        return;
+    }
+    printf("\n=== Verificacao de integridade de %ld linhas sinteticas (gerado em %.2f s), melhor de %d ===\n",
+           linhas, agoraSegundos() - inicio, REPETICOES_VERIFICACAO);
+
+    OpcoesVerificacao sequencial = {NULL, NULL, 1};
+    OpcoesVerificacao paralela = {NULL, NULL, 0};
+    ResumoVerificacao resumo;
+    double tempo_sequencial = 1e9, tempo_paralelo = 1e9;
+    long problemas_sequencial = 0, problemas_paralelo = 0;
+    for (int r = 0; r < REPETICOES_VERIFICACAO; r++) {
+        problemas_sequencial = verificarDiretorioDados(DIRETORIO_BENCH_VERIFICACAO, &sequencial, &resumo);
+        tempo_sequencial = (resumo.segundos < tempo_sequencial) ? resumo.segundos : tempo_sequencial;
+        problemas_paralelo = verificarDiretorioDados(DIRETORIO_BENCH_VERIFICACAO, &paralela, &resumo);
+        tempo_paralelo = (resumo.segundos < tempo_paralelo) ? resumo.segundos : tempo_paralelo;
+    }
+
+    printf("%-28s %-12s %-14s %-10s\n", "Modo", "ms", "Mlinhas/s", "Problemas");
+    printf("%-28s %-12.1f %-14.2f %-10ld\n", "uma tabela por vez", tempo_sequencial * 1e3,
+           resumo.linhas / tempo_sequencial / 1e6, problemas_sequencial);
+    printf("%-28s %-12.1f %-14.2f %-10ld (%.1fx)\n", "tabelas da etapa em paralelo", tempo_paralelo * 1e3,
+           resumo.linhas / tempo_paralelo / 1e6, problemas_paralelo, tempo_sequencial / tempo_paralelo);
+    if (problemas_sequencial != problemas_paralelo || resumo.linhas != linhas) {
+        printf("Aviso: resultados diferentes (%ld x %ld problemas, %ld x %ld linhas)\n", problemas_sequencial,
+               problemas_paralelo, resumo.linhas, linhas);
+    }
+
+    removerBenchVerificacao();
+}
+
+// ========== BACKUP INCREMENTAL E RESTAURAÇÃO DA CADEIA ==========
+
+#define DIRETORIO_BENCH_BACKUP "data/bench_backup"
+#define AULAS_BENCH_BACKUP 2000000
+#define RODADAS_BENCH_BACKUP 8
+#define ALTERADAS_BENCH_BACKUP 400     // Por rodada: atualizadas; metade disso incluídas e excluídas
+
+typedef struct {
+    int id;
+    int id_turma;
+    int versao;                        // 0 = excluída
+} AulaBenchBackup;
+
+static AulaBenchBackup *aulas_bench_backup;
+static int total_aulas_bench_backup;
+static char caminho_aulas_bench_backup[] = DIRETORIO_BENCH_BACKUP "/aulas.csv";
+
+static void carregarAulasBenchBackup(void) {
+    // O array é a fonte: o CSV só é gravado por salvarAulasBenchBackup()
+}
+
+static int salvarAulasBenchBackup(void);
+
+static TabelaResidente tabela_bench_backup =
+    TABELA_RESIDENTE_INIT(caminho_aulas_bench_backup, carregarAulasBenchBackup, salvarAulasBenchBackup);
+
+static void gravarAulasBenchBackup(FILE *csv) {
+    fprintf(csv, "ID,ID_Turma,Data,Conteudo\n");
+    for (int i = 0; i < total_aulas_bench_backup; i++) {
+        const AulaBenchBackup *aula = &aulas_bench_backup[i];
+        if (aula->versao > 0) {
+            fprintf(csv, "%d,%d,%02d/%02d/2025,Conteudo da aula %d (revisao %d)\n", aula->id, aula->id_turma,
+                    1 + aula->id % 28, 1 + aula->id % 12, aula->id, aula->versao);
+        }
+    }
+}
+
+// Publica o CSV como os módulos: temporário + rename, depois marcarTabelaSalva()
+static int salvarAulasBenchBackup(void) {
+    FILE *csv = abrirEscritaAtomica(caminho_aulas_bench_backup);
+    if (csv == NULL) {
+        return 0;
+    }
+    gravarAulasBenchBackup(csv);
+    if (!concluirEscritaAtomica(csv, caminho_aulas_bench_backup)) {
+        return 0;
+    }
+    marcarTabelaSalva(&tabela_bench_backup);
+    return 1;
+}
+
+static void caminhoBenchBackup(char *caminho, size_t tamanho, const char *nome) {
+    snprintf(caminho, tamanho, "%s/%s", DIRETORIO_BENCH_BACKUP, nome);
+}
+
+static void removerBenchBackup(void) {
+    static const char *arquivos[] = {
+        "aulas.csv", "aulas.csv.lock", "alteracoes.log", "alteracoes.log.lock", "journal.log.lock",
+        "restaurado/aulas.csv", "restaurado", "completo.pimb", "completo.pimb.lock"
+    };
+    char caminho[256];
+    for (size_t i = 0; i < sizeof(arquivos) / sizeof(arquivos[0]); i++) {
+        caminhoBenchBackup(caminho, sizeof(caminho), arquivos[i]);
+        remove(caminho);
+    }
+    for (int r = 0; r <= RODADAS_BENCH_BACKUP; r++) {
+        char nome[64];
+        snprintf(nome, sizeof(nome), "backup_%d.pimb", r);
+        caminhoBenchBackup(caminho, sizeof(caminho), nome);
+        remove(caminho);
+        strncat(caminho, ".lock", sizeof(caminho) - strlen(caminho) - 1);
+        remove(caminho);
+    }
+    rmdir(DIRETORIO_BENCH_BACKUP);
+}
+
+// Uma rodada de alterações: atualizações espalhadas, exclusões e aulas novas no fim
+static void alterarAulasBenchBackup(unsigned int *semente) {
+    abrirEscritaTabela(&tabela_bench_backup);
+    for (int i = 0; i < ALTERADAS_BENCH_BACKUP; i++) {
+        AulaBenchBackup *aula = &aulas_bench_backup[rand_r(semente) % (unsigned int)total_aulas_bench_backup];
+        aula->versao += (aula->versao > 0);
+    }
+    for (int i = 0; i < ALTERADAS_BENCH_BACKUP / 2; i++) {
+        aulas_bench_backup[rand_r(semente) % (unsigned int)total_aulas_bench_backup].versao = 0;
+        AulaBenchBackup *nova = &aulas_bench_backup[total_aulas_bench_backup];
+        nova->id = total_aulas_bench_backup + 1;
+        nova->id_turma = 1 + (int)(rand_r(semente) % 20000);
+        nova->versao = 1;
+        total_aulas_bench_backup++;
+    }
+    salvarAulasBenchBackup();
+    fecharTabela(&tabela_bench_backup);
+}
+
+// Confere uma cópia ("restaurado/aulas.csv") com o CSV publicado
+static int copiaIgualBenchBackup(const char *nome) {
+    char caminho[256];
+    caminhoBenchBackup(caminho, sizeof(caminho), nome);
+    FILE *original = fopen(caminho_aulas_bench_backup, "rb");
+    FILE *restaurado = fopen(caminho, "rb");
+    int iguais = original != NULL && restaurado != NULL;
+    char bloco_original[65536];
+    char bloco_restaurado[65536];
+
+    while (iguais) {
+        size_t lido = fread(bloco_original, 1, sizeof(bloco_original), original);
+        iguais = fread(bloco_restaurado, 1, sizeof(bloco_restaurado), restaurado) == lido &&
+                 memcmp(bloco_original, bloco_restaurado, lido) == 0;
+        if (lido == 0) {
+            break;
+        }
+    }
+    if (original != NULL) {
+        fclose(original);
+    }
+    if (restaurado != NULL) {
+        fclose(restaurado);
+    }
+    return iguais;
+}
+
+// Gera as aulas iniciais (array e CSV) em DIRETORIO_BENCH_BACKUP
+static int gerarAulasBenchBackup(void) {
+    removerBenchBackup();
+    mkdir(DIRETORIO_BENCH_BACKUP, 0755);
+    aulas_bench_backup = malloc(sizeof(AulaBenchBackup) *
+                                (AULAS_BENCH_BACKUP + RODADAS_BENCH_BACKUP * ALTERADAS_BENCH_BACKUP));
+    FILE *csv = fopen(caminho_aulas_bench_backup, "wb");
+    if (aulas_bench_backup == NULL || csv == NULL) {
+        printf("Nao foi possivel gerar %s.\n", caminho_aulas_bench_backup);
+        if (csv != NULL) {
+            fclose(csv);
+        }
+        free(aulas_bench_backup);
+        removerBenchBackup();
+        return 0;
+    }
+    for (int i = 0; i < AULAS_BENCH_BACKUP; i++) {
+        aulas_bench_backup[i].id = i + 1;
+        aulas_bench_backup[i].id_turma = 1 + i / 100;
+        aulas_bench_backup[i].versao = 1;
+    }
+    total_aulas_bench_backup = AULAS_BENCH_BACKUP;
+    gravarAulasBenchBackup(csv);
+    fclose(csv);
+    return 1;
+}
+
+static void benchBackup(void) {
+    const char *cadeia[RODADAS_BENCH_BACKUP + 1];
+    char nomes[RODADAS_BENCH_BACKUP + 1][256];
+    char destino[256];
+    char completo_final[256];
+    ResumoBackup resumo;
+    unsigned int semente = 42;
+
+    if (!gerarAulasBenchBackup()) {
+        return;
+    }
+    caminhoBenchBackup(destino, sizeof(destino), "restaurado");
+    caminhoBenchBackup(completo_final, sizeof(completo_final), "completo.pimb");
+
+    printf("\n=== Backup incremental de %d aulas: %d rodadas de %d atualizacoes + %d exclusoes + %d inclusoes ===\n",
+           AULAS_BENCH_BACKUP, RODADAS_BENCH_BACKUP, ALTERADAS_BENCH_BACKUP, ALTERADAS_BENCH_BACKUP / 2,
+           ALTERADAS_BENCH_BACKUP / 2);
+
+    for (int r = 0; r <= RODADAS_BENCH_BACKUP; r++) {
+        snprintf(nomes[r], sizeof(nomes[r]), "%s/backup_%d.pimb", DIRETORIO_BENCH_BACKUP, r);
+        cadeia[r] = nomes[r];
+    }
+    int saida = silenciarSaida();
+    int ok = criarBackup(DIRETORIO_BENCH_BACKUP, cadeia[0], &resumo);
+    restaurarSaida(saida);
+    if (!ok) {
+        printf("Falha no backup completo.\n");
+        free(aulas_bench_backup);
+        removerBenchBackup();
+        return;
+    }
+    printf("%-24s %-12s %-14s %-12s\n", "Backup", "ms", "Bytes", "Operacoes");
+    printf("%-24s %-12.1f %-14lld %-12s\n", "completo", resumo.segundos * 1e3, resumo.bytes_gravados, "-");
+
+    double publicacao = 0.0;
+    long long bytes_incrementais = 0;
+    for (int r = 1; r <= RODADAS_BENCH_BACKUP && ok; r++) {
+        double inicio = agoraSegundos();
+        alterarAulasBenchBackup(&semente);
+        publicacao += agoraSegundos() - inicio;
+
+        saida = silenciarSaida();
+        ok = criarBackupIncremental(DIRETORIO_BENCH_BACKUP, cadeia[r - 1], cadeia[r], &resumo);
+        restaurarSaida(saida);
+        bytes_incrementais += resumo.bytes_gravados;
+        if (r == 1 || r == RODADAS_BENCH_BACKUP) {
+            char rotulo[32];
+            snprintf(rotulo, sizeof(rotulo), "incremental %d", r);
+            printf("%-24s %-12.1f %-14lld %-12lld\n", rotulo, resumo.segundos * 1e3, resumo.bytes_gravados,
+                   resumo.alteracoes);
+        }
+    }
+    printf("Publicacao das rodadas (CSV + registro de alteracoes): %.1f ms em media; incrementais somam %lld bytes\n",
+           publicacao / RODADAS_BENCH_BACKUP * 1e3, bytes_incrementais);
+
+    // Restauração: cadeia inteira x um completo do mesmo instante
+    char restaurado_csv[256];
+    caminhoBenchBackup(restaurado_csv, sizeof(restaurado_csv), "restaurado/aulas.csv");
+    saida = silenciarSaida();
+    ok = ok && criarBackup(DIRETORIO_BENCH_BACKUP, completo_final, NULL);
+    restaurarSaida(saida);
+    double tempo_cadeia = 1e9, tempo_completo = 1e9;
+    long long linhas = 0;
+    int iguais = ok;
+    for (int i = 0; i < 3 && ok; i++) {
+        saida = silenciarSaida();
+        ok = restaurarCadeiaBackup(cadeia, RODADAS_BENCH_BACKUP + 1, destino, &resumo);
+        restaurarSaida(saida);
+        tempo_cadeia = (resumo.segundos < tempo_cadeia) ? resumo.segundos : tempo_cadeia;
+        linhas = resumo.linhas;
+        iguais = iguais && ok && copiaIgualBenchBackup("restaurado/aulas.csv");
+        remove(restaurado_csv);
+
+        saida = silenciarSaida();
+        ok = ok && restaurarBackup(completo_final, destino, &resumo);
+        restaurarSaida(saida);
+        tempo_completo = (resumo.segundos < tempo_completo) ? resumo.segundos : tempo_completo;
+        iguais = iguais && ok && copiaIgualBenchBackup("restaurado/aulas.csv");
+        remove(restaurado_csv);
+    }
+    if (!ok) {
+        printf("Falha na restauracao.\n");
+    } else {
+        printf("%-36s %-12s %-14s\n", "Restauracao (melhor de 3)", "ms", "Mlinhas/s");
+        printf("%-36s %-12.1f %-14.2f\n", "completo + incrementais (cadeia)", tempo_cadeia * 1e3,
+               linhas / tempo_cadeia / 1e6);
+        printf("%-36s %-12.1f %-14.2f\n", "completo do mesmo instante", tempo_completo * 1e3,
+               linhas / tempo_completo / 1e6);
+        printf("Restauracao igual ao CSV publicado: %s\n", iguais ? "sim" : "NAO");
+    }
+
+    free(aulas_bench_backup);
+    removerBenchBackup();
+}
+
+// ========== REPLICAÇÃO ==========
+
+#define DIRETORIO_BENCH_REPLICA DIRETORIO_BENCH_BACKUP "/replica"
+
+typedef struct {
+    pthread_t thread;
+    int descritor;
+    atomic_int parar;
+    MetricasReplicacao metricas;
+} LadoBenchReplicacao;
+
+static void *primarioBenchReplicacao(void *arg) {
+    LadoBenchReplicacao *lado = (LadoBenchReplicacao *)arg;
+    servirReplicacao(DIRETORIO_BENCH_BACKUP, lado->descritor, &lado->parar);
+    return NULL;
+}
+
+static void *seguidorBenchReplicacao(void *arg) {
+    LadoBenchReplicacao *lado = (LadoBenchReplicacao *)arg;
+    seguirReplicacao(DIRETORIO_BENCH_REPLICA, lado->descritor, &lado->parar, &lado->metricas);
+    return NULL;
+}
+
+static void removerBenchReplica(void) {
+    static const char *arquivos[] = {
+        "alunos.csv", "turmas.csv", "aulas.csv", "aluno_turma.csv", "atividades.csv", "notas.csv",
+        "usuarios.csv", "frequencia.dat", "alteracoes.log", ARQUIVO_SEGUIDOR, ARQUIVO_METRICAS_REPLICACAO
+    };
+    char caminho[256];
+    for (size_t i = 0; i < sizeof(arquivos) / sizeof(arquivos[0]); i++) {
+        snprintf(caminho, sizeof(caminho), "%s/%s", DIRETORIO_BENCH_REPLICA, arquivos[i]);
+        remove(caminho);
+        strncat(caminho, ".lock", sizeof(caminho) - strlen(caminho) - 1);
+        remove(caminho);
+    }
+    rmdir(DIRETORIO_BENCH_REPLICA);
+}
+
+// Espera o seguidor chegar à última sequência do primário
+// Retorna: segundos de espera, -1 se não chegou em 60 s
+static double esperarReplicaBench(void) {
+    struct timespec pausa = {0, 200000};
+    double inicio = agoraSegundos();
+    long long alvo = ultimaSequenciaAlteracoes(DIRETORIO_BENCH_BACKUP);
+
+    while (ultimaSequenciaAlteracoes(DIRETORIO_BENCH_REPLICA) < alvo) {
+        if (agoraSegundos() - inicio > 60.0) {
+            return -1.0;
+        }
+        nanosleep(&pausa, NULL);
+    }
+    return agoraSegundos() - inicio;
+}
+
+static void benchReplicacao(void) {
+    LadoBenchReplicacao primario;
+    LadoBenchReplicacao seguidor;
+    unsigned int semente = 7;
+    int par[2];
+
+    if (!gerarAulasBenchBackup()) {
+        return;
+    }
+    removerBenchReplica();
+    memset(&primario, 0, sizeof(primario));
+    memset(&seguidor, 0, sizeof(seguidor));
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, par) != 0) {
+        printf("Nao foi possivel criar o par de sockets.\n");
+        free(aulas_bench_backup);
+        removerBenchBackup();
+        return;
+    }
+    primario.descritor = par[0];
+    seguidor.descritor = par[1];
+
+    printf("\n=== Replicacao de %d aulas para um diretorio reserva: %d rodadas de %d atualizacoes + %d exclusoes + "
+           "%d inclusoes ===\n",
+           AULAS_BENCH_BACKUP, RODADAS_BENCH_BACKUP, ALTERADAS_BENCH_BACKUP, ALTERADAS_BENCH_BACKUP / 2,
+           ALTERADAS_BENCH_BACKUP / 2);
+
+    // Cópia inicial: o seguidor cria o log por último
+    char log_replica[256];
+    struct stat info;
+    struct timespec pausa = {0, 200000};
+    snprintf(log_replica, sizeof(log_replica), "%s/%s.lock", DIRETORIO_BENCH_REPLICA, "alteracoes.log");
+    double inicio = agoraSegundos();
+    pthread_create(&primario.thread, NULL, primarioBenchReplicacao, &primario);
+    pthread_create(&seguidor.thread, NULL, seguidorBenchReplicacao, &seguidor);
+    while (stat(log_replica, &info) != 0 && agoraSegundos() - inicio < 60.0) {
+        nanosleep(&pausa, NULL);
+    }
+    double copia = agoraSegundos() - inicio;
+
+    // Cada rodada: publicação no primário, depois a espera até o seguidor aplicar
+    double publicacao = 0.0;
+    double atraso = 0.0;
+    double atraso_maximo = 0.0;
+    int ok = 1;
+    for (int r = 0; r < RODADAS_BENCH_BACKUP && ok; r++) {
+        inicio = agoraSegundos();
+        alterarAulasBenchBackup(&semente);
+        publicacao += agoraSegundos() - inicio;
+        double espera = esperarReplicaBench();
+        ok = espera >= 0.0;
+        atraso += espera;
+        atraso_maximo = (espera > atraso_maximo) ? espera : atraso_maximo;
+    }
+
+    atomic_store(&seguidor.parar, 1);
+    pthread_join(seguidor.thread, NULL);
+    atomic_store(&primario.parar, 1);
+    pthread_join(primario.thread, NULL);
+    close(par[0]);
+    close(par[1]);
+
+    if (!ok) {
+        printf("O seguidor nao alcancou o primario.\n");
+    } else {
+        printf("%-44s %-12s\n", "Etapa", "ms");
+        printf("%-44s %-12.1f\n", "copia inicial (backup completo)", copia * 1e3);
+        printf("%-44s %-12.1f\n", "publicacao no primario (media por rodada)", publicacao / RODADAS_BENCH_BACKUP * 1e3);
+        printf("%-44s %-12.1f\n", "atraso ate aplicar no seguidor (media)", atraso / RODADAS_BENCH_BACKUP * 1e3);
+        printf("%-44s %-12.1f\n", "atraso ate aplicar no seguidor (maximo)", atraso_maximo * 1e3);
+        printf("Metricas do seguidor: %lld publicacoes, %lld operacoes, atraso maximo %.1f ms\n",
+               seguidor.metricas.publicacoes, seguidor.metricas.operacoes,
+               seguidor.metricas.atraso_maximo_segundos * 1e3);
+        printf("Seguidor promovido igual ao CSV publicado: %s\n",
+               copiaIgualBenchBackup("replica/aulas.csv") ? "sim" : "NAO");
+    }
+
+    removerBenchReplica();
+    free(aulas_bench_backup);
+    removerBenchBackup();
+}
+
+// ========== ASSINATURA DE ALTERAÇÕES ==========
+
+// O que um painel sem assinatura faz a cada mudança: reler o CSV inteiro
+// Retorna: aulas lidas (linhas com ID)
+static long relerAulasBenchAssinatura(void) {
+    FILE *csv = fopen(caminho_aulas_bench_backup, "r");
+    char linha[256];
+    long linhas = 0;
+
+    if (csv == NULL) {
+        return 0;
+    }
+    while (fgets(linha, sizeof(linha), csv) != NULL) {
+        linhas += strtol(linha, NULL, 10) > 0;
+    }
+    fclose(csv);
+    return linhas;
+}
+
+static void benchAssinatura(void) {
+    static const char *tabelas[] = {"aulas.csv"};
+    AssinaturaAlteracoes assinatura;
+    LoteAlteracoes lote;
+    unsigned int semente = 11;
+
+    if (!gerarAulasBenchBackup()) {
+        return;
+    }
+    memset(&lote, 0, sizeof(lote));
+    abrirAssinaturaAlteracoes(&assinatura, DIRETORIO_BENCH_BACKUP, tabelas, 1, ASSINATURA_DO_FIM);
+
+    printf("\n=== Assinatura de %d aulas: %d rodadas de %d atualizacoes + %d exclusoes + %d inclusoes ===\n",
+           AULAS_BENCH_BACKUP, RODADAS_BENCH_BACKUP, ALTERADAS_BENCH_BACKUP, ALTERADAS_BENCH_BACKUP / 2,
+           ALTERADAS_BENCH_BACKUP / 2);
+
+    double tempo_lote = 0.0;
+    double tempo_releitura = 0.0;
+    long eventos = 0;
+    long recargas = 0;
+    long linhas = 0;
+    for (int r = 0; r < RODADAS_BENCH_BACKUP; r++) {
+        alterarAulasBenchBackup(&semente);
+
+        double inicio = agoraSegundos();
+        long total = lerLoteAlteracoes(&assinatura, &lote, 100000, 0);
+        tempo_lote += agoraSegundos() - inicio;
+        for (long i = 0; i < total; i++) {
+            recargas += lote.eventos[i].operacao == EVENTO_RECARREGAR;
+        }
+        eventos += (total > 0) ? total : 0;
+
+        inicio = agoraSegundos();
+        linhas += relerAulasBenchAssinatura();
+        tempo_releitura += agoraSegundos() - inicio;
+    }
+
+    printf("%-36s %-12s %-14s\n", "Por rodada (media)", "ms", "Linhas");
+    printf("%-36s %-12.3f %-14ld\n", "lote de eventos da assinatura", tempo_lote / RODADAS_BENCH_BACKUP * 1e3,
+           eventos / RODADAS_BENCH_BACKUP);
+    printf("%-36s %-12.3f %-14ld\n", "releitura do CSV", tempo_releitura / RODADAS_BENCH_BACKUP * 1e3,
+           linhas / RODADAS_BENCH_BACKUP);
+    printf("Eventos por rodada esperados: ate %d; pedidos de recarga: %ld; ultima sequencia %lld\n",
+           ALTERADAS_BENCH_BACKUP * 2, recargas, lote.ultima_sequencia);
+
+    liberarLoteAlteracoes(&lote);
+    fecharAssinaturaAlteracoes(&assinatura);
+    free(aulas_bench_backup);
+    removerBenchBackup();
+}
+
+// ========== PERMISSÕES ==========
+
+// Em bench_permissoes.c (auth_manager.h não convive com file_manager.h)
+void benchPermissoes(void);
+
+// ========== REGISTRO DOS BENCHMARKS ==========
+
+typedef struct {
+    const char *nome;
+    const char *descricao;
+    void (*executar)(void);
+} Benchmark;
+
+static const Benchmark benchmarks[] = {
+    {"leitura", "Escalabilidade de leitores concorrentes (1..N threads)", benchEscalabilidadeLeitura},
+    {"snapshot", "Leitores de aulas por snapshot com um escritor concorrente", benchSnapshotAulas},
+    {"exportacao", "Anexar a tabela exportada em memoria compartilhada x reler o CSV", benchExportacao},
+    {"persistencia", "Commits sincronos (stdio) x assincronos (io_uring / threads)", benchPersistencia},
+    {"auditoria", "Log de login: fopen por linha x anel com escritora em lote", benchAuditoria},
+    {"consulta", "Consulta do log de auditoria: varredura x indices de login e tempo", benchConsultaAuditoria},
+    {"permissoes", "Checagem de permissao: strcmp em cadeia x hash perfeito x mascara", benchPermissoes},
+    {"relatorios", "Relatorios de todas as turmas: um por turma x lote em threads x incremental", benchRelatorios},
+    {"agregados", "Contagens por turma: varredura das tabelas x contadores agregados", benchAgregados},
+    {"frequencia", "Chamadas em bitset: registro, popcount por turma/aluno e releitura", benchFrequencia},
+    {"roster", "Alunos das turmas com o cadastro: uma busca por RA x juncao em lote", benchRoster},
+    {"notas", "Boletim em colunas: importacao e estatisticas de 100k alunos x 50 atividades", benchNotas},
+    {"verificacao", "Verificacao de integridade dos CSVs: uma tabela por vez x etapas em paralelo", benchVerificacao},
+    {"backup", "Backup incremental pelo registro de alteracoes e restauracao da cadeia (linhas/s)", benchBackup},
+    {"replicacao", "Atraso do seguidor que aplica o registro de alteracoes do primario", benchReplicacao},
+    {"assinatura", "Painel ao vivo: lote de alteracoes da assinatura x reler o CSV a cada mudanca", benchAssinatura},
+};
+
+#define TOTAL_BENCHMARKS (int)(sizeof(benchmarks) / sizeof(benchmarks[0]))
+
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--lista") == 0) {
+        for (int i = 0; i < TOTAL_BENCHMARKS; i++) {
+            printf("  %-12s %s\n", benchmarks[i].nome, benchmarks[i].descricao);
+        }
+        return 0;
+    }
+
+    for (int i = 0; i < TOTAL_BENCHMARKS; i++) {
+        // Sem argumentos executa todos; caso contrário apenas os informados
+        int selecionado = (argc == 1);
+        for (int j = 1; j < argc; j++) {
+            if (strcmp(argv[j], benchmarks[i].nome) == 0) {
+                selecionado = 1;
+            }
+        }
+        if (selecionado) {
+            benchmarks[i].executar();
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "auth_manager.h"
+
+// Benchmark de permissões em unidade separada: auth_manager.h (via
+// usuario_manager.h) e file_manager.h definem TIPO_ALUNO cada um
+
+#define CHECAGENS_PERMISSAO 20000000L
+
+static const char *nomes_bench[] = {
+    "CADASTRAR_TURMA", "EDITAR_TURMA", "REGISTRAR_AULA", "UPLOAD_ATIVIDADE",
+    "VISUALIZAR_ALUNOS", "GERAR_RELATORIO", "CONSULTAR_TURMAS", "CONSULTAR_AULAS",
+    "BAIXAR_ATIVIDADE", "VISUALIZAR_NOTAS", "EXCLUIR_USUARIO", "LISTAR_LOGS"
+};
+
+#define TOTAL_NOMES_BENCH (int)(sizeof(nomes_bench) / sizeof(nomes_bench[0]))
+
+static double segundosMonotonicos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Como temPermissao() decidia antes das máscaras
+static int temPermissaoPorStrcmp(const Sessao *sessao, const char *acao) {
+    if (!sessao->ativo) {
+        return 0;
+    }
+    if (strcmp(sessao->tipo, "ADMIN") == 0) {
+        return 1;
+    }
+    if (strcmp(sessao->tipo, "PROFESSOR") == 0) {
+        if (strcmp(acao, "CADASTRAR_TURMA") == 0 ||
+            strcmp(acao, "EDITAR_TURMA") == 0 ||
+            strcmp(acao, "REGISTRAR_AULA") == 0 ||
+            strcmp(acao, "UPLOAD_ATIVIDADE") == 0 ||
+            strcmp(acao, "VISUALIZAR_ALUNOS") == 0 ||
+            strcmp(acao, "GERAR_RELATORIO") == 0) {
+            return 1;
+        }
+    }
+    if (strcmp(sessao->tipo, "ALUNO") == 0) {
+        if (strcmp(acao, "CONSULTAR_TURMAS") == 0 ||
+            strcmp(acao, "CONSULTAR_AULAS") == 0 ||
+            strcmp(acao, "BAIXAR_ATIVIDADE") == 0 ||
+            strcmp(acao, "VISUALIZAR_NOTAS") == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void benchPermissoes(void) {
+    static const char *tipos[] = {"ADMIN", "PROFESSOR", "ALUNO"};
+    AcaoPermissao acoes[TOTAL_NOMES_BENCH];
+    Sessao sessoes[3];
+    volatile long concedidas = 0;
+    long parcial;
+    int divergencias = 0;
+
+    memset(sessoes, 0, sizeof(sessoes));
+    for (int p = 0; p < 3; p++) {
+        strcpy(sessoes[p].tipo, tipos[p]);
+        sessoes[p].ativo = 1;
+        prepararPermissoesSessao(&sessoes[p]);
+    }
+    for (int a = 0; a < TOTAL_NOMES_BENCH; a++) {
+        acoes[a] = acaoPorNome(nomes_bench[a]);
+    }
+
+    // As três formas precisam concordar antes de medir
+    for (int p = 0; p < 3; p++) {
+        for (int a = 0; a < TOTAL_NOMES_BENCH; a++) {
+            int antiga = temPermissaoPorStrcmp(&sessoes[p], nomes_bench[a]);
+            int por_nome = temPermissao(&sessoes[p], nomes_bench[a]);
+            int por_mascara = (acoes[a] == ACAO_NENHUMA) ? isAdmin(&sessoes[p])
+                                                         : temPermissaoAcao(&sessoes[p], acoes[a]);
+            divergencias += (antiga != por_nome) + (antiga != por_mascara);
+        }
+    }
+
+    printf("\n=== Permissoes: %ld checagens (3 papeis x %d acoes) ===\n",
+           CHECAGENS_PERMISSAO, TOTAL_NOMES_BENCH);
+    printf("Divergencias entre as formas: %d\n", divergencias);
+    printf("%-30s %-16s %-10s\n", "Forma", "checagens/s", "ns/checagem");
+
+    double inicio = segundosMonotonicos();
+    parcial = 0;
+    for (long i = 0; i < CHECAGENS_PERMISSAO; i++) {
+        parcial += temPermissaoPorStrcmp(&sessoes[i % 3], nomes_bench[i % TOTAL_NOMES_BENCH]);
+    }
+    concedidas += parcial;
+    double tempo = segundosMonotonicos() - inicio;
+    printf("%-30s %-16.0f %-10.2f\n", "strcmp em cadeia (antiga)", CHECAGENS_PERMISSAO / tempo,
+           tempo / CHECAGENS_PERMISSAO * 1e9);
+
+    inicio = segundosMonotonicos();
+    parcial = 0;
+    for (long i = 0; i < CHECAGENS_PERMISSAO; i++) {
+        parcial += temPermissao(&sessoes[i % 3], nomes_bench[i % TOTAL_NOMES_BENCH]);
+    }
+    concedidas += parcial;
+    tempo = segundosMonotonicos() - inicio;
+    printf("%-30s %-16.0f %-10.2f\n", "nome -> hash perfeito", CHECAGENS_PERMISSAO / tempo,
+           tempo / CHECAGENS_PERMISSAO * 1e9);
+
+    inicio = segundosMonotonicos();
+    parcial = 0;
+    for (long i = 0; i < CHECAGENS_PERMISSAO; i++) {
+        parcial += temPermissaoAcao(&sessoes[i % 3], acoes[i % TOTAL_NOMES_BENCH]);
+    }
+    concedidas += parcial;
+    tempo = segundosMonotonicos() - inicio;
+    printf("%-30s %-16.0f %-10.2f\n", "constante (um AND)", CHECAGENS_PERMISSAO / tempo,
+           tempo / CHECAGENS_PERMISSAO * 1e9);
+
+    (void)concedidas;
+}
@@ -0,0 +1,523 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "exportacao_manager.h"
+#include "structs.h"
+#include "aluno_manager.h"
+#include "turma_manager.h"
+#include "aula_manager.h"
+#include "atividade_manager.h"
+#include "usuario_manager.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+#endif
+
+// ========== DESCRIÇÃO DAS TABELAS ==========
+
+// Coluna exportada: onde o valor está na struct do sistema
+typedef struct {
+    const char *nome;
+    int tipo;                  // COLUNA_INTEIRO ou COLUNA_TEXTO
+    size_t offset;             // offsetof na struct
+    size_t tamanho;            // Tamanho do campo na struct
+} ColunaExportada;
+
+#define COLUNA_INT(tipo, campo, nome) { nome, COLUNA_INTEIRO, offsetof(tipo, campo), sizeof(int) }
+#define COLUNA_TXT(tipo, campo, nome) { nome, COLUNA_TEXTO, offsetof(tipo, campo), sizeof(((tipo *)0)->campo) }
+
+static const ColunaExportada colunas_alunos[] = {
+    COLUNA_INT(Aluno, ra, "RA"),
+    COLUNA_TXT(Aluno, nome, "Nome"),
+    COLUNA_TXT(Aluno, email, "Email"),
+    COLUNA_INT(Aluno, ativo, "Ativo"),
+};
+
+static const ColunaExportada colunas_turmas[] = {
+    COLUNA_INT(Turma, id, "ID"),
+    COLUNA_TXT(Turma, nome, "Nome"),
+    COLUNA_TXT(Turma, professor, "Professor"),
+    COLUNA_INT(Turma, ano, "Ano"),
+    COLUNA_INT(Turma, semestre, "Semestre"),
+};
+
+static const ColunaExportada colunas_matriculas[] = {
+    COLUNA_INT(AlunoTurma, ra, "RA"),
+    COLUNA_INT(AlunoTurma, id_turma, "ID_Turma"),
+};
+
+static const ColunaExportada colunas_aulas[] = {
+    COLUNA_INT(Aula, id, "ID"),
+    COLUNA_INT(Aula, id_turma, "ID_Turma"),
+    COLUNA_TXT(Aula, data, "Data"),
+    COLUNA_TXT(Aula, conteudo, "Conteudo"),
+};
+
+static const ColunaExportada colunas_atividades[] = {
+    COLUNA_INT(Atividade, id, "ID"),
+    COLUNA_INT(Atividade, id_turma, "ID_Turma"),
+    COLUNA_TXT(Atividade, titulo, "Titulo"),
+    COLUNA_TXT(Atividade, descricao, "Descricao"),
+    COLUNA_TXT(Atividade, path_arquivo, "Arquivo"),
+};
+
+// Sem a coluna de senha
+static const ColunaExportada colunas_usuarios[] = {
+    COLUNA_INT(Usuario, id, "ID"),
+    COLUNA_TXT(Usuario, login, "Login"),
+    COLUNA_TXT(Usuario, tipo, "Tipo"),
+    COLUNA_INT(Usuario, ativo, "Ativo"),
+};
+
+// Estado de publicação de uma tabela no processo dono
+typedef struct {
+    const char *segmento;
+    const ColunaExportada *colunas;
+    int num_colunas;
+    int max_registros;
+    size_t tam_struct;
+    pthread_mutex_t trava;     // Serializa publicações da tabela
+    int descritor;
+    unsigned char *mapa;
+    size_t capacidade;
+} EstadoExportacao;
+
+#define ESTADO_EXPORTACAO(segmento, colunas, max, tipo) \
+    { segmento, colunas, (int)(sizeof(colunas) / sizeof(colunas[0])), max, sizeof(tipo), \
+      PTHREAD_MUTEX_INITIALIZER, -1, NULL, 0 }
+
+static EstadoExportacao estados[TOTAL_EXPORTACOES] = {
+    ESTADO_EXPORTACAO("/pim_alunos", colunas_alunos, MAX_ALUNOS, Aluno),
+    ESTADO_EXPORTACAO("/pim_turmas", colunas_turmas, MAX_TURMAS, Turma),
+    ESTADO_EXPORTACAO("/pim_matriculas", colunas_matriculas, MAX_MATRICULAS, AlunoTurma),
+    ESTADO_EXPORTACAO("/pim_aulas", colunas_aulas, MAX_AULAS, Aula),
+    ESTADO_EXPORTACAO("/pim_atividades", colunas_atividades, MAX_ATIVIDADES, Atividade),
+    ESTADO_EXPORTACAO("/pim_usuarios", colunas_usuarios, MAX_USUARIOS, Usuario),
+};
+
+static atomic_int exportacao_habilitada = 0;
+
+// ========== FUNÇÕES AUXILIARES PRIVADAS ==========
+
+// Pior caso: todos os registros com todos os textos no tamanho máximo
+static size_t capacidadeNecessaria(const EstadoExportacao *estado) {
+    size_t heap_por_registro = 0;
+
+    for (int c = 0; c < estado->num_colunas; c++) {
+        if (estado->colunas[c].tipo == COLUNA_TEXTO) {
+            heap_por_registro += estado->colunas[c].tamanho - 1;
+        }
+    }
+
+    return sizeof(CabecalhoExportacao) +
+           (size_t)estado->max_registros * (size_t)estado->num_colunas * sizeof(CampoExportado) +
+           (size_t)estado->max_registros * heap_por_registro;
+}
+
+#ifndef _WIN32
+
+// Cria/mapeia o segmento e grava a parte estática do cabeçalho
+static int abrirSegmento(EstadoExportacao *estado) {
+    CabecalhoExportacao *cabecalho;
+    size_t capacidade = capacidadeNecessaria(estado);
+    int descritor = shm_open(estado->segmento, O_CREAT | O_RDWR, 0644);
+
+    if (descritor < 0) {
+        printf("Aviso: não foi possível criar o segmento %s.\n", estado->segmento);
+        return 0;
+    }
+
+    // Um único processo dono por segmento
+    if (flock(descritor, LOCK_EX | LOCK_NB) != 0) {
+        printf("Aviso: o segmento %s já tem outro processo dono.\n", estado->segmento);
+        close(descritor);
+        return 0;
+    }
+
+    if (ftruncate(descritor, (off_t)capacidade) != 0) {
+        printf("Aviso: falha ao dimensionar o segmento %s.\n", estado->segmento);
+        close(descritor);
+        return 0;
+    }
+
+    estado->mapa = mmap(NULL, capacidade, PROT_READ | PROT_WRITE, MAP_SHARED, descritor, 0);
+    if (estado->mapa == MAP_FAILED) {
+        estado->mapa = NULL;
+        close(descritor);
+        return 0;
+    }
+    estado->descritor = descritor;
+    estado->capacidade = capacidade;
+
+    cabecalho = (CabecalhoExportacao *)estado->mapa;
+
+    // Segmento de um dono anterior: continua a sequência (par) para os leitores anexados
+    uint64_t sequencia = 0;
+    if (cabecalho->magica == EXPORTACAO_MAGICA && cabecalho->versao == EXPORTACAO_VERSAO) {
+        sequencia = (atomic_load(&cabecalho->sequencia) + 1) & ~(uint64_t)1;
+    }
+
+    atomic_store_explicit(&cabecalho->sequencia, sequencia + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    cabecalho->magica = EXPORTACAO_MAGICA;
+    cabecalho->versao = EXPORTACAO_VERSAO;
+    cabecalho->capacidade = capacidade;
+    cabecalho->num_colunas = (uint32_t)estado->num_colunas;
+    cabecalho->tam_registro = (uint32_t)(estado->num_colunas * sizeof(CampoExportado));
+    cabecalho->offset_registros = sizeof(CabecalhoExportacao);
+    cabecalho->offset_heap = sizeof(CabecalhoExportacao) +
+                             (uint64_t)estado->max_registros * cabecalho->tam_registro;
+    memset(cabecalho->colunas, 0, sizeof(cabecalho->colunas));
+    for (int c = 0; c < estado->num_colunas; c++) {
+        strncpy(cabecalho->colunas[c].nome, estado->colunas[c].nome,
+                sizeof(cabecalho->colunas[c].nome) - 1);
+        cabecalho->colunas[c].tipo = (uint32_t)estado->colunas[c].tipo;
+    }
+
+    atomic_store_explicit(&cabecalho->sequencia, sequencia + 2, memory_order_release);
+    return 1;
+}
+
+#endif
+
+// ========== PROCESSO DONO ==========
+
+int habilitarExportacao(void) {
+#ifdef _WIN32
+    printf("Aviso: exportação em memória compartilhada não suportada no Windows.\n");
+    return 0;
+#else
+    atomic_store(&exportacao_habilitada, 1);
+    return 1;
+#endif
+}
+
+int publicarExportacao(TabelaExportacao tabela, const void *registros, int total) {
+#ifdef _WIN32
+    (void)tabela; (void)registros; (void)total;
+    return 0;
+#else
+    EstadoExportacao *estado;
+    CabecalhoExportacao *cabecalho;
+    const unsigned char *origem = (const unsigned char *)registros;
+    uint64_t sequencia;
+    uint64_t usado_heap = 0;
+
+    if (!atomic_load(&exportacao_habilitada) || (unsigned)tabela >= TOTAL_EXPORTACOES) {
+        return 0;
+    }
+
+    estado = &estados[tabela];
+    pthread_mutex_lock(&estado->trava);
+
+    if (estado->mapa == NULL && !abrirSegmento(estado)) {
+        pthread_mutex_unlock(&estado->trava);
+        return 0;
+    }
+    if (total > estado->max_registros) {
+        total = estado->max_registros;
+    }
+
+    cabecalho = (CabecalhoExportacao *)estado->mapa;
+    CampoExportado *campos = (CampoExportado *)(estado->mapa + cabecalho->offset_registros);
+    char *heap = (char *)(estado->mapa + cabecalho->offset_heap);
+
+    // Seqlock: sequência ímpar enquanto registros e heap são reescritos
+    sequencia = atomic_load_explicit(&cabecalho->sequencia, memory_order_relaxed);
+    atomic_store_explicit(&cabecalho->sequencia, sequencia + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    for (int i = 0; i < total; i++) {
+        const unsigned char *registro = origem + (size_t)i * estado->tam_struct;
+
+        for (int c = 0; c < estado->num_colunas; c++) {
+            const ColunaExportada *coluna = &estado->colunas[c];
+            CampoExportado *campo = &campos[(size_t)i * estado->num_colunas + c];
+
+            if (coluna->tipo == COLUNA_INTEIRO) {
+                int valor;
+                memcpy(&valor, registro + coluna->offset, sizeof(int));
+                campo->inteiro = valor;
+            } else {
+                const char *texto = (const char *)(registro + coluna->offset);
+                size_t tamanho = strnlen(texto, coluna->tamanho - 1);
+                memcpy(heap + usado_heap, texto, tamanho);
+                campo->texto.offset = (uint32_t)usado_heap;
+                campo->texto.tamanho = (uint32_t)tamanho;
+                usado_heap += tamanho;
+            }
+        }
+    }
+
+    cabecalho->total_registros = (uint32_t)total;
+    cabecalho->tam_heap = usado_heap;
+    cabecalho->geracao++;
+
+    atomic_store_explicit(&cabecalho->sequencia, sequencia + 2, memory_order_release);
+
+    pthread_mutex_unlock(&estado->trava);
+    return 1;
+#endif
+}
+
+// Lista uma tabela em um buffer temporário e publica
+#define EXPORTAR_LISTAGEM(tabela, tipo, maximo, listar)         \
+    do {                                                        \
+        tipo *buffer = malloc(sizeof(tipo) * (maximo));         \
+        if (buffer != NULL) {                                   \
+            publicadas += publicarExportacao(tabela, buffer, listar(buffer, (maximo))); \
+            free(buffer);                                       \
+        }                                                       \
+    } while (0)
+
+int exportarTodasTabelas(void) {
+    int publicadas = 0;
+
+    if (!atomic_load(&exportacao_habilitada)) {
+        return 0;
+    }
+
+    EXPORTAR_LISTAGEM(EXPORTACAO_ALUNOS, Aluno, MAX_ALUNOS, listarAlunos);
+    EXPORTAR_LISTAGEM(EXPORTACAO_TURMAS, Turma, MAX_TURMAS, listarTurmas);
+    EXPORTAR_LISTAGEM(EXPORTACAO_MATRICULAS, AlunoTurma, MAX_MATRICULAS, listarMatriculas);
+    EXPORTAR_LISTAGEM(EXPORTACAO_AULAS, Aula, MAX_AULAS, listarTodasAulas);
+    EXPORTAR_LISTAGEM(EXPORTACAO_ATIVIDADES, Atividade, MAX_ATIVIDADES, listarAtividades);
+    EXPORTAR_LISTAGEM(EXPORTACAO_USUARIOS, Usuario, MAX_USUARIOS, listarUsuarios);
+
+    return publicadas;
+}
+
+void removerExportacoes(void) {
+    atomic_store(&exportacao_habilitada, 0);
+
+#ifndef _WIN32
+    for (int t = 0; t < TOTAL_EXPORTACOES; t++) {
+        EstadoExportacao *estado = &estados[t];
+
+        pthread_mutex_lock(&estado->trava);
+        if (estado->mapa != NULL) {
+            munmap(estado->mapa, estado->capacidade);
+            close(estado->descritor);
+            estado->mapa = NULL;
+            estado->descritor = -1;
+        }
+        shm_unlink(estado->segmento);
+        pthread_mutex_unlock(&estado->trava);
+    }
+#endif
+}
+
+// ========== LEITORES ==========
+
+int anexarExportacao(LeitorExportacao *leitor, TabelaExportacao tabela) {
+    leitor->descritor = -1;
+    leitor->mapa = NULL;
+    leitor->tamanho = 0;
+    leitor->tabela = tabela;
+
+#ifdef _WIN32
+    return 0;
+#else
+    struct stat info;
+    const CabecalhoExportacao *cabecalho;
+
+    if ((unsigned)tabela >= TOTAL_EXPORTACOES) {
+        return 0;
+    }
+
+    leitor->descritor = shm_open(estados[tabela].segmento, O_RDONLY, 0);
+    if (leitor->descritor < 0) {
+        return 0;
+    }
+
+    if (fstat(leitor->descritor, &info) != 0 || (size_t)info.st_size < sizeof(CabecalhoExportacao)) {
+        desanexarExportacao(leitor);
+        return 0;
+    }
+
+    leitor->mapa = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, leitor->descritor, 0);
+    if (leitor->mapa == MAP_FAILED) {
+        leitor->mapa = NULL;
+        desanexarExportacao(leitor);
+        return 0;
+    }
+    leitor->tamanho = (size_t)info.st_size;
+
+    cabecalho = (const CabecalhoExportacao *)leitor->mapa;
+    if (cabecalho->magica != EXPORTACAO_MAGICA || cabecalho->versao != EXPORTACAO_VERSAO ||
+        cabecalho->capacidade > leitor->tamanho) {
+        desanexarExportacao(leitor);
+        return 0;
+    }
+    return 1;
+#endif
+}
+
+void desanexarExportacao(LeitorExportacao *leitor) {
+#ifndef _WIN32
+    if (leitor->mapa != NULL) {
+        munmap((void *)leitor->mapa, leitor->tamanho);
+    }
+    if (leitor->descritor >= 0) {
+        close(leitor->descritor);
+    }
+#endif
+    leitor->mapa = NULL;
+    leitor->descritor = -1;
+    leitor->tamanho = 0;
+}
+
+const CabecalhoExportacao* cabecalhoExportacao(const LeitorExportacao *leitor) {
+    return (const CabecalhoExportacao *)leitor->mapa;
+}
+
+#ifndef _WIN32
+// O dono mantém o flock exclusivo do segmento enquanto vive (abrirSegmento):
+// se o leitor consegue a trava, ninguém vai terminar a publicação em curso
+static int donoAusente(const LeitorExportacao *leitor) {
+    if (flock(leitor->descritor, LOCK_SH | LOCK_NB) != 0) {
+        return 0;
+    }
+    flock(leitor->descritor, LOCK_UN);
+    return 1;
+}
+#endif
+
+uint64_t iniciarLeituraExportacao(const LeitorExportacao *leitor) {
+    CabecalhoExportacao *cabecalho = (CabecalhoExportacao *)leitor->mapa;
+    uint64_t sequencia;
+
+    // Publicação em curso: espera o dono terminar (ou desiste se ele morreu)
+    for (unsigned long espera = 1;
+         (sequencia = atomic_load_explicit(&cabecalho->sequencia, memory_order_acquire)) & 1; espera++) {
+#ifndef _WIN32
+        if (espera % EXPORTACAO_CONFERIR_DONO == 0 && donoAusente(leitor)) {
+            return atomic_load_explicit(&cabecalho->sequencia, memory_order_acquire);
+        }
+        sched_yield();
+#endif
+    }
+    return sequencia;
+}
+
+int validarLeituraExportacao(const LeitorExportacao *leitor, uint64_t sequencia) {
+    CabecalhoExportacao *cabecalho = (CabecalhoExportacao *)leitor->mapa;
+
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&cabecalho->sequencia, memory_order_relaxed) == sequencia;
+}
+
+const CampoExportado* registroExportado(const LeitorExportacao *leitor, int indice) {
+    const CabecalhoExportacao *cabecalho = cabecalhoExportacao(leitor);
+    return (const CampoExportado *)(leitor->mapa + cabecalho->offset_registros +
+                                    (size_t)indice * cabecalho->tam_registro);
+}
+
+const char* textoExportado(const LeitorExportacao *leitor, const CampoExportado *campo) {
+    const CabecalhoExportacao *cabecalho = cabecalhoExportacao(leitor);
+    return (const char *)(leitor->mapa + cabecalho->offset_heap + campo->texto.offset);
+}
+
+// Confere se o layout do segmento é o que esta versão do programa conhece
+static int layoutCompativel(const LeitorExportacao *leitor) {
+    const CabecalhoExportacao *cabecalho = cabecalhoExportacao(leitor);
+    const EstadoExportacao *estado = &estados[leitor->tabela];
+
+    if ((int)cabecalho->num_colunas != estado->num_colunas ||
+        cabecalho->tam_registro != estado->num_colunas * sizeof(CampoExportado)) {
+        return 0;
+    }
+    for (int c = 0; c < estado->num_colunas; c++) {
+        if ((int)cabecalho->colunas[c].tipo != estado->colunas[c].tipo ||
+            strncmp(cabecalho->colunas[c].nome, estado->colunas[c].nome,
+                    sizeof(cabecalho->colunas[c].nome)) != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int lerTabelaExportada(const LeitorExportacao *leitor, void *destino, int max,
+                       uint64_t *geracao) {
+    const CabecalhoExportacao *cabecalho = cabecalhoExportacao(leitor);
+    const EstadoExportacao *estado;
+    unsigned char *saida = (unsigned char *)destino;
+    uint64_t sequencia;
+    int total;
+
+    if (leitor->mapa == NULL) {
+        return -1;
+    }
+    estado = &estados[leitor->tabela];
+
+    for (;;) {
+        int corrompida = 0;
+
+        sequencia = iniciarLeituraExportacao(leitor);
+        if (sequencia & 1) {
+            return -1;                 // Dono morreu no meio de uma publicação
+        }
+        if (!layoutCompativel(leitor)) {
+            if (validarLeituraExportacao(leitor, sequencia)) {
+                return -1;
+            }
+            continue;
+        }
+
+        // Valores lidos durante uma publicação podem ser lixo: tudo é limitado
+        // ao mapeamento e a leitura é descartada se a sequência mudou
+        uint64_t limite_heap = leitor->tamanho - cabecalho->offset_heap;
+        uint64_t max_registros = (cabecalho->offset_heap - cabecalho->offset_registros) /
+                                 cabecalho->tam_registro;
+        total = (int)cabecalho->total_registros;
+        if ((uint64_t)total > max_registros) {
+            total = (int)max_registros;
+        }
+        if (total > max) {
+            total = max;
+        }
+
+        for (int i = 0; i < total && !corrompida; i++) {
+            const CampoExportado *campos = registroExportado(leitor, i);
+            unsigned char *registro = saida + (size_t)i * estado->tam_struct;
+
+            memset(registro, 0, estado->tam_struct);
+            for (int c = 0; c < estado->num_colunas; c++) {
+                const ColunaExportada *coluna = &estado->colunas[c];
+
+                if (coluna->tipo == COLUNA_INTEIRO) {
+                    int valor = (int)campos[c].inteiro;
+                    memcpy(registro + coluna->offset, &valor, sizeof(int));
+                    continue;
+                }
+
+                uint64_t offset = campos[c].texto.offset;
+                uint64_t tamanho = campos[c].texto.tamanho;
+                if (offset + tamanho > limite_heap) {
+                    corrompida = 1;
+                    break;
+                }
+                if (tamanho > coluna->tamanho - 1) {
+                    tamanho = coluna->tamanho - 1;
+                }
+                memcpy(registro + coluna->offset, textoExportado(leitor, &campos[c]), (size_t)tamanho);
+            }
+        }
+
+        if (geracao != NULL) {
+            *geracao = cabecalho->geracao;
+        }
+        if (validarLeituraExportacao(leitor, sequencia)) {
+            return corrompida ? -1 : total;
+        }
+    }
+}
@@ -0,0 +1,134 @@
+#ifndef EXPORTACAO_MANAGER_H
+#define EXPORTACAO_MANAGER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+// ========== EXPORTAÇÃO DE TABELAS EM MEMÓRIA COMPARTILHADA ==========
+//
+// Um processo dono (o que chama habilitarExportacao) publica cada tabela em um
+// segmento POSIX "/pim_<tabela>". Outros processos do mesmo host mapeiam o
+// segmento somente leitura: uma única cópia dos dados em RAM e anexação
+// instantânea, sem reler CSV.
+//
+// Layout do segmento (todos os offsets a partir do início):
+//   CabecalhoExportacao | registros de largura fixa | heap de textos
+// Cada registro tem num_colunas campos de 8 bytes: inteiros em int64 e textos
+// como (offset, tamanho) dentro do heap, sem '\0'.
+//
+// Consistência por seqlock: o dono torna "sequencia" ímpar antes de escrever e
+// par ao terminar. O leitor lê a sequência (par), copia o que precisa e
+// confere que ela não mudou; se mudou, repete a leitura.
+// Se o dono morre com a sequência ímpar, o leitor percebe (a trava de dono
+// do segmento ficou livre) e a leitura falha em vez de esperar para sempre.
+//
+// Senhas nunca são exportadas (a coluna não existe no segmento de usuários).
+
+#define EXPORTACAO_MAGICA 0x534D4950u      // "PIMS" em little-endian
+#define EXPORTACAO_VERSAO 1
+#define EXPORTACAO_MAX_COLUNAS 8
+
+#define EXPORTACAO_CONFERIR_DONO 1024   // Esperas entre as conferências do dono
+
+#define COLUNA_INTEIRO 1
+#define COLUNA_TEXTO 2
+
+// Tabelas exportáveis
+typedef enum {
+    EXPORTACAO_ALUNOS = 0,
+    EXPORTACAO_TURMAS,
+    EXPORTACAO_MATRICULAS,
+    EXPORTACAO_AULAS,
+    EXPORTACAO_ATIVIDADES,
+    EXPORTACAO_USUARIOS,
+    TOTAL_EXPORTACOES
+} TabelaExportacao;
+
+// Descrição de uma coluna gravada no cabeçalho (legível por qualquer linguagem)
+typedef struct {
+    char nome[24];
+    uint32_t tipo;             // COLUNA_INTEIRO ou COLUNA_TEXTO
+    uint32_t reservado;
+} ColunaCabecalho;
+
+// Cabeçalho versionado no início do segmento
+typedef struct {
+    uint32_t magica;           // EXPORTACAO_MAGICA
+    uint32_t versao;           // EXPORTACAO_VERSAO
+    _Atomic uint64_t sequencia; // Seqlock: ímpar durante a publicação
+    uint64_t geracao;          // Publicações concluídas
+    uint64_t capacidade;       // Tamanho total do segmento
+    uint32_t total_registros;
+    uint32_t num_colunas;
+    uint32_t tam_registro;     // num_colunas * sizeof(CampoExportado)
+    uint32_t reservado;
+    uint64_t offset_registros;
+    uint64_t offset_heap;
+    uint64_t tam_heap;         // Bytes usados no heap
+    ColunaCabecalho colunas[EXPORTACAO_MAX_COLUNAS];
+} CabecalhoExportacao;
+
+// Campo de largura fixa de um registro exportado
+typedef union {
+    int64_t inteiro;
+    struct {
+        uint32_t offset;       // Relativo a offset_heap
+        uint32_t tamanho;
+    } texto;
+} CampoExportado;
+
+// Segmento anexado por um leitor
+typedef struct {
+    int descritor;
+    const unsigned char *mapa;
+    size_t tamanho;
+    TabelaExportacao tabela;
+} LeitorExportacao;
+
+// ========== PROCESSO DONO ==========
+
+// Função para tornar este processo o dono das exportações
+// A partir daqui toda carga/gravação de tabela republica o segmento.
+// Retorna: 1 se habilitado, 0 se não suportado nesta plataforma
+int habilitarExportacao(void);
+
+// Função para publicar agora todas as tabelas (carregando as que faltarem)
+// Retorna: quantidade de tabelas publicadas
+int exportarTodasTabelas(void);
+
+// Função chamada pelos módulos após carregar/gravar a tabela
+// Não faz nada se a exportação não estiver habilitada.
+// Retorna: 1 se publicou, 0 caso contrário
+int publicarExportacao(TabelaExportacao tabela, const void *registros, int total);
+
+// Função para desabilitar a exportação e remover os segmentos publicados
+void removerExportacoes(void);
+
+// ========== LEITORES (OUTROS PROCESSOS) ==========
+
+// Função para mapear somente leitura o segmento de uma tabela
+// Retorna: 1 se anexado e com cabeçalho válido, 0 caso contrário
+int anexarExportacao(LeitorExportacao *leitor, TabelaExportacao tabela);
+
+// Função para desfazer o mapeamento
+void desanexarExportacao(LeitorExportacao *leitor);
+
+// Acesso sem cópia: iniciarLeituraExportacao devolve a sequência (espera se
+// houver publicação em curso; ímpar se o dono morreu no meio dela e não há o
+// que ler); depois de ler, validarLeituraExportacao diz se os dados lidos são
+// consistentes (0 = repetir a leitura).
+const CabecalhoExportacao* cabecalhoExportacao(const LeitorExportacao *leitor);
+uint64_t iniciarLeituraExportacao(const LeitorExportacao *leitor);
+int validarLeituraExportacao(const LeitorExportacao *leitor, uint64_t sequencia);
+const CampoExportado* registroExportado(const LeitorExportacao *leitor, int indice);
+const char* textoExportado(const LeitorExportacao *leitor, const CampoExportado *campo);
+
+// Função para decodificar a tabela nas structs do sistema (Aluno, Turma, ...)
+// Repete a cópia até obter uma versão consistente.
+// Retorna: registros copiados (-1 se o segmento é incompatível ou se o dono
+//          morreu no meio de uma publicação)
+int lerTabelaExportada(const LeitorExportacao *leitor, void *destino, int max,
+                       uint64_t *geracao);
+
+#endif
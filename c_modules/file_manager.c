@@ -2,24 +2,14 @@
 #include <stdlib.h>
 #include <string.h>
 #include "file_manager.h"
+#include "tabela_manager.h"
 
-// ========== SALVAR DADOS ==========
-int salvarDados(const char *nome_arquivo, void *dados, int num_registros, int tipo) {
-    FILE *arquivo;
+// ========== ESCREVER REGISTROS ==========
+// Formata o cabeçalho e as linhas CSV no stream informado
+// Retorna: 1 se sucesso, 0 se o tipo é desconhecido
+static int escreverRegistros(FILE *arquivo, void *dados, int num_registros, int tipo) {
     int i;
     
-    // Estrutura de decisão (requisito obrigatório)
-    if (dados == NULL || num_registros <= 0) {
-        printf("Erro: dados inválidos para salvar.\n");
-        return 0;
-    }
-    
-    arquivo = fopen(nome_arquivo, "w");
-    if (arquivo == NULL) {
-        printf("Erro ao abrir arquivo %s para escrita.\n", nome_arquivo);
-        return 0;
-    }
-    
     // Estrutura de decisão switch (requisito obrigatório)
     switch (tipo) {
         case TIPO_ALUNO: {
@@ -83,15 +73,83 @@ int salvarDados(const char *nome_arquivo, void *dados, int num_registros, int ti
         
         default:
             printf("Erro: tipo de dado desconhecido.\n");
-            fclose(arquivo);
             return 0;
     }
     
-    fclose(arquivo);
+    return 1;
+}
+
+// ========== SALVAR DADOS ==========
+int salvarDados(const char *nome_arquivo, void *dados, int num_registros, int tipo) {
+    FILE *arquivo;
+    
+    // Estrutura de decisão (requisito obrigatório)
+    // Zero registros é válido: grava apenas o cabeçalho (ex.: exclusão do último registro)
+    if (dados == NULL || num_registros < 0) {
+        printf("Erro: dados inválidos para salvar.\n");
+        return 0;
+    }
+    
+    // Grava em "<arquivo>.tmp" e substitui por rename: leitores nunca veem meio arquivo
+    arquivo = abrirEscritaAtomica(nome_arquivo);
+    if (arquivo == NULL) {
+        printf("Erro ao abrir arquivo %s para escrita.\n", nome_arquivo);
+        return 0;
+    }
+    
+    if (!escreverRegistros(arquivo, dados, num_registros, tipo)) {
+        abandonarEscritaAtomica(arquivo, nome_arquivo);
+        return 0;
+    }
+    
+    if (!concluirEscritaAtomica(arquivo, nome_arquivo)) {
+        printf("Erro ao gravar arquivo %s.\n", nome_arquivo);
+        return 0;
+    }
     printf("Dados salvos com sucesso em %s\n", nome_arquivo);
     return 1;
 }
 
+// ========== SERIALIZAR DADOS ==========
+char* serializarDados(void *dados, int num_registros, int tipo, size_t *tamanho) {
+    char *conteudo = NULL;
+    FILE *memoria;
+    int ok;
+    
+    if (dados == NULL || num_registros < 0) {
+        return NULL;
+    }
+    
+#ifdef _WIN32
+    // Sem open_memstream: formata em arquivo temporário e lê de volta
+    long fim;
+    memoria = tmpfile();
+    if (memoria == NULL) {
+        return NULL;
+    }
+    ok = escreverRegistros(memoria, dados, num_registros, tipo);
+    fim = ftell(memoria);
+    if (ok && fim >= 0 && (conteudo = malloc((size_t)fim + 1)) != NULL) {
+        rewind(memoria);
+        *tamanho = fread(conteudo, 1, (size_t)fim, memoria);
+        conteudo[*tamanho] = '\0';
+    }
+    fclose(memoria);
+    return conteudo;
+#else
+    memoria = open_memstream(&conteudo, tamanho);
+    if (memoria == NULL) {
+        return NULL;
+    }
+    ok = escreverRegistros(memoria, dados, num_registros, tipo);
+    if (fclose(memoria) != 0 || !ok) {
+        free(conteudo);
+        return NULL;
+    }
+    return conteudo;
+#endif
+}
+
 // ========== CARREGAR DADOS ==========
 int carregarDados(const char *nome_arquivo, void *destino, int max_registros, int tipo) {
     FILE *arquivo;
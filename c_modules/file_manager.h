@@ -1,12 +1,20 @@
 #ifndef FILE_MANAGER_H
 #define FILE_MANAGER_H
 
+#include <stddef.h>
 #include "structs.h"
 
 // Função para salvar dados em arquivo CSV
+// A gravação é atômica (temporário + rename); a trava entre processos fica a
+// cargo do chamador (abrirEscritaTabela em tabela_manager.h)
 // Retorna: 1 se sucesso, 0 se erro
 int salvarDados(const char *nome_arquivo, void *dados, int num_registros, int tipo);
 
+// Função para gerar em memória o mesmo conteúdo CSV que salvarDados gravaria
+// Usada pela persistência assíncrona (persistencia_manager.h)
+// Retorna: buffer alocado com malloc (o chamador libera) ou NULL se erro
+char* serializarDados(void *dados, int num_registros, int tipo, size_t *tamanho);
+
 // Função para carregar dados de arquivo CSV
 // Retorna: número de registros lidos, -1 se erro
 int carregarDados(const char *nome_arquivo, void *destino, int max_registros, int tipo);
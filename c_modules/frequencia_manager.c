@@ -0,0 +1,871 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <pthread.h>
+#include "frequencia_manager.h"
+#include "turma_manager.h"
+#include "aula_manager.h"
+#include "tabela_manager.h"
+
+#define LIMITE_OBSOLETOS 64            // Folga antes de compactar o arquivo
+
+// ========== ESTRUTURAS INTERNAS ==========
+
+// Tabela int -> índice com endereçamento aberto (valor -1 = posição livre)
+typedef struct {
+    int *chaves;
+    int *valores;
+    int capacidade;            // Potência de 2
+    int usados;
+} MapaInteiros;
+
+typedef struct {
+    int id_turma;
+    int *ras;                  // Ordem da lista de chamada
+    int total;
+    int capacidade;
+    MapaInteiros posicoes;     // RA -> posição
+} ListaChamada;
+
+typedef struct {
+    int id_aula;
+    int id_turma;
+    int bits;                  // Tamanho da lista quando a chamada foi feita
+    uint64_t *matriculados;    // palavras(bits) + presentes logo em seguida
+} Chamada;
+
+static struct {
+    char arquivo[MAX_PATH];
+    int carregado;
+    long long geracao;         // Geração do arquivo de trava na última carga
+    long lido;                 // Bytes válidos já aplicados
+    long tamanho;              // Tamanho do arquivo na última leitura
+    ListaChamada *listas;
+    int total_listas;
+    int capacidade_listas;
+    MapaInteiros indice_listas;    // id_turma -> lista
+    Chamada *chamadas;
+    int total_chamadas;
+    int capacidade_chamadas;
+    MapaInteiros indice_chamadas;  // id_aula -> chamada
+    long obsoletos;            // Registros do arquivo que não valem mais
+} estado = { .arquivo = ARQUIVO_FREQUENCIA };
+
+static pthread_mutex_t trava_frequencia = PTHREAD_MUTEX_INITIALIZER;
+static TravaArquivo trava_arquivo = TRAVA_ARQUIVO_INIT;
+
+// ========== FUNÇÕES AUXILIARES PRIVADAS ==========
+
+static int contarBits(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// Posição do bit ligado mais baixo (x != 0)
+static int menorBit(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int posicao = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        posicao++;
+    }
+    return posicao;
+#endif
+}
+
+static int palavras(int bits) {
+    return (bits + 63) / 64;
+}
+
+static int testarBit(const uint64_t *bitset, int posicao) {
+    return (int)((bitset[posicao / 64] >> (posicao % 64)) & 1u);
+}
+
+static uint32_t espalhar(uint32_t x) {
+    x *= 0x9E3779B1u;
+    return x ^ (x >> 15);
+}
+
+static uint32_t fnv1a(const unsigned char *dados, size_t tamanho) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < tamanho; i++) {
+        h = (h ^ dados[i]) * 16777619u;
+    }
+    return h;
+}
+
+// ---------- Mapa de inteiros ----------
+
+static int mapaBuscar(const MapaInteiros *mapa, int chave) {
+    if (mapa->capacidade == 0) {
+        return -1;
+    }
+    uint32_t i = espalhar((uint32_t)chave) & (uint32_t)(mapa->capacidade - 1);
+    while (mapa->valores[i] >= 0) {
+        if (mapa->chaves[i] == chave) {
+            return mapa->valores[i];
+        }
+        i = (i + 1) & (uint32_t)(mapa->capacidade - 1);
+    }
+    return -1;
+}
+
+static void mapaLiberar(MapaInteiros *mapa) {
+    free(mapa->chaves);
+    free(mapa->valores);
+    memset(mapa, 0, sizeof(*mapa));
+}
+
+static int mapaInserir(MapaInteiros *mapa, int chave, int valor);
+
+// Dobra a capacidade e reinsere (ocupação máxima de 1/2)
+static int mapaCrescer(MapaInteiros *mapa) {
+    MapaInteiros novo;
+    novo.capacidade = mapa->capacidade ? mapa->capacidade * 2 : 16;
+    novo.usados = 0;
+    novo.chaves = malloc(sizeof(int) * (size_t)novo.capacidade);
+    novo.valores = malloc(sizeof(int) * (size_t)novo.capacidade);
+    if (novo.chaves == NULL || novo.valores == NULL) {
+        free(novo.chaves);
+        free(novo.valores);
+        return 0;
+    }
+    memset(novo.valores, 0xFF, sizeof(int) * (size_t)novo.capacidade);
+
+    for (int i = 0; i < mapa->capacidade; i++) {
+        if (mapa->valores[i] >= 0) {
+            mapaInserir(&novo, mapa->chaves[i], mapa->valores[i]);
+        }
+    }
+    mapaLiberar(mapa);
+    *mapa = novo;
+    return 1;
+}
+
+static int mapaInserir(MapaInteiros *mapa, int chave, int valor) {
+    if ((mapa->usados + 1) * 2 > mapa->capacidade && !mapaCrescer(mapa)) {
+        return 0;
+    }
+    uint32_t i = espalhar((uint32_t)chave) & (uint32_t)(mapa->capacidade - 1);
+    while (mapa->valores[i] >= 0 && mapa->chaves[i] != chave) {
+        i = (i + 1) & (uint32_t)(mapa->capacidade - 1);
+    }
+    if (mapa->valores[i] < 0) {
+        mapa->usados++;
+    }
+    mapa->chaves[i] = chave;
+    mapa->valores[i] = valor;
+    return 1;
+}
+
+// ---------- Estado em memória ----------
+
+static void limparEstado(void) {
+    for (int i = 0; i < estado.total_listas; i++) {
+        free(estado.listas[i].ras);
+        mapaLiberar(&estado.listas[i].posicoes);
+    }
+    for (int i = 0; i < estado.total_chamadas; i++) {
+        free(estado.chamadas[i].matriculados);
+    }
+    free(estado.listas);
+    free(estado.chamadas);
+    mapaLiberar(&estado.indice_listas);
+    mapaLiberar(&estado.indice_chamadas);
+
+    estado.listas = NULL;
+    estado.chamadas = NULL;
+    estado.total_listas = estado.capacidade_listas = 0;
+    estado.total_chamadas = estado.capacidade_chamadas = 0;
+    estado.carregado = 0;
+    estado.lido = 0;
+    estado.tamanho = 0;
+    estado.obsoletos = 0;
+}
+
+static ListaChamada* listaDaTurma(int id_turma, int criar) {
+    int indice = mapaBuscar(&estado.indice_listas, id_turma);
+    if (indice >= 0) {
+        return &estado.listas[indice];
+    }
+    if (!criar) {
+        return NULL;
+    }
+
+    if (estado.total_listas == estado.capacidade_listas) {
+        int capacidade = estado.capacidade_listas ? estado.capacidade_listas * 2 : 16;
+        ListaChamada *novas = realloc(estado.listas, sizeof(ListaChamada) * (size_t)capacidade);
+        if (novas == NULL) {
+            return NULL;
+        }
+        estado.listas = novas;
+        estado.capacidade_listas = capacidade;
+    }
+    if (!mapaInserir(&estado.indice_listas, id_turma, estado.total_listas)) {
+        return NULL;
+    }
+
+    ListaChamada *lista = &estado.listas[estado.total_listas++];
+    memset(lista, 0, sizeof(*lista));
+    lista->id_turma = id_turma;
+    return lista;
+}
+
+static int acrescentarNaLista(ListaChamada *lista, int ra) {
+    if (mapaBuscar(&lista->posicoes, ra) >= 0) {
+        return 1;
+    }
+    if (lista->total == lista->capacidade) {
+        int capacidade = lista->capacidade ? lista->capacidade * 2 : 32;
+        int *ras = realloc(lista->ras, sizeof(int) * (size_t)capacidade);
+        if (ras == NULL) {
+            return 0;
+        }
+        lista->ras = ras;
+        lista->capacidade = capacidade;
+    }
+    if (!mapaInserir(&lista->posicoes, ra, lista->total)) {
+        return 0;
+    }
+    lista->ras[lista->total++] = ra;
+    return 1;
+}
+
+static Chamada* chamadaDaAula(int id_aula) {
+    int indice = mapaBuscar(&estado.indice_chamadas, id_aula);
+    return (indice >= 0) ? &estado.chamadas[indice] : NULL;
+}
+
+static uint64_t* presentesDa(const Chamada *chamada) {
+    return chamada->matriculados + palavras(chamada->bits);
+}
+
+static void reconstruirIndiceChamadas(void) {
+    mapaLiberar(&estado.indice_chamadas);
+    for (int i = 0; i < estado.total_chamadas; i++) {
+        mapaInserir(&estado.indice_chamadas, estado.chamadas[i].id_aula, i);
+    }
+}
+
+// Aplica um registro já validado (da leitura do arquivo ou recém-gravado)
+static int aplicarRegistro(const RegistroFrequencia *registro, const unsigned char *carga) {
+    if (registro->tipo == FREQ_REG_LISTA) {
+        ListaChamada *lista = listaDaTurma(registro->id_turma, 1);
+        if (lista == NULL) {
+            return 0;
+        }
+        for (uint32_t i = 0; i < registro->quantidade; i++) {
+            int32_t ra;
+            memcpy(&ra, carga + i * sizeof(int32_t), sizeof(ra));
+            if (!acrescentarNaLista(lista, ra)) {
+                return 0;
+            }
+        }
+        return 1;
+    }
+
+    if (registro->tipo == FREQ_REG_CHAMADA) {
+        size_t bytes = sizeof(uint64_t) * 2 * (size_t)palavras((int)registro->quantidade);
+        uint64_t *bits = malloc(bytes ? bytes : 1);
+        if (bits == NULL) {
+            return 0;
+        }
+        memcpy(bits, carga, bytes);
+
+        Chamada *chamada = chamadaDaAula(registro->id_aula);
+        if (chamada != NULL) {
+            free(chamada->matriculados);
+            estado.obsoletos++;
+        } else {
+            if (estado.total_chamadas == estado.capacidade_chamadas) {
+                int capacidade = estado.capacidade_chamadas ? estado.capacidade_chamadas * 2 : 64;
+                Chamada *novas = realloc(estado.chamadas, sizeof(Chamada) * (size_t)capacidade);
+                if (novas == NULL) {
+                    free(bits);
+                    return 0;
+                }
+                estado.chamadas = novas;
+                estado.capacidade_chamadas = capacidade;
+            }
+            if (!mapaInserir(&estado.indice_chamadas, registro->id_aula, estado.total_chamadas)) {
+                free(bits);
+                return 0;
+            }
+            chamada = &estado.chamadas[estado.total_chamadas++];
+        }
+        chamada->id_aula = registro->id_aula;
+        chamada->id_turma = registro->id_turma;
+        chamada->bits = (int)registro->quantidade;
+        chamada->matriculados = bits;
+        return 1;
+    }
+
+    if (registro->tipo == FREQ_REG_EXCLUSAO) {
+        int indice = mapaBuscar(&estado.indice_chamadas, registro->id_aula);
+        if (indice >= 0) {
+            free(estado.chamadas[indice].matriculados);
+            estado.chamadas[indice] = estado.chamadas[--estado.total_chamadas];
+            reconstruirIndiceChamadas();
+            estado.obsoletos += 2;     // A chamada e a própria exclusão
+        }
+        return 1;
+    }
+
+    return 1; // Tipo desconhecido de versão futura: ignorado
+}
+
+// Confere se o tamanho da carga bate com o tipo do registro
+static int cargaCompativel(const RegistroFrequencia *registro) {
+    size_t carga = registro->tamanho - sizeof(RegistroFrequencia);
+
+    switch (registro->tipo) {
+        case FREQ_REG_LISTA:
+            return carga == sizeof(int32_t) * (size_t)registro->quantidade;
+        case FREQ_REG_CHAMADA:
+            return registro->quantidade <= (uint32_t)MAX_MATRICULAS * 64 &&
+                   carga == sizeof(uint64_t) * 2 * (size_t)palavras((int)registro->quantidade);
+        default:
+            return 1;
+    }
+}
+
+// Valida e aplica os registros de um trecho do arquivo
+// Retorna: bytes consumidos (param no primeiro registro inválido)
+static long aplicarTrecho(const unsigned char *dados, long tamanho) {
+    const size_t apos_verificacao = offsetof(RegistroFrequencia, tipo);
+    long posicao = 0;
+
+    while (tamanho - posicao >= (long)sizeof(RegistroFrequencia)) {
+        RegistroFrequencia registro;
+        memcpy(&registro, dados + posicao, sizeof(registro));
+
+        if (registro.tamanho < sizeof(registro) || (long)registro.tamanho > tamanho - posicao) {
+            break;
+        }
+        if (fnv1a(dados + posicao + apos_verificacao, registro.tamanho - apos_verificacao) !=
+            registro.verificacao || !cargaCompativel(&registro)) {
+            break;
+        }
+        if (!aplicarRegistro(&registro, dados + posicao + sizeof(registro))) {
+            break;
+        }
+        posicao += (long)registro.tamanho;
+    }
+    return posicao;
+}
+
+// Lê do arquivo o que ainda não foi aplicado (tudo, na primeira vez)
+static void lerAcrescimos(void) {
+    FILE *arquivo = fopen(estado.arquivo, "rb");
+    if (arquivo == NULL) {
+        estado.tamanho = 0;
+        return;
+    }
+
+    fseek(arquivo, 0, SEEK_END);
+    long tamanho = ftell(arquivo);
+    if (tamanho < estado.lido) {
+        // Encolheu sem mudar a geração (regravado por fora): recomeça
+        limparEstado();
+        estado.carregado = 1;
+    }
+    estado.tamanho = tamanho;
+
+    long inicio = estado.lido;
+    if (inicio == 0) {
+        CabecalhoFrequencia cabecalho;
+        fseek(arquivo, 0, SEEK_SET);
+        if (fread(&cabecalho, sizeof(cabecalho), 1, arquivo) != 1 ||
+            cabecalho.magica != FREQUENCIA_MAGICA || cabecalho.versao != FREQUENCIA_VERSAO) {
+            if (tamanho > 0) {
+                printf("Aviso: %s nao e um arquivo de frequencia valido.\n", estado.arquivo);
+            }
+            fclose(arquivo);
+            return;
+        }
+        inicio = (long)sizeof(cabecalho);
+        estado.lido = inicio;
+    }
+
+    if (tamanho > inicio) {
+        unsigned char *dados = malloc((size_t)(tamanho - inicio));
+        if (dados != NULL) {
+            fseek(arquivo, inicio, SEEK_SET);
+            long lidos = (long)fread(dados, 1, (size_t)(tamanho - inicio), arquivo);
+            estado.lido = inicio + aplicarTrecho(dados, lidos);
+            free(dados);
+        }
+    }
+    fclose(arquivo);
+}
+
+// Obtém a trava do arquivo e alcança o que outros processos gravaram
+// (exige trava_frequencia)
+static int abrirFrequencia(int modo) {
+    if (!travarArquivo(&trava_arquivo, estado.arquivo, modo)) {
+        return 0;
+    }
+
+    long long geracao = lerGeracaoArquivo(&trava_arquivo);
+    if (!estado.carregado || geracao != estado.geracao) {
+        limparEstado();
+        estado.carregado = 1;
+        estado.geracao = geracao;
+    }
+    lerAcrescimos();
+    return 1;
+}
+
+static void fecharFrequencia(void) {
+    destravarArquivo(&trava_arquivo);
+}
+
+static int gravarCabecalho(FILE *arquivo) {
+    CabecalhoFrequencia cabecalho = {FREQUENCIA_MAGICA, FREQUENCIA_VERSAO};
+    return fwrite(&cabecalho, sizeof(cabecalho), 1, arquivo) == 1;
+}
+
+// Monta o registro (cabeçalho + carga) em um bloco pronto para gravar
+static unsigned char* montarRegistro(int tipo, int id_turma, int id_aula, uint32_t quantidade,
+                                     const void *carga, size_t tamanho_carga, size_t *tamanho) {
+    RegistroFrequencia registro;
+    const size_t apos_verificacao = offsetof(RegistroFrequencia, tipo);
+
+    *tamanho = sizeof(registro) + tamanho_carga;
+    unsigned char *bloco = malloc(*tamanho);
+    if (bloco == NULL) {
+        return NULL;
+    }
+
+    memset(&registro, 0, sizeof(registro));
+    registro.tamanho = (uint32_t)*tamanho;
+    registro.tipo = (uint8_t)tipo;
+    registro.id_turma = id_turma;
+    registro.id_aula = id_aula;
+    registro.quantidade = quantidade;
+    memcpy(bloco, &registro, sizeof(registro));
+    if (tamanho_carga > 0) {
+        memcpy(bloco + sizeof(registro), carga, tamanho_carga);
+    }
+
+    registro.verificacao = fnv1a(bloco + apos_verificacao, *tamanho - apos_verificacao);
+    memcpy(bloco, &registro, sizeof(registro));
+    return bloco;
+}
+
+static int regravarArquivo(void);
+
+// Acrescenta o registro ao arquivo e aplica em memória (exige trava exclusiva)
+static int gravarRegistro(int tipo, int id_turma, int id_aula, uint32_t quantidade,
+                          const void *carga, size_t tamanho_carga) {
+    size_t tamanho;
+    unsigned char *bloco = montarRegistro(tipo, id_turma, id_aula, quantidade, carga, tamanho_carga, &tamanho);
+    if (bloco == NULL) {
+        return 0;
+    }
+
+    // Sobra de uma gravação interrompida no fim do arquivo: regrava antes
+    if (estado.tamanho != estado.lido && !regravarArquivo()) {
+        free(bloco);
+        return 0;
+    }
+
+    FILE *arquivo = fopen(estado.arquivo, "ab");
+    int ok = (arquivo != NULL);
+    if (ok && estado.lido == 0) {
+        ok = gravarCabecalho(arquivo);
+        estado.lido = (long)sizeof(CabecalhoFrequencia);
+    }
+    ok = ok && fwrite(bloco, 1, tamanho, arquivo) == tamanho;
+    if (arquivo != NULL && fclose(arquivo) != 0) {
+        ok = 0;
+    }
+    if (!ok) {
+        printf("Erro ao gravar %s.\n", estado.arquivo);
+        free(bloco);
+        estado.carregado = 0; // Releitura completa na próxima operação
+        return 0;
+    }
+
+    RegistroFrequencia registro;
+    memcpy(&registro, bloco, sizeof(registro));
+    ok = aplicarRegistro(&registro, bloco + sizeof(registro));
+    estado.lido += (long)tamanho;
+    estado.tamanho = estado.lido;
+    free(bloco);
+
+    if (estado.obsoletos > estado.total_chamadas + LIMITE_OBSOLETOS) {
+        regravarArquivo();
+    }
+    return ok;
+}
+
+// Regrava o arquivo só com o estado vivo (exige trava exclusiva)
+static int regravarArquivo(void) {
+    FILE *arquivo = abrirEscritaAtomica(estado.arquivo);
+    if (arquivo == NULL) {
+        return 0;
+    }
+
+    int ok = gravarCabecalho(arquivo);
+    long tamanho_total = (long)sizeof(CabecalhoFrequencia);
+
+    for (int i = 0; ok && i < estado.total_listas; i++) {
+        const ListaChamada *lista = &estado.listas[i];
+        size_t tamanho;
+        int32_t *ras = malloc(sizeof(int32_t) * (size_t)(lista->total ? lista->total : 1));
+        if (ras == NULL) {
+            ok = 0;
+            break;
+        }
+        for (int j = 0; j < lista->total; j++) {
+            ras[j] = lista->ras[j];
+        }
+        unsigned char *bloco = montarRegistro(FREQ_REG_LISTA, lista->id_turma, 0, (uint32_t)lista->total, ras,
+                                              sizeof(int32_t) * (size_t)lista->total, &tamanho);
+        ok = bloco != NULL && fwrite(bloco, 1, tamanho, arquivo) == tamanho;
+        tamanho_total += (long)tamanho;
+        free(bloco);
+        free(ras);
+    }
+    for (int i = 0; ok && i < estado.total_chamadas; i++) {
+        const Chamada *chamada = &estado.chamadas[i];
+        size_t tamanho;
+        unsigned char *bloco = montarRegistro(FREQ_REG_CHAMADA, chamada->id_turma, chamada->id_aula,
+                                              (uint32_t)chamada->bits, chamada->matriculados,
+                                              sizeof(uint64_t) * 2 * (size_t)palavras(chamada->bits), &tamanho);
+        ok = bloco != NULL && fwrite(bloco, 1, tamanho, arquivo) == tamanho;
+        tamanho_total += (long)tamanho;
+        free(bloco);
+    }
+
+    if (!ok) {
+        abandonarEscritaAtomica(arquivo, estado.arquivo);
+        return 0;
+    }
+    if (!concluirEscritaAtomica(arquivo, estado.arquivo)) {
+        return 0;
+    }
+
+    // Outros processos recarregam do zero
+    incrementarGeracaoArquivo(&trava_arquivo);
+    estado.geracao = lerGeracaoArquivo(&trava_arquivo);
+    estado.lido = tamanho_total;
+    estado.tamanho = tamanho_total;
+    estado.obsoletos = 0;
+    return 1;
+}
+
+// Grava a chamada com os bitsets informados (exige trava exclusiva)
+static int gravarChamada(int id_aula, int id_turma, int bits, const uint64_t *bitsets) {
+    return gravarRegistro(FREQ_REG_CHAMADA, id_turma, id_aula, (uint32_t)bits, bitsets,
+                          sizeof(uint64_t) * 2 * (size_t)palavras(bits));
+}
+
+// ========== IMPLEMENTAÇÃO DAS FUNÇÕES PÚBLICAS ==========
+
+void usarArquivoFrequencia(const char *arquivo) {
+    pthread_mutex_lock(&trava_frequencia);
+
+    limparEstado();
+    snprintf(estado.arquivo, sizeof(estado.arquivo), "%s", arquivo ? arquivo : ARQUIVO_FREQUENCIA);
+    trava_arquivo.pid = 0; // A próxima trava reabre "<arquivo>.lock" do novo caminho
+
+    pthread_mutex_unlock(&trava_frequencia);
+}
+
+int registrarChamada(int id_aula, const int *ausentes, int total_ausentes) {
+    Aula aula;
+    int resultado = -1;
+
+    if (!obterAulaPorID(id_aula, &aula)) {
+        printf("Erro: aula %d não encontrada.\n", id_aula);
+        return -1;
+    }
+
+    // Lista atual da turma (fora da trava da frequência)
+    int *ras = malloc(sizeof(int) * MAX_MATRICULAS);
+    if (ras == NULL) {
+        return -1;
+    }
+    int matriculados = listarAlunosDaTurma(aula.id_turma, ras, MAX_MATRICULAS);
+
+    pthread_mutex_lock(&trava_frequencia);
+    if (!abrirFrequencia(TRAVA_EXCLUSIVA)) {
+        pthread_mutex_unlock(&trava_frequencia);
+        free(ras);
+        return -1;
+    }
+
+    // 1. Matriculados que ainda não estão na lista de chamada entram no fim
+    ListaChamada *lista = listaDaTurma(aula.id_turma, 0);
+    int32_t *novos = malloc(sizeof(int32_t) * (size_t)(matriculados ? matriculados : 1));
+    int total_novos = 0;
+    if (novos != NULL) {
+        for (int i = 0; i < matriculados; i++) {
+            if (lista == NULL || mapaBuscar(&lista->posicoes, ras[i]) < 0) {
+                novos[total_novos++] = ras[i];
+            }
+        }
+    }
+    int ok = novos != NULL &&
+             (total_novos == 0 || gravarRegistro(FREQ_REG_LISTA, aula.id_turma, 0, (uint32_t)total_novos, novos,
+                                                 sizeof(int32_t) * (size_t)total_novos));
+    free(novos);
+    lista = listaDaTurma(aula.id_turma, 0);
+
+    // 2. Todos os matriculados presentes, menos os ausentes
+    uint64_t *bitsets = NULL;
+    int bits = lista ? lista->total : 0;
+    if (ok) {
+        bitsets = calloc((size_t)palavras(bits) * 2 + 1, sizeof(uint64_t));
+        ok = (bitsets != NULL);
+    }
+    if (ok) {
+        uint64_t *presentes = bitsets + palavras(bits);
+        for (int i = 0; i < matriculados; i++) {
+            int posicao = mapaBuscar(&lista->posicoes, ras[i]);
+            bitsets[posicao / 64] |= 1ULL << (posicao % 64);
+        }
+        memcpy(presentes, bitsets, sizeof(uint64_t) * (size_t)palavras(bits));
+
+        for (int i = 0; i < total_ausentes && ok; i++) {
+            int posicao = lista ? mapaBuscar(&lista->posicoes, ausentes[i]) : -1;
+            if (posicao < 0 || !testarBit(bitsets, posicao)) {
+                printf("Erro: RA %d não está matriculado na turma %d.\n", ausentes[i], aula.id_turma);
+                ok = 0;
+                break;
+            }
+            presentes[posicao / 64] &= ~(1ULL << (posicao % 64));
+        }
+    }
+    if (ok && gravarChamada(id_aula, aula.id_turma, bits, bitsets)) {
+        resultado = matriculados;
+    }
+
+    fecharFrequencia();
+    pthread_mutex_unlock(&trava_frequencia);
+    free(bitsets);
+    free(ras);
+    return resultado;
+}
+
+int alterarPresenca(int id_aula, int ra, int presente) {
+    int ok = 0;
+
+    pthread_mutex_lock(&trava_frequencia);
+    if (!abrirFrequencia(TRAVA_EXCLUSIVA)) {
+        pthread_mutex_unlock(&trava_frequencia);
+        return 0;
+    }
+
+    Chamada *chamada = chamadaDaAula(id_aula);
+    ListaChamada *lista = chamada ? listaDaTurma(chamada->id_turma, 0) : NULL;
+    int posicao = lista ? mapaBuscar(&lista->posicoes, ra) : -1;
+
+    if (posicao >= 0 && posicao < chamada->bits && testarBit(chamada->matriculados, posicao)) {
+        size_t bytes = sizeof(uint64_t) * 2 * (size_t)palavras(chamada->bits);
+        uint64_t *bitsets = malloc(bytes ? bytes : 1);
+        if (bitsets != NULL) {
+            memcpy(bitsets, chamada->matriculados, bytes);
+            uint64_t *presentes = bitsets + palavras(chamada->bits);
+            if (presente) {
+                presentes[posicao / 64] |= 1ULL << (posicao % 64);
+            } else {
+                presentes[posicao / 64] &= ~(1ULL << (posicao % 64));
+            }
+            ok = gravarChamada(id_aula, chamada->id_turma, chamada->bits, bitsets);
+            free(bitsets);
+        }
+    }
+
+    fecharFrequencia();
+    pthread_mutex_unlock(&trava_frequencia);
+    return ok;
+}
+
+int consultarPresenca(int id_aula, int ra) {
+    int resultado = -1;
+
+    pthread_mutex_lock(&trava_frequencia);
+    if (abrirFrequencia(TRAVA_COMPARTILHADA)) {
+        const Chamada *chamada = chamadaDaAula(id_aula);
+        const ListaChamada *lista = chamada ? listaDaTurma(chamada->id_turma, 0) : NULL;
+        int posicao = lista ? mapaBuscar(&lista->posicoes, ra) : -1;
+
+        if (posicao >= 0 && posicao < chamada->bits && testarBit(chamada->matriculados, posicao)) {
+            resultado = testarBit(presentesDa(chamada), posicao);
+        }
+        fecharFrequencia();
+    }
+    pthread_mutex_unlock(&trava_frequencia);
+    return resultado;
+}
+
+int contarPresentesAula(int id_aula, int *matriculados) {
+    int presentes = -1;
+    int total = 0;
+
+    pthread_mutex_lock(&trava_frequencia);
+    if (abrirFrequencia(TRAVA_COMPARTILHADA)) {
+        const Chamada *chamada = chamadaDaAula(id_aula);
+        if (chamada != NULL) {
+            const uint64_t *bits_presentes = presentesDa(chamada);
+            presentes = 0;
+            for (int w = 0; w < palavras(chamada->bits); w++) {
+                total += contarBits(chamada->matriculados[w]);
+                presentes += contarBits(bits_presentes[w]);
+            }
+        }
+        fecharFrequencia();
+    }
+    pthread_mutex_unlock(&trava_frequencia);
+
+    if (matriculados != NULL) {
+        *matriculados = total;
+    }
+    return presentes;
+}
+
+int frequenciaDoAluno(int id_turma, int ra, FrequenciaAluno *destino) {
+    int encontrado = 0;
+    FrequenciaAluno frequencia = {ra, 0, 0};
+
+    pthread_mutex_lock(&trava_frequencia);
+    if (abrirFrequencia(TRAVA_COMPARTILHADA)) {
+        const ListaChamada *lista = listaDaTurma(id_turma, 0);
+        int posicao = lista ? mapaBuscar(&lista->posicoes, ra) : -1;
+
+        if (posicao >= 0) {
+            encontrado = 1;
+            for (int i = 0; i < estado.total_chamadas; i++) {
+                const Chamada *chamada = &estado.chamadas[i];
+                if (chamada->id_turma == id_turma && posicao < chamada->bits &&
+                    testarBit(chamada->matriculados, posicao)) {
+                    frequencia.chamadas++;
+                    frequencia.presencas += testarBit(presentesDa(chamada), posicao);
+                }
+            }
+        }
+        fecharFrequencia();
+    }
+    pthread_mutex_unlock(&trava_frequencia);
+
+    if (destino != NULL) {
+        *destino = frequencia;
+    }
+    return encontrado;
+}
+
+int frequenciaAlunosDaTurma(int id_turma, FrequenciaAluno *destino, int max) {
+    int copiados = 0;
+
+    pthread_mutex_lock(&trava_frequencia);
+    if (!abrirFrequencia(TRAVA_COMPARTILHADA)) {
+        pthread_mutex_unlock(&trava_frequencia);
+        return 0;
+    }
+
+    const ListaChamada *lista = listaDaTurma(id_turma, 0);
+    if (lista != NULL && lista->total > 0) {
+        int *contagens = calloc((size_t)lista->total * 2, sizeof(int));
+        if (contagens == NULL) {
+            copiados = -1;
+        } else {
+            int *chamadas = contagens;
+            int *presencas = contagens + lista->total;
+
+            // Só os bits ligados de cada palavra são visitados
+            for (int i = 0; i < estado.total_chamadas; i++) {
+                const Chamada *chamada = &estado.chamadas[i];
+                if (chamada->id_turma != id_turma) {
+                    continue;
+                }
+                const uint64_t *bits_presentes = presentesDa(chamada);
+                for (int w = 0; w < palavras(chamada->bits); w++) {
+                    for (uint64_t m = chamada->matriculados[w]; m != 0; m &= m - 1) {
+                        chamadas[w * 64 + menorBit(m)]++;
+                    }
+                    for (uint64_t p = bits_presentes[w]; p != 0; p &= p - 1) {
+                        presencas[w * 64 + menorBit(p)]++;
+                    }
+                }
+            }
+
+            for (int j = 0; j < lista->total && copiados < max; j++) {
+                destino[copiados].ra = lista->ras[j];
+                destino[copiados].chamadas = chamadas[j];
+                destino[copiados].presencas = presencas[j];
+                copiados++;
+            }
+            free(contagens);
+        }
+    }
+
+    fecharFrequencia();
+    pthread_mutex_unlock(&trava_frequencia);
+    return copiados;
+}
+
+int frequenciaDaTurma(int id_turma, FrequenciaTurma *destino) {
+    FrequenciaTurma frequencia = {0, 0, 0};
+
+    pthread_mutex_lock(&trava_frequencia);
+    if (abrirFrequencia(TRAVA_COMPARTILHADA)) {
+        for (int i = 0; i < estado.total_chamadas; i++) {
+            const Chamada *chamada = &estado.chamadas[i];
+            if (chamada->id_turma != id_turma) {
+                continue;
+            }
+            const uint64_t *bits_presentes = presentesDa(chamada);
+            frequencia.chamadas++;
+            for (int w = 0; w < palavras(chamada->bits); w++) {
+                frequencia.matriculados += contarBits(chamada->matriculados[w]);
+                frequencia.presencas += contarBits(bits_presentes[w]);
+            }
+        }
+        fecharFrequencia();
+    }
+    pthread_mutex_unlock(&trava_frequencia);
+
+    if (destino != NULL) {
+        *destino = frequencia;
+    }
+    return frequencia.chamadas;
+}
+
+int excluirChamada(int id_aula) {
+    int ok = 0;
+
+    pthread_mutex_lock(&trava_frequencia);
+    if (abrirFrequencia(TRAVA_EXCLUSIVA)) {
+        const Chamada *chamada = chamadaDaAula(id_aula);
+        if (chamada != NULL) {
+            ok = gravarRegistro(FREQ_REG_EXCLUSAO, chamada->id_turma, id_aula, 0, NULL, 0);
+        }
+        fecharFrequencia();
+    }
+    pthread_mutex_unlock(&trava_frequencia);
+    return ok;
+}
+
+int compactarFrequencias(void) {
+    int ok = 0;
+
+    pthread_mutex_lock(&trava_frequencia);
+    if (abrirFrequencia(TRAVA_EXCLUSIVA)) {
+        ok = regravarArquivo();
+        fecharFrequencia();
+    }
+    pthread_mutex_unlock(&trava_frequencia);
+    return ok;
+}
@@ -0,0 +1,113 @@
+#ifndef FREQUENCIA_MANAGER_H
+#define FREQUENCIA_MANAGER_H
+
+#include <stdint.h>
+#include "structs.h"
+
+// ========== FREQUÊNCIA (CHAMADA) POR AULA ==========
+//
+// Cada turma tem uma lista de chamada: os RAs de listarAlunosDaTurma(), na
+// mesma ordem, e só cresce (quem é matriculado depois entra no fim; quem sai
+// da turma continua na posição, para as chamadas antigas). A chamada de uma
+// aula guarda dois bitsets sobre essa lista, em palavras de 64 bits:
+// - matriculados: quem estava na turma quando a chamada foi feita;
+// - presentes:    subconjunto dos matriculados.
+// Frequência da aula e da turma são popcounts palavra a palavra; a de cada
+// aluno de uma turma sai de uma passada pelos bits ligados.
+//
+// Persistência em ARQUIVO_FREQUENCIA, só por acréscimo:
+//   CabecalhoFrequencia | RegistroFrequencia + carga | ...
+// - FREQ_REG_LISTA:    RAs acrescentados à lista da turma (int32 cada);
+// - FREQ_REG_CHAMADA:  bitsets da aula (substitui a chamada anterior dela);
+// - FREQ_REG_EXCLUSAO: remove a chamada da aula.
+// Uma chamada de 1000 alunos ocupa 250 bytes. A leitura para no primeiro
+// registro incompleto ou com verificação errada; quando os registros
+// substituídos passam dos vivos, o arquivo é regravado (gravação atômica).
+// Outro processo pode acrescentar registros: cada operação confere a trava
+// "<arquivo>.lock" e lê só o que foi acrescentado desde a última vez.
+
+#define ARQUIVO_FREQUENCIA "data/frequencia.dat"
+#define FREQUENCIA_MAGICA 0x464D4950u      // "PIMF"
+#define FREQUENCIA_VERSAO 1
+
+#define FREQ_REG_LISTA 1
+#define FREQ_REG_CHAMADA 2
+#define FREQ_REG_EXCLUSAO 3
+
+// ========== FORMATO EM DISCO ==========
+
+typedef struct {
+    uint32_t magica;           // FREQUENCIA_MAGICA
+    uint32_t versao;
+} CabecalhoFrequencia;
+
+typedef struct {
+    uint32_t tamanho;          // Registro inteiro, carga incluída
+    uint32_t verificacao;      // FNV-1a dos bytes após este campo
+    uint8_t tipo;              // FREQ_REG_*
+    uint8_t reservado[3];
+    int32_t id_turma;
+    int32_t id_aula;           // 0 em FREQ_REG_LISTA
+    uint32_t quantidade;       // LISTA: RAs na carga; CHAMADA: bits de cada bitset
+} RegistroFrequencia;
+
+// ========== CONSULTAS ==========
+
+// Frequência de um aluno nas chamadas de uma turma
+typedef struct {
+    int ra;
+    int chamadas;              // Chamadas em que estava matriculado
+    int presencas;
+} FrequenciaAluno;
+
+// Frequência de uma turma inteira
+typedef struct {
+    int chamadas;
+    long long matriculados;    // Soma de alunos matriculados por chamada
+    long long presencas;
+} FrequenciaTurma;
+
+// Função para trocar o arquivo de frequência (testes e benchmarks)
+// NULL volta para ARQUIVO_FREQUENCIA; o estado em memória é descartado
+void usarArquivoFrequencia(const char *arquivo);
+
+// Função para registrar a chamada de uma aula: todos os matriculados na
+// turma da aula ficam presentes, exceto os RAs de "ausentes"
+// Uma nova chamada da mesma aula substitui a anterior
+// Retorna: alunos na chamada, ou -1 (aula inexistente, ausente fora da turma, erro de gravação)
+int registrarChamada(int id_aula, const int *ausentes, int total_ausentes);
+
+// Função para alterar a presença de um aluno em uma chamada já registrada
+// Retorna: 1 se sucesso, 0 se a aula não tem chamada ou o aluno não estava nela
+int alterarPresenca(int id_aula, int ra, int presente);
+
+// Função para consultar a presença de um aluno em uma aula
+// Retorna: 1 presente, 0 ausente, -1 sem chamada ou aluno fora dela
+int consultarPresenca(int id_aula, int ra);
+
+// Função para contar os presentes de uma aula (matriculados pode ser NULL)
+// Retorna: presentes, ou -1 se a aula não tem chamada
+int contarPresentesAula(int id_aula, int *matriculados);
+
+// Função para calcular a frequência de um aluno em uma turma
+// Retorna: 1 se o aluno está na lista de chamada da turma, 0 se não
+int frequenciaDoAluno(int id_turma, int ra, FrequenciaAluno *destino);
+
+// Função para calcular a frequência de todos os alunos de uma turma, na
+// ordem da lista de chamada
+// Retorna: alunos copiados para destino (-1 se faltou memória)
+int frequenciaAlunosDaTurma(int id_turma, FrequenciaAluno *destino, int max);
+
+// Função para calcular a frequência de uma turma
+// Retorna: chamadas registradas da turma
+int frequenciaDaTurma(int id_turma, FrequenciaTurma *destino);
+
+// Função para excluir a chamada de uma aula
+// Retorna: 1 se havia chamada, 0 se não
+int excluirChamada(int id_aula);
+
+// Função para regravar o arquivo só com as listas e chamadas vivas
+// Retorna: 1 se sucesso, 0 se erro
+int compactarFrequencias(void);
+
+#endif
@@ -0,0 +1,220 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include "journal_manager.h"
+#include "tabela_manager.h"
+#include "structs.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#define close _close
+#define fsync _commit
+#else
+#include <unistd.h>
+#endif
+
+// Trava "journal.log.lock" deste processo
+static TravaArquivo trava_journal = TRAVA_ARQUIVO_INIT;
+
+// ========== FUNÇÕES AUXILIARES PRIVADAS ==========
+
+// Substitui "destino" por "origem" (rename atômico)
+static int substituirArquivo(const char *origem, const char *destino) {
+#ifdef _WIN32
+    return MoveFileExA(origem, destino, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(origem, destino) == 0;
+#endif
+}
+
+// Sincroniza o diretório do arquivo, para que os renames sobrevivam a uma queda
+static void sincronizarDiretorio(const char *arquivo) {
+#ifdef _WIN32
+    (void)arquivo;
+#else
+    char diretorio[MAX_PATH];
+    const char *barra = strrchr(arquivo, '/');
+    int descritor;
+
+    if (barra == NULL) {
+        snprintf(diretorio, sizeof(diretorio), ".");
+    } else {
+        snprintf(diretorio, sizeof(diretorio), "%.*s", (int)(barra - arquivo), arquivo);
+    }
+    descritor = open(barra == arquivo ? "/" : diretorio, O_RDONLY);
+    if (descritor >= 0) {
+        fsync(descritor);
+        close(descritor);
+    }
+#endif
+}
+
+// Lê a lista de arquivos de ARQUIVO_JOURNAL
+// Retorna: arquivos listados, 0 se não há journal, -1 se ele não está confirmado
+static int lerJournal(char arquivos[][MAX_PATH], int max) {
+    char linha[MAX_PATH];
+    int total = 0;
+    int confirmados = -1;
+    FILE *journal = fopen(ARQUIVO_JOURNAL, "r");
+
+    if (journal == NULL) {
+        return 0;
+    }
+
+    if (fgets(linha, sizeof(linha), journal) == NULL ||
+        strncmp(linha, JOURNAL_CABECALHO, strlen(JOURNAL_CABECALHO)) != 0) {
+        fclose(journal);
+        return -1;
+    }
+
+    while (fgets(linha, sizeof(linha), journal) != NULL) {
+        linha[strcspn(linha, "\r\n")] = '\0';
+        if (sscanf(linha, "CONFIRMADA %d", &confirmados) == 1) {
+            break;
+        }
+        if (linha[0] != '\0' && total < max) {
+            strcpy(arquivos[total++], linha);
+        }
+    }
+    fclose(journal);
+
+    return (confirmados == total) ? total : -1;
+}
+
+// Refaz os renames de um journal confirmado (exige trava_journal)
+// Retorna: arquivos republicados
+static int concluirPublicacaoPendente(void) {
+    char arquivos[MAX_ARQUIVOS_JOURNAL][MAX_PATH];
+    char temporario[MAX_PATH + 8];
+    int total = lerJournal(arquivos, MAX_ARQUIVOS_JOURNAL);
+    int republicados = 0;
+
+    // Journal pela metade nunca foi renomeado: sobra apenas o ".tmp"
+    snprintf(temporario, sizeof(temporario), "%s.tmp", ARQUIVO_JOURNAL);
+    remove(temporario);
+
+    if (total == 0) {
+        return 0;
+    }
+    if (total < 0) {
+        // Sem "CONFIRMADA": a publicação não chegou ao ponto de confirmação
+        remove(ARQUIVO_JOURNAL);
+        return 0;
+    }
+
+    for (int i = 0; i < total; i++) {
+        TravaArquivo trava = TRAVA_ARQUIVO_INIT;
+        FILE *existe;
+
+        // Mesmo protocolo de um escritor: trava exclusiva + nova geração
+        travarArquivo(&trava, arquivos[i], TRAVA_EXCLUSIVA);
+        snprintf(temporario, sizeof(temporario), "%s.tmp", arquivos[i]);
+        existe = fopen(temporario, "r");
+        if (existe != NULL) {
+            fclose(existe);
+            if (substituirArquivo(temporario, arquivos[i])) {
+                republicados++;
+            }
+        }
+        incrementarGeracaoArquivo(&trava);
+        destravarArquivo(&trava);
+        if (trava.descritor >= 0) {
+            close(trava.descritor);
+        }
+    }
+
+    sincronizarDiretorio(ARQUIVO_JOURNAL);
+    remove(ARQUIVO_JOURNAL);
+    printf("Journal: publicação interrompida concluída (%d arquivo(s)).\n", republicados);
+    return republicados;
+}
+
+// ========== IMPLEMENTAÇÃO DAS FUNÇÕES PÚBLICAS ==========
+
+int travarJournal(void) {
+    if (!travarArquivo(&trava_journal, ARQUIVO_JOURNAL, TRAVA_EXCLUSIVA)) {
+        printf("Erro: não foi possível travar o journal.\n");
+        return 0;
+    }
+    concluirPublicacaoPendente();
+    return 1;
+}
+
+void destravarJournal(void) {
+    destravarArquivo(&trava_journal);
+}
+
+int publicarArquivosAtomico(const char *const *arquivos, int total) {
+    char temporario[MAX_PATH + 8];
+    FILE *journal;
+    int ok;
+
+    if (total <= 0) {
+        return 1;
+    }
+    if (total > MAX_ARQUIVOS_JOURNAL) {
+        printf("Erro: arquivos demais para uma publicação.\n");
+        return 0;
+    }
+
+    // 1. Journal completo e sincronizado antes de tocar em qualquer CSV
+    snprintf(temporario, sizeof(temporario), "%s.tmp", ARQUIVO_JOURNAL);
+    journal = fopen(temporario, "w");
+    if (journal == NULL) {
+        printf("Erro ao abrir o journal para escrita.\n");
+        return 0;
+    }
+
+    fprintf(journal, "%s\n", JOURNAL_CABECALHO);
+    for (int i = 0; i < total; i++) {
+        fprintf(journal, "%s\n", arquivos[i]);
+    }
+    fprintf(journal, "CONFIRMADA %d\n", total);
+
+    ok = (fflush(journal) == 0) && (fsync(fileno(journal)) == 0);
+    ok = (fclose(journal) == 0) && ok;
+    if (!ok || !substituirArquivo(temporario, ARQUIVO_JOURNAL)) {
+        remove(temporario);
+        printf("Erro ao gravar o journal.\n");
+        return 0;
+    }
+    sincronizarDiretorio(ARQUIVO_JOURNAL);
+
+    // 2. Confirmado: a partir daqui a recuperação termina o que faltar
+    for (int i = 0; i < total; i++) {
+        snprintf(temporario, sizeof(temporario), "%s.tmp", arquivos[i]);
+        if (!substituirArquivo(temporario, arquivos[i])) {
+            printf("Aviso: %s será publicado na recuperação do journal.\n", arquivos[i]);
+            return 1;
+        }
+    }
+    sincronizarDiretorio(arquivos[0]);
+
+    // 3. Publicação completa
+    remove(ARQUIVO_JOURNAL);
+    return 1;
+}
+
+int recuperarJournal(void) {
+    int republicados;
+
+    if (!travarArquivo(&trava_journal, ARQUIVO_JOURNAL, TRAVA_EXCLUSIVA)) {
+        return 0;
+    }
+    republicados = concluirPublicacaoPendente();
+    destravarArquivo(&trava_journal);
+    return republicados;
+}
+
+void descartarTemporarios(const char *const *arquivos, int total) {
+    char temporario[MAX_PATH + 8];
+
+    for (int i = 0; i < total; i++) {
+        snprintf(temporario, sizeof(temporario), "%s.tmp", arquivos[i]);
+        remove(temporario);
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef JOURNAL_MANAGER_H
+#define JOURNAL_MANAGER_H
+
+// ========== JOURNAL DE PUBLICAÇÃO (VÁRIOS CSVs DE UMA VEZ) ==========
+//
+// Cada CSV é publicado sozinho por "x.csv.tmp" + rename. Quando uma operação
+// altera vários CSVs (ex.: excluir a turma com suas aulas, atividades, notas
+// e matrículas), todos os temporários são gravados e sincronizados antes, e
+// o journal decide se a operação aconteceu:
+// 1. ARQUIVO_JOURNAL é escrito em "journal.log.tmp" com a lista de CSVs e a
+//    linha final "CONFIRMADA <n>", sincronizado e renomeado: a existência de
+//    ARQUIVO_JOURNAL é o ponto de confirmação;
+// 2. cada "x.csv.tmp" substitui o seu CSV por rename;
+// 3. ARQUIVO_JOURNAL é removido.
+// Se o processo morrer entre 1 e 3, a próxima travarJournal() (ou
+// recuperarJournal()) refaz os renames que faltaram, sob a trava exclusiva de
+// cada CSV; o temporário que já sumiu foi publicado. Sem journal, temporários
+// que sobrarem não valem nada e o próximo escritor os sobrescreve.
+//
+// A trava "journal.log.lock" é obtida antes das travas dos CSVs e mantida
+// durante toda a transação: transações de processos diferentes se
+// serializam e a recuperação nunca espera por uma delas.
+//
+// Formato (texto):
+//   PIMJ 1
+//   data/aulas.csv
+//   data/atividades.csv
+//   CONFIRMADA 2
+
+#define ARQUIVO_JOURNAL "data/journal.log"
+#define JOURNAL_CABECALHO "PIMJ 1"
+#define MAX_ARQUIVOS_JOURNAL 16
+
+// Função para obter a trava do journal e concluir publicação interrompida
+// Retorna: 1 se obteve, 0 se erro
+int travarJournal(void);
+
+// Função para liberar a trava do journal
+void destravarJournal(void);
+
+// Função para publicar de uma vez os temporários "<arquivo>.tmp" já gravados
+// Exige travarJournal(); os temporários devem estar completos e sincronizados
+// Retorna: 1 se publicados, 0 se o journal não pôde ser gravado (nada muda)
+int publicarArquivosAtomico(const char *const *arquivos, int total);
+
+// Função para concluir uma publicação interrompida (início do programa)
+// Retorna: arquivos republicados, 0 se não havia journal pendente
+int recuperarJournal(void);
+
+// Função para apagar os temporários de uma publicação desistida
+void descartarTemporarios(const char *const *arquivos, int total);
+
+#endif
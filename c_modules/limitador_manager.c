@@ -0,0 +1,274 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <time.h>
+#include "limitador_manager.h"
+
+#define MASCARA_LIMITADOR (LIMITADOR_ENTRADAS - 1)
+#define MIL_FICHAS 1000u               // Fichas guardadas em milésimos
+#define TENTATIVAS_CAS 64
+#define DESLOCAMENTO_TIPO 62           // Tipo do balde nos 2 bits altos da chave
+#define SEPARADOR_CHAVE 0xFFu          // Entre login e cliente (não aparece em UTF-8)
+
+// Tipos de balde
+enum { BALDE_LOGIN_CLIENTE = 0, BALDE_LOGIN, BALDE_CLIENTE, TOTAL_BALDES };
+
+// ========== ESTRUTURAS INTERNAS ==========
+
+// "estado" = fichas em milésimos (32 bits altos) | instante da última recarga
+// em ms (32 bits baixos); 0 = balde novo, ainda cheio
+typedef struct {
+    _Atomic uint64_t chave;            // 0 = livre
+    _Atomic uint64_t estado;
+    _Atomic uint32_t ultimo_uso;       // Segundos (para o despejo)
+    uint32_t reservado;
+    uint64_t preenchimento;
+} EntradaLimitador;
+
+static EntradaLimitador tabela[LIMITADOR_ENTRADAS];
+
+static _Atomic int habilitado = 1;
+static _Atomic uint32_t capacidade[TOTAL_BALDES] = {5 * MIL_FICHAS, 30 * MIL_FICHAS, 20 * MIL_FICHAS};
+static _Atomic uint32_t recarga_por_s[TOTAL_BALDES] = {5 * MIL_FICHAS / 60, 10 * MIL_FICHAS / 60,
+                                                       60 * MIL_FICHAS / 60};
+
+static _Atomic unsigned long long permitidas = 0;
+static _Atomic unsigned long long bloqueadas = 0;
+static _Atomic unsigned long long despejos = 0;
+static _Atomic unsigned long long lotadas = 0;
+
+// ========== FUNÇÕES AUXILIARES PRIVADAS ==========
+
+static uint32_t agoraMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000);
+}
+
+// FNV-1a de 64 bits sobre login e cliente (NULL = vazio), com o tipo nos
+// bits altos (nunca 0)
+static uint64_t chaveDe(int tipo, const char *login, const char *cliente) {
+    uint64_t h = 1469598103934665603ULL;
+
+    for (const unsigned char *p = (const unsigned char *)login; p != NULL && *p; p++) {
+        h = (h ^ *p) * 1099511628211ULL;
+    }
+    h = (h ^ SEPARADOR_CHAVE) * 1099511628211ULL;
+    for (const unsigned char *p = (const unsigned char *)cliente; p != NULL && *p; p++) {
+        h = (h ^ *p) * 1099511628211ULL;
+    }
+    h = (h & ~(3ULL << DESLOCAMENTO_TIPO)) | ((uint64_t)tipo << DESLOCAMENTO_TIPO);
+    return h ? h : 1;
+}
+
+// Fichas do balde recarregadas até "agora" (estado 0 = cheio); o instante da
+// recarga vai para *instante (só avança com ganho inteiro, para não perder a
+// fração)
+static uint32_t fichasRecarregadas(uint64_t estado, int tipo, uint32_t agora, uint32_t *instante) {
+    uint32_t cap = atomic_load_explicit(&capacidade[tipo], memory_order_relaxed);
+    uint32_t taxa = atomic_load_explicit(&recarga_por_s[tipo], memory_order_relaxed);
+
+    if (estado == 0) {
+        *instante = agora;
+        return cap;
+    }
+    uint32_t fichas = (uint32_t)(estado >> 32);
+    *instante = (uint32_t)estado;
+    uint64_t ganho = (uint64_t)(uint32_t)(agora - *instante) * taxa / 1000;
+    if (ganho > 0) {
+        fichas = (fichas + ganho >= cap) ? cap : fichas + (uint32_t)ganho;
+        *instante = agora;
+    }
+    return fichas;
+}
+
+// Baldes de cliente podem sempre sair; os de falha, só depois de recarregados
+static int baldeDespejavel(EntradaLimitador *e, uint64_t chave, uint32_t agora) {
+    int tipo = (int)(chave >> DESLOCAMENTO_TIPO);
+    uint32_t instante;
+
+    if (tipo == BALDE_CLIENTE) {
+        return 1;
+    }
+    return fichasRecarregadas(atomic_load_explicit(&e->estado, memory_order_acquire), tipo, agora, &instante) >=
+           atomic_load_explicit(&capacidade[tipo], memory_order_relaxed);
+}
+
+// Posição do balde da chave; com "criar", ocupa uma livre ou despeja se não
+// existir. *lotado = 1 quando não há posição livre nem despejável.
+// Retorna: entrada, NULL se não existe (sem "criar") ou não coube
+static EntradaLimitador* localizarBalde(uint64_t chave, int criar, int *lotado) {
+    uint32_t agora = agoraMs();
+    uint32_t agora_s = agora / 1000;
+
+    *lotado = 0;
+    for (int tentativa = 0; tentativa < TENTATIVAS_CAS; tentativa++) {
+        EntradaLimitador *livre = NULL, *antiga = NULL;
+        uint64_t chave_antiga = 0;
+        uint32_t uso_antigo = UINT32_MAX;
+
+        for (int i = 0; i < LIMITADOR_SONDAGEM; i++) {
+            EntradaLimitador *e = &tabela[(chave + (uint64_t)i) & MASCARA_LIMITADOR];
+            uint64_t atual = atomic_load_explicit(&e->chave, memory_order_acquire);
+
+            if (atual == chave) {
+                atomic_store_explicit(&e->ultimo_uso, agora_s, memory_order_relaxed);
+                return e;
+            }
+            if (atual == 0) {
+                if (livre == NULL) {
+                    livre = e;
+                }
+                continue;
+            }
+            uint32_t uso = atomic_load_explicit(&e->ultimo_uso, memory_order_relaxed);
+            if (uso < uso_antigo && baldeDespejavel(e, atual, agora)) {
+                uso_antigo = uso;
+                antiga = e;
+                chave_antiga = atual;
+            }
+        }
+
+        // Ocupa uma posição livre ou despeja a menos usada; se outra thread
+        // chegou antes, procura de novo (pode ter sido a mesma chave)
+        EntradaLimitador *alvo = livre ? livre : antiga;
+        if (alvo == NULL) {
+            *lotado = 1;
+            return NULL;
+        }
+        if (!criar) {
+            return NULL;
+        }
+        uint64_t esperado = livre ? 0 : chave_antiga;
+        if (atomic_compare_exchange_strong_explicit(&alvo->chave, &esperado, chave,
+                                                    memory_order_acq_rel, memory_order_acquire)) {
+            atomic_store_explicit(&alvo->estado, 0, memory_order_release);
+            atomic_store_explicit(&alvo->ultimo_uso, agora_s, memory_order_relaxed);
+            if (livre == NULL) {
+                atomic_fetch_add_explicit(&despejos, 1, memory_order_relaxed);
+            }
+            return alvo;
+        }
+    }
+    return NULL;
+}
+
+// Recarrega e, se "gastar", retira uma ficha
+// Retorna: 1 se havia ficha, 0 se o balde está vazio
+static int usarBalde(EntradaLimitador *e, int tipo, int gastar) {
+    uint32_t agora = agoraMs();
+
+    for (int tentativa = 0; tentativa < TENTATIVAS_CAS; tentativa++) {
+        uint64_t antigo = atomic_load_explicit(&e->estado, memory_order_acquire);
+        uint32_t instante;
+        uint32_t fichas = fichasRecarregadas(antigo, tipo, agora, &instante);
+
+        if (fichas < MIL_FICHAS) {
+            return 0;
+        }
+        if (!gastar) {
+            return 1;
+        }
+        fichas -= MIL_FICHAS;
+
+        // 0 é reservado para "balde novo"
+        uint64_t novo = ((uint64_t)fichas << 32) | instante;
+        if (novo == 0) {
+            novo = 1;
+        }
+        if (atomic_compare_exchange_weak_explicit(&e->estado, &antigo, novo,
+                                                  memory_order_acq_rel, memory_order_relaxed)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Consulta (e, com "gastar", cria e gasta) o balde da chave
+// Retorna: 1 se permitido (balde inexistente = cheio), 0 se vazio ou lotado
+static int baldePermite(uint64_t chave, int tipo, int gastar) {
+    int lotado;
+    EntradaLimitador *e = localizarBalde(chave, gastar, &lotado);
+
+    if (e == NULL) {
+        if (lotado) {
+            atomic_fetch_add_explicit(&lotadas, 1, memory_order_relaxed);
+        }
+        return !lotado;
+    }
+    return usarBalde(e, tipo, gastar);
+}
+
+// ========== FUNÇÕES PÚBLICAS ==========
+
+void configuracaoLimitadorPadrao(ConfiguracaoLimitador *config) {
+    config->habilitado = 1;
+    config->rajada_login = 5;
+    config->falhas_login_por_minuto = 5;
+    config->rajada_login_global = 30;
+    config->falhas_login_global_por_minuto = 10;
+    config->rajada_cliente = 20;
+    config->tentativas_cliente_por_minuto = 60;
+}
+
+void configurarLimitador(const ConfiguracaoLimitador *config) {
+    atomic_store(&capacidade[BALDE_LOGIN_CLIENTE], (uint32_t)config->rajada_login * MIL_FICHAS);
+    atomic_store(&recarga_por_s[BALDE_LOGIN_CLIENTE],
+                 (uint32_t)config->falhas_login_por_minuto * MIL_FICHAS / 60);
+    atomic_store(&capacidade[BALDE_LOGIN], (uint32_t)config->rajada_login_global * MIL_FICHAS);
+    atomic_store(&recarga_por_s[BALDE_LOGIN],
+                 (uint32_t)config->falhas_login_global_por_minuto * MIL_FICHAS / 60);
+    atomic_store(&capacidade[BALDE_CLIENTE], (uint32_t)config->rajada_cliente * MIL_FICHAS);
+    atomic_store(&recarga_por_s[BALDE_CLIENTE],
+                 (uint32_t)config->tentativas_cliente_por_minuto * MIL_FICHAS / 60);
+    atomic_store(&habilitado, config->habilitado);
+}
+
+int consultarLimitador(const char *login, const char *cliente) {
+    if (!atomic_load_explicit(&habilitado, memory_order_relaxed)) {
+        return LIMITE_PERMITIDO;
+    }
+
+    // Falhas esgotadas (desta origem ou no teto do login): só confere, as
+    // fichas saem em registrarFalhaLimitador()
+    if (login != NULL && (!baldePermite(chaveDe(BALDE_LOGIN_CLIENTE, login, cliente), BALDE_LOGIN_CLIENTE, 0) ||
+                          !baldePermite(chaveDe(BALDE_LOGIN, login, NULL), BALDE_LOGIN, 0))) {
+        atomic_fetch_add_explicit(&bloqueadas, 1, memory_order_relaxed);
+        return LIMITE_BLOQUEADO;
+    }
+    if (cliente != NULL && !baldePermite(chaveDe(BALDE_CLIENTE, NULL, cliente), BALDE_CLIENTE, 1)) {
+        atomic_fetch_add_explicit(&bloqueadas, 1, memory_order_relaxed);
+        return LIMITE_BLOQUEADO;
+    }
+
+    atomic_fetch_add_explicit(&permitidas, 1, memory_order_relaxed);
+    return LIMITE_PERMITIDO;
+}
+
+void registrarFalhaLimitador(const char *login, const char *cliente) {
+    if (login == NULL || !atomic_load_explicit(&habilitado, memory_order_relaxed)) {
+        return;
+    }
+    baldePermite(chaveDe(BALDE_LOGIN_CLIENTE, login, cliente), BALDE_LOGIN_CLIENTE, 1);
+    baldePermite(chaveDe(BALDE_LOGIN, login, NULL), BALDE_LOGIN, 1);
+}
+
+void reiniciarLimitador(void) {
+    for (int i = 0; i < LIMITADOR_ENTRADAS; i++) {
+        atomic_store(&tabela[i].chave, 0);
+        atomic_store(&tabela[i].estado, 0);
+        atomic_store(&tabela[i].ultimo_uso, 0);
+    }
+    atomic_store(&permitidas, 0);
+    atomic_store(&bloqueadas, 0);
+    atomic_store(&despejos, 0);
+    atomic_store(&lotadas, 0);
+}
+
+void estatisticasLimitador(EstatisticasLimitador *destino) {
+    destino->permitidas = atomic_load(&permitidas);
+    destino->bloqueadas = atomic_load(&bloqueadas);
+    destino->despejos = atomic_load(&despejos);
+    destino->lotadas = atomic_load(&lotadas);
+}
@@ -0,0 +1,71 @@
+#ifndef LIMITADOR_MANAGER_H
+#define LIMITADOR_MANAGER_H
+
+// ========== LIMITADOR DE TENTATIVAS DE LOGIN ==========
+//
+// Baldes de fichas (token bucket) consultados antes de qualquer busca de
+// usuário:
+// - cliente: toda tentativa gasta uma ficha (script martelando de uma origem);
+// - login + cliente: só as falhas gastam (senha errada ou usuário
+//   inexistente/inativo). Quem erra a senha de outra origem não bloqueia o
+//   dono da conta na dele;
+// - login (teto global): também só as falhas, com rajada maior; segura o
+//   ataque distribuído (muitas origens contra a mesma conta).
+// O balde recarrega continuamente até a rajada configurada.
+//
+// Os baldes ficam em uma tabela de tamanho fixo sem trava: cada posição tem a
+// chave (hash de 64 bits, com o tipo do balde nos 2 bits altos) e o estado do
+// balde compactado em uma palavra atualizada por CAS. A busca sonda
+// LIMITADOR_SONDAGEM posições; sem lugar livre, despeja a menos usada
+// recentemente dentre elas (LRU aproximado). Baldes de falha só são
+// despejados cheios: inundar a tabela com logins novos não zera as falhas de
+// ninguém. Se todas as posições sondadas guardam falhas, a tentativa de um
+// login sem balde é recusada (a falha não teria onde ser contada).
+// Recusar custa uma busca na tabela: nada de disco, trava ou log.
+
+#define LIMITADOR_ENTRADAS 4096        // Potência de 2
+#define LIMITADOR_SONDAGEM 8
+
+#define LIMITE_BLOQUEADO 0
+#define LIMITE_PERMITIDO 1
+
+typedef struct {
+    int habilitado;
+    int rajada_login;                  // Falhas seguidas aceitas por login + cliente
+    int falhas_login_por_minuto;       // Recarga do balde do login + cliente
+    int rajada_login_global;           // Falhas seguidas aceitas por login (todas as origens)
+    int falhas_login_global_por_minuto;
+    int rajada_cliente;                // Tentativas seguidas aceitas por cliente
+    int tentativas_cliente_por_minuto; // Recarga do balde do cliente
+} ConfiguracaoLimitador;
+
+typedef struct {
+    unsigned long long permitidas;
+    unsigned long long bloqueadas;
+    unsigned long long despejos;       // Baldes substituídos por falta de lugar
+    unsigned long long lotadas;        // Posições sondadas só com falhas: tentativa recusada ou falha sem lugar
+} EstatisticasLimitador;
+
+// Função para preencher a configuração padrão (5 falhas e 5/min por login +
+// cliente; 30 falhas e 10/min por login; 20 tentativas e 60/min por cliente)
+void configuracaoLimitadorPadrao(ConfiguracaoLimitador *config);
+
+// Função para trocar a configuração (vale para as próximas consultas)
+void configurarLimitador(const ConfiguracaoLimitador *config);
+
+// Função para consultar (e gastar a ficha do cliente) antes de autenticar
+// cliente pode ser NULL (sem balde de cliente)
+// Retorna: LIMITE_PERMITIDO ou LIMITE_BLOQUEADO
+int consultarLimitador(const char *login, const char *cliente);
+
+// Função para gastar as fichas do login após uma tentativa malsucedida
+// cliente pode ser NULL (mesma origem de consultarLimitador)
+void registrarFalhaLimitador(const char *login, const char *cliente);
+
+// Função para esvaziar a tabela e os contadores (sem tentativas em andamento)
+void reiniciarLimitador(void);
+
+// Função para consultar os contadores
+void estatisticasLimitador(EstatisticasLimitador *destino);
+
+#endif
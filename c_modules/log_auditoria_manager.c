@@ -0,0 +1,679 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <time.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "log_auditoria_manager.h"
+
+#ifdef _WIN32
+#include <direct.h>
+#include <windows.h>
+#define criarDiretorio(caminho) _mkdir(caminho)
+#else
+#define criarDiretorio(caminho) mkdir((caminho), 0755)
+#endif
+
+#define TAM_BUFFER_SEGMENTO 65536
+#define TAM_MAX_REGISTRO (sizeof(RegistroLog) + MAX_LOGIN + LOG_MAX_ACAO + LOG_MAX_DETALHES)
+
+// Destinos gravados pela auditoria (ver auditoria_manager.h)
+#define DESTINO_AUTH 0
+
+// ========== CRC-32 ==========
+
+static uint32_t tabela_crc[256];
+static pthread_once_t crc_iniciado = PTHREAD_ONCE_INIT;
+
+static void montarTabelaCrc(void) {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        tabela_crc[i] = c;
+    }
+}
+
+static uint32_t calcularCrc(const unsigned char *dados, size_t tamanho) {
+    uint32_t c = 0xFFFFFFFFu;
+
+    pthread_once(&crc_iniciado, montarTabelaCrc);
+    for (size_t i = 0; i < tamanho; i++) {
+        c = tabela_crc[(c ^ dados[i]) & 0xFF] ^ (c >> 8);
+    }
+    return c ^ 0xFFFFFFFFu;
+}
+
+// ========== FUNÇÕES AUXILIARES PRIVADAS ==========
+
+static void caminhoSegmento(const char *diretorio, uint64_t numero, const char *extensao,
+                            char *destino, size_t tamanho) {
+    snprintf(destino, tamanho, "%s/seg_%06llu.%s", diretorio, (unsigned long long)numero, extensao);
+}
+
+static int arquivoExiste(const char *caminho) {
+    struct stat info;
+    return stat(caminho, &info) == 0;
+}
+
+static int64_t agoraMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+// Lê o registro na posição atual; 0 no fim do arquivo ou em registro inválido
+static int lerRegistro(FILE *arquivo, EventoAuditoria *evento, uint32_t *tamanho) {
+    unsigned char bruto[TAM_MAX_REGISTRO];
+    RegistroLog cabecalho;
+    const size_t apos_crc = offsetof(RegistroLog, instante_ms);
+
+    if (fread(&cabecalho, sizeof(cabecalho), 1, arquivo) != 1) {
+        return 0;
+    }
+    if (cabecalho.tam_login >= MAX_LOGIN || cabecalho.tam_acao >= LOG_MAX_ACAO ||
+        cabecalho.tam_detalhes >= LOG_MAX_DETALHES ||
+        cabecalho.tamanho != sizeof(RegistroLog) + cabecalho.tam_login + cabecalho.tam_acao +
+                             cabecalho.tam_detalhes) {
+        return 0;
+    }
+
+    memcpy(bruto, &cabecalho, sizeof(cabecalho));
+    size_t textos = cabecalho.tamanho - sizeof(RegistroLog);
+    if (textos > 0 && fread(bruto + sizeof(RegistroLog), 1, textos, arquivo) != textos) {
+        return 0;
+    }
+    if (calcularCrc(bruto + apos_crc, cabecalho.tamanho - apos_crc) != cabecalho.crc) {
+        return 0;
+    }
+
+    const char *texto = (const char *)bruto + sizeof(RegistroLog);
+    evento->instante_ms = cabecalho.instante_ms;
+    evento->destino = cabecalho.destino;
+    evento->sucesso = cabecalho.sucesso;
+    memcpy(evento->login, texto, cabecalho.tam_login);
+    evento->login[cabecalho.tam_login] = '\0';
+    texto += cabecalho.tam_login;
+    memcpy(evento->acao, texto, cabecalho.tam_acao);
+    evento->acao[cabecalho.tam_acao] = '\0';
+    texto += cabecalho.tam_acao;
+    memcpy(evento->detalhes, texto, cabecalho.tam_detalhes);
+    evento->detalhes[cabecalho.tam_detalhes] = '\0';
+
+    *tamanho = cabecalho.tamanho;
+    return 1;
+}
+
+// ========== CONSTRUÇÃO DO ÍNDICE ==========
+
+typedef struct {
+    char login[MAX_LOGIN];
+    uint64_t offset;
+} ParLogin;
+
+typedef struct {
+    MarcaTempo *marcas;
+    size_t total_marcas;
+    size_t cap_marcas;
+    ParLogin *pares;
+    size_t total_pares;
+    size_t cap_pares;
+    uint64_t registros;
+    int64_t primeiro_ms;
+    int64_t ultimo_ms;
+} Indexador;
+
+static void limparIndexador(Indexador *ix) {
+    free(ix->marcas);
+    free(ix->pares);
+    memset(ix, 0, sizeof(*ix));
+}
+
+static int indexarRegistro(Indexador *ix, int64_t instante_ms, const char *login, uint64_t offset) {
+    if (ix->registros % LOG_INTERVALO_MARCAS == 0) {
+        if (ix->total_marcas == ix->cap_marcas) {
+            size_t nova = ix->cap_marcas ? ix->cap_marcas * 2 : 64;
+            MarcaTempo *marcas = realloc(ix->marcas, nova * sizeof(MarcaTempo));
+            if (marcas == NULL) {
+                return 0;
+            }
+            ix->marcas = marcas;
+            ix->cap_marcas = nova;
+        }
+        ix->marcas[ix->total_marcas].instante_ms = instante_ms;
+        ix->marcas[ix->total_marcas].offset = offset;
+        ix->total_marcas++;
+    }
+
+    if (ix->total_pares == ix->cap_pares) {
+        size_t nova = ix->cap_pares ? ix->cap_pares * 2 : 256;
+        ParLogin *pares = realloc(ix->pares, nova * sizeof(ParLogin));
+        if (pares == NULL) {
+            return 0;
+        }
+        ix->pares = pares;
+        ix->cap_pares = nova;
+    }
+    snprintf(ix->pares[ix->total_pares].login, MAX_LOGIN, "%s", login);
+    ix->pares[ix->total_pares].offset = offset;
+    ix->total_pares++;
+
+    if (ix->registros == 0) {
+        ix->primeiro_ms = instante_ms;
+    }
+    ix->ultimo_ms = instante_ms;
+    ix->registros++;
+    return 1;
+}
+
+static int compararPares(const void *a, const void *b) {
+    const ParLogin *pa = a, *pb = b;
+    int c = strcmp(pa->login, pb->login);
+    if (c != 0) {
+        return c;
+    }
+    return (pa->offset > pb->offset) - (pa->offset < pb->offset);
+}
+
+// Grava "seg_<n>.idx" (temporário + rename: leitores nunca veem meio índice)
+static int gravarIndice(const char *diretorio, uint64_t numero, Indexador *ix, uint64_t tam_segmento) {
+    char caminho[MAX_PATH + 32], temporario[MAX_PATH + 40];
+    CabecalhoIndice cabecalho;
+    FILE *arquivo;
+    int ok = 1;
+
+    qsort(ix->pares, ix->total_pares, sizeof(ParLogin), compararPares);
+
+    uint32_t logins = 0;
+    for (size_t i = 0; i < ix->total_pares; i++) {
+        if (i == 0 || strcmp(ix->pares[i].login, ix->pares[i - 1].login) != 0) {
+            logins++;
+        }
+    }
+
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    cabecalho.magica = LOG_INDICE_MAGICA;
+    cabecalho.versao = LOG_AUDITORIA_VERSAO;
+    cabecalho.total_registros = ix->registros;
+    cabecalho.primeiro_ms = ix->primeiro_ms;
+    cabecalho.ultimo_ms = ix->ultimo_ms;
+    cabecalho.tam_segmento = tam_segmento;
+    cabecalho.num_marcas = (uint32_t)ix->total_marcas;
+    cabecalho.num_logins = logins;
+    cabecalho.num_offsets = ix->total_pares;
+
+    caminhoSegmento(diretorio, numero, "idx", caminho, sizeof(caminho));
+    snprintf(temporario, sizeof(temporario), "%s.tmp", caminho);
+    arquivo = fopen(temporario, "wb");
+    if (arquivo == NULL) {
+        return 0;
+    }
+
+    ok = fwrite(&cabecalho, sizeof(cabecalho), 1, arquivo) == 1;
+    if (ok && ix->total_marcas > 0) {
+        ok = fwrite(ix->marcas, sizeof(MarcaTempo), ix->total_marcas, arquivo) == ix->total_marcas;
+    }
+    for (size_t i = 0; ok && i < ix->total_pares; ) {
+        EntradaIndiceLogin entrada;
+        size_t fim = i;
+        while (fim < ix->total_pares && strcmp(ix->pares[fim].login, ix->pares[i].login) == 0) {
+            fim++;
+        }
+        memset(&entrada, 0, sizeof(entrada));
+        snprintf(entrada.login, sizeof(entrada.login), "%s", ix->pares[i].login);
+        entrada.quantidade = (uint32_t)(fim - i);
+        entrada.primeiro = i;
+        ok = fwrite(&entrada, sizeof(entrada), 1, arquivo) == 1;
+        i = fim;
+    }
+    for (size_t i = 0; ok && i < ix->total_pares; i++) {
+        ok = fwrite(&ix->pares[i].offset, sizeof(uint64_t), 1, arquivo) == 1;
+    }
+
+    ok = (fclose(arquivo) == 0) && ok;
+#ifdef _WIN32
+    ok = ok && MoveFileExA(temporario, caminho, MOVEFILE_REPLACE_EXISTING);
+#else
+    ok = ok && rename(temporario, caminho) == 0;
+#endif
+    if (!ok) {
+        remove(temporario);
+    }
+    return ok;
+}
+
+// Reconstrói o índice de um segmento sem ".idx" e descarta a cauda inválida
+static int reindexarSegmento(const char *diretorio, uint64_t numero) {
+    char caminho[MAX_PATH + 32];
+    CabecalhoSegmento cabecalho;
+    EventoAuditoria evento;
+    Indexador ix;
+    uint32_t tamanho;
+    FILE *arquivo;
+
+    caminhoSegmento(diretorio, numero, "bin", caminho, sizeof(caminho));
+    arquivo = fopen(caminho, "rb");
+    if (arquivo == NULL) {
+        return 0;
+    }
+    if (fread(&cabecalho, sizeof(cabecalho), 1, arquivo) != 1 ||
+        cabecalho.magica != LOG_AUDITORIA_MAGICA) {
+        fclose(arquivo);
+        return 0;
+    }
+
+    memset(&ix, 0, sizeof(ix));
+    uint64_t offset = sizeof(CabecalhoSegmento);
+    while (lerRegistro(arquivo, &evento, &tamanho)) {
+        indexarRegistro(&ix, evento.instante_ms, evento.login, offset);
+        offset += tamanho;
+    }
+    fclose(arquivo);
+
+    int ok = gravarIndice(diretorio, numero, &ix, offset);
+    limparIndexador(&ix);
+    return ok;
+}
+
+// ========== ESCRITA ==========
+
+static char diretorio_escrita[MAX_PATH];
+static FILE *segmento = NULL;
+static uint64_t numero_segmento = 0;
+static uint64_t tam_segmento = 0;
+static int64_t criado_ms = 0;
+static int64_t ultimo_instante_ms = 0;
+static size_t bytes_pendentes = 0;
+static Indexador indexador;
+static long limite_tamanho = LOG_TAM_SEGMENTO;
+static long long limite_duracao_ms = LOG_DURACAO_SEGMENTO_MS;
+
+static int abrirSegmentoNovo(void) {
+    char caminho[MAX_PATH + 32];
+    CabecalhoSegmento cabecalho;
+
+    numero_segmento++;
+    caminhoSegmento(diretorio_escrita, numero_segmento, "bin", caminho, sizeof(caminho));
+    segmento = fopen(caminho, "wb");
+    if (segmento == NULL) {
+        printf("Erro: não foi possível criar o segmento %s.\n", caminho);
+        return 0;
+    }
+    setvbuf(segmento, NULL, _IOFBF, TAM_BUFFER_SEGMENTO);
+
+    criado_ms = agoraMs();
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    cabecalho.magica = LOG_AUDITORIA_MAGICA;
+    cabecalho.versao = LOG_AUDITORIA_VERSAO;
+    cabecalho.numero = numero_segmento;
+    cabecalho.criado_ms = criado_ms;
+    fwrite(&cabecalho, sizeof(cabecalho), 1, segmento);
+
+    tam_segmento = sizeof(cabecalho);
+    bytes_pendentes = sizeof(cabecalho);
+    memset(&indexador, 0, sizeof(indexador));
+    return 1;
+}
+
+// Fecha o segmento atual; um segmento vazio é apagado em vez de indexado
+static void fecharSegmento(void) {
+    char caminho[MAX_PATH + 32];
+
+    if (segmento == NULL) {
+        return;
+    }
+    fclose(segmento);
+    segmento = NULL;
+    bytes_pendentes = 0;
+
+    if (indexador.registros == 0) {
+        caminhoSegmento(diretorio_escrita, numero_segmento, "bin", caminho, sizeof(caminho));
+        remove(caminho);
+        numero_segmento--;
+    } else if (!gravarIndice(diretorio_escrita, numero_segmento, &indexador, tam_segmento)) {
+        printf("Aviso: índice do segmento %llu não gravado (será refeito ao reabrir).\n",
+               (unsigned long long)numero_segmento);
+    }
+    limparIndexador(&indexador);
+}
+
+int abrirLogAuditoria(const char *diretorio) {
+    char caminho[MAX_PATH + 32];
+    uint64_t numero = 0;
+
+    if (segmento != NULL) {
+        fecharLogAuditoria();
+    }
+    snprintf(diretorio_escrita, sizeof(diretorio_escrita), "%s", diretorio);
+    if (criarDiretorio(diretorio_escrita) != 0 && errno != EEXIST) {
+        printf("Erro: não foi possível criar o diretório %s.\n", diretorio_escrita);
+        return 0;
+    }
+
+    // Segmentos são numerados a partir de 1 sem lacunas
+    for (;;) {
+        caminhoSegmento(diretorio_escrita, numero + 1, "bin", caminho, sizeof(caminho));
+        if (!arquivoExiste(caminho)) {
+            break;
+        }
+        numero++;
+        caminhoSegmento(diretorio_escrita, numero, "idx", caminho, sizeof(caminho));
+        if (!arquivoExiste(caminho)) {
+            reindexarSegmento(diretorio_escrita, numero);
+        }
+    }
+
+    numero_segmento = numero;
+    ultimo_instante_ms = 0;
+    return abrirSegmentoNovo();
+}
+
+void configurarRotacaoLog(long tam_segmento_max, long long duracao_ms) {
+    limite_tamanho = (tam_segmento_max > 0) ? tam_segmento_max : LOG_TAM_SEGMENTO;
+    limite_duracao_ms = (duracao_ms > 0) ? duracao_ms : LOG_DURACAO_SEGMENTO_MS;
+}
+
+int anexarEventoLog(const EventoAuditoria *evento) {
+    unsigned char bruto[TAM_MAX_REGISTRO];
+    RegistroLog cabecalho;
+    const size_t apos_crc = offsetof(RegistroLog, instante_ms);
+
+    if (segmento == NULL || evento == NULL) {
+        return 0;
+    }
+
+    // Instantes não decrescentes: o índice de tempo depende disso
+    int64_t instante = evento->instante_ms;
+    if (instante < ultimo_instante_ms) {
+        instante = ultimo_instante_ms;
+    }
+
+    if (indexador.registros > 0 &&
+        ((long)tam_segmento >= limite_tamanho || instante - criado_ms >= limite_duracao_ms)) {
+        fecharSegmento();
+        if (!abrirSegmentoNovo()) {
+            return 0;
+        }
+    }
+
+    size_t login = strnlen(evento->login, MAX_LOGIN - 1);
+    size_t acao = strnlen(evento->acao, LOG_MAX_ACAO - 1);
+    size_t detalhes = strnlen(evento->detalhes, LOG_MAX_DETALHES - 1);
+
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    cabecalho.tamanho = (uint32_t)(sizeof(RegistroLog) + login + acao + detalhes);
+    cabecalho.instante_ms = instante;
+    cabecalho.destino = (uint8_t)evento->destino;
+    cabecalho.sucesso = (uint8_t)(evento->sucesso != 0);
+    cabecalho.tam_login = (uint8_t)login;
+    cabecalho.tam_acao = (uint8_t)acao;
+    cabecalho.tam_detalhes = (uint16_t)detalhes;
+
+    memcpy(bruto, &cabecalho, sizeof(cabecalho));
+    memcpy(bruto + sizeof(RegistroLog), evento->login, login);
+    memcpy(bruto + sizeof(RegistroLog) + login, evento->acao, acao);
+    memcpy(bruto + sizeof(RegistroLog) + login + acao, evento->detalhes, detalhes);
+    cabecalho.crc = calcularCrc(bruto + apos_crc, cabecalho.tamanho - apos_crc);
+    memcpy(bruto, &cabecalho, sizeof(cabecalho));
+
+    if (fwrite(bruto, 1, cabecalho.tamanho, segmento) != cabecalho.tamanho) {
+        return 0;
+    }
+
+    char login_texto[MAX_LOGIN];
+    memcpy(login_texto, evento->login, login);
+    login_texto[login] = '\0';
+    indexarRegistro(&indexador, instante, login_texto, tam_segmento);
+
+    tam_segmento += cabecalho.tamanho;
+    bytes_pendentes += cabecalho.tamanho;
+    ultimo_instante_ms = instante;
+    return 1;
+}
+
+int descarregarLogAuditoria(void) {
+    if (segmento == NULL || bytes_pendentes == 0) {
+        return 0;
+    }
+    fflush(segmento);
+    bytes_pendentes = 0;
+    return 1;
+}
+
+void fecharLogAuditoria(void) {
+    fecharSegmento();
+}
+
+// ========== CONSULTA ==========
+
+void filtroAuditoriaPadrao(FiltroAuditoria *filtro) {
+    filtro->login = NULL;
+    filtro->acao = NULL;
+    filtro->destino = -1;
+    filtro->sucesso = -1;
+    filtro->inicio_ms = 0;
+    filtro->fim_ms = INT64_MAX;
+}
+
+static int eventoAtendeFiltro(const EventoAuditoria *evento, const FiltroAuditoria *filtro) {
+    return evento->instante_ms >= filtro->inicio_ms && evento->instante_ms <= filtro->fim_ms &&
+           (filtro->login == NULL || strcmp(evento->login, filtro->login) == 0) &&
+           (filtro->acao == NULL || strcmp(evento->acao, filtro->acao) == 0) &&
+           (filtro->destino < 0 || evento->destino == filtro->destino) &&
+           (filtro->sucesso < 0 || evento->sucesso == filtro->sucesso);
+}
+
+// Índice carregado inteiro em memória (NULL se ausente ou inválido)
+static unsigned char* carregarIndice(const char *diretorio, uint64_t numero, CabecalhoIndice *cabecalho) {
+    char caminho[MAX_PATH + 32];
+    unsigned char *dados;
+    FILE *arquivo;
+    long tamanho;
+
+    caminhoSegmento(diretorio, numero, "idx", caminho, sizeof(caminho));
+    arquivo = fopen(caminho, "rb");
+    if (arquivo == NULL) {
+        return NULL;
+    }
+    if (fseek(arquivo, 0, SEEK_END) != 0 || (tamanho = ftell(arquivo)) < (long)sizeof(CabecalhoIndice)) {
+        fclose(arquivo);
+        return NULL;
+    }
+    rewind(arquivo);
+    dados = malloc((size_t)tamanho);
+    if (dados == NULL || fread(dados, 1, (size_t)tamanho, arquivo) != (size_t)tamanho) {
+        free(dados);
+        fclose(arquivo);
+        return NULL;
+    }
+    fclose(arquivo);
+
+    memcpy(cabecalho, dados, sizeof(*cabecalho));
+    uint64_t esperado = sizeof(CabecalhoIndice) +
+                        (uint64_t)cabecalho->num_marcas * sizeof(MarcaTempo) +
+                        (uint64_t)cabecalho->num_logins * sizeof(EntradaIndiceLogin) +
+                        cabecalho->num_offsets * sizeof(uint64_t);
+    if (cabecalho->magica != LOG_INDICE_MAGICA || cabecalho->versao != LOG_AUDITORIA_VERSAO ||
+        esperado != (uint64_t)tamanho) {
+        free(dados);
+        return NULL;
+    }
+    return dados;
+}
+
+// Entrega os eventos do segmento; retorna 0 se o visitante pediu para parar
+static int consultarSegmento(const char *diretorio, uint64_t numero, const FiltroAuditoria *filtro,
+                             VisitanteAuditoria visitar, void *contexto, long *entregues) {
+    char caminho[MAX_PATH + 32];
+    CabecalhoIndice indice;
+    EventoAuditoria evento;
+    uint32_t tamanho;
+    int continuar = 1;
+
+    caminhoSegmento(diretorio, numero, "bin", caminho, sizeof(caminho));
+    FILE *arquivo = fopen(caminho, "rb");
+    if (arquivo == NULL) {
+        return 1;
+    }
+    unsigned char *dados = carregarIndice(diretorio, numero, &indice);
+    uint64_t inicio = sizeof(CabecalhoSegmento);
+    uint64_t limite = UINT64_MAX;
+
+    if (dados != NULL) {
+        const MarcaTempo *marcas = (const MarcaTempo *)(dados + sizeof(CabecalhoIndice));
+        const EntradaIndiceLogin *logins = (const EntradaIndiceLogin *)(marcas + indice.num_marcas);
+        const uint64_t *offsets = (const uint64_t *)(logins + indice.num_logins);
+
+        // Segmento inteiro fora do intervalo
+        if (indice.total_registros == 0 || indice.ultimo_ms < filtro->inicio_ms ||
+            indice.primeiro_ms > filtro->fim_ms) {
+            free(dados);
+            fclose(arquivo);
+            return 1;
+        }
+
+        // Por login: busca binária e leitura direta dos offsets
+        if (filtro->login != NULL) {
+            long esquerda = 0, direita = (long)indice.num_logins - 1;
+            const EntradaIndiceLogin *achado = NULL;
+            while (esquerda <= direita) {
+                long meio = (esquerda + direita) / 2;
+                int c = strcmp(logins[meio].login, filtro->login);
+                if (c == 0) {
+                    achado = &logins[meio];
+                    break;
+                }
+                if (c < 0) {
+                    esquerda = meio + 1;
+                } else {
+                    direita = meio - 1;
+                }
+            }
+            for (uint32_t i = 0; achado != NULL && continuar && i < achado->quantidade; i++) {
+                if (fseek(arquivo, (long)offsets[achado->primeiro + i], SEEK_SET) != 0 ||
+                    !lerRegistro(arquivo, &evento, &tamanho)) {
+                    break;
+                }
+                if (evento.instante_ms > filtro->fim_ms) {
+                    break;
+                }
+                if (eventoAtendeFiltro(&evento, filtro)) {
+                    (*entregues)++;
+                    continuar = visitar(&evento, contexto);
+                }
+            }
+            free(dados);
+            fclose(arquivo);
+            return continuar;
+        }
+
+        // Por tempo: começa na última marca anterior ao início
+        for (uint32_t i = 0; i < indice.num_marcas && marcas[i].instante_ms < filtro->inicio_ms; i++) {
+            inicio = marcas[i].offset;
+        }
+        limite = indice.tam_segmento;
+        free(dados);
+    }
+
+    // Varredura sequencial (segmento ativo ou a partir da marca)
+    if (fseek(arquivo, (long)inicio, SEEK_SET) == 0) {
+        uint64_t offset = inicio;
+        while (continuar && offset < limite && lerRegistro(arquivo, &evento, &tamanho)) {
+            offset += tamanho;
+            if (evento.instante_ms > filtro->fim_ms) {
+                break;
+            }
+            if (eventoAtendeFiltro(&evento, filtro)) {
+                (*entregues)++;
+                continuar = visitar(&evento, contexto);
+            }
+        }
+    }
+    fclose(arquivo);
+    return continuar;
+}
+
+long consultarLogAuditoria(const char *diretorio, const FiltroAuditoria *filtro,
+                           VisitanteAuditoria visitar, void *contexto) {
+    char caminho[MAX_PATH + 32];
+    FiltroAuditoria padrao;
+    long entregues = 0;
+
+    if (!arquivoExiste(diretorio)) {
+        return -1;
+    }
+    if (filtro == NULL) {
+        filtroAuditoriaPadrao(&padrao);
+        filtro = &padrao;
+    }
+
+    for (uint64_t numero = 1; ; numero++) {
+        caminhoSegmento(diretorio, numero, "bin", caminho, sizeof(caminho));
+        if (!arquivoExiste(caminho) ||
+            !consultarSegmento(diretorio, numero, filtro, visitar, contexto, &entregues)) {
+            break;
+        }
+    }
+    return entregues;
+}
+
+// ========== EXPORTAÇÃO PARA TEXTO ==========
+
+void formatarEventoTexto(const EventoAuditoria *evento, char *destino, size_t tamanho) {
+    char horario[32];
+    time_t segundos = (time_t)(evento->instante_ms / 1000);
+    struct tm partes;
+
+#ifdef _WIN32
+    localtime_s(&partes, &segundos);
+#else
+    localtime_r(&segundos, &partes);
+#endif
+    strftime(horario, sizeof(horario), "%a %b %e %H:%M:%S %Y", &partes);
+
+    // Mesmas linhas de auth_log.txt e acoes_log.txt
+    if (evento->destino == DESTINO_AUTH) {
+        snprintf(destino, tamanho, "[%s] %s %s - Usuario: %s", horario, evento->acao,
+                 evento->sucesso ? "SUCESSO" : "FALHA", evento->login);
+    } else if (strcmp(evento->acao, "MENSAGEM") == 0) {
+        snprintf(destino, tamanho, "[%s] %s", horario, evento->detalhes);
+    } else if (evento->login[0] != '\0') {
+        snprintf(destino, tamanho, "[%s] ACAO %s - Usuario: %s - %s", horario, evento->acao,
+                 evento->login, evento->detalhes);
+    } else {
+        snprintf(destino, tamanho, "[%s] %s %s", horario, evento->acao, evento->detalhes);
+    }
+}
+
+static int escreverLinhaTexto(const EventoAuditoria *evento, void *contexto) {
+    char linha[512];
+
+    formatarEventoTexto(evento, linha, sizeof(linha));
+    fprintf((FILE *)contexto, "%s\n", linha);
+    return 1;
+}
+
+long exportarLogTexto(const char *diretorio, const FiltroAuditoria *filtro, FILE *saida) {
+    long linhas = consultarLogAuditoria(diretorio, filtro, escreverLinhaTexto, saida);
+    return linhas < 0 ? 0 : linhas;
+}
+
+int removerSegmentosLog(const char *diretorio) {
+    char caminho[MAX_PATH + 32];
+    int removidos = 0;
+
+    for (uint64_t numero = 1; ; numero++) {
+        caminhoSegmento(diretorio, numero, "bin", caminho, sizeof(caminho));
+        if (!arquivoExiste(caminho)) {
+            break;
+        }
+        remove(caminho);
+        caminhoSegmento(diretorio, numero, "idx", caminho, sizeof(caminho));
+        remove(caminho);
+        removidos++;
+    }
+    return removidos;
+}
@@ -0,0 +1,151 @@
+#ifndef LOG_AUDITORIA_MANAGER_H
+#define LOG_AUDITORIA_MANAGER_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "structs.h"
+
+// ========== LOG DE AUDITORIA BINÁRIO, INDEXADO E ROTACIONADO ==========
+//
+// Os eventos de auditoria ficam em segmentos "<dir>/seg_<n>.bin":
+//   CabecalhoSegmento | RegistroLog + login + ação + detalhes | ...
+// Cada registro leva o próprio tamanho e um CRC-32: a leitura para no primeiro
+// registro incompleto (queda no meio de uma gravação) sem perder os anteriores.
+//
+// O segmento é trocado ao passar de um tamanho ou de uma duração. Ao fechar,
+// é gravado "<dir>/seg_<n>.idx" com:
+// - intervalo de tempo e total de registros (segmentos fora do intervalo da
+//   consulta nem são abertos);
+// - índice esparso de tempo: (instante, offset) a cada LOG_INTERVALO_MARCAS
+//   registros;
+// - índice por login: logins ordenados, cada um com a lista de offsets.
+// O segmento ainda aberto (ou um que ficou sem índice após uma queda) é lido
+// sequencialmente; ao reabrir o log, segmentos sem índice são reindexados.
+//
+// Um único processo escreve no diretório (a escritora de auditoria_manager);
+// qualquer processo pode consultar ao mesmo tempo.
+
+#define LOG_AUDITORIA_DIR "data/auditoria"
+#define LOG_AUDITORIA_MAGICA 0x414D4950u   // "PIMA"
+#define LOG_INDICE_MAGICA 0x494D4950u      // "PIMI"
+#define LOG_AUDITORIA_VERSAO 1
+
+#define LOG_TAM_SEGMENTO (4L * 1024 * 1024)            // Rotação por tamanho
+#define LOG_DURACAO_SEGMENTO_MS (24LL * 3600 * 1000)   // Rotação por tempo
+#define LOG_INTERVALO_MARCAS 64
+
+#define LOG_MAX_ACAO 32
+#define LOG_MAX_DETALHES 160
+
+// Evento decodificado
+typedef struct {
+    int64_t instante_ms;       // Milissegundos desde 1970 (UTC)
+    int destino;               // AUDITORIA_AUTH ou AUDITORIA_ACOES
+    int sucesso;               // 1 = sucesso, 0 = falha
+    char login[MAX_LOGIN];
+    char acao[LOG_MAX_ACAO];
+    char detalhes[LOG_MAX_DETALHES];
+} EventoAuditoria;
+
+// ========== FORMATO EM DISCO ==========
+
+typedef struct {
+    uint32_t magica;           // LOG_AUDITORIA_MAGICA
+    uint32_t versao;
+    uint64_t numero;           // n de "seg_<n>.bin"
+    int64_t criado_ms;
+} CabecalhoSegmento;
+
+typedef struct {
+    uint32_t tamanho;          // Registro inteiro, textos incluídos
+    uint32_t crc;              // CRC-32 dos bytes após este campo
+    int64_t instante_ms;
+    uint8_t destino;
+    uint8_t sucesso;
+    uint8_t tam_login;
+    uint8_t tam_acao;
+    uint16_t tam_detalhes;
+    uint16_t reservado;
+} RegistroLog;
+
+typedef struct {
+    uint32_t magica;           // LOG_INDICE_MAGICA
+    uint32_t versao;
+    uint64_t total_registros;
+    int64_t primeiro_ms;
+    int64_t ultimo_ms;
+    uint64_t tam_segmento;     // Bytes válidos do segmento indexado
+    uint32_t num_marcas;
+    uint32_t num_logins;
+    uint64_t num_offsets;
+} CabecalhoIndice;
+// Seguido de MarcaTempo[num_marcas], EntradaIndiceLogin[num_logins] e
+// uint64_t offsets[num_offsets] (agrupados por login)
+
+typedef struct {
+    int64_t instante_ms;
+    uint64_t offset;
+} MarcaTempo;
+
+typedef struct {
+    char login[MAX_LOGIN];
+    uint32_t quantidade;
+    uint64_t primeiro;         // Posição em offsets[]
+} EntradaIndiceLogin;
+
+// ========== ESCRITA (UM PROCESSO) ==========
+
+// Função para abrir o log no diretório (reindexa segmentos sem índice e
+// inicia um segmento novo)
+// Retorna: 1 se sucesso, 0 se erro
+int abrirLogAuditoria(const char *diretorio);
+
+// Função para ajustar a rotação (valores <= 0 mantêm o padrão)
+void configurarRotacaoLog(long tam_segmento, long long duracao_ms);
+
+// Função para acrescentar um evento ao segmento atual (bufferizado)
+// Retorna: 1 se sucesso, 0 se erro
+int anexarEventoLog(const EventoAuditoria *evento);
+
+// Função para entregar ao sistema o que está no buffer
+// Retorna: 1 se havia dados a gravar, 0 caso contrário
+int descarregarLogAuditoria(void);
+
+// Função para fechar o segmento atual gravando seu índice
+void fecharLogAuditoria(void);
+
+// ========== CONSULTA (QUALQUER PROCESSO) ==========
+
+// Filtro de consulta (campos NULL / -1 não filtram)
+typedef struct {
+    const char *login;
+    const char *acao;
+    int destino;
+    int sucesso;
+    int64_t inicio_ms;         // Intervalo fechado [inicio_ms, fim_ms]
+    int64_t fim_ms;
+} FiltroAuditoria;
+
+// Função para preencher um filtro que aceita tudo
+void filtroAuditoriaPadrao(FiltroAuditoria *filtro);
+
+// Chamada para cada evento encontrado; retornar 0 interrompe a consulta
+typedef int (*VisitanteAuditoria)(const EventoAuditoria *evento, void *contexto);
+
+// Função para consultar o log em ordem cronológica de segmento
+// Retorna: quantidade de eventos entregues ao visitante (-1 se o diretório não existe)
+long consultarLogAuditoria(const char *diretorio, const FiltroAuditoria *filtro,
+                           VisitanteAuditoria visitar, void *contexto);
+
+// Função para formatar o evento como a linha dos antigos logs de texto
+void formatarEventoTexto(const EventoAuditoria *evento, char *destino, size_t tamanho);
+
+// Função para exportar os eventos filtrados como texto
+// Retorna: linhas gravadas
+long exportarLogTexto(const char *diretorio, const FiltroAuditoria *filtro, FILE *saida);
+
+// Função para apagar todos os segmentos e índices do diretório
+// Retorna: segmentos removidos
+int removerSegmentosLog(const char *diretorio);
+
+#endif
@@ -9,6 +9,18 @@
 #include "aula_manager.h"
 #include "atividade_manager.h"
 #include "usuario_manager.h"
+#include "exportacao_manager.h"
+#include "tabela_manager.h"
+#include "relatorio_manager.h"
+#include "frequencia_manager.h"
+#include "nota_manager.h"
+#include "journal_manager.h"
+
+// Gravação adiada do modo manual
+#define INTERVALO_GRAVACAO_MS 2000
+#define LIMITE_ALTERACOES_PENDENTES 64
+
+#define DIRETORIO_RELATORIOS "data"
 
 static int lerLinha(char *destino, size_t tamanho) {
     if (fgets(destino, (int)tamanho, stdin) == NULL) {
@@ -48,6 +60,20 @@ static int lerInteiroObrigatorio(const char *prompt) {
     }
 }
 
+// Lê números separados por espaço, vírgula ou ponto e vírgula (ENTER = nenhum)
+static int lerListaInteiros(const char *prompt, int *destino, int max) {
+    char buffer[MAX_CONTEUDO];
+    int total = 0;
+
+    printf("%s", prompt);
+    if (lerLinha(buffer, sizeof(buffer))) {
+        for (char *parte = strtok(buffer, " ,;"); parte != NULL && total < max; parte = strtok(NULL, " ,;")) {
+            destino[total++] = atoi(parte);
+        }
+    }
+    return total;
+}
+
 static int lerInteiroOpcional(const char *prompt, int atual) {
     char buffer[64];
     int valor;
@@ -250,8 +276,13 @@ static void cadastrarTurmaManual(void) {
     turma.ano = lerInteiroObrigatorio("Ano letivo: ");
     turma.semestre = lerInteiroObrigatorio("Semestre (1 ou 2): ");
 
-    if (cadastrarTurma(&turma)) {
-        printf("Turma cadastrada com sucesso!\n");
+    // Turma e matrículas entram juntas (nada é gravado se um RA falhar)
+    int ras[MAX_ALUNOS];
+    int totalRas = lerListaInteiros("RAs a matricular separados por espaco ou virgula (ENTER = nenhum): ",
+                                    ras, MAX_ALUNOS);
+
+    if (cadastrarTurmaComAlunos(&turma, ras, totalRas)) {
+        printf("Turma cadastrada com sucesso (%d aluno(s) matriculado(s))!\n", totalRas);
     } else {
         printf("Falha ao cadastrar turma.\n");
     }
@@ -333,8 +364,34 @@ static void atualizarTurmaManual(void) {
 
 static void excluirTurmaManual(void) {
     int id = lerInteiroObrigatorio("\nInforme o ID da turma para excluir: ");
+    DependentesTurma dependentes;
+    char resposta[8];
+    int ok;
+
+    // Simulação: mostra o que sairia junto com a turma
+    if (!excluirTurmaEmCascata(id, 1, &dependentes)) {
+        aguardarEnter();
+        return;
+    }
 
-    if (excluirTurma(id)) {
+    if (dependentes.aulas + dependentes.atividades + dependentes.matriculas == 0) {
+        ok = excluirTurma(id);
+    } else {
+        printf("A turma possui %d aula(s), %d atividade(s) com %d nota(s), %d matricula(s) "
+               "e %d chamada(s).\n",
+               dependentes.aulas, dependentes.atividades, dependentes.notas,
+               dependentes.matriculas, dependentes.chamadas);
+        printf("Excluir a turma com todos esses registros? (s/n): ");
+        lerLinha(resposta, sizeof(resposta));
+        if (resposta[0] != 's' && resposta[0] != 'S') {
+            printf("Exclusao cancelada.\n");
+            aguardarEnter();
+            return;
+        }
+        ok = excluirTurmaEmCascata(id, 0, &dependentes);
+    }
+
+    if (ok) {
         printf("Turma excluida com sucesso.\n");
     } else {
         printf("Falha ao excluir turma.\n");
@@ -385,8 +442,8 @@ static void removerAlunoTurmaManual(void) {
 
 static void listarAlunosDaTurmaManual(void) {
     int idTurma = lerInteiroObrigatorio("\nInforme o ID da turma: ");
-    int ras[MAX_ALUNOS];
-    int total = listarAlunosDaTurma(idTurma, ras, MAX_ALUNOS);
+    Aluno alunos[MAX_ALUNOS];
+    int total = listarAlunosDaTurmaDetalhado(idTurma, 0, alunos, MAX_ALUNOS);
 
     printf("\n=== Alunos da Turma %d (%d registros) ===\n", idTurma, total);
 
@@ -397,11 +454,10 @@ static void listarAlunosDaTurmaManual(void) {
     }
 
     for (int i = 0; i < total; i++) {
-        Aluno *aluno = buscarAlunoPorRA(ras[i]);
-        if (aluno != NULL) {
-            printf("RA %d - %s (%s)\n", aluno->ra, aluno->nome, aluno->ativo ? "Ativo" : "Inativo");
+        if (alunos[i].ativo >= 0) {
+            printf("RA %d - %s (%s)\n", alunos[i].ra, alunos[i].nome, alunos[i].ativo ? "Ativo" : "Inativo");
         } else {
-            printf("RA %d - [nao encontrado]\n", ras[i]);
+            printf("RA %d - [nao encontrado]\n", alunos[i].ra);
         }
     }
 
@@ -618,6 +674,73 @@ static void excluirAulaManual(void) {
     aguardarEnter();
 }
 
+static void moverAulasManual(void) {
+    int ids[MAX_AULAS];
+
+    printf("\n=== Mover Aulas para Outra Turma ===\n");
+    int total = lerListaInteiros("IDs das aulas separados por espaco ou virgula: ", ids, MAX_AULAS);
+    if (total == 0) {
+        printf("Nenhuma aula informada.\n");
+        aguardarEnter();
+        return;
+    }
+    int idTurma = lerInteiroObrigatorio("ID da turma de destino: ");
+
+    // Todas ou nenhuma; as chamadas das aulas movidas são descartadas
+    int movidas = moverAulasParaTurma(ids, total, idTurma);
+    if (movidas >= 0) {
+        printf("%d aula(s) movida(s) para a turma %d.\n", movidas, idTurma);
+    } else {
+        printf("Falha ao mover aulas; nenhuma foi alterada.\n");
+    }
+
+    aguardarEnter();
+}
+
+static void registrarChamadaManual(void) {
+    int idAula = lerInteiroObrigatorio("\nInforme o ID da aula: ");
+    int ausentes[MAX_ALUNOS];
+    int totalAusentes = lerListaInteiros("RAs ausentes separados por espaco ou virgula (ENTER = todos presentes): ",
+                                         ausentes, MAX_ALUNOS);
+
+    int total = registrarChamada(idAula, ausentes, totalAusentes);
+    if (total >= 0) {
+        printf("Chamada registrada: %d presentes de %d alunos.\n", contarPresentesAula(idAula, NULL), total);
+    } else {
+        printf("Falha ao registrar chamada.\n");
+    }
+
+    aguardarEnter();
+}
+
+static void frequenciaDaTurmaManual(void) {
+    int idTurma = lerInteiroObrigatorio("\nInforme o ID da turma: ");
+    FrequenciaAluno frequencias[MAX_ALUNOS];
+    FrequenciaTurma turma;
+
+    int chamadas = frequenciaDaTurma(idTurma, &turma);
+    printf("\n=== Frequencia da Turma %d (%d chamadas) ===\n", idTurma, chamadas);
+
+    if (chamadas == 0) {
+        printf("Nenhuma chamada registrada para a turma.\n");
+        aguardarEnter();
+        return;
+    }
+
+    printf("Frequencia geral: %.1f%% (%lld presencas de %lld)\n",
+           turma.matriculados ? 100.0 * (double)turma.presencas / (double)turma.matriculados : 0.0,
+           turma.presencas, turma.matriculados);
+
+    int total = frequenciaAlunosDaTurma(idTurma, frequencias, MAX_ALUNOS);
+    for (int i = 0; i < total; i++) {
+        printf("RA %d - %d/%d aulas (%.1f%%)\n", frequencias[i].ra, frequencias[i].presencas,
+               frequencias[i].chamadas,
+               frequencias[i].chamadas ? 100.0 * frequencias[i].presencas / frequencias[i].chamadas : 0.0);
+    }
+
+    aguardarEnter();
+}
+
 static void menuAulas(void) {
     int opcao;
 
@@ -628,6 +751,9 @@ static void menuAulas(void) {
         printf("3. Listar aulas por turma\n");
         printf("4. Alterar aula\n");
         printf("5. Excluir aula\n");
+        printf("6. Registrar chamada (frequencia)\n");
+        printf("7. Frequencia da turma\n");
+        printf("8. Mover aulas para outra turma\n");
         printf("0. Voltar ao menu principal\n");
 
         opcao = lerInteiroObrigatorio("Escolha uma opcao: ");
@@ -648,6 +774,15 @@ static void menuAulas(void) {
             case 5:
                 excluirAulaManual();
                 break;
+            case 6:
+                registrarChamadaManual();
+                break;
+            case 7:
+                frequenciaDaTurmaManual();
+                break;
+            case 8:
+                moverAulasManual();
+                break;
             case 0:
                 break;
             default:
@@ -791,6 +926,78 @@ static void excluirAtividadeManual(void) {
     aguardarEnter();
 }
 
+static void lancarNotaManual(void) {
+    char buffer[64];
+    float nota;
+
+    int idAtividade = lerInteiroObrigatorio("\nInforme o ID da atividade: ");
+    int ra = lerInteiroObrigatorio("RA do aluno: ");
+    while (1) {
+        lerStringObrigatoria("Nota (0 a 10): ", buffer, sizeof(buffer));
+        for (char *c = buffer; *c; c++) {
+            if (*c == ',') {
+                *c = '.';      // Aceita "7,5"
+            }
+        }
+        if (sscanf(buffer, "%f", &nota) == 1) {
+            break;
+        }
+        printf("Entrada invalida. Digite um numero.\n");
+    }
+
+    if (lancarNota(ra, idAtividade, nota)) {
+        printf("Nota lancada com sucesso!\n");
+    } else {
+        printf("Falha ao lancar nota.\n");
+    }
+
+    aguardarEnter();
+}
+
+static void importarNotasManual(void) {
+    char caminho[MAX_PATH];
+
+    lerStringObrigatoria("\nArquivo CSV (RA,ID_Atividade,Nota): ", caminho, sizeof(caminho));
+    int total = importarNotas(caminho);
+    if (total >= 0) {
+        printf("%d notas importadas (linhas invalidas foram ignoradas).\n", total);
+    } else {
+        printf("Falha ao ler o arquivo %s.\n", caminho);
+    }
+
+    aguardarEnter();
+}
+
+static void notasDaTurmaManual(void) {
+    int idTurma = lerInteiroObrigatorio("\nInforme o ID da turma: ");
+    EstatisticasNotas estatisticas;
+    int ras[MAX_ALUNOS];
+    double medias[MAX_ALUNOS];
+
+    estatisticasDaTurma(idTurma, &estatisticas);
+    printf("\n=== Notas da Turma %d (%d lancadas) ===\n", idTurma, estatisticas.quantidade);
+
+    if (estatisticas.quantidade == 0) {
+        printf("Nenhuma nota lancada para a turma.\n");
+        aguardarEnter();
+        return;
+    }
+
+    printf("Media: %.2f | Desvio padrao: %.2f | Minima: %.2f | Maxima: %.2f\n", estatisticas.media,
+           estatisticas.desvio, (double)estatisticas.minima, (double)estatisticas.maxima);
+    for (int f = 0; f < FAIXAS_HISTOGRAMA; f++) {
+        printf("%2d a %2d: %d\n", f, f + 1, estatisticas.histograma[f]);
+    }
+
+    int total = mediasDaTurma(idTurma, ras, medias, MAX_ALUNOS);
+    printf("--- Media por aluno ---\n");
+    for (int i = 0; i < total; i++) {
+        printf("RA %d - %.2f\n", ras[i], medias[i]);
+    }
+
+    aguardarEnter();
+}
+
 static void menuAtividades(void) {
     int opcao;
 
@@ -801,6 +1008,9 @@ static void menuAtividades(void) {
         printf("3. Listar atividades por turma\n");
         printf("4. Alterar atividade\n");
         printf("5. Excluir atividade\n");
+        printf("6. Lancar nota\n");
+        printf("7. Importar notas (CSV)\n");
+        printf("8. Notas da turma\n");
         printf("0. Voltar ao menu principal\n");
 
         opcao = lerInteiroObrigatorio("Escolha uma opcao: ");
@@ -821,6 +1031,15 @@ static void menuAtividades(void) {
             case 5:
                 excluirAtividadeManual();
                 break;
+            case 6:
+                lancarNotaManual();
+                break;
+            case 7:
+                importarNotasManual();
+                break;
+            case 8:
+                notasDaTurmaManual();
+                break;
             case 0:
                 break;
             default:
@@ -1007,9 +1226,64 @@ static void menuUsuarios(void) {
     } while (opcao != 0);
 }
 
-int main(void) {
+// "--relatorios": diário de classe das turmas alteradas desde o último lote
+// "--relatorios-completos": de todas as turmas
+static int gerarTodosRelatorios(int completos) {
+    ResultadoLoteRelatorios resultado;
+
+    int gerados = completos ? gerarRelatoriosTodasTurmas(DIRETORIO_RELATORIOS, 0, &resultado)
+                            : atualizarRelatoriosTurmas(DIRETORIO_RELATORIOS, 0, &resultado);
+    if (gerados < 0) {
+        printf("Erro ao gerar relatorios em %s.\n", DIRETORIO_RELATORIOS);
+        return 1;
+    }
+
+    printf("%-10s %-8s %-10s %s\n", "Turma", "Aulas", "us", "Arquivo");
+    for (int i = 0; i < resultado.total_turmas; i++) {
+        const TempoRelatorio *tempo = &resultado.tempos[i];
+        if (tempo->reescrito || !tempo->ok) {
+            printf("%-10d %-8d %-10.0f %s/relatorio_turma_%d.txt%s\n", tempo->id_turma, tempo->aulas,
+                   tempo->microssegundos, DIRETORIO_RELATORIOS, tempo->id_turma, tempo->ok ? "" : " (falhou)");
+        }
+    }
+    printf("%d de %d relatorios em dia: %d reescritos, %d removidos, em %.2f ms (%d threads; carga %.2f ms)\n",
+           gerados, resultado.total_turmas, resultado.reescritos, resultado.removidos,
+           resultado.segundos_total * 1e3, resultado.threads, resultado.segundos_carga * 1e3);
+
+    int falhas = resultado.total_turmas - gerados;
+    liberarResultadoLote(&resultado);
+    return falhas ? 1 : 0;
+}
+
+int main(int argc, char *argv[]) {
     int opcao;
 
+    int gravacao_adiada = 0;
+
+    // Conclui uma exclusão em cascata interrompida antes de ler qualquer CSV
+    recuperarJournal();
+
+    // "--exportar": este processo publica as tabelas em memória compartilhada
+    // "--gravacao-adiada": grava os CSVs em segundo plano (um único escritor)
+    // "--relatorios" / "--relatorios-completos": gera os relatórios e encerra
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--relatorios") == 0 || strcmp(argv[i], "--relatorios-completos") == 0) {
+            return gerarTodosRelatorios(strcmp(argv[i], "--relatorios-completos") == 0);
+        }
+        if (strcmp(argv[i], "--exportar") == 0 && habilitarExportacao()) {
+            printf("%d tabelas exportadas em memoria compartilhada.\n", exportarTodasTabelas());
+        } else if (strcmp(argv[i], "--gravacao-adiada") == 0) {
+            gravacao_adiada = 1;
+        }
+    }
+
+    // Com a gravação adiada, alterações ficam em memória e são gravadas em
+    // segundo plano; a saída do programa (inclusive por exit()) grava o que
+    // estiver pendente
+    if (gravacao_adiada && iniciarGravacaoAdiada(INTERVALO_GRAVACAO_MS, LIMITE_ALTERACOES_PENDENTES)) {
+        atexit(encerrarGravacaoAdiada);
+    }
+
     do {
         printf("\n============================================\n");
         printf("       SISTEMA ACADEMICO - MODO MANUAL       \n");
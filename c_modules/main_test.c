@@ -1,7 +1,22 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#endif
 
 #include "structs.h"
 #include "aluno_manager.h"
@@ -9,6 +24,22 @@
 #include "aula_manager.h"
 #include "atividade_manager.h"
 #include "usuario_manager.h"
+#include "exportacao_manager.h"
+#include "persistencia_manager.h"
+#include "tabela_manager.h"
+#include "auth_manager.h"
+#include "auditoria_manager.h"
+#include "limitador_manager.h"
+#include "relatorio_manager.h"
+#include "agregado_manager.h"
+#include "frequencia_manager.h"
+#include "nota_manager.h"
+#include "journal_manager.h"
+#include "verificacao_manager.h"
+#include "backup_manager.h"
+#include "alteracoes_manager.h"
+#include "replicacao_manager.h"
+#include "assinatura_manager.h"
 
 #define RESET   "\033[0m"
 #define RED     "\033[31m"
@@ -59,10 +90,13 @@ static int gerarRaNovo(void) {
     return maior + 1;
 }
 
+// Login ainda não cadastrado (um usuário de execução anterior não colide)
 static void gerarLoginTeste(char *destino, size_t tamanho) {
     static int sequencia = 1;
     long marcador = (long)time(NULL) % 100000;
-    snprintf(destino, tamanho, "user_teste_%ld_%d", marcador, sequencia++);
+    do {
+        snprintf(destino, tamanho, "user_teste_%ld_%d", marcador, sequencia++);
+    } while (buscarUsuarioPorLogin(destino) != NULL);
 }
 
 static void exibirMenu(void) {
@@ -79,6 +113,28 @@ static void exibirMenu(void) {
     printf("%s[6]%s Testar modulo de Usuarios\n", GREEN, RESET);
     printf("%s[7]%s Testar geracao de Relatorios\n", GREEN, RESET);
     printf("%s[8]%s Executar todos os testes\n", MAGENTA, RESET);
+    printf("%s[9]%s Teste de concorrencia (leitores/escritores)\n", GREEN, RESET);
+    printf("%s[10]%s Teste de contencao entre processos (travas de arquivo)\n", GREEN, RESET);
+    printf("%s[11]%s Teste de exportacao em memoria compartilhada\n", GREEN, RESET);
+    printf("%s[12]%s Teste de persistencia assincrona (io_uring / threads)\n", GREEN, RESET);
+    printf("%s[13]%s Teste de gravacao adiada (write-behind)\n", GREEN, RESET);
+    printf("%s[14]%s Teste do log de auditoria (anel + escritora)\n", GREEN, RESET);
+    printf("%s[15]%s Teste do log binario (indices, rotacao, recuperacao)\n", GREEN, RESET);
+    printf("%s[16]%s Teste da tabela de sessoes (tokens, expiracao)\n", GREEN, RESET);
+    printf("%s[17]%s Teste de carga do limitador de login\n", GREEN, RESET);
+    printf("%s[18]%s Teste de relatorios em lote (todas as turmas)\n", GREEN, RESET);
+    printf("%s[19]%s Teste de atualizacao incremental dos relatorios\n", GREEN, RESET);
+    printf("%s[20]%s Teste das visoes agregadas (contadores por turma/professor)\n", GREEN, RESET);
+    printf("%s[21]%s Teste da frequencia por aula (bitsets de chamada)\n", GREEN, RESET);
+    printf("%s[22]%s Teste das notas (boletim em colunas)\n", GREEN, RESET);
+    printf("%s[23]%s Teste dos alunos da turma juntados ao cadastro\n", GREEN, RESET);
+    printf("%s[24]%s Teste da exclusao de turma em cascata (journal)\n", GREEN, RESET);
+    printf("%s[25]%s Teste da verificacao de integridade dos CSVs (fsck)\n", GREEN, RESET);
+    printf("%s[26]%s Teste das transacoes entre tabelas (turma com alunos, mover aulas)\n", GREEN, RESET);
+    printf("%s[27]%s Teste do backup consistente com escritas em andamento\n", GREEN, RESET);
+    printf("%s[28]%s Teste do backup incremental e da restauracao da cadeia\n", GREEN, RESET);
+    printf("%s[29]%s Teste da replicacao para um diretorio reserva\n", GREEN, RESET);
+    printf("%s[30]%s Teste da assinatura de alteracoes (eventos por tabela, retomada, lotes)\n", GREEN, RESET);
     printf("%s[0]%s Sair\n", RED, RESET);
     printf("\n%sEscolha uma opcao: %s", YELLOW, RESET);
 }
@@ -400,82 +456,3459 @@ static void testarRelatorios(void) {
     printf("\n%sGeracao de relatorio testada com sucesso.%s\n", GREEN, RESET);
 }
 
-static void executarTodosTestes(void) {
-    imprimirTitulo("EXECUTANDO TODOS OS TESTES", MAGENTA);
+// ========== TESTE DE CONCORRÊNCIA ==========
+
+#define CONC_LEITORES 8
+#define CONC_ESCRITORES 2
+#define CONC_LEITURAS 2000
+#define CONC_ESCRITAS 20
+
+typedef struct {
+    int ra;
+    int id_thread;
+    int inconsistencias;
+    int leituras;
+} ArgConcorrencia;
+
+// Leitor: nome e email sempre carregam o mesmo contador; divergência = leitura rasgada
+static void *leitorConcorrente(void *arg) {
+    ArgConcorrencia *dados = (ArgConcorrencia *)arg;
+    Aluno copia;
+    Aluno lista[64];
+
+    for (int i = 0; i < CONC_LEITURAS; i++) {
+        if (obterAlunoPorRA(dados->ra, &copia)) {
+            int n_nome = -1, n_email = -2;
+            sscanf(copia.nome, "Concorrencia %d", &n_nome);
+            sscanf(copia.email, "c%d@pim.com", &n_email);
+            if (n_nome != n_email) {
+                dados->inconsistencias++;
+            }
+            dados->leituras++;
+        }
+        if (i % 100 == 0) {
+            listarAlunos(lista, 64);
+        }
+    }
 
-    testarModuloAlunos();
-    aguardarEnter();
+    return NULL;
+}
 
-    testarModuloTurmas();
-    aguardarEnter();
+static void *escritorConcorrente(void *arg) {
+    ArgConcorrencia *dados = (ArgConcorrencia *)arg;
+    Aluno aluno;
+
+    for (int i = 0; i < CONC_ESCRITAS; i++) {
+        int valor = dados->id_thread * 1000 + i;
+        aluno.ra = dados->ra;
+        snprintf(aluno.nome, sizeof(aluno.nome), "Concorrencia %d", valor);
+        snprintf(aluno.email, sizeof(aluno.email), "c%d@pim.com", valor);
+        aluno.ativo = 1;
+        atualizarAluno(&aluno);
+    }
 
-    testarAssociacaoAlunoTurma();
-    aguardarEnter();
+    return NULL;
+}
 
-    testarModuloAulas();
-    aguardarEnter();
+static void testarConcorrencia(void) {
+    imprimirTitulo("TESTE: CONCORRENCIA LEITORES/ESCRITORES", BLUE);
 
-    testarModuloAtividades();
-    aguardarEnter();
+    int ra = gerarRaNovo();
+    Aluno aluno = {ra, "Concorrencia 0", "c0@pim.com", 1};
+    cadastrarAluno(&aluno);
 
-    testarModuloUsuarios();
-    aguardarEnter();
+    pthread_t threads[CONC_LEITORES + CONC_ESCRITORES];
+    ArgConcorrencia args[CONC_LEITORES + CONC_ESCRITORES];
+    int total_threads = CONC_LEITORES + CONC_ESCRITORES;
+
+    printf("%sDisparando %d leitores e %d escritores sobre o RA %d...%s\n",
+           YELLOW, CONC_LEITORES, CONC_ESCRITORES, ra, RESET);
+
+    for (int i = 0; i < total_threads; i++) {
+        args[i].ra = ra;
+        args[i].id_thread = i;
+        args[i].inconsistencias = 0;
+        args[i].leituras = 0;
+        pthread_create(&threads[i], NULL,
+                       i < CONC_LEITORES ? leitorConcorrente : escritorConcorrente,
+                       &args[i]);
+    }
 
-    testarRelatorios();
+    int inconsistencias = 0;
+    int leituras = 0;
+    for (int i = 0; i < total_threads; i++) {
+        pthread_join(threads[i], NULL);
+        inconsistencias += args[i].inconsistencias;
+        leituras += args[i].leituras;
+    }
 
-    imprimirTitulo("TODOS OS TESTES FORAM EXECUTADOS", GREEN);
+    printf("\n  Leituras realizadas: %d\n", leituras);
+    printf("  Leituras inconsistentes: %d\n", inconsistencias);
+
+    excluirAluno(ra);
+
+    if (inconsistencias == 0 && leituras == CONC_LEITORES * CONC_LEITURAS) {
+        printf("\n%sTeste de concorrencia concluido sem inconsistencias.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha: leituras inconsistentes ou perdidas.%s\n", RED, RESET);
+    }
 }
 
-int main(void) {
-    int opcao;
+// ========== TESTE DE CONTENÇÃO ENTRE PROCESSOS ==========
 
-    do {
-        exibirMenu();
-        if (scanf("%d", &opcao) != 1) {
-            printf("%s\nOpcao invalida! Digite um numero.%s\n", RED, RESET);
-            limparBuffer();
-            continue;
+#define CONTENCAO_PROCESSOS 4
+#define CONTENCAO_MATRICULAS 25
+
+static void testarContencaoProcessos(void) {
+    imprimirTitulo("TESTE: CONTENCAO ENTRE PROCESSOS (TRAVAS DE ARQUIVO)", BLUE);
+
+#ifdef _WIN32
+    printf("%sTeste disponivel apenas em sistemas POSIX (usa fork).%s\n", YELLOW, RESET);
+#else
+    int turmaId = gerarProximoIDTurma();
+    Turma turma = {turmaId, "ADS Contencao", "Professor Hugo", 2025, 1};
+    cadastrarTurma(&turma);
+
+    printf("%s%d processos matriculando %d alunos cada na turma %d...%s\n",
+           YELLOW, CONTENCAO_PROCESSOS, CONTENCAO_MATRICULAS, turmaId, RESET);
+    fflush(stdout);
+
+    pid_t filhos[CONTENCAO_PROCESSOS];
+    for (int p = 0; p < CONTENCAO_PROCESSOS; p++) {
+        filhos[p] = fork();
+        if (filhos[p] == 0) {
+            // Cada filho faz seus próprios ciclos leitura-modificação-escrita
+            if (freopen("/dev/null", "w", stdout) == NULL) {
+                _exit(2);
+            }
+            for (int i = 0; i < CONTENCAO_MATRICULAS; i++) {
+                associarAlunoTurma(900000 + p * 1000 + i, turmaId);
+            }
+            _exit(0);
         }
-        limparBuffer();
+    }
 
-        switch (opcao) {
-            case 1:
-                testarModuloAlunos();
-                aguardarEnter();
-                break;
-            case 2:
-                testarModuloTurmas();
-                aguardarEnter();
-                break;
-            case 3:
-                testarAssociacaoAlunoTurma();
-                aguardarEnter();
-                break;
-            case 4:
-                testarModuloAulas();
-                aguardarEnter();
-                break;
-            case 5:
-                testarModuloAtividades();
-                aguardarEnter();
-                break;
-            case 6:
-                testarModuloUsuarios();
-                aguardarEnter();
-                break;
-            case 7:
-                testarRelatorios();
-                aguardarEnter();
+    for (int p = 0; p < CONTENCAO_PROCESSOS; p++) {
+        waitpid(filhos[p], NULL, 0);
+    }
+
+    int ras[CONTENCAO_PROCESSOS * CONTENCAO_MATRICULAS + 1];
+    int total = listarAlunosDaTurma(turmaId, ras, CONTENCAO_PROCESSOS * CONTENCAO_MATRICULAS + 1);
+    int esperado = CONTENCAO_PROCESSOS * CONTENCAO_MATRICULAS;
+
+    printf("\n  Matriculas esperadas: %d\n", esperado);
+    printf("  Matriculas gravadas: %d\n", total);
+
+    for (int i = 0; i < total; i++) {
+        removerAlunoTurma(ras[i], turmaId);
+    }
+    excluirTurma(turmaId);
+
+    if (total == esperado) {
+        printf("\n%sNenhuma matricula perdida entre processos.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha: %d matriculas perdidas.%s\n", RED, esperado - total, RESET);
+    }
+
+    // Gravação que falha (o .tmp não pode ser criado) não fica só na memória
+    printf("\n%sCadastrando turma com o CSV impedido de ser gravado...%s\n", YELLOW, RESET);
+    Turma bloqueada = {gerarProximoIDTurma(), "ADS Sem Disco", "Professor Hugo", 2025, 1};
+    Turma lida;
+    mkdir(ARQUIVO_TURMAS ".tmp", 0700);
+    int cadastrada = cadastrarTurma(&bloqueada);
+    int na_memoria = obterTurmaPorID(bloqueada.id, &lida);
+    rmdir(ARQUIVO_TURMAS ".tmp");
+
+    if (!cadastrada && !na_memoria) {
+        printf("%sFalha de gravacao informada e alteracao desfeita.%s\n", GREEN, RESET);
+    } else {
+        printf("%sFalha: cadastro=%d, turma em memoria=%d apos gravacao falha.%s\n",
+               RED, cadastrada, na_memoria, RESET);
+        if (na_memoria) {
+            excluirTurma(bloqueada.id);
+        }
+    }
+#endif
+}
+
+// ========== TESTE DE EXPORTAÇÃO EM MEMÓRIA COMPARTILHADA ==========
+
+#define EXPORTACAO_VERSOES 200
+#define EXPORTACAO_MAX_LEITURAS 1000000
+#define EXPORTACAO_REGISTROS 300
+
+// Filho: confere que a tabela anexada é igual à listagem do pai
+static int conferirAlunosExportados(const Aluno *esperados, int total) {
+    static Aluno lidos[MAX_ALUNOS];
+    LeitorExportacao leitor;
+
+    if (!anexarExportacao(&leitor, EXPORTACAO_ALUNOS)) {
+        return 1;
+    }
+    int qtd = lerTabelaExportada(&leitor, lidos, MAX_ALUNOS, NULL);
+    desanexarExportacao(&leitor);
+
+    if (qtd != total) {
+        return 1;
+    }
+    for (int i = 0; i < total; i++) {
+        if (lidos[i].ra != esperados[i].ra || lidos[i].ativo != esperados[i].ativo ||
+            strcmp(lidos[i].nome, esperados[i].nome) != 0 ||
+            strcmp(lidos[i].email, esperados[i].email) != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Filho: toda leitura validada precisa vir de uma única versão
+// Lê até enxergar a última versão publicada pelo pai.
+static int contarLeiturasMisturadas(void) {
+    static Aluno lidos[EXPORTACAO_REGISTROS];
+    LeitorExportacao leitor;
+    int misturadas = 0;
+
+    while (!anexarExportacao(&leitor, EXPORTACAO_ALUNOS)) {
+        sched_yield();
+    }
+
+    for (int n = 0; n < EXPORTACAO_MAX_LEITURAS; n++) {
+        int qtd = lerTabelaExportada(&leitor, lidos, EXPORTACAO_REGISTROS, NULL);
+        char esperado[MAX_NOME];
+
+        if (qtd <= 0) {
+            continue;
+        }
+        if (lidos[0].ativo == EXPORTACAO_VERSOES) {
+            break;
+        }
+        snprintf(esperado, sizeof(esperado), "Versao %d", lidos[0].ativo);
+        for (int i = 0; i < qtd; i++) {
+            if (lidos[i].ativo != lidos[0].ativo || strcmp(lidos[i].nome, esperado) != 0) {
+                misturadas++;
                 break;
-            case 8:
-                executarTodosTestes();
+            }
+        }
+    }
+
+    desanexarExportacao(&leitor);
+    return misturadas > 255 ? 255 : misturadas;
+}
+
+static void testarExportacaoCompartilhada(void) {
+    imprimirTitulo("TESTE: EXPORTACAO EM MEMORIA COMPARTILHADA", BLUE);
+
+#ifdef _WIN32
+    printf("%sTeste disponivel apenas em sistemas POSIX (usa fork e shm_open).%s\n", YELLOW, RESET);
+#else
+    static Aluno alunos[MAX_ALUNOS];
+    static Aluno versao[EXPORTACAO_REGISTROS];
+    int status = 0;
+
+    if (!habilitarExportacao()) {
+        return;
+    }
+    printf("  Tabelas exportadas: %d\n", exportarTodasTabelas());
+    int total = listarAlunos(alunos, MAX_ALUNOS);
+    fflush(stdout);
+
+    // 1. Outro processo anexa e lê exatamente o que o dono publicou
+    pid_t filho = fork();
+    if (filho == 0) {
+        _exit(conferirAlunosExportados(alunos, total));
+    }
+    waitpid(filho, &status, 0);
+    int iguais = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    printf("  Leitor em outro processo (%d alunos): %s\n", total, iguais ? "igual" : "DIFERENTE");
+    fflush(stdout);
+
+    // 2. Leitor concorrente com o dono republicando versões diferentes
+    filho = fork();
+    if (filho == 0) {
+        if (freopen("/dev/null", "w", stdout) == NULL) {
+            _exit(255);
+        }
+        _exit(contarLeiturasMisturadas());
+    }
+    for (int v = 1; v <= EXPORTACAO_VERSOES; v++) {
+        for (int i = 0; i < EXPORTACAO_REGISTROS; i++) {
+            versao[i].ra = i + 1;
+            versao[i].ativo = v;
+            snprintf(versao[i].nome, sizeof(versao[i].nome), "Versao %d", v);
+            snprintf(versao[i].email, sizeof(versao[i].email), "v%d@pim.com", v);
+        }
+        publicarExportacao(EXPORTACAO_ALUNOS, versao, (v % 2) ? EXPORTACAO_REGISTROS : EXPORTACAO_REGISTROS / 2);
+    }
+    waitpid(filho, &status, 0);
+    int misturadas = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    printf("  Leituras com versoes misturadas: %d\n", misturadas);
+
+    removerExportacoes();
+
+    // 3. Dono que morre no meio de uma publicação: o leitor desiste
+    fflush(stdout);
+    filho = fork();
+    if (filho == 0) {
+        if (freopen("/dev/null", "w", stdout) == NULL) {
+            _exit(1);
+        }
+        habilitarExportacao();
+        publicarExportacao(EXPORTACAO_ALUNOS, versao, EXPORTACAO_REGISTROS);
+        int descritor = shm_open("/pim_alunos", O_RDWR, 0);
+        CabecalhoExportacao *cabecalho = mmap(NULL, sizeof(CabecalhoExportacao), PROT_READ | PROT_WRITE,
+                                              MAP_SHARED, descritor, 0);
+        if (descritor < 0 || cabecalho == MAP_FAILED) {
+            _exit(1);
+        }
+        atomic_fetch_add(&cabecalho->sequencia, 1);
+        _exit(0);
+    }
+    waitpid(filho, &status, 0);
+    LeitorExportacao leitor;
+    int orfa = WIFEXITED(status) && WEXITSTATUS(status) == 0 && anexarExportacao(&leitor, EXPORTACAO_ALUNOS);
+    if (orfa) {
+        orfa = lerTabelaExportada(&leitor, versao, EXPORTACAO_REGISTROS, NULL) == -1;
+        desanexarExportacao(&leitor);
+    }
+    printf("  Leitura com o dono morto no meio da publicacao: %s\n", orfa ? "recusada" : "ACEITA");
+    removerExportacoes();
+
+    if (iguais && misturadas == 0 && orfa) {
+        printf("\n%sExportacao consistente entre processos.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha na exportacao compartilhada.%s\n", RED, RESET);
+    }
+#endif
+}
+
+// ========== TESTE DE PERSISTÊNCIA ASSÍNCRONA ==========
+
+#define PERSISTENCIA_VERSOES 50
+#define ARQUIVO_TESTE_PERSISTENCIA "data/teste_persistencia.csv"
+
+// Submete várias versões do mesmo arquivo e confere ordem e conteúdo final
+static int conferirPersistencia(int modo) {
+    FilaConclusoes fila;
+    ConclusaoGravacao conclusao;
+    uint64_t ultimo_ticket = 0;
+    int fora_de_ordem = 0, falhas = 0;
+    char texto[64];
+
+    if (iniciarPersistencia(modo) != modo) {
+        printf("  %-9s indisponivel neste sistema\n", modo == PERSISTENCIA_URING ? "io_uring" : "threads");
+        encerrarPersistencia();
+        return 1;
+    }
+
+    inicializarFilaConclusoes(&fila);
+    for (int v = 1; v <= PERSISTENCIA_VERSOES; v++) {
+        char *conteudo = malloc(sizeof(texto));
+        if (conteudo == NULL) {
+            break;
+        }
+        int tamanho = snprintf(conteudo, sizeof(texto), "versao;%d\n", v);
+        submeterGravacao(ARQUIVO_TESTE_PERSISTENCIA, conteudo, (size_t)tamanho, &fila, NULL);
+    }
+
+    // Destino em diretório inexistente: a conclusão precisa trazer o erro
+    submeterGravacao("data/inexistente/teste.csv", strdup("x\n"), 2, &fila, NULL);
+
+    for (int i = 0; i <= PERSISTENCIA_VERSOES; i++) {
+        aguardarConclusao(&fila, &conclusao);
+        if (conclusao.resultado != 0) {
+            falhas++;
+        } else if (conclusao.ticket < ultimo_ticket) {
+            fora_de_ordem++;
+        } else {
+            ultimo_ticket = conclusao.ticket;
+        }
+    }
+    destruirFilaConclusoes(&fila);
+
+    printf("  backend=%-9s fora de ordem=%d, falhas=%d (esperada 1)",
+           backendPersistencia(), fora_de_ordem, falhas);
+    encerrarPersistencia();
+
+    FILE *f = fopen(ARQUIVO_TESTE_PERSISTENCIA, "r");
+    int final = 0;
+    if (f != NULL) {
+        if (fscanf(f, "versao;%d", &final) != 1) {
+            final = 0;
+        }
+        fclose(f);
+    }
+    remove(ARQUIVO_TESTE_PERSISTENCIA);
+    printf(", versao final=%d\n", final);
+
+    return (fora_de_ordem == 0 && falhas == 1 && final == PERSISTENCIA_VERSOES) ? 0 : 1;
+}
+
+static void testarPersistenciaAssincrona(void) {
+    imprimirTitulo("TESTE: PERSISTENCIA ASSINCRONA", BLUE);
+
+    int erros = conferirPersistencia(PERSISTENCIA_THREADS);
+#ifdef __linux__
+    erros += conferirPersistencia(PERSISTENCIA_URING);
+#endif
+
+    if (erros == 0) {
+        printf("\n%sGravacoes aplicadas em ordem e duraveis.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha na persistencia assincrona.%s\n", RED, RESET);
+    }
+}
+
+// ========== TESTE DE GRAVAÇÃO ADIADA (WRITE-BEHIND) ==========
+
+#define ADIADA_ALTERACOES 50
+#define ADIADA_INTERVALO_LONGO_MS 60000
+
+// Confere direto no CSV (sem passar pela tabela em memória)
+static int aulaGravadaNoCSV(int id) {
+    FILE *arquivo = fopen(ARQUIVO_AULAS, "r");
+    char linha[512];
+    int encontrada = 0;
+
+    if (arquivo == NULL) {
+        return 0;
+    }
+    while (fgets(linha, sizeof(linha), arquivo) != NULL) {
+        int lido;
+        if (sscanf(linha, "%d,", &lido) == 1 && lido == id) {
+            encontrada = 1;
+            break;
+        }
+    }
+    fclose(arquivo);
+    return encontrada;
+}
+
+static void prepararAulaAdiada(Aula *aula, int id, int versao) {
+    memset(aula, 0, sizeof(*aula));
+    aula->id = id;
+    aula->id_turma = 1;
+    strcpy(aula->data, "10/03/2025");
+    snprintf(aula->conteudo, sizeof(aula->conteudo), "Gravacao adiada %d", versao);
+}
+
+#ifndef _WIN32
+// Filho: grava A com barreira, altera B e "cai" sem descarregar
+static void filhoQueda(int id_a, int id_b) {
+    Aula aula;
+
+    iniciarGravacaoAdiada(ADIADA_INTERVALO_LONGO_MS, 1000);
+    prepararAulaAdiada(&aula, id_a, 1);
+    registrarAula(&aula);
+    descarregarTabelas();
+    prepararAulaAdiada(&aula, id_b, 2);
+    registrarAula(&aula);
+    _exit(0);
+}
+
+// Filho: altera e sai por exit(); o atexit drena a fila
+static void filhoSaidaLimpa(int id) {
+    Aula aula;
+
+    if (iniciarGravacaoAdiada(ADIADA_INTERVALO_LONGO_MS, 1000)) {
+        atexit(encerrarGravacaoAdiada);
+    }
+    prepararAulaAdiada(&aula, id, 3);
+    registrarAula(&aula);
+    exit(0);
+}
+#endif
+
+static void testarGravacaoAdiada(void) {
+    imprimirTitulo("TESTE: GRAVACAO ADIADA (WRITE-BEHIND)", BLUE);
+
+    EstatisticasGravacaoAdiada antes, depois;
+    Aula aula;
+    int base = gerarProximoIDAula();
+    int erros = 0;
+
+    // 1. Várias alterações viram uma gravação; o CSV só muda na barreira
+    iniciarGravacaoAdiada(ADIADA_INTERVALO_LONGO_MS, 1000);
+    estatisticasGravacaoAdiada(&antes);
+    for (int i = 0; i < ADIADA_ALTERACOES; i++) {
+        prepararAulaAdiada(&aula, base + i, 0);
+        registrarAula(&aula);
+    }
+    int em_memoria = obterAulaPorID(base + ADIADA_ALTERACOES - 1, &aula);
+    int no_disco_antes = aulaGravadaNoCSV(base);
+    descarregarTabelas();
+    int no_disco_depois = aulaGravadaNoCSV(base + ADIADA_ALTERACOES - 1);
+    estatisticasGravacaoAdiada(&depois);
+
+    printf("  %d alteracoes -> %ld gravacao(oes) do CSV (motor: %s)\n", ADIADA_ALTERACOES,
+           depois.gravacoes - antes.gravacoes, backendPersistencia());
+    printf("  Visivel em memoria: %s | no disco antes da barreira: %s | depois: %s\n",
+           em_memoria ? "sim" : "nao", no_disco_antes ? "sim" : "nao", no_disco_depois ? "sim" : "nao");
+    if (!em_memoria || no_disco_antes || !no_disco_depois || depois.gravacoes - antes.gravacoes != 1) {
+        erros++;
+    }
+
+    // 2. Exclusões pendentes são drenadas pelo encerramento
+    for (int i = 0; i < ADIADA_ALTERACOES; i++) {
+        excluirAula(base + i);
+    }
+    encerrarGravacaoAdiada();
+    int restantes = 0;
+    for (int i = 0; i < ADIADA_ALTERACOES; i++) {
+        restantes += aulaGravadaNoCSV(base + i);
+    }
+    printf("  Encerramento drenou as exclusoes: %s\n", restantes == 0 ? "sim" : "NAO");
+    if (restantes != 0) {
+        erros++;
+    }
+
+#ifdef _WIN32
+    printf("%sJanelas de queda testadas apenas em sistemas POSIX (usa fork).%s\n", YELLOW, RESET);
+#else
+    // 3. Queda: o que passou pela barreira sobrevive, o resto se perde inteiro
+    int status = 0;
+    fflush(stdout);
+    pid_t filho = fork();
+    if (filho == 0) {
+        if (freopen("/dev/null", "w", stdout) == NULL) {
+            _exit(1);
+        }
+        filhoQueda(base, base + 1);
+    }
+    waitpid(filho, &status, 0);
+    int sobreviveu = aulaGravadaNoCSV(base);
+    int perdida = !aulaGravadaNoCSV(base + 1);
+    int legivel = obterAulaPorID(base, &aula) && strcmp(aula.conteudo, "Gravacao adiada 1") == 0;
+    printf("  Queda apos a barreira: gravada=%s, pendente perdida=%s, CSV integro=%s\n",
+           sobreviveu ? "sim" : "nao", perdida ? "sim" : "nao", legivel ? "sim" : "nao");
+    if (!sobreviveu || !perdida || !legivel) {
+        erros++;
+    }
+    excluirAula(base);
+
+    // 4. Saída normal por exit() grava o que estava pendente
+    fflush(stdout);
+    filho = fork();
+    if (filho == 0) {
+        if (freopen("/dev/null", "w", stdout) == NULL) {
+            _exit(1);
+        }
+        filhoSaidaLimpa(base + 2);
+    }
+    waitpid(filho, &status, 0);
+    int drenada = aulaGravadaNoCSV(base + 2);
+    printf("  Saida por exit() drenou a fila: %s\n", drenada ? "sim" : "NAO");
+    if (!drenada) {
+        erros++;
+    }
+    excluirAula(base + 2);
+
+    // 5. Rodada que falha mantém a alteração na fila: o temporário do próximo
+    //    pedido ao motor (e o ".tmp" do caminho sem motor) é um diretório
+    FilaConclusoes fila;
+    ConclusaoGravacao conclusao;
+    char bloqueio_motor[MAX_PATH + 32];
+    iniciarGravacaoAdiada(ADIADA_INTERVALO_LONGO_MS, 1000);
+    inicializarFilaConclusoes(&fila);
+    uint64_t ticket = submeterGravacao(ARQUIVO_TESTE_PERSISTENCIA, strdup("x\n"), 2, &fila, NULL);
+    if (ticket != 0) {
+        aguardarConclusao(&fila, &conclusao);
+    }
+    destruirFilaConclusoes(&fila);
+    remove(ARQUIVO_TESTE_PERSISTENCIA);
+    snprintf(bloqueio_motor, sizeof(bloqueio_motor), "%s.tmp.%llu", ARQUIVO_AULAS,
+             (unsigned long long)ticket + 1);
+    mkdir(bloqueio_motor, 0700);
+    mkdir(ARQUIVO_AULAS ".tmp", 0700);
+    prepararAulaAdiada(&aula, base + 3, 4);
+    registrarAula(&aula);
+    int barreira_falhou = !descarregarTabelas();
+    int pendente = obterAulaPorID(base + 3, &aula) && !aulaGravadaNoCSV(base + 3);
+    rmdir(bloqueio_motor);
+    rmdir(ARQUIVO_AULAS ".tmp");
+    int barreira_gravou = descarregarTabelas();
+    int regravada = aulaGravadaNoCSV(base + 3);
+    encerrarGravacaoAdiada();
+    printf("  Falha na rodada: barreira informou=%s, ainda pendente=%s, gravada na seguinte=%s\n",
+           barreira_falhou ? "sim" : "nao", pendente ? "sim" : "nao",
+           (barreira_gravou && regravada) ? "sim" : "nao");
+    if (!barreira_falhou || !pendente || !barreira_gravou || !regravada) {
+        erros++;
+    }
+    excluirAula(base + 3);
+#endif
+
+    if (erros == 0) {
+        printf("\n%sGravacao adiada consistente.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha na gravacao adiada.%s\n", RED, RESET);
+    }
+}
+
+// ========== TESTE DO LOG DE AUDITORIA ==========
+
+#define AUDITORIA_THREADS 4
+#define AUDITORIA_LINHAS 5000
+#define DIRETORIO_TESTE_AUDITORIA "data/teste_auditoria"
+
+static void *produtorLoginsTeste(void *arg) {
+    char login[32];
+
+    snprintf(login, sizeof(login), "login_teste_%d", *(int *)arg);
+    for (int i = 0; i < AUDITORIA_LINHAS; i++) {
+        registrarTentativaLogin(login, i % 2);
+    }
+    return NULL;
+}
+
+static int contarEventoTeste(const EventoAuditoria *evento, void *contexto) {
+    (void)evento;
+    (*(long *)contexto)++;
+    return 1;
+}
+
+// Conta os eventos do diretório de teste que atendem ao filtro
+static long contarEventosAuditoria(const FiltroAuditoria *filtro) {
+    long total = 0;
+    consultarLogAuditoria(DIRETORIO_TESTE_AUDITORIA, filtro, contarEventoTeste, &total);
+    return total;
+}
+
+static long disparaProdutoresAuditoria(void) {
+    pthread_t ids[AUDITORIA_THREADS];
+    int indices[AUDITORIA_THREADS];
+
+    for (int t = 0; t < AUDITORIA_THREADS; t++) {
+        indices[t] = t;
+        pthread_create(&ids[t], NULL, produtorLoginsTeste, &indices[t]);
+    }
+    for (int t = 0; t < AUDITORIA_THREADS; t++) {
+        pthread_join(ids[t], NULL);
+    }
+    return (long)AUDITORIA_THREADS * AUDITORIA_LINHAS;
+}
+
+static void testarAuditoria(void) {
+    imprimirTitulo("TESTE: LOG DE AUDITORIA (ANEL + ESCRITORA)", BLUE);
+
+    EstatisticasAuditoria antes, depois;
+    FiltroAuditoria filtro;
+    Sessao sessao;
+    int erros = 0;
+
+    encerrarAuditoria();
+    redirecionarAuditoria(DIRETORIO_TESTE_AUDITORIA);
+    removerSegmentosLog(DIRETORIO_TESTE_AUDITORIA);
+
+    // 1. Política de espera: nenhum evento perdido
+    iniciarAuditoria(AUDITORIA_ESPERAR);
+    estatisticasAuditoria(&antes);
+    long enviadas = disparaProdutoresAuditoria();
+
+    memset(&sessao, 0, sizeof(sessao));
+    strcpy(sessao.login, "login_teste_acao");
+    sessao.ativo = 1;
+    int acao = registrarAcao(&sessao, "LOGIN", "Login realizado com sucesso");
+
+    descarregarAuditoria();
+    estatisticasAuditoria(&depois);
+
+    filtroAuditoriaPadrao(&filtro);
+    filtro.destino = AUDITORIA_AUTH;
+    long gravadas = contarEventosAuditoria(&filtro);
+    filtro.login = "login_teste_2";
+    long por_login = contarEventosAuditoria(&filtro);
+    filtro.sucesso = 0;
+    long falhas = contarEventosAuditoria(&filtro);
+    filtroAuditoriaPadrao(&filtro);
+    filtro.destino = AUDITORIA_ACOES;
+    filtro.login = "login_teste_acao";
+    long acoes = contarEventosAuditoria(&filtro);
+
+    printf("  Esperar: %ld enviadas, %ld gravadas, %llu gravacoes em lote\n",
+           enviadas, gravadas, depois.gravacoes - antes.gravacoes);
+    printf("  Consulta por login: %ld eventos (%ld falhas)\n", por_login, falhas);
+    printf("  registrarAcao gravou no log de acoes: %s\n", (acao && acoes == 1) ? "sim" : "NAO");
+    if (gravadas != enviadas || por_login != AUDITORIA_LINHAS || falhas != AUDITORIA_LINHAS / 2 ||
+        !acao || acoes != 1 || depois.descartadas != antes.descartadas) {
+        erros++;
+    }
+    encerrarAuditoria();
+
+    // 2. Política de descarte: todo evento é gravado ou contado como descartado
+    removerSegmentosLog(DIRETORIO_TESTE_AUDITORIA);
+    iniciarAuditoria(AUDITORIA_DESCARTAR);
+    estatisticasAuditoria(&antes);
+    enviadas = disparaProdutoresAuditoria();
+    descarregarAuditoria();
+    estatisticasAuditoria(&depois);
+    encerrarAuditoria();
+    filtroAuditoriaPadrao(&filtro);
+    filtro.destino = AUDITORIA_AUTH;
+    gravadas = contarEventosAuditoria(&filtro);
+    unsigned long long descartes = depois.descartadas - antes.descartadas;
+
+    printf("  Descartar: %ld enviadas = %ld gravadas + %llu descartadas\n",
+           enviadas, gravadas, descartes);
+    if (gravadas + (long)descartes != enviadas) {
+        erros++;
+    }
+
+    removerSegmentosLog(DIRETORIO_TESTE_AUDITORIA);
+    redirecionarAuditoria(LOG_AUDITORIA_DIR);
+
+    if (erros == 0) {
+        printf("\n%sLog de auditoria completo.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha no log de auditoria.%s\n", RED, RESET);
+    }
+}
+
+// ========== TESTE DO LOG BINÁRIO (ÍNDICES, ROTAÇÃO, RECUPERAÇÃO) ==========
+
+#define DIRETORIO_TESTE_LOG "data/teste_log_binario"
+#define EVENTOS_TESTE_LOG 5000
+#define INSTANTE_BASE_TESTE 1700000000000LL
+
+typedef struct {
+    long total;
+    int64_t ultimo_ms;
+    int fora_de_ordem;
+} OrdemConsulta;
+
+static int conferirOrdem(const EventoAuditoria *evento, void *contexto) {
+    OrdemConsulta *o = (OrdemConsulta *)contexto;
+    if (evento->instante_ms < o->ultimo_ms) {
+        o->fora_de_ordem = 1;
+    }
+    o->ultimo_ms = evento->instante_ms;
+    o->total++;
+    return 1;
+}
+
+static long consultarTesteLog(const FiltroAuditoria *filtro, int *fora_de_ordem) {
+    OrdemConsulta o = {0, 0, 0};
+    consultarLogAuditoria(DIRETORIO_TESTE_LOG, filtro, conferirOrdem, &o);
+    if (fora_de_ordem != NULL) {
+        *fora_de_ordem = o.fora_de_ordem;
+    }
+    return o.total;
+}
+
+// Caminho do maior segmento existente (0 se nenhum)
+static int ultimoSegmentoTeste(char *caminho, size_t tamanho) {
+    int numero = 0;
+    for (;;) {
+        char proximo[MAX_PATH];
+        snprintf(proximo, sizeof(proximo), "%s/seg_%06d.bin", DIRETORIO_TESTE_LOG, numero + 1);
+        FILE *f = fopen(proximo, "rb");
+        if (f == NULL) {
+            break;
+        }
+        fclose(f);
+        snprintf(caminho, tamanho, "%s", proximo);
+        numero++;
+    }
+    return numero;
+}
+
+static void anexarEventosTeste(int primeiro, int quantidade) {
+    EventoAuditoria evento;
+
+    memset(&evento, 0, sizeof(evento));
+    for (int i = primeiro; i < primeiro + quantidade; i++) {
+        evento.instante_ms = INSTANTE_BASE_TESTE + (int64_t)i * 10;
+        evento.destino = (i % 4 == 0) ? AUDITORIA_AUTH : AUDITORIA_ACOES;
+        evento.sucesso = i % 2;
+        snprintf(evento.login, sizeof(evento.login), "usuario_%d", i % 10);
+        snprintf(evento.acao, sizeof(evento.acao), "%s", (i % 4 == 0) ? "LOGIN" : "EDITAR_TURMA");
+        snprintf(evento.detalhes, sizeof(evento.detalhes), "evento %d", i);
+        anexarEventoLog(&evento);
+    }
+}
+
+static void testarLogBinario(void) {
+    imprimirTitulo("TESTE: LOG BINARIO (INDICES, ROTACAO, RECUPERACAO)", BLUE);
+
+    FiltroAuditoria filtro;
+    char caminho[MAX_PATH] = "";
+    int fora_de_ordem = 0;
+    int erros = 0;
+
+    removerSegmentosLog(DIRETORIO_TESTE_LOG);
+
+    // 1. Rotação por tamanho
+    configurarRotacaoLog(16 * 1024, 0);
+    abrirLogAuditoria(DIRETORIO_TESTE_LOG);
+    anexarEventosTeste(0, EVENTOS_TESTE_LOG);
+    fecharLogAuditoria();
+    int segmentos = ultimoSegmentoTeste(caminho, sizeof(caminho));
+
+    filtroAuditoriaPadrao(&filtro);
+    long todos = consultarTesteLog(&filtro, &fora_de_ordem);
+    printf("  %d eventos em %d segmentos; consulta completa: %ld (ordem %s)\n",
+           EVENTOS_TESTE_LOG, segmentos, todos, fora_de_ordem ? "QUEBRADA" : "ok");
+    if (segmentos < 2 || todos != EVENTOS_TESTE_LOG || fora_de_ordem) {
+        erros++;
+    }
+
+    // 2. Índice por login, por tempo e os dois juntos
+    filtro.login = "usuario_3";
+    long por_login = consultarTesteLog(&filtro, &fora_de_ordem);
+    filtroAuditoriaPadrao(&filtro);
+    filtro.inicio_ms = INSTANTE_BASE_TESTE + 10000;
+    filtro.fim_ms = INSTANTE_BASE_TESTE + 19990;
+    long por_tempo = consultarTesteLog(&filtro, NULL);
+    filtro.login = "usuario_3";
+    long combinada = consultarTesteLog(&filtro, NULL);
+    filtroAuditoriaPadrao(&filtro);
+    filtro.destino = AUDITORIA_AUTH;
+    filtro.acao = "LOGIN";
+    long logins = consultarTesteLog(&filtro, NULL);
+
+    printf("  Login: %ld | Intervalo de 10 s: %ld | Login no intervalo: %ld | LOGIN: %ld\n",
+           por_login, por_tempo, combinada, logins);
+    if (por_login != EVENTOS_TESTE_LOG / 10 || fora_de_ordem || por_tempo != 1000 ||
+        combinada != 100 || logins != EVENTOS_TESTE_LOG / 4) {
+        erros++;
+    }
+
+    // 3. Exportação para texto
+    FILE *texto = tmpfile();
+    filtroAuditoriaPadrao(&filtro);
+    long exportadas = texto ? exportarLogTexto(DIRETORIO_TESTE_LOG, &filtro, texto) : 0;
+    long linhas = 0;
+    if (texto != NULL) {
+        char linha[512];
+        rewind(texto);
+        while (fgets(linha, sizeof(linha), texto) != NULL) {
+            if (linha[0] == '[' && strstr(linha, "Usuario: usuario_") != NULL) {
+                linhas++;
+            }
+        }
+        fclose(texto);
+    }
+    printf("  Exportacao em texto: %ld linhas (%ld no formato antigo)\n", exportadas, linhas);
+    if (exportadas != EVENTOS_TESTE_LOG || linhas != EVENTOS_TESTE_LOG) {
+        erros++;
+    }
+
+    // 4. Segmento ativo (sem índice) também é consultado
+    abrirLogAuditoria(DIRETORIO_TESTE_LOG);
+    anexarEventosTeste(EVENTOS_TESTE_LOG, 100);
+    descarregarLogAuditoria();
+    long com_ativo = consultarTesteLog(&filtro, NULL);
+    fecharLogAuditoria();
+
+    // 5. Queda no meio de uma gravação: registro pela metade e índice perdido
+    segmentos = ultimoSegmentoTeste(caminho, sizeof(caminho));
+    FILE *f = fopen(caminho, "ab");
+    if (f != NULL) {
+        unsigned char lixo[20] = {60, 0, 0, 0, 0xDE, 0xAD, 0xBE, 0xEF};
+        fwrite(lixo, 1, sizeof(lixo), f);
+        fclose(f);
+    }
+    caminho[strlen(caminho) - 3] = '\0';
+    strcat(caminho, "idx");
+    remove(caminho);
+    long sem_indice = consultarTesteLog(&filtro, NULL);
+    abrirLogAuditoria(DIRETORIO_TESTE_LOG);
+    fecharLogAuditoria();
+    f = fopen(caminho, "rb");
+    int reindexado = (f != NULL);
+    if (f != NULL) {
+        fclose(f);
+    }
+    long recuperados = consultarTesteLog(&filtro, &fora_de_ordem);
+
+    printf("  Com segmento ativo: %ld | Cauda corrompida sem indice: %ld | Reindexado: %s (%ld)\n",
+           com_ativo, sem_indice, reindexado ? "sim" : "NAO", recuperados);
+    if (com_ativo != EVENTOS_TESTE_LOG + 100 || sem_indice != com_ativo || !reindexado ||
+        recuperados != com_ativo || fora_de_ordem) {
+        erros++;
+    }
+
+    int removidos = removerSegmentosLog(DIRETORIO_TESTE_LOG);
+    long restantes = consultarTesteLog(&filtro, NULL);
+    printf("  Segmentos removidos: %d, eventos restantes: %ld\n", removidos, restantes);
+    if (removidos != segmentos || restantes != 0) {
+        erros++;
+    }
+    configurarRotacaoLog(0, 0);
+
+    if (erros == 0) {
+        printf("\n%sLog binario consistente: indices, rotacao e recuperacao ok.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha no log binario.%s\n", RED, RESET);
+    }
+}
+
+// ========== TESTE DA TABELA DE SESSÕES ==========
+
+#define VALIDACOES_SESSAO 200000
+
+static long relogio_teste_sessoes = 0;
+
+static long relogioTesteSessoes(void) {
+    return relogio_teste_sessoes;
+}
+
+static int tokenHexadecimal(const char *token) {
+    if (strlen(token) != SESSAO_TAM_TOKEN - 1) {
+        return 0;
+    }
+    for (const char *p = token; *p; p++) {
+        if (!((*p >= '0' && *p <= '9') || (*p >= 'a' && *p <= 'f'))) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void testarSessoes(void) {
+    imprimirTitulo("TESTE: TABELA DE SESSOES (TOKENS + RODA DE TEMPO)", BLUE);
+
+    DadosSessao a, b, c, outra;
+    Sessao sessao;
+    int erros = 0;
+
+    // 1. Tokens aleatórios e invalidação por usuário (relógio simulado)
+    relogio_teste_sessoes = (long)time(NULL);
+    definirRelogioSessoes(relogioTesteSessoes);
+    int base = totalSessoesAtivas();
+    criarSessaoServidor(900001, "sessao_a", "ALUNO", &a);
+    criarSessaoServidor(900001, "sessao_a", "ALUNO", &b);
+    criarSessaoServidor(900001, "sessao_a", "ALUNO", &c);
+    criarSessaoServidor(900002, "sessao_b", "PROFESSOR", &outra);
+    int distintos = strcmp(a.token, b.token) != 0 && strcmp(b.token, c.token) != 0 &&
+                    strcmp(a.token, c.token) != 0;
+    printf("  Token: %s (%s, %s)\n", a.token,
+           tokenHexadecimal(a.token) ? "128 bits em hexadecimal" : "FORMATO INVALIDO",
+           distintos ? "distintos" : "REPETIDOS");
+    if (!tokenHexadecimal(a.token) || !distintos || totalSessoesAtivas() != base + 4) {
+        erros++;
+    }
+
+    int invalidadas = invalidarSessoesUsuario(900001);
+    int restantes = validarTokenSessao(a.token, NULL) + validarTokenSessao(b.token, NULL) +
+                    validarTokenSessao(c.token, NULL);
+    int outra_valida = validarTokenSessao(outra.token, NULL) == SESSAO_VALIDA;
+    printf("  Invalidadas do usuario: %d | ainda validas: %d | outro usuario valido: %s\n",
+           invalidadas, restantes, outra_valida ? "sim" : "NAO");
+    if (invalidadas != 3 || restantes != 0 || !outra_valida) {
+        erros++;
+    }
+
+    // 2. Expiração: válida antes das 8 h, vencida depois e recolhida pela roda
+    relogio_teste_sessoes += SESSAO_DURACAO_S - 1;
+    int antes = validarTokenSessao(outra.token, NULL);
+    criarSessaoServidor(900003, "sessao_c", "ALUNO", &c);
+    relogio_teste_sessoes += 2;
+    int depois = validarTokenSessao(outra.token, NULL);
+    relogio_teste_sessoes += SESSAO_DURACAO_S;
+    int sobraram = totalSessoesAtivas();
+    printf("  8h - 1s: %s | 8h + 1s: %s | sessoes apos a roda: %d\n",
+           antes == SESSAO_VALIDA ? "valida" : "INVALIDA",
+           depois == SESSAO_EXPIRADA ? "expirada" : "NAO EXPIROU", sobraram);
+    if (antes != SESSAO_VALIDA || depois != SESSAO_EXPIRADA || sobraram != 0) {
+        erros++;
+    }
+
+    // 3. Uma conta não enche a tabela: passando do limite, sai a mais antiga dela
+    static DadosSessao cheia[SESSOES_MAX + 1];
+    for (int i = 0; i < SESSOES_POR_USUARIO + 2; i++) {
+        relogio_teste_sessoes++;
+        criarSessaoServidor(900004, "sessao_d", "ALUNO", &cheia[i]);
+    }
+    int do_usuario = 0;
+    for (int i = 0; i < SESSOES_POR_USUARIO + 2; i++) {
+        do_usuario += validarTokenSessao(cheia[i].token, NULL) == SESSAO_VALIDA;
+    }
+    int antigas_encerradas = validarTokenSessao(cheia[0].token, NULL) == SESSAO_INEXISTENTE &&
+                             validarTokenSessao(cheia[1].token, NULL) == SESSAO_INEXISTENTE;
+    invalidarSessoesUsuario(900004);
+
+    // Tabela cheia: a sessão validada há mais tempo dá lugar à nova
+    for (int i = 0; i < SESSOES_MAX; i++) {
+        relogio_teste_sessoes++;
+        criarSessaoServidor(910000 + i, "sessao_e", "ALUNO", &cheia[i]);
+    }
+    relogio_teste_sessoes++;
+    validarTokenSessao(cheia[0].token, NULL);
+    int criou = criarSessaoServidor(910000 + SESSOES_MAX, "sessao_e", "ALUNO", &cheia[SESSOES_MAX]);
+    int despejo_lru = validarTokenSessao(cheia[0].token, NULL) == SESSAO_VALIDA &&
+                      validarTokenSessao(cheia[1].token, NULL) == SESSAO_INEXISTENTE &&
+                      validarTokenSessao(cheia[SESSOES_MAX].token, NULL) == SESSAO_VALIDA;
+    printf("  %d logins da mesma conta: %d validas (limite %d, mais antigas %s) | tabela cheia: %s\n",
+           SESSOES_POR_USUARIO + 2, do_usuario, SESSOES_POR_USUARIO,
+           antigas_encerradas ? "encerradas" : "AINDA VALIDAS",
+           criou && despejo_lru ? "nova sessao no lugar da menos usada" : "SEM LUGAR OU DESPEJO ERRADO");
+    if (do_usuario != SESSOES_POR_USUARIO || !antigas_encerradas || !criou || !despejo_lru ||
+        totalSessoesAtivas() != SESSOES_MAX) {
+        erros++;
+    }
+    relogio_teste_sessoes += 2 * SESSAO_DURACAO_S;
+    totalSessoesAtivas();
+    definirRelogioSessoes(NULL);
+
+    // 4. Integração: login, validação sem disco, reset de senha e exclusão
+    Usuario usuario;
+    usuario.id = gerarProximoIDUsuario();
+    gerarLoginTeste(usuario.login, sizeof(usuario.login));
+    strcpy(usuario.senha, "Senha@123");
+    strcpy(usuario.tipo, "PROFESSOR");
+    usuario.ativo = 1;
+    cadastrarUsuario(&usuario);
+
+    memset(&sessao, 0, sizeof(sessao));
+    int logou = autenticar(usuario.login, "Senha@123", &sessao) != NULL;
+    int valida = logou && validarSessao(&sessao);
+
+    double inicio = (double)clock();
+    long aceitas = 0;
+    for (int i = 0; i < VALIDACOES_SESSAO; i++) {
+        aceitas += validarSessao(&sessao);
+    }
+    double por_validacao = ((double)clock() - inicio) / CLOCKS_PER_SEC / VALIDACOES_SESSAO * 1e9;
+
+    inicio = (double)clock();
+    for (int i = 0; i < VALIDACOES_SESSAO; i++) {
+        aceitas += buscarUsuarioPorID(sessao.id_usuario) != NULL;
+    }
+    double por_busca = ((double)clock() - inicio) / CLOCKS_PER_SEC / VALIDACOES_SESSAO * 1e9;
+    printf("  validarSessao: %.0f ns | buscarUsuarioPorID (validacao antiga): %.0f ns\n",
+           por_validacao, por_busca);
+
+    resetarSenha(usuario.id, "Nova@1234");
+    int apos_reset = validarSessao(&sessao);
+    Sessao segunda;
+    memset(&segunda, 0, sizeof(segunda));
+    int relogou = autenticar(usuario.login, "Nova@1234", &segunda) != NULL;
+    excluirUsuario(usuario.id);
+    int apos_exclusao = validarSessao(&segunda);
+
+    printf("  Login: %s | valida: %s | apos resetarSenha: %s | apos excluirUsuario: %s\n",
+           logou ? "ok" : "FALHOU", valida ? "sim" : "NAO",
+           apos_reset ? "AINDA VALIDA" : "invalidada",
+           apos_exclusao ? "AINDA VALIDA" : "invalidada");
+    if (!logou || !valida || aceitas != 2L * VALIDACOES_SESSAO || apos_reset || !relogou ||
+        apos_exclusao) {
+        erros++;
+    }
+
+    if (erros == 0) {
+        printf("\n%sTabela de sessoes ok.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha na tabela de sessoes.%s\n", RED, RESET);
+    }
+}
+
+// ========== TESTE DE CARGA DO LIMITADOR DE LOGIN ==========
+
+#define ATACANTES_LIMITADOR 4
+#define LOGINS_LEGITIMOS 200
+#define DIRETORIO_TESTE_LIMITADOR "data/teste_limitador"
+
+typedef struct {
+    const char *alvo;
+    _Atomic int *parar;
+    long tentativas;
+} ArgAtacante;
+
+// Cada atacante manda uma tentativa a cada ~50 us (como requisições chegando
+// pela rede): o que muda com o limitador é o custo de cada uma no servidor
+static void *executarAtacante(void *arg) {
+    ArgAtacante *a = (ArgAtacante *)arg;
+    struct timespec intervalo = {0, 50000};
+    Sessao sessao;
+
+    while (!atomic_load(a->parar)) {
+        autenticarCliente(a->alvo, "senha_errada", "10.0.0.66", &sessao);
+        a->tentativas++;
+        nanosleep(&intervalo, NULL);
+    }
+    return NULL;
+}
+
+static int compararDoubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Silencia a saída padrão (as tentativas imprimem mensagens); -1 restaura
+static int silenciarSaida(int descritor) {
+#ifndef _WIN32
+    fflush(stdout);
+    if (descritor < 0) {
+        int salvo = dup(fileno(stdout));
+        FILE *nulo = fopen("/dev/null", "w");
+        if (nulo != NULL) {
+            dup2(fileno(nulo), fileno(stdout));
+            fclose(nulo);
+        }
+        return salvo;
+    }
+    dup2(descritor, fileno(stdout));
+    close(descritor);
+#endif
+    (void)descritor;
+    return -1;
+}
+
+// Mede logins legítimos (com logout) com "atacantes" threads martelando o alvo
+static void medirLoginsLegitimos(const char *login, const char *senha, const char *alvo,
+                                 int atacantes, double *p50, double *p99, int *sucessos,
+                                 long *ataques, double *cpu_total) {
+    static double latencias[LOGINS_LEGITIMOS];
+    pthread_t ids[ATACANTES_LIMITADOR];
+    ArgAtacante args[ATACANTES_LIMITADOR];
+    _Atomic int parar = 0;
+
+    int saida = silenciarSaida(-1);
+    clock_t cpu_inicio = clock();
+    for (int t = 0; t < atacantes; t++) {
+        args[t].alvo = alvo;
+        args[t].parar = &parar;
+        args[t].tentativas = 0;
+        pthread_create(&ids[t], NULL, executarAtacante, &args[t]);
+    }
+
+    // Um login legítimo a cada ~2 ms, para o ataque correr durante a medição
+    struct timespec pausa = {0, 2000000};
+    *sucessos = 0;
+    for (int i = 0; i < LOGINS_LEGITIMOS; i++) {
+        Sessao sessao;
+        char cliente[32];
+        struct timespec t0, t1;
+        // Cada login legítimo vem de uma máquina diferente
+        snprintf(cliente, sizeof(cliente), "192.168.%d.%d", i / 256, i % 256);
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        if (autenticarCliente(login, senha, cliente, &sessao) != NULL) {
+            (*sucessos)++;
+            logout(&sessao);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        latencias[i] = (double)(t1.tv_sec - t0.tv_sec) * 1e6 + (double)(t1.tv_nsec - t0.tv_nsec) / 1e3;
+        nanosleep(&pausa, NULL);
+    }
+
+    atomic_store(&parar, 1);
+    *ataques = 0;
+    for (int t = 0; t < atacantes; t++) {
+        pthread_join(ids[t], NULL);
+        *ataques += args[t].tentativas;
+    }
+    *cpu_total = (double)(clock() - cpu_inicio) / CLOCKS_PER_SEC;
+    silenciarSaida(saida);
+
+    qsort(latencias, LOGINS_LEGITIMOS, sizeof(double), compararDoubles);
+    *p50 = latencias[LOGINS_LEGITIMOS / 2];
+    *p99 = latencias[LOGINS_LEGITIMOS * 99 / 100];
+}
+
+static void testarLimitadorLogin(void) {
+    imprimirTitulo("TESTE: LIMITADOR DE LOGIN (CARGA COM ATAQUE)", BLUE);
+
+    ConfiguracaoLimitador config;
+    EstatisticasLimitador estatisticas;
+    Usuario legitimo, alvo;
+    double p50, p99, cpu, cpu_base;
+    int sucessos, erros = 0;
+    long ataques;
+
+    // Log de auditoria fora de data/auditoria durante a carga
+    encerrarAuditoria();
+    redirecionarAuditoria(DIRETORIO_TESTE_LIMITADOR);
+
+    legitimo.id = gerarProximoIDUsuario();
+    gerarLoginTeste(legitimo.login, sizeof(legitimo.login));
+    strcpy(legitimo.senha, "Senha@123");
+    strcpy(legitimo.tipo, "ALUNO");
+    legitimo.ativo = 1;
+    int cadastrados = cadastrarUsuario(&legitimo);
+    alvo = legitimo;
+    alvo.id = gerarProximoIDUsuario();
+    gerarLoginTeste(alvo.login, sizeof(alvo.login));
+    strcpy(alvo.tipo, "ADMIN");
+    cadastrados += cadastrarUsuario(&alvo);
+    if (cadastrados != 2) {
+        printf("\n%sFalha: usuarios do teste nao cadastrados (%s, %s).%s\n", RED, legitimo.login, alvo.login,
+               RESET);
+        excluirUsuario(legitimo.id);
+        excluirUsuario(alvo.id);
+        encerrarAuditoria();
+        redirecionarAuditoria(LOG_AUDITORIA_DIR);
+        return;
+    }
+
+    // 1. Regras: rajada de falhas por login + cliente e tentativas por cliente
+    configuracaoLimitadorPadrao(&config);
+    configurarLimitador(&config);
+    reiniciarLimitador();
+    int aceitas_login = 0;
+    for (int i = 0; i < 10; i++) {
+        if (consultarLimitador("conta_sob_ataque", "10.0.0.9")) {
+            aceitas_login++;
+            registrarFalhaLimitador("conta_sob_ataque", "10.0.0.9");
+        }
+    }
+    // O dono, de outra origem, continua entrando
+    int dono_liberado = consultarLimitador("conta_sob_ataque", "172.16.0.1");
+    int aceitas_cliente = 0;
+    for (int i = 0; i < 30; i++) {
+        char login[32];
+        snprintf(login, sizeof(login), "conta_%d", i);
+        aceitas_cliente += consultarLimitador(login, "10.0.0.1");
+    }
+    int outro_cliente = consultarLimitador("conta_0", "10.0.0.2");
+    printf("  Falhas aceitas por login: %d/10 (dono de outra origem: %s) | tentativas por cliente: %d/30 | "
+           "outro cliente: %s\n", aceitas_login, dono_liberado ? "liberado" : "BLOQUEADO", aceitas_cliente,
+           outro_cliente ? "liberado" : "BLOQUEADO");
+    if (aceitas_login != config.rajada_login || !dono_liberado || aceitas_cliente != config.rajada_cliente ||
+        !outro_cliente) {
+        erros++;
+    }
+
+    // Teto global: muitas origens, cada uma abaixo do próprio limite
+    reiniciarLimitador();
+    int aceitas_global = 0;
+    for (int i = 0; i < config.rajada_login_global * 2; i++) {
+        char cliente[32];
+        snprintf(cliente, sizeof(cliente), "10.2.0.%d", i);
+        if (consultarLimitador("conta_distribuida", cliente)) {
+            aceitas_global++;
+            registrarFalhaLimitador("conta_distribuida", cliente);
+        }
+    }
+
+    // Inundar a tabela com logins novos não zera as falhas da vítima
+    reiniciarLimitador();
+    for (int i = 0; i < config.rajada_login; i++) {
+        registrarFalhaLimitador("conta_vitima", "10.0.0.9");
+    }
+    for (int i = 0; i < LIMITADOR_ENTRADAS * 2; i++) {
+        char login[32];
+        snprintf(login, sizeof(login), "conta_inundacao_%d", i);
+        registrarFalhaLimitador(login, "10.0.0.9");
+    }
+    int vitima_bloqueada = !consultarLimitador("conta_vitima", "10.0.0.9");
+    estatisticasLimitador(&estatisticas);
+    printf("  Falhas aceitas de %d origens: %d (teto %d) | vitima apos inundacao: %s (%llu recusas por lotacao)\n",
+           config.rajada_login_global * 2, aceitas_global, config.rajada_login_global,
+           vitima_bloqueada ? "ainda bloqueada" : "LIBERADA", estatisticas.lotadas);
+    if (aceitas_global != config.rajada_login_global || !vitima_bloqueada) {
+        erros++;
+    }
+
+    // Despejo: mais chaves que posições
+    reiniciarLimitador();
+    for (int i = 0; i < LIMITADOR_ENTRADAS * 2; i++) {
+        char cliente[32];
+        snprintf(cliente, sizeof(cliente), "10.1.%d.%d", i / 256, i % 256);
+        consultarLimitador(NULL, cliente);
+    }
+    estatisticasLimitador(&estatisticas);
+    printf("  %d clientes em %d posicoes: %llu despejos\n", LIMITADOR_ENTRADAS * 2,
+           LIMITADOR_ENTRADAS, estatisticas.despejos);
+    if (estatisticas.despejos == 0) {
+        erros++;
+    }
+
+    // 2. Carga: logins legítimos sozinhos, sob ataque sem e com limitador
+    // A CPU de cada tentativa de ataque desconta a dos logins legítimos
+    printf("\n  %-24s %-9s %-9s %-9s %-9s %-12s\n", "Cenario", "p50 (us)", "p99 (us)", "sucessos",
+           "ataques", "us CPU/ataque");
+
+    reiniciarLimitador();
+    medirLoginsLegitimos(legitimo.login, "Senha@123", alvo.login, 0, &p50, &p99, &sucessos,
+                         &ataques, &cpu_base);
+    printf("  %-24s %-9.0f %-9.0f %-9d %-9ld %-12s\n", "sem ataque", p50, p99, sucessos, ataques, "-");
+
+    config.habilitado = 0;
+    configurarLimitador(&config);
+    medirLoginsLegitimos(legitimo.login, "Senha@123", alvo.login, ATACANTES_LIMITADOR,
+                         &p50, &p99, &sucessos, &ataques, &cpu);
+    printf("  %-24s %-9.0f %-9.0f %-9d %-9ld %-12.2f\n", "ataque, sem limitador", p50, p99, sucessos,
+           ataques, ataques ? (cpu - cpu_base) / ataques * 1e6 : 0.0);
+
+    config.habilitado = 1;
+    configurarLimitador(&config);
+    reiniciarLimitador();
+    medirLoginsLegitimos(legitimo.login, "Senha@123", alvo.login, ATACANTES_LIMITADOR,
+                         &p50, &p99, &sucessos, &ataques, &cpu);
+    estatisticasLimitador(&estatisticas);
+    printf("  %-24s %-9.0f %-9.0f %-9d %-9ld %-12.2f\n", "ataque, com limitador", p50, p99, sucessos,
+           ataques, ataques ? (cpu - cpu_base) / ataques * 1e6 : 0.0);
+    printf("  Com limitador: %llu tentativas bloqueadas sem consultar usuarios.csv\n",
+           estatisticas.bloqueadas);
+    if (sucessos != LOGINS_LEGITIMOS || estatisticas.bloqueadas == 0) {
+        erros++;
+    }
+
+    excluirUsuario(legitimo.id);
+    excluirUsuario(alvo.id);
+    reiniciarLimitador();
+    encerrarAuditoria();
+    removerSegmentosLog(DIRETORIO_TESTE_LIMITADOR);
+    redirecionarAuditoria(LOG_AUDITORIA_DIR);
+
+    if (erros == 0) {
+        printf("\n%sLimitador de login ok.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha no limitador de login.%s\n", RED, RESET);
+    }
+}
+
+// ========== TESTE DE RELATÓRIOS EM LOTE ==========
+
+#define DIRETORIO_TESTE_RELATORIOS "data/teste_relatorios"
+#define TURMAS_TESTE_LOTE 3
+
+// Lê o arquivo inteiro (NULL se não existir); tamanho em *tamanho
+static char* lerArquivoTeste(const char *caminho, long *tamanho) {
+    FILE *arquivo = fopen(caminho, "rb");
+    if (arquivo == NULL) {
+        return NULL;
+    }
+    fseek(arquivo, 0, SEEK_END);
+    *tamanho = ftell(arquivo);
+    fseek(arquivo, 0, SEEK_SET);
+    char *dados = malloc((size_t)*tamanho + 1);
+    if (dados != NULL && fread(dados, 1, (size_t)*tamanho, arquivo) != (size_t)*tamanho) {
+        free(dados);
+        dados = NULL;
+    }
+    fclose(arquivo);
+    return dados;
+}
+
+// Remove o controle de versões do lote e o diretório (já sem relatórios)
+static void removerDiretorioRelatoriosTeste(void) {
+    char caminho[256];
+
+    snprintf(caminho, sizeof(caminho), "%s/%s", DIRETORIO_TESTE_RELATORIOS, ARQUIVO_VERSOES_RELATORIOS);
+    remove(caminho);
+    strncat(caminho, ".lock", sizeof(caminho) - strlen(caminho) - 1);
+    remove(caminho);
+    remove(DIRETORIO_TESTE_RELATORIOS);
+}
+
+static void testarRelatoriosEmLote(void) {
+    imprimirTitulo("TESTE: RELATORIOS EM LOTE (TODAS AS TURMAS)", BLUE);
+
+    ResultadoLoteRelatorios resultado;
+    Turma lista[MAX_TURMAS];
+    int ids_turma[TURMAS_TESTE_LOTE];
+    int ids_aula[TURMAS_TESTE_LOTE * 2];
+    int erros = 0;
+
+    // Turmas com 0, 1 e 2 aulas, entremeadas com as dos outros testes
+    for (int t = 0; t < TURMAS_TESTE_LOTE; t++) {
+        Turma turma = {gerarProximoIDTurma(), "ADS Lote", "Professora Gabi", 2025, 2};
+        cadastrarTurma(&turma);
+        ids_turma[t] = turma.id;
+    }
+    int total_aulas_teste = 0;
+    for (int t = 1; t < TURMAS_TESTE_LOTE; t++) {
+        for (int a = 0; a < t; a++) {
+            Aula aula = {gerarProximoIDAula(), ids_turma[t], "20/08/2025", ""};
+            snprintf(aula.conteudo, sizeof(aula.conteudo), "Lote: aula %d da turma %d", a + 1, ids_turma[t]);
+            registrarAula(&aula);
+            ids_aula[total_aulas_teste++] = aula.id;
+        }
+    }
+
+    int total_turmas = listarTurmas(lista, MAX_TURMAS);
+    int gerados = gerarRelatoriosTodasTurmas(DIRETORIO_TESTE_RELATORIOS, 0, &resultado);
+    printf("  %d de %d relatorios em %.2f ms (%d threads; carga e agrupamento %.2f ms)\n",
+           gerados, resultado.total_turmas, resultado.segundos_total * 1e3, resultado.threads,
+           resultado.segundos_carga * 1e3);
+    if (gerados != total_turmas || resultado.total_turmas != total_turmas) {
+        erros++;
+    }
+
+    // Cada relatório do lote tem de ser idêntico ao individual
+    int diferentes = 0;
+    double maior_us = 0.0;
+    int turma_mais_lenta = 0;
+    int saida = silenciarSaida(-1);
+    for (int i = 0; i < resultado.total_turmas; i++) {
+        char lote[256], individual[256];
+        long tam_lote = 0, tam_individual = 0;
+
+        snprintf(lote, sizeof(lote), "%s/relatorio_turma_%d.txt", DIRETORIO_TESTE_RELATORIOS,
+                 resultado.tempos[i].id_turma);
+        snprintf(individual, sizeof(individual), "%s/individual.txt", DIRETORIO_TESTE_RELATORIOS);
+        gerarRelatorioTurma(resultado.tempos[i].id_turma, individual);
+
+        char *a = lerArquivoTeste(lote, &tam_lote);
+        char *b = lerArquivoTeste(individual, &tam_individual);
+        if (a == NULL || b == NULL || tam_lote != tam_individual || memcmp(a, b, (size_t)tam_lote) != 0) {
+            diferentes++;
+        }
+        free(a);
+        free(b);
+        remove(individual);
+        remove(lote);
+
+        if (resultado.tempos[i].microssegundos > maior_us) {
+            maior_us = resultado.tempos[i].microssegundos;
+            turma_mais_lenta = resultado.tempos[i].id_turma;
+        }
+    }
+    silenciarSaida(saida);
+    printf("  Relatorios diferentes do individual: %d\n", diferentes);
+    printf("  Mais lento: turma %d (%.1f us)\n", turma_mais_lenta, maior_us);
+    if (diferentes != 0) {
+        erros++;
+    }
+
+    for (int i = 0; i < resultado.total_turmas; i++) {
+        for (int t = 0; t < TURMAS_TESTE_LOTE; t++) {
+            if (resultado.tempos[i].id_turma == ids_turma[t] && resultado.tempos[i].aulas != t) {
+                printf("  Turma %d: %d aulas no lote, esperado %d\n", ids_turma[t],
+                       resultado.tempos[i].aulas, t);
+                erros++;
+            }
+        }
+    }
+    liberarResultadoLote(&resultado);
+    removerDiretorioRelatoriosTeste();
+
+    for (int i = 0; i < total_aulas_teste; i++) {
+        excluirAula(ids_aula[i]);
+    }
+    for (int t = 0; t < TURMAS_TESTE_LOTE; t++) {
+        excluirTurma(ids_turma[t]);
+    }
+
+    if (erros == 0) {
+        printf("\n%sRelatorios em lote ok.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha nos relatorios em lote.%s\n", RED, RESET);
+    }
+}
+
+// ========== TESTE DE ATUALIZAÇÃO INCREMENTAL DOS RELATÓRIOS ==========
+
+// Relatório da turma no último lote (NULL se não estiver)
+static const TempoRelatorio* tempoDaTurma(const ResultadoLoteRelatorios *resultado, int id_turma) {
+    for (int i = 0; i < resultado->total_turmas; i++) {
+        if (resultado->tempos[i].id_turma == id_turma) {
+            return &resultado->tempos[i];
+        }
+    }
+    return NULL;
+}
+
+static void testarAtualizacaoRelatorios(void) {
+    imprimirTitulo("TESTE: ATUALIZACAO INCREMENTAL DOS RELATORIOS", BLUE);
+
+    ResultadoLoteRelatorios resultado;
+    const TempoRelatorio *tempo;
+    int ids_turma[2];
+    int erros = 0;
+
+    for (int t = 0; t < 2; t++) {
+        Turma turma = {gerarProximoIDTurma(), "ADS Incremental", "Professora Gabi", 2025, 2};
+        cadastrarTurma(&turma);
+        ids_turma[t] = turma.id;
+    }
+    Aula aula = {gerarProximoIDAula(), ids_turma[0], "21/08/2025", "Incremental: primeira aula"};
+    registrarAula(&aula);
+
+    // 1. Primeira atualização: sem versões gravadas, tudo é escrito
+    atualizarRelatoriosTurmas(DIRETORIO_TESTE_RELATORIOS, 0, &resultado);
+    printf("  Primeira atualizacao: %d de %d reescritos\n", resultado.reescritos, resultado.total_turmas);
+    if (resultado.reescritos != resultado.total_turmas || resultado.gerados != resultado.total_turmas) {
+        erros++;
+    }
+    liberarResultadoLote(&resultado);
+
+    // 2. Nada mudou: nenhum arquivo é tocado
+    atualizarRelatoriosTurmas(DIRETORIO_TESTE_RELATORIOS, 0, &resultado);
+    printf("  Sem alteracoes: %d reescritos, %d em dia (%.2f ms)\n", resultado.reescritos,
+           resultado.gerados, resultado.segundos_total * 1e3);
+    if (resultado.reescritos != 0 || resultado.gerados != resultado.total_turmas) {
+        erros++;
+    }
+    liberarResultadoLote(&resultado);
+
+    // 3. Aula alterada: só a turma dela
+    strcpy(aula.conteudo, "Incremental: primeira aula (revisada)");
+    atualizarAula(&aula);
+    atualizarRelatoriosTurmas(DIRETORIO_TESTE_RELATORIOS, 0, &resultado);
+    tempo = tempoDaTurma(&resultado, ids_turma[0]);
+    printf("  Aula alterada: %d reescrito(s)\n", resultado.reescritos);
+    if (resultado.reescritos != 1 || tempo == NULL || !tempo->reescrito) {
+        erros++;
+    }
+    liberarResultadoLote(&resultado);
+
+    // 4. Arquivo apagado por fora: volta a ser gravado
+    char caminho[256];
+    snprintf(caminho, sizeof(caminho), "%s/relatorio_turma_%d.txt", DIRETORIO_TESTE_RELATORIOS, ids_turma[1]);
+    remove(caminho);
+    atualizarRelatoriosTurmas(DIRETORIO_TESTE_RELATORIOS, 0, &resultado);
+    tempo = tempoDaTurma(&resultado, ids_turma[1]);
+    printf("  Arquivo apagado: %d reescrito(s)\n", resultado.reescritos);
+    if (resultado.reescritos != 1 || tempo == NULL || !tempo->reescrito) {
+        erros++;
+    }
+    liberarResultadoLote(&resultado);
+
+    // 5. Turmas excluídas: relatórios removidos
+    excluirAula(aula.id);
+    excluirTurma(ids_turma[0]);
+    excluirTurma(ids_turma[1]);
+    atualizarRelatoriosTurmas(DIRETORIO_TESTE_RELATORIOS, 0, &resultado);
+    printf("  Turmas excluidas: %d relatorio(s) removido(s), %d reescrito(s)\n", resultado.removidos,
+           resultado.reescritos);
+    if (resultado.removidos != 2 || resultado.reescritos != 0) {
+        erros++;
+    }
+
+    for (int i = 0; i < resultado.total_turmas; i++) {
+        snprintf(caminho, sizeof(caminho), "%s/relatorio_turma_%d.txt", DIRETORIO_TESTE_RELATORIOS,
+                 resultado.tempos[i].id_turma);
+        remove(caminho);
+    }
+    liberarResultadoLote(&resultado);
+    removerDiretorioRelatoriosTeste();
+
+    if (erros == 0) {
+        printf("\n%sAtualizacao incremental dos relatorios ok.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha na atualizacao incremental dos relatorios.%s\n", RED, RESET);
+    }
+}
+
+// ========== TESTE DAS VISÕES AGREGADAS ==========
+
+// Confere os contadores da turma e conta a divergência
+static int conferirAgregado(const char *etapa, int id_turma, int aulas, int atividades, int alunos, int ativos) {
+    int lidos[4] = {contarAulasDaTurma(id_turma), contarAtividadesDaTurma(id_turma),
+                    contarAlunosDaTurma(id_turma, 0), contarAlunosDaTurma(id_turma, 1)};
+    int ok = lidos[0] == aulas && lidos[1] == atividades && lidos[2] == alunos && lidos[3] == ativos;
+
+    printf("  %-28s turma %d: %d aulas, %d atividades, %d alunos (%d ativos)%s\n", etapa, id_turma,
+           lidos[0], lidos[1], lidos[2], lidos[3], ok ? "" : "  <- divergente");
+    return ok ? 0 : 1;
+}
+
+static void testarVisoesAgregadas(void) {
+    imprimirTitulo("TESTE: VISOES AGREGADAS", BLUE);
+
+    char professor[MAX_NOME];
+    int ids_turma[2];
+    int erros = 0;
+
+    int saida = silenciarSaida(-1);
+    int aulas_antes = contarAulas();
+    int atividades_antes = contarAtividades();
+    int turmas_antes = contarTurmas();
+    int alunos_antes = contarAlunos(0);
+    int ativos_antes = contarAlunos(1);
+
+    int ra = gerarRaNovo();
+    snprintf(professor, sizeof(professor), "Professor Agregado %d", ra);
+    for (int t = 0; t < 2; t++) {
+        Turma turma = {gerarProximoIDTurma(), "ADS Agregados", "", 2025, t + 1};
+        strcpy(turma.professor, professor);
+        cadastrarTurma(&turma);
+        ids_turma[t] = turma.id;
+    }
+    Aluno aluno = {ra, "Aluno Agregado", "agregado@teste.com", 1};
+    cadastrarAluno(&aluno);
+    associarAlunoTurma(ra, ids_turma[0]);
+    associarAlunoTurma(ra, ids_turma[1]);
+
+    Aula aulas[3];
+    for (int i = 0; i < 3; i++) {
+        Aula aula = {gerarProximoIDAula(), ids_turma[0], "22/08/2025", "Agregados"};
+        registrarAula(&aula);
+        aulas[i] = aula;
+    }
+    Atividade atividade = {gerarProximoIDAtividade(), ids_turma[1], "Agregados", "", ""};
+    cadastrarAtividade(&atividade);
+    silenciarSaida(saida);
+
+    // 1. Inclusões
+    erros += conferirAgregado("Inclusoes:", ids_turma[0], 3, 0, 1, 1);
+    erros += conferirAgregado("", ids_turma[1], 0, 1, 1, 1);
+    if (contarAulas() != aulas_antes + 3 || contarAtividades() != atividades_antes + 1 ||
+        contarTurmas() != turmas_antes + 2 || contarAlunos(0) != alunos_antes + 1 ||
+        contarAlunos(1) != ativos_antes + 1) {
+        printf("  Totais das tabelas divergentes\n");
+        erros++;
+    }
+    int por_professor = contarTurmasPor(professor, 0, 0);
+    int por_semestre = contarTurmasPor(professor, 2025, 2);
+    printf("  Turmas do professor: %d (2025/2: %d)\n", por_professor, por_semestre);
+    if (por_professor != 2 || por_semestre != 1 || contarTurmasPor(professor, 2024, 0) != 0) {
+        erros++;
+    }
+
+    // 2. Alterações que mudam a chave agregada
+    saida = silenciarSaida(-1);
+    aulas[2].id_turma = ids_turma[1];
+    atualizarAula(&aulas[2]);
+    Turma turma;
+    obterTurmaPorID(ids_turma[1], &turma);
+    turma.semestre = 1;
+    atualizarTurma(&turma);
+    excluirAluno(ra); // Desativa: conta na turma, mas não como ativo
+    silenciarSaida(saida);
+    erros += conferirAgregado("Aula movida, aluno inativo:", ids_turma[0], 2, 0, 1, 0);
+    erros += conferirAgregado("", ids_turma[1], 1, 1, 1, 0);
+    if (contarTurmasPor(professor, 2025, 1) != 2 || contarTurmasPor(professor, 0, 2) != 0 ||
+        contarAlunos(1) != ativos_antes) {
+        printf("  Filtro por semestre ou ativos divergente\n");
+        erros++;
+    }
+
+    // 3. Reativação e remoção de matrícula
+    saida = silenciarSaida(-1);
+    aluno.ativo = 1;
+    atualizarAluno(&aluno);
+    removerAlunoTurma(ra, ids_turma[0]);
+    silenciarSaida(saida);
+    erros += conferirAgregado("Reativado, desmatriculado:", ids_turma[0], 2, 0, 0, 0);
+    erros += conferirAgregado("", ids_turma[1], 1, 1, 1, 1);
+
+    // 4. Recalcular do zero tem de dar o mesmo resultado
+    int divergencias = verificarAgregados(0);
+    printf("  Verificacao completa: %d divergencia(s)\n", divergencias);
+    if (divergencias != 0) {
+        erros++;
+    }
+
+    // 5. Exclusões zeram tudo
+    saida = silenciarSaida(-1);
+    removerAlunoTurma(ra, ids_turma[1]);
+    excluirAluno(ra);
+    for (int i = 0; i < 3; i++) {
+        excluirAula(aulas[i].id);
+    }
+    excluirAtividade(atividade.id);
+    excluirTurma(ids_turma[0]);
+    excluirTurma(ids_turma[1]);
+    silenciarSaida(saida);
+    erros += conferirAgregado("Exclusoes:", ids_turma[0], 0, 0, 0, 0);
+    erros += conferirAgregado("", ids_turma[1], 0, 0, 0, 0);
+    if (contarAulas() != aulas_antes || contarAtividades() != atividades_antes ||
+        contarTurmas() != turmas_antes || contarTurmasPor(professor, 0, 0) != 0 ||
+        contarAlunos(1) != ativos_antes) {
+        printf("  Totais das tabelas divergentes apos exclusoes\n");
+        erros++;
+    }
+    if (verificarAgregados(0) != 0) {
+        erros++;
+    }
+
+    if (erros == 0) {
+        printf("\n%sVisoes agregadas ok.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha nas visoes agregadas (%d).%s\n", RED, erros, RESET);
+    }
+}
+
+// ========== TESTE DA FREQUÊNCIA ==========
+
+#define ARQUIVO_TESTE_FREQUENCIA "data/teste_frequencia.dat"
+#define ALUNOS_TESTE_FREQUENCIA 66     // Passa de uma palavra de 64 bits
+
+static void removerArquivoFrequenciaTeste(void) {
+    remove(ARQUIVO_TESTE_FREQUENCIA);
+    remove(ARQUIVO_TESTE_FREQUENCIA ".lock");
+    remove(ARQUIVO_TESTE_FREQUENCIA ".tmp");
+}
+
+// Confere a frequência da turma e a de cada aluno contra a consulta individual
+static int conferirFrequenciaTurma(const char *etapa, int id_turma, int chamadas, long long matriculados,
+                                   long long presencas) {
+    FrequenciaAluno lista[ALUNOS_TESTE_FREQUENCIA + 1];
+    FrequenciaTurma turma;
+    int erros = 0;
+
+    frequenciaDaTurma(id_turma, &turma);
+    printf("  %-26s %d chamadas, %lld presencas de %lld\n", etapa, turma.chamadas, turma.presencas,
+           turma.matriculados);
+    if (turma.chamadas != chamadas || turma.matriculados != matriculados || turma.presencas != presencas) {
+        erros++;
+    }
+
+    int total = frequenciaAlunosDaTurma(id_turma, lista, ALUNOS_TESTE_FREQUENCIA + 1);
+    for (int i = 0; i < total; i++) {
+        FrequenciaAluno individual;
+        if (!frequenciaDoAluno(id_turma, lista[i].ra, &individual) || individual.chamadas != lista[i].chamadas ||
+            individual.presencas != lista[i].presencas) {
+            erros++;
+        }
+    }
+    return erros;
+}
+
+static void testarFrequencia(void) {
+    imprimirTitulo("TESTE: FREQUENCIA POR AULA (BITSETS)", BLUE);
+
+    int ras[ALUNOS_TESTE_FREQUENCIA + 1];
+    int ids_aula[3];
+    int erros = 0;
+
+    removerArquivoFrequenciaTeste();
+    usarArquivoFrequencia(ARQUIVO_TESTE_FREQUENCIA);
+
+    int saida = silenciarSaida(-1);
+    Turma turma = {gerarProximoIDTurma(), "ADS Frequencia", "Professora Gabi", 2025, 2};
+    cadastrarTurma(&turma);
+    int ra_base = gerarRaNovo();
+    for (int i = 0; i <= ALUNOS_TESTE_FREQUENCIA; i++) {
+        Aluno aluno = {ra_base + i, "Aluno Frequencia", "frequencia@teste.com", 1};
+        cadastrarAluno(&aluno);
+        ras[i] = aluno.ra;
+    }
+    for (int i = 0; i < ALUNOS_TESTE_FREQUENCIA; i++) {
+        associarAlunoTurma(ras[i], turma.id);
+    }
+    for (int i = 0; i < 3; i++) {
+        Aula aula = {gerarProximoIDAula(), turma.id, "25/08/2025", "Frequencia"};
+        registrarAula(&aula);
+        ids_aula[i] = aula.id;
+    }
+    silenciarSaida(saida);
+
+    // 1. "Todos presentes, exceto": os ausentes ficam nas duas palavras
+    int ausentes[2] = {ras[0], ras[ALUNOS_TESTE_FREQUENCIA - 1]};
+    int matriculados = 0;
+    int na_chamada = registrarChamada(ids_aula[0], ausentes, 2);
+    int presentes = contarPresentesAula(ids_aula[0], &matriculados);
+    printf("  Aula 1: %d presentes de %d (chamada com %d)\n", presentes, matriculados, na_chamada);
+    if (na_chamada != ALUNOS_TESTE_FREQUENCIA || presentes != ALUNOS_TESTE_FREQUENCIA - 2 ||
+        matriculados != ALUNOS_TESTE_FREQUENCIA) {
+        erros++;
+    }
+    registrarChamada(ids_aula[1], NULL, 0);
+
+    // 2. Ausente fora da turma é recusado; ajuste individual de presença
+    saida = silenciarSaida(-1);
+    int fora = ras[ALUNOS_TESTE_FREQUENCIA];
+    int recusada = registrarChamada(ids_aula[2], &fora, 1);
+    silenciarSaida(saida);
+    alterarPresenca(ids_aula[1], ras[ALUNOS_TESTE_FREQUENCIA - 1], 0);
+    printf("  Ausente fora da turma: %s; presenca alterada: %d\n", recusada < 0 ? "recusado" : "aceito",
+           consultarPresenca(ids_aula[1], ras[ALUNOS_TESTE_FREQUENCIA - 1]));
+    if (recusada >= 0 || consultarPresenca(ids_aula[1], ras[ALUNOS_TESTE_FREQUENCIA - 1]) != 0 ||
+        consultarPresenca(ids_aula[1], ras[1]) != 1 || consultarPresenca(ids_aula[1], fora) != -1) {
+        erros++;
+    }
+
+    // 3. Lista muda: um aluno entra (vai para o fim) e outro sai (mantém a posição)
+    saida = silenciarSaida(-1);
+    associarAlunoTurma(fora, turma.id);
+    removerAlunoTurma(ras[1], turma.id);
+    silenciarSaida(saida);
+    registrarChamada(ids_aula[2], NULL, 0);
+
+    FrequenciaAluno aluno;
+    frequenciaDoAluno(turma.id, ras[ALUNOS_TESTE_FREQUENCIA - 1], &aluno);
+    if (aluno.chamadas != 3 || aluno.presencas != 1) {
+        erros++;
+    }
+    frequenciaDoAluno(turma.id, ras[1], &aluno);
+    if (aluno.chamadas != 2 || aluno.presencas != 2) {
+        erros++;
+    }
+    frequenciaDoAluno(turma.id, fora, &aluno);
+    if (aluno.chamadas != 1 || aluno.presencas != 1) {
+        erros++;
+    }
+    long long celulas = 3LL * ALUNOS_TESTE_FREQUENCIA;
+    erros += conferirFrequenciaTurma("Tres chamadas:", turma.id, 3, celulas, celulas - 3);
+
+    // 4. Releitura do arquivo, exclusão e compactação
+    usarArquivoFrequencia(ARQUIVO_TESTE_FREQUENCIA);
+    erros += conferirFrequenciaTurma("Relido do arquivo:", turma.id, 3, celulas, celulas - 3);
+
+    excluirChamada(ids_aula[2]);
+    compactarFrequencias();
+    usarArquivoFrequencia(ARQUIVO_TESTE_FREQUENCIA);
+    long tamanho = 0;
+    free(lerArquivoTeste(ARQUIVO_TESTE_FREQUENCIA, &tamanho));
+    erros += conferirFrequenciaTurma("Excluida e compactado:", turma.id, 2, celulas - ALUNOS_TESTE_FREQUENCIA,
+                                     celulas - ALUNOS_TESTE_FREQUENCIA - 3);
+    printf("  Arquivo compactado: %ld bytes\n", tamanho);
+
+    // 5. Registro cortado no fim (queda durante a gravação) é descartado
+    FILE *arquivo = fopen(ARQUIVO_TESTE_FREQUENCIA, "ab");
+    if (arquivo != NULL) {
+        fwrite("\x40\x00\x00\x00\x01", 1, 5, arquivo);
+        fclose(arquivo);
+    }
+    usarArquivoFrequencia(ARQUIVO_TESTE_FREQUENCIA);
+    registrarChamada(ids_aula[2], NULL, 0);
+    usarArquivoFrequencia(ARQUIVO_TESTE_FREQUENCIA);
+    erros += conferirFrequenciaTurma("Apos registro cortado:", turma.id, 3, celulas, celulas - 3);
+
+    usarArquivoFrequencia(NULL);
+    removerArquivoFrequenciaTeste();
+    saida = silenciarSaida(-1);
+    for (int i = 0; i < 3; i++) {
+        excluirAula(ids_aula[i]);
+    }
+    for (int i = 0; i <= ALUNOS_TESTE_FREQUENCIA; i++) {
+        removerAlunoTurma(ras[i], turma.id);
+        excluirAluno(ras[i]);
+    }
+    excluirTurma(turma.id);
+    silenciarSaida(saida);
+
+    if (erros == 0) {
+        printf("\n%sFrequencia por aula ok.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha na frequencia por aula (%d).%s\n", RED, erros, RESET);
+    }
+}
+
+#define ARQUIVO_TESTE_IMPORTACAO_NOTAS "data/teste_importacao_notas.csv"
+#define LINHAS_TESTE_BOLETIM 1003      // Não múltiplo de 4: exercita o resto escalar
+
+static int conferirEstatisticas(const char *rotulo, const EstatisticasNotas *obtidas, int quantidade,
+                                double media, double desvio, float minima, float maxima) {
+    int ok = obtidas->quantidade == quantidade && fabs(obtidas->media - media) < 1e-4 &&
+             fabs(obtidas->desvio - desvio) < 1e-4 && obtidas->minima == minima && obtidas->maxima == maxima;
+    printf("  %-26s %d notas, media %.4f, desvio %.4f, min %.2f, max %.2f %s\n", rotulo, obtidas->quantidade,
+           obtidas->media, obtidas->desvio, (double)obtidas->minima, (double)obtidas->maxima,
+           ok ? "(ok)" : "(ERRO)");
+    return ok ? 0 : 1;
+}
+
+static void testarNotas(void) {
+    imprimirTitulo("TESTE: NOTAS (BOLETIM EM COLUNAS)", BLUE);
+
+    int ras[5];
+    int ids_atividade[2];
+    int erros = 0;
+
+    int saida = silenciarSaida(-1);
+    Turma turma = {gerarProximoIDTurma(), "ADS Notas", "Professora Gabi", 2025, 2};
+    cadastrarTurma(&turma);
+    int ra_base = gerarRaNovo();
+    for (int i = 0; i < 5; i++) {
+        Aluno aluno = {ra_base + i, "Aluno Notas", "notas@teste.com", 1};
+        cadastrarAluno(&aluno);
+        ras[i] = aluno.ra;
+        if (i < 4) {
+            associarAlunoTurma(ras[i], turma.id);
+        }
+    }
+    for (int i = 0; i < 2; i++) {
+        Atividade atividade = {gerarProximoIDAtividade(), turma.id, "Prova", "Notas", ""};
+        cadastrarAtividade(&atividade);
+        ids_atividade[i] = atividade.id;
+    }
+    silenciarSaida(saida);
+
+    // 1. Lançamento individual: fora da faixa, fora da turma e atividade inexistente são recusados
+    float notas[4] = {10.0f, 7.5f, 5.0f, 2.5f};
+    int lancadas = 0;
+    for (int i = 0; i < 4; i++) {
+        lancadas += lancarNota(ras[i], ids_atividade[0], notas[i]);
+    }
+    saida = silenciarSaida(-1);
+    int recusadas = lancarNota(ras[0], ids_atividade[1], 10.5f) + lancarNota(ras[4], ids_atividade[0], 8.0f) +
+                    lancarNota(ras[0], -1, 8.0f);
+    silenciarSaida(saida);
+    printf("  Lancadas: %d; recusadas aceitas: %d\n", lancadas, recusadas);
+    if (lancadas != 4 || recusadas != 0) {
+        erros++;
+    }
+
+    EstatisticasNotas estatisticas;
+    estatisticasDaAtividade(ids_atividade[0], &estatisticas);
+    erros += conferirEstatisticas("Atividade 1:", &estatisticas, 4, 6.25, sqrt(7.8125), 2.5f, 10.0f);
+    if (estatisticas.histograma[9] != 1 || estatisticas.histograma[7] != 1 || estatisticas.histograma[5] != 1 ||
+        estatisticas.histograma[2] != 1) {
+        printf("  %sHistograma incorreto.%s\n", RED, RESET);
+        erros++;
+    }
+
+    // 2. Importação em lote: só entram as linhas válidas
+    FILE *arquivo = fopen(ARQUIVO_TESTE_IMPORTACAO_NOTAS, "w");
+    if (arquivo != NULL) {
+        fprintf(arquivo, "RA,ID_Atividade,Nota\n");
+        fprintf(arquivo, "%d,%d,8\n%d,%d,6\n%d,%d,4\n", ras[0], ids_atividade[1], ras[1], ids_atividade[1],
+                ras[2], ids_atividade[1]);
+        fprintf(arquivo, "%d,%d,9\n%d,%d,12\nlinha invalida\n", ras[4], ids_atividade[1], ras[3],
+                ids_atividade[1]);
+        fclose(arquivo);
+    }
+    int importadas = importarNotas(ARQUIVO_TESTE_IMPORTACAO_NOTAS);
+    remove(ARQUIVO_TESTE_IMPORTACAO_NOTAS);
+    printf("  Importadas: %d de 6 linhas\n", importadas);
+    if (importadas != 3) {
+        erros++;
+    }
+
+    estatisticasDaTurma(turma.id, &estatisticas);
+    erros += conferirEstatisticas("Turma (7 notas):", &estatisticas, 7, 43.0 / 7.0,
+                                  sqrt(303.5 / 7.0 - (43.0 / 7.0) * (43.0 / 7.0)), 2.5f, 10.0f);
+    estatisticasDoAluno(ras[0], turma.id, &estatisticas);
+    erros += conferirEstatisticas("Aluno 1 na turma:", &estatisticas, 2, 9.0, 1.0, 8.0f, 10.0f);
+
+    // 3. Média ponderada (peso 1 e 3) e média de cada aluno da turma
+    float pesos[2] = {1.0f, 3.0f};
+    double media = 0.0;
+    mediaPonderadaDoAluno(ras[1], ids_atividade, pesos, 2, &media);
+    int ras_media[8];
+    double medias[8];
+    int com_nota = mediasDaTurma(turma.id, ras_media, medias, 8);
+    printf("  Media ponderada do aluno 2: %.3f; alunos com media: %d\n", media, com_nota);
+    if (fabs(media - 6.375) > 1e-9 || com_nota != 4) {
+        erros++;
+    }
+    for (int i = 0; i < com_nota; i++) {
+        if (ras_media[i] == ras[3] && fabs(medias[i] - 2.5) > 1e-9) {
+            erros++;
+        }
+    }
+
+    // 4. CSV gravado e remoção
+    long tamanho = 0;
+    char *conteudo = lerArquivoTeste(ARQUIVO_NOTAS, &tamanho);
+    int linhas_csv = 0;
+    for (long i = 0; conteudo != NULL && i < tamanho; i++) {
+        linhas_csv += conteudo[i] == '\n';
+    }
+    free(conteudo);
+    float nota = 0.0f;
+    int removida = removerNota(ras[0], ids_atividade[0]);
+    printf("  CSV com %d linhas; nota removida: %d; ainda existe: %d\n", linhas_csv, removida,
+           obterNota(ras[0], ids_atividade[0], &nota));
+    if (linhas_csv < 8 || !removida || obterNota(ras[0], ids_atividade[0], &nota) ||
+        !obterNota(ras[1], ids_atividade[0], &nota) || nota != 7.5f) {
+        erros++;
+    }
+
+    // 5. Boletim avulso: resultado do caminho vetorial igual ao do laço simples
+    Boletim *boletim = criarBoletim();
+    double soma = 0.0;
+    double soma_quadrados = 0.0;
+    int quantidade = 0;
+    for (int i = 0; i < LINHAS_TESTE_BOLETIM; i++) {
+        if (i % 7 == 3) {
+            continue;                  // Linhas sem nota no meio dos blocos
+        }
+        float valor = (float)(i % 41) / 4.0f;
+        lancarNotaBoletim(boletim, 1000 + i, 1, valor);
+        soma += valor;
+        soma_quadrados += (double)valor * valor;
+        quantidade++;
+    }
+    estatisticasAtividadesBoletim(boletim, NULL, 0, &estatisticas);
+    double media_esperada = soma / quantidade;
+    erros += conferirEstatisticas("Boletim avulso:", &estatisticas, quantidade, media_esperada,
+                                  sqrt(soma_quadrados / quantidade - media_esperada * media_esperada), 0.0f, 10.0f);
+    liberarBoletim(boletim);
+
+    saida = silenciarSaida(-1);
+    for (int i = 0; i < 4; i++) {
+        removerNota(ras[i], ids_atividade[0]);
+        removerNota(ras[i], ids_atividade[1]);
+    }
+    for (int i = 0; i < 2; i++) {
+        excluirAtividade(ids_atividade[i]);
+    }
+    for (int i = 0; i < 5; i++) {
+        removerAlunoTurma(ras[i], turma.id);
+        excluirAluno(ras[i]);
+    }
+    excluirTurma(turma.id);
+    silenciarSaida(saida);
+
+    if (erros == 0) {
+        printf("\n%sNotas ok.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha nas notas (%d).%s\n", RED, erros, RESET);
+    }
+}
+
+static void testarAlunosDaTurmaDetalhado(void) {
+    imprimirTitulo("TESTE: ALUNOS DA TURMA JUNTADOS AO CADASTRO", BLUE);
+
+    Aluno linhas[8];
+    int ras[3];
+    int erros = 0;
+
+    int saida = silenciarSaida(-1);
+    Turma turma = {gerarProximoIDTurma(), "ADS Roster", "Professora Gabi", 2025, 2};
+    cadastrarTurma(&turma);
+    int ra_base = gerarRaNovo();
+    // RAs decrescentes: a ordem da resposta segue as matrículas, não o índice
+    for (int i = 0; i < 3; i++) {
+        Aluno aluno = {ra_base + 2 - i, "Aluno Roster", "roster@teste.com", 1};
+        snprintf(aluno.nome, sizeof(aluno.nome), "Aluno Roster %d", i + 1);
+        cadastrarAluno(&aluno);
+        associarAlunoTurma(aluno.ra, turma.id);
+        ras[i] = aluno.ra;
+    }
+    excluirAluno(ras[1]);
+    Aluno repetido = {ras[0], "Repetido", "repetido@teste.com", 1};
+    int duplicado = cadastrarAluno(&repetido);
+    silenciarSaida(saida);
+
+    // 1. Todos, na ordem das matrículas, iguais à busca um a um
+    int total = listarAlunosDaTurmaDetalhado(turma.id, 0, linhas, 8);
+    printf("  Todos: %d linhas\n", total);
+    if (total != 3 || duplicado) {
+        erros++;
+    }
+    for (int i = 0; i < total && i < 3; i++) {
+        Aluno avulso;
+        int achou = obterAlunoPorRA(ras[i], &avulso);
+        printf("    RA %d - %s (%s)\n", linhas[i].ra, linhas[i].nome, linhas[i].ativo ? "Ativo" : "Inativo");
+        if (!achou || linhas[i].ra != ras[i] || strcmp(linhas[i].nome, avulso.nome) != 0 ||
+            strcmp(linhas[i].email, avulso.email) != 0 || linhas[i].ativo != avulso.ativo) {
+            erros++;
+        }
+    }
+
+    // 2. Só ativos e limite do destino
+    int ativos = listarAlunosDaTurmaDetalhado(turma.id, 1, linhas, 8);
+    int limitado = listarAlunosDaTurmaDetalhado(turma.id, 0, linhas, 2);
+    printf("  Somente ativos: %d; com max = 2: %d\n", ativos, limitado);
+    if (ativos != 2 || limitado != 2) {
+        erros++;
+    }
+
+    // 3. RA sem cadastro vira linha marcada (ou some com apenas_ativos)
+    int orfao[2] = {ras[2], -ra_base};
+    int juntadas = juntarAlunosPorRA(orfao, 2, 0, linhas, 8);
+    int juntadas_ativas = juntarAlunosPorRA(orfao, 2, 1, linhas + 2, 6);
+    printf("  RA sem cadastro: %d linhas (ativo %d); so ativos: %d\n", juntadas, linhas[1].ativo,
+           juntadas_ativas);
+    if (juntadas != 2 || linhas[1].ativo != -1 || linhas[1].ra != -ra_base || linhas[1].nome[0] != '\0' ||
+        juntadas_ativas != 1) {
+        erros++;
+    }
+
+    saida = silenciarSaida(-1);
+    for (int i = 0; i < 3; i++) {
+        removerAlunoTurma(ras[i], turma.id);
+        excluirAluno(ras[i]);
+    }
+    excluirTurma(turma.id);
+    silenciarSaida(saida);
+
+    if (erros == 0) {
+        printf("\n%sAlunos da turma ok.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha nos alunos da turma (%d).%s\n", RED, erros, RESET);
+    }
+}
+
+#define ARQUIVO_TESTE_JOURNAL "data/teste_journal.csv"
+
+// Conta as linhas de um CSV cujo segundo campo é a turma (aulas, atividades, matrículas)
+static int contarLinhasDaTurmaCSV(const char *arquivo, int id_turma) {
+    char linha[1024];
+    int primeiro;
+    int turma;
+    int total = 0;
+    FILE *csv = fopen(arquivo, "r");
+
+    if (csv == NULL) {
+        return -1;
+    }
+    while (fgets(linha, sizeof(linha), csv) != NULL) {
+        if (sscanf(linha, "%d,%d", &primeiro, &turma) == 2 && turma == id_turma) {
+            total++;
+        }
+    }
+    fclose(csv);
+    return total;
+}
+
+static int conferirDependentes(const char *etapa, const DependentesTurma *obtidos, int aulas, int atividades,
+                               int notas, int matriculas, int chamadas) {
+    printf("  %-22s %d aulas, %d atividades, %d notas, %d matriculas, %d chamadas\n", etapa, obtidos->aulas,
+           obtidos->atividades, obtidos->notas, obtidos->matriculas, obtidos->chamadas);
+    if (obtidos->aulas != aulas || obtidos->atividades != atividades || obtidos->notas != notas ||
+        obtidos->matriculas != matriculas || obtidos->chamadas != chamadas) {
+        printf("  %sEsperado: %d, %d, %d, %d, %d.%s\n", RED, aulas, atividades, notas, matriculas, chamadas, RESET);
+        return 1;
+    }
+    return 0;
+}
+
+// Grava um arquivo de texto de uma linha (journal simulado)
+static void escreverArquivoTeste(const char *caminho, const char *conteudo) {
+    FILE *arquivo = fopen(caminho, "w");
+    if (arquivo != NULL) {
+        fputs(conteudo, arquivo);
+        fclose(arquivo);
+    }
+}
+
+static void testarExclusaoEmCascata(void) {
+    imprimirTitulo("TESTE: EXCLUSAO DE TURMA EM CASCATA", BLUE);
+
+    int ras[3];
+    int ids_aula[3];
+    int ids_atividade[3];
+    int erros = 0;
+
+    removerArquivoFrequenciaTeste();
+    usarArquivoFrequencia(ARQUIVO_TESTE_FREQUENCIA);
+
+    // Turma excluída (2 aulas, 2 atividades, 3 alunos) e turma vizinha (1 de cada)
+    int saida = silenciarSaida(-1);
+    Turma turma = {gerarProximoIDTurma(), "ADS Cascata", "Professora Gabi", 2025, 2};
+    cadastrarTurma(&turma);
+    Turma vizinha = {gerarProximoIDTurma(), "ADS Vizinha", "Professora Gabi", 2025, 2};
+    cadastrarTurma(&vizinha);
+    int ra_base = gerarRaNovo();
+    for (int i = 0; i < 3; i++) {
+        Aluno aluno = {ra_base + i, "Aluno Cascata", "cascata@teste.com", 1};
+        cadastrarAluno(&aluno);
+        ras[i] = aluno.ra;
+        associarAlunoTurma(ras[i], turma.id);
+    }
+    associarAlunoTurma(ras[0], vizinha.id);
+    for (int i = 0; i < 3; i++) {
+        Aula aula = {gerarProximoIDAula(), i < 2 ? turma.id : vizinha.id, "01/09/2025", "Cascata"};
+        registrarAula(&aula);
+        ids_aula[i] = aula.id;
+        Atividade atividade = {gerarProximoIDAtividade(), aula.id_turma, "Prova", "Cascata", ""};
+        cadastrarAtividade(&atividade);
+        ids_atividade[i] = atividade.id;
+    }
+    for (int i = 0; i < 3; i++) {
+        lancarNota(ras[i], ids_atividade[0], 5.0f + (float)i);
+    }
+    lancarNota(ras[0], ids_atividade[2], 9.0f);
+    registrarChamada(ids_aula[0], NULL, 0);
+    registrarChamada(ids_aula[2], NULL, 0);
+    silenciarSaida(saida);
+
+    // 1. Simulação: conta pelos agregados e não altera nada
+    DependentesTurma dependentes;
+    excluirTurmaEmCascata(turma.id, 1, &dependentes);
+    erros += conferirDependentes("Simulacao:", &dependentes, 2, 2, 3, 3, 1);
+    if (contarAulasDaTurma(turma.id) != 2 || contarLinhasDaTurmaCSV(ARQUIVO_ALUNO_TURMA, turma.id) != 3) {
+        erros++;
+    }
+
+    // 2. Transação desfeita: memória volta ao CSV, que não mudou
+    saida = silenciarSaida(-1);
+    int iniciada = iniciarTransacaoTabelas();
+    int removidas = excluirAulasDaTurma(turma.id, NULL, 0);
+    int em_transacao = emTransacaoTabelas();
+    int publicada = concluirTransacaoTabelas(0);
+    silenciarSaida(saida);
+    printf("  Desfeita: %d aulas removidas em memoria, publicada %d, aulas agora %d\n", removidas, publicada,
+           contarAulasDaTurma(turma.id));
+    if (!iniciada || removidas != 2 || !em_transacao || publicada || emTransacaoTabelas() ||
+        contarAulasDaTurma(turma.id) != 2 || contarLinhasDaTurmaCSV(ARQUIVO_AULAS, turma.id) != 2) {
+        erros++;
+    }
+
+    // 3. Exclusão em cascata: tudo da turma sai, a vizinha fica intacta
+    saida = silenciarSaida(-1);
+    int excluida = excluirTurmaEmCascata(turma.id, 0, &dependentes);
+    silenciarSaida(saida);
+    erros += conferirDependentes("Excluidos:", &dependentes, 2, 2, 3, 3, 1);
+    Turma copia;
+    float nota = 0.0f;
+    int restantes = contarAulasDaTurma(turma.id) + contarAtividadesDaTurma(turma.id) +
+                    contarAlunosDaTurma(turma.id, 0) + obterNota(ras[1], ids_atividade[0], &nota) +
+                    (contarPresentesAula(ids_aula[0], NULL) >= 0);
+    int restantes_csv = contarLinhasDaTurmaCSV(ARQUIVO_AULAS, turma.id) +
+                        contarLinhasDaTurmaCSV(ARQUIVO_ATIVIDADES, turma.id) +
+                        contarLinhasDaTurmaCSV(ARQUIVO_ALUNO_TURMA, turma.id);
+    FILE *journal = fopen(ARQUIVO_JOURNAL, "r");
+    printf("  Excluida: %d; restos em memoria: %d; nos CSVs: %d; journal pendente: %s\n", excluida, restantes,
+           restantes_csv, journal ? "sim" : "nao");
+    if (!excluida || obterTurmaPorID(turma.id, &copia) || restantes != 0 || restantes_csv != 0 ||
+        journal != NULL) {
+        erros++;
+    }
+    if (journal != NULL) {
+        fclose(journal);
+    }
+    if (contarAulasDaTurma(vizinha.id) != 1 || contarAtividadesDaTurma(vizinha.id) != 1 ||
+        contarAlunosDaTurma(vizinha.id, 0) != 1 || !obterNota(ras[0], ids_atividade[2], &nota) ||
+        contarPresentesAula(ids_aula[2], NULL) != 1) {
+        printf("  %sTurma vizinha alterada.%s\n", RED, RESET);
+        erros++;
+    }
+
+    // 4. Queda depois da confirmação: a recuperação conclui o rename
+    escreverArquivoTeste(ARQUIVO_TESTE_JOURNAL, "antigo\n");
+    escreverArquivoTeste(ARQUIVO_TESTE_JOURNAL ".tmp", "novo\n");
+    escreverArquivoTeste(ARQUIVO_JOURNAL, JOURNAL_CABECALHO "\n" ARQUIVO_TESTE_JOURNAL "\nCONFIRMADA 1\n");
+    saida = silenciarSaida(-1);
+    int republicados = recuperarJournal();
+    silenciarSaida(saida);
+    long tamanho = 0;
+    char *conteudo = lerArquivoTeste(ARQUIVO_TESTE_JOURNAL, &tamanho);
+    int confirmado_aplicado = conteudo != NULL && tamanho == 5 && memcmp(conteudo, "novo\n", 5) == 0;
+    free(conteudo);
+
+    // Sem "CONFIRMADA" a publicação não aconteceu
+    escreverArquivoTeste(ARQUIVO_TESTE_JOURNAL ".tmp", "descartado\n");
+    escreverArquivoTeste(ARQUIVO_JOURNAL, JOURNAL_CABECALHO "\n" ARQUIVO_TESTE_JOURNAL "\n");
+    int sem_confirmacao = recuperarJournal();
+    conteudo = lerArquivoTeste(ARQUIVO_TESTE_JOURNAL, &tamanho);
+    int nao_confirmado_ignorado = conteudo != NULL && tamanho == 5 && memcmp(conteudo, "novo\n", 5) == 0;
+    free(conteudo);
+    journal = fopen(ARQUIVO_JOURNAL, "r");
+    printf("  Recuperacao: %d republicado(s), conteudo novo: %d; sem confirmacao: %d, ignorado: %d\n",
+           republicados, confirmado_aplicado, sem_confirmacao, nao_confirmado_ignorado);
+    if (republicados != 1 || !confirmado_aplicado || sem_confirmacao != 0 || !nao_confirmado_ignorado ||
+        journal != NULL) {
+        erros++;
+    }
+    if (journal != NULL) {
+        fclose(journal);
+    }
+    remove(ARQUIVO_TESTE_JOURNAL);
+    remove(ARQUIVO_TESTE_JOURNAL ".tmp");
+    remove(ARQUIVO_TESTE_JOURNAL ".lock");
+
+    saida = silenciarSaida(-1);
+    removerNota(ras[0], ids_atividade[2]);
+    excluirAtividade(ids_atividade[2]);
+    excluirAula(ids_aula[2]);
+    for (int i = 0; i < 3; i++) {
+        removerAlunoTurma(ras[i], vizinha.id);
+        excluirAluno(ras[i]);
+    }
+    excluirTurma(vizinha.id);
+    silenciarSaida(saida);
+    usarArquivoFrequencia(NULL);
+    removerArquivoFrequenciaTeste();
+
+    if (erros == 0) {
+        printf("\n%sExclusao em cascata ok.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha na exclusao em cascata (%d).%s\n", RED, erros, RESET);
+    }
+}
+
+// Linhas do CSV cujo primeiro campo é "id"
+static int contarLinhasComIDCSV(const char *arquivo, int id) {
+    char linha[1024];
+    int primeiro;
+    int total = 0;
+    FILE *csv = fopen(arquivo, "r");
+
+    if (csv == NULL) {
+        return -1;
+    }
+    while (fgets(linha, sizeof(linha), csv) != NULL) {
+        if (sscanf(linha, "%d,", &primeiro) == 1 && primeiro == id) {
+            total++;
+        }
+    }
+    fclose(csv);
+    return total;
+}
+
+// Leitura de outra thread durante a transação (caminhos que não esperam travas)
+typedef struct {
+    int id_turma;
+    int contadas;
+    int listadas;
+} LeituraForaTransacao;
+
+static void *lerAulasForaDaTransacao(void *arg) {
+    LeituraForaTransacao *leitura = (LeituraForaTransacao *)arg;
+    Aula vistas[8];
+
+    leitura->contadas = contarAulasDaTurma(leitura->id_turma);
+    leitura->listadas = listarAulasDaTurma(leitura->id_turma, vistas, 8);
+    return NULL;
+}
+
+static void testarTransacoesEntreTabelas(void) {
+    imprimirTitulo("TESTE: TRANSACOES ENTRE TABELAS", BLUE);
+
+    Turma copia;
+    int ras[3];
+    int ids_aula[2];
+    int erros = 0;
+
+    removerArquivoFrequenciaTeste();
+    usarArquivoFrequencia(ARQUIVO_TESTE_FREQUENCIA);
+
+    int saida = silenciarSaida(-1);
+    int ra_base = gerarRaNovo();
+    for (int i = 0; i < 3; i++) {
+        Aluno aluno = {ra_base + i, "Aluno Transacao", "transacao@teste.com", 1};
+        cadastrarAluno(&aluno);
+        ras[i] = aluno.ra;
+    }
+    silenciarSaida(saida);
+
+    // 1. Leitura das próprias escritas: a turma e a matrícula já aparecem
+    //    para a thread da transação, mas os CSVs só mudam na confirmação
+    saida = silenciarSaida(-1);
+    Turma origem = {gerarProximoIDTurma(), "ADS Transacao", "Professor Caio", 2025, 1};
+    iniciarTransacaoTabelas();
+    cadastrarTurma(&origem);
+    associarAlunoTurma(ras[0], origem.id);
+    int vista = obterTurmaPorID(origem.id, &copia) && verificarMatricula(ras[0], origem.id) &&
+                contarAlunosDaTurma(origem.id, 0) == 1;
+    int csv_antes = contarLinhasComIDCSV(ARQUIVO_TURMAS, origem.id) +
+                    contarLinhasDaTurmaCSV(ARQUIVO_ALUNO_TURMA, origem.id);
+    int publicada = concluirTransacaoTabelas(1);
+    int csv_depois = contarLinhasComIDCSV(ARQUIVO_TURMAS, origem.id) +
+                     contarLinhasDaTurmaCSV(ARQUIVO_ALUNO_TURMA, origem.id);
+    silenciarSaida(saida);
+    printf("  Dentro da transacao: visivel %d, linhas nos CSVs %d; publicada %d, linhas depois %d\n", vista,
+           csv_antes, publicada, csv_depois);
+    if (!vista || csv_antes != 0 || !publicada || csv_depois != 2) {
+        erros++;
+    }
+
+    // 2. Turma com alunos: um RA inexistente desfaz a turma e as matrículas
+    saida = silenciarSaida(-1);
+    int com_invalido[3] = {ras[1], ra_base + 1000, ras[2]};
+    Turma recusada = {gerarProximoIDTurma(), "ADS Recusada", "Professor Caio", 2025, 1};
+    int aceita = cadastrarTurmaComAlunos(&recusada, com_invalido, 3);
+    int recusada_visivel = obterTurmaPorID(recusada.id, &copia) + contarAlunosDaTurma(recusada.id, 0) +
+                           contarLinhasComIDCSV(ARQUIVO_TURMAS, recusada.id) +
+                           contarLinhasDaTurmaCSV(ARQUIVO_ALUNO_TURMA, recusada.id);
+    Turma destino = {gerarProximoIDTurma(), "ADS Destino", "Professor Caio", 2025, 1};
+    int criada = cadastrarTurmaComAlunos(&destino, &ras[1], 2);
+    silenciarSaida(saida);
+    printf("  Turma com RA invalido: aceita %d, restos %d; turma valida: %d com %d alunos (%d no CSV)\n", aceita,
+           recusada_visivel, criada, contarAlunosDaTurma(destino.id, 0),
+           contarLinhasDaTurmaCSV(ARQUIVO_ALUNO_TURMA, destino.id));
+    if (aceita || recusada_visivel != 0 || !criada || contarAlunosDaTurma(destino.id, 0) != 2 ||
+        contarLinhasDaTurmaCSV(ARQUIVO_ALUNO_TURMA, destino.id) != 2) {
+        erros++;
+    }
+
+    // 3. Mover aulas: desistir da transação externa mantém aulas e chamada
+    saida = silenciarSaida(-1);
+    for (int i = 0; i < 2; i++) {
+        Aula aula = {gerarProximoIDAula(), origem.id, "02/09/2025", "Transacao"};
+        registrarAula(&aula);
+        ids_aula[i] = aula.id;
+    }
+    registrarChamada(ids_aula[0], NULL, 0);
+    iniciarTransacaoTabelas();
+    int movidas_desfeitas = moverAulasParaTurma(ids_aula, 2, destino.id);
+    int no_destino_dentro = contarAulasDaTurma(destino.id);
+    LeituraForaTransacao fora = {destino.id, -1, -1};
+    pthread_t leitor;
+    pthread_create(&leitor, NULL, lerAulasForaDaTransacao, &fora);
+    pthread_join(leitor, NULL);
+    concluirTransacaoTabelas(0);
+    silenciarSaida(saida);
+    printf("  Movidas e desfeitas: %d (destino tinha %d dentro, %d/%d para outra thread); origem %d aulas, "
+           "chamada %d presente(s)\n", movidas_desfeitas, no_destino_dentro, fora.contadas, fora.listadas,
+           contarAulasDaTurma(origem.id), contarPresentesAula(ids_aula[0], NULL));
+    if (movidas_desfeitas != 2 || no_destino_dentro != 2 || fora.contadas != 0 || fora.listadas != 0 ||
+        contarAulasDaTurma(origem.id) != 2 ||
+        contarLinhasDaTurmaCSV(ARQUIVO_AULAS, origem.id) != 2 || contarPresentesAula(ids_aula[0], NULL) != 1) {
+        erros++;
+    }
+
+    // Uma operação interna que falha derruba a externa inteira
+    saida = silenciarSaida(-1);
+    int ids_invalidos[2] = {ids_aula[0], -1};
+    iniciarTransacaoTabelas();
+    associarAlunoTurma(ras[2], origem.id);
+    int movidas_invalidas = moverAulasParaTurma(ids_invalidos, 2, destino.id);
+    int externa_publicada = concluirTransacaoTabelas(1);
+    silenciarSaida(saida);
+    printf("  Aula inexistente: movidas %d, externa publicada %d, matricula ficou %d\n", movidas_invalidas,
+           externa_publicada, verificarMatricula(ras[2], origem.id));
+    if (movidas_invalidas != -1 || externa_publicada || verificarMatricula(ras[2], origem.id) ||
+        contarAulasDaTurma(origem.id) != 2) {
+        erros++;
+    }
+
+    // Confirmada: aulas no destino e a chamada (da turma antiga) excluída
+    saida = silenciarSaida(-1);
+    int movidas = moverAulasParaTurma(ids_aula, 2, destino.id);
+    silenciarSaida(saida);
+    printf("  Movidas: %d; destino %d aulas (%d no CSV), chamada %d\n", movidas, contarAulasDaTurma(destino.id),
+           contarLinhasDaTurmaCSV(ARQUIVO_AULAS, destino.id), contarPresentesAula(ids_aula[0], NULL));
+    if (movidas != 2 || contarAulasDaTurma(destino.id) != 2 || contarAulasDaTurma(origem.id) != 0 ||
+        contarLinhasDaTurmaCSV(ARQUIVO_AULAS, destino.id) != 2 || contarPresentesAula(ids_aula[0], NULL) >= 0) {
+        erros++;
+    }
+
+    // Limpeza: as cascatas podem rodar dentro de uma transação maior
+    saida = silenciarSaida(-1);
+    iniciarTransacaoTabelas();
+    excluirTurmaEmCascata(origem.id, 0, NULL);
+    excluirTurmaEmCascata(destino.id, 0, NULL);
+    int limpa = concluirTransacaoTabelas(1);
+    for (int i = 0; i < 3; i++) {
+        excluirAluno(ras[i]);
+    }
+    silenciarSaida(saida);
+    if (!limpa || obterTurmaPorID(origem.id, &copia) || obterTurmaPorID(destino.id, &copia) ||
+        contarLinhasDaTurmaCSV(ARQUIVO_AULAS, destino.id) != 0) {
+        printf("  %sLimpeza em transacao falhou.%s\n", RED, RESET);
+        erros++;
+    }
+    usarArquivoFrequencia(NULL);
+    removerArquivoFrequenciaTeste();
+
+    if (erros == 0) {
+        printf("\n%sTransacoes entre tabelas ok.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha nas transacoes entre tabelas (%d).%s\n", RED, erros, RESET);
+    }
+}
+
+#define ARQUIVO_TESTE_BACKUP "data/teste_backup.pimb"
+#define DIRETORIO_TESTE_RESTAURACAO "data/teste_backup_restaurado"
+#define TURMAS_TESTE_BACKUP 30
+
+static const char *arquivos_teste_backup[] = {
+    "alunos.csv", "turmas.csv", "aulas.csv", "aluno_turma.csv", "atividades.csv", "notas.csv", "usuarios.csv",
+    "frequencia.dat"
+};
+
+typedef struct {
+    int ras[2];
+    int primeiro_id;
+    atomic_int criadas;
+} EscritorBackupTeste;
+
+// Cria turmas com duas matrículas cada, numa transação por turma
+static void *escritorBackupTeste(void *arg) {
+    EscritorBackupTeste *escritor = (EscritorBackupTeste *)arg;
+    for (int i = 0; i < TURMAS_TESTE_BACKUP; i++) {
+        Turma turma = {escritor->primeiro_id + i, "ADS Backup", "Professora Rita", 2025, 2};
+        if (cadastrarTurmaComAlunos(&turma, escritor->ras, 2)) {
+            atomic_fetch_add(&escritor->criadas, 1);
+        }
+    }
+    return NULL;
+}
+
+static void removerRestauracaoTeste(void) {
+    char caminho[256];
+    for (int i = 0; i < 8; i++) {
+        snprintf(caminho, sizeof(caminho), "%s/%s", DIRETORIO_TESTE_RESTAURACAO, arquivos_teste_backup[i]);
+        remove(caminho);
+        strncat(caminho, ".lock", sizeof(caminho) - strlen(caminho) - 1);
+        remove(caminho);
+    }
+    remove(DIRETORIO_TESTE_RESTAURACAO);
+}
+
+static void testarBackupConsistente(void) {
+    imprimirTitulo("TESTE: BACKUP CONSISTENTE COM ESCRITAS EM ANDAMENTO", BLUE);
+
+    EscritorBackupTeste escritor;
+    pthread_t id_escritor;
+    ResumoBackup resumo;
+    char turmas_csv[256];
+    char matriculas_csv[256];
+    int erros = 0;
+    int backups = 0;
+    int parciais = 0;
+    int orfas = 0;
+    double travado_maximo = 0.0;
+
+    removerRestauracaoTeste();
+    snprintf(turmas_csv, sizeof(turmas_csv), "%s/turmas.csv", DIRETORIO_TESTE_RESTAURACAO);
+    snprintf(matriculas_csv, sizeof(matriculas_csv), "%s/aluno_turma.csv", DIRETORIO_TESTE_RESTAURACAO);
+
+    int saida = silenciarSaida(-1);
+    int ra_base = gerarRaNovo();
+    for (int i = 0; i < 2; i++) {
+        Aluno aluno = {ra_base + i, "Aluno Backup", "backup@teste.com", 1};
+        cadastrarAluno(&aluno);
+        escritor.ras[i] = aluno.ra;
+    }
+    escritor.primeiro_id = gerarProximoIDTurma();
+    atomic_init(&escritor.criadas, 0);
+
+    // 1. Backups enquanto outra thread publica turma + matrículas juntas:
+    //    cada restauração tem as duas matrículas de toda turma, ou nenhuma
+    pthread_create(&id_escritor, NULL, escritorBackupTeste, &escritor);
+    while (atomic_load(&escritor.criadas) < TURMAS_TESTE_BACKUP && backups < 200) {
+        OpcoesVerificacao so_contar = {NULL, NULL, 1};
+        ResumoVerificacao verificacao;
+        int turmas = 0;
+        int matriculas = 0;
+
+        if (!criarBackup("data", ARQUIVO_TESTE_BACKUP, &resumo) ||
+            !restaurarBackup(ARQUIVO_TESTE_BACKUP, DIRETORIO_TESTE_RESTAURACAO, NULL)) {
+            erros++;
+            break;
+        }
+        backups++;
+        travado_maximo = (resumo.segundos_travado > travado_maximo) ? resumo.segundos_travado : travado_maximo;
+        for (int id = escritor.primeiro_id; id < escritor.primeiro_id + TURMAS_TESTE_BACKUP; id++) {
+            turmas += contarLinhasComIDCSV(turmas_csv, id);
+            matriculas += contarLinhasDaTurmaCSV(matriculas_csv, id);
+        }
+        parciais += (matriculas != 2 * turmas);
+        verificarDiretorioDados(DIRETORIO_TESTE_RESTAURACAO, &so_contar, &verificacao);
+        orfas += (int)verificacao.por_tipo[PROBLEMA_CHAVE_ESTRANGEIRA];
+        removerRestauracaoTeste();
+    }
+    pthread_join(id_escritor, NULL);
+    silenciarSaida(saida);
+    printf("  %d backups durante %d transacoes: %d com turma parcial, %d chave(s) orfa(s); travas por ate %.0f us\n",
+           backups, atomic_load(&escritor.criadas), parciais, orfas, travado_maximo * 1e6);
+    if (backups == 0 || atomic_load(&escritor.criadas) != TURMAS_TESTE_BACKUP || parciais != 0 || orfas != 0) {
+        erros++;
+    }
+
+    // 2. Backup final igual aos arquivos; restauração não sobrescreve
+    saida = silenciarSaida(-1);
+    int criado = criarBackup("data", ARQUIVO_TESTE_BACKUP, &resumo);
+    int restaurado = restaurarBackup(ARQUIVO_TESTE_BACKUP, DIRETORIO_TESTE_RESTAURACAO, NULL);
+    int sobrescreveu = restaurarBackup(ARQUIVO_TESTE_BACKUP, DIRETORIO_TESTE_RESTAURACAO, NULL);
+    silenciarSaida(saida);
+    long tamanho_original = 0;
+    long tamanho_restaurado = 0;
+    char *original = lerArquivoTeste(ARQUIVO_TURMAS, &tamanho_original);
+    char *copia = lerArquivoTeste(turmas_csv, &tamanho_restaurado);
+    int iguais = original != NULL && copia != NULL && tamanho_original == tamanho_restaurado &&
+                 memcmp(original, copia, (size_t)tamanho_original) == 0;
+    free(original);
+    free(copia);
+    removerRestauracaoTeste();
+    printf("  Backup final: %d arquivos, %lld -> %lld bytes; restaurado %d, turmas.csv igual %d, sobrescreveu %d\n",
+           resumo.arquivos, resumo.bytes, resumo.bytes_gravados, restaurado, iguais, sobrescreveu);
+    if (!criado || !restaurado || !iguais || sobrescreveu) {
+        erros++;
+    }
+
+    // 3. Um bit trocado é detectado pelo CRC
+    long tamanho = 0;
+    char *bruto = lerArquivoTeste(ARQUIVO_TESTE_BACKUP, &tamanho);
+    int detectado = 0;
+    if (bruto != NULL && tamanho > 100) {
+        bruto[tamanho / 2] ^= 0x10;
+        FILE *corrompido = fopen(ARQUIVO_TESTE_BACKUP, "wb");
+        if (corrompido != NULL) {
+            fwrite(bruto, 1, (size_t)tamanho, corrompido);
+            fclose(corrompido);
+        }
+        saida = silenciarSaida(-1);
+        detectado = !verificarBackup(ARQUIVO_TESTE_BACKUP, NULL);
+        silenciarSaida(saida);
+    }
+    free(bruto);
+    printf("  Backup corrompido detectado: %d\n", detectado);
+    if (!detectado) {
+        erros++;
+    }
+    remove(ARQUIVO_TESTE_BACKUP);
+    remove(ARQUIVO_TESTE_BACKUP ".lock");
+
+    saida = silenciarSaida(-1);
+    for (int i = 0; i < TURMAS_TESTE_BACKUP; i++) {
+        excluirTurmaEmCascata(escritor.primeiro_id + i, 0, NULL);
+    }
+    for (int i = 0; i < 2; i++) {
+        excluirAluno(escritor.ras[i]);
+    }
+    silenciarSaida(saida);
+
+    if (erros == 0) {
+        printf("\n%sBackup consistente ok.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha no backup consistente (%d).%s\n", RED, erros, RESET);
+    }
+}
+
+#define TOTAL_TESTE_INCREMENTAL 5
+
+static const char *arquivos_teste_incremental[TOTAL_TESTE_INCREMENTAL] = {
+    "data/teste_incremental_0.pimb", "data/teste_incremental_1.pimb", "data/teste_incremental_2.pimb",
+    "data/teste_incremental_3.pimb", "data/teste_incremental_4.pimb"
+};
+
+// Confere se "diretorio" tem os mesmos arquivos que "data" ("avisar" lista os diferentes)
+static int diretorioIgualAosDados(const char *diretorio, int avisar) {
+    char caminho[256];
+    int iguais = 1;
+
+    for (int i = 0; i < 8 && iguais; i++) {
+        long tamanho_original = -1;
+        long tamanho_copia = -1;
+        snprintf(caminho, sizeof(caminho), "data/%s", arquivos_teste_backup[i]);
+        char *original = lerArquivoTeste(caminho, &tamanho_original);
+        snprintf(caminho, sizeof(caminho), "%s/%s", diretorio, arquivos_teste_backup[i]);
+        char *copia = lerArquivoTeste(caminho, &tamanho_copia);
+        iguais = (original == NULL && copia == NULL) ||
+                 (original != NULL && copia != NULL && tamanho_original == tamanho_copia &&
+                  memcmp(original, copia, (size_t)tamanho_original) == 0);
+        if (!iguais && avisar) {
+            printf("  %s difere do original.\n", arquivos_teste_backup[i]);
+        }
+        free(original);
+        free(copia);
+    }
+    return iguais;
+}
+
+// Restaura os "total" primeiros backups da cadeia e compara com "data"
+static int restaurarCadeiaTeste(int total) {
+    int saida = silenciarSaida(-1);
+    int restaurado = restaurarCadeiaBackup(arquivos_teste_incremental, total, DIRETORIO_TESTE_RESTAURACAO, NULL);
+    silenciarSaida(saida);
+    int iguais = restaurado && diretorioIgualAosDados(DIRETORIO_TESTE_RESTAURACAO, 1);
+    removerRestauracaoTeste();
+    return iguais;
+}
+
+static void testarBackupIncremental(void) {
+    imprimirTitulo("TESTE: BACKUP INCREMENTAL E RESTAURACAO DA CADEIA", BLUE);
+
+    ResumoBackup completo;
+    ResumoBackup incrementais[TOTAL_TESTE_INCREMENTAL];
+    int ras[4];
+    int erros = 0;
+
+    removerRestauracaoTeste();
+    memset(incrementais, 0, sizeof(incrementais));
+
+    // 1. Completo; depois alunos novos, um alterado e uma turma com matrículas
+    int saida = silenciarSaida(-1);
+    int criado = criarBackup("data", arquivos_teste_incremental[0], &completo);
+    int ra_base = gerarRaNovo();
+    for (int i = 0; i < 4; i++) {
+        Aluno aluno = {ra_base + i, "Aluno Incremental", "incremental@teste.com", 1};
+        cadastrarAluno(&aluno);
+        ras[i] = aluno.ra;
+    }
+    Aluno alterado = {ras[1], "Aluno Incremental Alterado", "alterado@teste.com", 1};
+    atualizarAluno(&alterado);
+    Turma turma = {gerarProximoIDTurma(), "ADS Incremental", "Professor Caio", 2025, 2};
+    cadastrarTurmaComAlunos(&turma, ras, 3);
+    criado = criarBackupIncremental("data", arquivos_teste_incremental[0], arquivos_teste_incremental[1],
+                                    &incrementais[1]) && criado;
+
+    // 2. Exclusões sobre o incremental anterior
+    excluirAluno(ras[3]);
+    excluirTurmaEmCascata(turma.id, 0, NULL);
+    criado = criarBackupIncremental("data", arquivos_teste_incremental[1], arquivos_teste_incremental[2],
+                                    &incrementais[2]) && criado;
+    silenciarSaida(saida);
+    printf("  Completo: %lld bytes; incrementais: %lld bytes (%lld operacoes, %d inalterados), "
+           "%lld bytes (%lld operacoes, %d inalterados)\n",
+           completo.bytes_gravados, incrementais[1].bytes_gravados, incrementais[1].alteracoes,
+           incrementais[1].inalterados, incrementais[2].bytes_gravados, incrementais[2].alteracoes,
+           incrementais[2].inalterados);
+    if (!criado || incrementais[1].tipo != BACKUP_TIPO_INCREMENTAL || incrementais[1].base != completo.identificador ||
+        incrementais[1].alteracoes == 0 || incrementais[1].inalterados == 0 || incrementais[2].alteracoes == 0 ||
+        incrementais[1].bytes_gravados >= completo.bytes_gravados) {
+        erros++;
+    }
+
+    // 3. A cadeia restaura o instante do último; um elo fora de ordem é recusado
+    int iguais = restaurarCadeiaTeste(3);
+    const char *fora_de_ordem[2] = {arquivos_teste_incremental[0], arquivos_teste_incremental[2]};
+    saida = silenciarSaida(-1);
+    int recusada = !restaurarCadeiaBackup(fora_de_ordem, 2, DIRETORIO_TESTE_RESTAURACAO, NULL);
+    silenciarSaida(saida);
+    removerRestauracaoTeste();
+    printf("  Cadeia restaurada igual aos dados: %d; elo pulado recusado: %d\n", iguais, recusada);
+    if (!iguais || !recusada) {
+        erros++;
+    }
+
+    // 4. Geração de alunos.csv sem registro (como uma gravação do front end):
+    //    o incremental copia a tabela inteira e a cadeia continua certa
+    TravaArquivo trava = TRAVA_ARQUIVO_INIT;
+    if (travarArquivo(&trava, ARQUIVO_ALUNOS, TRAVA_EXCLUSIVA)) {
+        incrementarGeracaoArquivo(&trava);
+        destravarArquivo(&trava);
+    }
+    close(trava.descritor);
+    saida = silenciarSaida(-1);
+    alterado.ativo = 0;
+    atualizarAluno(&alterado);
+    criado = criarBackupIncremental("data", arquivos_teste_incremental[2], arquivos_teste_incremental[3],
+                                    &incrementais[3]);
+    silenciarSaida(saida);
+    iguais = restaurarCadeiaTeste(4);
+    printf("  Com buraco no registro: %lld operacoes, %d inalterados; cadeia igual: %d\n",
+           incrementais[3].alteracoes, incrementais[3].inalterados, iguais);
+    if (!criado || incrementais[3].alteracoes != 0 || !iguais) {
+        erros++;
+    }
+
+    // 5. Registro podado até o último backup: o próximo incremental segue
+    saida = silenciarSaida(-1);
+    long mantidas = podarAlteracoes("data", incrementais[3].sequencia);
+    excluirAluno(ras[0]);
+    criado = criarBackupIncremental("data", arquivos_teste_incremental[3], arquivos_teste_incremental[4],
+                                    &incrementais[4]);
+    silenciarSaida(saida);
+    iguais = restaurarCadeiaTeste(5);
+    printf("  Podado ate %lld (%ld operacoes mantidas); proximo incremental com %lld operacoes; cadeia igual: %d\n",
+           incrementais[3].sequencia, mantidas, incrementais[4].alteracoes, iguais);
+    if (mantidas < 0 || !criado || incrementais[4].alteracoes == 0 || !iguais) {
+        erros++;
+    }
+
+    saida = silenciarSaida(-1);
+    for (int i = 1; i < 3; i++) {
+        excluirAluno(ras[i]);
+    }
+    silenciarSaida(saida);
+    for (int i = 0; i < TOTAL_TESTE_INCREMENTAL; i++) {
+        char trava_backup[256];
+        remove(arquivos_teste_incremental[i]);
+        snprintf(trava_backup, sizeof(trava_backup), "%s.lock", arquivos_teste_incremental[i]);
+        remove(trava_backup);
+    }
+
+    if (erros == 0) {
+        printf("\n%sBackup incremental ok.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha no backup incremental (%d).%s\n", RED, erros, RESET);
+    }
+}
+
+#define DIRETORIO_TESTE_REPLICA "data/teste_replica"
+
+#ifndef _WIN32
+typedef struct {
+    pthread_t thread;
+    int descritor;
+    atomic_int parar;
+    int resultado;
+    MetricasReplicacao metricas;
+} LadoReplicacaoTeste;
+
+static void *primarioReplicacaoTeste(void *arg) {
+    LadoReplicacaoTeste *lado = (LadoReplicacaoTeste *)arg;
+    lado->resultado = servirReplicacao("data", lado->descritor, &lado->parar);
+    return NULL;
+}
+
+static void *seguidorReplicacaoTeste(void *arg) {
+    LadoReplicacaoTeste *lado = (LadoReplicacaoTeste *)arg;
+    lado->resultado = seguirReplicacao(DIRETORIO_TESTE_REPLICA, lado->descritor, &lado->parar, &lado->metricas);
+    return NULL;
+}
+
+// Conecta primário e seguidor por um par de sockets, cada um numa thread
+static int conectarReplicacaoTeste(LadoReplicacaoTeste *primario, LadoReplicacaoTeste *seguidor) {
+    int par[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, par) != 0) {
+        return 0;
+    }
+    memset(primario, 0, sizeof(*primario));
+    memset(seguidor, 0, sizeof(*seguidor));
+    primario->descritor = par[0];
+    seguidor->descritor = par[1];
+    pthread_create(&primario->thread, NULL, primarioReplicacaoTeste, primario);
+    pthread_create(&seguidor->thread, NULL, seguidorReplicacaoTeste, seguidor);
+    return 1;
+}
+
+// Encerra o primário (o seguidor vê a conexão cair) ou promove o seguidor
+static void encerrarReplicacaoTeste(LadoReplicacaoTeste *lado, LadoReplicacaoTeste *outro) {
+    atomic_store(&lado->parar, 1);
+    pthread_join(lado->thread, NULL);
+    close(lado->descritor);
+    pthread_join(outro->thread, NULL);
+    close(outro->descritor);
+}
+
+// Espera a réplica ficar igual a "data", com a mesma sequência (até 5 s)
+static int esperarReplicaTeste(void) {
+    struct timespec pausa = {0, 10000000};
+    for (int i = 0; i < 500; i++) {
+        if (ultimaSequenciaAlteracoes(DIRETORIO_TESTE_REPLICA) == ultimaSequenciaAlteracoes("data") &&
+            diretorioIgualAosDados(DIRETORIO_TESTE_REPLICA, 0)) {
+            return 1;
+        }
+        nanosleep(&pausa, NULL);
+    }
+    diretorioIgualAosDados(DIRETORIO_TESTE_REPLICA, 1);
+    return 0;
+}
+
+// Métricas depois de dois pulsos (o seguidor as regrava a cada pulso)
+static void lerMetricasReplicaTeste(MetricasReplicacao *metricas) {
+    struct timespec pulsos = {0, (INTERVALO_REPLICACAO_MS * 2) * 1000000L};
+    nanosleep(&pulsos, NULL);
+    lerMetricasReplicacao(DIRETORIO_TESTE_REPLICA, metricas);
+}
+
+static void removerReplicaTeste(void) {
+    static const char *extras[] = {ARQUIVO_ALTERACOES, ARQUIVO_ALTERACOES ".lock", ARQUIVO_SEGUIDOR,
+                                   ARQUIVO_METRICAS_REPLICACAO};
+    char caminho[256];
+
+    for (int i = 0; i < 8; i++) {
+        snprintf(caminho, sizeof(caminho), "%s/%s", DIRETORIO_TESTE_REPLICA, arquivos_teste_backup[i]);
+        remove(caminho);
+        strncat(caminho, ".lock", sizeof(caminho) - strlen(caminho) - 1);
+        remove(caminho);
+    }
+    for (int i = 0; i < 4; i++) {
+        snprintf(caminho, sizeof(caminho), "%s/%s", DIRETORIO_TESTE_REPLICA, extras[i]);
+        remove(caminho);
+    }
+    remove(DIRETORIO_TESTE_REPLICA);
+}
+#endif
+
+static void testarReplicacao(void) {
+    imprimirTitulo("TESTE: REPLICACAO PARA UM DIRETORIO RESERVA", BLUE);
+
+#ifdef _WIN32
+    printf("%sTeste disponivel apenas em sistemas POSIX (usa sockets AF_UNIX).%s\n", YELLOW, RESET);
+#else
+    LadoReplicacaoTeste primario;
+    LadoReplicacaoTeste seguidor;
+    MetricasReplicacao metricas;
+    int ras[3];
+    int erros = 0;
+
+    removerReplicaTeste();
+
+    // 1. Diretório vazio: cópia inicial pelo backup
+    int saida = silenciarSaida(-1);
+    int conectado = conectarReplicacaoTeste(&primario, &seguidor);
+    int iguais = conectado && esperarReplicaTeste();
+    silenciarSaida(saida);
+    lerMetricasReplicaTeste(&metricas);
+    printf("  Copia inicial igual aos dados: %d (%lld arquivos)\n", iguais, metricas.arquivos_copiados);
+    if (!iguais) {
+        erros++;
+    }
+    if (!conectado) {
+        printf("\n%sFalha na replicacao (socketpair).%s\n", RED, RESET);
+        return;
+    }
+
+    // 2. Gravações pelos módulos: o seguidor aplica as operações do log
+    saida = silenciarSaida(-1);
+    int ra_base = gerarRaNovo();
+    for (int i = 0; i < 3; i++) {
+        Aluno aluno = {ra_base + i, "Aluno Replicado", "replica@teste.com", 1};
+        cadastrarAluno(&aluno);
+        ras[i] = aluno.ra;
+    }
+    Aluno alterado = {ras[1], "Aluno Replicado Alterado", "replica.alterado@teste.com", 1};
+    atualizarAluno(&alterado);
+    Turma turma = {gerarProximoIDTurma(), "ADS Replica", "Professora Lia", 2025, 2};
+    cadastrarTurmaComAlunos(&turma, ras, 2);
+    iguais = esperarReplicaTeste();
+    silenciarSaida(saida);
+    lerMetricasReplicaTeste(&metricas);
+    printf("  Gravacoes replicadas: %d (%lld publicacoes, %lld operacoes, atraso maximo %.3f ms, "
+           "atraso atual %lld sequencias)\n",
+           iguais, metricas.publicacoes, metricas.operacoes, metricas.atraso_maximo_segundos * 1e3,
+           metricas.atraso_sequencias);
+    if (!iguais || metricas.publicacoes == 0 || metricas.operacoes == 0 || metricas.atraso_sequencias != 0) {
+        erros++;
+    }
+
+    // 3. alunos.csv gravado por fora (sem registro no log): o pulso revela a
+    //    divergência e o seguidor copia o arquivo
+    long long copiados = metricas.arquivos_copiados;
+    int ra_externo = ras[2] + 1;
+    TravaArquivo trava = TRAVA_ARQUIVO_INIT;
+    if (travarArquivo(&trava, ARQUIVO_ALUNOS, TRAVA_EXCLUSIVA)) {
+        FILE *arquivo = fopen(ARQUIVO_ALUNOS, "ab");
+        if (arquivo != NULL) {
+            fprintf(arquivo, "%d,Aluno Externo,externo@teste.com,1\n", ra_externo);
+            fclose(arquivo);
+        }
+        incrementarGeracaoArquivo(&trava);
+        destravarArquivo(&trava);
+    }
+    close(trava.descritor);
+    saida = silenciarSaida(-1);
+    iguais = esperarReplicaTeste();
+    silenciarSaida(saida);
+    lerMetricasReplicaTeste(&metricas);
+    printf("  Gravacao externa copiada: %d (%lld arquivo(s))\n", iguais, metricas.arquivos_copiados - copiados);
+    if (!iguais || metricas.arquivos_copiados == copiados) {
+        erros++;
+    }
+
+    // 4. Primário cai; gravações sem seguidor; na reconexão a sequência é retomada
+    encerrarReplicacaoTeste(&primario, &seguidor);
+    int continua_seguidor = seguidor.resultado == 0 && pidSeguidorReplicacao(DIRETORIO_TESTE_REPLICA) != 0;
+    saida = silenciarSaida(-1);
+    excluirAluno(ra_externo);
+    excluirTurmaEmCascata(turma.id, 0, NULL);
+    copiados = seguidor.metricas.arquivos_copiados;
+    conectado = conectarReplicacaoTeste(&primario, &seguidor);
+    iguais = conectado && esperarReplicaTeste();
+    silenciarSaida(saida);
+    lerMetricasReplicaTeste(&metricas);
+    printf("  Desconectado continua seguidor: %d; retomado sem nova copia: %d (igual: %d)\n", continua_seguidor,
+           metricas.arquivos_copiados == copiados, iguais);
+    if (!continua_seguidor || !iguais || metricas.arquivos_copiados != copiados) {
+        erros++;
+    }
+
+    // 5. Promoção: o diretório deixa de ser seguidor, com os dados e a sequência
+    encerrarReplicacaoTeste(&seguidor, &primario);
+    iguais = diretorioIgualAosDados(DIRETORIO_TESTE_REPLICA, 1);
+    int mesma_sequencia = ultimaSequenciaAlteracoes(DIRETORIO_TESTE_REPLICA) == ultimaSequenciaAlteracoes("data");
+    printf("  Promovido: %d; igual aos dados: %d; mesma sequencia: %d\n",
+           seguidor.resultado == 1 && pidSeguidorReplicacao(DIRETORIO_TESTE_REPLICA) == 0, iguais, mesma_sequencia);
+    if (seguidor.resultado != 1 || pidSeguidorReplicacao(DIRETORIO_TESTE_REPLICA) != 0 || !iguais ||
+        !mesma_sequencia) {
+        erros++;
+    }
+
+    saida = silenciarSaida(-1);
+    for (int i = 0; i < 3; i++) {
+        excluirAluno(ras[i]);
+    }
+    silenciarSaida(saida);
+    removerReplicaTeste();
+
+    if (erros == 0) {
+        printf("\n%sReplicacao ok.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha na replicacao (%d).%s\n", RED, erros, RESET);
+    }
+#endif
+}
+
+// Eventos do lote com a tabela e a operação dadas
+static int contarEventosTeste(const LoteAlteracoes *lote, const char *tabela, char operacao) {
+    int total = 0;
+    for (long i = 0; i < lote->total; i++) {
+        total += strcmp(lote->eventos[i].tabela, tabela) == 0 && lote->eventos[i].operacao == operacao;
+    }
+    return total;
+}
+
+// Sequências crescentes dentro do lote e depois de "anterior"
+static int sequenciasCrescentesTeste(const LoteAlteracoes *lote, long long anterior) {
+    for (long i = 0; i < lote->total; i++) {
+        if (lote->eventos[i].operacao != EVENTO_RECARREGAR) {
+            if (lote->eventos[i].sequencia <= anterior) {
+                return 0;
+            }
+            anterior = lote->eventos[i].sequencia;
+        }
+    }
+    return lote->ultima_sequencia >= anterior;
+}
+
+static void testarAssinatura(void) {
+    imprimirTitulo("TESTE: ASSINATURA DE ALTERACOES (CDC)", BLUE);
+
+    const char *tabelas[2] = {"aulas.csv", "aluno_turma.csv"};
+    AssinaturaAlteracoes assinatura;
+    AssinaturaAlteracoes retomada;
+    LoteAlteracoes lote;
+    int erros = 0;
+
+    memset(&lote, 0, sizeof(lote));
+
+    // 1. Assinatura a partir de agora: nada ainda
+    long long inicio = ultimaSequenciaAlteracoes("data");
+    int aberta = abrirAssinaturaAlteracoes(&assinatura, "data", tabelas, 2, ASSINATURA_DO_FIM);
+    long vazio = aberta ? lerLoteAlteracoes(&assinatura, &lote, 100, 0) : -1;
+    printf("  Assinatura aberta: %d; eventos sem alteracoes: %ld\n", aberta, vazio);
+    if (!aberta || vazio != 0) {
+        printf("\n%sFalha na assinatura de alteracoes.%s\n", RED, RESET);
+        liberarLoteAlteracoes(&lote);
+        return;
+    }
+
+    // 2. Matrícula, aula incluída, alterada e excluída; alunos.csv não é assinada
+    int saida = silenciarSaida(-1);
+    int ra = gerarRaNovo();
+    Aluno aluno = {ra, "Aluno Assinatura", "assinatura@teste.com", 1};
+    cadastrarAluno(&aluno);
+    Turma turma = {gerarProximoIDTurma(), "ADS Assinatura", "Professor Davi", 2025, 2};
+    cadastrarTurmaComAlunos(&turma, &ra, 1);
+    int id_aula = gerarProximoIDAula();
+    Aula aula = {id_aula, turma.id, "05/05/2025", "Aula assinada"};
+    registrarAula(&aula);
+    snprintf(aula.conteudo, sizeof(aula.conteudo), "Aula assinada (revisada)");
+    atualizarAula(&aula);
+    excluirAula(id_aula);
+    silenciarSaida(saida);
+    long total = lerLoteAlteracoes(&assinatura, &lote, 100, 1000);
+    int matriculas = contarEventosTeste(&lote, "aluno_turma.csv", ALTERACAO_INSERIR);
+    int incluidas = contarEventosTeste(&lote, "aulas.csv", ALTERACAO_INSERIR);
+    int alteradas = contarEventosTeste(&lote, "aulas.csv", ALTERACAO_ATUALIZAR);
+    int excluidas = contarEventosTeste(&lote, "aulas.csv", ALTERACAO_EXCLUIR);
+    int crescentes = sequenciasCrescentesTeste(&lote, inicio);
+    int registro = total > 0 && strstr(lote.eventos[total - 1].linha, "Aula assinada (revisada)") != NULL;
+    long long depois_aulas = lote.ultima_sequencia;
+    printf("  %ld evento(s): %d matricula(s), %d inclusao(oes), %d alteracao(oes), %d exclusao(oes); "
+           "sequencias crescentes: %d; registro no evento: %d\n",
+           total, matriculas, incluidas, alteradas, excluidas, crescentes, registro);
+    if (total != 4 || matriculas != 1 || incluidas != 1 || alteradas != 1 || excluidas != 1 || !crescentes ||
+        !registro) {
+        erros++;
+    }
+
+    // 3. Retomada pela sequência: os mesmos eventos, na mesma ordem
+    int retomou = abrirAssinaturaAlteracoes(&retomada, "data", tabelas, 2, inicio);
+    long total_retomada = retomou ? lerLoteAlteracoes(&retomada, &lote, 100, 0) : -1;
+    retomou = retomou && total_retomada == total && lote.ultima_sequencia == depois_aulas &&
+              contarEventosTeste(&lote, "aulas.csv", ALTERACAO_EXCLUIR) == 1;
+    fecharAssinaturaAlteracoes(&retomada);
+    printf("  Retomada da sequencia %lld: %ld evento(s), igual: %d\n", inicio, total_retomada, retomou);
+    if (!retomou) {
+        erros++;
+    }
+
+    // 4. Lotes de até 2 eventos: 5 aulas (uma publicação cada) em 3 lotes
+    saida = silenciarSaida(-1);
+    for (int i = 1; i <= 5; i++) {
+        Aula nova = {id_aula + i, turma.id, "12/05/2025", "Aula em lote"};
+        registrarAula(&nova);
+    }
+    silenciarSaida(saida);
+    int lotes = 0;
+    long recebidos = 0;
+    int em_ordem = 1;
+    long long anterior = depois_aulas;
+    while (lotes < 10) {
+        long lidos = lerLoteAlteracoes(&assinatura, &lote, 2, 0);
+        if (lidos <= 0) {
+            break;
+        }
+        em_ordem = em_ordem && lidos <= 2 && sequenciasCrescentesTeste(&lote, anterior);
+        anterior = lote.ultima_sequencia;
+        recebidos += lidos;
+        lotes++;
+    }
+    printf("  Lotes de ate 2 eventos: %ld evento(s) em %d lote(s), em ordem: %d\n", recebidos, lotes, em_ordem);
+    if (recebidos != 5 || lotes != 3 || !em_ordem) {
+        erros++;
+    }
+
+    // 5. aulas.csv gravado por fora (sem registro no log): RECARREGAR
+    TravaArquivo trava = TRAVA_ARQUIVO_INIT;
+    if (travarArquivo(&trava, ARQUIVO_AULAS, TRAVA_EXCLUSIVA)) {
+        incrementarGeracaoArquivo(&trava);
+        destravarArquivo(&trava);
+    }
+    close(trava.descritor);
+    lerLoteAlteracoes(&assinatura, &lote, 100, 0);
+    int recarga = lote.total == 1 && contarEventosTeste(&lote, "aulas.csv", EVENTO_RECARREGAR) == 1;
+    printf("  Gravacao externa: %ld evento(s), recarregar aulas.csv: %d\n", lote.total, recarga);
+    if (!recarga) {
+        erros++;
+    }
+
+    // 6. Log podado: a assinatura aberta reabre o log novo; uma retomada de
+    //    antes da poda recebe RECARREGAR das tabelas assinadas
+    saida = silenciarSaida(-1);
+    long mantidas = podarAlteracoes("data", ultimaSequenciaAlteracoes("data"));
+    excluirTurmaEmCascata(turma.id, 0, NULL);
+    silenciarSaida(saida);
+    long depois_poda = lerLoteAlteracoes(&assinatura, &lote, 100, 1000);
+    int cascata = mantidas >= 0 && depois_poda == 6 && contarEventosTeste(&lote, "aulas.csv", ALTERACAO_EXCLUIR) == 5 &&
+                  contarEventosTeste(&lote, "aluno_turma.csv", ALTERACAO_EXCLUIR) == 1;
+    retomou = abrirAssinaturaAlteracoes(&retomada, "data", tabelas, 2, inicio);
+    lerLoteAlteracoes(&retomada, &lote, 100, 0);
+    int recargas = contarEventosTeste(&lote, "aulas.csv", EVENTO_RECARREGAR) +
+                   contarEventosTeste(&lote, "aluno_turma.csv", EVENTO_RECARREGAR);
+    fecharAssinaturaAlteracoes(&retomada);
+    printf("  Depois da poda: exclusao em cascata com %ld evento(s): %d; retomada antiga recarrega: %d\n",
+           depois_poda, cascata, recargas == 2);
+    if (!cascata || !retomou || recargas != 2) {
+        erros++;
+    }
+
+    fecharAssinaturaAlteracoes(&assinatura);
+    liberarLoteAlteracoes(&lote);
+    saida = silenciarSaida(-1);
+    excluirAluno(ra);
+    silenciarSaida(saida);
+
+    if (erros == 0) {
+        printf("\n%sAssinatura de alteracoes ok.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha na assinatura de alteracoes (%d).%s\n", RED, erros, RESET);
+    }
+}
+
+#define DIRETORIO_TESTE_VERIFICACAO "data/teste_verificacao"
+#define DIRETORIO_TESTE_REPARO "data/teste_verificacao_reparo"
+#define RELATORIO_TESTE_VERIFICACAO "data/teste_verificacao.json"
+
+static const char *csvs_teste_verificacao[] = {
+    "alunos.csv", "turmas.csv", "aulas.csv", "aluno_turma.csv", "atividades.csv", "usuarios.csv", "notas.csv"
+};
+
+static void escreverCsvVerificacao(const char *diretorio, const char *arquivo, const char *conteudo) {
+    char caminho[256];
+    snprintf(caminho, sizeof(caminho), "%s/%s", diretorio, arquivo);
+    escreverArquivoTeste(caminho, conteudo);
+}
+
+static void removerDiretorioVerificacaoTeste(const char *diretorio) {
+    char caminho[256];
+    for (int i = 0; i < 7; i++) {
+        snprintf(caminho, sizeof(caminho), "%s/%s", diretorio, csvs_teste_verificacao[i]);
+        remove(caminho);
+        strncat(caminho, ".lock", sizeof(caminho) - strlen(caminho) - 1);
+        remove(caminho);
+    }
+    remove(diretorio);
+}
+
+static void testarVerificacaoIntegridade(void) {
+    imprimirTitulo("TESTE: VERIFICACAO DE INTEGRIDADE (FSCK)", BLUE);
+
+    char nome_longo[MAX_NOME + 21];
+    char linha_aluno[MAX_NOME + 256];
+    int erros = 0;
+
+    removerDiretorioVerificacaoTeste(DIRETORIO_TESTE_VERIFICACAO);
+    removerDiretorioVerificacaoTeste(DIRETORIO_TESTE_REPARO);
+#ifdef _WIN32
+    _mkdir(DIRETORIO_TESTE_VERIFICACAO);
+#else
+    mkdir(DIRETORIO_TESTE_VERIFICACAO, 0755);
+#endif
+
+    // Um caso de cada problema (e linhas boas em volta)
+    memset(nome_longo, 'N', sizeof(nome_longo) - 1);
+    nome_longo[sizeof(nome_longo) - 1] = '\0';
+    snprintf(linha_aluno, sizeof(linha_aluno),
+             "RA,Nome,Email,Ativo\n1,Ana,ana@x,1\n2,Bruno,b@x,1\n2,Bruno Dup,b2@x,1\n3,Carla,c@x,7\n"
+             "4,%s,d@x,1\nx,Erro,e@x,1\n", nome_longo);
+    escreverCsvVerificacao(DIRETORIO_TESTE_VERIFICACAO, "alunos.csv", linha_aluno);
+    escreverCsvVerificacao(DIRETORIO_TESTE_VERIFICACAO, "turmas.csv",
+                           "ID,Nome,Professor,Ano,Semestre\n10,ADS,Prof,2025,1\n11,SI,Prof,2025,2\n");
+    escreverCsvVerificacao(DIRETORIO_TESTE_VERIFICACAO, "aulas.csv",
+                           "ID,ID_Turma,Data,Conteudo\n1,10,01/09/2025,Intro, com virgula\n"
+                           "2,99,01/09/2025,Orfa\n3,10,32/13/2025,Data ruim\n");
+    escreverCsvVerificacao(DIRETORIO_TESTE_VERIFICACAO, "aluno_turma.csv",
+                           "RA,ID_Turma\n1,10\n2,10\n4,11\n5,10\n1,10\n");
+    escreverCsvVerificacao(DIRETORIO_TESTE_VERIFICACAO, "atividades.csv",
+                           "ID,ID_Turma,Titulo,Descricao,Arquivo\n1,10,Prova,Desc,\n2,98,Orfa,Desc,\n");
+    escreverCsvVerificacao(DIRETORIO_TESTE_VERIFICACAO, "usuarios.csv",
+                           "ID,Login,Senha,Tipo,Ativo\n1,admin,x,ADMIN,1\n2,admin,y,PROFESSOR,1\n"
+                           "3,prof,z,CHEFE,1\n");
+    escreverCsvVerificacao(DIRETORIO_TESTE_VERIFICACAO, "notas.csv",
+                           "RA,ID_Atividade,Nota\n1,1,8\n2,1,11\n4,1,7\n1,2,5\n");
+
+    // 1. Contagem por tipo, relatório JSON e reparo
+    OpcoesVerificacao opcoes = {RELATORIO_TESTE_VERIFICACAO, DIRETORIO_TESTE_REPARO, 0};
+    ResumoVerificacao resumo;
+    long problemas = verificarDiretorioDados(DIRETORIO_TESTE_VERIFICACAO, &opcoes, &resumo);
+    static const long esperados[TOTAL_TIPOS_PROBLEMA] = {1, 3, 5, 1, 1, 3};
+    printf("  %d tabelas, %ld linhas, %ld problemas:", resumo.tabelas, resumo.linhas, problemas);
+    for (int t = 0; t < TOTAL_TIPOS_PROBLEMA; t++) {
+        printf(" %s=%ld", nomeProblemaVerificacao(t), resumo.por_tipo[t]);
+        if (resumo.por_tipo[t] != esperados[t]) {
+            erros++;
+        }
+    }
+    printf("\n");
+    if (problemas != 14 || resumo.tabelas != 7 || resumo.linhas != 25) {
+        erros++;
+    }
+
+    long tamanho = 0;
+    char *relatorio = lerArquivoTeste(RELATORIO_TESTE_VERIFICACAO, &tamanho);
+    int relatorio_ok = relatorio != NULL;
+    if (relatorio != NULL) {
+        relatorio[tamanho] = '\0';
+        relatorio_ok = strstr(relatorio, "\"chave_estrangeira\": 5") != NULL &&
+                       strstr(relatorio, "\"arquivo\": \"notas.csv\", \"linha\": 5") != NULL &&
+                       strstr(relatorio, "\"primeira_linha\": 3") != NULL;
+    }
+    free(relatorio);
+    remove(RELATORIO_TESTE_VERIFICACAO);
+    printf("  Reparo: %ld linhas descartadas, %ld campo cortado; relatorio JSON ok: %d\n",
+           resumo.linhas_descartadas, resumo.campos_cortados, relatorio_ok);
+    if (resumo.linhas_descartadas != 13 || resumo.campos_cortados != 1 || !relatorio_ok) {
+        erros++;
+    }
+
+    // 2. O diretório reparado passa sem problemas (sequencial = mesmo resultado)
+    OpcoesVerificacao so_contar = {NULL, NULL, 1};
+    ResumoVerificacao reparado;
+    long restantes = verificarDiretorioDados(DIRETORIO_TESTE_REPARO, &so_contar, &reparado);
+    printf("  Diretorio reparado: %ld linhas, %ld problemas\n", reparado.linhas, restantes);
+    if (restantes != 0 || reparado.linhas != 12) {
+        erros++;
+    }
+
+    // Nome longo demais cortado no tamanho da struct (a linha fica)
+    char *alunos = lerArquivoTeste(DIRETORIO_TESTE_REPARO "/alunos.csv", &tamanho);
+    char *aluno_cortado = NULL;
+    if (alunos != NULL) {
+        alunos[tamanho] = '\0';
+        aluno_cortado = strstr(alunos, "\n4,");
+    }
+    if (aluno_cortado == NULL || strcspn(aluno_cortado + 3, ",") != MAX_NOME - 1) {
+        printf("  %sNome do aluno 4 nao foi cortado em %d caracteres.%s\n", RED, MAX_NOME - 1, RESET);
+        erros++;
+    }
+    free(alunos);
+
+    // 3. Reparo nunca sobrescreve CSVs existentes
+    int saida = silenciarSaida(-1);
+    long recusado = verificarDiretorioDados(DIRETORIO_TESTE_VERIFICACAO, &opcoes, NULL);
+    silenciarSaida(saida);
+    if (recusado != -1) {
+        printf("  %sReparo sobrescreveu um diretorio existente.%s\n", RED, RESET);
+        erros++;
+    }
+    remove(RELATORIO_TESTE_VERIFICACAO);
+
+    removerDiretorioVerificacaoTeste(DIRETORIO_TESTE_VERIFICACAO);
+    removerDiretorioVerificacaoTeste(DIRETORIO_TESTE_REPARO);
+
+    if (erros == 0) {
+        printf("\n%sVerificacao de integridade ok.%s\n", GREEN, RESET);
+    } else {
+        printf("\n%sFalha na verificacao de integridade (%d).%s\n", RED, erros, RESET);
+    }
+}
+
+static void executarTodosTestes(void) {
+    imprimirTitulo("EXECUTANDO TODOS OS TESTES", MAGENTA);
+
+    testarModuloAlunos();
+    aguardarEnter();
+
+    testarModuloTurmas();
+    aguardarEnter();
+
+    testarAssociacaoAlunoTurma();
+    aguardarEnter();
+
+    testarModuloAulas();
+    aguardarEnter();
+
+    testarModuloAtividades();
+    aguardarEnter();
+
+    testarModuloUsuarios();
+    aguardarEnter();
+
+    testarRelatorios();
+    aguardarEnter();
+
+    testarConcorrencia();
+    aguardarEnter();
+
+    testarContencaoProcessos();
+    aguardarEnter();
+
+    testarExportacaoCompartilhada();
+    aguardarEnter();
+
+    testarPersistenciaAssincrona();
+    aguardarEnter();
+
+    testarGravacaoAdiada();
+    aguardarEnter();
+
+    testarAuditoria();
+    aguardarEnter();
+
+    testarLogBinario();
+    aguardarEnter();
+
+    testarSessoes();
+    aguardarEnter();
+
+    testarLimitadorLogin();
+    aguardarEnter();
+
+    testarRelatoriosEmLote();
+    aguardarEnter();
+
+    testarAtualizacaoRelatorios();
+    aguardarEnter();
+
+    testarVisoesAgregadas();
+    aguardarEnter();
+
+    testarFrequencia();
+    aguardarEnter();
+
+    testarNotas();
+    aguardarEnter();
+
+    testarAlunosDaTurmaDetalhado();
+    aguardarEnter();
+
+    testarExclusaoEmCascata();
+    aguardarEnter();
+
+    testarVerificacaoIntegridade();
+    aguardarEnter();
+
+    testarTransacoesEntreTabelas();
+    aguardarEnter();
+
+    testarBackupConsistente();
+    aguardarEnter();
+
+    testarBackupIncremental();
+    aguardarEnter();
+
+    testarReplicacao();
+    aguardarEnter();
+
+    testarAssinatura();
+
+    imprimirTitulo("TODOS OS TESTES FORAM EXECUTADOS", GREEN);
+}
+
+int main(void) {
+    int opcao;
+
+    do {
+        exibirMenu();
+        if (scanf("%d", &opcao) != 1) {
+            printf("%s\nOpcao invalida! Digite um numero.%s\n", RED, RESET);
+            limparBuffer();
+            continue;
+        }
+        limparBuffer();
+
+        switch (opcao) {
+            case 1:
+                testarModuloAlunos();
+                aguardarEnter();
+                break;
+            case 2:
+                testarModuloTurmas();
+                aguardarEnter();
+                break;
+            case 3:
+                testarAssociacaoAlunoTurma();
+                aguardarEnter();
+                break;
+            case 4:
+                testarModuloAulas();
+                aguardarEnter();
+                break;
+            case 5:
+                testarModuloAtividades();
+                aguardarEnter();
+                break;
+            case 6:
+                testarModuloUsuarios();
+                aguardarEnter();
+                break;
+            case 7:
+                testarRelatorios();
+                aguardarEnter();
+                break;
+            case 8:
+                executarTodosTestes();
+                aguardarEnter();
+                break;
+            case 9:
+                testarConcorrencia();
+                aguardarEnter();
+                break;
+            case 10:
+                testarContencaoProcessos();
+                aguardarEnter();
+                break;
+            case 11:
+                testarExportacaoCompartilhada();
+                aguardarEnter();
+                break;
+            case 12:
+                testarPersistenciaAssincrona();
+                aguardarEnter();
+                break;
+            case 13:
+                testarGravacaoAdiada();
+                aguardarEnter();
+                break;
+            case 14:
+                testarAuditoria();
+                aguardarEnter();
+                break;
+            case 15:
+                testarLogBinario();
+                aguardarEnter();
+                break;
+            case 16:
+                testarSessoes();
+                aguardarEnter();
+                break;
+            case 17:
+                testarLimitadorLogin();
+                aguardarEnter();
+                break;
+            case 18:
+                testarRelatoriosEmLote();
+                aguardarEnter();
+                break;
+            case 19:
+                testarAtualizacaoRelatorios();
+                aguardarEnter();
+                break;
+            case 20:
+                testarVisoesAgregadas();
+                aguardarEnter();
+                break;
+            case 21:
+                testarFrequencia();
+                aguardarEnter();
+                break;
+            case 22:
+                testarNotas();
+                aguardarEnter();
+                break;
+            case 23:
+                testarAlunosDaTurmaDetalhado();
+                aguardarEnter();
+                break;
+            case 24:
+                testarExclusaoEmCascata();
+                aguardarEnter();
+                break;
+            case 25:
+                testarVerificacaoIntegridade();
+                aguardarEnter();
+                break;
+            case 26:
+                testarTransacoesEntreTabelas();
+                aguardarEnter();
+                break;
+            case 27:
+                testarBackupConsistente();
+                aguardarEnter();
+                break;
+            case 28:
+                testarBackupIncremental();
+                aguardarEnter();
+                break;
+            case 29:
+                testarReplicacao();
+                aguardarEnter();
+                break;
+            case 30:
+                testarAssinatura();
                 aguardarEnter();
                 break;
             case 0:
                 printf("\n%sEncerrando sistema de testes...%s\n", CYAN, RESET);
                 break;
             default:
-                printf("%s\nOpcao invalida! Escolha entre 0 e 8.%s\n", RED, RESET);
+                printf("%s\nOpcao invalida! Escolha entre 0 e 30.%s\n", RED, RESET);
         }
     } while (opcao != 0);
 
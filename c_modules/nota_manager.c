@@ -0,0 +1,875 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "nota_manager.h"
+#include "atividade_manager.h"
+#include "turma_manager.h"
+#include "tabela_manager.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define NOTAS_SSE2 1
+#endif
+
+#define LINHAS_INICIAIS 64
+
+// ========== ESTRUTURAS INTERNAS ==========
+
+// Tabela int -> índice com endereçamento aberto (valor -1 = posição livre)
+typedef struct {
+    int *chaves;
+    int *valores;
+    int capacidade;            // Potência de 2
+    int usados;
+} MapaInteiros;
+
+typedef struct {
+    int id_atividade;
+    int notas;                 // Posições com nota
+    float *valores;            // capacidade_linhas posições (NaN = sem nota)
+} ColunaNotas;
+
+struct Boletim {
+    int *ras;                  // RA de cada linha
+    int linhas;
+    int capacidade_linhas;
+    MapaInteiros indice_linhas;    // RA -> linha
+    ColunaNotas *colunas;
+    int total_colunas;
+    int capacidade_colunas;
+    MapaInteiros indice_colunas;   // id_atividade -> coluna
+};
+
+// Somas parciais das estatísticas (várias colunas somam no mesmo acumulador)
+typedef struct {
+    long long quantidade;
+    double soma;
+    double soma_quadrados;
+    float minima;
+    float maxima;
+    long long histograma[FAIXAS_HISTOGRAMA];
+} AcumuladorNotas;
+
+// ========== FUNÇÕES AUXILIARES PRIVADAS ==========
+
+static uint32_t espalhar(uint32_t x) {
+    x *= 0x9E3779B1u;
+    return x ^ (x >> 15);
+}
+
+// ---------- Mapa de inteiros ----------
+
+static int mapaBuscar(const MapaInteiros *mapa, int chave) {
+    if (mapa->capacidade == 0) {
+        return -1;
+    }
+    uint32_t i = espalhar((uint32_t)chave) & (uint32_t)(mapa->capacidade - 1);
+    while (mapa->valores[i] >= 0) {
+        if (mapa->chaves[i] == chave) {
+            return mapa->valores[i];
+        }
+        i = (i + 1) & (uint32_t)(mapa->capacidade - 1);
+    }
+    return -1;
+}
+
+static void mapaLiberar(MapaInteiros *mapa) {
+    free(mapa->chaves);
+    free(mapa->valores);
+    memset(mapa, 0, sizeof(*mapa));
+}
+
+static int mapaInserir(MapaInteiros *mapa, int chave, int valor);
+
+// Dobra a capacidade e reinsere (ocupação máxima de 1/2)
+static int mapaCrescer(MapaInteiros *mapa) {
+    MapaInteiros novo;
+    novo.capacidade = mapa->capacidade ? mapa->capacidade * 2 : 16;
+    novo.usados = 0;
+    novo.chaves = malloc(sizeof(int) * (size_t)novo.capacidade);
+    novo.valores = malloc(sizeof(int) * (size_t)novo.capacidade);
+    if (novo.chaves == NULL || novo.valores == NULL) {
+        free(novo.chaves);
+        free(novo.valores);
+        return 0;
+    }
+    memset(novo.valores, 0xFF, sizeof(int) * (size_t)novo.capacidade);
+
+    for (int i = 0; i < mapa->capacidade; i++) {
+        if (mapa->valores[i] >= 0) {
+            mapaInserir(&novo, mapa->chaves[i], mapa->valores[i]);
+        }
+    }
+    mapaLiberar(mapa);
+    *mapa = novo;
+    return 1;
+}
+
+static int mapaInserir(MapaInteiros *mapa, int chave, int valor) {
+    if ((mapa->usados + 1) * 2 > mapa->capacidade && !mapaCrescer(mapa)) {
+        return 0;
+    }
+    uint32_t i = espalhar((uint32_t)chave) & (uint32_t)(mapa->capacidade - 1);
+    while (mapa->valores[i] >= 0 && mapa->chaves[i] != chave) {
+        i = (i + 1) & (uint32_t)(mapa->capacidade - 1);
+    }
+    if (mapa->valores[i] < 0) {
+        mapa->usados++;
+    }
+    mapa->chaves[i] = chave;
+    mapa->valores[i] = valor;
+    return 1;
+}
+
+// ---------- Linhas e colunas ----------
+
+static int notaValida(float nota) {
+    return nota >= 0.0f && nota <= NOTA_MAXIMA;    // Falso também para NaN
+}
+
+static void preencherSemNota(float *valores, int total) {
+    for (int i = 0; i < total; i++) {
+        valores[i] = NAN;
+    }
+}
+
+// Garante espaço para "necessarias" linhas em todas as colunas
+static int reservarLinhas(Boletim *boletim, int necessarias) {
+    if (necessarias <= boletim->capacidade_linhas) {
+        return 1;
+    }
+    int nova = boletim->capacidade_linhas ? boletim->capacidade_linhas : LINHAS_INICIAIS;
+    while (nova < necessarias) {
+        nova *= 2;
+    }
+
+    int *ras = realloc(boletim->ras, sizeof(int) * (size_t)nova);
+    if (ras == NULL) {
+        return 0;
+    }
+    boletim->ras = ras;
+    for (int c = 0; c < boletim->total_colunas; c++) {
+        // Colunas já aumentadas continuam válidas se uma das seguintes falhar
+        float *valores = realloc(boletim->colunas[c].valores, sizeof(float) * (size_t)nova);
+        if (valores == NULL) {
+            return 0;
+        }
+        preencherSemNota(valores + boletim->capacidade_linhas, nova - boletim->capacidade_linhas);
+        boletim->colunas[c].valores = valores;
+    }
+    boletim->capacidade_linhas = nova;
+    return 1;
+}
+
+// Retorna: linha do RA (criada se "criar"), -1 se não existe ou faltou memória
+static int linhaDoAluno(Boletim *boletim, int ra, int criar) {
+    int linha = mapaBuscar(&boletim->indice_linhas, ra);
+    if (linha >= 0 || !criar) {
+        return linha;
+    }
+    if (!reservarLinhas(boletim, boletim->linhas + 1) ||
+        !mapaInserir(&boletim->indice_linhas, ra, boletim->linhas)) {
+        return -1;
+    }
+    boletim->ras[boletim->linhas] = ra;
+    return boletim->linhas++;
+}
+
+// Retorna: coluna da atividade (criada se "criar"), -1 se não existe ou faltou memória
+static int colunaDaAtividade(Boletim *boletim, int id_atividade, int criar) {
+    int coluna = mapaBuscar(&boletim->indice_colunas, id_atividade);
+    if (coluna >= 0 || !criar) {
+        return coluna;
+    }
+    if (!reservarLinhas(boletim, 1)) {
+        return -1;
+    }
+    if (boletim->total_colunas == boletim->capacidade_colunas) {
+        int nova = boletim->capacidade_colunas ? boletim->capacidade_colunas * 2 : 8;
+        ColunaNotas *colunas = realloc(boletim->colunas, sizeof(ColunaNotas) * (size_t)nova);
+        if (colunas == NULL) {
+            return -1;
+        }
+        boletim->colunas = colunas;
+        boletim->capacidade_colunas = nova;
+    }
+
+    float *valores = malloc(sizeof(float) * (size_t)boletim->capacidade_linhas);
+    if (valores == NULL || !mapaInserir(&boletim->indice_colunas, id_atividade, boletim->total_colunas)) {
+        free(valores);
+        return -1;
+    }
+    preencherSemNota(valores, boletim->capacidade_linhas);
+    ColunaNotas *nova_coluna = &boletim->colunas[boletim->total_colunas];
+    nova_coluna->id_atividade = id_atividade;
+    nova_coluna->notas = 0;
+    nova_coluna->valores = valores;
+    return boletim->total_colunas++;
+}
+
+static void gravarNotaColuna(ColunaNotas *coluna, int linha, float nota) {
+    if (coluna->valores[linha] != coluna->valores[linha]) {
+        coluna->notas++;
+    }
+    coluna->valores[linha] = nota;
+}
+
+// Coluna da k-ésima atividade pedida (todas as colunas se atividades == NULL)
+// Retorna: NULL se a atividade não tem coluna ou nenhuma nota
+static const ColunaNotas* colunaPedida(const Boletim *boletim, const int *atividades, int k) {
+    int coluna = atividades ? mapaBuscar(&boletim->indice_colunas, atividades[k]) : k;
+    if (coluna < 0 || boletim->colunas[coluna].notas == 0) {
+        return NULL;
+    }
+    return &boletim->colunas[coluna];
+}
+
+// ---------- Estatísticas ----------
+
+static void iniciarAcumulador(AcumuladorNotas *acumulador) {
+    memset(acumulador, 0, sizeof(*acumulador));
+    acumulador->minima = INFINITY;
+    acumulador->maxima = -INFINITY;
+}
+
+// Faixa de 1 ponto do histograma; a nota máxima entra na última
+static int faixaDaNota(float nota) {
+    int faixa = (int)(nota * (FAIXAS_HISTOGRAMA / NOTA_MAXIMA));
+    return faixa < FAIXAS_HISTOGRAMA ? faixa : FAIXAS_HISTOGRAMA - 1;
+}
+
+static void acumularNota(AcumuladorNotas *acumulador, float nota) {
+    acumulador->quantidade++;
+    acumulador->soma += nota;
+    acumulador->soma_quadrados += (double)nota * nota;
+    if (nota < acumulador->minima) {
+        acumulador->minima = nota;
+    }
+    if (nota > acumulador->maxima) {
+        acumulador->maxima = nota;
+    }
+    acumulador->histograma[faixaDaNota(nota)]++;
+}
+
+// Acumula uma coluna inteira, 4 valores por vez com SSE2: as posições NaN
+// viram 0 na soma e +/-infinito no mínimo/máximo, pela máscara de cmpord
+static void acumularColuna(AcumuladorNotas *acumulador, const float *valores, int total) {
+    int i = 0;
+#ifdef NOTAS_SSE2
+    const __m128 mais_infinito = _mm_set1_ps(INFINITY);
+    const __m128 menos_infinito = _mm_set1_ps(-INFINITY);
+    const __m128 ultima_faixa = _mm_set1_ps((float)(FAIXAS_HISTOGRAMA - 1));
+    const __m128 escala = _mm_set1_ps(FAIXAS_HISTOGRAMA / NOTA_MAXIMA);
+    __m128d soma = _mm_setzero_pd();
+    __m128d quadrados = _mm_setzero_pd();
+    __m128 minima = mais_infinito;
+    __m128 maxima = menos_infinito;
+    int faixas[4];
+
+    for (; i + 4 <= total; i += 4) {
+        __m128 v = _mm_loadu_ps(valores + i);
+        __m128 validos = _mm_cmpord_ps(v, v);
+        int mascara = _mm_movemask_ps(validos);
+        if (mascara == 0) {
+            continue;                  // Bloco sem notas (comum em colunas de turmas pequenas)
+        }
+        v = _mm_and_ps(v, validos);
+        __m128d baixo = _mm_cvtps_pd(v);
+        __m128d alto = _mm_cvtps_pd(_mm_movehl_ps(v, v));
+        soma = _mm_add_pd(soma, _mm_add_pd(baixo, alto));
+        quadrados = _mm_add_pd(quadrados, _mm_add_pd(_mm_mul_pd(baixo, baixo), _mm_mul_pd(alto, alto)));
+        minima = _mm_min_ps(minima, _mm_or_ps(v, _mm_andnot_ps(validos, mais_infinito)));
+        maxima = _mm_max_ps(maxima, _mm_or_ps(v, _mm_andnot_ps(validos, menos_infinito)));
+
+        _mm_storeu_si128((__m128i *)faixas, _mm_cvttps_epi32(_mm_min_ps(_mm_mul_ps(v, escala), ultima_faixa)));
+        if (mascara == 0xF) {
+            acumulador->histograma[faixas[0]]++;
+            acumulador->histograma[faixas[1]]++;
+            acumulador->histograma[faixas[2]]++;
+            acumulador->histograma[faixas[3]]++;
+            acumulador->quantidade += 4;
+        } else {
+            for (int k = 0; k < 4; k++) {
+                if (mascara & (1 << k)) {
+                    acumulador->histograma[faixas[k]]++;
+                    acumulador->quantidade++;
+                }
+            }
+        }
+    }
+
+    double somas[2];
+    float extremos[4];
+    _mm_storeu_pd(somas, soma);
+    acumulador->soma += somas[0] + somas[1];
+    _mm_storeu_pd(somas, quadrados);
+    acumulador->soma_quadrados += somas[0] + somas[1];
+    _mm_storeu_ps(extremos, minima);
+    for (int k = 0; k < 4; k++) {
+        if (extremos[k] < acumulador->minima) {
+            acumulador->minima = extremos[k];
+        }
+    }
+    _mm_storeu_ps(extremos, maxima);
+    for (int k = 0; k < 4; k++) {
+        if (extremos[k] > acumulador->maxima) {
+            acumulador->maxima = extremos[k];
+        }
+    }
+#endif
+    for (; i < total; i++) {
+        if (valores[i] == valores[i]) {
+            acumularNota(acumulador, valores[i]);
+        }
+    }
+}
+
+static void concluirEstatisticas(const AcumuladorNotas *acumulador, EstatisticasNotas *destino) {
+    memset(destino, 0, sizeof(*destino));
+    if (acumulador->quantidade == 0) {
+        return;
+    }
+    double media = acumulador->soma / (double)acumulador->quantidade;
+    double variancia = acumulador->soma_quadrados / (double)acumulador->quantidade - media * media;
+
+    destino->quantidade = (int)acumulador->quantidade;
+    destino->media = media;
+    destino->desvio = variancia > 0.0 ? sqrt(variancia) : 0.0;
+    destino->minima = acumulador->minima;
+    destino->maxima = acumulador->maxima;
+    for (int f = 0; f < FAIXAS_HISTOGRAMA; f++) {
+        destino->histograma[f] = (int)acumulador->histograma[f];
+    }
+}
+
+// Soma uma coluna nas somas/contagens por linha (4 linhas por vez com SSE2)
+static void somarColunaPorLinha(double *somas, float *contagens, const float *valores, int total) {
+    int i = 0;
+#ifdef NOTAS_SSE2
+    const __m128 um = _mm_set1_ps(1.0f);
+    for (; i + 4 <= total; i += 4) {
+        __m128 v = _mm_loadu_ps(valores + i);
+        __m128 validos = _mm_cmpord_ps(v, v);
+        if (_mm_movemask_ps(validos) == 0) {
+            continue;
+        }
+        v = _mm_and_ps(v, validos);
+        _mm_storeu_pd(somas + i, _mm_add_pd(_mm_loadu_pd(somas + i), _mm_cvtps_pd(v)));
+        _mm_storeu_pd(somas + i + 2, _mm_add_pd(_mm_loadu_pd(somas + i + 2), _mm_cvtps_pd(_mm_movehl_ps(v, v))));
+        _mm_storeu_ps(contagens + i, _mm_add_ps(_mm_loadu_ps(contagens + i), _mm_and_ps(validos, um)));
+    }
+#endif
+    for (; i < total; i++) {
+        if (valores[i] == valores[i]) {
+            somas[i] += valores[i];
+            contagens[i] += 1.0f;
+        }
+    }
+}
+
+// ========== BOLETIM EM MEMÓRIA ==========
+
+Boletim* criarBoletim(void) {
+    return calloc(1, sizeof(Boletim));
+}
+
+void liberarBoletim(Boletim *boletim) {
+    if (boletim == NULL) {
+        return;
+    }
+    for (int c = 0; c < boletim->total_colunas; c++) {
+        free(boletim->colunas[c].valores);
+    }
+    free(boletim->colunas);
+    free(boletim->ras);
+    mapaLiberar(&boletim->indice_linhas);
+    mapaLiberar(&boletim->indice_colunas);
+    free(boletim);
+}
+
+int lancarNotaBoletim(Boletim *boletim, int ra, int id_atividade, float nota) {
+    if (!notaValida(nota)) {
+        return 0;
+    }
+    int linha = linhaDoAluno(boletim, ra, 1);
+    int coluna = linha >= 0 ? colunaDaAtividade(boletim, id_atividade, 1) : -1;
+    if (coluna < 0) {
+        return 0;
+    }
+    gravarNotaColuna(&boletim->colunas[coluna], linha, nota);
+    return 1;
+}
+
+int importarNotasBoletim(Boletim *boletim, const Nota *notas, int total) {
+    int *linhas = malloc(sizeof(int) * (size_t)(total > 0 ? total : 1));
+    if (linhas == NULL) {
+        return -1;
+    }
+
+    // 1. Linhas primeiro: as colunas novas já nascem com a capacidade final
+    int ultimo_ra = 0;
+    int ultima_linha = -1;
+    for (int i = 0; i < total; i++) {
+        if (!notaValida(notas[i].nota)) {
+            linhas[i] = -1;
+            continue;
+        }
+        if (ultima_linha < 0 || notas[i].ra != ultimo_ra) {
+            ultimo_ra = notas[i].ra;
+            ultima_linha = linhaDoAluno(boletim, ultimo_ra, 1);
+            if (ultima_linha < 0) {
+                free(linhas);
+                return -1;
+            }
+        }
+        linhas[i] = ultima_linha;
+    }
+
+    // 2. Valores, reaproveitando a coluna enquanto a atividade se repete
+    int importadas = 0;
+    int ultima_atividade = 0;
+    int ultima_coluna = -1;
+    for (int i = 0; i < total; i++) {
+        if (linhas[i] < 0) {
+            continue;
+        }
+        if (ultima_coluna < 0 || notas[i].id_atividade != ultima_atividade) {
+            ultima_atividade = notas[i].id_atividade;
+            ultima_coluna = colunaDaAtividade(boletim, ultima_atividade, 1);
+            if (ultima_coluna < 0) {
+                free(linhas);
+                return -1;
+            }
+        }
+        gravarNotaColuna(&boletim->colunas[ultima_coluna], linhas[i], notas[i].nota);
+        importadas++;
+    }
+
+    free(linhas);
+    return importadas;
+}
+
+int obterNotaBoletim(const Boletim *boletim, int ra, int id_atividade, float *destino) {
+    if (boletim == NULL) {
+        return 0;
+    }
+    int linha = mapaBuscar(&boletim->indice_linhas, ra);
+    int coluna = mapaBuscar(&boletim->indice_colunas, id_atividade);
+    if (linha < 0 || coluna < 0) {
+        return 0;
+    }
+    float nota = boletim->colunas[coluna].valores[linha];
+    if (nota != nota) {
+        return 0;
+    }
+    if (destino != NULL) {
+        *destino = nota;
+    }
+    return 1;
+}
+
+int removerNotaBoletim(Boletim *boletim, int ra, int id_atividade) {
+    if (!obterNotaBoletim(boletim, ra, id_atividade, NULL)) {
+        return 0;
+    }
+    ColunaNotas *coluna = &boletim->colunas[mapaBuscar(&boletim->indice_colunas, id_atividade)];
+    coluna->valores[mapaBuscar(&boletim->indice_linhas, ra)] = NAN;
+    coluna->notas--;
+    return 1;
+}
+
+int removerAtividadeBoletim(Boletim *boletim, int id_atividade) {
+    int coluna = mapaBuscar(&boletim->indice_colunas, id_atividade);
+    if (coluna < 0) {
+        return 0;
+    }
+    int removidas = boletim->colunas[coluna].notas;
+    preencherSemNota(boletim->colunas[coluna].valores, boletim->linhas);
+    boletim->colunas[coluna].notas = 0;
+    return removidas;
+}
+
+void estatisticasAtividadesBoletim(const Boletim *boletim, const int *atividades, int total,
+                                   EstatisticasNotas *destino) {
+    AcumuladorNotas acumulador;
+    iniciarAcumulador(&acumulador);
+
+    if (boletim != NULL) {
+        int colunas = atividades ? total : boletim->total_colunas;
+        for (int k = 0; k < colunas; k++) {
+            const ColunaNotas *coluna = colunaPedida(boletim, atividades, k);
+            if (coluna != NULL) {
+                acumularColuna(&acumulador, coluna->valores, boletim->linhas);
+            }
+        }
+    }
+    concluirEstatisticas(&acumulador, destino);
+}
+
+void estatisticasAlunoBoletim(const Boletim *boletim, int ra, const int *atividades, int total,
+                              EstatisticasNotas *destino) {
+    AcumuladorNotas acumulador;
+    iniciarAcumulador(&acumulador);
+
+    int linha = boletim != NULL ? mapaBuscar(&boletim->indice_linhas, ra) : -1;
+    if (linha >= 0) {
+        int colunas = atividades ? total : boletim->total_colunas;
+        for (int k = 0; k < colunas; k++) {
+            const ColunaNotas *coluna = colunaPedida(boletim, atividades, k);
+            if (coluna != NULL && coluna->valores[linha] == coluna->valores[linha]) {
+                acumularNota(&acumulador, coluna->valores[linha]);
+            }
+        }
+    }
+    concluirEstatisticas(&acumulador, destino);
+}
+
+int mediaPonderadaBoletim(const Boletim *boletim, int ra, const int *atividades, const float *pesos,
+                          int total, double *media) {
+    int linha = boletim != NULL ? mapaBuscar(&boletim->indice_linhas, ra) : -1;
+    double soma = 0.0;
+    double soma_pesos = 0.0;
+
+    for (int k = 0; linha >= 0 && k < total; k++) {
+        int coluna = mapaBuscar(&boletim->indice_colunas, atividades[k]);
+        if (coluna < 0 || pesos[k] <= 0.0f) {
+            continue;
+        }
+        float nota = boletim->colunas[coluna].valores[linha];
+        if (nota == nota) {
+            soma += (double)nota * pesos[k];
+            soma_pesos += pesos[k];
+        }
+    }
+
+    if (soma_pesos <= 0.0) {
+        return 0;
+    }
+    *media = soma / soma_pesos;
+    return 1;
+}
+
+int mediasPorAlunoBoletim(const Boletim *boletim, const int *atividades, int total, int *ras,
+                          double *medias, int max) {
+    if (boletim == NULL || boletim->linhas == 0) {
+        return 0;
+    }
+    double *somas = calloc((size_t)boletim->linhas, sizeof(double));
+    float *contagens = calloc((size_t)boletim->linhas, sizeof(float));
+    if (somas == NULL || contagens == NULL) {
+        free(somas);
+        free(contagens);
+        return -1;
+    }
+
+    int colunas = atividades ? total : boletim->total_colunas;
+    for (int k = 0; k < colunas; k++) {
+        const ColunaNotas *coluna = colunaPedida(boletim, atividades, k);
+        if (coluna != NULL) {
+            somarColunaPorLinha(somas, contagens, coluna->valores, boletim->linhas);
+        }
+    }
+
+    int copiados = 0;
+    for (int i = 0; i < boletim->linhas && copiados < max; i++) {
+        if (contagens[i] > 0.0f) {
+            ras[copiados] = boletim->ras[i];
+            medias[copiados] = somas[i] / contagens[i];
+            copiados++;
+        }
+    }
+
+    free(somas);
+    free(contagens);
+    return copiados;
+}
+
+// ========== NOTAS DO SISTEMA (ARQUIVO_NOTAS) ==========
+
+static Boletim *boletim_sistema = NULL;
+
+// Lê um CSV "RA,ID_Atividade,Nota" (com cabeçalho)
+// Retorna: vetor alocado (total em *total), ou NULL com *total = -1 se o arquivo não abriu
+static Nota* lerNotasArquivo(const char *caminho, int *total) {
+    FILE *arquivo = fopen(caminho, "r");
+    *total = -1;
+    if (arquivo == NULL) {
+        return NULL;
+    }
+
+    int capacidade = 1024;
+    Nota *notas = malloc(sizeof(Nota) * (size_t)capacidade);
+    char linha[256];
+    int lidas = 0;
+
+    if (fgets(linha, sizeof(linha), arquivo) == NULL) { // Pular cabeçalho
+        linha[0] = '\0';
+    }
+    while (notas != NULL && fgets(linha, sizeof(linha), arquivo) != NULL) {
+        Nota nota;
+        if (sscanf(linha, "%d,%d,%f", &nota.ra, &nota.id_atividade, &nota.nota) != 3) {
+            continue;
+        }
+        if (lidas == capacidade) {
+            Nota *maior = realloc(notas, sizeof(Nota) * (size_t)capacidade * 2);
+            if (maior == NULL) {
+                free(notas);
+                notas = NULL;
+                break;
+            }
+            notas = maior;
+            capacidade *= 2;
+        }
+        notas[lidas++] = nota;
+    }
+
+    fclose(arquivo);
+    if (notas != NULL) {
+        *total = lidas;
+    }
+    return notas;
+}
+
+// Carrega notas do arquivo para memória
+static void carregarNotasMemoria(void) {
+    Boletim *novo = criarBoletim();
+    int total = 0;
+    Nota *notas = lerNotasArquivo(ARQUIVO_NOTAS, &total);
+
+    if (novo != NULL && notas != NULL && importarNotasBoletim(novo, notas, total) < 0) {
+        printf("Erro: memória insuficiente para carregar as notas.\n");
+    }
+    free(notas);
+    liberarBoletim(boletim_sistema);
+    boletim_sistema = novo;
+}
+
+static int gravarNotasArquivo(void);
+
+static TabelaResidente tabela_notas = TABELA_RESIDENTE_INIT(ARQUIVO_NOTAS, carregarNotasMemoria,
+                                                            gravarNotasArquivo);
+
+// Grava as notas da memória para o arquivo, coluna por coluna (exige trava de escrita)
+static int gravarNotasArquivo(void) {
+    FILE *arquivo = abrirEscritaAtomica(ARQUIVO_NOTAS);
+    if (arquivo == NULL) {
+        printf("Erro ao abrir arquivo de notas.\n");
+        return 0;
+    }
+
+    fprintf(arquivo, "RA,ID_Atividade,Nota\n");
+    for (int c = 0; boletim_sistema != NULL && c < boletim_sistema->total_colunas; c++) {
+        const ColunaNotas *coluna = &boletim_sistema->colunas[c];
+        for (int i = 0; coluna->notas > 0 && i < boletim_sistema->linhas; i++) {
+            if (coluna->valores[i] == coluna->valores[i]) {
+                fprintf(arquivo, "%d,%d,%g\n", boletim_sistema->ras[i], coluna->id_atividade,
+                        (double)coluna->valores[i]);
+            }
+        }
+    }
+
+    if (!concluirEscritaAtomica(arquivo, ARQUIVO_NOTAS)) {
+        printf("Erro ao gravar arquivo de notas.\n");
+        return 0;
+    }
+    marcarTabelaSalva(&tabela_notas);
+    return 1;
+}
+
+// IDs das atividades de uma turma
+// Retorna: vetor alocado (NULL se a turma não tem atividades), total em *total
+static int* atividadesDaTurma(int id_turma, int *total) {
+    int previstas = contarAtividadesDaTurma(id_turma);
+    *total = 0;
+    if (previstas <= 0) {
+        return NULL;
+    }
+
+    Atividade *atividades = malloc(sizeof(Atividade) * (size_t)previstas);
+    int *ids = malloc(sizeof(int) * (size_t)previstas);
+    if (atividades == NULL || ids == NULL) {
+        free(atividades);
+        free(ids);
+        return NULL;
+    }
+    *total = listarAtividadesDaTurma(id_turma, atividades, previstas);
+    for (int i = 0; i < *total; i++) {
+        ids[i] = atividades[i].id;
+    }
+    free(atividades);
+    return ids;
+}
+
+static int compararMatriculas(const void *a, const void *b) {
+    const AlunoTurma *x = a;
+    const AlunoTurma *y = b;
+    if (x->ra != y->ra) {
+        return x->ra < y->ra ? -1 : 1;
+    }
+    return (x->id_turma > y->id_turma) - (x->id_turma < y->id_turma);
+}
+
+// Lançar nota de um aluno matriculado na turma da atividade
+int lancarNota(int ra, int id_atividade, float nota) {
+    Atividade atividade;
+
+    // Estrutura de decisão (requisito obrigatório)
+    if (!notaValida(nota)) {
+        printf("Erro: a nota deve estar entre 0 e %.0f.\n", (double)NOTA_MAXIMA);
+        return 0;
+    }
+    if (!obterAtividadePorID(id_atividade, &atividade)) {
+        printf("Erro: atividade não encontrada.\n");
+        return 0;
+    }
+    if (!verificarMatricula(ra, atividade.id_turma)) {
+        printf("Erro: aluno não matriculado na turma da atividade.\n");
+        return 0;
+    }
+
+    abrirEscritaTabela(&tabela_notas);
+    int sucesso = boletim_sistema != NULL && lancarNotaBoletim(boletim_sistema, ra, id_atividade, nota);
+    if (sucesso) {
+        sucesso = registrarAlteracaoTabela(&tabela_notas);
+    }
+    fecharTabela(&tabela_notas);
+    return sucesso;
+}
+
+// Importar notas em lote: valida tudo contra uma cópia das atividades e das
+// matrículas (ordenadas) e grava o CSV uma vez só
+int importarNotas(const char *arquivo_csv) {
+    int total = 0;
+    Nota *notas = lerNotasArquivo(arquivo_csv, &total);
+    if (notas == NULL) {
+        return -1;
+    }
+
+    Atividade *atividades = malloc(sizeof(Atividade) * MAX_ATIVIDADES);
+    AlunoTurma *matriculas = malloc(sizeof(AlunoTurma) * MAX_MATRICULAS);
+    MapaInteiros turma_da_atividade = {0};
+    int validas = 0;
+
+    if (atividades != NULL && matriculas != NULL) {
+        int total_atividades = listarAtividades(atividades, MAX_ATIVIDADES);
+        int total_matriculas = listarMatriculas(matriculas, MAX_MATRICULAS);
+        qsort(matriculas, (size_t)total_matriculas, sizeof(AlunoTurma), compararMatriculas);
+
+        int memoria = 1;
+        for (int i = 0; i < total_atividades && memoria; i++) {
+            memoria = mapaInserir(&turma_da_atividade, atividades[i].id, atividades[i].id_turma);
+        }
+        for (int i = 0; i < total && memoria; i++) {
+            AlunoTurma chave = { notas[i].ra, mapaBuscar(&turma_da_atividade, notas[i].id_atividade) };
+            if (notaValida(notas[i].nota) && chave.id_turma >= 0 &&
+                bsearch(&chave, matriculas, (size_t)total_matriculas, sizeof(AlunoTurma),
+                        compararMatriculas) != NULL) {
+                notas[validas++] = notas[i];
+            }
+        }
+    }
+    free(atividades);
+    free(matriculas);
+    mapaLiberar(&turma_da_atividade);
+
+    int importadas = 0;
+    if (validas > 0) {
+        abrirEscritaTabela(&tabela_notas);
+        importadas = boletim_sistema != NULL ? importarNotasBoletim(boletim_sistema, notas, validas) : -1;
+        if (importadas > 0 && !registrarAlteracaoTabela(&tabela_notas)) {
+            importadas = 0;
+        }
+        fecharTabela(&tabela_notas);
+    }
+
+    free(notas);
+    return importadas < 0 ? 0 : importadas;
+}
+
+// Consultar a nota de um aluno em uma atividade
+int obterNota(int ra, int id_atividade, float *destino) {
+    abrirLeituraTabela(&tabela_notas);
+    int encontrada = obterNotaBoletim(boletim_sistema, ra, id_atividade, destino);
+    fecharTabela(&tabela_notas);
+    return encontrada;
+}
+
+// Apagar a nota de um aluno em uma atividade
+int removerNota(int ra, int id_atividade) {
+    abrirEscritaTabela(&tabela_notas);
+    int removida = removerNotaBoletim(boletim_sistema, ra, id_atividade);
+    if (removida) {
+        removida = registrarAlteracaoTabela(&tabela_notas);
+    }
+    fecharTabela(&tabela_notas);
+    return removida;
+}
+
+// Apagar as notas de várias atividades de uma vez
+int removerNotasDasAtividades(const int *atividades, int total) {
+    int removidas = 0;
+
+    abrirEscritaTabela(&tabela_notas);
+    for (int i = 0; boletim_sistema != NULL && i < total; i++) {
+        removidas += removerAtividadeBoletim(boletim_sistema, atividades[i]);
+    }
+    if (removidas > 0 && !registrarAlteracaoTabela(&tabela_notas)) {
+        removidas = -1; // Alteração desfeita: nada foi apagado
+    }
+    fecharTabela(&tabela_notas);
+    return removidas;
+}
+
+// Estatísticas de uma atividade
+void estatisticasDaAtividade(int id_atividade, EstatisticasNotas *destino) {
+    abrirLeituraTabela(&tabela_notas);
+    estatisticasAtividadesBoletim(boletim_sistema, &id_atividade, 1, destino);
+    fecharTabela(&tabela_notas);
+}
+
+// Estatísticas de todas as notas de uma turma
+void estatisticasDaTurma(int id_turma, EstatisticasNotas *destino) {
+    int total = 0;
+    int *ids = atividadesDaTurma(id_turma, &total);
+
+    abrirLeituraTabela(&tabela_notas);
+    estatisticasAtividadesBoletim(total > 0 ? boletim_sistema : NULL, ids, total, destino);
+    fecharTabela(&tabela_notas);
+    free(ids);
+}
+
+// Estatísticas de um aluno em uma turma (0 = em todas as atividades)
+void estatisticasDoAluno(int ra, int id_turma, EstatisticasNotas *destino) {
+    int total = 0;
+    int *ids = id_turma != 0 ? atividadesDaTurma(id_turma, &total) : NULL;
+
+    abrirLeituraTabela(&tabela_notas);
+    estatisticasAlunoBoletim(id_turma == 0 || total > 0 ? boletim_sistema : NULL, ra, ids, total, destino);
+    fecharTabela(&tabela_notas);
+    free(ids);
+}
+
+// Média de cada aluno com nota nas atividades da turma
+int mediasDaTurma(int id_turma, int *ras, double *medias, int max) {
+    int total = 0;
+    int *ids = atividadesDaTurma(id_turma, &total);
+    int copiados = 0;
+
+    if (total > 0) {
+        abrirLeituraTabela(&tabela_notas);
+        copiados = mediasPorAlunoBoletim(boletim_sistema, ids, total, ras, medias, max);
+        fecharTabela(&tabela_notas);
+    }
+    free(ids);
+    return copiados < 0 ? 0 : copiados;
+}
+
+// Média ponderada de um aluno em atividades escolhidas
+int mediaPonderadaDoAluno(int ra, const int *atividades, const float *pesos, int total, double *media) {
+    abrirLeituraTabela(&tabela_notas);
+    int calculada = mediaPonderadaBoletim(boletim_sistema, ra, atividades, pesos, total, media);
+    fecharTabela(&tabela_notas);
+    return calculada;
+}
@@ -0,0 +1,131 @@
+#ifndef NOTA_MANAGER_H
+#define NOTA_MANAGER_H
+
+#include "structs.h"
+
+// ========== NOTAS (BOLETIM EM COLUNAS) ==========
+//
+// O boletim é uma tabela RA x atividade guardada por coluna: cada atividade
+// tem um vetor de float com uma posição por aluno (linha), e um mapa RA ->
+// linha comum a todas as colunas. Posição sem nota vale NaN.
+// - estatísticas de uma atividade/turma percorrem colunas contíguas, de 4 em
+//   4 valores com SSE2 quando disponível (NaN descartado por máscara);
+// - as de um aluno leem a mesma linha em cada coluna pedida.
+// Linhas e colunas só crescem enquanto o boletim existe; removerNota apenas
+// volta a posição para NaN.
+//
+// As notas lançadas pelo sistema ficam em ARQUIVO_NOTAS (RA,ID_Atividade,Nota),
+// uma TabelaResidente como as demais: o boletim é remontado quando o CSV muda.
+
+#define ARQUIVO_NOTAS "data/notas.csv"
+#define NOTA_MAXIMA 10.0f
+#define FAIXAS_HISTOGRAMA 10       // Faixas de 1 ponto: [0,1), [1,2), ..., [9,10]
+
+typedef struct Boletim Boletim;
+
+// Resultado das estatísticas (campos zerados quando quantidade == 0)
+typedef struct {
+    int quantidade;                // Notas consideradas
+    double media;
+    double desvio;                 // Desvio padrão populacional
+    float minima;
+    float maxima;
+    int histograma[FAIXAS_HISTOGRAMA];
+} EstatisticasNotas;
+
+// ========== BOLETIM EM MEMÓRIA ==========
+
+// Função para criar um boletim vazio
+// Retorna: boletim ou NULL se faltou memória
+Boletim* criarBoletim(void);
+
+// Função para liberar o boletim
+void liberarBoletim(Boletim *boletim);
+
+// Função para lançar (ou substituir) a nota de um aluno em uma atividade
+// Retorna: 1 se sucesso, 0 se nota fora de 0..NOTA_MAXIMA ou faltou memória
+int lancarNotaBoletim(Boletim *boletim, int ra, int id_atividade, float nota);
+
+// Função para importar notas em lote (mesmo efeito de lancarNotaBoletim em
+// sequência, com reserva de linhas/colunas de uma vez)
+// Retorna: notas importadas (as fora da faixa são ignoradas), -1 se faltou memória
+int importarNotasBoletim(Boletim *boletim, const Nota *notas, int total);
+
+// Função para consultar uma nota
+// Retorna: 1 se há nota, 0 se não
+int obterNotaBoletim(const Boletim *boletim, int ra, int id_atividade, float *destino);
+
+// Função para apagar uma nota
+// Retorna: 1 se havia nota, 0 se não
+int removerNotaBoletim(Boletim *boletim, int ra, int id_atividade);
+
+// Função para apagar todas as notas de uma atividade (a coluna fica vazia)
+// Retorna: notas apagadas
+int removerAtividadeBoletim(Boletim *boletim, int id_atividade);
+
+// Nas funções abaixo, atividades == NULL considera todas as colunas do boletim
+
+// Função para calcular as estatísticas de um conjunto de atividades (todas as
+// notas das colunas pedidas: uma atividade, ou as atividades de uma turma)
+void estatisticasAtividadesBoletim(const Boletim *boletim, const int *atividades, int total,
+                                   EstatisticasNotas *destino);
+
+// Função para calcular as estatísticas de um aluno nas atividades pedidas
+void estatisticasAlunoBoletim(const Boletim *boletim, int ra, const int *atividades, int total,
+                              EstatisticasNotas *destino);
+
+// Função para calcular a média ponderada de um aluno; atividades sem nota
+// ficam de fora (o peso delas não entra no divisor)
+// Retorna: 1 se havia ao menos uma nota com peso positivo, 0 se não
+int mediaPonderadaBoletim(const Boletim *boletim, int ra, const int *atividades, const float *pesos,
+                          int total, double *media);
+
+// Função para calcular a média de todos os alunos nas atividades pedidas,
+// somando coluna a coluna (alunos sem nota nelas ficam de fora)
+// Retorna: alunos copiados para ras/medias (até max), -1 se faltou memória
+int mediasPorAlunoBoletim(const Boletim *boletim, const int *atividades, int total, int *ras,
+                          double *medias, int max);
+
+// ========== NOTAS DO SISTEMA (ARQUIVO_NOTAS) ==========
+
+// Função para lançar a nota de um aluno matriculado na turma da atividade
+// Retorna: 1 se sucesso, 0 se erro (atividade inexistente, aluno fora da turma, nota inválida,
+// falha ao gravar)
+int lancarNota(int ra, int id_atividade, float nota);
+
+// Função para importar notas de um CSV "RA,ID_Atividade,Nota" (com cabeçalho)
+// Linhas inválidas são ignoradas; tudo é gravado de uma vez
+// Retorna: notas importadas, ou -1 se o arquivo não pôde ser lido
+int importarNotas(const char *arquivo_csv);
+
+// Função para consultar a nota de um aluno em uma atividade
+// Retorna: 1 se há nota, 0 se não
+int obterNota(int ra, int id_atividade, float *destino);
+
+// Função para apagar a nota de um aluno em uma atividade
+// Retorna: 1 se havia nota (e a remoção foi gravada), 0 se não
+int removerNota(int ra, int id_atividade);
+
+// Função para apagar todas as notas das atividades pedidas (ex.: atividades
+// excluídas), com uma única gravação
+// Retorna: notas apagadas, ou -1 se a gravação falhou
+int removerNotasDasAtividades(const int *atividades, int total);
+
+// Função para calcular as estatísticas de uma atividade
+void estatisticasDaAtividade(int id_atividade, EstatisticasNotas *destino);
+
+// Função para calcular as estatísticas de todas as notas de uma turma
+void estatisticasDaTurma(int id_turma, EstatisticasNotas *destino);
+
+// Função para calcular as estatísticas de um aluno em uma turma (0 = em todas)
+void estatisticasDoAluno(int ra, int id_turma, EstatisticasNotas *destino);
+
+// Função para calcular a média de cada aluno com nota nas atividades da turma
+// Retorna: alunos copiados para ras/medias (até max)
+int mediasDaTurma(int id_turma, int *ras, double *medias, int max);
+
+// Função para calcular a média ponderada de um aluno em atividades escolhidas
+// Retorna: 1 se havia nota, 0 se não
+int mediaPonderadaDoAluno(int ra, const int *atividades, const float *pesos, int total, double *media);
+
+#endif
@@ -0,0 +1,754 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include "persistencia_manager.h"
+#include "structs.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#define open _open
+#define write _write
+#define close _close
+#define fsync _commit
+#else
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#define PERSISTENCIA_COM_URING 1
+#endif
+
+#define ENTRADAS_URING 64
+#define OPERACOES_POR_TAREFA 4   // escrever, fsync, rename, fsync do diretório
+#define TRABALHADORES_PERSISTENCIA 2
+
+// ========== ESTRUTURAS INTERNAS ==========
+
+typedef struct TarefaGravacao {
+    uint64_t ticket;
+    char destino[MAX_PATH];
+    char temporario[MAX_PATH + 32];
+    char *conteudo;
+    size_t tamanho;
+    int descritor;             // Temporário aberto na submissão
+    int descritor_dir;         // Diretório do destino (fsync após o rename)
+    int restantes;             // Operações io_uring sem conclusão
+    int resultado;             // Primeiro erro da cadeia (0 = sucesso)
+    int no_anel;               // Ocupa vaga no io_uring
+    FilaConclusoes *fila;
+    void *contexto;
+    struct TarefaGravacao *espera;   // Próximo pedido para o mesmo destino
+    struct TarefaGravacao *proxima;  // Encadeamento em listas do motor
+} TarefaGravacao;
+
+static pthread_mutex_t trava_motor = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sinal_motor = PTHREAD_COND_INITIALIZER;
+static int modo_ativo = 0;
+static int encerrando = 0;
+static uint64_t proximo_ticket = 1;
+static int pendentes = 0;                   // Submetidos e ainda não concluídos
+static TarefaGravacao *em_andamento = NULL; // Um por destino; os demais esperam
+
+// Pool de threads (fallback)
+static TarefaGravacao *prontas_inicio = NULL;
+static TarefaGravacao *prontas_fim = NULL;
+static pthread_t trabalhadores[TRABALHADORES_PERSISTENCIA];
+
+static void despacharTarefa(TarefaGravacao *tarefa);
+
+#ifdef PERSISTENCIA_COM_URING
+typedef struct {
+    int fd;
+    unsigned entradas;
+    _Atomic unsigned *sq_cabeca;
+    _Atomic unsigned *sq_cauda;
+    unsigned *sq_mascara;
+    unsigned *sq_indices;
+    _Atomic unsigned *cq_cabeca;
+    _Atomic unsigned *cq_cauda;
+    unsigned *cq_mascara;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void *mapa_sq;
+    void *mapa_cq;
+    size_t tam_sq;
+    size_t tam_cq;
+    size_t tam_sqes;
+    int tarefas;               // Tarefas com operações no anel
+    pthread_t colhedor;
+} AnelUring;
+
+static AnelUring anel = { .fd = -1 };
+#endif
+
+// ========== FILA DE CONCLUSÕES ==========
+
+void inicializarFilaConclusoes(FilaConclusoes *fila) {
+    pthread_mutex_init(&fila->trava, NULL);
+    pthread_cond_init(&fila->sinal, NULL);
+    fila->itens = NULL;
+    fila->inicio = 0;
+    fila->quantidade = 0;
+    fila->capacidade = 0;
+}
+
+void destruirFilaConclusoes(FilaConclusoes *fila) {
+    free(fila->itens);
+    fila->itens = NULL;
+    pthread_mutex_destroy(&fila->trava);
+    pthread_cond_destroy(&fila->sinal);
+}
+
+static void entregarConclusao(FilaConclusoes *fila, const ConclusaoGravacao *conclusao) {
+    pthread_mutex_lock(&fila->trava);
+
+    // Cresce o anel reorganizando os itens a partir do índice 0
+    if (fila->quantidade == fila->capacidade) {
+        int nova = fila->capacidade ? fila->capacidade * 2 : 16;
+        ConclusaoGravacao *itens = malloc(sizeof(ConclusaoGravacao) * (size_t)nova);
+        if (itens == NULL) {
+            pthread_mutex_unlock(&fila->trava);
+            printf("Erro: sem memória para a fila de conclusões.\n");
+            return;
+        }
+        for (int i = 0; i < fila->quantidade; i++) {
+            itens[i] = fila->itens[(fila->inicio + i) % fila->capacidade];
+        }
+        free(fila->itens);
+        fila->itens = itens;
+        fila->inicio = 0;
+        fila->capacidade = nova;
+    }
+
+    fila->itens[(fila->inicio + fila->quantidade) % fila->capacidade] = *conclusao;
+    fila->quantidade++;
+    pthread_cond_signal(&fila->sinal);
+    pthread_mutex_unlock(&fila->trava);
+}
+
+void aguardarConclusao(FilaConclusoes *fila, ConclusaoGravacao *destino) {
+    pthread_mutex_lock(&fila->trava);
+    while (fila->quantidade == 0) {
+        pthread_cond_wait(&fila->sinal, &fila->trava);
+    }
+    *destino = fila->itens[fila->inicio];
+    fila->inicio = (fila->inicio + 1) % fila->capacidade;
+    fila->quantidade--;
+    pthread_mutex_unlock(&fila->trava);
+}
+
+int colherConclusoes(FilaConclusoes *fila, ConclusaoGravacao *destino, int max) {
+    int colhidas = 0;
+
+    pthread_mutex_lock(&fila->trava);
+    while (colhidas < max && fila->quantidade > 0) {
+        destino[colhidas++] = fila->itens[fila->inicio];
+        fila->inicio = (fila->inicio + 1) % fila->capacidade;
+        fila->quantidade--;
+    }
+    pthread_mutex_unlock(&fila->trava);
+    return colhidas;
+}
+
+// ========== CONCLUSÃO DE TAREFAS ==========
+
+// Chamada sem trava_motor quando a cadeia inteira terminou
+static void finalizarTarefa(TarefaGravacao *tarefa) {
+    if (tarefa->descritor >= 0) {
+        close(tarefa->descritor);
+    }
+    if (tarefa->descritor_dir >= 0) {
+        close(tarefa->descritor_dir);
+    }
+    if (tarefa->resultado < 0) {
+        remove(tarefa->temporario);
+    }
+
+    if (tarefa->fila != NULL) {
+        ConclusaoGravacao conclusao = {tarefa->ticket, tarefa->resultado, tarefa->contexto};
+        entregarConclusao(tarefa->fila, &conclusao);
+    }
+
+    pthread_mutex_lock(&trava_motor);
+
+#ifdef PERSISTENCIA_COM_URING
+    if (tarefa->no_anel) {
+        anel.tarefas--;        // O próximo da espera herda a vaga
+    }
+#endif
+
+    // Sai da lista de andamento e libera o próximo pedido do mesmo destino
+    for (TarefaGravacao **p = &em_andamento; *p != NULL; p = &(*p)->proxima) {
+        if (*p == tarefa) {
+            *p = tarefa->proxima;
+            break;
+        }
+    }
+    if (tarefa->espera != NULL) {
+        despacharTarefa(tarefa->espera);
+    }
+
+    pendentes--;
+    pthread_cond_broadcast(&sinal_motor);
+    pthread_mutex_unlock(&trava_motor);
+
+    free(tarefa->conteudo);
+    free(tarefa);
+}
+
+// ========== BACKEND io_uring (CHAMADAS DE SISTEMA DIRETAS) ==========
+
+#ifdef PERSISTENCIA_COM_URING
+
+
+#define OP_ESCREVER 0
+#define OP_FSYNC 1
+#define OP_RENOMEAR 2
+#define OP_FSYNC_DIR 3
+
+static int uringSetup(unsigned entradas, struct io_uring_params *parametros) {
+    return (int)syscall(__NR_io_uring_setup, entradas, parametros);
+}
+
+static int uringEnter(unsigned enviar, unsigned minimo, unsigned flags) {
+    return (int)syscall(__NR_io_uring_enter, anel.fd, enviar, minimo, flags, NULL, 0);
+}
+
+// Confere se o kernel conhece todas as operações da cadeia
+static int uringSuportaCadeia(void) {
+    size_t tamanho = sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op);
+    struct io_uring_probe *sonda = calloc(1, tamanho);
+    int ok = 0;
+
+    if (sonda == NULL) {
+        return 0;
+    }
+    if (syscall(__NR_io_uring_register, anel.fd, IORING_REGISTER_PROBE, sonda, 256) == 0) {
+        int ops[] = {IORING_OP_WRITE, IORING_OP_FSYNC, IORING_OP_RENAMEAT, IORING_OP_NOP};
+        ok = 1;
+        for (size_t i = 0; i < sizeof(ops) / sizeof(ops[0]); i++) {
+            if (ops[i] > sonda->last_op || !(sonda->ops[ops[i]].flags & IO_URING_OP_SUPPORTED)) {
+                ok = 0;
+            }
+        }
+    }
+    free(sonda);
+    return ok;
+}
+
+static void fecharAnel(void) {
+    if (anel.sqes != NULL) {
+        munmap(anel.sqes, anel.tam_sqes);
+    }
+    if (anel.mapa_cq != NULL && anel.mapa_cq != anel.mapa_sq) {
+        munmap(anel.mapa_cq, anel.tam_cq);
+    }
+    if (anel.mapa_sq != NULL) {
+        munmap(anel.mapa_sq, anel.tam_sq);
+    }
+    if (anel.fd >= 0) {
+        close(anel.fd);
+    }
+    memset(&anel, 0, sizeof(anel));
+    anel.fd = -1;
+}
+
+static int abrirAnel(void) {
+    struct io_uring_params p;
+    unsigned char *sq, *cq;
+
+    memset(&p, 0, sizeof(p));
+    anel.fd = uringSetup(ENTRADAS_URING, &p);
+    if (anel.fd < 0) {
+        anel.fd = -1;
+        return 0;
+    }
+    anel.entradas = p.sq_entries;
+
+    anel.tam_sq = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    anel.tam_cq = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (anel.tam_cq > anel.tam_sq) {
+            anel.tam_sq = anel.tam_cq;
+        }
+        anel.tam_cq = anel.tam_sq;
+    }
+
+    anel.mapa_sq = mmap(NULL, anel.tam_sq, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        anel.fd, IORING_OFF_SQ_RING);
+    if (anel.mapa_sq == MAP_FAILED) {
+        anel.mapa_sq = NULL;
+        fecharAnel();
+        return 0;
+    }
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        anel.mapa_cq = anel.mapa_sq;
+    } else {
+        anel.mapa_cq = mmap(NULL, anel.tam_cq, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                            anel.fd, IORING_OFF_CQ_RING);
+        if (anel.mapa_cq == MAP_FAILED) {
+            anel.mapa_cq = NULL;
+            fecharAnel();
+            return 0;
+        }
+    }
+
+    anel.tam_sqes = p.sq_entries * sizeof(struct io_uring_sqe);
+    anel.sqes = mmap(NULL, anel.tam_sqes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     anel.fd, IORING_OFF_SQES);
+    if (anel.sqes == MAP_FAILED) {
+        anel.sqes = NULL;
+        fecharAnel();
+        return 0;
+    }
+
+    sq = anel.mapa_sq;
+    cq = anel.mapa_cq;
+    anel.sq_cabeca = (_Atomic unsigned *)(sq + p.sq_off.head);
+    anel.sq_cauda = (_Atomic unsigned *)(sq + p.sq_off.tail);
+    anel.sq_mascara = (unsigned *)(sq + p.sq_off.ring_mask);
+    anel.sq_indices = (unsigned *)(sq + p.sq_off.array);
+    anel.cq_cabeca = (_Atomic unsigned *)(cq + p.cq_off.head);
+    anel.cq_cauda = (_Atomic unsigned *)(cq + p.cq_off.tail);
+    anel.cq_mascara = (unsigned *)(cq + p.cq_off.ring_mask);
+    anel.cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+
+    if (!uringSuportaCadeia()) {
+        fecharAnel();
+        return 0;
+    }
+    return 1;
+}
+
+// Reserva a próxima SQE (exige trava_motor)
+static struct io_uring_sqe* proximaSqe(unsigned *cauda) {
+    unsigned indice = *cauda & *anel.sq_mascara;
+    struct io_uring_sqe *sqe = &anel.sqes[indice];
+
+    memset(sqe, 0, sizeof(*sqe));
+    anel.sq_indices[indice] = indice;
+    (*cauda)++;
+    return sqe;
+}
+
+// Publica as SQEs preparadas e avisa o kernel (exige trava_motor)
+static void enviarSqes(unsigned cauda, unsigned quantidade) {
+    atomic_store_explicit(anel.sq_cauda, cauda, memory_order_release);
+    while (uringEnter(quantidade, 0, 0) < 0 && errno == EINTR) {
+        // repete
+    }
+}
+
+// Envia a cadeia escrever -> fsync -> rename -> fsync(dir) (exige trava_motor)
+static void enfileirarUring(TarefaGravacao *tarefa) {
+    unsigned cauda;
+    struct io_uring_sqe *sqe;
+    uint64_t base = (uint64_t)(uintptr_t)tarefa;
+
+    anel.tarefas++;
+    tarefa->no_anel = 1;
+    tarefa->restantes = OPERACOES_POR_TAREFA;
+    cauda = atomic_load_explicit(anel.sq_cauda, memory_order_relaxed);
+
+    sqe = proximaSqe(&cauda);
+    sqe->opcode = IORING_OP_WRITE;
+    sqe->fd = tarefa->descritor;
+    sqe->addr = (uint64_t)(uintptr_t)tarefa->conteudo;
+    sqe->len = (uint32_t)tarefa->tamanho;
+    sqe->off = 0;
+    sqe->flags = IOSQE_IO_LINK;
+    sqe->user_data = base | OP_ESCREVER;
+
+    sqe = proximaSqe(&cauda);
+    sqe->opcode = IORING_OP_FSYNC;
+    sqe->fd = tarefa->descritor;
+    sqe->flags = IOSQE_IO_LINK;
+    sqe->user_data = base | OP_FSYNC;
+
+    sqe = proximaSqe(&cauda);
+    sqe->opcode = IORING_OP_RENAMEAT;
+    sqe->fd = AT_FDCWD;
+    sqe->addr = (uint64_t)(uintptr_t)tarefa->temporario;
+    sqe->len = (uint32_t)AT_FDCWD;
+    sqe->addr2 = (uint64_t)(uintptr_t)tarefa->destino;
+    sqe->flags = IOSQE_IO_LINK;
+    sqe->user_data = base | OP_RENOMEAR;
+
+    sqe = proximaSqe(&cauda);
+    sqe->opcode = IORING_OP_FSYNC;
+    sqe->fd = tarefa->descritor_dir;
+    sqe->user_data = base | OP_FSYNC_DIR;
+
+    enviarSqes(cauda, OPERACOES_POR_TAREFA);
+}
+
+// Thread que colhe as CQEs e conclui as tarefas
+static void *colhedorUring(void *arg) {
+    (void)arg;
+
+    for (;;) {
+        if (uringEnter(0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+            printf("Erro: io_uring_enter falhou (%s).\n", strerror(errno));
+            return NULL;
+        }
+
+        unsigned cabeca = atomic_load_explicit(anel.cq_cabeca, memory_order_relaxed);
+        unsigned cauda = atomic_load_explicit(anel.cq_cauda, memory_order_acquire);
+        int sair = 0;
+
+        while (cabeca != cauda) {
+            struct io_uring_cqe *cqe = &anel.cqes[cabeca & *anel.cq_mascara];
+            TarefaGravacao *tarefa = (TarefaGravacao *)(uintptr_t)(cqe->user_data & ~(uint64_t)3);
+            int operacao = (int)(cqe->user_data & 3);
+            int resultado = cqe->res;
+
+            cabeca++;
+            if (tarefa == NULL) {
+                sair = 1;       // NOP de encerramento
+                continue;
+            }
+
+            // Escrita curta também interrompe a cadeia (o kernel cancela o resto)
+            if (operacao == OP_ESCREVER && resultado >= 0 && (size_t)resultado != tarefa->tamanho) {
+                resultado = -EIO;
+            }
+            if (resultado < 0 && (tarefa->resultado == 0 || tarefa->resultado == -ECANCELED)) {
+                tarefa->resultado = resultado;
+            }
+
+            if (--tarefa->restantes == 0) {
+                atomic_store_explicit(anel.cq_cabeca, cabeca, memory_order_release);
+                finalizarTarefa(tarefa);
+            }
+        }
+        atomic_store_explicit(anel.cq_cabeca, cabeca, memory_order_release);
+
+        if (sair) {
+            return NULL;
+        }
+    }
+}
+
+static int iniciarUring(void) {
+    if (!abrirAnel()) {
+        return 0;
+    }
+    if (pthread_create(&anel.colhedor, NULL, colhedorUring, NULL) != 0) {
+        fecharAnel();
+        return 0;
+    }
+    return 1;
+}
+
+static void encerrarUring(void) {
+    pthread_mutex_lock(&trava_motor);
+    unsigned cauda = atomic_load_explicit(anel.sq_cauda, memory_order_relaxed);
+    struct io_uring_sqe *sqe = proximaSqe(&cauda);
+    sqe->opcode = IORING_OP_NOP;
+    sqe->user_data = 0;
+    enviarSqes(cauda, 1);
+    pthread_mutex_unlock(&trava_motor);
+
+    pthread_join(anel.colhedor, NULL);
+    fecharAnel();
+}
+
+#endif
+
+// ========== BACKEND POOL DE THREADS ==========
+
+// Executa a cadeia com chamadas síncronas
+static void executarCadeiaSincrona(TarefaGravacao *tarefa) {
+    size_t escritos = 0;
+
+    while (escritos < tarefa->tamanho) {
+        long n = (long)write(tarefa->descritor, tarefa->conteudo + escritos,
+                             (unsigned)(tarefa->tamanho - escritos));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            tarefa->resultado = n < 0 ? -errno : -EIO;
+            return;
+        }
+        escritos += (size_t)n;
+    }
+
+    if (fsync(tarefa->descritor) != 0) {
+        tarefa->resultado = -errno;
+        return;
+    }
+
+#ifdef _WIN32
+    close(tarefa->descritor);
+    tarefa->descritor = -1;
+    if (!MoveFileExA(tarefa->temporario, tarefa->destino, MOVEFILE_REPLACE_EXISTING)) {
+        tarefa->resultado = -EIO;
+    }
+#else
+    if (rename(tarefa->temporario, tarefa->destino) != 0) {
+        tarefa->resultado = -errno;
+        return;
+    }
+    if (tarefa->descritor_dir >= 0 && fsync(tarefa->descritor_dir) != 0) {
+        tarefa->resultado = -errno;
+    }
+#endif
+}
+
+static void *trabalhadorPersistencia(void *arg) {
+    (void)arg;
+
+    for (;;) {
+        pthread_mutex_lock(&trava_motor);
+        while (prontas_inicio == NULL && !encerrando) {
+            pthread_cond_wait(&sinal_motor, &trava_motor);
+        }
+        if (prontas_inicio == NULL) {
+            pthread_mutex_unlock(&trava_motor);
+            return NULL;
+        }
+
+        TarefaGravacao *tarefa = prontas_inicio;
+        prontas_inicio = tarefa->proxima;
+        if (prontas_inicio == NULL) {
+            prontas_fim = NULL;
+        }
+        tarefa->proxima = NULL;
+
+        // Volta para a lista de andamento até concluir
+        tarefa->proxima = em_andamento;
+        em_andamento = tarefa;
+        pthread_mutex_unlock(&trava_motor);
+
+        executarCadeiaSincrona(tarefa);
+        finalizarTarefa(tarefa);
+    }
+}
+
+// ========== DESPACHO ==========
+
+// Inicia a tarefa ou a coloca atrás do pedido em andamento do mesmo destino
+// (exige trava_motor)
+static void despacharTarefa(TarefaGravacao *tarefa) {
+    for (TarefaGravacao *atual = em_andamento; atual != NULL; atual = atual->proxima) {
+        if (strcmp(atual->destino, tarefa->destino) == 0) {
+            TarefaGravacao *ultima = atual;
+            while (ultima->espera != NULL) {
+                ultima = ultima->espera;
+            }
+            if (ultima != tarefa) {
+                ultima->espera = tarefa;
+            }
+            return;
+        }
+    }
+
+#ifdef PERSISTENCIA_COM_URING
+    if (modo_ativo == PERSISTENCIA_URING) {
+        tarefa->proxima = em_andamento;
+        em_andamento = tarefa;
+        enfileirarUring(tarefa);
+        return;
+    }
+#endif
+
+    // Pool de threads: o trabalhador a recoloca em em_andamento
+    tarefa->proxima = NULL;
+    if (prontas_fim != NULL) {
+        prontas_fim->proxima = tarefa;
+    } else {
+        prontas_inicio = tarefa;
+    }
+    prontas_fim = tarefa;
+    pthread_cond_broadcast(&sinal_motor);
+}
+
+// Pedidos na fila do pool contam como "em andamento" para a ordenação
+static int destinoOcupado(const char *destino) {
+    for (TarefaGravacao *t = prontas_inicio; t != NULL; t = t->proxima) {
+        if (strcmp(t->destino, destino) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// ========== FUNÇÕES PÚBLICAS ==========
+
+int iniciarPersistencia(int modo) {
+    pthread_mutex_lock(&trava_motor);
+    if (modo_ativo != 0) {
+        pthread_mutex_unlock(&trava_motor);
+        return modo_ativo;
+    }
+    encerrando = 0;
+    pthread_mutex_unlock(&trava_motor);
+
+#ifdef PERSISTENCIA_COM_URING
+    if (modo != PERSISTENCIA_THREADS && iniciarUring()) {
+        modo_ativo = PERSISTENCIA_URING;
+        return modo_ativo;
+    }
+#endif
+    if (modo == PERSISTENCIA_URING) {
+        printf("Aviso: io_uring indisponível; usando pool de threads.\n");
+    }
+
+    for (int i = 0; i < TRABALHADORES_PERSISTENCIA; i++) {
+        if (pthread_create(&trabalhadores[i], NULL, trabalhadorPersistencia, NULL) != 0) {
+            printf("Erro: não foi possível criar as threads de persistência.\n");
+            pthread_mutex_lock(&trava_motor);
+            encerrando = 1;
+            pthread_cond_broadcast(&sinal_motor);
+            pthread_mutex_unlock(&trava_motor);
+            for (int j = 0; j < i; j++) {
+                pthread_join(trabalhadores[j], NULL);
+            }
+            return 0;
+        }
+    }
+    modo_ativo = PERSISTENCIA_THREADS;
+    return modo_ativo;
+}
+
+void encerrarPersistencia(void) {
+    if (modo_ativo == 0) {
+        return;
+    }
+
+    aguardarTodasGravacoes();
+
+#ifdef PERSISTENCIA_COM_URING
+    if (modo_ativo == PERSISTENCIA_URING) {
+        encerrarUring();
+        modo_ativo = 0;
+        return;
+    }
+#endif
+
+    pthread_mutex_lock(&trava_motor);
+    encerrando = 1;
+    pthread_cond_broadcast(&sinal_motor);
+    pthread_mutex_unlock(&trava_motor);
+    for (int i = 0; i < TRABALHADORES_PERSISTENCIA; i++) {
+        pthread_join(trabalhadores[i], NULL);
+    }
+    modo_ativo = 0;
+}
+
+const char* backendPersistencia(void) {
+    switch (modo_ativo) {
+        case PERSISTENCIA_URING:
+            return "io_uring";
+        case PERSISTENCIA_THREADS:
+            return "threads";
+        default:
+            return "inativo";
+    }
+}
+
+// Abre o diretório do destino para o fsync após o rename
+static int abrirDiretorioDestino(const char *destino) {
+#ifdef _WIN32
+    (void)destino;
+    return -1;
+#else
+    char diretorio[MAX_PATH];
+    const char *barra = strrchr(destino, '/');
+
+    if (barra == NULL) {
+        return open(".", O_RDONLY);
+    }
+    snprintf(diretorio, sizeof(diretorio), "%.*s", (int)(barra - destino), destino);
+    return open(barra == destino ? "/" : diretorio, O_RDONLY);
+#endif
+}
+
+uint64_t submeterGravacao(const char *arquivo, char *conteudo, size_t tamanho,
+                          FilaConclusoes *fila, void *contexto) {
+    TarefaGravacao *tarefa;
+
+    if (modo_ativo == 0 || arquivo == NULL || strlen(arquivo) >= MAX_PATH ||
+        (conteudo == NULL && tamanho > 0)) {
+        free(conteudo);
+        return 0;
+    }
+
+    tarefa = calloc(1, sizeof(TarefaGravacao));
+    if (tarefa == NULL) {
+        free(conteudo);
+        return 0;
+    }
+
+    // Copiado sob a trava: depois de despachada, a tarefa pode ser liberada
+    // por um worker (ou pela conclusão do io_uring) antes deste retorno
+    pthread_mutex_lock(&trava_motor);
+    uint64_t ticket = proximo_ticket++;
+    tarefa->ticket = ticket;
+    pendentes++;
+    pthread_mutex_unlock(&trava_motor);
+
+    strcpy(tarefa->destino, arquivo);
+    snprintf(tarefa->temporario, sizeof(tarefa->temporario), "%s.tmp.%llu",
+             arquivo, (unsigned long long)ticket);
+    tarefa->conteudo = conteudo;
+    tarefa->tamanho = tamanho;
+    tarefa->fila = fila;
+    tarefa->contexto = contexto;
+
+    // Temporário exclusivo do pedido: pode ser aberto antes de chegar a vez
+    tarefa->descritor = open(tarefa->temporario, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    tarefa->descritor_dir = abrirDiretorioDestino(arquivo);
+    if (tarefa->descritor < 0) {
+        // Aceito, mas já concluído com erro (entregue na fila como os demais)
+        tarefa->resultado = -errno;
+        finalizarTarefa(tarefa);
+        return ticket;
+    }
+
+    pthread_mutex_lock(&trava_motor);
+#ifdef PERSISTENCIA_COM_URING
+    // Cada tarefa ocupa OPERACOES_POR_TAREFA entradas até ser colhida; as que
+    // saem da espera (finalizarTarefa) reaproveitam a vaga da anterior
+    while (modo_ativo == PERSISTENCIA_URING &&
+           (anel.tarefas + 1) * OPERACOES_POR_TAREFA > (int)anel.entradas) {
+        pthread_cond_wait(&sinal_motor, &trava_motor);
+    }
+#endif
+    if (modo_ativo == PERSISTENCIA_THREADS && destinoOcupado(arquivo)) {
+        // Atrás do último pedido do mesmo destino ainda na fila do pool
+        TarefaGravacao *ultima = NULL;
+        for (TarefaGravacao *t = prontas_inicio; t != NULL; t = t->proxima) {
+            if (strcmp(t->destino, arquivo) == 0) {
+                ultima = t;
+            }
+        }
+        while (ultima->espera != NULL) {
+            ultima = ultima->espera;
+        }
+        ultima->espera = tarefa;
+    } else {
+        despacharTarefa(tarefa);
+    }
+    pthread_mutex_unlock(&trava_motor);
+
+    return ticket;
+}
+
+void aguardarTodasGravacoes(void) {
+    pthread_mutex_lock(&trava_motor);
+    while (pendentes > 0) {
+        pthread_cond_wait(&sinal_motor, &trava_motor);
+    }
+    pthread_mutex_unlock(&trava_motor);
+}
@@ -0,0 +1,79 @@
+#ifndef PERSISTENCIA_MANAGER_H
+#define PERSISTENCIA_MANAGER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+
+// ========== PERSISTÊNCIA ASSÍNCRONA ==========
+//
+// Grava arquivos inteiros sem bloquear quem pede a gravação. Cada pedido vira
+// a cadeia escrever -> fsync -> rename sobre "<arquivo>.tmp.<ticket>":
+// - no Linux, a cadeia é enviada de uma vez ao io_uring (operações ligadas
+//   com IOSQE_IO_LINK; uma falha cancela o restante e o destino fica intacto);
+// - sem io_uring (kernel antigo, seccomp, outros sistemas), um pool de threads
+//   executa a mesma cadeia com chamadas síncronas.
+// Pedidos para o mesmo destino são aplicados na ordem de submissão.
+//
+// O motor não obtém as travas entre processos (tabela_manager.h): quem chama
+// decide quando o conteúdo pode ser publicado.
+//
+// O descarregador da gravação adiada (tabela_manager.h) é o cliente do motor:
+// com a trava exclusiva do CSV obtida, entrega a imagem da tabela formatada em
+// memória e só solta a trava quando a conclusão chega. As demais gravações
+// (modo síncrono, transações) continuam com stdio + fsync + rename.
+
+#define PERSISTENCIA_AUTOMATICA 0   // io_uring se disponível, senão threads
+#define PERSISTENCIA_URING 1
+#define PERSISTENCIA_THREADS 2
+
+// Resultado de um pedido concluído
+typedef struct {
+    uint64_t ticket;
+    int resultado;             // 0 = gravado e durável; < 0 = -errno
+    void *contexto;            // Valor informado na submissão
+} ConclusaoGravacao;
+
+// Fila de conclusões de um chamador (ex.: uma thread de atendimento)
+typedef struct {
+    pthread_mutex_t trava;
+    pthread_cond_t sinal;
+    ConclusaoGravacao *itens;
+    int inicio;
+    int quantidade;
+    int capacidade;
+} FilaConclusoes;
+
+// Função para iniciar o motor (modo PERSISTENCIA_*)
+// Retorna: modo efetivamente em uso ou 0 se erro
+int iniciarPersistencia(int modo);
+
+// Função para encerrar o motor: espera os pedidos pendentes e libera recursos
+void encerrarPersistencia(void);
+
+// Função para consultar o backend ativo ("io_uring", "threads" ou "inativo")
+const char* backendPersistencia(void);
+
+// Função para pedir a gravação de "conteudo" em "arquivo"
+// O motor assume o buffer (alocado com malloc) e o libera ao concluir.
+// Se "fila" não for NULL, a conclusão é entregue nela.
+// Retorna: ticket do pedido (> 0) ou 0 se não foi aceito (buffer liberado)
+uint64_t submeterGravacao(const char *arquivo, char *conteudo, size_t tamanho,
+                          FilaConclusoes *fila, void *contexto);
+
+// Função para esperar todos os pedidos submetidos até agora
+void aguardarTodasGravacoes(void);
+
+// ========== FILA DE CONCLUSÕES ==========
+
+void inicializarFilaConclusoes(FilaConclusoes *fila);
+void destruirFilaConclusoes(FilaConclusoes *fila);
+
+// Função para retirar uma conclusão, esperando se a fila estiver vazia
+void aguardarConclusao(FilaConclusoes *fila, ConclusaoGravacao *destino);
+
+// Função para retirar até "max" conclusões sem esperar
+// Retorna: quantidade retirada
+int colherConclusoes(FilaConclusoes *fila, ConclusaoGravacao *destino, int max);
+
+#endif
@@ -0,0 +1,821 @@
+// Módulo de extensão CPython "pim_nativo"
+// Expõe os gerenciadores C ao front end Python: as listagens devolvem visões
+// de sequência sobre cópias compactas das tabelas em memória (ou sobre o
+// snapshot imutável, no caso das aulas); cada linha só vira dict quando é
+// acessada. Compilar com "make modulo-python".
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#define chdir _chdir
+#else
+#include <unistd.h>
+#endif
+
+#include "structs.h"
+#include "aluno_manager.h"
+#include "turma_manager.h"
+#include "aula_manager.h"
+#include "atividade_manager.h"
+#include "usuario_manager.h"
+#include "agregado_manager.h"
+#include "assinatura_manager.h"
+
+// ========== CONVERSÃO DE REGISTROS ==========
+//
+// As chaves e os valores (sempre str) seguem os cabeçalhos dos CSVs, para que
+// as linhas sejam intercambiáveis com as de csv.DictReader no front end.
+
+static PyObject* texto(const char *valor) {
+    return PyUnicode_DecodeUTF8(valor, (Py_ssize_t)strlen(valor), "replace");
+}
+
+static PyObject* inteiro(int valor) {
+    return PyUnicode_FromFormat("%d", valor);
+}
+
+static PyObject* alunoParaDict(const void *registro) {
+    const Aluno *a = registro;
+    return Py_BuildValue("{s:N,s:N,s:N,s:N}",
+                         "RA", inteiro(a->ra), "Nome", texto(a->nome),
+                         "Email", texto(a->email), "Ativo", inteiro(a->ativo));
+}
+
+static PyObject* turmaParaDict(const void *registro) {
+    const Turma *t = registro;
+    return Py_BuildValue("{s:N,s:N,s:N,s:N,s:N}",
+                         "ID", inteiro(t->id), "Nome", texto(t->nome),
+                         "Professor", texto(t->professor), "Ano", inteiro(t->ano),
+                         "Semestre", inteiro(t->semestre));
+}
+
+static PyObject* aulaParaDict(const void *registro) {
+    const Aula *a = registro;
+    return Py_BuildValue("{s:N,s:N,s:N,s:N}",
+                         "ID", inteiro(a->id), "ID_Turma", inteiro(a->id_turma),
+                         "Data", texto(a->data), "Conteudo", texto(a->conteudo));
+}
+
+static PyObject* atividadeParaDict(const void *registro) {
+    const Atividade *a = registro;
+    return Py_BuildValue("{s:N,s:N,s:N,s:N,s:N}",
+                         "ID", inteiro(a->id), "ID_Turma", inteiro(a->id_turma),
+                         "Titulo", texto(a->titulo), "Descricao", texto(a->descricao),
+                         "Arquivo", texto(a->path_arquivo));
+}
+
+static PyObject* usuarioParaDict(const void *registro) {
+    const Usuario *u = registro;
+    return Py_BuildValue("{s:N,s:N,s:N,s:N,s:N}",
+                         "ID", inteiro(u->id), "Login", texto(u->login),
+                         "Senha", texto(u->senha), "Tipo", texto(u->tipo),
+                         "Ativo", inteiro(u->ativo));
+}
+
+// ========== TIPO Tabela (VISÃO DE SEQUÊNCIA) ==========
+
+typedef PyObject* (*ConverterRegistro)(const void *registro);
+
+typedef struct {
+    PyObject_HEAD
+    void *dados;               // Cópia compacta dos registros (NULL se snapshot)
+    Snapshot *snapshot;        // Snapshot adquirido (aulas), liberado no dealloc
+    Py_ssize_t total;
+    size_t tam_registro;
+    ConverterRegistro converter;
+} TabelaObjeto;
+
+static void tabelaDealloc(TabelaObjeto *self) {
+    free(self->dados);
+    liberarSnapshot(self->snapshot);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static Py_ssize_t tabelaTamanho(TabelaObjeto *self) {
+    return self->total;
+}
+
+static PyObject* tabelaItem(TabelaObjeto *self, Py_ssize_t indice) {
+    const void *registro;
+
+    if (indice < 0 || indice >= self->total) {
+        PyErr_SetString(PyExc_IndexError, "indice fora da tabela");
+        return NULL;
+    }
+
+    if (self->snapshot != NULL) {
+        registro = registroSnapshot(self->snapshot, (int)indice);
+    } else {
+        registro = (const unsigned char *)self->dados + (size_t)indice * self->tam_registro;
+    }
+    return self->converter(registro);
+}
+
+static PySequenceMethods tabelaSequencia = {
+    .sq_length = (lenfunc)tabelaTamanho,
+    .sq_item = (ssizeargfunc)tabelaItem,
+};
+
+static PyTypeObject TabelaTipo = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "pim_nativo.Tabela",
+    .tp_doc = "Visao somente leitura de uma tabela; cada item e um dict com as colunas do CSV.",
+    .tp_basicsize = sizeof(TabelaObjeto),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_dealloc = (destructor)tabelaDealloc,
+    .tp_as_sequence = &tabelaSequencia,
+};
+
+// Cria uma visão que assume a posse de "dados" (alocado com malloc)
+static PyObject* novaTabela(void *dados, int total, size_t tam_registro,
+                            ConverterRegistro converter) {
+    TabelaObjeto *tabela = PyObject_New(TabelaObjeto, &TabelaTipo);
+    if (tabela == NULL) {
+        free(dados);
+        return NULL;
+    }
+
+    tabela->dados = dados;
+    tabela->snapshot = NULL;
+    tabela->total = total;
+    tabela->tam_registro = tam_registro;
+    tabela->converter = converter;
+    return (PyObject *)tabela;
+}
+
+// ========== LISTAGENS ==========
+
+// Copia a tabela com o GIL liberado e devolve a visão ajustada ao total lido
+#define LISTAR_TABELA(tipo, maximo, listar, converter)                      \
+    do {                                                                    \
+        tipo *dados = malloc(sizeof(tipo) * (maximo));                      \
+        int total;                                                          \
+        if (dados == NULL) {                                                \
+            return PyErr_NoMemory();                                        \
+        }                                                                   \
+        Py_BEGIN_ALLOW_THREADS                                              \
+        total = listar(dados, (maximo));                                    \
+        Py_END_ALLOW_THREADS                                                \
+        if (total < (maximo)) {                                             \
+            tipo *ajustado = realloc(dados, sizeof(tipo) * (total > 0 ? total : 1)); \
+            dados = ajustado ? ajustado : dados;                            \
+        }                                                                   \
+        return novaTabela(dados, total, sizeof(tipo), converter);           \
+    } while (0)
+
+static PyObject* py_listarAlunos(PyObject *self, PyObject *args) {
+    (void)self; (void)args;
+    LISTAR_TABELA(Aluno, MAX_ALUNOS, listarAlunos, alunoParaDict);
+}
+
+static PyObject* py_listarTurmas(PyObject *self, PyObject *args) {
+    (void)self; (void)args;
+    LISTAR_TABELA(Turma, MAX_TURMAS, listarTurmas, turmaParaDict);
+}
+
+static PyObject* py_listarAtividades(PyObject *self, PyObject *args) {
+    (void)self; (void)args;
+    LISTAR_TABELA(Atividade, MAX_ATIVIDADES, listarAtividades, atividadeParaDict);
+}
+
+static PyObject* py_listarUsuarios(PyObject *self, PyObject *args) {
+    (void)self; (void)args;
+    LISTAR_TABELA(Usuario, MAX_USUARIOS, listarUsuarios, usuarioParaDict);
+}
+
+// Aulas: a visão segura o snapshot imutável, sem nenhuma cópia
+static PyObject* py_listarAulas(PyObject *self, PyObject *args) {
+    Snapshot *snapshot;
+    TabelaObjeto *tabela;
+    (void)self; (void)args;
+
+    Py_BEGIN_ALLOW_THREADS
+    snapshot = adquirirSnapshotAulas();
+    Py_END_ALLOW_THREADS
+
+    tabela = (TabelaObjeto *)novaTabela(NULL, 0, sizeof(Aula), aulaParaDict);
+    if (tabela == NULL) {
+        liberarSnapshot(snapshot);
+        return NULL;
+    }
+    tabela->snapshot = snapshot;
+    tabela->total = snapshot ? snapshot->total_registros : 0;
+    return (PyObject *)tabela;
+}
+
+static PyObject* py_listarAulasDaTurma(PyObject *self, PyObject *args) {
+    int id_turma;
+    (void)self;
+
+    if (!PyArg_ParseTuple(args, "i", &id_turma)) {
+        return NULL;
+    }
+
+    Aula *dados = malloc(sizeof(Aula) * MAX_AULAS);
+    int total;
+    if (dados == NULL) {
+        return PyErr_NoMemory();
+    }
+    Py_BEGIN_ALLOW_THREADS
+    total = listarAulasDaTurma(id_turma, dados, MAX_AULAS);
+    Py_END_ALLOW_THREADS
+    return novaTabela(dados, total, sizeof(Aula), aulaParaDict);
+}
+
+static PyObject* py_listarAlunosDaTurma(PyObject *self, PyObject *args) {
+    static int ras[MAX_ALUNOS];
+    int id_turma;
+    int total;
+    (void)self;
+
+    if (!PyArg_ParseTuple(args, "i", &id_turma)) {
+        return NULL;
+    }
+
+    // O GIL serializa o uso do buffer estático
+    total = listarAlunosDaTurma(id_turma, ras, MAX_ALUNOS);
+
+    PyObject *lista = PyList_New(total);
+    if (lista == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < total; i++) {
+        PyList_SET_ITEM(lista, i, PyLong_FromLong(ras[i]));
+    }
+    return lista;
+}
+
+// Alunos da turma já juntados ao cadastro, numa visão como a de listar_alunos
+static PyObject* py_listarAlunosDaTurmaDetalhado(PyObject *self, PyObject *args, PyObject *kwargs) {
+    static char *chaves[] = {"id_turma", "apenas_ativos", NULL};
+    int id_turma, apenas_ativos = 0;
+    (void)self;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "i|p", chaves, &id_turma, &apenas_ativos)) {
+        return NULL;
+    }
+    Aluno *dados = malloc(sizeof(Aluno) * MAX_ALUNOS);
+    int total;
+    if (dados == NULL) {
+        return PyErr_NoMemory();
+    }
+    Py_BEGIN_ALLOW_THREADS
+    total = listarAlunosDaTurmaDetalhado(id_turma, apenas_ativos, dados, MAX_ALUNOS);
+    Py_END_ALLOW_THREADS
+    return novaTabela(dados, total, sizeof(Aluno), alunoParaDict);
+}
+
+// ========== BUSCAS (CÓPIA, SEGURAS ENTRE THREADS) ==========
+
+static PyObject* py_buscarAluno(PyObject *self, PyObject *args) {
+    Aluno aluno;
+    int ra, achou;
+    (void)self;
+
+    if (!PyArg_ParseTuple(args, "i", &ra)) {
+        return NULL;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    achou = obterAlunoPorRA(ra, &aluno);
+    Py_END_ALLOW_THREADS
+    if (!achou) {
+        Py_RETURN_NONE;
+    }
+    return alunoParaDict(&aluno);
+}
+
+static PyObject* py_buscarTurma(PyObject *self, PyObject *args) {
+    Turma turma;
+    int id, achou;
+    (void)self;
+
+    if (!PyArg_ParseTuple(args, "i", &id)) {
+        return NULL;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    achou = obterTurmaPorID(id, &turma);
+    Py_END_ALLOW_THREADS
+    if (!achou) {
+        Py_RETURN_NONE;
+    }
+    return turmaParaDict(&turma);
+}
+
+static PyObject* py_buscarAula(PyObject *self, PyObject *args) {
+    Aula aula;
+    int id, achou;
+    (void)self;
+
+    if (!PyArg_ParseTuple(args, "i", &id)) {
+        return NULL;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    achou = obterAulaPorID(id, &aula);
+    Py_END_ALLOW_THREADS
+    if (!achou) {
+        Py_RETURN_NONE;
+    }
+    return aulaParaDict(&aula);
+}
+
+static PyObject* py_buscarAtividade(PyObject *self, PyObject *args) {
+    Atividade atividade;
+    int id, achou;
+    (void)self;
+
+    if (!PyArg_ParseTuple(args, "i", &id)) {
+        return NULL;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    achou = obterAtividadePorID(id, &atividade);
+    Py_END_ALLOW_THREADS
+    if (!achou) {
+        Py_RETURN_NONE;
+    }
+    return atividadeParaDict(&atividade);
+}
+
+static PyObject* py_buscarUsuario(PyObject *self, PyObject *args) {
+    Usuario usuario;
+    const char *login;
+    int achou;
+    (void)self;
+
+    if (!PyArg_ParseTuple(args, "s", &login)) {
+        return NULL;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    achou = obterUsuarioPorLogin(login, &usuario);
+    Py_END_ALLOW_THREADS
+    if (!achou) {
+        Py_RETURN_NONE;
+    }
+    return usuarioParaDict(&usuario);
+}
+
+// ========== CONTAGENS ==========
+
+static PyObject* py_contarAlunos(PyObject *self, PyObject *args, PyObject *kwargs) {
+    static char *chaves[] = {"apenas_ativos", NULL};
+    int apenas_ativos = 0;
+    int total;
+    (void)self;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|p", chaves, &apenas_ativos)) {
+        return NULL;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    total = contarAlunos(apenas_ativos);
+    Py_END_ALLOW_THREADS
+    return PyLong_FromLong(total);
+}
+
+static PyObject* py_contarTurmas(PyObject *self, PyObject *args, PyObject *kwargs) {
+    static char *chaves[] = {"professor", "ano", "semestre", NULL};
+    const char *professor = NULL;
+    int ano = 0, semestre = 0;
+    int total;
+    (void)self;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|zii", chaves, &professor, &ano, &semestre)) {
+        return NULL;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    total = contarTurmasPor(professor, ano, semestre);
+    Py_END_ALLOW_THREADS
+    return PyLong_FromLong(total);
+}
+
+static PyObject* py_contarAulas(PyObject *self, PyObject *args) {
+    int total;
+    (void)self; (void)args;
+
+    Py_BEGIN_ALLOW_THREADS
+    total = contarAulas();
+    Py_END_ALLOW_THREADS
+    return PyLong_FromLong(total);
+}
+
+static PyObject* py_contarAtividades(PyObject *self, PyObject *args) {
+    int total;
+    (void)self; (void)args;
+
+    Py_BEGIN_ALLOW_THREADS
+    total = contarAtividades();
+    Py_END_ALLOW_THREADS
+    return PyLong_FromLong(total);
+}
+
+static PyObject* py_agregadoTurma(PyObject *self, PyObject *args) {
+    int id_turma;
+    AgregadoTurma agregado;
+    (void)self;
+
+    if (!PyArg_ParseTuple(args, "i", &id_turma)) {
+        return NULL;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    agregado.alunos = contarAlunosDaTurma(id_turma, 0);
+    agregado.alunos_ativos = contarAlunosDaTurma(id_turma, 1);
+    agregado.aulas = contarAulasDaTurma(id_turma);
+    agregado.atividades = contarAtividadesDaTurma(id_turma);
+    Py_END_ALLOW_THREADS
+    return Py_BuildValue("{s:i,s:i,s:i,s:i}",
+                         "alunos", agregado.alunos,
+                         "alunos_ativos", agregado.alunos_ativos,
+                         "aulas", agregado.aulas,
+                         "atividades", agregado.atividades);
+}
+
+static PyObject* py_contarAulasDaTurma(PyObject *self, PyObject *args) {
+    int id_turma, total;
+    (void)self;
+
+    if (!PyArg_ParseTuple(args, "i", &id_turma)) {
+        return NULL;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    total = contarAulasDaTurma(id_turma);
+    Py_END_ALLOW_THREADS
+    return PyLong_FromLong(total);
+}
+
+// ========== CADASTROS ==========
+//
+// IDs omitidos (0) são gerados pelo gerenciador. Retornam o ID/RA gravado ou
+// levantam ValueError quando o gerenciador recusa o registro.
+
+static void copiarTexto(char *destino, size_t tamanho, const char *origem) {
+    strncpy(destino, origem, tamanho - 1);
+    destino[tamanho - 1] = '\0';
+}
+
+static PyObject* resultadoCadastro(int ok, int id, const char *tabela) {
+    if (!ok) {
+        PyErr_Format(PyExc_ValueError, "cadastro recusado em %s", tabela);
+        return NULL;
+    }
+    return PyLong_FromLong(id);
+}
+
+static PyObject* py_cadastrarAluno(PyObject *self, PyObject *args, PyObject *kwargs) {
+    static char *chaves[] = {"ra", "nome", "email", "ativo", NULL};
+    Aluno aluno;
+    const char *nome, *email;
+    int ok;
+    (void)self;
+
+    memset(&aluno, 0, sizeof(aluno));
+    aluno.ativo = 1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "iss|p", chaves,
+                                     &aluno.ra, &nome, &email, &aluno.ativo)) {
+        return NULL;
+    }
+    copiarTexto(aluno.nome, sizeof(aluno.nome), nome);
+    copiarTexto(aluno.email, sizeof(aluno.email), email);
+
+    Py_BEGIN_ALLOW_THREADS
+    ok = cadastrarAluno(&aluno);
+    Py_END_ALLOW_THREADS
+    return resultadoCadastro(ok, aluno.ra, "alunos");
+}
+
+static PyObject* py_cadastrarTurma(PyObject *self, PyObject *args, PyObject *kwargs) {
+    static char *chaves[] = {"nome", "professor", "ano", "semestre", "id", NULL};
+    Turma turma;
+    const char *nome, *professor;
+    int ok;
+    (void)self;
+
+    memset(&turma, 0, sizeof(turma));
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ssii|i", chaves, &nome, &professor,
+                                     &turma.ano, &turma.semestre, &turma.id)) {
+        return NULL;
+    }
+    copiarTexto(turma.nome, sizeof(turma.nome), nome);
+    copiarTexto(turma.professor, sizeof(turma.professor), professor);
+
+    Py_BEGIN_ALLOW_THREADS
+    if (turma.id == 0) {
+        turma.id = gerarProximoIDTurma();
+    }
+    ok = cadastrarTurma(&turma);
+    Py_END_ALLOW_THREADS
+    return resultadoCadastro(ok, turma.id, "turmas");
+}
+
+static PyObject* py_registrarAula(PyObject *self, PyObject *args, PyObject *kwargs) {
+    static char *chaves[] = {"id_turma", "data", "conteudo", "id", NULL};
+    Aula aula;
+    const char *data, *conteudo;
+    int ok;
+    (void)self;
+
+    memset(&aula, 0, sizeof(aula));
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "iss|i", chaves, &aula.id_turma,
+                                     &data, &conteudo, &aula.id)) {
+        return NULL;
+    }
+    copiarTexto(aula.data, sizeof(aula.data), data);
+    copiarTexto(aula.conteudo, sizeof(aula.conteudo), conteudo);
+
+    Py_BEGIN_ALLOW_THREADS
+    if (aula.id == 0) {
+        aula.id = gerarProximoIDAula();
+    }
+    ok = registrarAula(&aula);
+    Py_END_ALLOW_THREADS
+    return resultadoCadastro(ok, aula.id, "aulas");
+}
+
+static PyObject* py_cadastrarAtividade(PyObject *self, PyObject *args, PyObject *kwargs) {
+    static char *chaves[] = {"id_turma", "titulo", "descricao", "arquivo", "id", NULL};
+    Atividade atividade;
+    const char *titulo, *descricao = "", *arquivo = "";
+    int ok;
+    (void)self;
+
+    memset(&atividade, 0, sizeof(atividade));
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "is|ssi", chaves, &atividade.id_turma,
+                                     &titulo, &descricao, &arquivo, &atividade.id)) {
+        return NULL;
+    }
+    copiarTexto(atividade.titulo, sizeof(atividade.titulo), titulo);
+    copiarTexto(atividade.descricao, sizeof(atividade.descricao), descricao);
+    copiarTexto(atividade.path_arquivo, sizeof(atividade.path_arquivo), arquivo);
+
+    Py_BEGIN_ALLOW_THREADS
+    if (atividade.id == 0) {
+        atividade.id = gerarProximoIDAtividade();
+    }
+    ok = cadastrarAtividade(&atividade);
+    Py_END_ALLOW_THREADS
+    return resultadoCadastro(ok, atividade.id, "atividades");
+}
+
+static PyObject* py_cadastrarUsuario(PyObject *self, PyObject *args, PyObject *kwargs) {
+    static char *chaves[] = {"login", "senha", "tipo", NULL};
+    Usuario usuario;
+    const char *login, *senha, *tipo;
+    int ok;
+    (void)self;
+
+    memset(&usuario, 0, sizeof(usuario));
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "sss", chaves, &login, &senha, &tipo)) {
+        return NULL;
+    }
+    copiarTexto(usuario.login, sizeof(usuario.login), login);
+    copiarTexto(usuario.senha, sizeof(usuario.senha), senha);
+    copiarTexto(usuario.tipo, sizeof(usuario.tipo), tipo);
+    usuario.ativo = 1;
+
+    Py_BEGIN_ALLOW_THREADS
+    usuario.id = gerarProximoIDUsuario();
+    ok = cadastrarUsuario(&usuario);
+    Py_END_ALLOW_THREADS
+    return resultadoCadastro(ok, usuario.id, "usuarios");
+}
+
+// ========== TIPO Assinatura (ALTERAÇÕES POR TABELA) ==========
+//
+// Assinatura(tabelas=None, desde=-1): eventos do registro de alterações de
+// data/ (assinatura_manager.h) a partir da sequência "desde" (-1 = só os
+// novos). ler(maximo=500, espera_ms=0) devolve uma lista de tuplas
+// (sequencia, tabela, operacao, linha), com operacao "I", "U", "D" ou "L"
+// (recarregar a tabela) e a linha do CSV; "sequencia" é de onde retomar.
+
+typedef struct {
+    PyObject_HEAD
+    AssinaturaAlteracoes assinatura;
+    LoteAlteracoes lote;
+    int aberta;
+} AssinaturaObjeto;
+
+static void assinaturaDealloc(AssinaturaObjeto *self) {
+    if (self->aberta) {
+        fecharAssinaturaAlteracoes(&self->assinatura);
+    }
+    liberarLoteAlteracoes(&self->lote);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static int assinaturaInit(AssinaturaObjeto *self, PyObject *args, PyObject *kwargs) {
+    static char *chaves[] = {"tabelas", "desde", NULL};
+    const char *nomes[TOTAL_TABELAS_ASSINATURA];
+    PyObject *tabelas = Py_None;
+    PyObject *sequencia = NULL;
+    long long desde = ASSINATURA_DO_FIM;
+    int total = 0;
+    int ok;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OL", chaves, &tabelas, &desde)) {
+        return -1;
+    }
+    if (tabelas != Py_None) {
+        sequencia = PySequence_Fast(tabelas, "tabelas deve ser uma sequencia de nomes de CSV");
+        if (sequencia == NULL) {
+            return -1;
+        }
+        Py_ssize_t tamanho = PySequence_Fast_GET_SIZE(sequencia);
+        if (tamanho > TOTAL_TABELAS_ASSINATURA) {
+            Py_DECREF(sequencia);
+            PyErr_SetString(PyExc_ValueError, "tabelas repetidas ou demais");
+            return -1;
+        }
+        for (Py_ssize_t i = 0; i < tamanho; i++) {
+            nomes[i] = PyUnicode_AsUTF8(PySequence_Fast_GET_ITEM(sequencia, i));
+            if (nomes[i] == NULL) {
+                Py_DECREF(sequencia);
+                return -1;
+            }
+        }
+        total = (int)tamanho;
+    }
+
+    if (self->aberta) {
+        fecharAssinaturaAlteracoes(&self->assinatura);
+        self->aberta = 0;
+    }
+    ok = abrirAssinaturaAlteracoes(&self->assinatura, "data", nomes, total, desde);
+    Py_XDECREF(sequencia);
+    if (!ok) {
+        PyErr_SetString(PyExc_ValueError, "tabela sem registro de alteracoes");
+        return -1;
+    }
+    self->aberta = 1;
+    return 0;
+}
+
+static PyObject* assinaturaLer(AssinaturaObjeto *self, PyObject *args, PyObject *kwargs) {
+    static char *chaves[] = {"maximo", "espera_ms", NULL};
+    long maximo = 500;
+    int espera_ms = 0;
+    long total;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|li", chaves, &maximo, &espera_ms)) {
+        return NULL;
+    }
+    if (!self->aberta) {
+        PyErr_SetString(PyExc_ValueError, "assinatura fechada");
+        return NULL;
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    total = lerLoteAlteracoes(&self->assinatura, &self->lote, maximo, espera_ms);
+    Py_END_ALLOW_THREADS
+    if (total < 0) {
+        return PyErr_NoMemory();
+    }
+
+    PyObject *eventos = PyList_New(total);
+    for (long i = 0; eventos != NULL && i < total; i++) {
+        const EventoAlteracao *evento = &self->lote.eventos[i];
+        PyObject *item = Py_BuildValue("(LsNN)", evento->sequencia, evento->tabela,
+                                       PyUnicode_FromStringAndSize(&evento->operacao, 1),
+                                       PyUnicode_DecodeUTF8(evento->linha, (Py_ssize_t)evento->tamanho_linha,
+                                                            "replace"));
+        if (item == NULL) {
+            Py_CLEAR(eventos);
+            break;
+        }
+        PyList_SET_ITEM(eventos, i, item);
+    }
+    return eventos;
+}
+
+static PyObject* assinaturaFechar(AssinaturaObjeto *self, PyObject *args) {
+    (void)args;
+    if (self->aberta) {
+        fecharAssinaturaAlteracoes(&self->assinatura);
+        self->aberta = 0;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* assinaturaSequencia(AssinaturaObjeto *self, void *contexto) {
+    (void)contexto;
+    return PyLong_FromLongLong(self->assinatura.apos_sequencia);
+}
+
+static PyMethodDef assinaturaMetodos[] = {
+    {"ler", (PyCFunction)(void (*)(void))assinaturaLer, METH_VARARGS | METH_KEYWORDS,
+     "Proximo lote: lista de (sequencia, tabela, operacao, linha); espera ate espera_ms pelo primeiro."},
+    {"fechar", (PyCFunction)assinaturaFechar, METH_NOARGS, "Encerra a assinatura."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyGetSetDef assinaturaAtributos[] = {
+    {"sequencia", (getter)assinaturaSequencia, NULL, "Ultima sequencia entregue (retome com desde=).", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyTypeObject AssinaturaTipo = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "pim_nativo.Assinatura",
+    .tp_doc = "Assinatura(tabelas=None, desde=-1): alteracoes das tabelas de data/ em lotes.",
+    .tp_basicsize = sizeof(AssinaturaObjeto),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)assinaturaInit,
+    .tp_dealloc = (destructor)assinaturaDealloc,
+    .tp_methods = assinaturaMetodos,
+    .tp_getset = assinaturaAtributos,
+};
+
+// ========== CONFIGURAÇÃO ==========
+
+// Os gerenciadores usam caminhos relativos ("data/x.csv")
+static PyObject* py_configurar(PyObject *self, PyObject *args) {
+    const char *diretorio_base;
+    (void)self;
+
+    if (!PyArg_ParseTuple(args, "s", &diretorio_base)) {
+        return NULL;
+    }
+    if (chdir(diretorio_base) != 0) {
+        return PyErr_SetFromErrnoWithFilename(PyExc_OSError, diretorio_base);
+    }
+    Py_RETURN_NONE;
+}
+
+// ========== REGISTRO DO MÓDULO ==========
+
+static PyMethodDef metodos[] = {
+    {"configurar", py_configurar, METH_VARARGS, "Define o diretorio que contem a pasta data/."},
+    {"listar_alunos", py_listarAlunos, METH_NOARGS, "Visao de todos os alunos."},
+    {"listar_turmas", py_listarTurmas, METH_NOARGS, "Visao de todas as turmas."},
+    {"listar_aulas", py_listarAulas, METH_NOARGS, "Visao do snapshot atual das aulas."},
+    {"listar_aulas_da_turma", py_listarAulasDaTurma, METH_VARARGS, "Visao das aulas de uma turma."},
+    {"listar_atividades", py_listarAtividades, METH_NOARGS, "Visao de todas as atividades."},
+    {"listar_usuarios", py_listarUsuarios, METH_NOARGS, "Visao de todos os usuarios."},
+    {"listar_alunos_da_turma", py_listarAlunosDaTurma, METH_VARARGS, "Lista de RAs matriculados."},
+    {"listar_alunos_da_turma_detalhado", (PyCFunction)(void (*)(void))py_listarAlunosDaTurmaDetalhado,
+     METH_VARARGS | METH_KEYWORDS,
+     "Visao dos alunos da turma com o cadastro (apenas_ativos=True filtra; Ativo -1 = RA sem cadastro)."},
+    {"buscar_aluno", py_buscarAluno, METH_VARARGS, "Dict do aluno ou None."},
+    {"buscar_turma", py_buscarTurma, METH_VARARGS, "Dict da turma ou None."},
+    {"buscar_aula", py_buscarAula, METH_VARARGS, "Dict da aula ou None."},
+    {"buscar_atividade", py_buscarAtividade, METH_VARARGS, "Dict da atividade ou None."},
+    {"buscar_usuario", py_buscarUsuario, METH_VARARGS, "Dict do usuario (por login) ou None."},
+    {"contar_alunos", (PyCFunction)(void (*)(void))py_contarAlunos, METH_VARARGS | METH_KEYWORDS,
+     "Total de alunos (apenas_ativos=True conta so os ativos)."},
+    {"contar_aulas", py_contarAulas, METH_NOARGS, "Total de aulas registradas."},
+    {"contar_aulas_da_turma", py_contarAulasDaTurma, METH_VARARGS, "Total de aulas de uma turma."},
+    {"contar_turmas", (PyCFunction)(void (*)(void))py_contarTurmas, METH_VARARGS | METH_KEYWORDS,
+     "Total de turmas (professor/ano/semestre opcionais filtram)."},
+    {"contar_atividades", py_contarAtividades, METH_NOARGS, "Total de atividades."},
+    {"agregado_turma", py_agregadoTurma, METH_VARARGS,
+     "Dict com alunos, alunos_ativos, aulas e atividades de uma turma."},
+    {"cadastrar_aluno", (PyCFunction)(void (*)(void))py_cadastrarAluno, METH_VARARGS | METH_KEYWORDS,
+     "Cadastra aluno(ra, nome, email, ativo=True); retorna o RA."},
+    {"cadastrar_turma", (PyCFunction)(void (*)(void))py_cadastrarTurma, METH_VARARGS | METH_KEYWORDS,
+     "Cadastra turma(nome, professor, ano, semestre, id=0); retorna o ID."},
+    {"registrar_aula", (PyCFunction)(void (*)(void))py_registrarAula, METH_VARARGS | METH_KEYWORDS,
+     "Registra aula(id_turma, data, conteudo, id=0); retorna o ID."},
+    {"cadastrar_atividade", (PyCFunction)(void (*)(void))py_cadastrarAtividade, METH_VARARGS | METH_KEYWORDS,
+     "Cadastra atividade(id_turma, titulo, descricao='', arquivo='', id=0); retorna o ID."},
+    {"cadastrar_usuario", (PyCFunction)(void (*)(void))py_cadastrarUsuario, METH_VARARGS | METH_KEYWORDS,
+     "Cadastra usuario(login, senha, tipo); retorna o ID."},
+    {NULL, NULL, 0, NULL}
+};
+
+static struct PyModuleDef modulo = {
+    PyModuleDef_HEAD_INIT,
+    "pim_nativo",
+    "Acesso direto as tabelas em memoria dos modulos C do PIM 2025.",
+    -1,
+    metodos,
+    NULL, NULL, NULL, NULL
+};
+
+PyMODINIT_FUNC PyInit_pim_nativo(void) {
+    PyObject *m;
+
+    if (PyType_Ready(&TabelaTipo) < 0 || PyType_Ready(&AssinaturaTipo) < 0) {
+        return NULL;
+    }
+
+    m = PyModule_Create(&modulo);
+    if (m == NULL) {
+        return NULL;
+    }
+
+    Py_INCREF(&TabelaTipo);
+    if (PyModule_AddObject(m, "Tabela", (PyObject *)&TabelaTipo) < 0) {
+        Py_DECREF(&TabelaTipo);
+        Py_DECREF(m);
+        return NULL;
+    }
+    Py_INCREF(&AssinaturaTipo);
+    if (PyModule_AddObject(m, "Assinatura", (PyObject *)&AssinaturaTipo) < 0) {
+        Py_DECREF(&AssinaturaTipo);
+        Py_DECREF(m);
+        return NULL;
+    }
+    return m;
+}
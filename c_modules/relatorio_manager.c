@@ -0,0 +1,518 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <pthread.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "relatorio_manager.h"
+#include "turma_manager.h"
+#include "aula_manager.h"
+#include "snapshot_manager.h"
+#include "tabela_manager.h"
+
+#ifdef _WIN32
+#include <direct.h>
+#define criarDiretorio(caminho) _mkdir(caminho)
+#else
+#define criarDiretorio(caminho) mkdir((caminho), 0755)
+#endif
+
+#define CAPACIDADE_INICIAL_RELATORIO 4096
+#define VERSAO_FORMATO_RELATORIO 1      // Mudou o texto? Incrementar invalida todas as versões
+
+static const char LINHA_DUPLA[] = "========================================\n";
+static const char LINHA_SIMPLES[] = "----------------------------------------\n\n";
+
+// ========== ESTRUTURAS INTERNAS ==========
+
+// Turma com a posição original (para ordenar por id sem perder a ordem da listagem)
+typedef struct {
+    int id;
+    int posicao;
+} ChaveTurma;
+
+// Linha de ARQUIVO_VERSOES_RELATORIOS
+typedef struct {
+    int id_turma;
+    uint64_t versao;                // Hash do conteúdo da turma
+    long long tamanho;              // Tamanho do arquivo gravado
+} VersaoRelatorio;
+
+// Estado compartilhado por todas as threads do lote (somente leitura, exceto
+// "proxima"; cada thread só escreve nas posições das turmas que pegou)
+typedef struct {
+    const char *diretorio;
+    int so_desatualizados;
+    const VersaoRelatorio *anteriores;  // Ordenadas por id_turma
+    int total_anteriores;
+    VersaoRelatorio *atuais;            // Uma por turma, na ordem da listagem
+    const Turma *turmas;
+    int total_turmas;
+    const Aula **aulas_agrupadas;   // Aulas em ordem de turma
+    const int *inicio_turma;        // Faixa [inicio_turma[i], inicio_turma[i + 1])
+    TempoRelatorio *tempos;
+    _Atomic int proxima;
+} LoteRelatorios;
+
+// ========== FUNÇÕES AUXILIARES PRIVADAS ==========
+
+static double agoraSegundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int nucleosDisponiveis(void) {
+#ifdef _SC_NPROCESSORS_ONLN
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n < 1) ? 1 : (int)n;
+#else
+    return 1;
+#endif
+}
+
+static int garantirEspaco(BufferRelatorio *buffer, size_t extra) {
+    if (buffer->usados + extra <= buffer->capacidade) {
+        return 1;
+    }
+    size_t nova = buffer->capacidade ? buffer->capacidade : CAPACIDADE_INICIAL_RELATORIO;
+    while (nova < buffer->usados + extra) {
+        nova *= 2;
+    }
+    char *dados = realloc(buffer->dados, nova);
+    if (dados == NULL) {
+        return 0;
+    }
+    buffer->dados = dados;
+    buffer->capacidade = nova;
+    return 1;
+}
+
+static void anexarTexto(BufferRelatorio *buffer, const char *texto, size_t tamanho) {
+    memcpy(buffer->dados + buffer->usados, texto, tamanho);
+    buffer->usados += tamanho;
+}
+
+static int compararChaveTurma(const void *a, const void *b) {
+    const ChaveTurma *x = (const ChaveTurma *)a;
+    const ChaveTurma *y = (const ChaveTurma *)b;
+    return (x->id > y->id) - (x->id < y->id);
+}
+
+// Posição (na listagem) da turma com o id, ou -1
+static int localizarTurma(const ChaveTurma *chaves, int total, int id) {
+    int inicio = 0, fim = total - 1;
+    while (inicio <= fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        if (chaves[meio].id == id) {
+            return chaves[meio].posicao;
+        }
+        if (chaves[meio].id < id) {
+            inicio = meio + 1;
+        } else {
+            fim = meio - 1;
+        }
+    }
+    return -1;
+}
+
+static int compararVersaoRelatorio(const void *a, const void *b) {
+    const VersaoRelatorio *x = (const VersaoRelatorio *)a;
+    const VersaoRelatorio *y = (const VersaoRelatorio *)b;
+    return (x->id_turma > y->id_turma) - (x->id_turma < y->id_turma);
+}
+
+static const VersaoRelatorio* buscarVersao(const VersaoRelatorio *versoes, int total, int id_turma) {
+    VersaoRelatorio chave;
+    chave.id_turma = id_turma;
+    return bsearch(&chave, versoes, (size_t)total, sizeof(VersaoRelatorio), compararVersaoRelatorio);
+}
+
+// Hash de tudo o que entra no texto do relatório: FNV-1a de 64 bits aplicado
+// a palavras de 8 bytes (o conteúdo das aulas domina o custo do lote)
+static uint64_t hashTexto(uint64_t h, const char *texto) {
+    size_t tamanho = strlen(texto);
+    const char *p = texto;
+
+    for (; tamanho >= 8; p += 8, tamanho -= 8) {
+        uint64_t palavra;
+        memcpy(&palavra, p, sizeof(palavra));
+        h = (h ^ palavra) * 1099511628211ULL;
+        h ^= h >> 32;
+    }
+    for (; tamanho > 0; p++, tamanho--) {
+        h = (h ^ (unsigned char)*p) * 1099511628211ULL;
+    }
+    return (h ^ 0xffu) * 1099511628211ULL;     // Separador entre campos
+}
+
+static uint64_t versaoConteudo(int id_turma, const Aula *const *aulas, int total) {
+    uint64_t h = 1469598103934665603ULL;
+    char numero[32];
+
+    snprintf(numero, sizeof(numero), "%d:%d", VERSAO_FORMATO_RELATORIO, id_turma);
+    h = hashTexto(h, numero);
+    for (int i = 0; i < total; i++) {
+        h = hashTexto(h, aulas[i]->data);
+        h = hashTexto(h, aulas[i]->conteudo);
+    }
+    return h;
+}
+
+static long long tamanhoArquivo(const char *caminho) {
+    struct stat info;
+    return (stat(caminho, &info) == 0) ? (long long)info.st_size : -1;
+}
+
+// Lê as versões gravadas no último lote (vetor vazio se o arquivo não existe)
+static VersaoRelatorio* carregarVersoes(const char *arquivo, int *total) {
+    VersaoRelatorio *versoes = NULL;
+    int capacidade = 0;
+    char linha[128];
+
+    *total = 0;
+    FILE *entrada = fopen(arquivo, "r");
+    if (entrada == NULL) {
+        return NULL;
+    }
+    while (fgets(linha, sizeof(linha), entrada) != NULL) {
+        VersaoRelatorio v;
+        unsigned long long versao;
+        if (sscanf(linha, "%d,%llx,%lld", &v.id_turma, &versao, &v.tamanho) != 3) {
+            continue;   // Cabeçalho ou linha danificada: a turma é regerada
+        }
+        v.versao = versao;
+        if (*total == capacidade) {
+            capacidade = capacidade ? capacidade * 2 : 64;
+            VersaoRelatorio *maior = realloc(versoes, sizeof(VersaoRelatorio) * (size_t)capacidade);
+            if (maior == NULL) {
+                break;
+            }
+            versoes = maior;
+        }
+        versoes[(*total)++] = v;
+    }
+    fclose(entrada);
+
+    qsort(versoes, (size_t)*total, sizeof(VersaoRelatorio), compararVersaoRelatorio);
+    return versoes;
+}
+
+static int gravarVersoes(const char *arquivo, const VersaoRelatorio *versoes, const TempoRelatorio *tempos,
+                         int total) {
+    FILE *saida = abrirEscritaAtomica(arquivo);
+    if (saida == NULL) {
+        return 0;
+    }
+    fprintf(saida, "ID_Turma,Versao,Tamanho\n");
+    for (int i = 0; i < total; i++) {
+        // Relatório que falhou fica fora: o próximo lote tenta de novo
+        if (tempos[i].ok) {
+            fprintf(saida, "%d,%016llx,%lld\n", versoes[i].id_turma,
+                    (unsigned long long)versoes[i].versao, versoes[i].tamanho);
+        }
+    }
+    return concluirEscritaAtomica(saida, arquivo);
+}
+
+// Tamanho final em *tamanho (difere de "usados" no modo texto do Windows)
+static int gravarBuffer(const BufferRelatorio *buffer, const char *arquivo_destino, long long *tamanho) {
+    FILE *arquivo = fopen(arquivo_destino, "w");
+    if (arquivo == NULL) {
+        return 0;
+    }
+    size_t gravados = fwrite(buffer->dados, 1, buffer->usados, arquivo);
+    *tamanho = ftell(arquivo);
+    int ok = (fclose(arquivo) == 0) && gravados == buffer->usados;
+    return ok;
+}
+
+static void* executarTrabalhador(void *arg) {
+    LoteRelatorios *lote = (LoteRelatorios *)arg;
+    BufferRelatorio buffer = {NULL, 0, 0};
+    char caminho[512];
+
+    for (;;) {
+        int i = atomic_fetch_add_explicit(&lote->proxima, 1, memory_order_relaxed);
+        if (i >= lote->total_turmas) {
+            break;
+        }
+
+        double inicio = agoraSegundos();
+        int primeira = lote->inicio_turma[i];
+        int total = lote->inicio_turma[i + 1] - primeira;
+        TempoRelatorio *tempo = &lote->tempos[i];
+        VersaoRelatorio *atual = &lote->atuais[i];
+
+        tempo->id_turma = lote->turmas[i].id;
+        tempo->aulas = total;
+        snprintf(caminho, sizeof(caminho), "%s/relatorio_turma_%d.txt", lote->diretorio, tempo->id_turma);
+
+        atual->id_turma = tempo->id_turma;
+        atual->versao = versaoConteudo(tempo->id_turma, lote->aulas_agrupadas + primeira, total);
+        atual->tamanho = -1;
+
+        // Em dia: mesma versão e o arquivo continua com o tamanho gravado
+        if (lote->so_desatualizados) {
+            const VersaoRelatorio *anterior = buscarVersao(lote->anteriores, lote->total_anteriores,
+                                                           tempo->id_turma);
+            if (anterior != NULL && anterior->versao == atual->versao &&
+                tamanhoArquivo(caminho) == anterior->tamanho) {
+                atual->tamanho = anterior->tamanho;
+                tempo->ok = 1;
+                tempo->reescrito = 0;
+                tempo->microssegundos = (agoraSegundos() - inicio) * 1e6;
+                continue;
+            }
+        }
+
+        limparBufferRelatorio(&buffer);
+        tempo->ok = renderizarRelatorioTurma(&buffer, tempo->id_turma, lote->aulas_agrupadas + primeira, total) &&
+                    gravarBuffer(&buffer, caminho, &atual->tamanho);
+        tempo->reescrito = tempo->ok;
+        tempo->microssegundos = (agoraSegundos() - inicio) * 1e6;
+    }
+
+    liberarBufferRelatorio(&buffer);
+    return NULL;
+}
+
+// ========== FUNÇÕES PÚBLICAS ==========
+
+void limparBufferRelatorio(BufferRelatorio *buffer) {
+    buffer->usados = 0;
+}
+
+void liberarBufferRelatorio(BufferRelatorio *buffer) {
+    free(buffer->dados);
+    buffer->dados = NULL;
+    buffer->usados = 0;
+    buffer->capacidade = 0;
+}
+
+int renderizarRelatorioTurma(BufferRelatorio *buffer, int id_turma, const Aula *const *aulas, int total) {
+    char numero[96];
+    int tam;
+
+    // Cabeçalho do relatório
+    tam = snprintf(numero, sizeof(numero), "  DIÁRIO DE CLASSE - TURMA ID %d\n", id_turma);
+    if (!garantirEspaco(buffer, 2 * (sizeof(LINHA_DUPLA) - 1) + (size_t)tam + 1)) {
+        return 0;
+    }
+    anexarTexto(buffer, LINHA_DUPLA, sizeof(LINHA_DUPLA) - 1);
+    anexarTexto(buffer, numero, (size_t)tam);
+    anexarTexto(buffer, LINHA_DUPLA, sizeof(LINHA_DUPLA) - 1);
+    anexarTexto(buffer, "\n", 1);
+
+    for (int i = 0; i < total; i++) {
+        size_t tam_data = strlen(aulas[i]->data);
+        size_t tam_conteudo = strlen(aulas[i]->conteudo);
+
+        if (!garantirEspaco(buffer, tam_data + tam_conteudo + 32 + sizeof(LINHA_SIMPLES))) {
+            return 0;
+        }
+        anexarTexto(buffer, "Data: ", 6);
+        anexarTexto(buffer, aulas[i]->data, tam_data);
+        anexarTexto(buffer, "\nConteúdo: ", strlen("\nConteúdo: "));
+        anexarTexto(buffer, aulas[i]->conteudo, tam_conteudo);
+        anexarTexto(buffer, "\n", 1);
+        anexarTexto(buffer, LINHA_SIMPLES, sizeof(LINHA_SIMPLES) - 1);
+    }
+
+    // Rodapé do relatório
+    tam = snprintf(numero, sizeof(numero), "Total de aulas ministradas: %d\n", total);
+    if (!garantirEspaco(buffer, 1 + 2 * (sizeof(LINHA_DUPLA) - 1) + (size_t)tam)) {
+        return 0;
+    }
+    anexarTexto(buffer, "\n", 1);
+    anexarTexto(buffer, LINHA_DUPLA, sizeof(LINHA_DUPLA) - 1);
+    anexarTexto(buffer, numero, (size_t)tam);
+    anexarTexto(buffer, LINHA_DUPLA, sizeof(LINHA_DUPLA) - 1);
+    return 1;
+}
+
+// Lote completo ou só das turmas desatualizadas; as versões são gravadas nos dois casos
+static int processarLote(const char *diretorio, int threads, int so_desatualizados,
+                         ResultadoLoteRelatorios *resultado) {
+    double inicio = agoraSegundos();
+    LoteRelatorios lote;
+    TravaArquivo trava = TRAVA_ARQUIVO_INIT;
+    char arquivo_versoes[512];
+    int gerados = 0, reescritos = 0, removidos = 0;
+
+    if (criarDiretorio(diretorio) != 0 && errno != EEXIST) {
+        return -1;
+    }
+    snprintf(arquivo_versoes, sizeof(arquivo_versoes), "%s/%s", diretorio, ARQUIVO_VERSOES_RELATORIOS);
+    if (threads <= 0) {
+        threads = nucleosDisponiveis();
+    }
+    if (threads > RELATORIO_MAX_THREADS) {
+        threads = RELATORIO_MAX_THREADS;
+    }
+
+    Turma *turmas = malloc(sizeof(Turma) * MAX_TURMAS);
+    ChaveTurma *chaves = malloc(sizeof(ChaveTurma) * MAX_TURMAS);
+    int *inicio_turma = calloc(MAX_TURMAS + 1, sizeof(int));
+    TempoRelatorio *tempos = calloc(MAX_TURMAS, sizeof(TempoRelatorio));
+    VersaoRelatorio *atuais = calloc(MAX_TURMAS, sizeof(VersaoRelatorio));
+    if (turmas == NULL || chaves == NULL || inicio_turma == NULL || tempos == NULL || atuais == NULL) {
+        free(turmas);
+        free(chaves);
+        free(inicio_turma);
+        free(tempos);
+        free(atuais);
+        return -1;
+    }
+
+    // Um lote por diretório de cada vez (threads ou processos): as versões
+    // gravadas têm de corresponder aos arquivos que ficaram
+    int travado = travarArquivo(&trava, arquivo_versoes, TRAVA_EXCLUSIVA);
+    int total_anteriores = 0;
+    VersaoRelatorio *anteriores = carregarVersoes(arquivo_versoes, &total_anteriores);
+
+    // Carga única: turmas e uma versão das aulas
+    int total_turmas = listarTurmas(turmas, MAX_TURMAS);
+    Snapshot *versao = adquirirSnapshotAulas();
+    const Aula **agrupadas = malloc(sizeof(const Aula *) * (size_t)(totalRegistrosSnapshot(versao) + 1));
+    int *turma_da_aula = malloc(sizeof(int) * (size_t)(totalRegistrosSnapshot(versao) + 1));
+    if (agrupadas == NULL || turma_da_aula == NULL) {
+        liberarSnapshot(versao);
+        free(agrupadas);
+        free(turma_da_aula);
+        free(turmas);
+        free(chaves);
+        free(inicio_turma);
+        free(tempos);
+        free(atuais);
+        free(anteriores);
+        if (travado) {
+            destravarArquivo(&trava);
+        }
+        if (trava.descritor >= 0) {
+            close(trava.descritor);
+        }
+        return -1;
+    }
+
+    for (int i = 0; i < total_turmas; i++) {
+        chaves[i].id = turmas[i].id;
+        chaves[i].posicao = i;
+    }
+    qsort(chaves, (size_t)total_turmas, sizeof(ChaveTurma), compararChaveTurma);
+
+    // Agrupamento em uma passada (contagem estável: mantém a ordem das aulas
+    // dentro da turma, igual ao relatório individual)
+    for (int i = 0; i < totalRegistrosSnapshot(versao); i++) {
+        const Aula *aula = registroSnapshot(versao, i);
+        turma_da_aula[i] = localizarTurma(chaves, total_turmas, aula->id_turma);
+        if (turma_da_aula[i] >= 0) {
+            inicio_turma[turma_da_aula[i] + 1]++;
+        }
+    }
+    for (int i = 0; i < total_turmas; i++) {
+        inicio_turma[i + 1] += inicio_turma[i];
+    }
+    // A contagem por turma não é mais necessária: vira o cursor de escrita
+    for (int i = 0; i < total_turmas; i++) {
+        tempos[i].aulas = inicio_turma[i];
+    }
+    for (int i = 0; i < totalRegistrosSnapshot(versao); i++) {
+        if (turma_da_aula[i] >= 0) {
+            agrupadas[tempos[turma_da_aula[i]].aulas++] = registroSnapshot(versao, i);
+        }
+    }
+    free(turma_da_aula);
+    double segundos_carga = agoraSegundos() - inicio;
+
+    lote.diretorio = diretorio;
+    lote.so_desatualizados = so_desatualizados;
+    lote.anteriores = anteriores;
+    lote.total_anteriores = total_anteriores;
+    lote.atuais = atuais;
+    lote.turmas = turmas;
+    lote.total_turmas = total_turmas;
+    lote.aulas_agrupadas = agrupadas;
+    lote.inicio_turma = inicio_turma;
+    lote.tempos = tempos;
+    atomic_init(&lote.proxima, 0);
+
+    if (threads > total_turmas) {
+        threads = (total_turmas > 0) ? total_turmas : 1;
+    }
+
+    // A thread chamadora também trabalha; se não conseguir criar as demais, faz sozinha
+    pthread_t ids[RELATORIO_MAX_THREADS];
+    int criadas = 0;
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&ids[criadas], NULL, executarTrabalhador, &lote) != 0) {
+            break;
+        }
+        criadas++;
+    }
+    executarTrabalhador(&lote);
+    for (int t = 0; t < criadas; t++) {
+        pthread_join(ids[t], NULL);
+    }
+
+    liberarSnapshot(versao);
+    free(agrupadas);
+    free(inicio_turma);
+
+    for (int i = 0; i < total_turmas; i++) {
+        gerados += tempos[i].ok;
+        reescritos += tempos[i].reescrito;
+    }
+
+    // Relatórios de turmas excluídas (só os que este módulo gravou)
+    for (int i = 0; i < total_anteriores; i++) {
+        if (localizarTurma(chaves, total_turmas, anteriores[i].id_turma) < 0) {
+            char caminho[512];
+            snprintf(caminho, sizeof(caminho), "%s/relatorio_turma_%d.txt", diretorio, anteriores[i].id_turma);
+            removidos += (remove(caminho) == 0);
+        }
+    }
+
+    gravarVersoes(arquivo_versoes, atuais, tempos, total_turmas);
+    if (travado) {
+        destravarArquivo(&trava);
+    }
+    if (trava.descritor >= 0) {
+        close(trava.descritor);
+    }
+    free(anteriores);
+    free(atuais);
+    free(chaves);
+    free(turmas);
+
+    if (resultado != NULL) {
+        resultado->total_turmas = total_turmas;
+        resultado->gerados = gerados;
+        resultado->reescritos = reescritos;
+        resultado->removidos = removidos;
+        resultado->threads = criadas + 1;
+        resultado->segundos_carga = segundos_carga;
+        resultado->segundos_total = agoraSegundos() - inicio;
+        resultado->tempos = tempos;
+    } else {
+        free(tempos);
+    }
+    return gerados;
+}
+
+int gerarRelatoriosTodasTurmas(const char *diretorio, int threads, ResultadoLoteRelatorios *resultado) {
+    return processarLote(diretorio, threads, 0, resultado);
+}
+
+int atualizarRelatoriosTurmas(const char *diretorio, int threads, ResultadoLoteRelatorios *resultado) {
+    return processarLote(diretorio, threads, 1, resultado);
+}
+
+void liberarResultadoLote(ResultadoLoteRelatorios *resultado) {
+    free(resultado->tempos);
+    resultado->tempos = NULL;
+}
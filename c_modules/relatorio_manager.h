@@ -0,0 +1,78 @@
+#ifndef RELATORIO_MANAGER_H
+#define RELATORIO_MANAGER_H
+
+#include <stddef.h>
+#include "structs.h"
+
+// ========== RELATÓRIOS DO DIÁRIO DE CLASSE EM LOTE ==========
+//
+// gerarRelatoriosTodasTurmas() carrega turmas e aulas uma única vez (uma
+// versão do snapshot de aulas), agrupa as aulas por id_turma em uma passada
+// (contagem + soma de prefixos) e distribui as turmas entre threads. Cada
+// thread monta o relatório no próprio buffer e grava o arquivo com uma única
+// escrita; não há estado compartilhado além do índice da próxima turma.
+//
+// O texto é o mesmo de gerarRelatorioTurma() (as duas usam
+// renderizarRelatorioTurma()).
+//
+// Atualização incremental: a versão de cada relatório é um hash do que entra
+// no texto (id da turma, data e conteúdo das aulas, na ordem). O lote grava
+// as versões em "<diretorio>/ARQUIVO_VERSOES_RELATORIOS"; atualizarRelatoriosTurmas()
+// só reescreve a turma cuja versão mudou ou cujo arquivo sumiu/mudou de
+// tamanho, e remove os relatórios de turmas excluídas. O hash (e não um
+// contador nas funções de aula) também enxerga alterações feitas por outro
+// processo direto no CSV.
+
+#define RELATORIO_MAX_THREADS 64
+#define ARQUIVO_VERSOES_RELATORIOS "relatorios_versoes.csv"
+
+// Buffer de saída que cresce conforme a necessidade
+typedef struct {
+    char *dados;
+    size_t usados;
+    size_t capacidade;
+} BufferRelatorio;
+
+// Tempo de um relatório do lote
+typedef struct {
+    int id_turma;
+    int aulas;
+    int ok;                    // 1 se o arquivo está em dia
+    int reescrito;             // 1 se foi gravado neste lote
+    double microssegundos;     // Versão, montagem e gravação
+} TempoRelatorio;
+
+typedef struct {
+    int total_turmas;
+    int gerados;               // Relatórios em dia ao final
+    int reescritos;            // Gravados neste lote
+    int removidos;             // Turmas excluídas desde o último lote
+    int threads;
+    double segundos_carga;     // Turmas, snapshot e agrupamento
+    double segundos_total;     // Do início ao último arquivo
+    TempoRelatorio *tempos;    // Um por turma, na ordem de listarTurmas()
+} ResultadoLoteRelatorios;
+
+// Função para esvaziar o buffer mantendo a memória
+void limparBufferRelatorio(BufferRelatorio *buffer);
+
+// Função para liberar a memória do buffer
+void liberarBufferRelatorio(BufferRelatorio *buffer);
+
+// Função para montar o texto do relatório de uma turma no buffer
+// Retorna: 1 se sucesso, 0 se faltou memória
+int renderizarRelatorioTurma(BufferRelatorio *buffer, int id_turma, const Aula *const *aulas, int total);
+
+// Função para gerar "<diretorio>/relatorio_turma_<id>.txt" de todas as turmas
+// O diretório é criado se não existir; threads <= 0 usa um por núcleo
+// Retorna: relatórios gravados (-1 sem diretório ou memória); detalhes em resultado (pode ser NULL)
+int gerarRelatoriosTodasTurmas(const char *diretorio, int threads, ResultadoLoteRelatorios *resultado);
+
+// Função para atualizar só os relatórios desatualizados em "<diretorio>"
+// Retorna: relatórios em dia ao final (-1 sem diretório ou memória)
+int atualizarRelatoriosTurmas(const char *diretorio, int threads, ResultadoLoteRelatorios *resultado);
+
+// Função para liberar os tempos do resultado
+void liberarResultadoLote(ResultadoLoteRelatorios *resultado);
+
+#endif
@@ -0,0 +1,298 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "structs.h"
+#include "replicacao_manager.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/socket.h>
+#endif
+
+// Cópia reserva do diretório de dados, atualizada pelo registro de alterações
+//
+//   sistema_replicacao --primario                       (em data, socket data/replicacao.sock)
+//   sistema_replicacao --seguidor /mnt/reserva/data     (outro terminal; de preferência outro disco)
+//   sistema_replicacao --estado /mnt/reserva/data
+//   sistema_replicacao --promover /mnt/reserva/data
+//
+// O primário serve até 8 seguidores. O seguidor reconecta sozinho quando o
+// primário cai e retoma da última sequência aplicada; Ctrl+C (ou --promover)
+// aplica o que já chegou e transforma o diretório em diretório de dados.
+//
+// Código de saída: 0 sucesso, 1 diretório não é seguidor, 2 erro
+
+#define DIRETORIO_PADRAO "data"
+#define SOCKET_PADRAO "replicacao.sock"
+#define MAX_SEGUIDORES 8
+#define ESPERA_RECONEXAO_MS 1000
+#define ESPERA_PROMOCAO_MS 10000
+
+static void exibirAjuda(const char *programa) {
+    printf("Uso: %s [opcoes]\n", programa);
+    printf("  --primario         Serve o registro de alteracoes de --dir aos seguidores\n");
+    printf("  --seguidor DIR     Mantem DIR como copia de --dir (pelo --socket)\n");
+    printf("  --estado DIR       Mostra o atraso e os contadores do seguidor DIR\n");
+    printf("  --promover DIR     Encerra o seguidor de DIR e o torna diretorio de dados\n");
+    printf("  --dir DIR          Diretorio dos dados do primario (padrao: %s)\n", DIRETORIO_PADRAO);
+    printf("  --socket CAMINHO   Socket local (padrao: <dir>/%s)\n", SOCKET_PADRAO);
+}
+
+static void exibirMetricas(const char *diretorio, const MetricasReplicacao *m) {
+    long pid = pidSeguidorReplicacao(diretorio);
+
+    printf("Seguidor: %s", diretorio);
+    if (pid > 0) {
+        printf(" (processo %ld, %s)\n", pid, m->conectado ? "conectado" : "desconectado");
+    } else {
+        printf(" (%s)\n", m->promovido ? "promovido" : "sem seguidor ativo");
+    }
+    printf("  sequencia aplicada: %lld de %lld (atraso de %lld)\n", m->sequencia_aplicada,
+           m->sequencia_primario, m->atraso_sequencias);
+    printf("  atraso: %.3f ms (maximo %.3f ms)\n", m->atraso_segundos * 1e3, m->atraso_maximo_segundos * 1e3);
+    printf("  publicacoes: %lld, operacoes: %lld, arquivos copiados: %lld\n", m->publicacoes, m->operacoes,
+           m->arquivos_copiados);
+}
+
+#ifdef _WIN32
+
+int main(int argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+    (void)exibirAjuda;
+    (void)exibirMetricas;
+    printf("Aviso: replicação não suportada no Windows.\n");
+    return 2;
+}
+
+#else
+
+static atomic_int parar = 0;
+
+static void pedirParada(int sinal) {
+    (void)sinal;
+    atomic_store(&parar, 1);
+}
+
+static void instalarSinais(void) {
+    struct sigaction acao;
+
+    memset(&acao, 0, sizeof(acao));
+    acao.sa_handler = pedirParada;
+    sigemptyset(&acao.sa_mask);
+    sigaction(SIGINT, &acao, NULL);
+    sigaction(SIGTERM, &acao, NULL);
+}
+
+static void esperarMs(long ms) {
+    struct timespec espera = {ms / 1000, (ms % 1000) * 1000000L};
+    nanosleep(&espera, NULL);
+}
+
+typedef struct {
+    pthread_t thread;
+    const char *diretorio;
+    int descritor;
+    atomic_int ativo;              // 1 enquanto a thread serve o seguidor
+    int usado;                     // Thread criada (precisa de join)
+} ConexaoSeguidor;
+
+static void *servirConexao(void *argumento) {
+    ConexaoSeguidor *conexao = (ConexaoSeguidor *)argumento;
+
+    servirReplicacao(conexao->diretorio, conexao->descritor, &parar);
+    close(conexao->descritor);
+    atomic_store(&conexao->ativo, 0);
+    return NULL;
+}
+
+static int executarPrimario(const char *diretorio, const char *socket_local) {
+    ConexaoSeguidor conexoes[MAX_SEGUIDORES];
+    int escuta = escutarReplicacao(socket_local);
+
+    if (escuta < 0) {
+        printf("Erro: não foi possível escutar em '%s'.\n", socket_local);
+        return 2;
+    }
+    memset(conexoes, 0, sizeof(conexoes));
+    printf("Primario: %s, seguidores em %s (Ctrl+C encerra).\n", diretorio, socket_local);
+
+    while (!atomic_load(&parar)) {
+        struct pollfd espera = {escuta, POLLIN, 0};
+        if (poll(&espera, 1, INTERVALO_REPLICACAO_MS) <= 0) {
+            continue;
+        }
+        int descritor = accept(escuta, NULL, NULL);
+        if (descritor < 0) {
+            continue;
+        }
+
+        ConexaoSeguidor *livre = NULL;
+        for (int i = 0; i < MAX_SEGUIDORES && livre == NULL; i++) {
+            if (!atomic_load(&conexoes[i].ativo)) {
+                livre = &conexoes[i];
+            }
+        }
+        if (livre == NULL) {
+            printf("Aviso: limite de %d seguidores; conexao recusada.\n", MAX_SEGUIDORES);
+            close(descritor);
+            continue;
+        }
+        if (livre->usado) {
+            pthread_join(livre->thread, NULL);
+        }
+        livre->diretorio = diretorio;
+        livre->descritor = descritor;
+        atomic_store(&livre->ativo, 1);
+        livre->usado = pthread_create(&livre->thread, NULL, servirConexao, livre) == 0;
+        if (!livre->usado) {
+            atomic_store(&livre->ativo, 0);
+            close(descritor);
+        }
+    }
+
+    for (int i = 0; i < MAX_SEGUIDORES; i++) {
+        if (conexoes[i].usado) {
+            pthread_join(conexoes[i].thread, NULL);
+        }
+    }
+    close(escuta);
+    unlink(socket_local);
+    return 0;
+}
+
+static int executarSeguidor(const char *diretorio, const char *socket_local) {
+    MetricasReplicacao metricas;
+    int avisado = 0;
+
+    printf("Seguidor: %s <- %s (Ctrl+C promove).\n", diretorio, socket_local);
+    while (!atomic_load(&parar)) {
+        int descritor = conectarReplicacao(socket_local);
+        if (descritor < 0) {
+            if (!avisado) {
+                printf("Aguardando o primario em '%s'...\n", socket_local);
+                avisado = 1;
+            }
+            esperarMs(ESPERA_RECONEXAO_MS);
+            continue;
+        }
+        avisado = 0;
+        int resultado = seguirReplicacao(diretorio, descritor, &parar, &metricas);
+        close(descritor);
+        if (resultado < 0) {
+            return 2;
+        }
+        if (resultado == 1) {
+            printf("Promovido: %s e agora um diretorio de dados.\n", diretorio);
+            exibirMetricas(diretorio, &metricas);
+            return 0;
+        }
+        printf("Conexao com o primario encerrada; reconectando.\n");
+    }
+
+    // Parado sem conexão: o que foi aplicado até aqui vale
+    if (pidSeguidorReplicacao(diretorio) > 0 && !promoverSeguidorReplicacao(diretorio)) {
+        return 2;
+    }
+    printf("Promovido: %s e agora um diretorio de dados.\n", diretorio);
+    return 0;
+}
+
+static int promoverSeguidor(const char *diretorio) {
+    long pid = pidSeguidorReplicacao(diretorio);
+
+    if (pid == 0) {
+        printf("'%s' nao e um diretorio seguidor.\n", diretorio);
+        return 1;
+    }
+    if (!promoverSeguidorReplicacao(diretorio)) {
+        // Seguidor ativo: ele mesmo aplica o que recebeu e se promove
+        kill((pid_t)pid, SIGTERM);
+        for (long esperado = 0; pidSeguidorReplicacao(diretorio) != 0; esperado += 50) {
+            if (esperado >= ESPERA_PROMOCAO_MS) {
+                printf("Erro: o seguidor %ld nao terminou.\n", pid);
+                return 2;
+            }
+            esperarMs(50);
+        }
+    }
+    printf("Promovido: %s e agora um diretorio de dados.\n", diretorio);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    const char *diretorio = DIRETORIO_PADRAO;
+    const char *socket_local = NULL;
+    const char *seguidor = NULL;
+    const char *estado = NULL;
+    const char *promover = NULL;
+    char socket_padrao[MAX_PATH + 32];
+    int primario = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char *valor = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(argv[i], "--primario") == 0) {
+            primario = 1;
+        } else if (strcmp(argv[i], "--seguidor") == 0 && valor) {
+            seguidor = valor;
+            i++;
+        } else if (strcmp(argv[i], "--estado") == 0 && valor) {
+            estado = valor;
+            i++;
+        } else if (strcmp(argv[i], "--promover") == 0 && valor) {
+            promover = valor;
+            i++;
+        } else if (strcmp(argv[i], "--dir") == 0 && valor) {
+            diretorio = valor;
+            i++;
+        } else if (strcmp(argv[i], "--socket") == 0 && valor) {
+            socket_local = valor;
+            i++;
+        } else {
+            exibirAjuda(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 2;
+        }
+    }
+
+    if (primario + (seguidor != NULL) + (estado != NULL) + (promover != NULL) != 1) {
+        exibirAjuda(argv[0]);
+        return 2;
+    }
+    if (socket_local == NULL) {
+        snprintf(socket_padrao, sizeof(socket_padrao), "%s/%s", diretorio, SOCKET_PADRAO);
+        socket_local = socket_padrao;
+    }
+
+    if (estado != NULL) {
+        MetricasReplicacao metricas;
+        if (!lerMetricasReplicacao(estado, &metricas) && pidSeguidorReplicacao(estado) == 0) {
+            printf("'%s' nao e um diretorio seguidor.\n", estado);
+            return 1;
+        }
+        exibirMetricas(estado, &metricas);
+        return 0;
+    }
+    if (promover != NULL) {
+        return promoverSeguidor(promover);
+    }
+
+    instalarSinais();
+    if (primario) {
+        return executarPrimario(diretorio, socket_local);
+    }
+    if (strcmp(seguidor, diretorio) == 0) {
+        printf("Erro: o seguidor precisa de um diretorio diferente do primario.\n");
+        return 2;
+    }
+    return executarSeguidor(seguidor, socket_local);
+}
+
+#endif
@@ -0,0 +1,974 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include "replicacao_manager.h"
+#include "alteracoes_manager.h"
+#include "backup_manager.h"
+#include "tabela_manager.h"
+#include "structs.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+#define MAX_LINHA_REPLICACAO 1024
+#define TAM_BUFFER_REPLICACAO 65536
+
+// Arquivos replicados (os do backup); os CSVs também vêm pelo log
+static const char *arquivos_replicados[TOTAL_ARQUIVOS_BACKUP] = {
+    "alunos.csv", "turmas.csv", "aulas.csv", "aluno_turma.csv",
+    "atividades.csv", "notas.csv", "usuarios.csv", "frequencia.dat"
+};
+
+#ifndef _WIN32
+
+// Leitura do socket com buffer (linhas de controle e conteúdos)
+typedef struct {
+    int descritor;
+    char buffer[TAM_BUFFER_REPLICACAO];
+    size_t inicio;
+    size_t fim;
+} CanalReplicacao;
+
+// Estado do primário para um seguidor
+typedef struct {
+    const char *diretorio;
+    int descritor;
+    TravaArquivo travas[TOTAL_ARQUIVOS_BACKUP];
+} Remetente;
+
+// Estado do seguidor
+typedef struct {
+    const char *diretorio;
+    int descritor;
+    TravaArquivo travas[TOTAL_ARQUIVOS_BACKUP];
+    int pedido[TOTAL_ARQUIVOS_BACKUP]; // Arquivo inteiro pedido, à espera
+    MetricasReplicacao metricas;
+} Seguidor;
+
+// ========== FUNÇÕES AUXILIARES PRIVADAS ==========
+
+static long long agoraMicrossegundos(void) {
+    struct timespec agora;
+    clock_gettime(CLOCK_REALTIME, &agora);
+    return (long long)agora.tv_sec * 1000000LL + agora.tv_nsec / 1000;
+}
+
+static void caminhoReplicacao(char *destino, size_t tamanho, const char *diretorio, const char *nome) {
+    snprintf(destino, tamanho, "%s/%s", diretorio, nome);
+}
+
+// Retorna: posição do arquivo na lista, -1 se não é replicado
+static int indiceReplicado(const char *nome) {
+    for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP; i++) {
+        if (strcmp(arquivos_replicados[i], nome) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Retorna: conteúdo (malloc, com '\0' no fim), NULL se o arquivo não existe
+static char *lerArquivoReplicado(const char *caminho, size_t *tamanho) {
+    FILE *arquivo = fopen(caminho, "rb");
+    char *dados = NULL;
+    long fim;
+
+    *tamanho = 0;
+    if (arquivo == NULL) {
+        return NULL;
+    }
+    if (fseek(arquivo, 0, SEEK_END) == 0 && (fim = ftell(arquivo)) >= 0 && fseek(arquivo, 0, SEEK_SET) == 0) {
+        dados = malloc((size_t)fim + 1);
+        if (dados != NULL && fread(dados, 1, (size_t)fim, arquivo) != (size_t)fim) {
+            free(dados);
+            dados = NULL;
+        }
+        if (dados != NULL) {
+            dados[fim] = '\0';
+            *tamanho = (size_t)fim;
+        }
+    }
+    fclose(arquivo);
+    return dados;
+}
+
+static long long tamanhoArquivo(const char *caminho) {
+    struct stat info;
+    return (stat(caminho, &info) == 0) ? (long long)info.st_size : -1;
+}
+
+static void fecharTravas(TravaArquivo *travas) {
+    for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP; i++) {
+        if (travas[i].descritor >= 0) {
+            close(travas[i].descritor);
+            travas[i].descritor = -1;
+        }
+    }
+}
+
+// ========== CANAL ==========
+
+// Retorna: 1 com dados para ler, 0 se o tempo acabou, -1 se a conexão terminou
+static int esperarCanal(CanalReplicacao *canal, int ms) {
+    struct pollfd espera;
+
+    if (canal->inicio < canal->fim) {
+        return 1;
+    }
+    espera.fd = canal->descritor;
+    espera.events = POLLIN;
+    espera.revents = 0;
+    int prontos = poll(&espera, 1, ms);
+    if (prontos <= 0) {
+        return (prontos == 0 || errno == EINTR) ? 0 : -1;
+    }
+
+    ssize_t lidos = recv(canal->descritor, canal->buffer, sizeof(canal->buffer), 0);
+    if (lidos < 0 && errno == EINTR) {
+        return 0;
+    }
+    if (lidos <= 0) {
+        return -1;
+    }
+    canal->inicio = 0;
+    canal->fim = (size_t)lidos;
+    return 1;
+}
+
+// Retorna: 1 se leu os "tamanho" bytes, 0 se a conexão terminou antes
+static int lerCanal(CanalReplicacao *canal, void *destino, size_t tamanho) {
+    unsigned char *saida = (unsigned char *)destino;
+
+    while (tamanho > 0) {
+        int pronto = esperarCanal(canal, -1);
+        if (pronto < 0) {
+            return 0;
+        }
+        if (pronto == 0) {
+            continue;
+        }
+        size_t disponivel = canal->fim - canal->inicio;
+        size_t copiar = (disponivel < tamanho) ? disponivel : tamanho;
+        memcpy(saida, canal->buffer + canal->inicio, copiar);
+        canal->inicio += copiar;
+        saida += copiar;
+        tamanho -= copiar;
+    }
+    return 1;
+}
+
+// Lê uma linha de controle (sem o '\n')
+// Retorna: 1 se leu, 0 se a conexão terminou ou a linha é longa demais
+static int lerLinhaCanal(CanalReplicacao *canal, char *linha, size_t maximo) {
+    size_t usado = 0;
+
+    for (;;) {
+        char c;
+        if (!lerCanal(canal, &c, 1)) {
+            return 0;
+        }
+        if (c == '\n') {
+            linha[usado] = '\0';
+            return 1;
+        }
+        if (usado + 1 >= maximo) {
+            return 0;
+        }
+        linha[usado++] = c;
+    }
+}
+
+static int enviarTudo(int descritor, const void *dados, size_t tamanho) {
+    const char *p = (const char *)dados;
+
+    while (tamanho > 0) {
+        ssize_t enviados = send(descritor, p, tamanho, MSG_NOSIGNAL);
+        if (enviados < 0 && errno == EINTR) {
+            continue;
+        }
+        if (enviados <= 0) {
+            return 0;
+        }
+        p += enviados;
+        tamanho -= (size_t)enviados;
+    }
+    return 1;
+}
+
+// Linha de controle seguida do conteúdo
+static int enviarMensagem(int descritor, const char *linha, const void *dados, size_t tamanho) {
+    return enviarTudo(descritor, linha, strlen(linha)) && (tamanho == 0 || enviarTudo(descritor, dados, tamanho));
+}
+
+// ========== PRIMÁRIO ==========
+
+// Cópia inicial: um backup completo, apagado depois de enviado
+static int enviarCopiaInicial(Remetente *remetente, long long *sequencia) {
+    char caminho[MAX_PATH + 64];
+    char linha[MAX_LINHA_REPLICACAO];
+    ResumoBackup resumo;
+    size_t tamanho = 0;
+
+    snprintf(caminho, sizeof(caminho), "%s/replicacao_%ld_%d.pimb", remetente->diretorio, (long)getpid(),
+             remetente->descritor);
+    if (!criarBackup(remetente->diretorio, caminho, &resumo)) {
+        return 0;
+    }
+    char *dados = lerArquivoReplicado(caminho, &tamanho);
+    remove(caminho);
+    strncat(caminho, ".lock", sizeof(caminho) - strlen(caminho) - 1);
+    remove(caminho);
+    if (dados == NULL) {
+        return 0;
+    }
+
+    snprintf(linha, sizeof(linha), "B %zu\n", tamanho);
+    int ok = enviarMensagem(remetente->descritor, linha, dados, tamanho);
+    free(dados);
+    *sequencia = resumo.sequencia;
+    return ok;
+}
+
+// Arquivo inteiro (ou só o trecho acrescentado) lido sob a trava compartilhada
+static int enviarArquivo(Remetente *remetente, const char *nome, long long geracao_seguidor,
+                         long long tamanho_seguidor) {
+    char caminho[MAX_PATH + 64];
+    char linha[MAX_LINHA_REPLICACAO];
+    int indice = indiceReplicado(nome);
+    size_t tamanho = 0;
+    size_t desde = 0;
+
+    if (indice < 0) {
+        return 0;
+    }
+    caminhoReplicacao(caminho, sizeof(caminho), remetente->diretorio, nome);
+    if (!travarArquivo(&remetente->travas[indice], caminho, TRAVA_COMPARTILHADA)) {
+        return 0;
+    }
+    long long geracao = lerGeracaoArquivo(&remetente->travas[indice]);
+    char *dados = lerArquivoReplicado(caminho, &tamanho);
+    destravarArquivo(&remetente->travas[indice]);
+
+    // frequencia.dat só cresce entre compactações (que mudam a geração)
+    if (dados != NULL && camposChaveAlteracoes(nome) == 0 && geracao == geracao_seguidor &&
+        tamanho_seguidor >= 0 && (size_t)tamanho_seguidor <= tamanho) {
+        desde = (size_t)tamanho_seguidor;
+    }
+    snprintf(linha, sizeof(linha), "T %s %lld %d %zu %zu\n", nome, geracao, dados != NULL, desde, tamanho - desde);
+    int ok = enviarMensagem(remetente->descritor, linha, (dados != NULL) ? dados + desde : NULL, tamanho - desde);
+    free(dados);
+    return ok;
+}
+
+// Geração e tamanho de cada arquivo para o pulso ("-1:-1" se a trava está ocupada)
+static void lerEstadoArquivos(Remetente *remetente, char *texto, size_t tamanho) {
+    char caminho[MAX_PATH + 64];
+    size_t usado = 0;
+
+    texto[0] = '\0';
+    for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP && usado < tamanho; i++) {
+        long long geracao = -1;
+        long long bytes = -1;
+        caminhoReplicacao(caminho, sizeof(caminho), remetente->diretorio, arquivos_replicados[i]);
+        if (travarArquivo(&remetente->travas[i], caminho, TRAVA_COMPARTILHADA | TRAVA_SEM_ESPERA)) {
+            geracao = lerGeracaoArquivo(&remetente->travas[i]);
+            bytes = tamanhoArquivo(caminho);
+            destravarArquivo(&remetente->travas[i]);
+        }
+        usado += (size_t)snprintf(texto + usado, tamanho - usado, " %lld:%lld", geracao, bytes);
+    }
+}
+
+// O log foi trocado por podarAlteracoes(): o leitor reabre o arquivo novo
+static int logTrocado(const LeitorAlteracoes *leitor, const char *diretorio) {
+    char caminho[MAX_PATH + 64];
+    struct stat atual;
+    struct stat aberto;
+
+    caminhoReplicacao(caminho, sizeof(caminho), diretorio, ARQUIVO_ALTERACOES);
+    return leitor->arquivo != NULL && stat(caminho, &atual) == 0 && fstat(fileno(leitor->arquivo), &aberto) == 0 &&
+           (atual.st_ino != aberto.st_ino || atual.st_dev != aberto.st_dev);
+}
+
+// ========== SEGUIDOR ==========
+
+static long long geracaoLocal(Seguidor *seguidor, int indice) {
+    char caminho[MAX_PATH + 64];
+    long long geracao = 0;
+
+    caminhoReplicacao(caminho, sizeof(caminho), seguidor->diretorio, arquivos_replicados[indice]);
+    if (travarArquivo(&seguidor->travas[indice], caminho, TRAVA_COMPARTILHADA)) {
+        geracao = lerGeracaoArquivo(&seguidor->travas[indice]);
+        destravarArquivo(&seguidor->travas[indice]);
+    }
+    return geracao;
+}
+
+// Põe a geração do primário no arquivo de trava (exige trava exclusiva)
+static void definirGeracao(TravaArquivo *trava, long long geracao) {
+    long long atual = lerGeracaoArquivo(trava);
+    if (geracao != atual) {
+        avancarGeracaoArquivo(trava, geracao - atual);
+    }
+}
+
+// Publica o conteúdo novo de um arquivo do seguidor (temporário + rename)
+// Sem concluirEscritaAtomica(): as operações vêm prontas do primário e o log
+// do seguidor recebe as dele, com as mesmas sequências
+static int substituirArquivoLocal(const char *caminho, const char *dados, size_t tamanho) {
+    char temporario[MAX_PATH + 72];
+    FILE *arquivo;
+
+    snprintf(temporario, sizeof(temporario), "%s.tmp", caminho);
+    arquivo = fopen(temporario, "wb");
+    if (arquivo == NULL) {
+        return 0;
+    }
+    int ok = fwrite(dados, 1, tamanho, arquivo) == tamanho && fflush(arquivo) == 0 && fsync(fileno(arquivo)) == 0;
+    ok = (fclose(arquivo) == 0) && ok;
+    ok = ok && rename(temporario, caminho) == 0;
+    if (!ok) {
+        remove(temporario);
+    }
+    return ok;
+}
+
+static void gravarMetricas(Seguidor *seguidor) {
+    char caminho[MAX_PATH + 64];
+    const MetricasReplicacao *m = &seguidor->metricas;
+
+    caminhoReplicacao(caminho, sizeof(caminho), seguidor->diretorio, ARQUIVO_METRICAS_REPLICACAO);
+    FILE *arquivo = abrirEscritaAtomica(caminho);
+    if (arquivo == NULL) {
+        return;
+    }
+    fprintf(arquivo, "sequencia_aplicada %lld\n", m->sequencia_aplicada);
+    fprintf(arquivo, "sequencia_primario %lld\n", m->sequencia_primario);
+    fprintf(arquivo, "atraso_sequencias %lld\n", m->atraso_sequencias);
+    fprintf(arquivo, "atraso_segundos %.6f\n", m->atraso_segundos);
+    fprintf(arquivo, "atraso_maximo_segundos %.6f\n", m->atraso_maximo_segundos);
+    fprintf(arquivo, "publicacoes %lld\n", m->publicacoes);
+    fprintf(arquivo, "operacoes %lld\n", m->operacoes);
+    fprintf(arquivo, "arquivos_copiados %lld\n", m->arquivos_copiados);
+    fprintf(arquivo, "conectado %d\n", m->conectado);
+    fprintf(arquivo, "promovido %d\n", m->promovido);
+    concluirEscritaAtomica(arquivo, caminho);
+}
+
+static int pedirArquivo(Seguidor *seguidor, int indice) {
+    char caminho[MAX_PATH + 64];
+    char linha[MAX_LINHA_REPLICACAO];
+
+    caminhoReplicacao(caminho, sizeof(caminho), seguidor->diretorio, arquivos_replicados[indice]);
+    snprintf(linha, sizeof(linha), "T %s %lld %lld\n", arquivos_replicados[indice], geracaoLocal(seguidor, indice),
+             tamanhoArquivo(caminho));
+    seguidor->pedido[indice] = 1;
+    return enviarTudo(seguidor->descritor, linha, strlen(linha));
+}
+
+// Recebe o backup inicial, restaura e adota gerações e sequência
+static int aplicarCopiaInicial(Seguidor *seguidor, CanalReplicacao *canal, size_t tamanho) {
+    char caminho[MAX_PATH + 64];
+    char bloco[TAM_BUFFER_REPLICACAO];
+    ArquivoBackup arquivos[TOTAL_ARQUIVOS_BACKUP];
+    ResumoBackup resumo;
+
+    caminhoReplicacao(caminho, sizeof(caminho), seguidor->diretorio, "replicacao_inicial.pimb");
+    FILE *arquivo = fopen(caminho, "wb");
+    int ok = arquivo != NULL;
+    while (tamanho > 0) {
+        size_t parte = (tamanho < sizeof(bloco)) ? tamanho : sizeof(bloco);
+        if (!lerCanal(canal, bloco, parte)) {
+            ok = 0;
+            break;
+        }
+        ok = ok && fwrite(bloco, 1, parte, arquivo) == parte;
+        tamanho -= parte;
+    }
+    if (arquivo != NULL) {
+        ok = (fclose(arquivo) == 0) && ok;
+    }
+
+    int total = ok ? listarArquivosBackup(caminho, arquivos) : -1;
+    ok = total >= 0 && restaurarBackup(caminho, seguidor->diretorio, &resumo);
+    remove(caminho);
+    if (!ok) {
+        printf("Erro: cópia inicial não aplicada em '%s'.\n", seguidor->diretorio);
+        return 0;
+    }
+
+    for (int i = 0; i < total; i++) {
+        int indice = indiceReplicado(arquivos[i].nome);
+        if (indice < 0) {
+            continue;
+        }
+        caminhoReplicacao(caminho, sizeof(caminho), seguidor->diretorio, arquivos[i].nome);
+        if (travarArquivo(&seguidor->travas[indice], caminho, TRAVA_EXCLUSIVA)) {
+            definirGeracao(&seguidor->travas[indice], arquivos[i].geracao);
+            destravarArquivo(&seguidor->travas[indice]);
+        }
+    }
+    // Por último: o log do seguidor existir marca a cópia inicial como aplicada
+    if (!acrescentarPublicacoesAlteracoes(seguidor->diretorio, NULL, 0, resumo.sequencia)) {
+        return 0;
+    }
+    seguidor->metricas.sequencia_aplicada = resumo.sequencia;
+    seguidor->metricas.arquivos_copiados += resumo.arquivos;
+    return 1;
+}
+
+// Remonta o CSV do seguidor com as operações de uma publicação
+// Retorna: 1 se aplicada, 0 se alguma operação não se encaixa
+static int aplicarOperacoesLocais(Seguidor *seguidor, int indice, const char *texto, size_t tamanho,
+                                  long long geracao) {
+    char caminho[MAX_PATH + 64];
+    size_t tamanho_atual = 0;
+    int ok = 1;
+
+    caminhoReplicacao(caminho, sizeof(caminho), seguidor->diretorio, arquivos_replicados[indice]);
+    if (!travarArquivo(&seguidor->travas[indice], caminho, TRAVA_EXCLUSIVA)) {
+        return 0;
+    }
+    char *atual = lerArquivoReplicado(caminho, &tamanho_atual);
+    ConteudoTabela *conteudo = criarConteudoTabela(arquivos_replicados[indice], atual != NULL ? atual : "",
+                                                   tamanho_atual);
+    ok = conteudo != NULL;
+
+    for (size_t inicio = 0; ok && inicio < tamanho;) {
+        const char *quebra = memchr(texto + inicio, '\n', tamanho - inicio);
+        size_t fim = (quebra != NULL) ? (size_t)(quebra - texto) : tamanho;
+        Alteracao alteracao;
+
+        ok = interpretarAlteracao(texto + inicio, fim - inicio, &alteracao);
+        if (ok && alteracao.operacao != ALTERACAO_CONFIRMAR) {
+            ok = aplicarAlteracao(conteudo, &alteracao);
+            seguidor->metricas.operacoes += ok;
+        }
+        inicio = fim + 1;
+    }
+
+    size_t tamanho_novo = 0;
+    char *novo = ok ? serializarConteudoTabela(conteudo, &tamanho_novo) : NULL;
+    ok = novo != NULL && substituirArquivoLocal(caminho, novo, tamanho_novo);
+    if (ok) {
+        definirGeracao(&seguidor->travas[indice], geracao);
+    }
+    destravarArquivo(&seguidor->travas[indice]);
+
+    free(novo);
+    liberarConteudoTabela(conteudo);
+    free(atual);
+    return ok;
+}
+
+// Uma publicação do log do primário
+static int aplicarPublicacao(Seguidor *seguidor, const char *texto, size_t tamanho, long long lida_us) {
+    Alteracao primeira;
+    Alteracao confirmacao;
+    const char *ultima = texto;
+
+    if (tamanho == 0 || texto[tamanho - 1] != '\n') {
+        printf("Erro: publicação malformada recebida do primário.\n");
+        return 0;
+    }
+
+    // A publicação termina na linha C, com a última sequência
+    for (const char *p = texto; p < texto + tamanho - 1; p++) {
+        if (*p == '\n') {
+            ultima = p + 1;
+        }
+    }
+    const char *fim_primeira = memchr(texto, '\n', tamanho);
+    if (fim_primeira == NULL ||
+        !interpretarAlteracao(texto, (size_t)(fim_primeira - texto), &primeira) ||
+        !interpretarAlteracao(ultima, (size_t)(texto + tamanho - 1 - ultima), &confirmacao) ||
+        confirmacao.operacao != ALTERACAO_CONFIRMAR) {
+        printf("Erro: publicação malformada recebida do primário.\n");
+        return 0;
+    }
+
+    // Sem a geração anterior (ou com operação que não se encaixa), pede o arquivo
+    int indice = indiceReplicado(primeira.tabela);
+    if (indice >= 0 && !seguidor->pedido[indice]) {
+        long long local = geracaoLocal(seguidor, indice);
+        if (primeira.geracao == local + 1) {
+            if (!aplicarOperacoesLocais(seguidor, indice, texto, tamanho, primeira.geracao) &&
+                !pedirArquivo(seguidor, indice)) {
+                return 0;
+            }
+        } else if (primeira.geracao > local + 1 && !pedirArquivo(seguidor, indice)) {
+            return 0;
+        }
+    }
+
+    if (!acrescentarPublicacoesAlteracoes(seguidor->diretorio, texto, tamanho, confirmacao.sequencia)) {
+        printf("Erro ao gravar o registro de alterações de '%s'.\n", seguidor->diretorio);
+        return 0;
+    }
+
+    MetricasReplicacao *m = &seguidor->metricas;
+    m->sequencia_aplicada = confirmacao.sequencia;
+    m->publicacoes++;
+    m->atraso_segundos = (double)(agoraMicrossegundos() - lida_us) / 1e6;
+    if (m->atraso_segundos > m->atraso_maximo_segundos) {
+        m->atraso_maximo_segundos = m->atraso_segundos;
+    }
+    if (m->sequencia_primario < m->sequencia_aplicada) {
+        m->sequencia_primario = m->sequencia_aplicada;
+    }
+    m->atraso_sequencias = m->sequencia_primario - m->sequencia_aplicada;
+    return 1;
+}
+
+// Arquivo inteiro (ou o trecho acrescentado) enviado pelo primário
+static int aplicarArquivo(Seguidor *seguidor, CanalReplicacao *canal, const char *nome, long long geracao,
+                          int existe, size_t desde, size_t tamanho) {
+    char caminho[MAX_PATH + 64];
+    int indice = indiceReplicado(nome);
+    char *dados = malloc(tamanho + 1);
+    int ok = dados != NULL && lerCanal(canal, dados, tamanho) && indice >= 0;
+
+    if (!ok) {
+        free(dados);
+        return 0;
+    }
+    caminhoReplicacao(caminho, sizeof(caminho), seguidor->diretorio, nome);
+    if (!travarArquivo(&seguidor->travas[indice], caminho, TRAVA_EXCLUSIVA)) {
+        free(dados);
+        return 0;
+    }
+
+    if (!existe) {
+        ok = remove(caminho) == 0 || errno == ENOENT;
+    } else if (desde > 0) {
+        // Só o trecho novo: vale se o seguidor ainda tem exatamente o começo
+        FILE *arquivo = (tamanhoArquivo(caminho) == (long long)desde) ? fopen(caminho, "ab") : NULL;
+        ok = arquivo != NULL && fwrite(dados, 1, tamanho, arquivo) == tamanho && fflush(arquivo) == 0 &&
+             fsync(fileno(arquivo)) == 0;
+        if (arquivo != NULL) {
+            ok = (fclose(arquivo) == 0) && ok;
+        }
+    } else {
+        ok = substituirArquivoLocal(caminho, dados, tamanho);
+    }
+    if (ok) {
+        definirGeracao(&seguidor->travas[indice], geracao);
+        seguidor->metricas.arquivos_copiados++;
+    }
+    destravarArquivo(&seguidor->travas[indice]);
+    free(dados);
+
+    // Se não deu certo, o próximo pulso mostra a divergência e o pedido se repete
+    seguidor->pedido[indice] = 0;
+    return 1;
+}
+
+// Pulso: atraso e, com tudo o que foi enviado aplicado, arquivos divergentes
+static int aplicarPulso(Seguidor *seguidor, const char *linha) {
+    MetricasReplicacao *m = &seguidor->metricas;
+    long long sequencia = 0;
+    long long enviada = 0;
+    long long agora_us = 0;
+    int lidos = 0;
+
+    if (sscanf(linha, "H %lld %lld %lld%n", &sequencia, &enviada, &agora_us, &lidos) != 3) {
+        return 0;
+    }
+    m->sequencia_primario = sequencia;
+    if (m->sequencia_aplicada >= enviada) {
+        // Em dia: o que o log ainda não tem (sequência reservada) não conta
+        m->atraso_sequencias = 0;
+        m->atraso_segundos = 0.0;
+    } else {
+        m->atraso_sequencias = sequencia - m->sequencia_aplicada;
+    }
+
+    const char *p = linha + lidos;
+    for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP; i++) {
+        char caminho[MAX_PATH + 64];
+        long long geracao = 0;
+        long long tamanho = 0;
+        int usados = 0;
+
+        if (sscanf(p, " %lld:%lld%n", &geracao, &tamanho, &usados) != 2) {
+            return 0;
+        }
+        p += usados;
+        if (geracao < 0 || seguidor->pedido[i] || m->sequencia_aplicada < enviada) {
+            continue;
+        }
+        caminhoReplicacao(caminho, sizeof(caminho), seguidor->diretorio, arquivos_replicados[i]);
+        if ((geracao != geracaoLocal(seguidor, i) || tamanho != tamanhoArquivo(caminho)) &&
+            !pedirArquivo(seguidor, i)) {
+            return 0;
+        }
+    }
+    gravarMetricas(seguidor);
+    return 1;
+}
+
+// Retorna: 1 se tratou a mensagem, 0 se a conexão terminou ou veio algo inválido
+static int tratarMensagemSeguidor(Seguidor *seguidor, CanalReplicacao *canal) {
+    char linha[MAX_LINHA_REPLICACAO];
+    char nome[MAX_NOME_ARQUIVO_BACKUP];
+    long long geracao = 0;
+    long long lida_us = 0;
+    int existe = 0;
+    size_t desde = 0;
+    size_t tamanho = 0;
+
+    if (!lerLinhaCanal(canal, linha, sizeof(linha))) {
+        return 0;
+    }
+    switch (linha[0]) {
+        case 'B':
+            return sscanf(linha, "B %zu", &tamanho) == 1 && aplicarCopiaInicial(seguidor, canal, tamanho);
+
+        case 'P': {
+            if (sscanf(linha, "P %zu %lld", &tamanho, &lida_us) != 2) {
+                return 0;
+            }
+            char *texto = malloc(tamanho + 1);
+            int ok = texto != NULL && lerCanal(canal, texto, tamanho) &&
+                     aplicarPublicacao(seguidor, texto, tamanho, lida_us);
+            free(texto);
+            return ok;
+        }
+
+        case 'T':
+            return sscanf(linha, "T %31s %lld %d %zu %zu", nome, &geracao, &existe, &desde, &tamanho) == 5 &&
+                   aplicarArquivo(seguidor, canal, nome, geracao, existe, desde, tamanho);
+
+        case 'H':
+            return aplicarPulso(seguidor, linha);
+
+        default:
+            return 0;
+    }
+}
+
+#endif
+
+// ========== IMPLEMENTAÇÃO DAS FUNÇÕES PÚBLICAS ==========
+
+int servirReplicacao(const char *diretorio, int descritor, atomic_int *parar) {
+#ifdef _WIN32
+    (void)diretorio; (void)descritor; (void)parar;
+    printf("Aviso: replicação não suportada no Windows.\n");
+    return 0;
+#else
+    Remetente remetente;
+    LeitorAlteracoes leitor;
+    char linha[MAX_LINHA_REPLICACAO];
+    char estado[MAX_LINHA_REPLICACAO / 2];
+    long long apos = 0;
+    long long proximo_pulso = 0;
+    int tem_copia = 0;
+    int aberto = 0;
+    int ok = 1;
+
+    CanalReplicacao *canal = malloc(sizeof(CanalReplicacao));
+    if (canal == NULL) {
+        return 0;
+    }
+    canal->descritor = descritor;
+    canal->inicio = 0;
+    canal->fim = 0;
+    remetente.diretorio = diretorio;
+    remetente.descritor = descritor;
+    for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP; i++) {
+        remetente.travas[i] = (TravaArquivo)TRAVA_ARQUIVO_INIT;
+    }
+    memset(&leitor, 0, sizeof(leitor));
+
+    ok = lerLinhaCanal(canal, linha, sizeof(linha)) && sscanf(linha, "R %lld %d", &apos, &tem_copia) == 2;
+    if (ok && !tem_copia) {
+        ok = enviarCopiaInicial(&remetente, &apos);
+    }
+
+    while (ok && !atomic_load(parar)) {
+        // Estado dos arquivos antes de esvaziar o log: o que já estiver
+        // publicado nele vai antes do pulso
+        int pulso = agoraMicrossegundos() >= proximo_pulso;
+        if (pulso) {
+            lerEstadoArquivos(&remetente, estado, sizeof(estado));
+        }
+
+        if (aberto && logTrocado(&leitor, diretorio)) {
+            fecharLeitorAlteracoes(&leitor);
+            aberto = 0;
+        }
+        if (!aberto) {
+            aberto = abrirLeitorAlteracoes(&leitor, diretorio, apos);
+        }
+        PublicacaoAlteracoes publicacao;
+        int lida = 0;
+        while (ok && aberto && (lida = lerPublicacaoAlteracoes(&leitor, &publicacao)) > 0) {
+            snprintf(linha, sizeof(linha), "P %zu %lld\n", publicacao.tamanho_texto, agoraMicrossegundos());
+            ok = enviarMensagem(descritor, linha, publicacao.texto, publicacao.tamanho_texto);
+            apos = publicacao.ultima_sequencia;
+        }
+        ok = ok && lida >= 0;
+
+        if (ok && pulso) {
+            snprintf(linha, sizeof(linha), "H %lld %lld %lld%s\n", ultimaSequenciaAlteracoes(diretorio), apos,
+                     agoraMicrossegundos(), estado);
+            ok = enviarTudo(descritor, linha, strlen(linha));
+            proximo_pulso = agoraMicrossegundos() + INTERVALO_REPLICACAO_MS * 1000LL;
+        }
+
+        // Pedidos de arquivo do seguidor; a espera é também o intervalo de releitura do log
+        int pronto = ok ? esperarCanal(canal, ESPERA_REPLICACAO_MS) : 0;
+        while (ok && pronto > 0) {
+            char nome[MAX_NOME_ARQUIVO_BACKUP];
+            long long geracao = 0;
+            long long tamanho = 0;
+            ok = lerLinhaCanal(canal, linha, sizeof(linha)) &&
+                 sscanf(linha, "T %31s %lld %lld", nome, &geracao, &tamanho) == 3 &&
+                 enviarArquivo(&remetente, nome, geracao, tamanho);
+            pronto = (canal->inicio < canal->fim);
+        }
+        if (pronto < 0) {
+            break;                 // Seguidor desconectou
+        }
+    }
+
+    if (aberto) {
+        fecharLeitorAlteracoes(&leitor);
+    }
+    fecharTravas(remetente.travas);
+    free(canal);
+    return ok;
+#endif
+}
+
+int seguirReplicacao(const char *diretorio, int descritor, atomic_int *parar, MetricasReplicacao *metricas) {
+#ifdef _WIN32
+    (void)diretorio; (void)descritor; (void)parar; (void)metricas;
+    printf("Aviso: replicação não suportada no Windows.\n");
+    return -1;
+#else
+    char caminho[MAX_PATH + 64];
+    char linha[MAX_LINHA_REPLICACAO];
+    int resultado = 0;
+
+    mkdir(diretorio, 0755);
+    long pid = pidSeguidorReplicacao(diretorio);
+    if (pid > 0 && pid != (long)getpid() && kill((pid_t)pid, 0) == 0) {
+        printf("Erro: '%s' já é seguido pelo processo %ld.\n", diretorio, pid);
+        return -1;
+    }
+
+    // Sem log, o diretório ainda não recebeu a cópia inicial: precisa estar sem tabelas
+    caminhoReplicacao(caminho, sizeof(caminho), diretorio, ARQUIVO_ALTERACOES ".lock");
+    int tem_copia = tamanhoArquivo(caminho) >= 0;
+    for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP && !tem_copia; i++) {
+        caminhoReplicacao(caminho, sizeof(caminho), diretorio, arquivos_replicados[i]);
+        if (tamanhoArquivo(caminho) >= 0) {
+            printf("Erro: '%s' tem tabelas e não é um seguidor; use um diretório vazio.\n", diretorio);
+            return -1;
+        }
+    }
+
+    caminhoReplicacao(caminho, sizeof(caminho), diretorio, ARQUIVO_SEGUIDOR);
+    FILE *marca = fopen(caminho, "w");
+    if (marca == NULL) {
+        printf("Erro: não foi possível marcar '%s' como seguidor.\n", diretorio);
+        return -1;
+    }
+    fprintf(marca, "%ld\n", (long)getpid());
+    fclose(marca);
+
+    Seguidor *seguidor = calloc(1, sizeof(Seguidor));
+    CanalReplicacao *canal = malloc(sizeof(CanalReplicacao));
+    if (seguidor == NULL || canal == NULL) {
+        free(seguidor);
+        free(canal);
+        return -1;
+    }
+    seguidor->diretorio = diretorio;
+    seguidor->descritor = descritor;
+    for (int i = 0; i < TOTAL_ARQUIVOS_BACKUP; i++) {
+        seguidor->travas[i] = (TravaArquivo)TRAVA_ARQUIVO_INIT;
+    }
+    lerMetricasReplicacao(diretorio, &seguidor->metricas);
+    seguidor->metricas.sequencia_aplicada = ultimaSequenciaAlteracoes(diretorio);
+    seguidor->metricas.conectado = 1;
+    seguidor->metricas.promovido = 0;
+    canal->descritor = descritor;
+    canal->inicio = 0;
+    canal->fim = 0;
+
+    snprintf(linha, sizeof(linha), "R %lld %d\n", seguidor->metricas.sequencia_aplicada, tem_copia);
+    int ok = enviarTudo(descritor, linha, strlen(linha));
+
+    while (ok) {
+        if (atomic_load(parar)) {
+            resultado = 1;
+            break;
+        }
+        int pronto = esperarCanal(canal, INTERVALO_REPLICACAO_MS);
+        if (pronto < 0) {
+            break;                 // Primário desconectou
+        }
+        if (pronto > 0) {
+            ok = tratarMensagemSeguidor(seguidor, canal);
+        }
+    }
+
+    // Promovido: o diretório passa a ser de dados comum
+    seguidor->metricas.conectado = 0;
+    if (resultado == 1) {
+        caminhoReplicacao(caminho, sizeof(caminho), diretorio, ARQUIVO_SEGUIDOR);
+        remove(caminho);
+        seguidor->metricas.promovido = 1;
+    }
+    gravarMetricas(seguidor);
+    if (metricas != NULL) {
+        *metricas = seguidor->metricas;
+    }
+    fecharTravas(seguidor->travas);
+    free(canal);
+    free(seguidor);
+    return resultado;
+#endif
+}
+
+int promoverSeguidorReplicacao(const char *diretorio) {
+#ifdef _WIN32
+    (void)diretorio;
+    return 0;
+#else
+    char caminho[MAX_PATH + 64];
+    long pid = pidSeguidorReplicacao(diretorio);
+
+    if (pid > 0 && pid != (long)getpid() && kill((pid_t)pid, 0) == 0) {
+        return 0;
+    }
+    caminhoReplicacao(caminho, sizeof(caminho), diretorio, ARQUIVO_SEGUIDOR);
+    remove(caminho);
+    return 1;
+#endif
+}
+
+int lerMetricasReplicacao(const char *diretorio, MetricasReplicacao *metricas) {
+    char caminho[MAX_PATH + 64];
+    char nome[64];
+    double valor;
+
+    memset(metricas, 0, sizeof(*metricas));
+    snprintf(caminho, sizeof(caminho), "%s/%s", diretorio, ARQUIVO_METRICAS_REPLICACAO);
+    FILE *arquivo = fopen(caminho, "r");
+    if (arquivo == NULL) {
+        return 0;
+    }
+    while (fscanf(arquivo, "%63s %lf", nome, &valor) == 2) {
+        if (strcmp(nome, "sequencia_aplicada") == 0) {
+            metricas->sequencia_aplicada = (long long)valor;
+        } else if (strcmp(nome, "sequencia_primario") == 0) {
+            metricas->sequencia_primario = (long long)valor;
+        } else if (strcmp(nome, "atraso_sequencias") == 0) {
+            metricas->atraso_sequencias = (long long)valor;
+        } else if (strcmp(nome, "atraso_segundos") == 0) {
+            metricas->atraso_segundos = valor;
+        } else if (strcmp(nome, "atraso_maximo_segundos") == 0) {
+            metricas->atraso_maximo_segundos = valor;
+        } else if (strcmp(nome, "publicacoes") == 0) {
+            metricas->publicacoes = (long long)valor;
+        } else if (strcmp(nome, "operacoes") == 0) {
+            metricas->operacoes = (long long)valor;
+        } else if (strcmp(nome, "arquivos_copiados") == 0) {
+            metricas->arquivos_copiados = (long long)valor;
+        } else if (strcmp(nome, "conectado") == 0) {
+            metricas->conectado = (int)valor;
+        } else if (strcmp(nome, "promovido") == 0) {
+            metricas->promovido = (int)valor;
+        }
+    }
+    fclose(arquivo);
+    return 1;
+}
+
+long pidSeguidorReplicacao(const char *diretorio) {
+    char caminho[MAX_PATH + 64];
+    long pid = 0;
+
+    snprintf(caminho, sizeof(caminho), "%s/%s", diretorio, ARQUIVO_SEGUIDOR);
+    FILE *arquivo = fopen(caminho, "r");
+    if (arquivo == NULL) {
+        return 0;
+    }
+    if (fscanf(arquivo, "%ld", &pid) != 1 || pid <= 0) {
+        pid = 1;                   // Marca ilegível: continua seguidor
+    }
+    fclose(arquivo);
+    return pid;
+}
+
+int escutarReplicacao(const char *caminho) {
+#ifdef _WIN32
+    (void)caminho;
+    return -1;
+#else
+    struct sockaddr_un endereco;
+
+    if (strlen(caminho) >= sizeof(endereco.sun_path)) {
+        printf("Erro: caminho do socket longo demais: '%s'.\n", caminho);
+        return -1;
+    }
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strcpy(endereco.sun_path, caminho);
+
+    int descritor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (descritor < 0) {
+        return -1;
+    }
+    // Socket de uma execução anterior
+    unlink(caminho);
+    if (bind(descritor, (struct sockaddr *)&endereco, sizeof(endereco)) != 0 || listen(descritor, 8) != 0) {
+        close(descritor);
+        return -1;
+    }
+    return descritor;
+#endif
+}
+
+int conectarReplicacao(const char *caminho) {
+#ifdef _WIN32
+    (void)caminho;
+    return -1;
+#else
+    struct sockaddr_un endereco;
+
+    if (strlen(caminho) >= sizeof(endereco.sun_path)) {
+        return -1;
+    }
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strcpy(endereco.sun_path, caminho);
+
+    int descritor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (descritor < 0) {
+        return -1;
+    }
+    if (connect(descritor, (struct sockaddr *)&endereco, sizeof(endereco)) != 0) {
+        close(descritor);
+        return -1;
+    }
+    return descritor;
+#endif
+}
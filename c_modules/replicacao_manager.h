@@ -0,0 +1,95 @@
+#ifndef REPLICACAO_MANAGER_H
+#define REPLICACAO_MANAGER_H
+
+#include <stdatomic.h>
+
+// ========== REPLICAÇÃO PARA UM DIRETÓRIO RESERVA (LOG SHIPPING) ==========
+//
+// O primário envia ao seguidor, por um socket local, o registro de
+// alterações do diretório de dados (alteracoes_manager.h); o seguidor aplica
+// as operações no próprio diretório (outro disco) e pode ser promovido a
+// diretório de dados a qualquer momento.
+//
+// 1. O seguidor conecta e envia a última sequência que aplicou e se já
+//    tem a cópia inicial.
+// 2. Sem ela, o primário envia um backup completo (backup_manager.h); o
+//    seguidor o restaura e adota a geração de cada arquivo e a sequência do
+//    backup.
+// 3. Cada publicação confirmada do log segue como está. O seguidor remonta
+//    o CSV com as operações e o publica (temporário + rename, sob a trava do
+//    arquivo, com a geração do primário), depois acrescenta a publicação ao
+//    próprio log com as mesmas sequências: promovido, o diretório continua a
+//    numeração (backups incrementais e assinantes seguem valendo).
+// 4. Uma geração que falta no log (CSV gravado por outro programa, queda
+//    entre o rename e o registro) ou uma operação que não se encaixa: o
+//    seguidor pede o arquivo inteiro, que o primário lê sob a trava
+//    compartilhada. frequencia.dat (fora do log) vai pelo mesmo caminho; se
+//    só cresceu, vai apenas o trecho novo.
+// 5. A cada intervalo o primário envia um pulso com a última sequência do
+//    log, a última enviada e a geração e o tamanho de cada arquivo (lidos
+//    sob a trava, antes de esvaziar o log): é o que mede o atraso e o que
+//    revela arquivos divergentes quando o seguidor aplicou tudo o enviado.
+//
+// Mensagens (uma linha de texto, seguida de "tamanho" bytes quando houver):
+//   seguidor -> primário: "R sequencia tem_copia", "T arquivo geracao tamanho"
+//   primário -> seguidor: "B tamanho" (backup), "P tamanho lida_us" (publicação),
+//                         "T arquivo geracao existe desde tamanho" (arquivo),
+//                         "H sequencia enviada agora_us geracao:tamanho ..." (pulso)
+//
+// "<dir>/replicacao.seguidor" marca o diretório seguidor (PID do processo);
+// enquanto existir, só o seguidor grava ali. "<dir>/replicacao.metricas"
+// tem as métricas (uma por linha, "nome valor"), regravadas a cada pulso.
+// Disponível apenas em sistemas POSIX (sockets AF_UNIX).
+
+#define ARQUIVO_SEGUIDOR "replicacao.seguidor"
+#define ARQUIVO_METRICAS_REPLICACAO "replicacao.metricas"
+#define INTERVALO_REPLICACAO_MS 100    // Pulso do primário
+#define ESPERA_REPLICACAO_MS 10        // Releitura do log sem novidades
+
+typedef struct {
+    long long sequencia_aplicada;  // Última do log do seguidor
+    long long sequencia_primario;  // Última informada pelo primário
+    long long atraso_sequencias;   // Diferença entre as duas
+    double atraso_segundos;        // Publicação lida no primário -> aplicada (0 em dia)
+    double atraso_maximo_segundos;
+    long long publicacoes;         // Publicações aplicadas
+    long long operacoes;
+    long long arquivos_copiados;   // Backup inicial, buracos e divergências
+    int conectado;
+    int promovido;
+} MetricasReplicacao;
+
+// Função para servir um seguidor conectado em "descritor" (bloqueia)
+// Termina quando o seguidor desconecta ou "parar" vira 1
+// Retorna: 1 se terminou normalmente, 0 se erro
+int servirReplicacao(const char *diretorio, int descritor, atomic_int *parar);
+
+// Função para seguir o primário conectado em "descritor" (bloqueia)
+// Com "parar" em 1, aplica o que já recebeu e promove o diretório (remove a
+// marca de seguidor); se o primário desconectar, o diretório continua
+// seguidor (reconecte e chame de novo: a sequência aplicada é retomada)
+// Retorna: 1 se promovido, 0 se a conexão terminou, -1 se erro (diretório
+//          com tabelas e sem cópia inicial, outro seguidor ativo)
+int seguirReplicacao(const char *diretorio, int descritor, atomic_int *parar, MetricasReplicacao *metricas);
+
+// Função para promover um diretório seguidor cujo processo já terminou
+// Retorna: 1 se promovido, 0 se um seguidor ainda está ativo nele
+int promoverSeguidorReplicacao(const char *diretorio);
+
+// Função para ler as métricas gravadas pelo seguidor de "diretorio"
+// Retorna: 1 se leu, 0 se o diretório não tem métricas
+int lerMetricasReplicacao(const char *diretorio, MetricasReplicacao *metricas);
+
+// Função para ler o PID do seguidor de "diretorio"
+// Retorna: PID, 0 se o diretório não é seguidor
+long pidSeguidorReplicacao(const char *diretorio);
+
+// Função para escutar conexões de seguidores no socket local "caminho"
+// Retorna: descritor para accept(), -1 se erro
+int escutarReplicacao(const char *caminho);
+
+// Função para conectar ao primário no socket local "caminho"
+// Retorna: descritor conectado, -1 se erro
+int conectarReplicacao(const char *caminho);
+
+#endif
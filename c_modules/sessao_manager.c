@@ -0,0 +1,320 @@
+#ifdef _WIN32
+#define _CRT_RAND_S
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include "sessao_manager.h"
+
+#define BALDES_SESSOES 2048            // Potência de 2, ~2x SESSOES_MAX
+#define FATIAS_RODA 512                // Minutos cobertos pela roda (> 8 h)
+#define SEGUNDOS_FATIA 60
+#define BYTES_TOKEN 16
+
+// ========== ESTRUTURAS INTERNAS ==========
+
+// Os encadeamentos guardam índice + 1 (0 = fim da lista), o que dispensa
+// inicializar os vetores estáticos
+typedef struct {
+    DadosSessao dados;
+    long ultimo_uso;           // Criação ou última validação (despejo com a tabela cheia)
+    int em_uso;
+    int proxima_hash;          // Próxima no balde da tabela (ou na lista livre)
+    int proxima_roda;          // Vizinhas na fatia da roda
+    int anterior_roda;
+} EntradaSessao;
+
+static EntradaSessao sessoes[SESSOES_MAX];
+static int baldes[BALDES_SESSOES];
+static int roda[FATIAS_RODA];
+static int livres = 0;                 // Cabeça da lista livre
+static int proxima_nunca_usada = 0;    // Entradas ainda não postas na lista livre
+static int total_ativas = 0;
+static long minuto_processado = -1;    // Última fatia da roda já limpa
+
+static pthread_mutex_t trava_sessoes = PTHREAD_MUTEX_INITIALIZER;
+static long (*relogio_sessoes)(void) = NULL;
+
+// ========== FUNÇÕES AUXILIARES PRIVADAS ==========
+
+static long agora(void) {
+    return relogio_sessoes ? relogio_sessoes() : (long)time(NULL);
+}
+
+// FNV-1a sobre o token
+static unsigned baldeDoToken(const char *token) {
+    uint32_t h = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)token; *p; p++) {
+        h = (h ^ *p) * 16777619u;
+    }
+    return h & (BALDES_SESSOES - 1);
+}
+
+static int gerarToken(char *destino) {
+    unsigned char bytes[BYTES_TOKEN];
+
+#ifdef _WIN32
+    for (int i = 0; i < BYTES_TOKEN; i += 4) {
+        unsigned int valor;
+        if (rand_s(&valor) != 0) {
+            return 0;
+        }
+        memcpy(bytes + i, &valor, 4);
+    }
+#else
+    FILE *fonte = fopen("/dev/urandom", "rb");
+    if (fonte == NULL) {
+        return 0;
+    }
+    size_t lidos = fread(bytes, 1, sizeof(bytes), fonte);
+    fclose(fonte);
+    if (lidos != sizeof(bytes)) {
+        return 0;
+    }
+#endif
+
+    for (int i = 0; i < BYTES_TOKEN; i++) {
+        snprintf(destino + 2 * i, 3, "%02x", bytes[i]);
+    }
+    return 1;
+}
+
+// Entrada do token (exige trava_sessoes); 0 se não existe
+static int buscarEntrada(const char *token) {
+    for (int i = baldes[baldeDoToken(token)]; i != 0; i = sessoes[i - 1].proxima_hash) {
+        if (strcmp(sessoes[i - 1].dados.token, token) == 0) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+static void inserirNaRoda(int indice) {
+    EntradaSessao *e = &sessoes[indice - 1];
+    int fatia = (int)((e->dados.expira / SEGUNDOS_FATIA) % FATIAS_RODA);
+
+    e->anterior_roda = 0;
+    e->proxima_roda = roda[fatia];
+    if (roda[fatia] != 0) {
+        sessoes[roda[fatia] - 1].anterior_roda = indice;
+    }
+    roda[fatia] = indice;
+}
+
+// Tira a sessão da tabela, da roda e devolve a entrada à lista livre
+static void removerEntrada(int indice) {
+    EntradaSessao *e = &sessoes[indice - 1];
+    int *elo = &baldes[baldeDoToken(e->dados.token)];
+
+    while (*elo != indice) {
+        elo = &sessoes[*elo - 1].proxima_hash;
+    }
+    *elo = e->proxima_hash;
+
+    if (e->anterior_roda != 0) {
+        sessoes[e->anterior_roda - 1].proxima_roda = e->proxima_roda;
+    } else {
+        roda[(e->dados.expira / SEGUNDOS_FATIA) % FATIAS_RODA] = e->proxima_roda;
+    }
+    if (e->proxima_roda != 0) {
+        sessoes[e->proxima_roda - 1].anterior_roda = e->anterior_roda;
+    }
+
+    memset(&e->dados, 0, sizeof(e->dados));
+    e->em_uso = 0;
+    e->proxima_hash = livres;
+    livres = indice;
+    total_ativas--;
+}
+
+// Avança a roda até o minuto atual liberando as sessões vencidas
+static void avancarRoda(long instante) {
+    long minuto = instante / SEGUNDOS_FATIA;
+
+    if (minuto_processado < 0 || minuto - minuto_processado > FATIAS_RODA) {
+        minuto_processado = minuto - FATIAS_RODA;
+    }
+    // A fatia do minuto atual é revista a cada chamada: parte dela ainda vale
+    for (long m = minuto_processado; m <= minuto; m++) {
+        int i = roda[m % FATIAS_RODA];
+        while (i != 0) {
+            int proxima = sessoes[i - 1].proxima_roda;
+            if (sessoes[i - 1].dados.expira <= instante) {
+                removerEntrada(i);
+            }
+            i = proxima;
+        }
+    }
+    minuto_processado = minuto;
+}
+
+// Encerra a sessão mais antiga do usuário se ele já está no limite
+static void limitarSessoesUsuario(int id_usuario) {
+    int mais_antiga = 0;
+    int do_usuario = 0;
+
+    for (int i = 1; i <= proxima_nunca_usada; i++) {
+        const EntradaSessao *e = &sessoes[i - 1];
+        if (e->em_uso && e->dados.id_usuario == id_usuario) {
+            do_usuario++;
+            if (mais_antiga == 0 || e->dados.criada < sessoes[mais_antiga - 1].dados.criada) {
+                mais_antiga = i;
+            }
+        }
+    }
+    if (do_usuario >= SESSOES_POR_USUARIO) {
+        removerEntrada(mais_antiga);
+    }
+}
+
+// Tabela cheia: a sessão usada há mais tempo dá lugar à nova
+static void despejarMenosUsada(void) {
+    int menos_usada = 0;
+
+    for (int i = 1; i <= proxima_nunca_usada; i++) {
+        if (sessoes[i - 1].em_uso &&
+            (menos_usada == 0 || sessoes[i - 1].ultimo_uso < sessoes[menos_usada - 1].ultimo_uso)) {
+            menos_usada = i;
+        }
+    }
+    if (menos_usada != 0) {
+        removerEntrada(menos_usada);
+    }
+}
+
+static int novaEntrada(void) {
+    if (livres != 0) {
+        int indice = livres;
+        livres = sessoes[indice - 1].proxima_hash;
+        return indice;
+    }
+    if (proxima_nunca_usada < SESSOES_MAX) {
+        return ++proxima_nunca_usada;
+    }
+    return 0;
+}
+
+// ========== FUNÇÕES PÚBLICAS ==========
+
+int criarSessaoServidor(int id_usuario, const char *login, const char *tipo, DadosSessao *destino) {
+    char token[SESSAO_TAM_TOKEN];
+
+    if (login == NULL || tipo == NULL) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&trava_sessoes);
+    long instante = agora();
+    avancarRoda(instante);
+
+    // Um token repetido é praticamente impossível, mas custa só uma busca
+    do {
+        if (!gerarToken(token)) {
+            pthread_mutex_unlock(&trava_sessoes);
+            printf("Erro: não foi possível gerar o token da sessão.\n");
+            return 0;
+        }
+    } while (buscarEntrada(token) != 0);
+
+    limitarSessoesUsuario(id_usuario);
+    int indice = novaEntrada();
+    if (indice == 0) {
+        despejarMenosUsada();
+        indice = novaEntrada();
+    }
+
+    EntradaSessao *e = &sessoes[indice - 1];
+    snprintf(e->dados.token, sizeof(e->dados.token), "%s", token);
+    e->dados.id_usuario = id_usuario;
+    snprintf(e->dados.login, sizeof(e->dados.login), "%s", login);
+    snprintf(e->dados.tipo, sizeof(e->dados.tipo), "%s", tipo);
+    e->dados.criada = instante;
+    e->dados.expira = instante + SESSAO_DURACAO_S;
+    e->ultimo_uso = instante;
+    e->em_uso = 1;
+
+    unsigned balde = baldeDoToken(token);
+    e->proxima_hash = baldes[balde];
+    baldes[balde] = indice;
+    inserirNaRoda(indice);
+    total_ativas++;
+
+    if (destino != NULL) {
+        *destino = e->dados;
+    }
+    pthread_mutex_unlock(&trava_sessoes);
+    return 1;
+}
+
+int validarTokenSessao(const char *token, DadosSessao *destino) {
+    int resultado = SESSAO_INEXISTENTE;
+
+    if (token == NULL || token[0] == '\0') {
+        return SESSAO_INEXISTENTE;
+    }
+
+    pthread_mutex_lock(&trava_sessoes);
+    long instante = agora();
+    int indice = buscarEntrada(token);
+    if (indice != 0) {
+        if (sessoes[indice - 1].dados.expira <= instante) {
+            removerEntrada(indice);
+            resultado = SESSAO_EXPIRADA;
+        } else {
+            sessoes[indice - 1].ultimo_uso = instante;
+            if (destino != NULL) {
+                *destino = sessoes[indice - 1].dados;
+            }
+            resultado = SESSAO_VALIDA;
+        }
+    }
+    pthread_mutex_unlock(&trava_sessoes);
+    return resultado;
+}
+
+int encerrarSessaoToken(const char *token) {
+    if (token == NULL || token[0] == '\0') {
+        return 0;
+    }
+
+    pthread_mutex_lock(&trava_sessoes);
+    int indice = buscarEntrada(token);
+    if (indice != 0) {
+        removerEntrada(indice);
+    }
+    pthread_mutex_unlock(&trava_sessoes);
+    return indice != 0;
+}
+
+int invalidarSessoesUsuario(int id_usuario) {
+    int invalidadas = 0;
+
+    pthread_mutex_lock(&trava_sessoes);
+    for (int i = 1; i <= proxima_nunca_usada; i++) {
+        if (sessoes[i - 1].em_uso && sessoes[i - 1].dados.id_usuario == id_usuario) {
+            removerEntrada(i);
+            invalidadas++;
+        }
+    }
+    pthread_mutex_unlock(&trava_sessoes);
+    return invalidadas;
+}
+
+int totalSessoesAtivas(void) {
+    pthread_mutex_lock(&trava_sessoes);
+    avancarRoda(agora());
+    int total = total_ativas;
+    pthread_mutex_unlock(&trava_sessoes);
+    return total;
+}
+
+void definirRelogioSessoes(long (*relogio)(void)) {
+    pthread_mutex_lock(&trava_sessoes);
+    relogio_sessoes = relogio;
+    minuto_processado = -1;
+    pthread_mutex_unlock(&trava_sessoes);
+}
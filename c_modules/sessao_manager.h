@@ -0,0 +1,69 @@
+#ifndef SESSAO_MANAGER_H
+#define SESSAO_MANAGER_H
+
+#include "structs.h"
+
+// ========== TABELA DE SESSÕES EM MEMÓRIA ==========
+//
+// Cada login bem-sucedido recebe um token aleatório (128 bits em hexadecimal)
+// registrado em uma tabela hash do processo. Validar um token é uma busca na
+// tabela, sem ler usuarios.csv nem chamar o sistema.
+//
+// A expiração usa uma roda de tempo: a fatia de cada minuto guarda as sessões
+// que vencem nele. A cada operação a roda avança até o minuto atual e libera
+// o que venceu, sem percorrer a tabela inteira.
+//
+// excluirUsuario(), resetarSenha() e a desativação por atualizarUsuario()
+// invalidam na hora todas as sessões do usuário neste processo.
+//
+// Uma conta não monopoliza a tabela: passando de SESSOES_POR_USUARIO, o novo
+// login encerra a sessão mais antiga do mesmo usuário. Com a tabela cheia, a
+// sessão usada (validada) há mais tempo dá lugar à nova. As duas buscas
+// percorrem a tabela, o que só acontece no login.
+
+#define SESSOES_MAX 1024               // Sessões simultâneas
+#define SESSOES_POR_USUARIO 8          // Acima disso, a mais antiga do usuário sai
+#define SESSAO_DURACAO_S 28800         // 8 horas
+#define SESSAO_TAM_TOKEN 33            // 32 dígitos hexadecimais + '\0'
+
+// Resultado da validação
+#define SESSAO_INEXISTENTE 0           // Token desconhecido, encerrado ou invalidado
+#define SESSAO_VALIDA 1
+#define SESSAO_EXPIRADA -1             // Passou de SESSAO_DURACAO_S
+
+// Dados guardados para cada token
+typedef struct {
+    char token[SESSAO_TAM_TOKEN];
+    int id_usuario;
+    char login[MAX_LOGIN];
+    char tipo[20];
+    long criada;               // Segundos desde 1970
+    long expira;
+} DadosSessao;
+
+// Função para abrir uma sessão para o usuário (pode encerrar a mais antiga
+// dele ou, com a tabela cheia, a usada há mais tempo)
+// Retorna: 1 se criada (token em destino->token), 0 se não há fonte de
+// aleatoriedade
+int criarSessaoServidor(int id_usuario, const char *login, const char *tipo, DadosSessao *destino);
+
+// Função para validar um token (destino pode ser NULL)
+// Retorna: SESSAO_VALIDA, SESSAO_EXPIRADA ou SESSAO_INEXISTENTE
+int validarTokenSessao(const char *token, DadosSessao *destino);
+
+// Função para encerrar a sessão de um token (logout)
+// Retorna: 1 se existia, 0 caso contrário
+int encerrarSessaoToken(const char *token);
+
+// Função para invalidar todas as sessões de um usuário
+// Retorna: quantidade de sessões invalidadas
+int invalidarSessoesUsuario(int id_usuario);
+
+// Função para contar as sessões ainda não vencidas
+int totalSessoesAtivas(void);
+
+// Função para trocar o relógio usado nas expirações (NULL volta a time())
+// Usada pelos testes para simular a passagem das 8 horas
+void definirRelogioSessoes(long (*relogio)(void));
+
+#endif
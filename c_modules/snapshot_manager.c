@@ -0,0 +1,196 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include "snapshot_manager.h"
+
+// ========== FUNÇÕES AUXILIARES PRIVADAS ==========
+
+// Fatia dos contadores usada por esta thread (distribuída em rodízio)
+static _Thread_local int fatia_thread = -1;
+static atomic_uint proxima_fatia = 0;
+
+static int fatiaDaThread(void) {
+    if (fatia_thread < 0) {
+        fatia_thread = (int)(atomic_fetch_add(&proxima_fatia, 1) % SNAPSHOT_FATIAS);
+    }
+    return fatia_thread;
+}
+
+static int somarFatias(ContadorFatia *fatias) {
+    int soma = 0;
+    for (int i = 0; i < SNAPSHOT_FATIAS; i++) {
+        soma += atomic_load(&fatias[i].valor);
+    }
+    return soma;
+}
+
+static void liberarBloco(BlocoSnapshot *bloco) {
+    if (atomic_fetch_sub(&bloco->referencias, 1) == 1) {
+        free(bloco);
+    }
+}
+
+// Libera uma versão que nenhum leitor pode mais alcançar
+static void destruirSnapshot(Snapshot *snapshot) {
+    for (int i = 0; i < snapshot->total_blocos; i++) {
+        liberarBloco(snapshot->blocos[i]);
+    }
+    free(snapshot->blocos);
+    free(snapshot);
+}
+
+// Cria um bloco novo com a cópia dos registros informados
+static BlocoSnapshot* criarBloco(const unsigned char *origem, int total, size_t tam_registro) {
+    BlocoSnapshot *bloco = malloc(sizeof(BlocoSnapshot) + (size_t)total * tam_registro);
+    if (bloco == NULL) {
+        return NULL;
+    }
+
+    atomic_init(&bloco->referencias, 1);
+    bloco->total = total;
+    memcpy(bloco->dados, origem, (size_t)total * tam_registro);
+    return bloco;
+}
+
+// Espera todos os leitores que podem ter visto a versão anterior
+static void aguardarPeriodoDeGraca(TabelaSnapshot *tabela) {
+    unsigned int epoca = atomic_load(&tabela->epoca);
+
+    atomic_store(&tabela->epoca, epoca + 1);
+    while (somarFatias(tabela->leitores[epoca & 1]) != 0) {
+        sched_yield();
+    }
+}
+
+// Libera as versões retiradas que nenhum leitor segura mais (exige "escritor")
+// Depois da retirada ninguém incrementa as fatias, então a soma só diminui
+static void recolherRetiradas(TabelaSnapshot *tabela) {
+    Snapshot **ligacao = &tabela->retiradas;
+
+    while (*ligacao != NULL) {
+        Snapshot *retirada = *ligacao;
+        if (somarFatias(retirada->referencias) == 0) {
+            *ligacao = retirada->proxima_retirada;
+            destruirSnapshot(retirada);
+        } else {
+            ligacao = &retirada->proxima_retirada;
+        }
+    }
+}
+
+// ========== FUNÇÕES DE LEITURA ==========
+
+Snapshot* adquirirSnapshot(TabelaSnapshot *tabela) {
+    int fatia = fatiaDaThread();
+    unsigned int epoca;
+    Snapshot *snapshot;
+
+    // Entra na paridade corrente; se a época virou no meio, tenta de novo
+    for (;;) {
+        epoca = atomic_load(&tabela->epoca);
+        atomic_fetch_add(&tabela->leitores[epoca & 1][fatia].valor, 1);
+        if (atomic_load(&tabela->epoca) == epoca) {
+            break;
+        }
+        atomic_fetch_sub(&tabela->leitores[epoca & 1][fatia].valor, 1);
+    }
+
+    // Dentro da paridade a versão lida não pode ser retirada pelo escritor
+    snapshot = atomic_load(&tabela->atual);
+    if (snapshot != NULL) {
+        atomic_fetch_add(&snapshot->referencias[fatia].valor, 1);
+    }
+
+    atomic_fetch_sub(&tabela->leitores[epoca & 1][fatia].valor, 1);
+    return snapshot;
+}
+
+void liberarSnapshot(Snapshot *snapshot) {
+    if (snapshot == NULL) {
+        return;
+    }
+
+    // Só a soma das fatias importa: devolver em outra thread deixa uma fatia
+    // negativa e a outra positiva, sem que a versão seja liberada antes da hora
+    atomic_fetch_sub(&snapshot->referencias[fatiaDaThread()].valor, 1);
+}
+
+int totalRegistrosSnapshot(const Snapshot *snapshot) {
+    return snapshot ? snapshot->total_registros : 0;
+}
+
+const void* registroSnapshot(const Snapshot *snapshot, int indice) {
+    const BlocoSnapshot *bloco = snapshot->blocos[indice / REGISTROS_POR_BLOCO];
+    return bloco->dados + (size_t)(indice % REGISTROS_POR_BLOCO) * snapshot->tam_registro;
+}
+
+// ========== FUNÇÕES DE ESCRITA ==========
+
+int publicarSnapshot(TabelaSnapshot *tabela, const void *registros, int total) {
+    const unsigned char *origem = (const unsigned char *)registros;
+    size_t tam = tabela->tam_registro;
+
+    pthread_mutex_lock(&tabela->escritor);
+
+    Snapshot *anterior = atomic_load(&tabela->atual);
+    Snapshot *novo = malloc(sizeof(Snapshot));
+    int total_blocos = (total + REGISTROS_POR_BLOCO - 1) / REGISTROS_POR_BLOCO;
+
+    if (novo == NULL) {
+        pthread_mutex_unlock(&tabela->escritor);
+        return 0;
+    }
+
+    novo->blocos = calloc(total_blocos > 0 ? (size_t)total_blocos : 1, sizeof(BlocoSnapshot *));
+    if (novo->blocos == NULL) {
+        free(novo);
+        pthread_mutex_unlock(&tabela->escritor);
+        return 0;
+    }
+
+    for (int i = 0; i < SNAPSHOT_FATIAS; i++) {
+        atomic_init(&novo->referencias[i].valor, 0);
+    }
+    novo->proxima_retirada = NULL;
+    novo->versao = anterior ? anterior->versao + 1 : 1;
+    novo->total_registros = total;
+    novo->total_blocos = total_blocos;
+    novo->tam_registro = tam;
+
+    // Copy-on-write: só os blocos alterados são copiados
+    for (int b = 0; b < total_blocos; b++) {
+        int inicio = b * REGISTROS_POR_BLOCO;
+        int qtd = (total - inicio < REGISTROS_POR_BLOCO) ? total - inicio : REGISTROS_POR_BLOCO;
+        BlocoSnapshot *velho = (anterior && b < anterior->total_blocos) ? anterior->blocos[b] : NULL;
+
+        if (velho != NULL && velho->total == qtd &&
+            memcmp(velho->dados, origem + (size_t)inicio * tam, (size_t)qtd * tam) == 0) {
+            atomic_fetch_add(&velho->referencias, 1);
+            novo->blocos[b] = velho;
+            continue;
+        }
+
+        novo->blocos[b] = criarBloco(origem + (size_t)inicio * tam, qtd, tam);
+        if (novo->blocos[b] == NULL) {
+            novo->total_blocos = b;
+            destruirSnapshot(novo);
+            pthread_mutex_unlock(&tabela->escritor);
+            return 0;
+        }
+    }
+
+    atomic_store(&tabela->atual, novo);
+
+    // A anterior só é retirada após o período de graça; quem já a adquiriu
+    // continua com ela até devolver
+    if (anterior != NULL) {
+        aguardarPeriodoDeGraca(tabela);
+        anterior->proxima_retirada = tabela->retiradas;
+        tabela->retiradas = anterior;
+    }
+    recolherRetiradas(tabela);
+
+    pthread_mutex_unlock(&tabela->escritor);
+    return 1;
+}
@@ -0,0 +1,89 @@
+#ifndef SNAPSHOT_MANAGER_H
+#define SNAPSHOT_MANAGER_H
+
+#include <stddef.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+// ========== SNAPSHOTS IMUTÁVEIS (ESTILO RCU) ==========
+//
+// Leitores obtêm uma versão imutável da tabela sem nunca esperar por escritores.
+// O escritor monta uma nova versão reaproveitando os blocos que não mudaram
+// (copy-on-write por bloco), publica com troca atômica de ponteiro e só libera
+// a versão antiga depois que nenhum leitor pode mais estar adquirindo-a.
+//
+// Os contadores de leitores são fatiados: cada thread usa sempre a mesma
+// fatia, e cada fatia ocupa uma linha de cache própria, de modo que leitores
+// em threads diferentes não disputam a mesma linha. Só o escritor soma as
+// fatias. Uma versão substituída vai para a lista de retiradas e é liberada
+// numa publicação seguinte, quando a soma das suas referências chega a zero
+// (adquirir e devolver podem acontecer em threads diferentes).
+
+#define REGISTROS_POR_BLOCO 128
+#define SNAPSHOT_FATIAS 16     // Fatias dos contadores de leitores
+#define LINHA_CACHE 64
+
+// Contador de uma fatia, sozinho na sua linha de cache
+typedef struct {
+    atomic_int valor;
+    char preenchimento[LINHA_CACHE - sizeof(atomic_int)];
+} ContadorFatia;
+
+// Bloco de registros compartilhado entre versões consecutivas
+// (as referências dos blocos só são alteradas pelo escritor)
+typedef struct {
+    atomic_int referencias;    // Versões que apontam para este bloco
+    int total;                 // Registros válidos no bloco
+    unsigned char dados[];     // total * tam_registro bytes
+} BlocoSnapshot;
+
+// Versão imutável de uma tabela
+typedef struct Snapshot {
+    unsigned long versao;      // Incrementada a cada publicação
+    int total_registros;
+    int total_blocos;
+    size_t tam_registro;
+    BlocoSnapshot **blocos;
+    struct Snapshot *proxima_retirada; // Lista de versões à espera de liberação
+    char separador[LINHA_CACHE];
+    ContadorFatia referencias[SNAPSHOT_FATIAS]; // Leitores (a soma pode ser lida só após a retirada)
+} Snapshot;
+
+// Ponto de publicação de snapshots de uma tabela
+typedef struct {
+    _Atomic(Snapshot *) atual; // Versão publicada (NULL antes da primeira carga)
+    atomic_uint epoca;         // Paridade usada no período de graça
+    pthread_mutex_t escritor;  // Serializa publicações
+    size_t tam_registro;
+    Snapshot *retiradas;       // Versões substituídas ainda referenciadas (sob "escritor")
+    char separador[LINHA_CACHE];
+    ContadorFatia leitores[2][SNAPSHOT_FATIAS]; // Leitores adquirindo em cada paridade
+} TabelaSnapshot;
+
+#define TABELA_SNAPSHOT_INIT(tipo) \
+    { NULL, 0, PTHREAD_MUTEX_INITIALIZER, sizeof(tipo), NULL, { 0 }, { { { 0 } } } }
+
+// ========== FUNÇÕES DE LEITURA (NUNCA BLOQUEIAM) ==========
+
+// Função para adquirir a versão publicada da tabela
+// Retorna: snapshot com referência própria ou NULL se nada foi publicado
+Snapshot* adquirirSnapshot(TabelaSnapshot *tabela);
+
+// Função para devolver um snapshot adquirido (pode ser em outra thread)
+void liberarSnapshot(Snapshot *snapshot);
+
+// Função para contar os registros de um snapshot
+// Retorna: total de registros (0 se o snapshot for NULL)
+int totalRegistrosSnapshot(const Snapshot *snapshot);
+
+// Função para acessar o i-ésimo registro de um snapshot
+const void* registroSnapshot(const Snapshot *snapshot, int indice);
+
+// ========== FUNÇÕES DE ESCRITA ==========
+
+// Função para publicar o conteúdo atual de um array como nova versão
+// Blocos idênticos aos da versão anterior são reaproveitados.
+// Retorna: 1 se sucesso, 0 se faltou memória (a versão anterior é mantida)
+int publicarSnapshot(TabelaSnapshot *tabela, const void *registros, int total);
+
+#endif
@@ -48,6 +48,13 @@ typedef struct {
     char path_arquivo[MAX_PATH]; // Caminho do arquivo (se houver)
 } Atividade;
 
+// Estrutura para representar a nota de um aluno em uma atividade
+typedef struct {
+    int ra;                    // FK: RA do aluno
+    int id_atividade;          // FK: ID da atividade
+    float nota;                // 0 a 10
+} Nota;
+
 // Estrutura para representar um Usuário
 typedef struct {
     int id;                    // ID único do usuário
@@ -0,0 +1,986 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/stat.h>
+#include "tabela_manager.h"
+#include "journal_manager.h"
+#include "alteracoes_manager.h"
+#include "persistencia_manager.h"
+#include "structs.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#include <process.h>
+#define getpid _getpid
+#define fsync _commit
+#else
+#include <unistd.h>
+#include <sys/file.h>
+#endif
+
+// Posição da região travada no Windows (fora dos bytes do contador de geração)
+#define OFFSET_TRAVA_WINDOWS 0x40000000UL
+#define TAM_GERACAO 21
+
+// Tabelas que registram alterações (uma por CSV do sistema)
+#define MAX_TABELAS_ADIADAS 16
+
+// Estado da gravação adiada (protegido por trava_adiada)
+static pthread_mutex_t trava_adiada = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sinal_descarregador = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t sinal_barreira = PTHREAD_COND_INITIALIZER;
+static pthread_t descarregador;
+static int adiada_ativa = 0;
+static int adiada_encerrando = 0;
+static int intervalo_adiado_ms = 0;
+static int limite_adiado = 0;
+static TabelaResidente *tabelas_sujas[MAX_TABELAS_ADIADAS];
+static int total_sujas = 0;
+static int alteracoes_pendentes = 0;
+static unsigned long long barreiras_pedidas = 0;
+static unsigned long long barreiras_atendidas = 0;
+static EstatisticasGravacaoAdiada estatisticas_adiadas = {0, 0, 0};
+static int falhas_adiadas = 0; // Tabelas que a última rodada não conseguiu gravar
+
+// Gravações feitas pelo descarregador também sincronizam o conteúdo em disco
+static volatile int escrita_duravel = 0;
+
+// Descarregador com o motor de persistência: o CSV é formatado em memória e o
+// motor faz escrita, fsync e rename enquanto a trava exclusiva segue obtida
+typedef struct {
+    FILE *fluxo;
+    char *conteudo;
+    size_t tamanho;
+} GravacaoMotor;
+
+static _Thread_local GravacaoMotor *gravacao_motor = NULL;
+static int motor_adiado = 0;       // O descarregador entrega as gravações ao motor
+static int motor_proprio = 0;      // O motor foi iniciado pela gravação adiada
+
+// Ação adiada para depois da publicação (ver aposConfirmarTransacaoTabelas)
+typedef struct {
+    int (*acao)(int);
+    int valor;
+} AcaoTransacao;
+
+// Transação em andamento (uma por processo; a thread dona a acha pela chave)
+typedef struct {
+    TabelaResidente *tabelas[MAX_TABELAS_TRANSACAO]; // Travadas até o fim, na ordem de abertura
+    int alteradas[MAX_TABELAS_TRANSACAO];
+    int total;
+    char gravados[MAX_TABELAS_TRANSACAO][MAX_PATH];  // Temporários prontos para o journal
+    int total_gravados;
+    int confirmando;           // 1 enquanto as tabelas alteradas gravam seus temporários
+    int aninhadas;             // Inícios internos ainda não concluídos
+    int desistida;             // Uma transação interna desistiu: a externa não publica
+    unsigned long numero;      // Distinto a cada transação (ver numeroTransacaoTabelas)
+    AcaoTransacao *acoes;
+    int total_acoes;
+    int capacidade_acoes;
+} Transacao;
+
+static pthread_mutex_t trava_transacao = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t chave_transacao_criada = PTHREAD_ONCE_INIT;
+static pthread_key_t chave_transacao;
+static Transacao transacao_atual;
+static unsigned long transacoes_iniciadas = 0;  // Protegido por trava_transacao
+
+static void criarChaveTransacao(void) {
+    pthread_key_create(&chave_transacao, NULL);
+}
+
+// Transação da thread atual (NULL se não há)
+static Transacao* transacaoDaThread(void) {
+    pthread_once(&chave_transacao_criada, criarChaveTransacao);
+    return (Transacao*)pthread_getspecific(chave_transacao);
+}
+
+// Posição da tabela na transação (-1 se ainda não participa)
+static int posicaoNaTransacao(const Transacao *transacao, const TabelaResidente *tabela) {
+    for (int i = 0; i < transacao->total; i++) {
+        if (transacao->tabelas[i] == tabela) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// ========== TRAVAS DE ARQUIVO ENTRE PROCESSOS ==========
+
+// Abre "<arquivo>.lock" para este processo (reabre após fork)
+static int garantirDescritor(TravaArquivo *trava, const char *arquivo) {
+    char caminho[MAX_PATH + 8];
+    long pid = (long)getpid();
+
+    if (trava->pid == pid && trava->descritor >= 0) {
+        return 1;
+    }
+
+    // O descritor herdado do processo pai compartilha a trava com ele
+    if (trava->descritor >= 0) {
+        close(trava->descritor);
+    }
+
+    snprintf(caminho, sizeof(caminho), "%s.lock", arquivo);
+    trava->descritor = open(caminho, O_RDWR | O_CREAT, 0644);
+    trava->pid = pid;
+
+    return trava->descritor >= 0;
+}
+
+int travarArquivo(TravaArquivo *trava, const char *arquivo, int modo) {
+    int exclusiva = (modo & TRAVA_EXCLUSIVA) != 0;
+    int sem_espera = (modo & TRAVA_SEM_ESPERA) != 0;
+
+    if (!garantirDescritor(trava, arquivo)) {
+        return 0;
+    }
+
+#ifdef _WIN32
+    OVERLAPPED regiao;
+    DWORD flags = 0;
+    memset(&regiao, 0, sizeof(regiao));
+    regiao.Offset = OFFSET_TRAVA_WINDOWS;
+    if (exclusiva) {
+        flags |= LOCKFILE_EXCLUSIVE_LOCK;
+    }
+    if (sem_espera) {
+        flags |= LOCKFILE_FAIL_IMMEDIATELY;
+    }
+    return LockFileEx((HANDLE)_get_osfhandle(trava->descritor), flags, 0, 1, 0, &regiao) != 0;
+#else
+    int operacao = exclusiva ? LOCK_EX : LOCK_SH;
+    if (sem_espera) {
+        operacao |= LOCK_NB;
+    }
+    return flock(trava->descritor, operacao) == 0;
+#endif
+}
+
+void destravarArquivo(TravaArquivo *trava) {
+    if (trava->descritor < 0) {
+        return;
+    }
+
+#ifdef _WIN32
+    OVERLAPPED regiao;
+    memset(&regiao, 0, sizeof(regiao));
+    regiao.Offset = OFFSET_TRAVA_WINDOWS;
+    UnlockFileEx((HANDLE)_get_osfhandle(trava->descritor), 0, 1, 0, &regiao);
+#else
+    flock(trava->descritor, LOCK_UN);
+#endif
+}
+
+long long lerGeracaoArquivo(TravaArquivo *trava) {
+    char buffer[TAM_GERACAO + 1];
+    long lidos = 0;
+
+    if (trava->descritor < 0) {
+        return 0;
+    }
+
+#ifdef _WIN32
+    OVERLAPPED posicao;
+    DWORD qtd = 0;
+    memset(&posicao, 0, sizeof(posicao));
+    if (ReadFile((HANDLE)_get_osfhandle(trava->descritor), buffer, TAM_GERACAO, &qtd, &posicao)) {
+        lidos = (long)qtd;
+    }
+#else
+    lidos = (long)pread(trava->descritor, buffer, TAM_GERACAO, 0);
+#endif
+
+    if (lidos <= 0) {
+        return 0;
+    }
+    buffer[lidos] = '\0';
+    return atoll(buffer);
+}
+
+void incrementarGeracaoArquivo(TravaArquivo *trava) {
+    avancarGeracaoArquivo(trava, 1);
+}
+
+void avancarGeracaoArquivo(TravaArquivo *trava, long long quantidade) {
+    char buffer[TAM_GERACAO + 1];
+
+    if (trava->descritor < 0) {
+        return;
+    }
+
+    snprintf(buffer, sizeof(buffer), "%020lld\n", lerGeracaoArquivo(trava) + quantidade);
+
+#ifdef _WIN32
+    OVERLAPPED posicao;
+    DWORD qtd = 0;
+    memset(&posicao, 0, sizeof(posicao));
+    WriteFile((HANDLE)_get_osfhandle(trava->descritor), buffer, TAM_GERACAO, &qtd, &posicao);
+#else
+    if (pwrite(trava->descritor, buffer, TAM_GERACAO, 0) != TAM_GERACAO) {
+        printf("Aviso: falha ao atualizar geração do arquivo de trava.\n");
+    }
+#endif
+}
+
+// ========== GRAVAÇÃO ATÔMICA ==========
+
+FILE* abrirEscritaAtomica(const char *arquivo) {
+    char temporario[MAX_PATH + 8];
+
+#ifndef _WIN32
+    // Descarregador: o conteúdo vai para a memória e depois para o motor
+    if (gravacao_motor != NULL && gravacao_motor->fluxo == NULL) {
+        gravacao_motor->conteudo = NULL;
+        gravacao_motor->tamanho = 0;
+        gravacao_motor->fluxo = open_memstream(&gravacao_motor->conteudo, &gravacao_motor->tamanho);
+        return gravacao_motor->fluxo;
+    }
+#endif
+
+    snprintf(temporario, sizeof(temporario), "%s.tmp", arquivo);
+    return fopen(temporario, "w");
+}
+
+// Entrega o conteúdo formatado ao motor e espera a conclusão (o chamador
+// continua com a trava exclusiva até o rename acontecer)
+static int concluirPeloMotor(GravacaoMotor *gravacao, const char *arquivo) {
+    FilaConclusoes fila;
+    ConclusaoGravacao conclusao;
+    int ok = (fclose(gravacao->fluxo) == 0);
+
+    gravacao->fluxo = NULL;
+    if (!ok) {
+        free(gravacao->conteudo);
+        return 0;
+    }
+    prepararAlteracoesConteudo(arquivo, gravacao->conteudo, gravacao->tamanho);
+
+    inicializarFilaConclusoes(&fila);
+    ok = submeterGravacao(arquivo, gravacao->conteudo, gravacao->tamanho, &fila, NULL) != 0;
+    if (ok) {
+        aguardarConclusao(&fila, &conclusao);
+        ok = (conclusao.resultado == 0);
+    }
+    destruirFilaConclusoes(&fila);
+
+    if (!ok) {
+        descartarAlteracoesTabela(arquivo);
+    }
+    return ok;
+}
+
+// Confirmação de transação: o temporário fica sincronizado à espera do journal
+static int guardarTemporario(Transacao *transacao, FILE *temporario, const char *caminho_tmp,
+                             const char *arquivo) {
+    int ok = (fflush(temporario) == 0) && (fsync(fileno(temporario)) == 0);
+    ok = (fclose(temporario) == 0) && ok;
+    if (!ok) {
+        remove(caminho_tmp);
+        return 0;
+    }
+    prepararAlteracoesTabela(arquivo);
+
+    for (int i = 0; i < transacao->total_gravados; i++) {
+        if (strcmp(transacao->gravados[i], arquivo) == 0) {
+            return 1;
+        }
+    }
+    if (transacao->total_gravados >= MAX_TABELAS_TRANSACAO) {
+        remove(caminho_tmp);
+        return 0;
+    }
+    snprintf(transacao->gravados[transacao->total_gravados++], MAX_PATH, "%s", arquivo);
+    return 1;
+}
+
+int concluirEscritaAtomica(FILE *temporario, const char *arquivo) {
+    char caminho_tmp[MAX_PATH + 8];
+    Transacao *transacao = transacaoDaThread();
+    int ok;
+
+    snprintf(caminho_tmp, sizeof(caminho_tmp), "%s.tmp", arquivo);
+
+    if (transacao != NULL && transacao->confirmando) {
+        return guardarTemporario(transacao, temporario, caminho_tmp, arquivo);
+    }
+    if (gravacao_motor != NULL && temporario == gravacao_motor->fluxo) {
+        return concluirPeloMotor(gravacao_motor, arquivo);
+    }
+
+    ok = (fflush(temporario) == 0);
+    if (ok && escrita_duravel) {
+        ok = (fsync(fileno(temporario)) == 0);
+    }
+    ok = (fclose(temporario) == 0) && ok;
+    if (!ok) {
+        remove(caminho_tmp);
+        return 0;
+    }
+    prepararAlteracoesTabela(arquivo);
+
+#ifdef _WIN32
+    ok = MoveFileExA(caminho_tmp, arquivo, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    ok = rename(caminho_tmp, arquivo) == 0;
+#endif
+
+    if (!ok) {
+        remove(caminho_tmp);
+        descartarAlteracoesTabela(arquivo);
+    }
+    return ok;
+}
+
+void abandonarEscritaAtomica(FILE *temporario, const char *arquivo) {
+    char caminho_tmp[MAX_PATH + 8];
+
+    if (gravacao_motor != NULL && temporario == gravacao_motor->fluxo) {
+        fclose(temporario);
+        free(gravacao_motor->conteudo);
+        gravacao_motor->fluxo = NULL;
+        return;
+    }
+
+    snprintf(caminho_tmp, sizeof(caminho_tmp), "%s.tmp", arquivo);
+    fclose(temporario);
+    remove(caminho_tmp);
+}
+
+// ========== FUNÇÕES AUXILIARES PRIVADAS ==========
+
+// Lê a assinatura atual do arquivo (mtime + tamanho + geração)
+static void lerAssinatura(TabelaResidente *tabela, AssinaturaArquivo *assinatura) {
+    struct stat info;
+
+    assinatura->geracao = lerGeracaoArquivo(&tabela->trava_arquivo);
+
+    if (stat(tabela->arquivo, &info) != 0) {
+        assinatura->mtime_ns = 0;
+        assinatura->tamanho = -1;
+        return;
+    }
+
+#if defined(_WIN32)
+    assinatura->mtime_ns = (long long)info.st_mtime * 1000000000LL;
+#elif defined(__APPLE__)
+    assinatura->mtime_ns = (long long)info.st_mtimespec.tv_sec * 1000000000LL +
+                           info.st_mtimespec.tv_nsec;
+#else
+    assinatura->mtime_ns = (long long)info.st_mtim.tv_sec * 1000000000LL +
+                           info.st_mtim.tv_nsec;
+#endif
+    assinatura->tamanho = (long long)info.st_size;
+}
+
+// Verifica se o CSV precisa ser relido
+static int tabelaDesatualizada(TabelaResidente *tabela) {
+    AssinaturaArquivo atual;
+
+    // Alterações adiadas: a memória é mais nova que o CSV
+    if (tabela->alteracoes > 0 && tabela->trava_arquivo.pid == (long)getpid()) {
+        return 0;
+    }
+
+    // Primeira carga ou processo filho que ainda não abriu sua própria trava
+    if (!tabela->carregada || tabela->trava_arquivo.pid != (long)getpid()) {
+        return 1;
+    }
+
+    lerAssinatura(tabela, &atual);
+    return atual.mtime_ns != tabela->assinatura.mtime_ns ||
+           atual.tamanho != tabela->assinatura.tamanho ||
+           atual.geracao != tabela->assinatura.geracao;
+}
+
+// Recarrega o array do módulo (exige trava de escrita da tabela)
+// Retorna: 1 se recarregou, 0 se a trava do arquivo estava ocupada (sem_espera)
+static int recarregarTabela(TabelaResidente *tabela, int sem_espera) {
+    int travou = 0;
+
+    // O escritor já detém a trava exclusiva; os demais leem sob trava compartilhada
+    if (!tabela->exclusiva) {
+        travou = travarArquivo(&tabela->trava_arquivo, tabela->arquivo,
+                               TRAVA_COMPARTILHADA | (sem_espera ? TRAVA_SEM_ESPERA : 0));
+        if (!travou && sem_espera && tabela->trava_arquivo.descritor >= 0) {
+            return 0;
+        }
+    }
+
+    tabela->carregar();
+    lerAssinatura(tabela, &tabela->assinatura);
+    tabela->carregada = 1;
+
+    if (travou) {
+        destravarArquivo(&tabela->trava_arquivo);
+    }
+    return 1;
+}
+
+// Trava de escrita + trava exclusiva do CSV, relendo-o se mudou
+static void travarParaEscrita(TabelaResidente *tabela) {
+    pthread_rwlock_wrlock(&tabela->trava);
+
+    // A trava exclusiva cobre todo o ciclo leitura-modificação-escrita
+    tabela->exclusiva = travarArquivo(&tabela->trava_arquivo, tabela->arquivo, TRAVA_EXCLUSIVA);
+
+    if (tabelaDesatualizada(tabela)) {
+        recarregarTabela(tabela, 0);
+    }
+}
+
+// Solta as travas de travarParaEscrita/abrirLeituraTabela
+static void liberarTabela(TabelaResidente *tabela) {
+    // Só o escritor (trava exclusiva da tabela) pode ter exclusiva = 1
+    if (tabela->exclusiva) {
+        tabela->exclusiva = 0;
+        destravarArquivo(&tabela->trava_arquivo);
+    }
+    pthread_rwlock_unlock(&tabela->trava);
+}
+
+// Em transação, a primeira abertura trava a tabela até o fim dela
+// Retorna: 1 se a tabela está na transação da thread, 0 se segue o caminho normal
+static int abrirNaTransacao(TabelaResidente *tabela) {
+    Transacao *transacao = transacaoDaThread();
+
+    if (transacao == NULL) {
+        return 0;
+    }
+    if (posicaoNaTransacao(transacao, tabela) >= 0) {
+        return 1;
+    }
+    if (transacao->total >= MAX_TABELAS_TRANSACAO) {
+        return 0;
+    }
+
+    travarParaEscrita(tabela);
+    transacao->tabelas[transacao->total] = tabela;
+    transacao->alteradas[transacao->total] = 0;
+    transacao->total++;
+    return 1;
+}
+
+// ========== IMPLEMENTAÇÃO DAS FUNÇÕES PÚBLICAS ==========
+
+void abrirLeituraTabela(TabelaResidente *tabela) {
+    if (abrirNaTransacao(tabela)) {
+        return;
+    }
+
+    pthread_rwlock_rdlock(&tabela->trava);
+
+    // Caminho rápido: a tabela em memória ainda reflete o CSV
+    while (tabelaDesatualizada(tabela)) {
+        pthread_rwlock_unlock(&tabela->trava);
+
+        pthread_rwlock_wrlock(&tabela->trava);
+        if (tabelaDesatualizada(tabela)) {
+            recarregarTabela(tabela, 0);
+        }
+        pthread_rwlock_unlock(&tabela->trava);
+
+        pthread_rwlock_rdlock(&tabela->trava);
+    }
+}
+
+void abrirEscritaTabela(TabelaResidente *tabela) {
+    if (abrirNaTransacao(tabela)) {
+        return;
+    }
+    travarParaEscrita(tabela);
+}
+
+int sincronizarTabelaSemBloquear(TabelaResidente *tabela) {
+    int desatualizada;
+    int verificada = 1;
+
+    if (pthread_rwlock_tryrdlock(&tabela->trava) != 0) {
+        return 0;
+    }
+    desatualizada = tabelaDesatualizada(tabela);
+    pthread_rwlock_unlock(&tabela->trava);
+
+    if (!desatualizada) {
+        return 1;
+    }
+
+    if (pthread_rwlock_trywrlock(&tabela->trava) != 0) {
+        return 0;
+    }
+    if (tabelaDesatualizada(tabela)) {
+        verificada = recarregarTabela(tabela, 1);
+    }
+    pthread_rwlock_unlock(&tabela->trava);
+    return verificada;
+}
+
+void fecharTabela(TabelaResidente *tabela) {
+    Transacao *transacao = transacaoDaThread();
+
+    // Tabelas da transação ficam travadas até concluirTransacaoTabelas()
+    if (transacao != NULL && posicaoNaTransacao(transacao, tabela) >= 0) {
+        return;
+    }
+    liberarTabela(tabela);
+}
+
+void marcarTabelaSalva(TabelaResidente *tabela) {
+    Transacao *transacao = transacaoDaThread();
+
+    // Confirmação: o temporário ainda não foi publicado; a transação marca depois
+    if (transacao != NULL && transacao->confirmando) {
+        return;
+    }
+
+    // As operações entram no log com a geração nova, ainda sob a trava exclusiva
+    if (tabela->exclusiva) {
+        incrementarGeracaoArquivo(&tabela->trava_arquivo);
+        registrarAlteracoesTabela(tabela->arquivo, lerGeracaoArquivo(&tabela->trava_arquivo));
+    } else {
+        descartarAlteracoesTabela(tabela->arquivo);
+    }
+    lerAssinatura(tabela, &tabela->assinatura);
+    tabela->carregada = 1;
+}
+
+void invalidarTabela(TabelaResidente *tabela) {
+    Transacao *transacao = transacaoDaThread();
+
+    // Já travada pela transação: relê agora
+    if (transacao != NULL && posicaoNaTransacao(transacao, tabela) >= 0) {
+        recarregarTabela(tabela, 0);
+        return;
+    }
+
+    pthread_rwlock_wrlock(&tabela->trava);
+    tabela->carregada = 0;
+    pthread_rwlock_unlock(&tabela->trava);
+}
+
+// ========== GRAVAÇÃO ADIADA (WRITE-BEHIND) ==========
+
+// Grava a tabela se ainda houver alterações pendentes (descarregador)
+// Retorna: 1 se gravou, 0 se não havia o que gravar, -1 se a gravação falhou
+// (as alterações continuam pendentes para a próxima rodada)
+static int gravarTabelaPendente(TabelaResidente *tabela) {
+    int gravou = 0;
+
+    pthread_rwlock_wrlock(&tabela->trava);
+    if (tabela->alteracoes > 0) {
+        // Mesma trava exclusiva do ciclo leitura-modificação-escrita, sem recarga
+        tabela->exclusiva = travarArquivo(&tabela->trava_arquivo, tabela->arquivo, TRAVA_EXCLUSIVA);
+        int salvo = 0;
+        if (tabela->exclusiva) {
+            // Com o motor ativo, salvar() só retorna depois do rename (trava ainda obtida)
+            GravacaoMotor gravacao = {NULL, NULL, 0};
+            if (motor_adiado && strcmp(backendPersistencia(), "inativo") != 0) {
+                gravacao_motor = &gravacao;
+            }
+            salvo = tabela->salvar();
+            gravacao_motor = NULL;
+        }
+        if (salvo) {
+            tabela->alteracoes = 0;
+            gravou = 1;
+        } else {
+            printf("Erro: %s não foi gravado; nova tentativa na próxima rodada.\n", tabela->arquivo);
+            gravou = -1;
+        }
+    }
+    fecharTabela(tabela);
+    return gravou;
+}
+
+// Prazo absoluto "intervalo_ms" a partir de agora (para pthread_cond_timedwait)
+static void calcularPrazo(struct timespec *prazo, int intervalo_ms) {
+    clock_gettime(CLOCK_REALTIME, prazo);
+    prazo->tv_sec += intervalo_ms / 1000;
+    prazo->tv_nsec += (long)(intervalo_ms % 1000) * 1000000L;
+    if (prazo->tv_nsec >= 1000000000L) {
+        prazo->tv_sec++;
+        prazo->tv_nsec -= 1000000000L;
+    }
+}
+
+static void *executarDescarregador(void *arg) {
+    TabelaResidente *rodada[MAX_TABELAS_ADIADAS];
+    struct timespec prazo;
+    int com_prazo = 0;
+    int prazo_vencido = 0;
+
+    (void)arg;
+    pthread_mutex_lock(&trava_adiada);
+
+    for (;;) {
+        int barreira = barreiras_pedidas != barreiras_atendidas;
+        int limite = alteracoes_pendentes >= limite_adiado;
+
+        if (!adiada_encerrando && !barreira && !limite && !prazo_vencido) {
+            // O prazo começa a contar na primeira alteração pendente
+            if (total_sujas > 0 && !com_prazo) {
+                calcularPrazo(&prazo, intervalo_adiado_ms);
+                com_prazo = 1;
+            }
+            if (com_prazo) {
+                prazo_vencido = pthread_cond_timedwait(&sinal_descarregador, &trava_adiada,
+                                                       &prazo) == ETIMEDOUT;
+            } else {
+                pthread_cond_wait(&sinal_descarregador, &trava_adiada);
+            }
+            continue;
+        }
+
+        // Rodada: atende também as barreiras pedidas até aqui
+        unsigned long long alvo = barreiras_pedidas;
+        int quantidade = total_sujas;
+        for (int i = 0; i < quantidade; i++) {
+            rodada[i] = tabelas_sujas[i];
+            rodada[i]->na_fila = 0;
+        }
+        total_sujas = 0;
+        alteracoes_pendentes = 0;
+        com_prazo = 0;
+        prazo_vencido = 0;
+        pthread_mutex_unlock(&trava_adiada);
+
+        int gravadas = 0;
+        int falhas = 0;
+        for (int i = 0; i < quantidade; i++) {
+            int resultado = gravarTabelaPendente(rodada[i]);
+            if (resultado > 0) {
+                gravadas++;
+            } else if (resultado < 0) {
+                rodada[falhas++] = rodada[i];
+            }
+        }
+
+        pthread_mutex_lock(&trava_adiada);
+        // Tabelas que falharam voltam à lista: a próxima rodada (no prazo) tenta de novo
+        for (int i = 0; i < falhas; i++) {
+            if (!rodada[i]->na_fila) {
+                rodada[i]->na_fila = 1;
+                tabelas_sujas[total_sujas++] = rodada[i];
+            }
+        }
+        falhas_adiadas = falhas;
+        estatisticas_adiadas.gravacoes += gravadas;
+        estatisticas_adiadas.rodadas++;
+        barreiras_atendidas = alvo;
+        pthread_cond_broadcast(&sinal_barreira);
+
+        // Encerramento: só sai quando não sobrou nada (novas alterações
+        // registradas durante a rodada ganham mais uma volta). Se a rodada
+        // falhou, desiste: as alterações seguem só na memória e a próxima
+        // gravação síncrona da tabela as leva junto.
+        if (adiada_encerrando && barreiras_pedidas == barreiras_atendidas &&
+            (total_sujas == 0 || falhas > 0)) {
+            for (int i = 0; i < total_sujas; i++) {
+                tabelas_sujas[i]->na_fila = 0;
+            }
+            total_sujas = 0;
+            adiada_ativa = 0;
+            escrita_duravel = 0;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&trava_adiada);
+    return NULL;
+}
+
+int iniciarGravacaoAdiada(int intervalo_ms, int limite_alteracoes) {
+    pthread_mutex_lock(&trava_adiada);
+    if (adiada_ativa) {
+        pthread_mutex_unlock(&trava_adiada);
+        return 1;
+    }
+
+    intervalo_adiado_ms = (intervalo_ms > 0) ? intervalo_ms : 1;
+    limite_adiado = (limite_alteracoes > 0) ? limite_alteracoes : 1;
+    adiada_encerrando = 0;
+    escrita_duravel = 1;
+
+#ifndef _WIN32
+    // Sem o motor, o descarregador grava pelo caminho síncrono (stdio + fsync + rename)
+    motor_proprio = strcmp(backendPersistencia(), "inativo") == 0;
+    motor_adiado = iniciarPersistencia(PERSISTENCIA_AUTOMATICA) != 0;
+    motor_proprio = motor_proprio && motor_adiado;
+#endif
+
+    if (pthread_create(&descarregador, NULL, executarDescarregador, NULL) != 0) {
+        escrita_duravel = 0;
+        if (motor_proprio) {
+            encerrarPersistencia();
+        }
+        motor_adiado = 0;
+        motor_proprio = 0;
+        pthread_mutex_unlock(&trava_adiada);
+        printf("Erro: não foi possível iniciar a gravação adiada.\n");
+        return 0;
+    }
+    adiada_ativa = 1;
+    pthread_mutex_unlock(&trava_adiada);
+    return 1;
+}
+
+void encerrarGravacaoAdiada(void) {
+    pthread_mutex_lock(&trava_adiada);
+    if (!adiada_ativa || adiada_encerrando) {
+        pthread_mutex_unlock(&trava_adiada);
+        return;
+    }
+    adiada_encerrando = 1;
+    pthread_cond_signal(&sinal_descarregador);
+    pthread_mutex_unlock(&trava_adiada);
+
+    pthread_join(descarregador, NULL);
+
+    pthread_mutex_lock(&trava_adiada);
+    if (motor_proprio) {
+        encerrarPersistencia();
+    }
+    motor_adiado = 0;
+    motor_proprio = 0;
+    if (falhas_adiadas > 0) {
+        printf("Erro: %d tabela(s) com alterações adiadas não gravadas.\n", falhas_adiadas);
+        falhas_adiadas = 0;
+    }
+    pthread_mutex_unlock(&trava_adiada);
+}
+
+int descarregarTabelas(void) {
+    int gravou_tudo = 1;
+
+    pthread_mutex_lock(&trava_adiada);
+    if (adiada_ativa) {
+        unsigned long long minha = ++barreiras_pedidas;
+        pthread_cond_signal(&sinal_descarregador);
+        while (barreiras_atendidas < minha) {
+            pthread_cond_wait(&sinal_barreira, &trava_adiada);
+        }
+        gravou_tudo = (falhas_adiadas == 0);
+    }
+    pthread_mutex_unlock(&trava_adiada);
+    return gravou_tudo;
+}
+
+int registrarAlteracaoTabela(TabelaResidente *tabela) {
+    Transacao *transacao = transacaoDaThread();
+    int posicao = (transacao != NULL) ? posicaoNaTransacao(transacao, tabela) : -1;
+
+    // Em transação, a gravação fica para a confirmação
+    if (posicao >= 0) {
+        transacao->alteradas[posicao] = 1;
+        return 1;
+    }
+
+    pthread_mutex_lock(&trava_adiada);
+    estatisticas_adiadas.alteracoes++;
+
+    if (!adiada_ativa || tabela->salvar == NULL) {
+        estatisticas_adiadas.gravacoes++;
+        pthread_mutex_unlock(&trava_adiada);
+        if (tabela->salvar != NULL && !tabela->salvar()) {
+            // Nada fica alterado só na memória deste processo: volta ao CSV
+            descartarAlteracoesTabela(tabela->arquivo);
+            recarregarTabela(tabela, 0);
+            printf("Erro: alteração desfeita, %s não foi gravado.\n", tabela->arquivo);
+            return 0;
+        }
+        tabela->alteracoes = 0; // Sobras de um descarregador encerrado com falha
+        return 1;
+    }
+
+    tabela->alteracoes++;
+    if (!tabela->na_fila && total_sujas < MAX_TABELAS_ADIADAS) {
+        tabela->na_fila = 1;
+        tabelas_sujas[total_sujas++] = tabela;
+    }
+    alteracoes_pendentes++;
+
+    // Acorda o descarregador para iniciar o prazo ou atender o limite
+    if (total_sujas == 1 || alteracoes_pendentes >= limite_adiado) {
+        pthread_cond_signal(&sinal_descarregador);
+    }
+    pthread_mutex_unlock(&trava_adiada);
+    return 1;
+}
+
+void estatisticasGravacaoAdiada(EstatisticasGravacaoAdiada *destino) {
+    pthread_mutex_lock(&trava_adiada);
+    *destino = estatisticas_adiadas;
+    pthread_mutex_unlock(&trava_adiada);
+}
+
+// ========== TRANSAÇÕES ENTRE TABELAS ==========
+
+int iniciarTransacaoTabelas(void) {
+    Transacao *externa = transacaoDaThread();
+
+    // Operação composta dentro de outra transação: junta-se a ela
+    if (externa != NULL) {
+        externa->aninhadas++;
+        return 1;
+    }
+
+    // Nada adiado pode ser gravado por cima da transação depois dela
+    descarregarTabelas();
+
+    pthread_mutex_lock(&trava_transacao);
+    if (!travarJournal()) {
+        pthread_mutex_unlock(&trava_transacao);
+        return 0;
+    }
+
+    memset(&transacao_atual, 0, sizeof(transacao_atual));
+    transacao_atual.numero = ++transacoes_iniciadas;
+    pthread_setspecific(chave_transacao, &transacao_atual);
+    return 1;
+}
+
+int concluirTransacaoTabelas(int confirmar) {
+    Transacao *transacao = transacaoDaThread();
+    const char *arquivos[MAX_TABELAS_TRANSACAO];
+    AcaoTransacao *acoes;
+    int total_acoes;
+    int publicada = 0;
+
+    if (transacao == NULL) {
+        return 0;
+    }
+
+    // Interna: só a externa publica; desistir aqui desfaz tudo no fim
+    if (transacao->aninhadas > 0) {
+        transacao->aninhadas--;
+        if (!confirmar) {
+            transacao->desistida = 1;
+        }
+        return confirmar && !transacao->desistida;
+    }
+    if (confirmar && transacao->desistida) {
+        printf("Erro: uma operação da transação falhou; nada foi gravado.\n");
+        confirmar = 0;
+    }
+
+    if (confirmar) {
+        // Cada tabela alterada grava o seu temporário (ver concluirEscritaAtomica)
+        transacao->confirmando = 1;
+        for (int i = 0; i < transacao->total; i++) {
+            if (transacao->alteradas[i]) {
+                transacao->tabelas[i]->salvar();
+            }
+        }
+        transacao->confirmando = 0;
+
+        for (int i = 0; i < transacao->total_gravados; i++) {
+            arquivos[i] = transacao->gravados[i];
+        }
+
+        // Todas as tabelas alteradas precisam ter o temporário pronto
+        publicada = 1;
+        for (int i = 0; i < transacao->total && publicada; i++) {
+            int gravada = !transacao->alteradas[i];
+            for (int j = 0; j < transacao->total_gravados && !gravada; j++) {
+                gravada = strcmp(arquivos[j], transacao->tabelas[i]->arquivo) == 0;
+            }
+            publicada = gravada;
+        }
+
+        if (publicada) {
+            publicada = publicarArquivosAtomico(arquivos, transacao->total_gravados);
+        }
+        if (!publicada) {
+            descartarTemporarios(arquivos, transacao->total_gravados);
+            for (int i = 0; i < transacao->total_gravados; i++) {
+                descartarAlteracoesTabela(arquivos[i]);
+            }
+            printf("Erro: transação desfeita, nenhum arquivo foi alterado.\n");
+        }
+    }
+
+    pthread_setspecific(chave_transacao, NULL);
+
+    // Publicada: assinatura nova; desfeita: a memória volta a ser o CSV
+    for (int i = 0; i < transacao->total; i++) {
+        TabelaResidente *tabela = transacao->tabelas[i];
+        if (transacao->alteradas[i]) {
+            if (publicada) {
+                marcarTabelaSalva(tabela);
+            } else {
+                recarregarTabela(tabela, 0);
+            }
+        }
+        liberarTabela(tabela);
+    }
+
+    destravarJournal();
+
+    // A próxima transação reusa transacao_atual assim que a trava for solta
+    acoes = transacao->acoes;
+    total_acoes = transacao->total_acoes;
+    pthread_mutex_unlock(&trava_transacao);
+
+    // Fora das travas, como se a operação tivesse sido feita sem transação
+    for (int i = 0; publicada && i < total_acoes; i++) {
+        acoes[i].acao(acoes[i].valor);
+    }
+    free(acoes);
+    return publicada;
+}
+
+int aposConfirmarTransacaoTabelas(int (*acao)(int), int valor) {
+    Transacao *transacao = transacaoDaThread();
+
+    if (transacao == NULL) {
+        acao(valor);
+        return 1;
+    }
+
+    if (transacao->total_acoes == transacao->capacidade_acoes) {
+        int capacidade = (transacao->capacidade_acoes > 0) ? transacao->capacidade_acoes * 2 : 64;
+        AcaoTransacao *maiores = realloc(transacao->acoes, sizeof(AcaoTransacao) * (size_t)capacidade);
+        if (maiores == NULL) {
+            printf("Erro: memória insuficiente para a transação.\n");
+            transacao->desistida = 1;
+            return 0;
+        }
+        transacao->acoes = maiores;
+        transacao->capacidade_acoes = capacidade;
+    }
+    transacao->acoes[transacao->total_acoes].acao = acao;
+    transacao->acoes[transacao->total_acoes].valor = valor;
+    transacao->total_acoes++;
+    return 1;
+}
+
+int emTransacaoTabelas(void) {
+    return transacaoDaThread() != NULL;
+}
+
+int publicarTabelaAposConfirmar(TabelaResidente *tabela, int (*publicar)(int)) {
+    Transacao *transacao = transacaoDaThread();
+
+    if (transacao == NULL) {
+        return 0;
+    }
+    if (tabela->publicacao_pendente == transacao->numero) {
+        return 1;
+    }
+    if (!aposConfirmarTransacaoTabelas(publicar, 0)) {
+        return 0;
+    }
+    tabela->publicacao_pendente = transacao->numero;
+    return 1;
+}
+
+unsigned long numeroTransacaoTabelas(void) {
+    Transacao *transacao = transacaoDaThread();
+    return (transacao != NULL) ? transacao->numero : 0;
+}
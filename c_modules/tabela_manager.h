@@ -0,0 +1,242 @@
+#ifndef TABELA_MANAGER_H
+#define TABELA_MANAGER_H
+
+#include <stdio.h>
+#include <pthread.h>
+
+// ========== TABELAS RESIDENTES (CONCORRÊNCIA) ==========
+//
+// Cada módulo mantém seu array estático protegido por um TabelaResidente:
+// - vários leitores (buscarX/listarX) executam em paralelo sob a trava de leitura;
+// - escritores (cadastrar/atualizar/excluir) são serializados pela trava de escrita;
+// - o CSV só é relido quando sua assinatura (mtime + tamanho + geração) muda, de
+//   forma que leitores não precisam reescrever o array a cada chamada.
+//
+// ========== PROTOCOLO DE TRAVA ENTRE PROCESSOS ==========
+//
+// Todo CSV "data/x.csv" tem um arquivo de trava "data/x.csv.lock" (flock no
+// POSIX, LockFileEx no Windows) seguido também pelo front end Python:
+// 1. Leitura: trava compartilhada apenas durante o parse do arquivo.
+// 2. Leitura-modificação-escrita: trava exclusiva do reload até a gravação.
+// 3. Gravação: conteúdo vai para "x.csv.tmp" e substitui o CSV por rename, de
+//    modo que leitores sem trava nunca veem um arquivo pela metade.
+// 4. Antes de soltar a trava exclusiva, o escritor incrementa o contador de
+//    geração gravado no início do ".lock" (20 dígitos decimais + '\n').
+// 5. As linhas que mudaram vão para "data/alteracoes.log" com a geração nova
+//    (alteracoes_manager.h); gravações de fora do C ficam sem registro.
+
+#define TRAVA_COMPARTILHADA 0
+#define TRAVA_EXCLUSIVA 1
+#define TRAVA_SEM_ESPERA 2     // Combinável: falha em vez de esperar
+
+// Arquivo de trava ("<csv>.lock") aberto por processo
+typedef struct {
+    int descritor;             // -1 enquanto não aberto
+    long pid;                  // Processo que abriu o descritor (fork reabre)
+} TravaArquivo;
+
+#define TRAVA_ARQUIVO_INIT { -1, 0 }
+
+// Assinatura do arquivo usada para detectar alterações externas
+typedef struct {
+    long long mtime_ns;        // Última modificação em nanossegundos
+    long long tamanho;         // Tamanho em bytes (-1 se o arquivo não existe)
+    long long geracao;         // Contador do arquivo de trava
+} AssinaturaArquivo;
+
+// Estado compartilhado de uma tabela mantida em memória
+typedef struct {
+    pthread_rwlock_t trava;    // Trava leitores/escritor da tabela
+    const char *arquivo;       // CSV de origem
+    void (*carregar)(void);    // Recarrega o array estático do módulo
+    int carregada;             // 1 após a primeira carga
+    AssinaturaArquivo assinatura; // Assinatura do CSV na última carga/gravação
+    TravaArquivo trava_arquivo;   // Trava entre processos do CSV
+    int exclusiva;             // 1 enquanto o escritor detém a trava do arquivo
+    int (*salvar)(void);       // Grava o array estático no CSV (exige trava de escrita; 1 se gravou)
+    int alteracoes;            // Alterações em memória ainda não gravadas (gravação adiada)
+    int na_fila;               // 1 enquanto está na lista do descarregador
+    unsigned long publicacao_pendente; // Transação que já agendou a publicação
+} TabelaResidente;
+
+#define TABELA_RESIDENTE_INIT(arquivo, carregar, salvar) \
+    { PTHREAD_RWLOCK_INITIALIZER, (arquivo), (carregar), 0, { 0, -1, 0 }, TRAVA_ARQUIVO_INIT, 0, \
+      (salvar), 0, 0, 0 }
+
+// Função para abrir a tabela em modo leitura (compartilhado)
+// Recarrega o CSV antes, se ele mudou desde a última carga
+void abrirLeituraTabela(TabelaResidente *tabela);
+
+// Função para abrir a tabela em modo escrita (exclusivo)
+// Obtém também a trava exclusiva do arquivo até fecharTabela()
+// Recarrega o CSV antes, se ele mudou desde a última carga
+void abrirEscritaTabela(TabelaResidente *tabela);
+
+// Função para conferir/recarregar o CSV sem esperar por escritores
+// Usada pelos leitores de snapshot: se a trava estiver ocupada, a
+// verificação é adiada (o escritor publicará a versão nova ao terminar).
+// Retorna: 1 se a tabela foi verificada, 0 se a verificação foi adiada
+int sincronizarTabelaSemBloquear(TabelaResidente *tabela);
+
+// Função para liberar a trava obtida por abrirLeituraTabela/abrirEscritaTabela
+void fecharTabela(TabelaResidente *tabela);
+
+// Função para registrar que o array em memória acabou de ser persistido
+// Deve ser chamada com a trava de escrita obtida
+void marcarTabelaSalva(TabelaResidente *tabela);
+
+// Função para forçar a releitura do CSV na próxima abertura
+// Sem efeito enquanto a tabela tiver alterações adiadas (a memória prevalece)
+void invalidarTabela(TabelaResidente *tabela);
+
+// ========== GRAVAÇÃO ADIADA (WRITE-BEHIND) ==========
+//
+// Com a gravação adiada ativa, cadastrar/atualizar/excluir alteram apenas a
+// memória e retornam; uma thread descarregadora grava as tabelas alteradas:
+// - quando a primeira alteração pendente completa "intervalo_ms";
+// - quando o total de alterações pendentes chega a "limite_alteracoes";
+// - quando alguém chama descarregarTabelas() (barreira).
+// Várias alterações na mesma tabela viram uma única gravação do CSV, e cada
+// gravação passa a ser durável (fsync antes do rename). O descarregador
+// entrega as gravações ao motor de persistência (persistencia_manager.h),
+// iniciado junto com ele quando ainda não estiver ativo.
+//
+// Por isso a gravação adiada é opcional (sistema_cli --gravacao-adiada) e só
+// serve quando este é o único processo que altera os CSVs: enquanto uma
+// tabela tem alterações pendentes, este processo não a relê do disco, e a
+// próxima gravação sobrescreve o que outro processo tiver gravado nesse
+// intervalo. O modo síncrono (padrão) relê e grava sob a trava exclusiva e
+// não perde alterações concorrentes.
+// Alterações ainda não descarregadas se perdem se o processo morrer; o CSV
+// em disco continua íntegro na última versão gravada.
+
+// Contadores da gravação adiada
+typedef struct {
+    long alteracoes;           // Alterações registradas pelos módulos
+    long gravacoes;            // CSVs efetivamente gravados
+    long rodadas;              // Execuções do descarregador
+} EstatisticasGravacaoAdiada;
+
+// Função para iniciar a thread descarregadora
+// Retorna: 1 se ativa, 0 se erro
+int iniciarGravacaoAdiada(int intervalo_ms, int limite_alteracoes);
+
+// Função para gravar tudo o que estiver pendente e voltar ao modo síncrono
+// Se a última tentativa de uma tabela falhar, as alterações dela seguem só na
+// memória até a próxima gravação síncrona da tabela
+void encerrarGravacaoAdiada(void);
+
+// Função barreira: retorna depois que o descarregador tentou gravar toda
+// alteração registrada antes da chamada (imediata se a gravação adiada
+// estiver inativa). Uma tabela cuja gravação falhou continua pendente e é
+// tentada de novo na rodada seguinte.
+// Retorna: 1 se tudo foi gravado, 0 se alguma tabela ainda não está em disco
+int descarregarTabelas(void);
+
+// Função chamada pelos módulos após alterar o array (exige trava de escrita)
+// Grava agora (modo síncrono) ou marca a tabela para o descarregador. Se a
+// gravação síncrona falhar, a alteração é desfeita: a tabela é relida do CSV.
+// Retorna: 1 se gravada (ou pendente), 0 se a gravação falhou
+int registrarAlteracaoTabela(TabelaResidente *tabela);
+
+// Função para consultar os contadores da gravação adiada
+void estatisticasGravacaoAdiada(EstatisticasGravacaoAdiada *destino);
+
+// ========== TRANSAÇÕES ENTRE TABELAS ==========
+//
+// Entre iniciarTransacaoTabelas() e concluirTransacaoTabelas(), a thread que
+// iniciou a transação:
+// - obtém a trava de escrita (e a exclusiva do CSV) de cada tabela na primeira
+//   abertura, de leitura ou escrita, e só as solta no fim: fecharTabela() e
+//   aberturas repetidas da mesma tabela não fazem nada;
+// - registrarAlteracaoTabela() apenas marca a tabela; nada é gravado antes
+//   da confirmação.
+// Na confirmação, cada tabela alterada grava seu "x.csv.tmp" (com fsync) e o
+// journal publica todos juntos (journal_manager.h). Na desistência, ou se
+// alguma gravação falhar, as tabelas alteradas são relidas dos CSVs, que não
+// mudaram.
+//
+// Uma transação por vez no processo (as demais esperam em iniciar) e no
+// sistema (trava do journal). Dentro dela, as tabelas devem ser abertas
+// sempre na mesma ordem pelas operações concorrentes, como em qualquer
+// escritor que use mais de uma tabela.
+//
+// Uso pelos módulos: qualquer sequência de funções de cadastro entre iniciar
+// e concluir vira uma publicação só, e as consultas da mesma thread já veem
+// as alterações (a memória é a versão da transação). Iniciar de novo dentro
+// dela (ex.: excluirTurmaEmCascata() chamada numa transação maior) junta-se à
+// externa: a interna não publica nada, e se desistir a externa também desiste.
+// O que não mora numa tabela residente (chamadas em frequencia.dat) entra com
+// aposConfirmarTransacaoTabelas() e só acontece se a transação for publicada.
+// Do mesmo modo, snapshots, exportação e agregados alterados na transação
+// ficam visíveis só para a thread dela (numeroTransacaoTabelas()); os demais
+// leitores recebem a versão nova por aposConfirmarTransacaoTabelas(), e uma
+// desistência não chega a ser vista por eles.
+
+#define MAX_TABELAS_TRANSACAO 16
+
+// Função para iniciar uma transação na thread atual (ou juntar-se à dela)
+// Descarrega antes as alterações adiadas e conclui publicação interrompida
+// Retorna: 1 se iniciada, 0 se o journal falhou
+int iniciarTransacaoTabelas(void);
+
+// Função para encerrar a transação da thread atual
+// confirmar = 1 publica as alterações; 0 desiste delas
+// Retorna: 1 se as alterações foram publicadas (interna: se seguem na
+//          externa), 0 se foram descartadas
+int concluirTransacaoTabelas(int confirmar);
+
+// Função para executar acao(valor) só depois que a transação for publicada
+// Sem transação, executa agora
+// Retorna: 1 se registrada, 0 se faltou memória (a transação desiste)
+int aposConfirmarTransacaoTabelas(int (*acao)(int), int valor);
+
+// Função para saber se a thread atual está em uma transação
+int emTransacaoTabelas(void);
+
+// Função para agendar, uma vez por transação, a publicação de uma tabela
+// alterada nela: publicar(0) roda após a confirmação, fora das travas
+// (deve abrir a tabela por conta própria). Exige a trava de escrita.
+// Retorna: 1 se agendada (ou já estava), 0 fora de transação ou se faltou
+//          memória (a transação desiste)
+int publicarTabelaAposConfirmar(TabelaResidente *tabela, int (*publicar)(int));
+
+// Função para identificar a transação da thread atual
+// Retorna: número distinto a cada transação, ou 0 fora de transação
+unsigned long numeroTransacaoTabelas(void);
+
+// ========== TRAVAS DE ARQUIVO ENTRE PROCESSOS ==========
+
+// Função para obter a trava do arquivo "<arquivo>.lock"
+// modo: TRAVA_COMPARTILHADA ou TRAVA_EXCLUSIVA, opcionalmente | TRAVA_SEM_ESPERA
+// Retorna: 1 se obteve, 0 se erro ou se estava ocupada (TRAVA_SEM_ESPERA)
+int travarArquivo(TravaArquivo *trava, const char *arquivo, int modo);
+
+// Função para liberar a trava do arquivo
+void destravarArquivo(TravaArquivo *trava);
+
+// Função para ler o contador de geração do arquivo de trava
+long long lerGeracaoArquivo(TravaArquivo *trava);
+
+// Função para incrementar o contador de geração (exige trava exclusiva)
+void incrementarGeracaoArquivo(TravaArquivo *trava);
+
+// Função para somar "quantidade" ao contador de geração (exige trava exclusiva)
+void avancarGeracaoArquivo(TravaArquivo *trava, long long quantidade);
+
+// ========== GRAVAÇÃO ATÔMICA ==========
+
+// Função para abrir "<arquivo>.tmp" para escrita
+// Retorna: FILE* do temporário ou NULL se erro
+FILE* abrirEscritaAtomica(const char *arquivo);
+
+// Função para fechar o temporário e substituir o arquivo final por rename
+// Durante a confirmação de uma transação, o temporário é sincronizado e fica
+// para a publicação pelo journal
+// Retorna: 1 se sucesso, 0 se erro (o arquivo original é preservado)
+int concluirEscritaAtomica(FILE *temporario, const char *arquivo);
+
+// Função para desistir de uma gravação: fecha e remove "<arquivo>.tmp"
+void abandonarEscritaAtomica(FILE *temporario, const char *arquivo);
+
+#endif
@@ -3,12 +3,20 @@
 #include <string.h>
 #include "turma_manager.h"
 #include "file_manager.h"
+#include "tabela_manager.h"
+#include "exportacao_manager.h"
+#include "aluno_manager.h"
+#include "agregado_manager.h"
+#include "aula_manager.h"
+#include "atividade_manager.h"
+#include "nota_manager.h"
+#include "frequencia_manager.h"
 
 // ========== ARRAYS GLOBAIS (EM MEMÓRIA) ==========
 static Turma turmas[MAX_TURMAS];
 static int total_turmas = 0;
 
-static AlunoTurma matriculas[MAX_TURMAS * 10]; // Cada turma pode ter vários alunos
+static AlunoTurma matriculas[MAX_MATRICULAS]; // Cada turma pode ter vários alunos
 static int total_matriculas = 0;
 
 // ========== FUNÇÕES AUXILIARES PRIVADAS ==========
@@ -16,11 +24,44 @@ static int total_matriculas = 0;
 // Carrega turmas do arquivo para memória
 static void carregarTurmasMemoria(void) {
     total_turmas = carregarDados(ARQUIVO_TURMAS, turmas, MAX_TURMAS, TIPO_TURMA);
+    publicarExportacao(EXPORTACAO_TURMAS, turmas, total_turmas);
+    reconstruirAgregadosTurmas(turmas, total_turmas);
 }
 
-// Salva turmas da memória para o arquivo
-static void salvarTurmasArquivo(void) {
-    salvarDados(ARQUIVO_TURMAS, turmas, total_turmas, TIPO_TURMA);
+static int gravarTurmasArquivo(void);
+static int gravarMatriculasArquivo(void);
+
+// Travas leitores/escritor das duas tabelas do módulo
+static TabelaResidente tabela_turmas = TABELA_RESIDENTE_INIT(ARQUIVO_TURMAS, carregarTurmasMemoria,
+                                                             gravarTurmasArquivo);
+
+// Grava turmas da memória para o arquivo (exige trava de escrita)
+static int gravarTurmasArquivo(void) {
+    if (!salvarDados(ARQUIVO_TURMAS, turmas, total_turmas, TIPO_TURMA)) {
+        return 0;
+    }
+    marcarTabelaSalva(&tabela_turmas);
+    return 1;
+}
+
+// Publica a versão confirmada para os demais leitores (após a transação)
+static int publicarTurmasConfirmadas(int ignorado) {
+    (void)ignorado;
+    abrirLeituraTabela(&tabela_turmas);
+    publicarExportacao(EXPORTACAO_TURMAS, turmas, total_turmas);
+    reconstruirAgregadosTurmas(turmas, total_turmas);
+    fecharTabela(&tabela_turmas);
+    return 1;
+}
+
+// Publica a alteração e grava agora ou em segundo plano (exige trava de escrita)
+static int salvarTurmasArquivo(void) {
+    if (emTransacaoTabelas()) {
+        publicarTabelaAposConfirmar(&tabela_turmas, publicarTurmasConfirmadas);
+    } else {
+        publicarExportacao(EXPORTACAO_TURMAS, turmas, total_turmas);
+    }
+    return registrarAlteracaoTabela(&tabela_turmas);
 }
 
 // Carrega matrículas do arquivo para memória
@@ -30,6 +71,7 @@ static void carregarMatriculasMemoria(void) {
     FILE *arquivo = fopen(ARQUIVO_ALUNO_TURMA, "r");
     if (arquivo == NULL) {
         total_matriculas = 0;
+        reconstruirAgregadosMatriculas(matriculas, 0);
         return;
     }
     
@@ -37,7 +79,7 @@ static void carregarMatriculasMemoria(void) {
     fgets(linha, sizeof(linha), arquivo); // Pular cabeçalho
     
     total_matriculas = 0;
-    while (fgets(linha, sizeof(linha), arquivo) != NULL && total_matriculas < MAX_TURMAS * 10) {
+    while (fgets(linha, sizeof(linha), arquivo) != NULL && total_matriculas < MAX_MATRICULAS) {
         sscanf(linha, "%d,%d", 
                &matriculas[total_matriculas].ra,
                &matriculas[total_matriculas].id_turma);
@@ -45,14 +87,19 @@ static void carregarMatriculasMemoria(void) {
     }
     
     fclose(arquivo);
+    publicarExportacao(EXPORTACAO_MATRICULAS, matriculas, total_matriculas);
+    reconstruirAgregadosMatriculas(matriculas, total_matriculas);
 }
 
-// Salva matrículas da memória para o arquivo
-static void salvarMatriculasArquivo(void) {
-    FILE *arquivo = fopen(ARQUIVO_ALUNO_TURMA, "w");
+static TabelaResidente tabela_matriculas = TABELA_RESIDENTE_INIT(ARQUIVO_ALUNO_TURMA, carregarMatriculasMemoria,
+                                                                 gravarMatriculasArquivo);
+
+// Grava matrículas da memória para o arquivo (exige trava de escrita)
+static int gravarMatriculasArquivo(void) {
+    FILE *arquivo = abrirEscritaAtomica(ARQUIVO_ALUNO_TURMA);
     if (arquivo == NULL) {
         printf("Erro ao abrir arquivo de matrículas.\n");
-        return;
+        return 0;
     }
     
     fprintf(arquivo, "RA,ID_Turma\n");
@@ -64,7 +111,32 @@ static void salvarMatriculasArquivo(void) {
                 matriculas[i].id_turma);
     }
     
-    fclose(arquivo);
+    if (!concluirEscritaAtomica(arquivo, ARQUIVO_ALUNO_TURMA)) {
+        printf("Erro ao gravar arquivo de matrículas.\n");
+        return 0;
+    }
+    marcarTabelaSalva(&tabela_matriculas);
+    return 1;
+}
+
+// Publica a versão confirmada para os demais leitores (após a transação)
+static int publicarMatriculasConfirmadas(int ignorado) {
+    (void)ignorado;
+    abrirLeituraTabela(&tabela_matriculas);
+    publicarExportacao(EXPORTACAO_MATRICULAS, matriculas, total_matriculas);
+    reconstruirAgregadosMatriculas(matriculas, total_matriculas);
+    fecharTabela(&tabela_matriculas);
+    return 1;
+}
+
+// Publica a alteração e grava agora ou em segundo plano (exige trava de escrita)
+static int salvarMatriculasArquivo(void) {
+    if (emTransacaoTabelas()) {
+        publicarTabelaAposConfirmar(&tabela_matriculas, publicarMatriculasConfirmadas);
+    } else {
+        publicarExportacao(EXPORTACAO_MATRICULAS, matriculas, total_matriculas);
+    }
+    return registrarAlteracaoTabela(&tabela_matriculas);
 }
 
 // ========== IMPLEMENTAÇÃO DAS FUNÇÕES PÚBLICAS ==========
@@ -77,11 +149,12 @@ int cadastrarTurma(Turma *turma) {
         return 0;
     }
     
-    carregarTurmasMemoria();
+    abrirEscritaTabela(&tabela_turmas);
     
     // Verificar se ID já existe
     for (int i = 0; i < total_turmas; i++) {
         if (turmas[i].id == turma->id) {
+            fecharTabela(&tabela_turmas);
             printf("Erro: ID %d já cadastrado.\n", turma->id);
             return 0;
         }
@@ -89,6 +162,7 @@ int cadastrarTurma(Turma *turma) {
     
     // Verificar limite
     if (total_turmas >= MAX_TURMAS) {
+        fecharTabela(&tabela_turmas);
         printf("Erro: limite de turmas atingido.\n");
         return 0;
     }
@@ -96,29 +170,61 @@ int cadastrarTurma(Turma *turma) {
     // Adicionar nova turma
     turmas[total_turmas] = *turma;
     total_turmas++;
-    salvarTurmasArquivo();
+    agregarTurma(NULL, turma);
+    int salvo = salvarTurmasArquivo();
+    fecharTabela(&tabela_turmas);
+    if (!salvo) {
+        return 0;
+    }
     
     printf("Turma '%s' cadastrada com sucesso!\n", turma->nome);
     return 1;
 }
 
 // Buscar turma por ID (uso de ponteiro - requisito desejável)
+// O ponteiro só é estável até a próxima escrita; entre threads use obterTurmaPorID()
 Turma* buscarTurmaPorID(int id) {
-    carregarTurmasMemoria();
+    Turma *encontrada = NULL;
+    
+    abrirLeituraTabela(&tabela_turmas);
     
     // Estrutura de repetição (requisito obrigatório)
     for (int i = 0; i < total_turmas; i++) {
         if (turmas[i].id == id) {
-            return &turmas[i]; // Retorna ponteiro
+            encontrada = &turmas[i]; // Retorna ponteiro
+            break;
         }
     }
     
-    return NULL; // Não encontrada
+    fecharTabela(&tabela_turmas);
+    return encontrada; // NULL se não encontrada
+}
+
+// Copiar turma por ID para o destino
+int obterTurmaPorID(int id, Turma *destino) {
+    int encontrada = 0;
+    
+    if (destino == NULL) {
+        return 0;
+    }
+    
+    abrirLeituraTabela(&tabela_turmas);
+    
+    for (int i = 0; i < total_turmas; i++) {
+        if (turmas[i].id == id) {
+            *destino = turmas[i];
+            encontrada = 1;
+            break;
+        }
+    }
+    
+    fecharTabela(&tabela_turmas);
+    return encontrada;
 }
 
 // Listar todas as turmas
 int listarTurmas(Turma *destino, int max) {
-    carregarTurmasMemoria();
+    abrirLeituraTabela(&tabela_turmas);
     
     int count = (total_turmas < max) ? total_turmas : max;
     
@@ -127,107 +233,266 @@ int listarTurmas(Turma *destino, int max) {
         destino[i] = turmas[i];
     }
     
+    fecharTabela(&tabela_turmas);
     return count;
 }
 
+// Contar turmas em O(1)
+int contarTurmas(void) {
+    return contarTurmasPor(NULL, 0, 0);
+}
+
+// Contar turmas de um professor/ano/semestre em O(1)
+int contarTurmasPor(const char *professor, int ano, int semestre) {
+    abrirLeituraTabela(&tabela_turmas); // Recarrega (e reconstrói) se o CSV mudou
+    int total = lerTurmasAgregadas(professor, ano, semestre);
+    fecharTabela(&tabela_turmas);
+    return total;
+}
+
 // Atualizar dados de uma turma
 int atualizarTurma(Turma *turma) {
     if (turma == NULL) {
         return 0;
     }
     
-    carregarTurmasMemoria();
+    abrirEscritaTabela(&tabela_turmas);
     
     for (int i = 0; i < total_turmas; i++) {
         if (turmas[i].id == turma->id) {
+            Turma antes = turmas[i];
             turmas[i] = *turma;
-            salvarTurmasArquivo();
+            agregarTurma(&antes, &turmas[i]);
+            int salvo = salvarTurmasArquivo();
+            fecharTabela(&tabela_turmas);
+            if (!salvo) {
+                return 0;
+            }
             printf("Turma atualizada com sucesso!\n");
             return 1;
         }
     }
     
+    fecharTabela(&tabela_turmas);
     printf("Erro: turma não encontrada.\n");
     return 0;
 }
 
 // Excluir uma turma
 int excluirTurma(int id) {
-    carregarTurmasMemoria();
+    abrirEscritaTabela(&tabela_turmas);
     
     // Estrutura de repetição com decisão (requisitos obrigatórios)
     for (int i = 0; i < total_turmas; i++) {
         if (turmas[i].id == id) {
+            agregarTurma(&turmas[i], NULL);
+            
             // Remove a turma deslocando os elementos
             for (int j = i; j < total_turmas - 1; j++) {
                 turmas[j] = turmas[j + 1];
             }
             total_turmas--;
-            salvarTurmasArquivo();
+            int salvo = salvarTurmasArquivo();
+            fecharTabela(&tabela_turmas);
+            if (!salvo) {
+                return 0;
+            }
             
             printf("Turma excluída com sucesso!\n");
             return 1;
         }
     }
     
+    fecharTabela(&tabela_turmas);
     printf("Erro: turma não encontrada.\n");
     return 0;
 }
 
+// Remove todas as matrículas de uma turma numa passada
+static int removerMatriculasDaTurma(int id_turma) {
+    int removidas = 0;
+    int mantidas = 0;
+
+    abrirEscritaTabela(&tabela_matriculas);
+
+    for (int i = 0; i < total_matriculas; i++) {
+        if (matriculas[i].id_turma == id_turma) {
+            agregarMatricula(&matriculas[i], NULL);
+            removidas++;
+        } else {
+            matriculas[mantidas++] = matriculas[i];
+        }
+    }
+
+    if (removidas > 0) {
+        total_matriculas = mantidas;
+        if (!salvarMatriculasArquivo()) {
+            removidas = -1; // Alteração desfeita: nada foi excluído
+        }
+    }
+    fecharTabela(&tabela_matriculas);
+    return removidas;
+}
+
+// Excluir uma turma e tudo o que depende dela
+int excluirTurmaEmCascata(int id, int simular, DependentesTurma *dependentes) {
+    DependentesTurma contagem = {0, 0, 0, 0, 0};
+    EstatisticasNotas notas;
+    FrequenciaTurma frequencia;
+    Turma turma;
+
+    if (!obterTurmaPorID(id, &turma)) {
+        printf("Erro: turma não encontrada.\n");
+        return 0;
+    }
+
+    if (simular) {
+        contagem.aulas = contarAulasDaTurma(id);
+        contagem.atividades = contarAtividadesDaTurma(id);
+        contagem.matriculas = contarAlunosDaTurma(id, 0);
+        estatisticasDaTurma(id, &notas);
+        contagem.notas = notas.quantidade;
+        contagem.chamadas = frequenciaDaTurma(id, &frequencia);
+        if (dependentes != NULL) {
+            *dependentes = contagem;
+        }
+        return 1;
+    }
+
+    int *ids_aulas = malloc(sizeof(int) * MAX_AULAS);
+    int *ids_atividades = malloc(sizeof(int) * MAX_ATIVIDADES);
+    if (ids_aulas == NULL || ids_atividades == NULL) {
+        free(ids_aulas);
+        free(ids_atividades);
+        printf("Erro: memória insuficiente.\n");
+        return 0;
+    }
+
+    if (!iniciarTransacaoTabelas()) {
+        free(ids_aulas);
+        free(ids_atividades);
+        return 0;
+    }
+
+    // Uma passada por tabela; nada é gravado antes da confirmação
+    contagem.aulas = excluirAulasDaTurma(id, ids_aulas, MAX_AULAS);
+    contagem.atividades = excluirAtividadesDaTurma(id, ids_atividades, MAX_ATIVIDADES);
+    contagem.notas = removerNotasDasAtividades(ids_atividades, contagem.atividades);
+    contagem.matriculas = removerMatriculasDaTurma(id);
+    int excluida = excluirTurma(id);
+
+    // As chamadas (frequencia.dat) saem só depois da publicação
+    contagem.chamadas = frequenciaDaTurma(id, &frequencia);
+    for (int i = 0; excluida && i < contagem.aulas && i < MAX_AULAS; i++) {
+        excluida = aposConfirmarTransacaoTabelas(excluirChamada, ids_aulas[i]);
+    }
+
+    int publicada = concluirTransacaoTabelas(excluida);
+    if (publicada && dependentes != NULL) {
+        *dependentes = contagem;
+    }
+
+    free(ids_aulas);
+    free(ids_atividades);
+    return publicada;
+}
+
 // ========== FUNÇÕES DE ASSOCIAÇÃO ALUNO-TURMA ==========
 
 // Associar um aluno a uma turma (matrícula)
 int associarAlunoTurma(int ra, int id_turma) {
-    carregarMatriculasMemoria();
+    abrirEscritaTabela(&tabela_matriculas);
     
     // Verificar se já está matriculado
     for (int i = 0; i < total_matriculas; i++) {
         if (matriculas[i].ra == ra && matriculas[i].id_turma == id_turma) {
+            fecharTabela(&tabela_matriculas);
             printf("Aviso: aluno já matriculado nesta turma.\n");
             return 0;
         }
     }
     
     // Adicionar matrícula
-    if (total_matriculas < MAX_TURMAS * 10) {
+    if (total_matriculas < MAX_MATRICULAS) {
         matriculas[total_matriculas].ra = ra;
         matriculas[total_matriculas].id_turma = id_turma;
+        agregarMatricula(NULL, &matriculas[total_matriculas]);
         total_matriculas++;
-        salvarMatriculasArquivo();
+        int salvo = salvarMatriculasArquivo();
+        fecharTabela(&tabela_matriculas);
+        if (!salvo) {
+            return 0;
+        }
         
         printf("Aluno RA %d matriculado na turma ID %d.\n", ra, id_turma);
         return 1;
     }
     
+    fecharTabela(&tabela_matriculas);
     printf("Erro: limite de matrículas atingido.\n");
     return 0;
 }
 
 // Remover um aluno de uma turma
 int removerAlunoTurma(int ra, int id_turma) {
-    carregarMatriculasMemoria();
+    abrirEscritaTabela(&tabela_matriculas);
     
     for (int i = 0; i < total_matriculas; i++) {
         if (matriculas[i].ra == ra && matriculas[i].id_turma == id_turma) {
+            agregarMatricula(&matriculas[i], NULL);
+            
             // Remove deslocando elementos
             for (int j = i; j < total_matriculas - 1; j++) {
                 matriculas[j] = matriculas[j + 1];
             }
             total_matriculas--;
-            salvarMatriculasArquivo();
+            int salvo = salvarMatriculasArquivo();
+            fecharTabela(&tabela_matriculas);
+            if (!salvo) {
+                return 0;
+            }
             
             printf("Aluno removido da turma com sucesso!\n");
             return 1;
         }
     }
     
+    fecharTabela(&tabela_matriculas);
     printf("Erro: matrícula não encontrada.\n");
     return 0;
 }
 
+// Cadastrar uma turma já com os alunos matriculados, numa única publicação
+int cadastrarTurmaComAlunos(Turma *turma, const int *ras, int total) {
+    Aluno aluno;
+    int ok;
+
+    if (turma == NULL || (ras == NULL && total > 0)) {
+        printf("Erro: turma inválida.\n");
+        return 0;
+    }
+
+    if (!iniciarTransacaoTabelas()) {
+        return 0;
+    }
+
+    // A turma nova já é visível para as matrículas (mesma transação)
+    ok = cadastrarTurma(turma);
+    for (int i = 0; ok && i < total; i++) {
+        ok = obterAlunoPorRA(ras[i], &aluno);
+        if (!ok) {
+            printf("Erro: aluno RA %d não encontrado.\n", ras[i]);
+            break;
+        }
+        ok = associarAlunoTurma(ras[i], turma->id);
+    }
+
+    return concluirTransacaoTabelas(ok);
+}
+
 // Listar todos os alunos de uma turma
 int listarAlunosDaTurma(int id_turma, int *ras_destino, int max) {
-    carregarMatriculasMemoria();
+    abrirLeituraTabela(&tabela_matriculas);
     
     int count = 0;
     
@@ -239,12 +504,51 @@ int listarAlunosDaTurma(int id_turma, int *ras_destino, int max) {
         }
     }
     
+    fecharTabela(&tabela_matriculas);
     return count;
 }
 
+// Listar os alunos de uma turma já juntados ao cadastro (RA, nome, email, ativo)
+int listarAlunosDaTurmaDetalhado(int id_turma, int apenas_ativos, Aluno *destino, int max) {
+    abrirLeituraTabela(&tabela_matriculas);
+    
+    int *ras = malloc(sizeof(int) * (size_t)(total_matriculas > 0 ? total_matriculas : 1));
+    int count = 0;
+    for (int i = 0; ras != NULL && i < total_matriculas; i++) {
+        if (matriculas[i].id_turma == id_turma) {
+            ras[count++] = matriculas[i].ra;
+        }
+    }
+    
+    fecharTabela(&tabela_matriculas);
+    
+    // A junção trava só a tabela de alunos (nunca as duas ao mesmo tempo)
+    if (ras == NULL) {
+        return 0;
+    }
+    int linhas = juntarAlunosPorRA(ras, count, apenas_ativos, destino, max);
+    free(ras);
+    return linhas;
+}
+
+// Contar os alunos de uma turma em O(1)
+int contarAlunosDaTurma(int id_turma, int apenas_ativos) {
+    AgregadoTurma agregado;
+    
+    // O estado ativo vem da tabela de alunos: confere o CSV dela primeiro
+    // (sem segurar a trava das matrículas)
+    contarAlunos(0);
+    
+    abrirLeituraTabela(&tabela_matriculas);
+    lerAgregadoTurma(id_turma, &agregado);
+    fecharTabela(&tabela_matriculas);
+    
+    return apenas_ativos ? agregado.alunos_ativos : agregado.alunos;
+}
+
 // Listar todas as turmas de um aluno
 int listarTurmasDoAluno(int ra, int *ids_destino, int max) {
-    carregarMatriculasMemoria();
+    abrirLeituraTabela(&tabela_matriculas);
     
     int count = 0;
     
@@ -255,25 +559,41 @@ int listarTurmasDoAluno(int ra, int *ids_destino, int max) {
         }
     }
     
+    fecharTabela(&tabela_matriculas);
+    return count;
+}
+
+// Listar todas as matrículas (pares RA/turma)
+int listarMatriculas(AlunoTurma *destino, int max) {
+    abrirLeituraTabela(&tabela_matriculas);
+    
+    int count = (total_matriculas < max) ? total_matriculas : max;
+    memcpy(destino, matriculas, sizeof(AlunoTurma) * (size_t)count);
+    
+    fecharTabela(&tabela_matriculas);
     return count;
 }
 
 // Verificar se um aluno está matriculado em uma turma
 int verificarMatricula(int ra, int id_turma) {
-    carregarMatriculasMemoria();
+    int matriculado = 0;
+    
+    abrirLeituraTabela(&tabela_matriculas);
     
     for (int i = 0; i < total_matriculas; i++) {
         if (matriculas[i].ra == ra && matriculas[i].id_turma == id_turma) {
-            return 1; // Matriculado
+            matriculado = 1;
+            break;
         }
     }
     
-    return 0; // Não matriculado
+    fecharTabela(&tabela_matriculas);
+    return matriculado;
 }
 
 // Gerar próximo ID disponível de turma
 int gerarProximoIDTurma(void) {
-    carregarTurmasMemoria();
+    abrirLeituraTabela(&tabela_turmas);
     
     int maior_id = 0;
     
@@ -284,5 +604,6 @@ int gerarProximoIDTurma(void) {
         }
     }
     
+    fecharTabela(&tabela_turmas);
     return maior_id + 1;
-}
\ No newline at end of file
+}
@@ -6,6 +6,7 @@
 #define MAX_TURMAS 500
 #define ARQUIVO_TURMAS "data/turmas.csv"
 #define ARQUIVO_ALUNO_TURMA "data/aluno_turma.csv"
+#define MAX_MATRICULAS (MAX_TURMAS * 10)
 
 // ========== FUNÇÕES DE GERENCIAMENTO DE TURMAS ==========
 
@@ -17,10 +18,21 @@ int cadastrarTurma(Turma *turma);
 // Retorna: ponteiro para a turma ou NULL se não encontrada
 Turma* buscarTurmaPorID(int id);
 
+// Função para copiar a turma de um ID para o destino (seguro entre threads)
+// Retorna: 1 se encontrada, 0 se não
+int obterTurmaPorID(int id, Turma *destino);
+
 // Função para listar todas as turmas
 // Retorna: número de turmas listadas
 int listarTurmas(Turma *destino, int max);
 
+// Função para contar as turmas (O(1), contador de agregado_manager)
+int contarTurmas(void);
+
+// Função para contar as turmas de um professor/ano/semestre (O(1))
+// professor NULL, ano 0 ou semestre 0 não filtram aquele campo
+int contarTurmasPor(const char *professor, int ano, int semestre);
+
 // Função para atualizar dados de uma turma
 // Retorna: 1 se sucesso, 0 se erro
 int atualizarTurma(Turma *turma);
@@ -29,6 +41,24 @@ int atualizarTurma(Turma *turma);
 // Retorna: 1 se sucesso, 0 se erro
 int excluirTurma(int id);
 
+// Registros que dependem de uma turma (exclusão em cascata)
+typedef struct {
+    int aulas;
+    int atividades;
+    int notas;                 // Notas das atividades da turma
+    int matriculas;
+    int chamadas;              // Chamadas das aulas (arquivo de frequência)
+} DependentesTurma;
+
+// Função para excluir uma turma junto com suas aulas, atividades, notas e
+// matrículas. Os CSVs alterados são publicados juntos por uma transação
+// (journal_manager.h): ou tudo muda, ou nada muda. As chamadas das aulas
+// removidas saem do arquivo de frequência logo depois da publicação.
+// simular = 1 não altera nada: só conta os dependentes pelos agregados da
+// turma (O(1)) e pelas notas de suas atividades
+// Retorna: 1 se sucesso (ou simulação de turma existente), 0 se erro
+int excluirTurmaEmCascata(int id, int simular, DependentesTurma *dependentes);
+
 // ========== FUNÇÕES DE ASSOCIAÇÃO ALUNO-TURMA ==========
 
 // Função para associar um aluno a uma turma (matrícula)
@@ -39,14 +69,33 @@ int associarAlunoTurma(int ra, int id_turma);
 // Retorna: 1 se sucesso, 0 se erro
 int removerAlunoTurma(int ra, int id_turma);
 
+// Função para cadastrar uma turma e matricular os alunos de "ras" numa
+// única transação: se um RA não existir ou se repetir, nada é gravado
+// Retorna: 1 se sucesso, 0 se erro
+int cadastrarTurmaComAlunos(Turma *turma, const int *ras, int total);
+
 // Função para listar todos os alunos de uma turma
 // Retorna: número de alunos na turma
 int listarAlunosDaTurma(int id_turma, int *ras_destino, int max);
 
+// Função para listar os alunos de uma turma já com o cadastro (RA, nome,
+// email, ativo), na ordem das matrículas: uma passada nas matrículas e uma
+// busca no índice de RA por aluno (ver juntarAlunosPorRA)
+// Retorna: número de linhas copiadas para destino
+int listarAlunosDaTurmaDetalhado(int id_turma, int apenas_ativos, Aluno *destino, int max);
+
+// Função para contar os alunos de uma turma (O(1))
+// Retorna: matrículas da turma, ou só as de alunos ativos
+int contarAlunosDaTurma(int id_turma, int apenas_ativos);
+
 // Função para listar todas as turmas de um aluno
 // Retorna: número de turmas do aluno
 int listarTurmasDoAluno(int ra, int *ids_destino, int max);
 
+// Função para copiar todas as matrículas
+// Retorna: número de matrículas copiadas
+int listarMatriculas(AlunoTurma *destino, int max);
+
 // Função para verificar se um aluno está matriculado em uma turma
 // Retorna: 1 se matriculado, 0 se não
 int verificarMatricula(int ra, int id_turma);
@@ -3,6 +3,9 @@
 #include <string.h>
 #include <ctype.h>
 #include "usuario_manager.h"
+#include "tabela_manager.h"
+#include "exportacao_manager.h"
+#include "sessao_manager.h"
 
 // ========== ARRAYS GLOBAIS (EM MEMÓRIA) ==========
 static Usuario usuarios[MAX_USUARIOS];
@@ -37,14 +40,21 @@ static void carregarUsuariosMemoria(void) {
     }
     
     fclose(arquivo);
+    publicarExportacao(EXPORTACAO_USUARIOS, usuarios, total_usuarios);
 }
 
-// Salva usuários da memória para o arquivo
-static void salvarUsuariosArquivo(void) {
-    FILE *arquivo = fopen(ARQUIVO_USUARIOS, "w");
+static int gravarUsuariosArquivo(void);
+
+// Trava leitores/escritor da tabela de usuários
+static TabelaResidente tabela_usuarios = TABELA_RESIDENTE_INIT(ARQUIVO_USUARIOS, carregarUsuariosMemoria,
+                                                               gravarUsuariosArquivo);
+
+// Grava usuários da memória para o arquivo (exige trava de escrita)
+static int gravarUsuariosArquivo(void) {
+    FILE *arquivo = abrirEscritaAtomica(ARQUIVO_USUARIOS);
     if (arquivo == NULL) {
         printf("Erro ao abrir arquivo %s para escrita.\n", ARQUIVO_USUARIOS);
-        return;
+        return 0;
     }
     
     fprintf(arquivo, "ID,Login,Senha,Tipo,Ativo\n");
@@ -58,8 +68,43 @@ static void salvarUsuariosArquivo(void) {
                 usuarios[i].ativo);
     }
     
-    fclose(arquivo);
+    if (!concluirEscritaAtomica(arquivo, ARQUIVO_USUARIOS)) {
+        printf("Erro ao gravar arquivo %s.\n", ARQUIVO_USUARIOS);
+        return 0;
+    }
+    marcarTabelaSalva(&tabela_usuarios);
     printf("Usuários salvos com sucesso em %s\n", ARQUIVO_USUARIOS);
+    return 1;
+}
+
+// Publica a alteração e grava agora ou em segundo plano (exige trava de escrita)
+static int salvarUsuariosArquivo(void) {
+    publicarExportacao(EXPORTACAO_USUARIOS, usuarios, total_usuarios);
+    return registrarAlteracaoTabela(&tabela_usuarios);
+}
+
+// Verifica login duplicado (exige trava já obtida)
+static int loginExisteSemTrava(const char *login) {
+    for (int i = 0; i < total_usuarios; i++) {
+        if (strcmp(usuarios[i].login, login) == 0) {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+// Calcula o próximo ID livre (exige trava já obtida)
+static int proximoIDUsuarioSemTrava(void) {
+    int maior_id = 0;
+    
+    for (int i = 0; i < total_usuarios; i++) {
+        if (usuarios[i].id > maior_id) {
+            maior_id = usuarios[i].id;
+        }
+    }
+    
+    return maior_id + 1;
 }
 
 // ========== IMPLEMENTAÇÃO DAS FUNÇÕES PÚBLICAS ==========
@@ -77,16 +122,18 @@ int cadastrarUsuario(Usuario *usuario) {
         return 0;
     }
     
-    carregarUsuariosMemoria();
+    abrirEscritaTabela(&tabela_usuarios);
     
     // Verificar se login já existe
-    if (loginExiste(usuario->login)) {
+    if (loginExisteSemTrava(usuario->login)) {
+        fecharTabela(&tabela_usuarios);
         printf("Erro: login '%s' já está em uso.\n", usuario->login);
         return 0;
     }
     
     // Verificar limite
     if (total_usuarios >= MAX_USUARIOS) {
+        fecharTabela(&tabela_usuarios);
         printf("Erro: limite de usuários atingido.\n");
         return 0;
     }
@@ -94,45 +141,102 @@ int cadastrarUsuario(Usuario *usuario) {
     // Adicionar novo usuário
     usuarios[total_usuarios] = *usuario;
     total_usuarios++;
-    salvarUsuariosArquivo();
+    int salvo = salvarUsuariosArquivo();
+    fecharTabela(&tabela_usuarios);
+    if (!salvo) {
+        return 0;
+    }
     
     printf("Usuário '%s' cadastrado com sucesso!\n", usuario->login);
     return 1;
 }
 
 // Buscar usuário por ID
+// O ponteiro só é estável até a próxima escrita; entre threads use obterUsuarioPorID()
 Usuario* buscarUsuarioPorID(int id) {
-    carregarUsuariosMemoria();
+    Usuario *encontrado = NULL;
+    
+    abrirLeituraTabela(&tabela_usuarios);
+    
+    for (int i = 0; i < total_usuarios; i++) {
+        if (usuarios[i].id == id) {
+            encontrado = &usuarios[i];
+            break;
+        }
+    }
+    
+    fecharTabela(&tabela_usuarios);
+    return encontrado;
+}
+
+// Copiar usuário por ID para o destino
+int obterUsuarioPorID(int id, Usuario *destino) {
+    int encontrado = 0;
+    
+    if (destino == NULL) {
+        return 0;
+    }
+    
+    abrirLeituraTabela(&tabela_usuarios);
     
     for (int i = 0; i < total_usuarios; i++) {
         if (usuarios[i].id == id) {
-            return &usuarios[i];
+            *destino = usuarios[i];
+            encontrado = 1;
+            break;
         }
     }
     
-    return NULL;
+    fecharTabela(&tabela_usuarios);
+    return encontrado;
 }
 
 // Buscar usuário por login
 Usuario* buscarUsuarioPorLogin(const char *login) {
+    Usuario *encontrado = NULL;
+    
     if (login == NULL) {
         return NULL;
     }
     
-    carregarUsuariosMemoria();
+    abrirLeituraTabela(&tabela_usuarios);
     
     for (int i = 0; i < total_usuarios; i++) {
         if (strcmp(usuarios[i].login, login) == 0) {
-            return &usuarios[i];
+            encontrado = &usuarios[i];
+            break;
         }
     }
     
-    return NULL;
+    fecharTabela(&tabela_usuarios);
+    return encontrado;
+}
+
+// Copiar usuário por login para o destino
+int obterUsuarioPorLogin(const char *login, Usuario *destino) {
+    int encontrado = 0;
+    
+    if (login == NULL || destino == NULL) {
+        return 0;
+    }
+    
+    abrirLeituraTabela(&tabela_usuarios);
+    
+    for (int i = 0; i < total_usuarios; i++) {
+        if (strcmp(usuarios[i].login, login) == 0) {
+            *destino = usuarios[i];
+            encontrado = 1;
+            break;
+        }
+    }
+    
+    fecharTabela(&tabela_usuarios);
+    return encontrado;
 }
 
 // Listar todos os usuários
 int listarUsuarios(Usuario *destino, int max) {
-    carregarUsuariosMemoria();
+    abrirLeituraTabela(&tabela_usuarios);
     
     int count = (total_usuarios < max) ? total_usuarios : max;
     
@@ -140,6 +244,7 @@ int listarUsuarios(Usuario *destino, int max) {
         destino[i] = usuarios[i];
     }
     
+    fecharTabela(&tabela_usuarios);
     return count;
 }
 
@@ -149,38 +254,53 @@ int atualizarUsuario(Usuario *usuario) {
         return 0;
     }
     
-    carregarUsuariosMemoria();
+    abrirEscritaTabela(&tabela_usuarios);
     
     for (int i = 0; i < total_usuarios; i++) {
         if (usuarios[i].id == usuario->id) {
             // Não permite alterar o login
+            int perde_acesso = usuarios[i].ativo && !usuario->ativo;
             strcpy(usuarios[i].tipo, usuario->tipo);
             usuarios[i].ativo = usuario->ativo;
             // A senha não é alterada aqui (use alterarSenha)
             
-            salvarUsuariosArquivo();
+            int salvo = salvarUsuariosArquivo();
+            fecharTabela(&tabela_usuarios);
+            if (!salvo) {
+                return 0;
+            }
+            if (perde_acesso) {
+                invalidarSessoesUsuario(usuario->id);
+            }
             printf("Usuário atualizado com sucesso!\n");
             return 1;
         }
     }
     
+    fecharTabela(&tabela_usuarios);
     printf("Erro: usuário não encontrado.\n");
     return 0;
 }
 
 // Excluir um usuário (desativar)
 int excluirUsuario(int id) {
-    carregarUsuariosMemoria();
+    abrirEscritaTabela(&tabela_usuarios);
     
     for (int i = 0; i < total_usuarios; i++) {
         if (usuarios[i].id == id) {
             usuarios[i].ativo = 0;
-            salvarUsuariosArquivo();
+            int salvo = salvarUsuariosArquivo();
+            fecharTabela(&tabela_usuarios);
+            if (!salvo) {
+                return 0;
+            }
+            invalidarSessoesUsuario(id);
             printf("Usuário desativado com sucesso!\n");
             return 1;
         }
     }
     
+    fecharTabela(&tabela_usuarios);
     printf("Erro: usuário não encontrado.\n");
     return 0;
 }
@@ -196,24 +316,30 @@ int alterarSenha(int id, const char *senha_antiga, const char *senha_nova) {
         return 0;
     }
     
-    carregarUsuariosMemoria();
+    abrirEscritaTabela(&tabela_usuarios);
     
     for (int i = 0; i < total_usuarios; i++) {
         if (usuarios[i].id == id) {
             // Verificar senha antiga
             if (strcmp(usuarios[i].senha, senha_antiga) != 0) {
+                fecharTabela(&tabela_usuarios);
                 printf("Erro: senha antiga incorreta.\n");
                 return 0;
             }
             
             strcpy(usuarios[i].senha, senha_nova);
             
-            salvarUsuariosArquivo();
+            int salvo = salvarUsuariosArquivo();
+            fecharTabela(&tabela_usuarios);
+            if (!salvo) {
+                return 0;
+            }
             printf("Senha alterada com sucesso!\n");
             return 1;
         }
     }
     
+    fecharTabela(&tabela_usuarios);
     printf("Erro: usuário não encontrado.\n");
     return 0;
 }
@@ -229,18 +355,24 @@ int resetarSenha(int id, const char *nova_senha) {
         return 0;
     }
     
-    carregarUsuariosMemoria();
+    abrirEscritaTabela(&tabela_usuarios);
     
     for (int i = 0; i < total_usuarios; i++) {
         if (usuarios[i].id == id) {
             strcpy(usuarios[i].senha, nova_senha);
             
-            salvarUsuariosArquivo();
+            int salvo = salvarUsuariosArquivo();
+            fecharTabela(&tabela_usuarios);
+            if (!salvo) {
+                return 0;
+            }
+            invalidarSessoesUsuario(id);
             printf("Senha resetada com sucesso!\n");
             return 1;
         }
     }
     
+    fecharTabela(&tabela_usuarios);
     printf("Erro: usuário não encontrado.\n");
     return 0;
 }
@@ -306,32 +438,22 @@ int loginExiste(const char *login) {
         return 0;
     }
     
-    carregarUsuariosMemoria();
+    abrirLeituraTabela(&tabela_usuarios);
+    int existe = loginExisteSemTrava(login);
+    fecharTabela(&tabela_usuarios);
     
-    for (int i = 0; i < total_usuarios; i++) {
-        if (strcmp(usuarios[i].login, login) == 0) {
-            return 1;
-        }
-    }
-    
-    return 0;
+    return existe;
 }
 
 // ========== FUNÇÕES AUXILIARES ==========
 
 // Gerar próximo ID disponível de usuário
 int gerarProximoIDUsuario(void) {
-    carregarUsuariosMemoria();
-    
-    int maior_id = 0;
-    
-    for (int i = 0; i < total_usuarios; i++) {
-        if (usuarios[i].id > maior_id) {
-            maior_id = usuarios[i].id;
-        }
-    }
+    abrirLeituraTabela(&tabela_usuarios);
+    int proximo = proximoIDUsuarioSemTrava();
+    fecharTabela(&tabela_usuarios);
     
-    return maior_id + 1;
+    return proximo;
 }
 
 // Converter tipo de usuário em string
@@ -365,16 +487,23 @@ TipoUsuario stringParaTipoUsuario(const char *tipo_str) {
 
 // Criar usuário admin padrão (se não existir)
 int criarAdminPadrao(void) {
-    carregarUsuariosMemoria();
+    abrirEscritaTabela(&tabela_usuarios);
     
     // Verificar se já existe um admin
-    if (loginExiste("admin")) {
+    if (loginExisteSemTrava("admin")) {
+        fecharTabela(&tabela_usuarios);
         return 0; // Já existe
     }
     
+    if (total_usuarios >= MAX_USUARIOS) {
+        fecharTabela(&tabela_usuarios);
+        printf("Erro: limite de usuários atingido.\n");
+        return 0;
+    }
+    
     // Criar usuário admin
     Usuario admin;
-    admin.id = gerarProximoIDUsuario();
+    admin.id = proximoIDUsuarioSemTrava();
     strcpy(admin.login, "admin");
     
     // Senha padrão: "admin123"
@@ -386,7 +515,11 @@ int criarAdminPadrao(void) {
     // Adicionar à lista
     usuarios[total_usuarios] = admin;
     total_usuarios++;
-    salvarUsuariosArquivo();
+    int salvo = salvarUsuariosArquivo();
+    fecharTabela(&tabela_usuarios);
+    if (!salvo) {
+        return 0;
+    }
     
     printf("Usuário admin padrão criado!\n");
     printf("Login: admin\n");
@@ -23,10 +23,18 @@ int cadastrarUsuario(Usuario *usuario);
 // Retorna: ponteiro para o usuário ou NULL se não encontrado
 Usuario* buscarUsuarioPorID(int id);
 
+// Função para copiar o usuário de um ID para o destino (seguro entre threads)
+// Retorna: 1 se encontrado, 0 se não
+int obterUsuarioPorID(int id, Usuario *destino);
+
 // Função para buscar usuário por login
 // Retorna: ponteiro para o usuário ou NULL se não encontrado
 Usuario* buscarUsuarioPorLogin(const char *login);
 
+// Função para copiar o usuário de um login para o destino (seguro entre threads)
+// Retorna: 1 se encontrado, 0 se não
+int obterUsuarioPorLogin(const char *login, Usuario *destino);
+
 // Função para listar todos os usuários
 // Retorna: número de usuários listados
 int listarUsuarios(Usuario *destino, int max);
@@ -35,7 +43,7 @@ int listarUsuarios(Usuario *destino, int max);
 // Retorna: 1 se sucesso, 0 se erro
 int atualizarUsuario(Usuario *usuario);
 
-// Função para excluir um usuário (desativar)
+// Função para excluir um usuário (desativar e encerrar suas sessões)
 // Retorna: 1 se sucesso, 0 se erro
 int excluirUsuario(int id);
 
@@ -43,7 +51,7 @@ int excluirUsuario(int id);
 // Retorna: 1 se sucesso, 0 se erro
 int alterarSenha(int id, const char *senha_antiga, const char *senha_nova);
 
-// Função para resetar senha (admin)
+// Função para resetar senha (admin; encerra as sessões do usuário)
 // Retorna: 1 se sucesso, 0 se erro
 int resetarSenha(int id, const char *nova_senha);
 
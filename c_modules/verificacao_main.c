@@ -0,0 +1,76 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "structs.h"
+#include "verificacao_manager.h"
+
+// Verificação de integridade dos CSVs (fsck)
+//
+//   sistema_verificacao
+//   sistema_verificacao --dir backup/data --relatorio verificacao.json
+//   sistema_verificacao --reparar data_reparado
+//
+// Código de saída: 0 sem problemas, 1 com problemas, 2 erro
+
+#define DIRETORIO_PADRAO "data"
+
+static void exibirAjuda(const char *programa) {
+    printf("Uso: %s [opcoes]\n", programa);
+    printf("  --dir DIR         Diretorio dos CSVs (padrao: %s)\n", DIRETORIO_PADRAO);
+    printf("  --relatorio ARQ   Grava o relatorio JSON em ARQ ('-' = tela)\n");
+    printf("  --reparar DIR     Grava em DIR (novo) os CSVs sem as linhas com problema\n");
+    printf("  --sequencial      Verifica uma tabela por vez\n");
+}
+
+int main(int argc, char *argv[]) {
+    const char *diretorio = DIRETORIO_PADRAO;
+    OpcoesVerificacao opcoes = {NULL, NULL, 0};
+    ResumoVerificacao resumo;
+
+    for (int i = 1; i < argc; i++) {
+        const char *valor = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(argv[i], "--dir") == 0 && valor) {
+            diretorio = valor;
+            i++;
+        } else if (strcmp(argv[i], "--relatorio") == 0 && valor) {
+            opcoes.relatorio_json = valor;
+            i++;
+        } else if (strcmp(argv[i], "--reparar") == 0 && valor) {
+            opcoes.diretorio_reparo = valor;
+            i++;
+        } else if (strcmp(argv[i], "--sequencial") == 0) {
+            opcoes.sequencial = 1;
+        } else {
+            exibirAjuda(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 2;
+        }
+    }
+
+    if (opcoes.diretorio_reparo != NULL && strcmp(opcoes.diretorio_reparo, diretorio) == 0) {
+        printf("Erro: o reparo deve ir para outro diretorio.\n");
+        return 2;
+    }
+
+    long problemas = verificarDiretorioDados(diretorio, &opcoes, &resumo);
+    if (problemas < 0) {
+        return 2;
+    }
+
+    // Com o JSON na tela, o resumo vai para stderr para não misturar as saídas
+    FILE *saida = (opcoes.relatorio_json != NULL && strcmp(opcoes.relatorio_json, "-") == 0) ? stderr : stdout;
+    fprintf(saida, "%d tabelas, %ld linhas verificadas em %.3f s: %ld problema(s).\n", resumo.tabelas,
+            resumo.linhas, resumo.segundos, problemas);
+    for (int t = 0; t < TOTAL_TIPOS_PROBLEMA; t++) {
+        if (resumo.por_tipo[t] > 0) {
+            fprintf(saida, "  %-18s %ld\n", nomeProblemaVerificacao(t), resumo.por_tipo[t]);
+        }
+    }
+    if (opcoes.diretorio_reparo != NULL) {
+        fprintf(saida, "Reparo em %s: %ld linha(s) descartada(s), %ld campo(s) cortado(s).\n",
+                opcoes.diretorio_reparo, resumo.linhas_descartadas, resumo.campos_cortados);
+    }
+
+    return problemas > 0 ? 1 : 0;
+}
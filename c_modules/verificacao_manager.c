@@ -0,0 +1,789 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "verificacao_manager.h"
+#include "tabela_manager.h"
+#include "aula_manager.h"
+#include "nota_manager.h"
+#include "structs.h"
+
+#ifdef _WIN32
+#include <direct.h>
+#include <io.h>
+#define close _close
+#define criarDiretorio(caminho) _mkdir(caminho)
+#else
+#include <unistd.h>
+#define criarDiretorio(caminho) mkdir((caminho), 0755)
+#endif
+
+#define MAX_CAMPOS 5
+
+#define CAMPO_INTEIRO 0
+#define CAMPO_TEXTO 1
+#define CAMPO_DATA 2
+#define CAMPO_REAL 3
+
+#define TAB_ALUNOS 0
+#define TAB_TURMAS 1
+#define TAB_AULAS 2
+#define TAB_MATRICULAS 3
+#define TAB_ATIVIDADES 4
+#define TAB_USUARIOS 5
+#define TAB_NOTAS 6
+#define TOTAL_TABELAS 7
+
+// ========== ESQUEMA DOS CSVs ==========
+
+typedef struct {
+    const char *nome;
+    int tipo;                  // CAMPO_*
+    int largura;               // Tamanho do campo na struct, '\0' incluído (0 = sem limite)
+} EsquemaCampo;
+
+typedef struct {
+    const char *arquivo;       // Nome dentro do diretório de dados
+    const char *cabecalho;
+    int total_campos;
+    EsquemaCampo campos[MAX_CAMPOS];
+    int chave[2];              // Colunas da chave primária (segunda = -1 se simples)
+    int texto_unico;           // Coluna de texto que também não se repete (-1 = nenhuma)
+} EsquemaTabela;
+
+static const EsquemaTabela esquemas[TOTAL_TABELAS] = {
+    {"alunos.csv", "RA,Nome,Email,Ativo", 4,
+     {{"RA", CAMPO_INTEIRO, 0}, {"Nome", CAMPO_TEXTO, MAX_NOME}, {"Email", CAMPO_TEXTO, MAX_NOME},
+      {"Ativo", CAMPO_INTEIRO, 0}},
+     {0, -1}, -1},
+    {"turmas.csv", "ID,Nome,Professor,Ano,Semestre", 5,
+     {{"ID", CAMPO_INTEIRO, 0}, {"Nome", CAMPO_TEXTO, MAX_TURMA_NOME}, {"Professor", CAMPO_TEXTO, MAX_NOME},
+      {"Ano", CAMPO_INTEIRO, 0}, {"Semestre", CAMPO_INTEIRO, 0}},
+     {0, -1}, -1},
+    {"aulas.csv", "ID,ID_Turma,Data,Conteudo", 4,
+     {{"ID", CAMPO_INTEIRO, 0}, {"ID_Turma", CAMPO_INTEIRO, 0}, {"Data", CAMPO_DATA, 11},
+      {"Conteudo", CAMPO_TEXTO, MAX_CONTEUDO}},
+     {0, -1}, -1},
+    {"aluno_turma.csv", "RA,ID_Turma", 2,
+     {{"RA", CAMPO_INTEIRO, 0}, {"ID_Turma", CAMPO_INTEIRO, 0}},
+     {0, 1}, -1},
+    {"atividades.csv", "ID,ID_Turma,Titulo,Descricao,Arquivo", 5,
+     {{"ID", CAMPO_INTEIRO, 0}, {"ID_Turma", CAMPO_INTEIRO, 0}, {"Titulo", CAMPO_TEXTO, MAX_NOME},
+      {"Descricao", CAMPO_TEXTO, MAX_CONTEUDO}, {"Arquivo", CAMPO_TEXTO, MAX_PATH}},
+     {0, -1}, -1},
+    {"usuarios.csv", "ID,Login,Senha,Tipo,Ativo", 5,
+     {{"ID", CAMPO_INTEIRO, 0}, {"Login", CAMPO_TEXTO, MAX_LOGIN}, {"Senha", CAMPO_TEXTO, MAX_SENHA},
+      {"Tipo", CAMPO_TEXTO, 20}, {"Ativo", CAMPO_INTEIRO, 0}},
+     {0, -1}, 1},
+    {"notas.csv", "RA,ID_Atividade,Nota", 3,
+     {{"RA", CAMPO_INTEIRO, 0}, {"ID_Atividade", CAMPO_INTEIRO, 0}, {"Nota", CAMPO_REAL, 0}},
+     {0, 1}, -1},
+};
+
+static const char *nomes_problemas[TOTAL_TIPOS_PROBLEMA] = {
+    "linha_malformada", "chave_duplicada", "chave_estrangeira", "data_invalida", "campo_truncado",
+    "valor_invalido"
+};
+
+// ========== ESTRUTURAS INTERNAS ==========
+
+// Chave (inteiro ou par de inteiros em 64 bits) -> linha, endereçamento aberto
+typedef struct {
+    uint64_t *chaves;
+    int *linhas;               // -1 = posição livre
+    size_t mascara;            // Capacidade - 1 (potência de 2)
+} ConjuntoChaves;
+
+typedef struct {
+    char *campos[MAX_CAMPOS];  // Apontam para o buffer do arquivo
+    int valores[MAX_CAMPOS];   // Campos inteiros já convertidos
+    int numero;                // Linha no arquivo (o cabeçalho é a 1)
+    unsigned char descartada;  // Fica fora do reparo
+} LinhaVerificada;
+
+typedef struct {
+    int linha;                 // Índice em TabelaVerificada.linhas
+    int tipo;                  // PROBLEMA_*
+    int campo;                 // -1 = linha inteira
+    int referencia;            // Duplicada: linha da primeira ocorrência; estrangeira: TAB_*
+    const char *detalhe;
+} ProblemaVerificado;
+
+typedef struct {
+    const EsquemaTabela *esquema;
+    int indice;                // TAB_*
+    int existe;
+    char *conteudo;
+    LinhaVerificada *linhas;
+    int total;
+    ConjuntoChaves chaves;     // Chave primária -> linha mantida
+    ConjuntoChaves textos;     // Hash do texto único -> linha mantida
+    ProblemaVerificado *problemas;    // Até MAX_PROBLEMAS_RELATORIO detalhados
+    int total_problemas;
+    int capacidade_problemas;
+    long por_tipo[TOTAL_TIPOS_PROBLEMA];
+    int sem_memoria;
+} TabelaVerificada;
+
+typedef struct {
+    TabelaVerificada *tabelas;
+    int indice;
+    const char *diretorio;
+} TarefaVerificacao;
+
+// ========== CONJUNTO DE CHAVES ==========
+
+static uint64_t espalhar64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+static uint64_t hashTexto(const char *texto) {
+    uint64_t hash = 1469598103934665603ULL;             // FNV-1a
+    for (; *texto; texto++) {
+        hash = (hash ^ (unsigned char)*texto) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+static uint64_t chaveDaLinha(const LinhaVerificada *linha, const int colunas[2]) {
+    uint64_t chave = (uint32_t)linha->valores[colunas[0]];
+    if (colunas[1] >= 0) {
+        chave = (chave << 32) | (uint32_t)linha->valores[colunas[1]];
+    }
+    return chave;
+}
+
+static uint64_t chaveDoPar(int a, int b) {
+    return ((uint64_t)(uint32_t)a << 32) | (uint32_t)b;
+}
+
+// Capacidade para "elementos" chaves com ocupação de no máximo 50%
+static int criarConjunto(ConjuntoChaves *conjunto, int elementos) {
+    size_t capacidade = 16;
+    while (capacidade < (size_t)elementos * 2) {
+        capacidade *= 2;
+    }
+    conjunto->chaves = malloc(sizeof(uint64_t) * capacidade);
+    conjunto->linhas = malloc(sizeof(int) * capacidade);
+    conjunto->mascara = capacidade - 1;
+    if (conjunto->chaves == NULL || conjunto->linhas == NULL) {
+        return 0;
+    }
+    memset(conjunto->linhas, 0xff, sizeof(int) * capacidade);
+    return 1;
+}
+
+static void liberarConjunto(ConjuntoChaves *conjunto) {
+    free(conjunto->chaves);
+    free(conjunto->linhas);
+    conjunto->chaves = NULL;
+    conjunto->linhas = NULL;
+}
+
+// Insere chave -> linha, a menos que ela já exista; com coluna_texto >= 0 a
+// chave é o hash do texto e a igualdade confere o próprio texto
+// Retorna: linha já existente com a chave, -1 se inseriu
+static int inserirChave(ConjuntoChaves *conjunto, uint64_t chave, int linha, const TabelaVerificada *tabela,
+                        int coluna_texto) {
+    size_t posicao = espalhar64(chave) & conjunto->mascara;
+
+    while (conjunto->linhas[posicao] >= 0) {
+        int existente = conjunto->linhas[posicao];
+        if (conjunto->chaves[posicao] == chave &&
+            (coluna_texto < 0 || strcmp(tabela->linhas[existente].campos[coluna_texto],
+                                        tabela->linhas[linha].campos[coluna_texto]) == 0)) {
+            return existente;
+        }
+        posicao = (posicao + 1) & conjunto->mascara;
+    }
+    conjunto->chaves[posicao] = chave;
+    conjunto->linhas[posicao] = linha;
+    return -1;
+}
+
+// Retorna: linha com a chave, -1 se não há (conjunto vazio também)
+static int buscarChave(const ConjuntoChaves *conjunto, uint64_t chave) {
+    if (conjunto->linhas == NULL) {
+        return -1;
+    }
+    size_t posicao = espalhar64(chave) & conjunto->mascara;
+    while (conjunto->linhas[posicao] >= 0) {
+        if (conjunto->chaves[posicao] == chave) {
+            return conjunto->linhas[posicao];
+        }
+        posicao = (posicao + 1) & conjunto->mascara;
+    }
+    return -1;
+}
+
+// ========== LEITURA E QUEBRA EM CAMPOS ==========
+
+// Registra um problema (descarta a linha, exceto campo truncado)
+static void registrarProblema(TabelaVerificada *tabela, int linha, int tipo, int campo, int referencia,
+                              const char *detalhe) {
+    tabela->por_tipo[tipo]++;
+    if (tipo != PROBLEMA_CAMPO_TRUNCADO) {
+        tabela->linhas[linha].descartada = 1;
+    }
+
+    if (tabela->total_problemas >= MAX_PROBLEMAS_RELATORIO) {
+        return;
+    }
+    if (tabela->total_problemas == tabela->capacidade_problemas) {
+        int nova = tabela->capacidade_problemas ? tabela->capacidade_problemas * 2 : 64;
+        ProblemaVerificado *problemas = realloc(tabela->problemas, sizeof(ProblemaVerificado) * (size_t)nova);
+        if (problemas == NULL) {
+            tabela->sem_memoria = 1;
+            return;
+        }
+        tabela->problemas = problemas;
+        tabela->capacidade_problemas = nova;
+    }
+    ProblemaVerificado *problema = &tabela->problemas[tabela->total_problemas++];
+    problema->linha = linha;
+    problema->tipo = tipo;
+    problema->campo = campo;
+    problema->referencia = referencia;
+    problema->detalhe = detalhe;
+}
+
+// Lê o CSV inteiro sob a trava compartilhada do protocolo
+// Retorna: tamanho lido, -1 se o arquivo não existe ou faltou memória
+static long lerArquivoInteiro(const char *caminho, char **destino) {
+    TravaArquivo trava = TRAVA_ARQUIVO_INIT;
+    long tamanho = -1;
+    int travou = travarArquivo(&trava, caminho, TRAVA_COMPARTILHADA);
+    FILE *arquivo = fopen(caminho, "rb");
+
+    *destino = NULL;
+    if (arquivo != NULL) {
+        fseek(arquivo, 0, SEEK_END);
+        tamanho = ftell(arquivo);
+        fseek(arquivo, 0, SEEK_SET);
+        *destino = malloc((size_t)tamanho + 1);
+        if (*destino == NULL || fread(*destino, 1, (size_t)tamanho, arquivo) != (size_t)tamanho) {
+            free(*destino);
+            *destino = NULL;
+            tamanho = -1;
+        } else {
+            (*destino)[tamanho] = '\0';
+        }
+        fclose(arquivo);
+    }
+
+    if (travou) {
+        destravarArquivo(&trava);
+    }
+    if (trava.descritor >= 0) {
+        close(trava.descritor);
+    }
+    return tamanho;
+}
+
+// Converte um campo inteiro inteiro (sem sobras)
+static int converterInteiro(const char *texto, int *valor) {
+    char *fim;
+    long numero;
+
+    errno = 0;
+    numero = strtol(texto, &fim, 10);
+    if (fim == texto || *fim != '\0' || errno != 0 || numero < -2147483647L - 1 || numero > 2147483647L) {
+        return 0;
+    }
+    *valor = (int)numero;
+    return 1;
+}
+
+// Faixas que os cadastros garantem
+static void conferirValores(TabelaVerificada *tabela, int i) {
+    LinhaVerificada *linha = &tabela->linhas[i];
+
+    switch (tabela->indice) {
+        case TAB_ALUNOS:
+            if (linha->valores[3] != 0 && linha->valores[3] != 1) {
+                registrarProblema(tabela, i, PROBLEMA_VALOR_INVALIDO, 3, -1, "ativo deve ser 0 ou 1");
+            }
+            break;
+        case TAB_TURMAS:
+            if (linha->valores[4] != 1 && linha->valores[4] != 2) {
+                registrarProblema(tabela, i, PROBLEMA_VALOR_INVALIDO, 4, -1, "semestre deve ser 1 ou 2");
+            }
+            break;
+        case TAB_USUARIOS:
+            if (strcmp(linha->campos[3], "ADMIN") != 0 && strcmp(linha->campos[3], "PROFESSOR") != 0 &&
+                strcmp(linha->campos[3], "ALUNO") != 0) {
+                registrarProblema(tabela, i, PROBLEMA_VALOR_INVALIDO, 3, -1, "tipo deve ser ADMIN, PROFESSOR ou ALUNO");
+            }
+            if (linha->valores[4] != 0 && linha->valores[4] != 1) {
+                registrarProblema(tabela, i, PROBLEMA_VALOR_INVALIDO, 4, -1, "ativo deve ser 0 ou 1");
+            }
+            break;
+        case TAB_NOTAS: {
+            double nota = strtod(linha->campos[2], NULL);
+            if (!(nota >= 0.0 && nota <= NOTA_MAXIMA)) {
+                registrarProblema(tabela, i, PROBLEMA_VALOR_INVALIDO, 2, -1, "nota fora de 0..10");
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// Quebra uma linha em campos (o último vai até o fim, como nos carregadores)
+// e confere formato, datas e larguras
+static void verificarLinha(TabelaVerificada *tabela, int i, char *texto) {
+    const EsquemaTabela *esquema = tabela->esquema;
+    LinhaVerificada *linha = &tabela->linhas[i];
+    int total = esquema->total_campos;
+
+    for (int k = 0; k < total; k++) {
+        linha->campos[k] = texto;
+        if (k < total - 1) {
+            char *virgula = strchr(texto, ',');
+            if (virgula == NULL) {
+                registrarProblema(tabela, i, PROBLEMA_LINHA_MALFORMADA, k + 1, -1,
+                                  texto[0] == '\0' && k == 0 ? "linha vazia" : "campo ausente");
+                return;
+            }
+            *virgula = '\0';
+            texto = virgula + 1;
+        }
+    }
+
+    for (int k = 0; k < total; k++) {
+        const EsquemaCampo *campo = &esquema->campos[k];
+        char *valor = linha->campos[k];
+        char *fim;
+
+        switch (campo->tipo) {
+            case CAMPO_INTEIRO:
+                if (!converterInteiro(valor, &linha->valores[k])) {
+                    registrarProblema(tabela, i, PROBLEMA_LINHA_MALFORMADA, k, -1, "numero invalido");
+                    return;
+                }
+                break;
+            case CAMPO_REAL:
+                strtod(valor, &fim);
+                if (fim == valor || *fim != '\0') {
+                    registrarProblema(tabela, i, PROBLEMA_LINHA_MALFORMADA, k, -1, "numero invalido");
+                    return;
+                }
+                break;
+            case CAMPO_DATA:
+                if (!validarData(valor)) {
+                    registrarProblema(tabela, i, PROBLEMA_DATA_INVALIDA, k, -1, "data invalida (DD/MM/AAAA)");
+                }
+                break;
+            default:
+                // "%[^,]" não lê campo vazio e desalinha os seguintes (o último pode ficar vazio)
+                if (valor[0] == '\0' && k < total - 1) {
+                    registrarProblema(tabela, i, PROBLEMA_LINHA_MALFORMADA, k, -1, "texto vazio");
+                    return;
+                }
+                if (campo->largura > 0 && strlen(valor) >= (size_t)campo->largura) {
+                    registrarProblema(tabela, i, PROBLEMA_CAMPO_TRUNCADO, k, -1, "maior que o campo da struct");
+                }
+                break;
+        }
+    }
+
+    conferirValores(tabela, i);
+}
+
+// Etapa 1: lê, quebra em campos, confere cada linha e as chaves primárias
+static void *verificarTabela(void *arg) {
+    TarefaVerificacao *tarefa = (TarefaVerificacao *)arg;
+    TabelaVerificada *tabela = &tarefa->tabelas[tarefa->indice];
+    const EsquemaTabela *esquema = tabela->esquema;
+    char caminho[MAX_PATH * 2];
+    long tamanho;
+
+    snprintf(caminho, sizeof(caminho), "%s/%s", tarefa->diretorio, esquema->arquivo);
+    tamanho = lerArquivoInteiro(caminho, &tabela->conteudo);
+    if (tamanho < 0) {
+        return NULL;
+    }
+    tabela->existe = 1;
+
+    int capacidade = 1;
+    for (long i = 0; i < tamanho; i++) {
+        capacidade += tabela->conteudo[i] == '\n';
+    }
+    tabela->linhas = calloc((size_t)capacidade, sizeof(LinhaVerificada));
+    if (tabela->linhas == NULL) {
+        tabela->sem_memoria = 1;
+        return NULL;
+    }
+
+    // Primeira linha é o cabeçalho (ignorado, como nos carregadores)
+    char *texto = tabela->conteudo;
+    int numero = 0;
+    while (*texto != '\0') {
+        char *fim = strchr(texto, '\n');
+        char *proxima = fim ? fim + 1 : texto + strlen(texto);
+        if (fim != NULL) {
+            *fim = '\0';
+            if (fim > texto && fim[-1] == '\r') {
+                fim[-1] = '\0';
+            }
+        }
+        numero++;
+        if (numero > 1) {
+            int i = tabela->total++;
+            tabela->linhas[i].numero = numero;
+            verificarLinha(tabela, i, texto);
+        }
+        texto = proxima;
+    }
+
+    // Chave primária e texto único: vale a primeira linha mantida
+    if (!criarConjunto(&tabela->chaves, tabela->total) ||
+        (esquema->texto_unico >= 0 && !criarConjunto(&tabela->textos, tabela->total))) {
+        tabela->sem_memoria = 1;
+        return NULL;
+    }
+    for (int i = 0; i < tabela->total; i++) {
+        LinhaVerificada *linha = &tabela->linhas[i];
+        if (linha->descartada) {
+            continue;
+        }
+        int existente = inserirChave(&tabela->chaves, chaveDaLinha(linha, esquema->chave), i, tabela, -1);
+        if (existente >= 0) {
+            registrarProblema(tabela, i, PROBLEMA_CHAVE_DUPLICADA, esquema->chave[0],
+                              tabela->linhas[existente].numero, "chave primaria repetida");
+            continue;
+        }
+        if (esquema->texto_unico >= 0) {
+            int coluna = esquema->texto_unico;
+            existente = inserirChave(&tabela->textos, hashTexto(linha->campos[coluna]), i, tabela, coluna);
+            if (existente >= 0) {
+                registrarProblema(tabela, i, PROBLEMA_CHAVE_DUPLICADA, coluna, tabela->linhas[existente].numero,
+                                  "valor unico repetido");
+            }
+        }
+    }
+    return NULL;
+}
+
+// ========== CHAVES ESTRANGEIRAS ==========
+
+// Linha mantida da tabela pai com a chave (-1 se não há)
+static int linhaMantida(const TabelaVerificada *pai, uint64_t chave) {
+    int linha = buscarChave(&pai->chaves, chave);
+    return (linha >= 0 && !pai->linhas[linha].descartada) ? linha : -1;
+}
+
+static void conferirEstrangeira(TabelaVerificada *tabela, int i, int campo, const TabelaVerificada *pai) {
+    uint64_t chave = (uint32_t)tabela->linhas[i].valores[campo];
+    if (linhaMantida(pai, chave) < 0) {
+        registrarProblema(tabela, i, PROBLEMA_CHAVE_ESTRANGEIRA, campo, pai->indice, "sem correspondente");
+    }
+}
+
+// Etapas 2 e 3: cada tabela confere as suas referências
+static void *verificarReferencias(void *arg) {
+    TarefaVerificacao *tarefa = (TarefaVerificacao *)arg;
+    TabelaVerificada *tabelas = tarefa->tabelas;
+    TabelaVerificada *tabela = &tabelas[tarefa->indice];
+
+    for (int i = 0; tabela->existe && i < tabela->total; i++) {
+        if (tabela->linhas[i].descartada) {
+            continue;
+        }
+        switch (tarefa->indice) {
+            case TAB_AULAS:
+            case TAB_ATIVIDADES:
+                conferirEstrangeira(tabela, i, 1, &tabelas[TAB_TURMAS]);
+                break;
+            case TAB_MATRICULAS:
+                conferirEstrangeira(tabela, i, 0, &tabelas[TAB_ALUNOS]);
+                conferirEstrangeira(tabela, i, 1, &tabelas[TAB_TURMAS]);
+                break;
+            case TAB_NOTAS: {
+                const LinhaVerificada *nota = &tabela->linhas[i];
+                conferirEstrangeira(tabela, i, 0, &tabelas[TAB_ALUNOS]);
+                int atividade = linhaMantida(&tabelas[TAB_ATIVIDADES], (uint32_t)nota->valores[1]);
+                if (atividade < 0) {
+                    registrarProblema(tabela, i, PROBLEMA_CHAVE_ESTRANGEIRA, 1, TAB_ATIVIDADES, "sem correspondente");
+                } else {
+                    int id_turma = tabelas[TAB_ATIVIDADES].linhas[atividade].valores[1];
+                    if (linhaMantida(&tabelas[TAB_MATRICULAS], chaveDoPar(nota->valores[0], id_turma)) < 0) {
+                        registrarProblema(tabela, i, PROBLEMA_CHAVE_ESTRANGEIRA, 0, TAB_MATRICULAS,
+                                          "aluno fora da turma da atividade");
+                    }
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return NULL;
+}
+
+// Executa uma função para as tabelas pedidas, uma thread por tabela
+static void executarEtapa(TabelaVerificada *tabelas, const int *indices, int total, void *(*funcao)(void *),
+                          const char *diretorio, int sequencial) {
+    TarefaVerificacao tarefas[TOTAL_TABELAS];
+    pthread_t threads[TOTAL_TABELAS];
+    int criada[TOTAL_TABELAS];
+
+    for (int i = 0; i < total; i++) {
+        tarefas[i].tabelas = tabelas;
+        tarefas[i].indice = indices[i];
+        tarefas[i].diretorio = diretorio;
+        criada[i] = !sequencial && pthread_create(&threads[i], NULL, funcao, &tarefas[i]) == 0;
+        if (!criada[i]) {
+            funcao(&tarefas[i]);
+        }
+    }
+    for (int i = 0; i < total; i++) {
+        if (criada[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+}
+
+// ========== RELATÓRIO JSON ==========
+
+static void escreverTextoJson(FILE *saida, const char *texto) {
+    fputc('"', saida);
+    for (const unsigned char *c = (const unsigned char *)texto; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(saida, "\\%c", *c);
+        } else if (*c < 0x20) {
+            fprintf(saida, "\\u%04x", *c);
+        } else {
+            fputc(*c, saida);
+        }
+    }
+    fputc('"', saida);
+}
+
+static void escreverRelatorio(FILE *saida, const char *diretorio, const TabelaVerificada *tabelas,
+                              const ResumoVerificacao *resumo) {
+    long detalhados = 0;
+    int primeiro = 1;
+
+    fprintf(saida, "{\n  \"diretorio\": ");
+    escreverTextoJson(saida, diretorio);
+    fprintf(saida, ",\n  \"segundos\": %.3f,\n  \"linhas\": %ld,\n  \"problemas\": %ld,\n", resumo->segundos,
+            resumo->linhas, resumo->problemas);
+
+    fprintf(saida, "  \"por_tipo\": {");
+    for (int t = 0; t < TOTAL_TIPOS_PROBLEMA; t++) {
+        fprintf(saida, "%s\"%s\": %ld", t ? ", " : "", nomes_problemas[t], resumo->por_tipo[t]);
+    }
+    fprintf(saida, "},\n  \"tabelas\": [\n");
+    for (int i = 0; i < TOTAL_TABELAS; i++) {
+        long problemas = 0;
+        for (int t = 0; t < TOTAL_TIPOS_PROBLEMA; t++) {
+            problemas += tabelas[i].por_tipo[t];
+        }
+        fprintf(saida, "    {\"arquivo\": \"%s\", \"encontrado\": %s, \"linhas\": %d, \"problemas\": %ld}%s\n",
+                tabelas[i].esquema->arquivo, tabelas[i].existe ? "true" : "false", tabelas[i].total, problemas,
+                i + 1 < TOTAL_TABELAS ? "," : "");
+    }
+
+    fprintf(saida, "  ],\n  \"detalhes\": [\n");
+    for (int i = 0; i < TOTAL_TABELAS; i++) {
+        const TabelaVerificada *tabela = &tabelas[i];
+        for (int p = 0; p < tabela->total_problemas && detalhados < MAX_PROBLEMAS_RELATORIO; p++) {
+            const ProblemaVerificado *problema = &tabela->problemas[p];
+            const LinhaVerificada *linha = &tabela->linhas[problema->linha];
+            const char *valor = NULL;
+
+            if (problema->campo >= 0 && problema->campo < tabela->esquema->total_campos) {
+                valor = linha->campos[problema->campo];
+            }
+            fprintf(saida, "%s    {\"arquivo\": \"%s\", \"linha\": %d, \"tipo\": \"%s\"", primeiro ? "" : ",\n",
+                    tabela->esquema->arquivo, linha->numero, nomes_problemas[problema->tipo]);
+            if (problema->campo >= 0 && problema->campo < tabela->esquema->total_campos) {
+                fprintf(saida, ", \"campo\": \"%s\"", tabela->esquema->campos[problema->campo].nome);
+            }
+            if (valor != NULL) {
+                fprintf(saida, ", \"valor\": ");
+                escreverTextoJson(saida, valor);
+            }
+            fprintf(saida, ", \"detalhe\": \"%s\"", problema->detalhe);
+            if (problema->tipo == PROBLEMA_CHAVE_DUPLICADA) {
+                fprintf(saida, ", \"primeira_linha\": %d", problema->referencia);
+            } else if (problema->tipo == PROBLEMA_CHAVE_ESTRANGEIRA) {
+                fprintf(saida, ", \"referencia\": \"%s\"", esquemas[problema->referencia].arquivo);
+            }
+            fprintf(saida, "}");
+            primeiro = 0;
+            detalhados++;
+        }
+    }
+    fprintf(saida, "%s  ],\n  \"detalhes_omitidos\": %ld\n}\n", primeiro ? "" : "\n",
+            resumo->problemas - detalhados);
+}
+
+// ========== REPARO ==========
+
+// Tamanho do campo cortado para caber na struct, sem partir caractere UTF-8
+static size_t larguraCortada(const char *texto, int largura) {
+    size_t tamanho = strlen(texto);
+    if (largura <= 0 || tamanho < (size_t)largura) {
+        return tamanho;
+    }
+    tamanho = (size_t)largura - 1;
+    while (tamanho > 0 && ((unsigned char)texto[tamanho] & 0xC0) == 0x80) {
+        tamanho--;
+    }
+    return tamanho;
+}
+
+static int gravarReparo(const char *diretorio_reparo, const TabelaVerificada *tabelas, ResumoVerificacao *resumo) {
+    char caminho[MAX_PATH * 2];
+
+    if (criarDiretorio(diretorio_reparo) != 0 && errno != EEXIST) {
+        printf("Erro: não foi possível criar o diretório '%s'.\n", diretorio_reparo);
+        return 0;
+    }
+
+    // Diretório novo: não sobrescreve CSVs que já estejam lá
+    for (int i = 0; i < TOTAL_TABELAS; i++) {
+        struct stat info;
+        snprintf(caminho, sizeof(caminho), "%s/%s", diretorio_reparo, tabelas[i].esquema->arquivo);
+        if (tabelas[i].existe && stat(caminho, &info) == 0) {
+            printf("Erro: '%s' já existe; o reparo exige um diretório novo.\n", caminho);
+            return 0;
+        }
+    }
+
+    for (int i = 0; i < TOTAL_TABELAS; i++) {
+        const TabelaVerificada *tabela = &tabelas[i];
+        if (!tabela->existe) {
+            continue;
+        }
+        snprintf(caminho, sizeof(caminho), "%s/%s", diretorio_reparo, tabela->esquema->arquivo);
+        FILE *arquivo = fopen(caminho, "w");
+        if (arquivo == NULL) {
+            printf("Erro ao criar '%s'.\n", caminho);
+            return 0;
+        }
+
+        fprintf(arquivo, "%s\n", tabela->esquema->cabecalho);
+        for (int l = 0; l < tabela->total; l++) {
+            const LinhaVerificada *linha = &tabela->linhas[l];
+            if (linha->descartada) {
+                resumo->linhas_descartadas++;
+                continue;
+            }
+            for (int k = 0; k < tabela->esquema->total_campos; k++) {
+                size_t tamanho = larguraCortada(linha->campos[k], tabela->esquema->campos[k].largura);
+                if (tamanho < strlen(linha->campos[k])) {
+                    resumo->campos_cortados++;
+                }
+                fprintf(arquivo, "%s%.*s", k ? "," : "", (int)tamanho, linha->campos[k]);
+            }
+            fputc('\n', arquivo);
+        }
+
+        if (fclose(arquivo) != 0) {
+            printf("Erro ao gravar '%s'.\n", caminho);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// ========== IMPLEMENTAÇÃO DAS FUNÇÕES PÚBLICAS ==========
+
+const char* nomeProblemaVerificacao(int tipo) {
+    return (tipo >= 0 && tipo < TOTAL_TIPOS_PROBLEMA) ? nomes_problemas[tipo] : "desconhecido";
+}
+
+long verificarDiretorioDados(const char *diretorio, const OpcoesVerificacao *opcoes,
+                             ResumoVerificacao *resumo) {
+    static const int todas[TOTAL_TABELAS] = {
+        TAB_ALUNOS, TAB_TURMAS, TAB_AULAS, TAB_MATRICULAS, TAB_ATIVIDADES, TAB_USUARIOS, TAB_NOTAS
+    };
+    static const int etapa_turmas[3] = {TAB_AULAS, TAB_MATRICULAS, TAB_ATIVIDADES};
+    static const int etapa_notas[1] = {TAB_NOTAS};
+    OpcoesVerificacao padrao = {NULL, NULL, 0};
+    TabelaVerificada tabelas[TOTAL_TABELAS];
+    ResumoVerificacao total;
+    struct timespec inicio, fim;
+    int ok = 1;
+
+    if (opcoes == NULL) {
+        opcoes = &padrao;
+    }
+    memset(tabelas, 0, sizeof(tabelas));
+    memset(&total, 0, sizeof(total));
+    for (int i = 0; i < TOTAL_TABELAS; i++) {
+        tabelas[i].esquema = &esquemas[i];
+        tabelas[i].indice = i;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    executarEtapa(tabelas, todas, TOTAL_TABELAS, verificarTabela, diretorio, opcoes->sequencial);
+    executarEtapa(tabelas, etapa_turmas, 3, verificarReferencias, diretorio, opcoes->sequencial);
+    executarEtapa(tabelas, etapa_notas, 1, verificarReferencias, diretorio, opcoes->sequencial);
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+
+    for (int i = 0; i < TOTAL_TABELAS; i++) {
+        total.tabelas += tabelas[i].existe;
+        total.linhas += tabelas[i].total;
+        for (int t = 0; t < TOTAL_TIPOS_PROBLEMA; t++) {
+            total.por_tipo[t] += tabelas[i].por_tipo[t];
+            total.problemas += tabelas[i].por_tipo[t];
+        }
+        if (tabelas[i].sem_memoria) {
+            printf("Erro: memória insuficiente para verificar %s.\n", esquemas[i].arquivo);
+            ok = 0;
+        }
+    }
+    total.segundos = (double)(fim.tv_sec - inicio.tv_sec) + (double)(fim.tv_nsec - inicio.tv_nsec) / 1e9;
+
+    if (total.tabelas == 0) {
+        printf("Erro: nenhum CSV do sistema em '%s'.\n", diretorio);
+        ok = 0;
+    }
+
+    if (ok && opcoes->diretorio_reparo != NULL) {
+        ok = gravarReparo(opcoes->diretorio_reparo, tabelas, &total);
+    }
+
+    if (ok && opcoes->relatorio_json != NULL) {
+        int tela = strcmp(opcoes->relatorio_json, "-") == 0;
+        FILE *saida = tela ? stdout : fopen(opcoes->relatorio_json, "w");
+        if (saida == NULL) {
+            printf("Erro: não foi possível criar '%s'.\n", opcoes->relatorio_json);
+            ok = 0;
+        } else {
+            escreverRelatorio(saida, diretorio, tabelas, &total);
+            if (!tela && fclose(saida) != 0) {
+                ok = 0;
+            }
+        }
+    }
+
+    for (int i = 0; i < TOTAL_TABELAS; i++) {
+        liberarConjunto(&tabelas[i].chaves);
+        liberarConjunto(&tabelas[i].textos);
+        free(tabelas[i].linhas);
+        free(tabelas[i].problemas);
+        free(tabelas[i].conteudo);
+    }
+
+    if (resumo != NULL) {
+        *resumo = total;
+    }
+    return ok ? total.problemas : -1;
+}
@@ -0,0 +1,62 @@
+#ifndef VERIFICACAO_MANAGER_H
+#define VERIFICACAO_MANAGER_H
+
+// ========== VERIFICAÇÃO DE INTEGRIDADE DOS CSVs (FSCK) ==========
+//
+// Lê os CSVs de um diretório de dados (alunos, turmas, aulas, aluno_turma,
+// atividades, usuarios, notas) sem passar pelos módulos: cada arquivo é lido
+// inteiro sob a trava compartilhada "<csv>.lock" e quebrado em campos no
+// próprio buffer, com a mesma regra dos carregadores (o último campo vai
+// até o fim da linha). Sem limite de linhas: MAX_ALUNOS etc. não se aplicam.
+//
+// Etapas (as tabelas de uma etapa são verificadas em paralelo):
+// 1. todas as tabelas: linha malformada, valor fora da faixa, data que
+//    validarData() recusa, campo maior que o da struct e chave primária
+//    repetida (conjunto hash chave -> linha; vale a primeira ocorrência);
+// 2. aulas, atividades e aluno_turma: chaves estrangeiras para turmas/alunos;
+// 3. notas: aluno, atividade e matrícula do aluno na turma da atividade.
+// As chaves estrangeiras só aceitam linhas que passaram nas etapas
+// anteriores (uma atividade descartada derruba as suas notas).
+//
+// Reparo: grava num diretório novo as linhas sem problema; campos longos
+// demais são cortados no tamanho da struct em vez de descartar a linha.
+
+#define TOTAL_TIPOS_PROBLEMA 6
+
+#define PROBLEMA_LINHA_MALFORMADA 0     // Campos faltando ou número inválido
+#define PROBLEMA_CHAVE_DUPLICADA 1
+#define PROBLEMA_CHAVE_ESTRANGEIRA 2
+#define PROBLEMA_DATA_INVALIDA 3
+#define PROBLEMA_CAMPO_TRUNCADO 4       // Não cabe no campo da struct
+#define PROBLEMA_VALOR_INVALIDO 5       // Ativo, semestre, tipo ou nota fora da faixa
+
+// Problemas detalhados no relatório JSON (os demais só entram na contagem)
+#define MAX_PROBLEMAS_RELATORIO 100000
+
+typedef struct {
+    const char *relatorio_json;    // Arquivo do relatório ("-" = stdout, NULL = nenhum)
+    const char *diretorio_reparo;  // Diretório novo para os CSVs reparados (NULL = sem reparo)
+    int sequencial;                // 1 = uma tabela por vez (comparação nos benchmarks)
+} OpcoesVerificacao;
+
+typedef struct {
+    int tabelas;                   // CSVs encontrados
+    long linhas;                   // Linhas de dados lidas
+    long problemas;
+    long por_tipo[TOTAL_TIPOS_PROBLEMA];
+    long linhas_descartadas;       // Reparo: linhas que ficaram de fora
+    long campos_cortados;          // Reparo: campos cortados no tamanho da struct
+    double segundos;
+} ResumoVerificacao;
+
+// Função para verificar os CSVs de um diretório
+// opcoes NULL = só contar
+// Retorna: problemas encontrados, -1 se o diretório não tem nenhum CSV
+//          conhecido ou se o relatório/reparo não pôde ser gravado
+long verificarDiretorioDados(const char *diretorio, const OpcoesVerificacao *opcoes,
+                             ResumoVerificacao *resumo);
+
+// Função para obter o nome de um tipo de problema (usado no JSON)
+const char* nomeProblemaVerificacao(int tipo);
+
+#endif
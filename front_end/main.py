@@ -6,9 +6,23 @@ TODAS as funcionalidades mantidas + Visual moderno aplicado
 
 from __future__ import annotations
 import csv
+import os
+import time
+from contextlib import contextmanager
 from dataclasses import dataclass
 from pathlib import Path
-from typing import Callable, Dict, Iterable, List, Optional, Sequence, Tuple
+from typing import Callable, Dict, Iterable, Iterator, List, Optional, Sequence, Tuple
+
+if os.name == "nt":
+    import msvcrt
+else:
+    import fcntl
+
+try:
+    # Modulo C opcional ("make modulo-python"); sem ele tudo vem dos CSVs
+    import pim_nativo
+except ImportError:
+    pim_nativo = None
 import customtkinter as ctk
 from tkinter import messagebox, ttk
 import tkinter as tk
@@ -95,26 +109,166 @@ def is_truthy(value: str) -> bool:
 def truthy_flag(value: str) -> str:
     return "Sim" if is_truthy(value) else "Nao"
 
+# ============= TRAVAS ENTRE PROCESSOS =============
+#
+# Mesmo protocolo dos modulos C (ver c_modules/tabela_manager.h):
+# 1. Cada "x.csv" tem o arquivo de trava "x.csv.lock" (flock no POSIX,
+#    msvcrt.locking no Windows, que so oferece trava exclusiva).
+# 2. Leitura: trava compartilhada apenas durante o parse do CSV.
+# 3. Leitura-modificacao-escrita: trava exclusiva do inicio da leitura ate a
+#    gravacao (DataRepository.update_table); dialogos nunca ficam abertos com
+#    a trava obtida.
+# 4. Gravacao: "x.csv.tmp" + os.replace, depois incrementa o contador de
+#    geracao (20 digitos + "\n" no inicio do ".lock") antes de soltar a trava.
+
+LOCK_OFFSET_WINDOWS = 0x40000000
+GENERATION_SIZE = 21
+
+
+class TableLock:
+    def __init__(self, path: Path, exclusive: bool) -> None:
+        self.path = path
+        self.exclusive = exclusive
+        self.fd = -1
+
+    def acquire(self) -> None:
+        self.fd = os.open(str(self.path), os.O_RDWR | os.O_CREAT, 0o644)
+        if os.name == "nt":
+            os.lseek(self.fd, LOCK_OFFSET_WINDOWS, os.SEEK_SET)
+            while True:
+                try:
+                    msvcrt.locking(self.fd, msvcrt.LK_NBLCK, 1)
+                    return
+                except OSError:
+                    time.sleep(0.01)
+        fcntl.flock(self.fd, fcntl.LOCK_EX if self.exclusive else fcntl.LOCK_SH)
+
+    def release(self) -> None:
+        if self.fd < 0:
+            return
+        if os.name == "nt":
+            os.lseek(self.fd, LOCK_OFFSET_WINDOWS, os.SEEK_SET)
+            msvcrt.locking(self.fd, msvcrt.LK_UNLCK, 1)
+        else:
+            fcntl.flock(self.fd, fcntl.LOCK_UN)
+        os.close(self.fd)
+        self.fd = -1
+
+    def bump_generation(self) -> None:
+        os.lseek(self.fd, 0, os.SEEK_SET)
+        raw = os.read(self.fd, GENERATION_SIZE)
+        try:
+            generation = int(raw.decode("ascii").strip() or "0")
+        except ValueError:
+            generation = 0
+        os.lseek(self.fd, 0, os.SEEK_SET)
+        os.write(self.fd, f"{generation + 1:020d}\n".encode("ascii"))
+
+
 # ============= REPOSITÓRIO DE DADOS =============
 
+NATIVE_LISTINGS: Dict[str, str] = {
+    "usuarios.csv": "listar_usuarios",
+    "alunos.csv": "listar_alunos",
+    "turmas.csv": "listar_turmas",
+    "aulas.csv": "listar_aulas",
+    "atividades.csv": "listar_atividades",
+}
+
+
 class DataRepository:
     def __init__(self, data_dir: Path) -> None:
         self.data_dir = data_dir
+        self._held_locks: Dict[str, TableLock] = {}
+        self.native = None
+        # Os modulos C so enxergam "<base>/data"; outros diretorios usam os CSVs
+        if pim_nativo is not None and data_dir.name == "data":
+            pim_nativo.configurar(str(data_dir.parent))
+            self.native = pim_nativo
 
     def _path_for(self, filename: str) -> Path:
         return self.data_dir / filename
 
+    @contextmanager
+    def lock_table(self, filename: str, exclusive: bool = True) -> Iterator[TableLock]:
+        held = self._held_locks.get(filename)
+        if held is not None:
+            if exclusive and not held.exclusive:
+                raise RuntimeError(f"Trava compartilhada de {filename} nao pode ser promovida")
+            yield held
+            return
+        self.data_dir.mkdir(parents=True, exist_ok=True)
+        lock = TableLock(self._path_for(filename + ".lock"), exclusive)
+        lock.acquire()
+        self._held_locks[filename] = lock
+        try:
+            yield lock
+        finally:
+            del self._held_locks[filename]
+            lock.release()
+
     def read_table(self, filename: str) -> Tuple[List[str], List[Dict[str, str]]]:
         path = self._path_for(filename)
         if not path.exists():
             headers = list(TABLE_HEADERS.get(filename, []))
             return headers, []
-        with path.open("r", newline="", encoding="utf-8") as csvfile:
-            reader = csv.DictReader(csvfile)
-            rows = [dict(row) for row in reader]
-            headers = list(reader.fieldnames or TABLE_HEADERS.get(filename, []))
+        with self.lock_table(filename, exclusive=False):
+            with path.open("r", newline="", encoding="utf-8") as csvfile:
+                reader = csv.DictReader(csvfile)
+                rows = [dict(row) for row in reader]
+                headers = list(reader.fieldnames or TABLE_HEADERS.get(filename, []))
         return headers, rows
 
+    def view_table(self, filename: str) -> Sequence[Dict[str, str]]:
+        """Linhas somente leitura para telas de listagem.
+
+        Com o modulo nativo e uma visao sobre a tabela em memoria dos modulos C
+        (as linhas viram dict so quando acessadas); sem ele, cai para read_table.
+        """
+        listing = NATIVE_LISTINGS.get(filename)
+        if self.native is not None and listing is not None:
+            return getattr(self.native, listing)()
+        return self.read_table(filename)[1]
+
+    def count_rows(self, filename: str, active_only: bool = False) -> int:
+        if self.native is not None:
+            if filename == "alunos.csv":
+                return self.native.contar_alunos(apenas_ativos=active_only)
+            if filename == "aulas.csv" and not active_only:
+                return self.native.contar_aulas()
+            if filename == "turmas.csv" and not active_only:
+                return self.native.contar_turmas()
+            if filename == "atividades.csv" and not active_only:
+                return self.native.contar_atividades()
+        rows = self.view_table(filename)
+        if active_only:
+            return sum(1 for row in rows if is_truthy(row.get("Ativo", "1")))
+        return len(rows)
+
+    def class_roster(self, class_id: str, active_only: bool = False) -> Sequence[Dict[str, str]]:
+        """Alunos de uma turma juntados ao cadastro (RA, Nome, Email, Ativo).
+
+        Com o modulo nativo a juncao e feita em C pelo indice de RA; sem ele,
+        uma passada em alunos.csv monta o indice e outra em aluno_turma.csv
+        junta. RA matriculado sem cadastro volta com Ativo "-1".
+        """
+        if self.native is not None:
+            return self.native.listar_alunos_da_turma_detalhado(int(class_id), apenas_ativos=active_only)
+        students: Dict[str, Dict[str, str]] = {}
+        for row in self.read_table("alunos.csv")[1]:
+            students.setdefault(row.get("RA", ""), row)
+        roster: List[Dict[str, str]] = []
+        for link in self.read_table("aluno_turma.csv")[1]:
+            if link.get("ID_Turma") != str(class_id):
+                continue
+            student = students.get(link.get("RA", ""))
+            if student is None:
+                if not active_only:
+                    roster.append({"RA": link.get("RA", ""), "Nome": "", "Email": "", "Ativo": "-1"})
+            elif not active_only or is_truthy(student.get("Ativo", "1")):
+                roster.append(student)
+        return roster
+
     def write_table(self, filename: str, rows: List[Dict[str, str]], headers: Optional[Sequence[str]] = None) -> None:
         path = self._path_for(filename)
         path.parent.mkdir(parents=True, exist_ok=True)
@@ -123,11 +277,28 @@ class DataRepository:
             header_order = list(rows[0].keys())
         if not header_order:
             raise ValueError(f"Cabecalho desconhecido para {filename}")
-        with path.open("w", newline="", encoding="utf-8") as csvfile:
-            writer = csv.DictWriter(csvfile, fieldnames=header_order)
-            writer.writeheader()
-            for row in rows:
-                writer.writerow(row)
+        tmp_path = self._path_for(filename + ".tmp")
+        with self.lock_table(filename) as lock:
+            with tmp_path.open("w", newline="", encoding="utf-8") as csvfile:
+                writer = csv.DictWriter(csvfile, fieldnames=header_order)
+                writer.writeheader()
+                for row in rows:
+                    writer.writerow(row)
+            os.replace(tmp_path, path)
+            lock.bump_generation()
+
+    def update_table(self, filename: str, mutate: Callable[[List[Dict[str, str]]], object]) -> object:
+        """Le, aplica mutate(rows) e grava sob uma unica trava exclusiva.
+
+        A gravacao so acontece se mutate retornar um valor verdadeiro, que
+        tambem e o retorno deste metodo.
+        """
+        with self.lock_table(filename):
+            headers, rows = self.read_table(filename)
+            result = mutate(rows)
+            if result:
+                self.write_table(filename, rows, headers)
+        return result
 
     @staticmethod
     def next_numeric_id(rows: Iterable[Dict[str, str]], field: str) -> int:
@@ -141,6 +312,68 @@ class DataRepository:
                 continue
         return max_value + 1
 
+# ============= ALTERAÇÕES AO VIVO =============
+#
+# O painel aplica as alteracoes das tabelas em vez de reler os CSVs (ver
+# c_modules/assinatura_manager.h). Cada evento e (sequencia, tabela,
+# operacao, linha): "I"/"U" gravam o registro da chave, "D" apaga a chave e
+# "L" pede a tabela inteira de novo (gravacoes deste front end, que nao
+# passam pelo registro de alteracoes, recriacoes e log podado). Sem o modulo
+# nativo, a geracao de cada ".lock" e consultada e qualquer mudanca vira "L".
+
+CHANGE_POLL_MS = 500
+CHANGE_BATCH = 500
+LIVE_TABLES = ("usuarios.csv", "alunos.csv", "turmas.csv", "aulas.csv", "atividades.csv", "aluno_turma.csv")
+
+
+class ChangeFeed:
+    def __init__(self, repo: DataRepository, tables: Sequence[str]) -> None:
+        self.repo = repo
+        self.tables = list(tables)
+        self.subscription = None
+        self.generations: Dict[str, int] = {}
+        if repo.native is not None and hasattr(repo.native, "Assinatura"):
+            self.subscription = repo.native.Assinatura(tabelas=self.tables)
+        else:
+            self.generations = {filename: self._generation(filename) for filename in self.tables}
+
+    def _generation(self, filename: str) -> int:
+        try:
+            with self.repo._path_for(filename + ".lock").open("rb") as lockfile:
+                return int(lockfile.read(GENERATION_SIZE).decode("ascii").strip() or "0")
+        except (OSError, ValueError):
+            return -1
+
+    def poll(self) -> List[Tuple[int, str, str, str]]:
+        if self.subscription is not None:
+            return self.subscription.ler(maximo=CHANGE_BATCH)
+        events = []
+        for filename in self.tables:
+            generation = self._generation(filename)
+            if generation != self.generations.get(filename):
+                self.generations[filename] = generation
+                events.append((0, filename, "L", ""))
+        return events
+
+    def close(self) -> None:
+        if self.subscription is not None:
+            self.subscription.fechar()
+            self.subscription = None
+
+    @staticmethod
+    def parse_line(filename: str, line: str) -> Dict[str, str]:
+        # Linhas dos modulos C: sem aspas, o ultimo campo leva o resto
+        headers = TABLE_HEADERS.get(filename, [])
+        return dict(zip(headers, line.split(",", max(len(headers) - 1, 0))))
+
+
+@dataclass(eq=False)
+class LiveView:
+    tree: object
+    columns: Sequence[Tuple[str, str]]
+    refresh: Callable[[], None]
+    incremental: bool = True         # False: qualquer alteracao rele a visao
+
 # ============= SERVIÇO DE AUTENTICAÇÃO =============
 
 class AuthService:
@@ -343,7 +576,20 @@ class DashboardFrame(ctk.CTkFrame):
         )
         self.tabview.pack(fill="both", expand=True, padx=20, pady=20)
         
+        self._live_views: Dict[str, List[LiveView]] = {}
         self._build_tabs()
+        
+        self._change_feed: Optional[ChangeFeed] = ChangeFeed(self.app.repo, LIVE_TABLES)
+        self._change_job = self.after(CHANGE_POLL_MS, self._poll_changes)
+    
+    def destroy(self) -> None:
+        if self._change_job is not None:
+            self.after_cancel(self._change_job)
+            self._change_job = None
+        if self._change_feed is not None:
+            self._change_feed.close()
+            self._change_feed = None
+        super().destroy()
     
     def is_admin(self) -> bool:
         return self.session.tipo.upper() == "ADMIN" or "*" in self.permissions
@@ -366,17 +612,67 @@ class DashboardFrame(ctk.CTkFrame):
             tab = self.tabview.add(title)
             builder(tab)
     
-    def _refresh_tree(self, tree, rows: List[Dict[str, str]], columns: Sequence[Tuple[str, str]]) -> None:
+    @staticmethod
+    def _tree_values(row: Dict[str, str], columns: Sequence[Tuple[str, str]]) -> List[str]:
+        values = []
+        for column, _ in columns:
+            cell = row.get(column, "")
+            if column == "Ativo":
+                cell = truthy_flag(cell)
+            values.append(str(cell))
+        return values
+    
+    def _refresh_tree(self, tree, rows: Sequence[Dict[str, str]], columns: Sequence[Tuple[str, str]]) -> None:
+        # A primeira coluna (ID/RA) vira o iid: e por ela que as alteracoes chegam
         for item in tree.get_children():
             tree.delete(item)
+        key = columns[0][0]
         for row in rows:
-            values = []
-            for column, _ in columns:
-                cell = row.get(column, "")
-                if column == "Ativo":
-                    cell = truthy_flag(cell)
-                values.append(str(cell))
-            tree.insert("", "end", values=values)
+            iid = str(row.get(key, ""))
+            if not iid or tree.exists(iid):
+                iid = None
+            tree.insert("", "end", iid=iid, values=self._tree_values(row, columns))
+    
+    def _watch(self, filename: str, tree, columns: Sequence[Tuple[str, str]],
+               refresh: Callable[[], None], incremental: bool = True) -> None:
+        self._live_views.setdefault(filename, []).append(LiveView(tree, columns, refresh, incremental))
+    
+    def _apply_change(self, view: LiveView, operation: str, row: Dict[str, str]) -> bool:
+        """Aplica uma alteracao na arvore; False se a visao precisa ser relida."""
+        iid = str(row.get(view.columns[0][0], ""))
+        if not view.incremental or not iid:
+            return False
+        if operation == "D":
+            if view.tree.exists(iid):
+                view.tree.delete(iid)
+        elif view.tree.exists(iid):
+            view.tree.item(iid, values=self._tree_values(row, view.columns))
+        else:
+            view.tree.insert("", "end", iid=iid, values=self._tree_values(row, view.columns))
+        return True
+    
+    def _poll_changes(self) -> None:
+        self._change_job = None
+        try:
+            events = self._change_feed.poll() if self._change_feed is not None else []
+        except OSError:
+            events = []
+        # Janelas fechadas (lista de alunos da turma) saem do registro
+        for filename, views in self._live_views.items():
+            self._live_views[filename] = [view for view in views if view.tree.winfo_exists()]
+        stale: List[LiveView] = []
+        for _, filename, operation, line in events:
+            views = self._live_views.get(filename, [])
+            if operation == "L":
+                stale.extend(views)
+                continue
+            row = ChangeFeed.parse_line(filename, line)
+            for view in views:
+                if view not in stale and not self._apply_change(view, operation, row):
+                    stale.append(view)
+        for view in stale:
+            view.refresh()
+        self._change_job = self.after(CHANGE_POLL_MS, self._poll_changes)
     
     def _get_selected_row(self, tree, columns: Sequence[Tuple[str, str]]) -> Optional[Dict[str, str]]:
         selection = tree.selection()
@@ -451,6 +747,7 @@ class DashboardFrame(ctk.CTkFrame):
         table_frame.pack(fill="both", expand=True, pady=(0, 20))
         
         self._refresh_users(tree, columns)
+        self._watch("usuarios.csv", tree, columns, lambda: self._refresh_users(tree, columns))
         
         btn_frame = ctk.CTkFrame(scroll_frame, fg_color="transparent")
         btn_frame.pack(fill="x")
@@ -463,7 +760,7 @@ class DashboardFrame(ctk.CTkFrame):
             lambda: self._toggle_user(tree, columns), 180).pack(side="left", padx=5)
     
     def _refresh_users(self, tree, columns) -> None:
-        _, rows = self.app.repo.read_table("usuarios.csv")
+        rows = self.app.repo.view_table("usuarios.csv")
         self._refresh_tree(tree, rows, columns)
     
     def _add_user(self, tree, columns) -> None:
@@ -485,15 +782,17 @@ class DashboardFrame(ctk.CTkFrame):
                 messagebox.showerror("Usuarios", "Tipo inválido.")
                 return False
             
-            headers, rows = self.app.repo.read_table("usuarios.csv")
-            for row in rows:
-                if row.get("Login", "").lower() == login.lower():
-                    messagebox.showerror("Usuarios", "Login já cadastrado.")
-                    return False
+            def add(rows: List[Dict[str, str]]) -> bool:
+                for row in rows:
+                    if row.get("Login", "").lower() == login.lower():
+                        return False
+                new_id = DataRepository.next_numeric_id(rows, "ID")
+                rows.append({"ID": str(new_id), "Login": login, "Senha": senha, "Tipo": tipo, "Ativo": "1"})
+                return True
             
-            new_id = DataRepository.next_numeric_id(rows, "ID")
-            rows.append({"ID": str(new_id), "Login": login, "Senha": senha, "Tipo": tipo, "Ativo": "1"})
-            self.app.repo.write_table("usuarios.csv", rows, headers)
+            if not self.app.repo.update_table("usuarios.csv", add):
+                messagebox.showerror("Usuarios", "Login já cadastrado.")
+                return False
             self._refresh_users(tree, columns)
             return True
         
@@ -512,14 +811,17 @@ class DashboardFrame(ctk.CTkFrame):
                 messagebox.showerror("Usuarios", "Senha não pode ser vazia.")
                 return False
             
-            headers, rows = self.app.repo.read_table("usuarios.csv")
-            for row in rows:
-                if row.get("Login") == selected.get("Login"):
-                    row["Senha"] = nova_senha
-                    self.app.repo.write_table("usuarios.csv", rows, headers)
-                    self._refresh_users(tree, columns)
-                    messagebox.showinfo("Usuarios", "Senha atualizada com sucesso.")
-                    return True
+            def reset(rows: List[Dict[str, str]]) -> bool:
+                for row in rows:
+                    if row.get("Login") == selected.get("Login"):
+                        row["Senha"] = nova_senha
+                        return True
+                return False
+            
+            if self.app.repo.update_table("usuarios.csv", reset):
+                self._refresh_users(tree, columns)
+                messagebox.showinfo("Usuarios", "Senha atualizada com sucesso.")
+                return True
             
             messagebox.showerror("Usuarios", "Usuário não encontrado.")
             return False
@@ -531,13 +833,16 @@ class DashboardFrame(ctk.CTkFrame):
         if selected is None:
             return
         
-        headers, rows = self.app.repo.read_table("usuarios.csv")
-        for row in rows:
-            if row.get("Login") == selected.get("Login"):
-                row["Ativo"] = "0" if is_truthy(row.get("Ativo", "1")) else "1"
-                self.app.repo.write_table("usuarios.csv", rows, headers)
-                self._refresh_users(tree, columns)
-                return
+        def toggle(rows: List[Dict[str, str]]) -> bool:
+            for row in rows:
+                if row.get("Login") == selected.get("Login"):
+                    row["Ativo"] = "0" if is_truthy(row.get("Ativo", "1")) else "1"
+                    return True
+            return False
+        
+        if self.app.repo.update_table("usuarios.csv", toggle):
+            self._refresh_users(tree, columns)
+            return
         
         messagebox.showerror("Usuarios", "Usuário não encontrado.")
     
@@ -555,6 +860,7 @@ class DashboardFrame(ctk.CTkFrame):
         table_frame.pack(fill="both", expand=True, pady=(0, 20))
         
         self._refresh_students(tree, columns)
+        self._watch("alunos.csv", tree, columns, lambda: self._refresh_students(tree, columns))
         
         btn_frame = ctk.CTkFrame(scroll_frame, fg_color="transparent")
         btn_frame.pack(fill="x")
@@ -575,7 +881,7 @@ class DashboardFrame(ctk.CTkFrame):
             lambda: self._refresh_students(tree, columns), 120).pack(side="right")
     
     def _refresh_students(self, tree, columns) -> None:
-        _, rows = self.app.repo.read_table("alunos.csv")
+        rows = self.app.repo.view_table("alunos.csv")
         self._refresh_tree(tree, rows, columns)
     
     def _add_student(self, tree, columns) -> None:
@@ -587,7 +893,6 @@ class DashboardFrame(ctk.CTkFrame):
         ]
         
         def submit(values: Dict[str, str]) -> bool:
-            headers, rows = self.app.repo.read_table("alunos.csv")
             ra = values["ra"].strip()
             nome = values["nome"].strip()
             email = values["email"].strip()
@@ -597,20 +902,21 @@ class DashboardFrame(ctk.CTkFrame):
                 messagebox.showerror("Alunos", "Nome e email são obrigatórios.")
                 return False
             
-            if not ra:
-                ra = str(DataRepository.next_numeric_id(rows, "RA"))
-            
-            if not ra.isdigit():
+            if ra and not ra.isdigit():
                 messagebox.showerror("Alunos", "RA deve ser numérico.")
                 return False
             
-            for row in rows:
-                if row.get("RA") == ra:
-                    messagebox.showerror("Alunos", "RA já existente.")
-                    return False
+            def add(rows: List[Dict[str, str]]) -> bool:
+                novo_ra = ra or str(DataRepository.next_numeric_id(rows, "RA"))
+                for row in rows:
+                    if row.get("RA") == novo_ra:
+                        return False
+                rows.append({"RA": novo_ra, "Nome": nome, "Email": email, "Ativo": ativo})
+                return True
             
-            rows.append({"RA": ra, "Nome": nome, "Email": email, "Ativo": ativo})
-            self.app.repo.write_table("alunos.csv", rows, headers)
+            if not self.app.repo.update_table("alunos.csv", add):
+                messagebox.showerror("Alunos", "RA já existente.")
+                return False
             self._refresh_students(tree, columns)
             return True
         
@@ -621,13 +927,16 @@ class DashboardFrame(ctk.CTkFrame):
         if selected is None:
             return
         
-        headers, rows = self.app.repo.read_table("alunos.csv")
-        for row in rows:
-            if row.get("RA") == selected.get("RA"):
-                row["Ativo"] = "0" if is_truthy(row.get("Ativo", "1")) else "1"
-                self.app.repo.write_table("alunos.csv", rows, headers)
-                self._refresh_students(tree, columns)
-                return
+        def toggle(rows: List[Dict[str, str]]) -> bool:
+            for row in rows:
+                if row.get("RA") == selected.get("RA"):
+                    row["Ativo"] = "0" if is_truthy(row.get("Ativo", "1")) else "1"
+                    return True
+            return False
+        
+        if self.app.repo.update_table("alunos.csv", toggle):
+            self._refresh_students(tree, columns)
+            return
         
         messagebox.showerror("Alunos", "Aluno não encontrado.")
     
@@ -646,6 +955,7 @@ class DashboardFrame(ctk.CTkFrame):
         table_frame.pack(fill="both", expand=True, pady=(0, 20))
         
         self._refresh_classes(tree, columns)
+        self._watch("turmas.csv", tree, columns, lambda: self._refresh_classes(tree, columns))
         
         btn_frame = ctk.CTkFrame(scroll_frame, fg_color="transparent")
         btn_frame.pack(fill="x")
@@ -654,9 +964,12 @@ class DashboardFrame(ctk.CTkFrame):
             lambda: self._add_class(tree, columns), 150)
         edit_btn = ComponentesUI.criar_botao_secundario(btn_frame, "✎ Editar",
             lambda: self._edit_class(tree, columns), 120)
+        roster_btn = ComponentesUI.criar_botao_secundario(btn_frame, "👥 Alunos",
+            lambda: self._show_class_roster(tree, columns), 120)
         
         add_btn.pack(side="left", padx=5)
         edit_btn.pack(side="left", padx=5)
+        roster_btn.pack(side="left", padx=5)
         
         ComponentesUI.criar_botao_secundario(btn_frame, "🔄 Atualizar",
             lambda: self._refresh_classes(tree, columns), 120).pack(side="right")
@@ -665,11 +978,47 @@ class DashboardFrame(ctk.CTkFrame):
             add_btn.configure(state="disabled")
         if not (self.is_admin() or self.has_action("EDITAR_TURMA")):
             edit_btn.configure(state="disabled")
+        if not (self.is_admin() or self.has_action("VISUALIZAR_ALUNOS")):
+            roster_btn.configure(state="disabled")
     
     def _refresh_classes(self, tree, columns) -> None:
-        _, rows = self.app.repo.read_table("turmas.csv")
+        rows = self.app.repo.view_table("turmas.csv")
         self._refresh_tree(tree, rows, columns)
     
+    def _show_class_roster(self, tree, columns) -> None:
+        selected = self._get_selected_row(tree, columns)
+        if selected is None:
+            return
+        
+        top = ctk.CTkToplevel(self)
+        top.title(f"Alunos da turma {selected.get('Nome', '')}")
+        top.transient(self.winfo_toplevel())
+        top.configure(fg_color=Config.COR_FUNDO_CARD)
+        
+        container = ctk.CTkFrame(top, fg_color=Config.COR_FUNDO_CARD)
+        container.pack(fill="both", expand=True, padx=20, pady=20)
+        
+        roster_columns = [("RA", "RA"), ("Nome", "Nome"), ("Email", "Email"), ("Ativo", "Ativo")]
+        table_frame, roster_tree = ComponentesUI.criar_tabela(container, roster_columns)
+        active_only = tk.BooleanVar(value=False)
+        
+        def refresh() -> None:
+            rows = []
+            for row in self.app.repo.class_roster(selected.get("ID", ""), active_only.get()):
+                if str(row.get("Ativo", "")) == "-1":
+                    row = dict(row, Nome="[nao encontrado]")
+                rows.append(row)
+            self._refresh_tree(roster_tree, rows, roster_columns)
+        
+        ctk.CTkCheckBox(container, text="Somente ativos", variable=active_only,
+                        command=refresh).pack(anchor="w", pady=(0, 10))
+        table_frame.pack(fill="both", expand=True)
+        refresh()
+        
+        # Juncao de duas tabelas: qualquer alteracao nelas rele a lista
+        for filename in ("alunos.csv", "aluno_turma.csv"):
+            self._watch(filename, roster_tree, roster_columns, refresh, incremental=False)
+    
     def _add_class(self, tree, columns) -> None:
         fields = [
             FormField("nome", "Nome da turma"),
@@ -679,7 +1028,6 @@ class DashboardFrame(ctk.CTkFrame):
         ]
         
         def submit(values: Dict[str, str]) -> bool:
-            headers, rows = self.app.repo.read_table("turmas.csv")
             nome = values["nome"].strip()
             professor = values["professor"].strip()
             ano = values["ano"].strip()
@@ -689,12 +1037,15 @@ class DashboardFrame(ctk.CTkFrame):
                 messagebox.showerror("Turmas", "Nome e professor são obrigatórios.")
                 return False
             
-            new_id = DataRepository.next_numeric_id(rows, "ID")
-            rows.append({
-                "ID": str(new_id), "Nome": nome, "Professor": professor,
-                "Ano": ano or "0", "Semestre": semestre or "0"
-            })
-            self.app.repo.write_table("turmas.csv", rows, headers)
+            def add(rows: List[Dict[str, str]]) -> bool:
+                new_id = DataRepository.next_numeric_id(rows, "ID")
+                rows.append({
+                    "ID": str(new_id), "Nome": nome, "Professor": professor,
+                    "Ano": ano or "0", "Semestre": semestre or "0"
+                })
+                return True
+            
+            self.app.repo.update_table("turmas.csv", add)
             self._refresh_classes(tree, columns)
             return True
         
@@ -713,18 +1064,21 @@ class DashboardFrame(ctk.CTkFrame):
         ]
         
         def submit(values: Dict[str, str]) -> bool:
-            headers, rows = self.app.repo.read_table("turmas.csv")
-            for row in rows:
-                if row.get("ID") == selected.get("ID"):
-                    row.update({
-                        "Nome": values["nome"].strip(),
-                        "Professor": values["professor"].strip(),
-                        "Ano": values["ano"].strip(),
-                        "Semestre": values["semestre"].strip(),
-                    })
-                    self.app.repo.write_table("turmas.csv", rows, headers)
-                    self._refresh_classes(tree, columns)
-                    return True
+            def edit(rows: List[Dict[str, str]]) -> bool:
+                for row in rows:
+                    if row.get("ID") == selected.get("ID"):
+                        row.update({
+                            "Nome": values["nome"].strip(),
+                            "Professor": values["professor"].strip(),
+                            "Ano": values["ano"].strip(),
+                            "Semestre": values["semestre"].strip(),
+                        })
+                        return True
+                return False
+            
+            if self.app.repo.update_table("turmas.csv", edit):
+                self._refresh_classes(tree, columns)
+                return True
             
             messagebox.showerror("Turmas", "Turma não encontrada.")
             return False
@@ -745,6 +1099,7 @@ class DashboardFrame(ctk.CTkFrame):
         table_frame.pack(fill="both", expand=True, pady=(0, 20))
         
         self._refresh_lessons(tree, columns)
+        self._watch("aulas.csv", tree, columns, lambda: self._refresh_lessons(tree, columns))
         
         btn_frame = ctk.CTkFrame(scroll_frame, fg_color="transparent")
         btn_frame.pack(fill="x")
@@ -760,7 +1115,7 @@ class DashboardFrame(ctk.CTkFrame):
             add_btn.configure(state="disabled")
     
     def _refresh_lessons(self, tree, columns) -> None:
-        _, rows = self.app.repo.read_table("aulas.csv")
+        rows = self.app.repo.view_table("aulas.csv")
         self._refresh_tree(tree, rows, columns)
     
     def _add_lesson(self, tree, columns) -> None:
@@ -771,7 +1126,6 @@ class DashboardFrame(ctk.CTkFrame):
         ]
         
         def submit(values: Dict[str, str]) -> bool:
-            headers, rows = self.app.repo.read_table("aulas.csv")
             id_turma = values["id_turma"].strip()
             data = values["data"].strip()
             conteudo = values["conteudo"].strip()
@@ -784,9 +1138,12 @@ class DashboardFrame(ctk.CTkFrame):
                 messagebox.showerror("Aulas", "Data e conteúdo são obrigatórios.")
                 return False
             
-            new_id = DataRepository.next_numeric_id(rows, "ID")
-            rows.append({"ID": str(new_id), "ID_Turma": id_turma, "Data": data, "Conteudo": conteudo})
-            self.app.repo.write_table("aulas.csv", rows, headers)
+            def add(rows: List[Dict[str, str]]) -> bool:
+                new_id = DataRepository.next_numeric_id(rows, "ID")
+                rows.append({"ID": str(new_id), "ID_Turma": id_turma, "Data": data, "Conteudo": conteudo})
+                return True
+            
+            self.app.repo.update_table("aulas.csv", add)
             self._refresh_lessons(tree, columns)
             return True
         
@@ -807,6 +1164,7 @@ class DashboardFrame(ctk.CTkFrame):
         table_frame.pack(fill="both", expand=True, pady=(0, 20))
         
         self._refresh_activities(tree, columns)
+        self._watch("atividades.csv", tree, columns, lambda: self._refresh_activities(tree, columns))
         
         btn_frame = ctk.CTkFrame(scroll_frame, fg_color="transparent")
         btn_frame.pack(fill="x")
@@ -828,7 +1186,7 @@ class DashboardFrame(ctk.CTkFrame):
             show_btn.configure(state="disabled")
     
     def _refresh_activities(self, tree, columns) -> None:
-        _, rows = self.app.repo.read_table("atividades.csv")
+        rows = self.app.repo.view_table("atividades.csv")
         self._refresh_tree(tree, rows, columns)
     
     def _add_activity(self, tree, columns) -> None:
@@ -840,7 +1198,6 @@ class DashboardFrame(ctk.CTkFrame):
         ]
         
         def submit(values: Dict[str, str]) -> bool:
-            headers, rows = self.app.repo.read_table("atividades.csv")
             id_turma = values["id_turma"].strip()
             titulo = values["titulo"].strip()
             descricao = values["descricao"].strip()
@@ -854,12 +1211,15 @@ class DashboardFrame(ctk.CTkFrame):
                 messagebox.showerror("Atividades", "Título obrigatório.")
                 return False
             
-            new_id = DataRepository.next_numeric_id(rows, "ID")
-            rows.append({
-                "ID": str(new_id), "ID_Turma": id_turma, "Titulo": titulo,
-                "Descricao": descricao, "Arquivo": arquivo
-            })
-            self.app.repo.write_table("atividades.csv", rows, headers)
+            def add(rows: List[Dict[str, str]]) -> bool:
+                new_id = DataRepository.next_numeric_id(rows, "ID")
+                rows.append({
+                    "ID": str(new_id), "ID_Turma": id_turma, "Titulo": titulo,
+                    "Descricao": descricao, "Arquivo": arquivo
+                })
+                return True
+            
+            self.app.repo.update_table("atividades.csv", add)
             self._refresh_activities(tree, columns)
             return True
         
@@ -965,22 +1325,19 @@ class DashboardFrame(ctk.CTkFrame):
             btn_load.configure(state="disabled")
     
     def _generate_summary_lines(self) -> List[str]:
-        _, alunos = self.app.repo.read_table("alunos.csv")
-        _, turmas = self.app.repo.read_table("turmas.csv")
-        _, aulas = self.app.repo.read_table("aulas.csv")
-        _, atividades = self.app.repo.read_table("atividades.csv")
-        
-        ativos = sum(1 for aluno in alunos if is_truthy(aluno.get("Ativo", "1")))
+        repo = self.app.repo
+        total_alunos = repo.count_rows("alunos.csv")
+        ativos = repo.count_rows("alunos.csv", active_only=True)
         
         lines = [
             "=" * 50,
             "RELATÓRIO GERAL DO SISTEMA ACADÊMICO",
             "=" * 50,
             "",
-            f"📚 Total de alunos: {len(alunos)} (ativos: {ativos})",
-            f"🏫 Total de turmas: {len(turmas)}",
-            f"📝 Total de aulas registradas: {len(aulas)}",
-            f"📄 Atividades disponíveis: {len(atividades)}",
+            f"📚 Total de alunos: {total_alunos} (ativos: {ativos})",
+            f"🏫 Total de turmas: {repo.count_rows('turmas.csv')}",
+            f"📝 Total de aulas registradas: {repo.count_rows('aulas.csv')}",
+            f"📄 Atividades disponíveis: {repo.count_rows('atividades.csv')}",
             "",
             "=" * 50,
         ]